@@ -0,0 +1,690 @@
+/*########################################################
+# Name: alnDirVect
+# Use:
+#  - Fills in the direction matrix for a Needleman or
+#    Waterman alignment with vector (SIMD) kernels
+#  - The output (byte or two bit direction matrix, best
+#    score, and best cell) is the same as NeedlemanAln,
+#    WatermanAln, NeedleTwoBit, and WaterTwoBit (and the
+#    no gap extension versions), so the matrixes can be
+#    used with dirMatrixToAln and twoBitDirMatrixToAln.
+#  - The 16 bit kernel is used whenever its scores can not
+#    overflow, else the 32 bit kernel is used.
+#  - Long Needlemans with a byte matrix use the 8 bit
+#    difference kernel (alnDirVectDiffI8.h) instead of the
+#    32 bit kernel. If a difference overflows, the matrix
+#    is redone with the 16/32 bit kernels.
+#  - -no-gap-extend is done by setting the gap extension
+#    penalty to the gap opening penalty
+#  - Only the delInsSnp direction preference is done with
+#    vectors (see vectWaterDirBl). The scalar aligners are
+#    used for the other preferences.
+# Libraries:
+#  - "alnDirVectDiffI8.h"             (No .c File)
+#  - "alnDirVectI16.h"                (No .c File)
+#  - "alnDirVectI32.h"                (No .c File)
+#  - "../memWater/memWaterVect.h"     (No .c File)
+#  - "../needleman/needleman.h"       (No .c File)
+#  - "../needleman/needleNoGap.h"     (No .c File)
+#  - "../needleman/needleTwoBit.h"    (No .c File)
+#  - "../needleman/needleTwoBitNoGap.h" (No .c File)
+#  - "../waterman/waterman.h"         (No .c File)
+#  - "../waterman/watermanNoGap.h"    (No .c File)
+#  - "../waterman/waterTwoBit.h"      (No .c File)
+#  - "../waterman/waterTwoBitNoGap.h" (No .c File)
+#  o "genAlnDirVect.h"                (No .c File)
+#  o "../general/alnMatrixStruct.h"   (No .c File)
+#  o "../general/twoBitArrays.h"      (No .c File)
+#  o "../general/seqStruct.h"         (No .c File)
+#  o "../general/alnSetStruct.h"      (No .c File)
+#  o "../general/alnSeqDefaults.h"    (No .c File)
+#  o "../general/dataTypeShortHand.h" (No .c File)
+#  o "../vectWrap/vectWrap.h"         (No .c File)
+# C Standard Libraries:
+#  o <stdint.h>
+#  o <stdlib.h>
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Includes and definitions
+'  o macro-01 alnDirScalar:
+'    - Runs the scalar Needleman or Waterman that has the
+'      same output as alnDirVect
+'  o macro-02 alnDirScalarTwoBit:
+'    - Runs the scalar two bit Needleman or Waterman that
+'      has the same output as alnDirVectTwoBit
+'  o macro-03 alnDirVectBits:
+'    - Picks the number of bits to score a matrix with
+'  o fun-04 alnDirVectPickBits:
+'    - Finds the largest penalty and picks the number of
+'      bits to score a matrix with
+'  o fun-05 alnDirVectFill:
+'    - Fills in a direction matrix with the kernel picked
+'      by alnDirVectPickBits
+'  o fun-06 alnDirVect:
+'    - Does a Needleman or Waterman alignment with a byte
+'      direction matrix filled in with vectors
+'  o fun-07 alnDirVectTwoBit:
+'    - Does a Needleman or Waterman alignment with a two
+'      bit direction matrix filled in with vectors
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes and definitions
+\-------------------------------------------------------*/
+
+#ifndef ALN_DIR_VECT_H
+#define ALN_DIR_VECT_H
+
+#include <stdlib.h>
+
+#include "alnDirVectDiffI8.h"
+#include "alnDirVectI16.h"
+#include "alnDirVectI32.h"
+#include "../memWater/memWaterVect.h"
+
+#include "../needleman/needleman.h"
+#include "../needleman/needleNoGap.h"
+#include "../needleman/needleTwoBit.h"
+#include "../needleman/needleTwoBitNoGap.h"
+
+#include "../waterman/waterman.h"
+#include "../waterman/watermanNoGap.h"
+#include "../waterman/waterTwoBit.h"
+#include "../waterman/waterTwoBitNoGap.h"
+
+/*Largest scores the 16 and 32 bit kernels can hold*/
+#define defAlnDirMaxI16 32767
+#define defAlnDirMaxI32 2147483647
+
+/*-------------------------------------------------------\
+| Macro-01: alnDirScalar
+|   - Runs the scalar Needleman or Waterman that has the
+|     same output as alnDirVect
+| Input:
+|   - qryST:
+|     o seqStruct with the query sequence
+|   - refST:
+|     o seqStruct with the reference sequence
+|   - needleBl:
+|     o 1: Needleman alignment
+|     o 0: Waterman alignment
+|   - settings:
+|     o alnSet structure with the alignment settings
+| Output:
+|   - Returns:
+|     o alnMatrix structure with the direction matrix
+|     o 0 for memory errors
+\-------------------------------------------------------*/
+#define alnDirScalar(qryST, refST, needleBl, settings)(\
+   (needleBl) ?\
+        (\
+           (settings)->noGapBl ?\
+                NeedleAlnNoGap((qryST),(refST),(settings))\
+              : NeedlemanAln((qryST), (refST), (settings))\
+        )\
+      : (\
+           (settings)->noGapBl ?\
+                WatermanAlnNoGap((qryST),(refST),(settings))\
+              : WatermanAln((qryST), (refST), (settings))\
+        )\
+) /*alnDirScalar*/
+
+/*-------------------------------------------------------\
+| Macro-02: alnDirScalarTwoBit
+|   - Runs the scalar two bit Needleman or Waterman that
+|     has the same output as alnDirVectTwoBit
+| Input:
+|   - qryST:
+|     o seqStruct with the query sequence
+|   - refST:
+|     o seqStruct with the reference sequence
+|   - needleBl:
+|     o 1: Needleman alignment
+|     o 0: Waterman alignment
+|   - settings:
+|     o alnSet structure with the alignment settings
+| Output:
+|   - Returns:
+|     o alnMatrixTwoBit structure with the direction
+|       matrix
+|     o 0 for memory errors
+\-------------------------------------------------------*/
+#define alnDirScalarTwoBit(qryST,refST,needleBl,settings)(\
+   (needleBl) ?\
+        (\
+           (settings)->noGapBl ?\
+                NeedleTwoBitNoGap((qryST),(refST),(settings))\
+              : NeedleTwoBit((qryST), (refST), (settings))\
+        )\
+      : (\
+           (settings)->noGapBl ?\
+                WaterTwoBitNoGap((qryST),(refST),(settings))\
+              : WaterTwoBit((qryST), (refST), (settings))\
+        )\
+) /*alnDirScalarTwoBit*/
+
+#ifdef DEFNOVECT
+   /*No vector support was compiled in, use the scalar
+   ` aligners instead
+   */
+   #define alnDirVect(qryST, refST, needleBl, settings)(\
+      alnDirScalar((qryST),(refST),(needleBl),(settings))\
+   )
+
+   #define alnDirVectTwoBit(qryST,refST,needleBl,settings)(\
+      alnDirScalarTwoBit(\
+         (qryST),\
+         (refST),\
+         (needleBl),\
+         (settings)\
+      )\
+   )
+#else
+
+/*-------------------------------------------------------\
+| Macro-03: alnDirVectBits
+|   - Picks the number of bits to score a matrix with
+| Input:
+|   - lenRefUL:
+|     o Number of reference bases (striped)
+|   - lenQryUL:
+|     o Number of query bases
+|   - maxPenL:
+|     o Largest absolute score or gap penalty (a cell is
+|       at most this far from the cell it came from)
+| Output:
+|   - Returns:
+|     o 16 if no score can overflow 16 bits
+|     o 32 if no score can overflow 32 bits
+|     o 0 if the scalar aligners have to be used
+| Note:
+|   - A path has at most lenQryUL + lenRefUL steps. The
+|     striped rows add up to one vector of padding columns
+|     and the gap/indel columns add one more step.
+\-------------------------------------------------------*/
+#define alnDirVectBits(lenRefUL, lenQryUL, maxPenL)(\
+   (lenRefUL) < defNum32BitElms ?\
+      0 /*Scalar is faster for a few reference bases*/\
+   :   ((lenRefUL) + (lenQryUL) + defNum16BitElms + 2)\
+     * (ulong) (maxPenL)\
+     <= defAlnDirMaxI16 ?\
+      16\
+   :   ((lenRefUL) + (lenQryUL) + defNum32BitElms + 2)\
+     * (ulong) (maxPenL)\
+     <= defAlnDirMaxI32 ?\
+      32\
+   : 0\
+) /*alnDirVectBits*/
+
+/*-------------------------------------------------------\
+| Fun-04: alnDirVectPickBits
+|   - Finds the largest penalty and picks the number of
+|     bits to score a matrix with
+| Input:
+|   - lenRefUL:
+|     o Number of reference bases to align
+|   - lenQryUL:
+|     o Number of query bases to align
+|   - diffBl:
+|     o 1: use the 8 bit difference kernel (byte matrix
+|          Needlemans only) when the 16 bit kernel can
+|          overflow
+|     o 0: only use the 16 and 32 bit kernels
+|   - settings:
+|     o alnSet structure with the gap penalties (after
+|       any -no-gap-extend change) and scoring matrix
+| Output:
+|   - Returns:
+|     o 8, 16, or 32 for the kernel to use
+|     o 0 if the scalar aligners have to be used
+\-------------------------------------------------------*/
+static char alnDirVectPickBits(
+   ulong lenRefUL,
+   ulong lenQryUL,
+   char diffBl,
+   struct alnSet *settings
+){
+   ulong ulBase = 0;
+   ulong ulCol = 0;
+   char bitsC = 0;
+   long maxPenL = settings->gapOpenC;
+
+   if(maxPenL < 0) maxPenL = -maxPenL;
+
+   if(settings->gapExtendC > maxPenL)
+      maxPenL = settings->gapExtendC;
+   else if(-settings->gapExtendC > maxPenL)
+      maxPenL = -settings->gapExtendC;
+
+   for(ulBase = 0; ulBase < defMatrixCol; ++ulBase)
+   { /*Loop: find the largest score in the matrix*/
+      for(ulCol = 0; ulCol < defMatrixCol; ++ulCol)
+      { /*Loop: check each column*/
+         if(settings->scoreMatrixC[ulBase][ulCol] > maxPenL)
+            maxPenL = settings->scoreMatrixC[ulBase][ulCol];
+
+         else if(
+            -settings->scoreMatrixC[ulBase][ulCol] > maxPenL
+         ) maxPenL = -settings->scoreMatrixC[ulBase][ulCol];
+      } /*Loop: check each column*/
+   } /*Loop: find the largest score in the matrix*/
+
+   bitsC = alnDirVectBits(lenRefUL, lenQryUL, maxPenL);
+
+   if(
+         diffBl
+      && bitsC != 16
+      && lenRefUL >= defNum32BitElms
+      && maxPenL <= defAlnDirDiffMaxPenI8
+   ) return 8; /*Differences do not grow with length*/
+
+   return bitsC;
+} /*alnDirVectPickBits*/
+
+/*-------------------------------------------------------\
+| Fun-05: alnDirVectFill
+|   - Fills in a direction matrix with the kernel picked
+|     by alnDirVectPickBits
+| Input:
+|   - refSeqStr:
+|     o C-string with the first reference base to align
+|   - lenRefUL:
+|     o Number of reference bases to align
+|   - qrySeqStr:
+|     o C-string with the first query base to align
+|   - lenQryUL:
+|     o Number of query bases to align
+|   - needleBl:
+|     o 1: Needleman alignment
+|     o 0: Waterman alignment
+|   - bitsC:
+|     o 8, 16, or 32; kernel to use (alnDirVectPickBits)
+|     o 8 is only for Needlemans with dirMatrix
+|   - dirMatrix:
+|     o Byte direction matrix to fill in (0 if using
+|       twoBitST)
+|   - twoBitST:
+|     o Two bit direction matrix to fill in (0 if using
+|       dirMatrix)
+|   - bestScoreL:
+|     o Will hold the best score (set to 0 for Waterman)
+|   - bestEndIndexUL:
+|     o Will hold the index of the best score
+|   - settings:
+|     o alnSet structure with the alignment settings
+| Output:
+|   - Modifies:
+|     o dirMatrix or twoBitST, bestScoreL, and
+|       bestEndIndexUL (see alnDirVectI32)
+|   - Returns:
+|     o 0 for no errors
+|     o 1 if the 8 bit kernel overflowed
+|     o 64 for memory errors
+\-------------------------------------------------------*/
+static char alnDirVectFill(
+   char *refSeqStr,   /*Reference sequence*/
+   ulong lenRefUL,    /*Number of reference bases*/
+   char *qrySeqStr,   /*Query sequence*/
+   ulong lenQryUL,    /*Number of query bases*/
+   char needleBl,     /*1: Needleman; 0: Waterman*/
+   char bitsC,        /*Kernel to use*/
+   char *dirMatrix,   /*Byte direction matrix or 0*/
+   struct twoBitAry *twoBitST, /*Two bit matrix or 0*/
+   long *bestScoreL,        /*Gets the best score*/
+   ulong *bestEndIndexUL,   /*Gets the best cell*/
+   struct alnSet *settings  /*Settings for alignment*/
+){
+   ulong profIndexAryUL[256];
+   ulong numProfUL = 0;
+   ulong ulBase = 0;
+   char errC = 0;
+
+   char *dirRowC = 0;
+   struct vectMemBlock memST;
+
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+      profIndexAryUL[ulBase] = 0;
+
+   /*Find the number of profiles I need*/
+   for(ulBase = 0; ulBase < lenQryUL; ++ulBase)
+   { /*Loop: find the bases in the query*/
+      if(profIndexAryUL[(uchar) qrySeqStr[ulBase]] == 0)
+      { /*If: this is a new base*/
+         ++numProfUL;
+         profIndexAryUL[(uchar) qrySeqStr[ulBase]] = 1;
+      } /*If: this is a new base*/
+   } /*Loop: find the bases in the query*/
+
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+      profIndexAryUL[ulBase] = 0;
+
+   /*Each kernel needs a profile for each base, four
+   ` striped rows, and one vector (lane 0 mask). A striped
+   ` row is at most one vector longer than the reference.
+   ` 32 bits is the largest element.
+   */
+   initVectMemBlock(&memST);
+
+   if(bitsC == 8)
+   { /*If: using the difference kernel*/
+      callocVectMemBlock(
+         &memST,
+           alnDirVectDiffLenI8(lenRefUL,lenQryUL,numProfUL)
+         * sizeof(int8_t)
+      );
+   } /*If: using the difference kernel*/
+
+   else
+   { /*Else: using a striped kernel*/
+      mallocVectMemBlock(
+         &memST,
+           (numProfUL + 5) * (lenRefUL + defNum8BitElms)
+         * sizeof(int32_t)
+      );
+   } /*Else: using a striped kernel*/
+
+   if(memST.freePtr == 0) return 64;
+
+   if(twoBitST != 0)
+   { /*If: I need a row buffer for the two bit matrix*/
+      dirRowC = malloc((lenRefUL + 1) * sizeof(char));
+
+      if(dirRowC == 0)
+      { /*If: I had a memory error*/
+         freeVectMemBlockBuff(&memST);
+         return 64;
+      } /*If: I had a memory error*/
+   } /*If: I need a row buffer for the two bit matrix*/
+
+   *bestScoreL = 0;
+   *bestEndIndexUL = 0;
+
+   if(bitsC == 8)
+      errC =
+         alnDirVectDiffI8(
+            refSeqStr,
+            lenRefUL,
+            qrySeqStr,
+            lenQryUL,
+            dirMatrix,
+            (int8_t *) memST.alnPtr,
+            profIndexAryUL,
+            bestScoreL,
+            bestEndIndexUL,
+            settings
+         );
+
+   else if(bitsC == 16)
+      alnDirVectI16(
+         refSeqStr,
+         lenRefUL,
+         qrySeqStr,
+         lenQryUL,
+         needleBl,
+         dirMatrix,
+         twoBitST,
+         dirRowC,
+         (int16_t *) memST.alnPtr,
+         profIndexAryUL,
+         bestScoreL,
+         bestEndIndexUL,
+         settings
+      );
+
+   else
+      alnDirVectI32(
+         refSeqStr,
+         lenRefUL,
+         qrySeqStr,
+         lenQryUL,
+         needleBl,
+         dirMatrix,
+         twoBitST,
+         dirRowC,
+         (int32_t *) memST.alnPtr,
+         profIndexAryUL,
+         bestScoreL,
+         bestEndIndexUL,
+         settings
+      );
+
+   free(dirRowC);
+   freeVectMemBlockBuff(&memST);
+   return errC;
+} /*alnDirVectFill*/
+
+/*-------------------------------------------------------\
+| Fun-06: alnDirVect
+|   - Does a Needleman or Waterman alignment with a byte
+|     direction matrix filled in with vectors
+| Input:
+|   - qryST:
+|     o seqStruct with the query sequence and the region
+|       to align (offsetUL and endAlnUL)
+|   - refST:
+|     o seqStruct with the reference sequence and the
+|       region to align (offsetUL and endAlnUL)
+|   - needleBl:
+|     o 1: Needleman alignment (NeedlemanAln)
+|     o 0: Waterman alignment (WatermanAln)
+|   - settings:
+|     o alnSet structure with the alignment settings
+| Output:
+|   - Returns:
+|     o alnMatrix structure with the direction matrix,
+|       the best score, and the index of the best score
+|       (scoreBitsC is the kernel used; 0 for scalar)
+|     o 0 for memory errors
+\-------------------------------------------------------*/
+static struct alnMatrix * alnDirVect(
+   struct seqStruct *qryST, /*query sequence and data*/
+   struct seqStruct *refST, /*ref sequence and data*/
+   char needleBl,           /*1: Needleman; 0: Waterman*/
+   struct alnSet *settings  /*Settings for alignment*/
+){
+   ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
+   ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
+   ulong lenMatrixUL = (lenRefUL + 1) * (lenQryUL + 1);
+   char bitsC = 0;
+   char errC = 0;
+
+   struct alnSet gapSetST; /*Settings with the gap penalty*/
+   struct alnMatrix *retMatrixST = 0;
+
+   if(
+         ! vectWaterDirBl(settings->bestDirC)
+      || settings->vectSetC == defVectScalar
+   ) return alnDirScalar(qryST, refST, needleBl, settings);
+
+   gapSetST = *settings;
+
+   /*No gap extension is a gap extension of gap open*/
+   if(gapSetST.noGapBl)
+      gapSetST.gapExtendC = gapSetST.gapOpenC;
+
+   bitsC =
+      alnDirVectPickBits(
+         lenRefUL,
+         lenQryUL,
+         needleBl,
+         &gapSetST
+      );
+
+   if(bitsC == 0)
+      return alnDirScalar(qryST, refST, needleBl, settings);
+
+   retMatrixST = malloc(sizeof(struct alnMatrix));
+   if(retMatrixST == 0) return 0;
+   initAlnMatrix(retMatrixST);
+
+   retMatrixST->dirMatrix =
+      malloc((lenMatrixUL + 1) * sizeof(char));
+
+   if(retMatrixST->dirMatrix == 0)
+   { /*If: Memory error*/
+      freeAlnMatrix(retMatrixST);
+      return 0;
+   } /*If: Memory error*/
+
+   retMatrixST->lenRefUL = lenRefUL;
+   retMatrixST->refOffsetUL = refST->offsetUL;
+
+   retMatrixST->lenQryUL = lenQryUL;
+   retMatrixST->qryOffsetUL = qryST->offsetUL;
+
+   errC =
+      alnDirVectFill(
+         refST->seqCStr + refST->offsetUL,
+         lenRefUL,
+         qryST->seqCStr + qryST->offsetUL,
+         lenQryUL,
+         needleBl,
+         bitsC,
+         retMatrixST->dirMatrix,
+         0,
+         &retMatrixST->bestScoreL,
+         &retMatrixST->bestEndIndexUL,
+         &gapSetST
+      );
+
+   if(errC == 1)
+   { /*If: the 8 bit differences overflowed*/
+      bitsC =
+         alnDirVectPickBits(lenRefUL,lenQryUL,0,&gapSetST);
+
+      if(bitsC == 0)
+      { /*If: only the scalar aligners can do this*/
+         freeAlnMatrix(retMatrixST);
+         return
+            alnDirScalar(qryST, refST, needleBl, settings);
+      } /*If: only the scalar aligners can do this*/
+
+      errC =
+         alnDirVectFill(
+            refST->seqCStr + refST->offsetUL,
+            lenRefUL,
+            qryST->seqCStr + qryST->offsetUL,
+            lenQryUL,
+            needleBl,
+            bitsC,
+            retMatrixST->dirMatrix,
+            0,
+            &retMatrixST->bestScoreL,
+            &retMatrixST->bestEndIndexUL,
+            &gapSetST
+         );
+   } /*If: the 8 bit differences overflowed*/
+
+   if(errC)
+   { /*If: I had a memory error*/
+      freeAlnMatrix(retMatrixST);
+      return 0;
+   } /*If: I had a memory error*/
+
+   retMatrixST->scoreBitsC = bitsC;
+   return retMatrixST;
+} /*alnDirVect*/
+
+/*-------------------------------------------------------\
+| Fun-07: alnDirVectTwoBit
+|   - Does a Needleman or Waterman alignment with a two
+|     bit direction matrix filled in with vectors
+| Input:
+|   - qryST:
+|     o seqStruct with the query sequence and the region
+|       to align (offsetUL and endAlnUL)
+|   - refST:
+|     o seqStruct with the reference sequence and the
+|       region to align (offsetUL and endAlnUL)
+|   - needleBl:
+|     o 1: Needleman alignment (NeedleTwoBit)
+|     o 0: Waterman alignment (WaterTwoBit)
+|   - settings:
+|     o alnSet structure with the alignment settings
+| Output:
+|   - Returns:
+|     o alnMatrixTwoBit structure with the direction
+|       matrix, the best score, and the index of the best
+|       score (scoreBitsC is the kernel used)
+|     o 0 for memory errors
+\-------------------------------------------------------*/
+static struct alnMatrixTwoBit * alnDirVectTwoBit(
+   struct seqStruct *qryST, /*query sequence and data*/
+   struct seqStruct *refST, /*ref sequence and data*/
+   char needleBl,           /*1: Needleman; 0: Waterman*/
+   struct alnSet *settings  /*Settings for alignment*/
+){
+   ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
+   ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
+   ulong lenMatrixUL = (lenRefUL + 1) * (lenQryUL + 1);
+   char bitsC = 0;
+
+   struct alnSet gapSetST; /*Settings with the gap penalty*/
+   struct alnMatrixTwoBit *retMatrixST = 0;
+
+   if(
+         ! vectWaterDirBl(settings->bestDirC)
+      || settings->vectSetC == defVectScalar
+   ) return
+        alnDirScalarTwoBit(qryST,refST,needleBl,settings);
+
+   gapSetST = *settings;
+
+   /*No gap extension is a gap extension of gap open*/
+   if(gapSetST.noGapBl)
+      gapSetST.gapExtendC = gapSetST.gapOpenC;
+
+   bitsC =
+      alnDirVectPickBits(lenRefUL,lenQryUL,0,&gapSetST);
+
+   if(bitsC == 0)
+      return
+        alnDirScalarTwoBit(qryST,refST,needleBl,settings);
+
+   retMatrixST = malloc(sizeof(struct alnMatrixTwoBit));
+   if(retMatrixST == 0) return 0;
+   initAlnMatrixTwoBit(retMatrixST);
+
+   retMatrixST->dirMatrix = makeTwoBit((lenMatrixUL + 1), 0);
+
+   if(retMatrixST->dirMatrix == 0)
+   { /*If: Memory error*/
+      freeAlnMatrixTwoBit(retMatrixST);
+      return 0;
+   } /*If: Memory error*/
+
+   retMatrixST->lenRefUL = lenRefUL;
+   retMatrixST->refOffsetUL = refST->offsetUL;
+
+   retMatrixST->lenQryUL = lenQryUL;
+   retMatrixST->qryOffsetUL = qryST->offsetUL;
+
+   if(
+      alnDirVectFill(
+         refST->seqCStr + refST->offsetUL,
+         lenRefUL,
+         qryST->seqCStr + qryST->offsetUL,
+         lenQryUL,
+         needleBl,
+         bitsC,
+         0,
+         retMatrixST->dirMatrix,
+         &retMatrixST->bestScoreL,
+         &retMatrixST->bestEndIndexUL,
+         &gapSetST
+      )
+   ){ /*If: I had a memory error*/
+      freeAlnMatrixTwoBit(retMatrixST);
+      return 0;
+   } /*If: I had a memory error*/
+
+   retMatrixST->scoreBitsC = bitsC;
+   return retMatrixST;
+} /*alnDirVectTwoBit*/
+
+#endif /*DEFNOVECT*/
+#endif
@@ -0,0 +1,619 @@
+/*########################################################
+# Name alnDirVectDiffI8
+# Use:
+#  o Holds the 8 bit difference recurrence (Suzuki and
+#    Kasahara) vector kernel that fills in the direction
+#    matrix for a Needleman alignment (see alnDirVect.h)
+#  o Only the differences between a cell and the cell
+#    above (dV) and the cell to the left (dH) are kept.
+#    These are set by the scores and gap penalties, not
+#    the length of the sequences, so they fit in 8 bits
+#    for any sequence length.
+#  o Cells on an anti-diagonal do not depend on each other,
+#    so each anti-diagonal is scored with one vector per
+#    defNum8BitElms cells. No lazy-F loop is needed.
+#  o The snp, insertion, and deletion scores are found
+#    relative to the diagonal cell:
+#    - snp: score of the query and reference bases
+#    - ins: dH of the cell above + gap penalty
+#    - del: dV of the cell to the left + gap penalty
+#    The best (T) gives dV = T - dH(above) and
+#    dH = T - dV(left). The Needleman score is the gap row
+#    score of the last column plus each dV in that column.
+#  o A Waterman needs the full score of each cell to find
+#    stops, so only Needlemans are done here
+#  o Differences are checked for overflow. If any go over
+#    defAlnDirDiffMaxI8, the kernel stops and returns 1
+#    so alnDirVect can use the 16/32 bit kernels.
+# Libraries:
+#   - "genAlnDirVect.h"                (No .c file)
+#   o "../general/twoBitArrays.h"      (No .c file)
+#   o "../general/alnSetStruct.h"      (No .c file)
+#   o "../general/alnSeqDefaults.h"    (No .c file)
+#   o "../general/dataTypeShortHand.h" (No .c file)
+#   o "../vectWrap/vectWrap.h"         (No .c file)
+# C Standard libraries:
+#   - <stdint.h>
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+' o macro-01 alnDirVectDiffLenI8:
+'   - Finds the number of int8_t's alnDirVectDiffI8 needs
+'     in its buffer
+' o macro-02 alnDirVectDiffSegI8:
+'   - Scores one vector of cells on an anti-diagonal and
+'     finds their directions and differences
+' o fun-03 alnDirVectDiffI8:
+'   - Fills in a Needleman direction matrix with 8 bit
+'     differences
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#ifndef ALN_DIR_VECT_DIFF_I8_H
+#define ALN_DIR_VECT_DIFF_I8_H
+
+#include <stdint.h>
+
+#include "genAlnDirVect.h"
+
+#ifndef DEFNOVECT
+
+/*Largest score or gap penalty the 8 bit kernel takes.
+` With differences kept in +-defAlnDirDiffMaxI8, adding
+` a gap opening and gap extension can not overflow 8
+` bits.
+*/
+#define defAlnDirDiffMaxPenI8 20
+#define defAlnDirDiffMaxI8 64
+
+/*-------------------------------------------------------\
+| Macro-01: alnDirVectDiffLenI8
+|   - Finds the number of int8_t's alnDirVectDiffI8 needs
+|     in its buffer
+| Input:
+|   - lenRefUL:
+|     o Number of reference bases to align
+|   - lenQryUL:
+|     o Number of query bases to align
+|   - numProfUL:
+|     o Number of different bases in the query
+| Output:
+|   - Returns:
+|     o Number of int8_t's to allocate
+| Note:
+|   - Each profile and anti-diagonal has one vector of
+|     padding on each end, so vectors that go past the
+|     matrix edge stay in the buffer
+\-------------------------------------------------------*/
+#define alnDirVectDiffLenI8(lenRefUL,lenQryUL,numProfUL)(\
+     (numProfUL) * ((lenRefUL) + 2 * defNum8BitElms)\
+   + 4 * ((lenQryUL) + 2 * defNum8BitElms + 2)\
+   + 2 * defNum8BitElms\
+) /*alnDirVectDiffLenI8*/
+
+/*-------------------------------------------------------\
+| Macro-02: alnDirVectDiffSegI8
+|   - Scores one vector of cells on an anti-diagonal and
+|     finds their directions and differences
+|   - This follows the scalar aligners with the delInsSnp
+|     direction preference: a deletion wins ties with an
+|     insertion, and a snp has to beat both
+| Input:
+|   - profVI:
+|     o Scores for the query and reference bases
+|   - upDHVI:
+|     o dH of the cells above (insertions)
+|   - upDirVI:
+|     o Directions for the cells above
+|   - leftDVVI:
+|     o dV of the cells to the left (deletions)
+|   - leftDirVI:
+|     o Directions for the cells to the left
+|   - openVI:
+|     o Gap opening penalty
+|   - gapDiffVI:
+|     o Gap extension penalty - gap opening penalty
+|   - oneVI:
+|     o 1 in every element
+|   - threeVI:
+|     o 3 (defMvSnp) in every element
+|   - dVVI:
+|     o Will hold score - score of the cell above
+|   - dHVI:
+|     o Will hold score - score of the cell to the left
+|   - dirVI:
+|     o Will hold the direction for each cell
+| Output:
+|   - Modifies:
+|     o dVVI, dHVI, and dirVI
+| Note:
+|   - dVVI and dHVI use saturated subtraction, so an
+|     overflow is seen as a difference over
+|     defAlnDirDiffMaxI8
+\-------------------------------------------------------*/
+#define alnDirVectDiffSegI8(\
+   profVI,     /*Snp scores*/\
+   upDHVI,     /*dH of cells above*/\
+   upDirVI,    /*Directions above*/\
+   leftDVVI,   /*dV of cells to the left*/\
+   leftDirVI,  /*Directions to the left*/\
+   openVI,     /*Gap opening penalty*/\
+   gapDiffVI,  /*gap extension - gap open*/\
+   oneVI,      /*1 in every element*/\
+   threeVI,    /*3 in every element*/\
+   dVVI,       /*Gets dV*/\
+   dHVI,       /*Gets dH*/\
+   dirVI       /*Gets directions*/\
+){ /*alnDirVectDiffSegI8*/\
+   vectI8 macroInsVI =\
+      add_vectI8_retVectI8(\
+         add_vectI8_retVectI8((upDHVI), (openVI)),\
+         andNot_vectI8_retVectI8(\
+            mask8_retVectI8(\
+               cmpeq_vectI8_retMask8((upDirVI), (threeVI))\
+            ),\
+            (gapDiffVI)\
+         )\
+      ); /*Gaps after a gap (not a snp) are extended*/\
+   \
+   vectI8 macroDelVI =\
+      add_vectI8_retVectI8(\
+         add_vectI8_retVectI8((leftDVVI), (openVI)),\
+         andNot_vectI8_retVectI8(\
+            mask8_retVectI8(\
+               cmpeq_vectI8_retMask8((leftDirVI),(threeVI))\
+            ),\
+            (gapDiffVI)\
+         )\
+      );\
+   \
+   vectI8 macroSnpBlVI;\
+   vectI8 macroBestVI;\
+   \
+   (dirVI) =\
+      add_vectI8_retVectI8(\
+         and_vectI8_retVectI8(\
+            mask8_retVectI8(\
+               cmpgt_vectI8_retMask8(\
+                  macroInsVI,\
+                  macroDelVI\
+               )\
+            ),\
+            (oneVI)\
+         ),\
+         (oneVI)\
+      ); /*defMvDel (1) or defMvIns (2); dels win ties*/\
+   \
+   macroBestVI =\
+      max_vectI8_retVectI8(macroDelVI, macroInsVI);\
+   \
+   macroSnpBlVI =\
+      mask8_retVectI8(\
+         cmpgt_vectI8_retMask8((profVI), macroBestVI)\
+      ); /*Snps have to be better*/\
+   \
+   macroBestVI =\
+      max_vectI8_retVectI8(macroBestVI, (profVI));\
+   \
+   (dirVI) =\
+      or_vectI8_retVectI8(\
+         (dirVI),\
+         and_vectI8_retVectI8(macroSnpBlVI, (threeVI))\
+      );\
+   \
+   (dVVI) = subSat_vectI8_retVectI8(macroBestVI, (upDHVI));\
+   (dHVI) =\
+      subSat_vectI8_retVectI8(macroBestVI, (leftDVVI));\
+} /*alnDirVectDiffSegI8*/
+
+/*-------------------------------------------------------\
+| Fun-03: alnDirVectDiffI8
+|   - Fills in a Needleman direction matrix with 8 bit
+|     differences on anti-diagonals
+| Input:
+|   - refSeqStr:
+|     o C-string with the first reference base to align
+|   - lenRefUL:
+|     o Number of reference bases to align
+|   - qrySeqStr:
+|     o C-string with the first query base to align
+|   - lenQryUL:
+|     o Number of query bases to align
+|   - dirMatrix:
+|     o Byte direction matrix to fill in. It must hold
+|       (lenRefUL + 1) * (lenQryUL + 1) + 1 directions.
+|   - buffAryI:
+|     o Buffer set to 0 to hold the reference profiles
+|       and the anti-diagonals. It must hold
+|       alnDirVectDiffLenI8(lenRefUL, lenQryUL, profiles)
+|       int8_t's
+|   - profIndexAryUL:
+|     o Array of 256 ulongs set to 0. This is used to map
+|       query bases to their profile and is set back to 0
+|       before returning
+|   - bestScoreL:
+|     o Will hold the score of the last cell
+|   - bestEndIndexUL:
+|     o Will hold the index of the last cell
+|   - settings:
+|     o alnSet structure with the gap penalties and the
+|       scoring matrix. Each must be within
+|       +-defAlnDirDiffMaxPenI8.
+| Output:
+|   - Modifies:
+|     o dirMatrix to have the same directions as
+|       NeedlemanAln
+|     o bestScoreL and bestEndIndexUL
+|   - Returns:
+|     o 0 for no errors
+|     o 1 if a difference overflowed (dirMatrix is only
+|       partly filled in)
+\-------------------------------------------------------*/
+static char alnDirVectDiffI8(
+   char *refSeqStr,   /*Reference sequence*/
+   ulong lenRefUL,    /*Number of reference bases*/
+   char *qrySeqStr,   /*Query sequence*/
+   ulong lenQryUL,    /*Number of query bases*/
+   char *dirMatrix,   /*Byte direction matrix*/
+   int8_t *buffAryI,        /*Vector aligned buffer*/
+   ulong *profIndexAryUL,   /*Maps bases to profiles*/
+   long *bestScoreL,        /*Gets the score*/
+   ulong *bestEndIndexUL,   /*Gets the last cell*/
+   struct alnSet *settings  /*Settings for alignment*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-03 TOC: alnDirVectDiffI8
+   '  - Fills in a Needleman direction matrix with 8 bit
+   '    differences on anti-diagonals
+   '  o fun-03 sec-01:
+   '    - Variable declerations
+   '  o fun-03 sec-02:
+   '    - Build the profiles and the gap row and column
+   '  o fun-03 sec-03:
+   '    - Score each anti-diagonal
+   '  o fun-03 sec-04:
+   '    - Find the last cell and clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-03 Sec-01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*Elements in a profile (reference is reversed) and
+   ` in an anti-diagonal (by query base); see
+   ` alnDirVectDiffLenI8
+   */
+   ulong lenProfUL = lenRefUL + 2 * defNum8BitElms;
+   ulong lenDiagUL = lenQryUL + 2 * defNum8BitElms + 2;
+   ulong lenRowUL = lenRefUL + 1; /*Row in dirMatrix*/
+
+   ulong diagUL = 0;    /*Anti-diagonal on (query + ref)*/
+   ulong firstUL = 0;   /*First query base on diagonal*/
+   ulong lastUL = 0;    /*Last query base on diagonal*/
+   long qryOnL = 0;     /*First query base in vector*/
+   long endL = 0;       /*Query base after vector*/
+   ulong ulBase = 0;
+   ulong ulElm = 0;
+   ulong maskUL = 0;
+   ulong numProfUL = 0;
+   long profOffL = 0;   /*Reversed reference of lane 0*/
+
+   int8_t *profAryI = 0;  /*Reversed reference profiles*/
+   int8_t *qryProfAryI = 0;/*Profile number of each base*/
+   int8_t *dVAryI = 0;    /*dV (by query base)*/
+   int8_t *dHAryI = 0;    /*dH (by query base)*/
+   int8_t *dirAryI = 0;   /*Directions (by query base)*/
+   int8_t *laneAryI = 0;  /*Lane number of each element*/
+   int8_t *outDirAryI = 0;/*Directions to copy out*/
+
+   vectI8 oneVI = set1_I8_retVectI8(1);
+   vectI8 threeVI = set1_I8_retVectI8(defMvSnp);
+   vectI8 zeroVI = zero_retVectI8();
+   vectI8 maxVI = set1_I8_retVectI8(defAlnDirDiffMaxI8);
+   vectI8 minVI = set1_I8_retVectI8(-defAlnDirDiffMaxI8);
+
+   vectI8 openVI = set1_I8_retVectI8(settings->gapOpenC);
+   vectI8 gapDiffVI =
+      set1_I8_retVectI8(
+         settings->gapExtendC - settings->gapOpenC
+      );
+
+   vectI8 laneVI;
+   vectI8 qryVI;
+   vectI8 profVI;
+   vectI8 dVVI;
+   vectI8 dHVI;
+   vectI8 dirVI;
+   vectI8 overVI; /*-1 for differences that overflowed*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-03 Sec-02:
+   ^  - Build the profiles and the gap row and column
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(ulBase = 0; ulBase < lenQryUL; ++ulBase)
+   { /*Loop: find the bases in the query*/
+      if(profIndexAryUL[(uchar) qrySeqStr[ulBase]] == 0)
+      { /*If: this is a new base*/
+         ++numProfUL;
+         profIndexAryUL[(uchar) qrySeqStr[ulBase]] =
+            numProfUL;
+      } /*If: this is a new base*/
+   } /*Loop: find the bases in the query*/
+
+   profAryI = buffAryI;
+   qryProfAryI = profAryI + numProfUL * lenProfUL;
+   dVAryI = qryProfAryI + lenDiagUL;
+   dHAryI = dVAryI + lenDiagUL;
+   dirAryI = dHAryI + lenDiagUL;
+   laneAryI = dirAryI + lenDiagUL;
+   outDirAryI = laneAryI + defNum8BitElms;
+
+   /*Element defNum8BitElms + k is reference base
+   ` lenRefUL - 1 - k, so the cells on an anti-diagonal
+   ` (query going up, reference going down) are in order
+   */
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+   { /*Loop: build the profile for each query base*/
+      if(profIndexAryUL[ulBase] == 0) continue;
+
+      for(ulElm = 0; ulElm < lenRefUL; ++ulElm)
+         profAryI[
+              (profIndexAryUL[ulBase] - 1) * lenProfUL
+            + defNum8BitElms
+            + ulElm
+         ] =
+            getBaseScore(
+               (char) ulBase,
+               refSeqStr[lenRefUL - 1 - ulElm],
+               settings
+            );
+   } /*Loop: build the profile for each query base*/
+
+   /*Query base 1 (index 0) is at defNum8BitElms + 1*/
+   for(ulBase = 0; ulBase < lenQryUL; ++ulBase)
+      qryProfAryI[defNum8BitElms + 1 + ulBase] =
+         (int8_t)
+         profIndexAryUL[(uchar) qrySeqStr[ulBase]];
+
+   for(ulElm = 0; ulElm < defNum8BitElms; ++ulElm)
+      laneAryI[ulElm] = (int8_t) ulElm;
+
+   laneVI = loadu_I8Ary_retVectI8(laneAryI);
+
+   /*Move the anti-diagonals so query base 0 (the gap
+   ` row) is at index 0
+   */
+   dVAryI += defNum8BitElms + 1;
+   dHAryI += defNum8BitElms + 1;
+   dirAryI += defNum8BitElms + 1;
+   qryProfAryI += defNum8BitElms;
+
+   /*The gap row and column (same as NeedlemanAln)*/
+   dirMatrix[0] = defMvStop;
+
+   for(ulElm = 1; ulElm <= lenRefUL; ++ulElm)
+      dirMatrix[ulElm] = defMvDel;
+
+   for(ulBase = 1; ulBase <= lenQryUL; ++ulBase)
+      dirMatrix[ulBase * lenRowUL] = defMvIns;
+
+   /*Score of the last column in the gap row*/
+   *bestScoreL =
+        settings->gapOpenC
+      + (long) (lenRefUL - 1) * settings->gapExtendC;
+
+   overVI = zeroVI;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-03 Sec-03:
+   ^  - Score each anti-diagonal
+   ^  o fun-03 sec-03 sub-01:
+   ^    - Set the gap row and column cells
+   ^  o fun-03 sec-03 sub-02:
+   ^    - Score the cells on the anti-diagonal
+   ^  o fun-03 sec-03 sub-03:
+   ^    - Copy out the directions
+   ^  o fun-03 sec-03 sub-04:
+   ^    - Check for overflows and keep the last column
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(diagUL = 2; diagUL <= lenRefUL + lenQryUL; ++diagUL)
+   { /*Loop: score each anti-diagonal*/
+
+      /**************************************************\
+      * Fun-03 Sec-03 Sub-01:
+      *  - Set the gap row and column cells
+      \**************************************************/
+
+      /*The arrays hold the last anti-diagonal. Query
+      ` base 0 is the gap row cell and query base
+      ` diagUL - 1 is the gap column cell.
+      */
+      if(diagUL - 1 <= lenRefUL)
+      { /*If: the gap row cell is on this diagonal*/
+         dHAryI[0] =
+            diagUL == 2 ?
+               settings->gapOpenC : settings->gapExtendC;
+
+         dirAryI[0] = defMvDel;
+      } /*If: the gap row cell is on this diagonal*/
+
+      if(diagUL - 1 <= lenQryUL)
+      { /*If: the gap column cell is on this diagonal*/
+         dVAryI[diagUL - 1] =
+            diagUL == 2 ?
+               settings->gapOpenC : settings->gapExtendC;
+
+         dirAryI[diagUL - 1] = defMvIns;
+      } /*If: the gap column cell is on this diagonal*/
+
+      if(diagUL > lenRefUL) firstUL = diagUL - lenRefUL;
+      else firstUL = 1;
+
+      if(diagUL - 1 < lenQryUL) lastUL = diagUL - 1;
+      else lastUL = lenQryUL;
+
+      /**************************************************\
+      * Fun-03 Sec-03 Sub-02:
+      *  - Score the cells on the anti-diagonal
+      \**************************************************/
+
+      /*Vectors are done from the last query base to the
+      ` first, so each vector only overwrites cells the
+      ` vectors after it are done with
+      */
+      endL = (long) lastUL + 1;
+
+      while(endL > (long) firstUL)
+      { /*Loop: score each vector on the anti-diagonal*/
+         qryOnL = endL - defNum8BitElms;
+         profOffL =
+              (long) lenRefUL
+            - (long) diagUL
+            + qryOnL
+            + defNum8BitElms;
+
+         qryVI =
+            loadu_I8Ary_retVectI8(qryProfAryI + qryOnL);
+
+         profVI = zeroVI;
+
+         for(ulBase = 1; ulBase <= numProfUL; ++ulBase)
+         { /*Loop: get the scores for each query base*/
+            profVI =
+               or_vectI8_retVectI8(
+                  profVI,
+                  and_vectI8_retVectI8(
+                     mask8_retVectI8(
+                        cmpeq_vectI8_retMask8(
+                           qryVI,
+                           set1_I8_retVectI8((char) ulBase)
+                        )
+                     ),
+                     loadu_I8Ary_retVectI8(
+                          profAryI
+                        + (ulBase - 1) * lenProfUL
+                        + profOffL
+                     )
+                  )
+               );
+         } /*Loop: get the scores for each query base*/
+
+         alnDirVectDiffSegI8(
+            profVI,
+            loadu_I8Ary_retVectI8(dHAryI + qryOnL - 1),
+            loadu_I8Ary_retVectI8(dirAryI + qryOnL - 1),
+            loadu_I8Ary_retVectI8(dVAryI + qryOnL),
+            loadu_I8Ary_retVectI8(dirAryI + qryOnL),
+            openVI,
+            gapDiffVI,
+            oneVI,
+            threeVI,
+            dVVI,
+            dHVI,
+            dirVI
+         );
+
+         storeu_vectI8_retAryI8(dVAryI + qryOnL, dVVI);
+         storeu_vectI8_retAryI8(dHAryI + qryOnL, dHVI);
+         storeu_vectI8_retAryI8(dirAryI + qryOnL, dirVI);
+
+         dVVI =
+            or_vectI8_retVectI8(
+               mask8_retVectI8(
+                  cmpgt_vectI8_retMask8(dVVI, maxVI)
+               ),
+               mask8_retVectI8(
+                  cmpgt_vectI8_retMask8(minVI, dVVI)
+               )
+            );
+
+         dHVI =
+            or_vectI8_retVectI8(
+               mask8_retVectI8(
+                  cmpgt_vectI8_retMask8(dHVI, maxVI)
+               ),
+               mask8_retVectI8(
+                  cmpgt_vectI8_retMask8(minVI, dHVI)
+               )
+            );
+
+         /*Lanes before firstUL are off the matrix*/
+         overVI =
+            or_vectI8_retVectI8(
+               overVI,
+               and_vectI8_retVectI8(
+                  or_vectI8_retVectI8(dVVI, dHVI),
+                  mask8_retVectI8(
+                     cmpgt_vectI8_retMask8(
+                        laneVI,
+                        set1_I8_retVectI8(
+                           (char) (
+                                (long) firstUL
+                              - qryOnL
+                              - 1
+                           )
+                        )
+                     )
+                  )
+               )
+            );
+
+         /***********************************************\
+         * Fun-03 Sec-03 Sub-03:
+         *  - Copy out the directions
+         \***********************************************/
+
+         storeu_vectI8_retAryI8(outDirAryI, dirVI);
+
+         if(qryOnL < (long) firstUL)
+            ulElm = (ulong) ((long) firstUL - qryOnL);
+         else ulElm = 0;
+
+         /*Cell (query, diagUL - query) is at
+         ` query * (lenRefUL + 1) + diagUL - query
+         */
+         for(; ulElm < defNum8BitElms; ++ulElm)
+            dirMatrix[
+                 ((ulong) qryOnL + ulElm) * lenRefUL
+               + diagUL
+            ] = (char) outDirAryI[ulElm];
+
+         endL = qryOnL;
+      } /*Loop: score each vector on the anti-diagonal*/
+
+      /**************************************************\
+      * Fun-03 Sec-03 Sub-04:
+      *  - Check for overflows and keep the last column
+      \**************************************************/
+
+      store_mask8_retUL(
+         maskUL,
+         cmpgt_vectI8_retMask8(zeroVI, overVI)
+      ); /*overVI is -1 (< 0) for overflows*/
+
+      if(maskUL != 0) break;
+
+      if(diagUL > lenRefUL)
+         *bestScoreL += dVAryI[diagUL - lenRefUL];
+   } /*Loop: score each anti-diagonal*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-03 Sec-04:
+   ^  - Find the last cell and clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   *bestEndIndexUL = lenQryUL * lenRowUL + lenRefUL;
+
+   /*The matrix has one extra direction (a stop)*/
+   dirMatrix[*bestEndIndexUL + 1] = defMvStop;
+
+   for(ulBase = 0; ulBase < lenQryUL; ++ulBase)
+      profIndexAryUL[(uchar) qrySeqStr[ulBase]] = 0;
+
+   return maskUL != 0;
+} /*alnDirVectDiffI8*/
+
+#endif /*DEFNOVECT*/
+#endif
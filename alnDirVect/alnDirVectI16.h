@@ -0,0 +1,683 @@
+/*########################################################
+# Name alnDirVectI16
+# Use:
+#  o Holds the 16 bit vector kernel that fills in the
+#    direction matrix for a Needleman or Waterman
+#    alignment (see alnDirVect.h)
+#  o The reference is striped (Farrar) across 16 bit
+#    vectors and each query base (row) is scored against
+#    the full reference in one pass. A lazy-F loop then
+#    corrects the deletions that cross segments. The
+#    directions come from the compare masks of the max
+#    steps and each finished row is copied into the byte
+#    direction matrix or packed into the two bit matrix.
+#  o There are no overflow checks. alnDirVect only uses
+#    this when every score in the matrix fits in 16 bits
+#    (see alnDirVectBits), else it uses the 32 bit kernel.
+# Libraries:
+#   - "genAlnDirVect.h"                (No .c file)
+#   o "../general/twoBitArrays.h"      (No .c file)
+#   o "../general/alnSetStruct.h"      (No .c file)
+#   o "../general/alnSeqDefaults.h"    (No .c file)
+#   o "../general/dataTypeShortHand.h" (No .c file)
+#   o "../vectWrap/vectWrap.h"         (No .c file)
+# C Standard libraries:
+#   - <stdint.h>
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+' o macro-01 alnDirVectSegI16:
+'   - Scores one segment (vector) of the striped reference
+'     for a single query base and finds its directions
+' o fun-02 alnDirVectI16:
+'   - Fills in a direction matrix with 16 bit vectors
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#ifndef ALN_DIR_VECT_I16_H
+#define ALN_DIR_VECT_I16_H
+
+#include <stdint.h>
+
+#include "genAlnDirVect.h"
+
+#ifndef DEFNOVECT
+
+/*Smallest 16 bit score; is never added to*/
+#define defAlnDirMinI16 (-32767 - 1)
+
+/*-------------------------------------------------------\
+| Macro-01: alnDirVectSegI16
+|   - Scores one segment (vector) of the striped reference
+|     for a single query base and finds its directions
+|   - This follows the scalar aligners with the delInsSnp
+|     direction preference: a deletion wins ties with an
+|     insertion, and a snp has to beat both
+| Input:
+|   - diagVI:
+|     o Scores for the cells on the diagnol (snp)
+|   - profVI:
+|     o Reference profile scores for this query base
+|   - upVI:
+|     o Scores for the cells above (insertions)
+|   - upDirVI:
+|     o Directions for the cells above
+|   - delVI:
+|     o Deletion score (cell to the left + gap penalty)
+|   - floorVI:
+|     o 0 for a Waterman (stops) or defAlnDirMinI16 for a
+|       Needleman
+|   - openVI:
+|     o Gap opening penalty
+|   - gapDiffVI:
+|     o Gap extension penalty - gap opening penalty
+|   - oneVI:
+|     o 1 in every element
+|   - threeVI:
+|     o 3 (defMvSnp) in every element
+|   - scoreVI:
+|     o Will hold the score for each cell
+|   - dirVI:
+|     o Will hold the direction for each cell
+|   - nextDelVI:
+|     o Will hold the deletion score for the cells to the
+|       right
+| Output:
+|   - Modifies:
+|     o scoreVI, dirVI, and nextDelVI
+\-------------------------------------------------------*/
+#define alnDirVectSegI16(\
+   diagVI,     /*Diagnol scores*/\
+   profVI,     /*Reference profile for the query base*/\
+   upVI,       /*Scores above*/\
+   upDirVI,    /*Directions above*/\
+   delVI,      /*Deletion scores*/\
+   floorVI,    /*0 for Waterman, min for Needleman*/\
+   openVI,     /*Gap opening penalty*/\
+   gapDiffVI,  /*gap extension - gap open*/\
+   oneVI,      /*1 in every element*/\
+   threeVI,    /*3 in every element*/\
+   scoreVI,    /*Gets scores*/\
+   dirVI,      /*Gets directions*/\
+   nextDelVI   /*Gets deletion scores for next segment*/\
+){ /*alnDirVectSegI16*/\
+   vectI16 macroSnpVI =\
+      add_vectI16_retVectI16((diagVI), (profVI));\
+   \
+   vectI16 macroInsVI =\
+      add_vectI16_retVectI16(\
+         add_vectI16_retVectI16((upVI), (openVI)),\
+         andNot_vectI16_retVectI16(\
+            mask16_retVectI16(\
+               cmpeq_vectI16_retMask16((upDirVI),(threeVI))\
+            ),\
+            (gapDiffVI)\
+         )\
+      ); /*Gaps after a gap (not a snp) are extended*/\
+   \
+   vectI16 macroSnpBlVI;\
+   \
+   (dirVI) =\
+      add_vectI16_retVectI16(\
+         and_vectI16_retVectI16(\
+            mask16_retVectI16(\
+               cmpgt_vectI16_retMask16(macroInsVI,(delVI))\
+            ),\
+            (oneVI)\
+         ),\
+         (oneVI)\
+      ); /*defMvDel (1) or defMvIns (2); dels win ties*/\
+   \
+   (scoreVI) = max_vectI16_retVectI16((delVI), macroInsVI);\
+   (scoreVI) = max_vectI16_retVectI16((scoreVI), (floorVI));\
+   \
+   macroSnpBlVI =\
+      mask16_retVectI16(\
+         cmpgt_vectI16_retMask16(macroSnpVI, (scoreVI))\
+      ); /*Snps have to be better*/\
+   \
+   (scoreVI) = max_vectI16_retVectI16((scoreVI), macroSnpVI);\
+   \
+   (dirVI) =\
+      or_vectI16_retVectI16(\
+         (dirVI),\
+         and_vectI16_retVectI16(macroSnpBlVI, (threeVI))\
+      );\
+   \
+   (dirVI) =\
+      and_vectI16_retVectI16(\
+         (dirVI),\
+         mask16_retVectI16(\
+            cmpgt_vectI16_retMask16((scoreVI), (floorVI))\
+         )\
+      ); /*Stops (defMvStop is 0) for a Waterman*/\
+   \
+   (nextDelVI) =\
+      add_vectI16_retVectI16(\
+         add_vectI16_retVectI16((scoreVI), (openVI)),\
+         andNot_vectI16_retVectI16(macroSnpBlVI,(gapDiffVI))\
+      );\
+} /*alnDirVectSegI16*/
+
+/*-------------------------------------------------------\
+| Fun-02: alnDirVectI16
+|   - Fills in a direction matrix for a Needleman or
+|     Waterman alignment with a striped reference and 16
+|     bit vectors
+| Input:
+|   - refSeqStr:
+|     o C-string with the first reference base to align
+|   - lenRefUL:
+|     o Number of reference bases to align
+|   - qrySeqStr:
+|     o C-string with the first query base to align
+|   - lenQryUL:
+|     o Number of query bases to align
+|   - needleBl:
+|     o 1: Needleman alignment
+|     o 0: Waterman alignment
+|   - dirMatrix:
+|     o Byte direction matrix to fill in (0 if using
+|       twoBitST). It must hold (lenRefUL + 1) *
+|       (lenQryUL + 1) + 1 directions.
+|   - twoBitST:
+|     o Two bit direction matrix to fill in (0 if using
+|       dirMatrix). It must hold the same number of
+|       elements as dirMatrix and be at its first element.
+|   - dirRowC:
+|     o Buffer of lenRefUL + 1 chars to build the rows of
+|       the two bit matrix in
+|   - buffAryI:
+|     o Vector aligned buffer to hold the reference
+|       profile and the striped rows. It must hold
+|       (number profiles + 5) * (lenRefUL + vector length)
+|       int16_t's
+|   - profIndexAryUL:
+|     o Array of 256 ulongs set to 0. This is used to map
+|       query bases to their profile and is set back to 0
+|       before returning
+|   - bestScoreL:
+|     o Will hold the best score (Waterman) or the score
+|       of the last cell (Needleman)
+|   - bestEndIndexUL:
+|     o Will hold the index of the best score in the
+|       direction matrix
+|   - settings:
+|     o alnSet structure with the gap penalties and the
+|       scoring matrix
+| Output:
+|   - Modifies:
+|     o dirMatrix or twoBitST to have the same directions
+|       as NeedlemanAln/WatermanAln (twoBitST is left on
+|       the last cell, like NeedleTwoBit/WaterTwoBit)
+|     o bestScoreL and bestEndIndexUL
+\-------------------------------------------------------*/
+static void alnDirVectI16(
+   char *refSeqStr,   /*Reference sequence*/
+   ulong lenRefUL,    /*Number of reference bases*/
+   char *qrySeqStr,   /*Query sequence*/
+   ulong lenQryUL,    /*Number of query bases*/
+   char needleBl,     /*1: Needleman; 0: Waterman*/
+   char *dirMatrix,   /*Byte direction matrix or 0*/
+   struct twoBitAry *twoBitST, /*Two bit matrix or 0*/
+   char *dirRowC,     /*Row buffer for twoBitST*/
+   int16_t *buffAryI,       /*Vector aligned buffer*/
+   ulong *profIndexAryUL,   /*Maps bases to profiles*/
+   long *bestScoreL,        /*Gets the best score*/
+   ulong *bestEndIndexUL,   /*Gets the best cell*/
+   struct alnSet *settings  /*Settings for alignment*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-02 TOC: alnDirVectI16
+   '  - Fills in a direction matrix with 16 bit vectors
+   '  o fun-02 sec-01:
+   '    - Variable declerations
+   '  o fun-02 sec-02:
+   '    - Build the reference profile
+   '  o fun-02 sec-03:
+   '    - Set up the gap row and constant vectors
+   '  o fun-02 sec-04:
+   '    - Score each query base
+   '  o fun-02 sec-05:
+   '    - Find the last cell and clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*Number of vectors in one striped row*/
+   ulong lenSegUL =
+      (lenRefUL + defNum16BitElms - 1) / defNum16BitElms;
+
+   /*Number of elements in one striped row*/
+   ulong lenRowUL = lenSegUL * defNum16BitElms;
+
+   ulong ulQry = 0;
+   ulong ulSeg = 0;
+   ulong ulElm = 0;
+   ulong ulBase = 0;
+   ulong colUL = 0;
+   ulong offsetUL = 0;
+   ulong maskUL = 0;
+   ulong numProfUL = 0;
+   ulong indexUL = 0;   /*Index of the row in the matrix*/
+
+   int16_t gapColI = 0;   /*Score of the indel column*/
+   int16_t lastGapColI = 0;
+   int16_t firstDelI = 0; /*Deletion for the 1st column*/
+
+   int16_t *profAryI = 0;  /*Reference profile*/
+   int16_t *profOnI = 0;   /*Profile for query base*/
+   int16_t *lane0AryI = 0; /*-1 for lane 0, else 0*/
+
+   int16_t *scoreAryI = 0;    /*Current row*/
+   int16_t *dirAryI = 0;
+   int16_t *oldScoreAryI = 0; /*Last row*/
+   int16_t *oldDirAryI = 0;
+   int16_t *swapPtrI = 0;
+
+   char *rowC = 0;  /*Row of directions to fill in*/
+
+   vectI16 zeroVI = zero_retVectI16();
+   vectI16 oneVI = set1_I16_retVectI16(1);
+   vectI16 threeVI = set1_I16_retVectI16(defMvSnp);
+   vectI16 minVI = set1_I16_retVectI16(defAlnDirMinI16);
+
+   vectI16 floorVI;
+   vectI16 openVI;
+   vectI16 gapDiffVI;
+   vectI16 lane0VI;
+
+   vectI16 firstDelVI; /*Deletion from the indel column*/
+   vectI16 firstDiagVI;
+   vectI16 diagVI;
+   vectI16 upVI;
+   vectI16 delVI;
+   vectI16 scoreVI;
+   vectI16 dirVI;
+   vectI16 sameVI;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-02:
+   ^  - Build the reference profile
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(ulQry = 0; ulQry < lenQryUL; ++ulQry)
+   { /*Loop: find the bases in the query*/
+      if(profIndexAryUL[(uchar) qrySeqStr[ulQry]] == 0)
+      { /*If: this is a new base*/
+         ++numProfUL;
+         profIndexAryUL[(uchar) qrySeqStr[ulQry]] =
+            numProfUL;
+      } /*If: this is a new base*/
+   } /*Loop: find the bases in the query*/
+
+   profAryI = buffAryI;
+   scoreAryI = profAryI + numProfUL * lenRowUL;
+   dirAryI = scoreAryI + lenRowUL;
+   oldScoreAryI = dirAryI + lenRowUL;
+   oldDirAryI = oldScoreAryI + lenRowUL;
+   lane0AryI = oldDirAryI + lenRowUL;
+
+   /*Element ulElm in segment ulSeg is reference column
+   ` ulElm * lenSegUL + ulSeg (striped)
+   */
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+   { /*Loop: build the profile for each query base*/
+      if(profIndexAryUL[ulBase] == 0) continue;
+
+      profOnI =
+         profAryI + (profIndexAryUL[ulBase] - 1) * lenRowUL;
+
+      for(ulSeg = 0; ulSeg < lenSegUL; ++ulSeg)
+      { /*Loop: Fill in each segment*/
+         for(ulElm = 0; ulElm < defNum16BitElms; ++ulElm)
+         { /*Loop: Fill in each element*/
+            colUL = ulElm * lenSegUL + ulSeg;
+
+            if(colUL >= lenRefUL) *profOnI = 0;
+
+            else
+               *profOnI =
+                  getBaseScore(
+                     (char) ulBase,
+                     refSeqStr[colUL],
+                     settings
+                  );
+
+            ++profOnI;
+         } /*Loop: Fill in each element*/
+      } /*Loop: Fill in each segment*/
+   } /*Loop: build the profile for each query base*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-03:
+   ^  - Set up the gap row and constant vectors
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(ulSeg = 0; ulSeg < lenSegUL; ++ulSeg)
+   { /*Loop: set up each segment*/
+      for(ulElm = 0; ulElm < defNum16BitElms; ++ulElm)
+      { /*Loop: set up each element*/
+         colUL = ulElm * lenSegUL + ulSeg;
+         offsetUL = ulSeg * defNum16BitElms + ulElm;
+
+         if(! needleBl)
+         { /*If: this is a Waterman*/
+            oldScoreAryI[offsetUL] = 0;
+            oldDirAryI[offsetUL] = defMvStop;
+         } /*If: this is a Waterman*/
+
+         else
+         { /*Else: this is a Needleman*/
+            oldScoreAryI[offsetUL] =
+                 settings->gapOpenC
+               + (int16_t) colUL * settings->gapExtendC;
+
+            oldDirAryI[offsetUL] = defMvDel;
+         } /*Else: this is a Needleman*/
+      } /*Loop: set up each element*/
+   } /*Loop: set up each segment*/
+
+   for(ulElm = 0; ulElm < defNum16BitElms; ++ulElm)
+      lane0AryI[ulElm] = -(ulElm == 0);
+
+   lane0VI = load_I16Ary_retVectI16(lane0AryI);
+   openVI = set1_I16_retVectI16(settings->gapOpenC);
+
+   gapDiffVI =
+      set1_I16_retVectI16(
+         settings->gapExtendC - settings->gapOpenC
+      );
+
+   if(needleBl) floorVI = minVI;
+   else floorVI = zeroVI;
+
+   /*The gap row (same as NeedlemanAln/WatermanAln)*/
+   if(dirMatrix) rowC = dirMatrix;
+   else rowC = dirRowC;
+
+   rowC[0] = defMvStop;
+
+   for(colUL = 1; colUL <= lenRefUL; ++colUL)
+      rowC[colUL] = needleBl ? defMvDel : defMvStop;
+
+   if(twoBitST)
+      alnDirVectPackRow(rowC, lenRefUL + 1, twoBitST);
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-04:
+   ^  - Score each query base
+   ^  o fun-02 sec-04 sub-01:
+   ^    - Set up for the next query base
+   ^  o fun-02 sec-04 sub-02:
+   ^    - Score each segment (deletions stay in lane)
+   ^  o fun-02 sec-04 sub-03:
+   ^    - Lazy-F loop; move deletions across lanes
+   ^  o fun-02 sec-04 sub-04:
+   ^    - Copy out the directions and swap rows
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   lastGapColI = 0;            /*Corner of the matrix*/
+   gapColI = needleBl ? settings->gapOpenC : 0;
+
+   for(ulQry = 0; ulQry < lenQryUL; ++ulQry)
+   { /*Loop: score each query base*/
+
+      /**************************************************\
+      * Fun-02 Sec-04 Sub-01:
+      *  - Set up for the next query base
+      \**************************************************/
+
+      profOnI =
+           profAryI
+         +   (profIndexAryUL[(uchar) qrySeqStr[ulQry]] - 1)
+           * lenRowUL;
+
+      /*The indel column is always a gap for a Needleman,
+      ` so the first reference column gets an extended
+      ` deletion. The Waterman indel column is all stops
+      ` and starts with a deletion score of 0.
+      */
+      if(needleBl) firstDelI = gapColI+settings->gapExtendC;
+      else firstDelI = 0;
+
+      firstDelVI =
+         and_vectI16_retVectI16(
+            lane0VI,
+            set1_I16_retVectI16(firstDelI)
+         );
+
+      /*Segment 0 is the column after the last segment,
+      ` but shifted one element. Lane 0 is next to the
+      ` indel column.
+      */
+      offsetUL = (lenSegUL - 1) * defNum16BitElms;
+
+      firstDiagVI =
+         or_vectI16_retVectI16(
+            slvect_vectI16_retVectI16(
+               load_I16Ary_retVectI16(oldScoreAryI + offsetUL),
+               1
+            ),
+            and_vectI16_retVectI16(
+               lane0VI,
+               set1_I16_retVectI16(lastGapColI)
+            )
+         );
+
+      diagVI = firstDiagVI;
+
+      /*The first pass does not carry deletions between
+      ` lanes. The lazy-F loop fixes this.
+      */
+      delVI =
+         or_vectI16_retVectI16(
+            firstDelVI,
+            andNot_vectI16_retVectI16(lane0VI, minVI)
+         );
+
+      /**************************************************\
+      * Fun-02 Sec-04 Sub-02:
+      *  - Score each segment (deletions stay in lane)
+      \**************************************************/
+
+      for(ulSeg = 0; ulSeg < lenSegUL; ++ulSeg)
+      { /*Loop: score each segment*/
+         offsetUL = ulSeg * defNum16BitElms;
+
+         upVI = load_I16Ary_retVectI16(oldScoreAryI+offsetUL);
+
+         alnDirVectSegI16(
+            diagVI,
+            load_I16Ary_retVectI16(profOnI + offsetUL),
+            upVI,
+            load_I16Ary_retVectI16(oldDirAryI + offsetUL),
+            delVI,
+            floorVI,
+            openVI,
+            gapDiffVI,
+            oneVI,
+            threeVI,
+            scoreVI,
+            dirVI,
+            delVI
+         );
+
+         store_vectI16_retAryI16(scoreAryI+offsetUL,scoreVI);
+         store_vectI16_retAryI16(dirAryI + offsetUL, dirVI);
+
+         diagVI = upVI;
+      } /*Loop: score each segment*/
+
+      /**************************************************\
+      * Fun-02 Sec-04 Sub-03:
+      *  - Lazy-F loop; move deletions across lanes
+      \**************************************************/
+
+      /* Each segment is rescored with the deletion from
+      `  the lane before until no cell in a segment
+      `  changes. A segment with no changes means every
+      `  later segment was scored with the right
+      `  deletions. Directions are checked as well,
+      `  because a deletion can tie an insertion without
+      `  changing the score.
+      */
+      delVI =
+         or_vectI16_retVectI16(
+            slvect_vectI16_retVectI16(delVI, 1),
+            firstDelVI
+         );
+
+      diagVI = firstDiagVI;
+      ulSeg = 0;
+
+      while(1)
+      { /*Loop: Lazy-F loop*/
+         offsetUL = ulSeg * defNum16BitElms;
+
+         upVI = load_I16Ary_retVectI16(oldScoreAryI+offsetUL);
+
+         alnDirVectSegI16(
+            diagVI,
+            load_I16Ary_retVectI16(profOnI + offsetUL),
+            upVI,
+            load_I16Ary_retVectI16(oldDirAryI + offsetUL),
+            delVI,
+            floorVI,
+            openVI,
+            gapDiffVI,
+            oneVI,
+            threeVI,
+            scoreVI,
+            dirVI,
+            delVI
+         );
+
+         /*Check if any cell in this segment changed*/
+         sameVI =
+            and_vectI16_retVectI16(
+               mask16_retVectI16(
+                  cmpeq_vectI16_retMask16(
+                     scoreVI,
+                     load_I16Ary_retVectI16(scoreAryI+offsetUL)
+                  )
+               ),
+               mask16_retVectI16(
+                  cmpeq_vectI16_retMask16(
+                     dirVI,
+                     load_I16Ary_retVectI16(dirAryI+offsetUL)
+                  )
+               )
+            );
+
+         store_mask16_retUL(
+            maskUL,
+            cmpgt_vectI16_retMask16(zeroVI, sameVI)
+         ); /*sameVI is -1 (< 0) for unchanged cells*/
+
+         if(maskUL == defMvMask16) break;
+
+         store_vectI16_retAryI16(scoreAryI+offsetUL,scoreVI);
+         store_vectI16_retAryI16(dirAryI + offsetUL, dirVI);
+
+         diagVI = upVI;
+         ++ulSeg;
+
+         if(ulSeg == lenSegUL)
+         { /*If: I need to move to the next lane*/
+            delVI =
+               or_vectI16_retVectI16(
+                  slvect_vectI16_retVectI16(delVI, 1),
+                  firstDelVI
+               );
+
+            diagVI = firstDiagVI;
+            ulSeg = 0;
+         } /*If: I need to move to the next lane*/
+      } /*Loop: Lazy-F loop*/
+
+      /**************************************************\
+      * Fun-02 Sec-04 Sub-04:
+      *  - Copy out the directions and swap rows
+      \**************************************************/
+
+      indexUL += lenRefUL + 1;
+
+      if(dirMatrix) rowC = dirMatrix + indexUL;
+      rowC[0] = needleBl ? defMvIns : defMvStop;
+
+      colUL = 1;
+
+      for(ulElm = 0; ulElm < defNum16BitElms; ++ulElm)
+      { /*Loop: unstripe each lane*/
+         offsetUL = ulElm;
+
+         for(ulSeg = 0; ulSeg < lenSegUL; ++ulSeg)
+         { /*Loop: copy each reference column in lane*/
+            if(colUL > lenRefUL) break;
+
+            rowC[colUL] = (char) dirAryI[offsetUL];
+
+            /*Rows and columns are done in order, so only
+            ` taking better scores keeps the first best
+            ` score (like WatermanAln)
+            */
+            if(
+                  ! needleBl
+               && scoreAryI[offsetUL] > *bestScoreL
+            ){ /*If: this is a new best score*/
+               *bestScoreL = scoreAryI[offsetUL];
+               *bestEndIndexUL = indexUL + colUL;
+            } /*If: this is a new best score*/
+
+            offsetUL += defNum16BitElms;
+            ++colUL;
+         } /*Loop: copy each reference column in lane*/
+      } /*Loop: unstripe each lane*/
+
+      if(twoBitST)
+         alnDirVectPackRow(rowC, lenRefUL + 1, twoBitST);
+
+      lastGapColI = gapColI;
+      if(needleBl) gapColI += settings->gapExtendC;
+
+      swapPtrI = scoreAryI;
+      scoreAryI = oldScoreAryI;
+      oldScoreAryI = swapPtrI;
+
+      swapPtrI = dirAryI;
+      dirAryI = oldDirAryI;
+      oldDirAryI = swapPtrI;
+   } /*Loop: score each query base*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-05:
+   ^  - Find the last cell and clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(needleBl)
+   { /*If: this is a Needleman (ends at the corner)*/
+      *bestScoreL =
+         oldScoreAryI[
+              ((lenRefUL - 1) % lenSegUL) * defNum16BitElms
+            + (lenRefUL - 1) / lenSegUL
+         ];
+
+      *bestEndIndexUL = indexUL + lenRefUL;
+   } /*If: this is a Needleman (ends at the corner)*/
+
+   /*The matrixes have one extra direction (a stop)*/
+   alnDirVectEndMatrix(
+      dirMatrix,
+      twoBitST,
+      indexUL + lenRefUL + 1
+   );
+
+   for(ulQry = 0; ulQry < lenQryUL; ++ulQry)
+      profIndexAryUL[(uchar) qrySeqStr[ulQry]] = 0;
+} /*alnDirVectI16*/
+
+#endif /*DEFNOVECT*/
+#endif
@@ -0,0 +1,118 @@
+/*########################################################
+# Name genAlnDirVect
+# Use:
+#  o Holds the macros shared by the alnDirVect kernels to
+#    copy finished rows into the byte or two bit direction
+#    matrixes
+# Libraries:
+#   - "../general/twoBitArrays.h"      (No .c file)
+#   - "../general/alnSetStruct.h"      (No .c file)
+#   - "../general/alnSeqDefaults.h"    (No .c file)
+#   - "../vectWrap/vectWrap.h"         (No .c file)
+#   o "../general/dataTypeShortHand.h" (No .c file)
+# C Standard libraries:
+#   o <stdlib.h>
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+' o macro-01 alnDirVectPackRow:
+'   - Packs a row of directions (one per char) into a two
+'     bit direction matrix
+' o macro-02 alnDirVectEndMatrix:
+'   - Sets the extra direction after the last row to a
+'     stop and moves a two bit matrix to the last cell
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#ifndef GEN_ALN_DIR_VECT_H
+#define GEN_ALN_DIR_VECT_H
+
+#include "../general/twoBitArrays.h"
+#include "../general/alnSetStruct.h"
+#include "../general/alnSeqDefaults.h"
+#include "../vectWrap/vectWrap.h"
+
+/*-------------------------------------------------------\
+| Macro-01: alnDirVectPackRow
+|   - Packs a row of directions (one per char) into a two
+|     bit direction matrix. Whole limbs are set four
+|     directions at a time, so only the ends of a row that
+|     share a limb with the last or next row are set one
+|     element at a time.
+| Input:
+|   - rowC:
+|     o Array of directions (defMvStop to defMvSnp)
+|   - lenRowUL:
+|     o Number of directions in rowC
+|   - twoBitST:
+|     o Pointer to the twoBitAry to pack the row into.
+|       The row starts at the current element.
+| Output:
+|   - Modifies:
+|     o twoBitST to have the directions in rowC and to be
+|       on the element after the row
+\-------------------------------------------------------*/
+#define alnDirVectPackRow(rowC, lenRowUL, twoBitST){\
+   ulong macroColUL = 0;\
+   \
+   while(\
+         (twoBitST)->elmOnC != 0\
+      && macroColUL < (lenRowUL)\
+   ){ /*Loop: finish the limb the last row ended in*/\
+      changeTwoBitElm((twoBitST), (rowC)[macroColUL]);\
+      twoBitMvToNextElm((twoBitST));\
+      ++macroColUL;\
+   } /*Loop: finish the limb the last row ended in*/\
+   \
+   while(macroColUL + 4 <= (lenRowUL))\
+   { /*Loop: fill in whole limbs*/\
+      *(twoBitST)->limbOnUCPtr =\
+         (uchar) (\
+              (rowC)[macroColUL]\
+            | ((rowC)[macroColUL + 1] << 2)\
+            | ((rowC)[macroColUL + 2] << 4)\
+            | ((rowC)[macroColUL + 3] << 6)\
+         );\
+      \
+      ++(twoBitST)->limbOnUCPtr;\
+      macroColUL += 4;\
+   } /*Loop: fill in whole limbs*/\
+   \
+   while(macroColUL < (lenRowUL))\
+   { /*Loop: start the limb the next row ends in*/\
+      changeTwoBitElm((twoBitST), (rowC)[macroColUL]);\
+      twoBitMvToNextElm((twoBitST));\
+      ++macroColUL;\
+   } /*Loop: start the limb the next row ends in*/\
+} /*alnDirVectPackRow*/
+
+/*-------------------------------------------------------\
+| Macro-02: alnDirVectEndMatrix
+|   - Sets the extra direction after the last row to a
+|     stop (like NeedlemanAln/WatermanAln) and moves a two
+|     bit matrix back to the last cell (like NeedleTwoBit)
+| Input:
+|   - dirMatrix:
+|     o Byte direction matrix (0 if using twoBitST)
+|   - twoBitST:
+|     o Two bit direction matrix (0 if using dirMatrix).
+|       This should be on the element after the last row.
+|   - lenMatrixUL:
+|     o Number of cells in the matrix (index of the extra
+|       direction)
+| Output:
+|   - Modifies:
+|     o dirMatrix or twoBitST
+\-------------------------------------------------------*/
+#define alnDirVectEndMatrix(dirMatrix,twoBitST,lenMatrixUL){\
+   if((dirMatrix) != 0)\
+      (dirMatrix)[(lenMatrixUL)] = defMvStop;\
+   \
+   else\
+   { /*Else: this is a two bit matrix*/\
+      changeTwoBitElm((twoBitST), defMvStop);\
+      twoBitMvBackOneElm((twoBitST));\
+   } /*Else: this is a two bit matrix*/\
+} /*alnDirVectEndMatrix*/
+
+#endif
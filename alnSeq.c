@@ -6,14 +6,26 @@
 # Includes:
 #  - "hirschberg/hirschberg.h"
 #  - "hirschberg/hirschbergNoGap.h"
+#  - "hirschberg/hirschThread.h"
+#  o "hirschberg/hirschVect.h"
+#  o "hirschberg/hirschVectScoreI16.h"
+#  o "hirschberg/hirschVectScoreI32.h"
 #  o "hirschberg/genScoreHirsch.h"
 #  o "hirschberg/genScoreNoGapHirsc.h"
 #  o "hirschberg/genHirsch.h"
 #
+#  - "alnDirVect/alnDirVect.h"
+#  o "alnDirVect/alnDirVectI16.h"
+#  o "alnDirVect/alnDirVectI32.h"
+#  o "alnDirVect/genAlnDirVect.h"
+#
 #  - "needleman/needleman.h"
 #  - "needleman/needleNoGap.h"
 #  - "needleman/needleTwoBit.h"
 #  - "needleman/needleTwoBitNoGap.h"
+#  - "needleman/needleMyers.h"
+#
+#  - "wavefront/wfa.h"
 #  o "needleman/genNeedle.h"
 #  o "needleman/genNeedleNoGap.h"
 #
@@ -31,13 +43,28 @@
 #  o "waterman/genWaterScan.h"
 #  o "waterman/genWaterScanNoGap.h"
 #
+#  - "waterman/waterDrop.h"
+#
 #  - "memWater/memWater.h"
 #  - "memWater/memWaterNoGap.h"
+#  - "memWater/memWaterVect.h"
+#  - "memWater/memNeedle.h"
+#
+#  - "batchAln/batchAln.h"
+#  - "batchAln/batchThread.h"
+#  - "vectDispatch/vectDispatch.h"
+#
+#  - "banded/bandAln.h"
+#  - "tileAln/tileAln.h"
 #
 #  - "memWater/memWaterScan.h"
 #  - "memWater/memWaterScanNoGap.h"
 #
 #  - "general/sortAndFiltAltAlns.h"
+#  - "general/seqFile.h"
+#  - "general/seqMap.h"
+#  - "general/faIndex.h"
+#  - "general/alnRef.h"
 #  o "general/alnMatrixStruct.h"
 #  o "general/alnSeqDefaults.h"
 #  o "general/alnSetStruct.h"
@@ -47,20 +74,32 @@
 #  o "general/genAln.h"
 #  o "general/genScan.h"
 #  o "general/seqStruct.h"
+#  o "general/seqVect.h"
+#  o "general/seqPack.h"
 #  o "general/twoBitArrays.h"
 #  o "general/genMath.h"
+#  o "general/threadPool.h"
+#  o "vectWrap/vectWrap.h"
 # C standard libraries:
 #  o <string.h>
 #  o <stdlib.h>
 #  o <stdio.h>
 #  o <stdint.h>
+#  o <pthread.h> (POSIX)
 #########################################################*/
 
 #include "hirschberg/hirschberg.h"
 #include "hirschberg/hirschbergNoGap.h"
+#include "hirschberg/hirschThread.h"
 
 #include "memWater/memWater.h"
 #include "memWater/memWaterNoGap.h"
+#include "memWater/memWaterVect.h"
+#include "memWater/memNeedle.h"
+
+#include "batchAln/batchAln.h"
+#include "batchAln/batchThread.h"
+#include "vectDispatch/vectDispatch.h"
 
 #include "memWater/memWaterScan.h"
 #include "memWater/memWaterScanNoGap.h"
@@ -75,12 +114,24 @@
 #include "waterman/waterScanTwoBit.h"
 #include "waterman/waterScanTwoBitNoGap.h"
 
+#include "waterman/waterDrop.h"
+
 #include "needleman/needleman.h"
 #include "needleman/needleNoGap.h"
 #include "needleman/needleTwoBit.h"
 #include "needleman/needleTwoBitNoGap.h"
+#include "needleman/needleMyers.h"
+
+#include "wavefront/wfa.h"
+
+#include "banded/bandAln.h"
+#include "tileAln/tileAln.h"
 
 #include "general/sortAndFiltAltAlns.h"
+#include "general/seqFile.h"
+#include "general/seqMap.h"
+#include "general/faIndex.h"
+#include "general/alnRef.h"
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
 ' SOP: Start Of Program
@@ -92,6 +143,12 @@
 '  o fun-03 printCompilerSettings:
 '    - Prints out the compiler flags used
 '    - Prints out what each possible compiler flag does
+'  o fun-04 batchAlnFiles:
+'    - Aligns every query record to a reference record
+'      (-batch)
+'  o fun-05 indexRefFile:
+'    - Builds a reference cache (.alnref) for
+'      alnSeq index
 \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 /*-------------------------------------------------------\
@@ -106,6 +163,9 @@
 |  - refFileCStr:
 |    o Pointer to c-string to hold the name of the fasta
 |      file with the reference sequence
+|  - refNameStr:
+|    o Pointer to c-string to hold the name of the entry
+|      in the reference to align to (-ref-name)
 |  - qryFileCStr:
 |    o Pointer to c-string to hold the name of the fasta
 |      file with the query sequence
@@ -153,6 +213,7 @@ char * checkInput(
     int *lenArgsInt,     /*Number arguments user input*/
     char *argsCStr[],    /*Array with user arguments*/
     char **refFileCStr,  /*file name of reference file*/
+    char **refNameStr,   /*Reference entry (-ref-name)*/
     char **queryFileCStr,/*File name of the query file*/
     char **outFileStr,     /*Name of the output file*/
     char **altAlnFileStr, /*file: alternative alignments*/
@@ -225,6 +286,78 @@ void printCompileSettings(
    '    - Print out what each compiler flag does
    \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
+/*-------------------------------------------------------\
+| Fun-04: batchAlnFiles
+|   - Aligns every query record to a reference record
+|     (one reference for all queries or the nth query to
+|     the nth reference)
+| Input:
+|   - refFileStr:
+|     o C-string with the name of the reference fasta or
+|       fastq file
+|   - qryFileStr:
+|     o C-string with the name of the query fasta or fastq
+|       file (any number of records)
+|   - outFileStr:
+|     o C-string with the name of the output file
+|   - scoreMtrxFileStr:
+|     o C-string with the name of the scoring matrix file
+|   - settings:
+|     o alnSet structure with the alignment settings
+| Output:
+|   - Prints the alignments or scores to outFileStr
+|   - Returns:
+|     o 0 for no errors
+|     o 1 for an alignment method that can not be batched
+|     o 2 for an invalid reference file
+|     o 4 for an invalid query file
+|     o 8 if an alignment could not be printed
+|     o 64 for memory errors
+\-------------------------------------------------------*/
+char batchAlnFiles(
+   char *refFileStr,      /*Reference fasta/fastq file*/
+   char *qryFileStr,      /*Query fasta/fastq file*/
+   char *outFileStr,      /*File to print alignments to*/
+   char *scoreMtrxFileStr,/*Scoring matrix file*/
+   struct alnSet *settings/*Alignment settings*/
+); /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-04 TOC: batchAlnFiles
+   '  - Aligns every query record to a reference record
+   '  o fun-04 sec-01:
+   '    - Variable declerations
+   '  o fun-04 sec-02:
+   '    - Check the settings and allocate memory
+   '  o fun-04 sec-03:
+   '    - Open the files and read the first reference
+   '  o fun-04 sec-04:
+   '    - Read in a batch of pairs and align them
+   '  o fun-04 sec-05:
+   '    - Clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Fun-05: indexRefFile
+|   - Builds a reference cache (.alnref) from the fasta
+|     or fastq file in -ref (alnSeq index)
+| Input:
+|   - lenArgsInt:
+|     o Number of arguments the user input
+|   - argsCStr:
+|     o Array of c-strings with the users input arguments
+|       (argsCStr[1] is "index")
+| Output:
+|   - Prints:
+|     o The cache to -out (-ref.alnref by default)
+|     o Errors to stderr
+|   - Returns:
+|     o 0 for no errors
+|     o -1 for errors
+\-------------------------------------------------------*/
+int indexRefFile(
+   int lenArgsInt,   /*Number of arguments*/
+   char *argsCStr[]  /*Arguments (argsCStr[1]: index)*/
+);
+
 int main(
     int lenArgsInt,
     char *argsCStr[]
@@ -256,6 +389,7 @@ int main(
 
    /*User input*/
    char *refFileCStr = 0;
+   char *refNameStr = 0;   /*-ref-name entry to align*/
    char *queryFileCStr = 0;
    char *outFileStr = 0;
    char *altAlnFileStr = 0;
@@ -270,6 +404,9 @@ int main(
    /*Caputures error type from functions*/
    uchar errUC = 0;
    long bestScoreL = 0;
+   long matchL = 0; /*Match score for needleMyers*/
+   long snpL = 0;   /*Mismatch score for needleMyers*/
+   struct wfaSet wfaST; /*Penalties for -use-wfa*/
    ulong iterUL = 0;
 
    /*Will hold the users settings*/
@@ -283,6 +420,11 @@ int main(
    FILE *faFILE = 0;
    FILE *outFILE = 0;
    FILE *altAlnFILE = 0;
+   struct seqFile faFileST; /*Block reader for faFILE*/
+   struct seqMap refMapST;  /*Map for large references*/
+   struct alnRef refCacheST;/*Reference cache (.alnref)*/
+   struct seqPack refPackST;/*Packed cache entry*/
+   struct seqPack *refPackPtr = 0; /*0: unpack the cache*/
 
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
    ^ Main Sec-02:
@@ -295,6 +437,8 @@ int main(
    ^    - Check if the main output file exists/was input
    ^  o main sec-02 sub-04:
    ^    - Check if file input for alternative alignments
+   ^  o main sec-02 sub-05:
+   ^    - Check if aligning every record (-batch)
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
    /*****************************************************\
@@ -302,6 +446,9 @@ int main(
    *  - Initialize variables and Get user input
    \*****************************************************/
 
+   if(lenArgsInt > 1 && strcmp(argsCStr[1], "index") == 0)
+      exit(indexRefFile(lenArgsInt, argsCStr));
+
    initSeqST(&refST);
    initSeqST(&queryST);
    initAlnSet(&settings);
@@ -311,6 +458,7 @@ int main(
            &lenArgsInt,
            argsCStr,
            &refFileCStr,
+           &refNameStr,
            &queryFileCStr,
            &outFileStr,
            &altAlnFileStr, /*TODO: ADD IN SETTING*/
@@ -323,6 +471,11 @@ int main(
            &settings
    ); /*Get user input*/
 
+   /*Pick the vector instruction set (-vect-set, the
+   ` ALNSEQ_VECT environment variable, or the cpu)
+   */
+   settings.vectSetC = vectDispatchPick(settings.vectSetC);
+
    /*****************************************************\
    * Main Sec-02 Sub-02:
    *  - Check user input for errors
@@ -450,32 +603,201 @@ int main(
         altAlnFILE = 0;
    } /*If: I have a file for alternative alignments*/
 
+   /*****************************************************\
+   * Main Sec-02 Sub-05:
+   *  - Check if aligning every record (-batch)
+   \*****************************************************/
+
+   if(settings.batchBl)
+   { /*If: aligning every query record*/
+      errUC =
+         batchAlnFiles(
+            refFileCStr,
+            queryFileCStr,
+            outFileStr,
+            scoreMtrxFileStr,
+            &settings
+         );
+
+      freeAlnSetStack(&settings); /*Score profile rows*/
+      if(errUC == 0) exit(0);
+
+      if(errUC == 1)
+      { /*If: this alignment can not be batched*/
+         printHelpMesg(stderr, 1); /*short help*/
+         fprintf(
+            stderr,
+            "-batch only works with -use-needle,"
+            " -use-water, or -use-mem-water\n"
+         );
+      } /*If: this alignment can not be batched*/
+
+      else if(errUC == 2)
+         fprintf(
+           stderr,
+           "Reference (-ref %s) is not valid\n",
+           refFileCStr
+         );
+
+      else if(errUC == 4)
+         fprintf(
+           stderr,
+           "Query (-query %s) is not valid\n",
+           queryFileCStr
+         );
+
+      else if(errUC == 8)
+         fprintf(stderr, "Failed to print alignment\n");
+
+      else fprintf(stderr, "Memory allocation error\n");
+
+      exit(-1);
+   } /*If: aligning every query record*/
+
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
    ^ Main Sec-3:
    ^  - read in the reference sequence
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
-   faFILE = fopen(refFileCStr, "r");
+   /*Large fasta references are used in place from a map
+   ` of the file (converted to lookup indexes)
+   */
+   initSeqFile(&faFileST);
+   initSeqMap(&refMapST);
+   initAlnRef(&refCacheST);
 
-   if(faFILE == 0) 
-   { /*If: reference file could not be opened*/
-       fprintf(
-         stderr,
-         "Reference (-ref %s) could not be opend\n",
-         refFileCStr
-       );
+   /*Caches from alnSeq index are found by their header*/
+   errUC = mapAlnRef(&refCacheST, refFileCStr);
 
-       exit(-1);
-   } /*If: reference file could not be opened*/
+   /*memNeedle unpacks one tile of the reference at a
+   ` time, so its cache entry is kept packed in the map
+   */
+   if(
+         settings.useNeedleBl
+      && settings.justScoresBl
+      && ! settings.bandUL
+   ) refPackPtr = &refPackST;
+
+   if(errUC == 1)
+   { /*If: the reference is a cache (.alnref)*/
+      errUC =
+         readAlnRef(
+            &refCacheST,
+            refNameStr,
+            refST.offsetUL,
+            refST.endAlnUL,
+            &refST,
+            refPackPtr
+         ); /*Only the entry (or region) is unpacked*/
 
-   /*Read in the reference sequence*/
-   errUC = readFaSeq(faFILE, &refST);
-   fclose(faFILE);
-   faFILE = 0;
+      if(refST.packST == 0) freeAlnRefStack(&refCacheST);
+   } /*If: the reference is a cache (.alnref)*/
+
+   else if(errUC == 2)
+   { /*If: the cache can not be used*/
+      fprintf(
+        stderr,
+        "Reference (-ref %s) is a truncated cache or was"
+        " made by a\n  different alnSeq build; rebuild it"
+        " with alnSeq index\n",
+        refFileCStr
+      );
+
+      exit(-1);
+   } /*If: the cache can not be used*/
+
+   else if(errUC == 64)
+   { /*If: I had a memory error*/
+      fprintf(stderr, "Memory allocation error\n");
+      exit(-1);
+   } /*If: I had a memory error*/
+
+   else if(refNameStr != 0)
+      errUC =
+         readFaRegion(
+            refFileCStr,
+            refNameStr,
+            refST.offsetUL,
+            refST.endAlnUL,
+            &refST
+         ); /*Uses (or builds) the index (refFileCStr.fai)*/
+
+   else errUC = mapSeqFile(&refMapST, refFileCStr, &refST);
+
+   if(refNameStr != 0)
+   { /*If: only read one region of one entry*/
+      /*Coordinates are now in the region*/
+      refST.offsetUL = 0;
+      refST.endAlnUL = 0;
+
+      if(errUC == 0)
+      { /*If: the entry is not in the reference*/
+         fprintf(
+           stderr,
+           "-ref-name %s is not in -ref %s\n",
+           refNameStr,
+           refFileCStr
+         );
+
+         freeSeqSTStack(&refST);
+         exit(-1);
+      } /*If: the entry is not in the reference*/
+
+      if(errUC == 4)
+      { /*If: the region is not in the entry*/
+         fprintf(
+           stderr,
+           "-ref-start and -ref-end are not in %s\n",
+           refNameStr
+         );
+
+         freeSeqSTStack(&refST);
+         exit(-1);
+      } /*If: the region is not in the entry*/
+
+      if(errUC == 8)
+      { /*If: reference file could not be opened*/
+         fprintf(
+           stderr,
+           "Reference (-ref %s) could not be opend\n",
+           refFileCStr
+         );
+
+         freeSeqSTStack(&refST);
+         exit(-1);
+      } /*If: reference file could not be opened*/
+   } /*If: only read one region of one entry*/
+
+   if(errUC == 4)
+   { /*If: the reference was not mapped*/
+      faFILE = fopen(refFileCStr, "r");
+
+      if(faFILE == 0) 
+      { /*If: reference file could not be opened*/
+          fprintf(
+            stderr,
+            "Reference (-ref %s) could not be opend\n",
+            refFileCStr
+          );
+
+          exit(-1);
+      } /*If: reference file could not be opened*/
+
+      /*Read in the reference sequence (converted to
+      ` lookup indexes as it is read)
+      */
+      errUC = openSeqFile(&faFileST, faFILE);
+      if(! errUC) errUC = readSeqFile(&faFileST, &refST, 1);
+
+      freeSeqFileStack(&faFileST);
+      fclose(faFILE);
+      faFILE = 0;
+   } /*If: the reference was not mapped*/
 
-   if(errUC & 2)
+   if(errUC == 0 || errUC & 2)
    { /*If: I had an Invalid fasta file*/
-       freeSeqSTStack(&refST);
+       freeSeqMapSTStack(&refST, &refMapST);
+       freeAlnRefStack(&refCacheST);
 
        fprintf(
          stderr,
@@ -488,7 +810,8 @@ int main(
 
    if(errUC & 64)
    { /*If: I had a memory error*/
-       freeSeqSTStack(&refST);
+       freeSeqMapSTStack(&refST, &refMapST);
+       freeAlnRefStack(&refCacheST);
        fprintf(stderr, "Memory allocation error\n");
        exit(-1);
    } /*If: I had a memory error*/
@@ -502,7 +825,8 @@ int main(
 
    if(faFILE == 0) 
    { /*If: reference file could not be opened*/
-       freeSeqSTStack(&refST);
+       freeSeqMapSTStack(&refST, &refMapST);
+       freeAlnRefStack(&refCacheST);
 
        fprintf(
          stderr,
@@ -515,13 +839,17 @@ int main(
 
 
    /*Read in the query sequence*/
-   errUC = readFaSeq(faFILE, &queryST);
+   errUC = openSeqFile(&faFileST, faFILE);
+   if(! errUC) errUC = readSeqFile(&faFileST, &queryST, 1);
+
+   freeSeqFileStack(&faFileST);
    fclose(faFILE);
    faFILE = 0;
 
-   if(errUC & 2)
+   if(errUC == 0 || errUC & 2)
    { /*If: I had an Invalid fasta file*/
-       freeSeqSTStack(&refST);
+       freeSeqMapSTStack(&refST, &refMapST);
+       freeAlnRefStack(&refCacheST);
        freeSeqSTStack(&queryST);
 
        fprintf(
@@ -534,12 +862,29 @@ int main(
 
    if(errUC & 64)
    { /*If: I had a memory error*/
-      freeSeqSTStack(&refST);
+      freeSeqMapSTStack(&refST, &refMapST);
+      freeAlnRefStack(&refCacheST);
       freeSeqSTStack(&queryST);
       fprintf(stderr, "Memory allocation error\n");
       exit(-1);
    } /*If: I had a memory error*/
 
+   if(settings.qryRevCmpBl)
+   { /*If: aligning the reverse complement of the query*/
+      /*The complement is done on bases*/
+      lookupIndexToSeqVect(
+         queryST.seqCStr,
+         queryST.lenSeqUL
+      );
+
+      reverseComplementSeqVect(&queryST);
+
+      seqToLookupIndexVect(
+         queryST.seqCStr,
+         queryST.lenSeqUL
+      );
+   } /*If: aligning the reverse complement of the query*/
+
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
    ^ Main Sec-05:
    ^  - Do the alingment
@@ -548,25 +893,25 @@ int main(
    ^  o main sec-05 sub-02:
    ^    - Open the output files
    ^  o main sec-05 sub-03:
-   ^    - Check if doing a Needleman alignment
+   ^    - Check if doing an wavefront (WFA) alignment
    ^  o main sec-05 sub-04:
-   ^    - Check if doing an Waterman alignment
+   ^    - Check if doing a Needleman alignment
    ^  o main sec-05 sub-05:
-   ^    - Check if doing an query reference scan Waterman
+   ^    - Check if doing an Waterman alignment
    ^  o main sec-05 sub-06:
+   ^    - Check if doing an query reference scan Waterman
+   ^  o main sec-05 sub-07:
    ^    - Check if doing an memory efficent Waterman
    ^      alignment that prints out alternative alignment
    ^      positions (Gets combined with a Hirschberg)
-   ^  o main sec-05 sub-07:
+   ^  o main sec-05 sub-08:
    ^    - Check if doing an memory efficent Waterman
    ^      alignment that prints out a single alignment
    ^      (uses a Hirschberg to get the alignment)
-   ^  o main sec-05 sub-08:
-   ^    - Check if doing an Hirschberg alignment
    ^  o main sec-05 sub-09:
-   ^    - Let user know this was an invalid alignment
+   ^    - Check if doing an Hirschberg alignment
    ^  o main sec-05 sub-10:
-   ^    - Check if the alignment failed
+   ^    - Let user know this was an invalid alignment
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
    /******************************************************\
@@ -574,8 +919,7 @@ int main(
    *  - Set up for the alignment
    \******************************************************/
 
-   seqToLookupIndex(refST.seqCStr);
-   seqToLookupIndex(queryST.seqCStr);
+   /*readSeqFile converted the sequences to lookup indexes*/
 
    if(refST.endAlnUL == 0)
       refST.endAlnUL = refST.lenSeqUL - 1;
@@ -611,12 +955,142 @@ int main(
 
    /******************************************************\
    * Main Sec-05 Sub-03:
+   *  - Check if doing an wavefront (WFA) alignment
+   \******************************************************/
+
+   if(settings.useWfaBl)
+   { /*If: I am doing a wavefront alignment*/
+      if(wfaSetup(&queryST, &refST, &settings, &wfaST))
+      { /*If: the penalties work with the wavefront*/
+         alnST =
+            wfaAln(&queryST, &refST, &wfaST, &bestScoreL);
+
+         goto printAlignment; /*Checks for memory errors*/
+      } /*If: the penalties work with the wavefront*/
+
+      fprintf(
+         stderr,
+         "-use-wfa does not support these scores; using"
+      );
+      fprintf(stderr, " -use-needle\n");
+
+      settings.useWfaBl = 0;
+      settings.useNeedleBl = 1;
+   } /*If: I am doing a wavefront alignment*/
+
+   /******************************************************\
+   * Main Sec-05 Sub-04:
    *  - Check if doing an Needleman alignment
    \******************************************************/
 
    if(settings.useNeedleBl)
    { /*If: I am doing a Needleman alignment*/
-     if(settings.noGapBl)
+     if(settings.justScoresBl && ! settings.bandUL)
+     { /*If: only finding the score (two rows)*/
+        alnMtrxST = memNeedle(&queryST, &refST, &settings);
+
+        if(alnMtrxST == 0)
+        { /*If: the aligment falied*/
+           fprintf(
+              stderr,
+              "Ran out of memory for mem-needle alignment\n"
+           );
+
+           if(outFILE != stdout) fclose(outFILE);
+           if(
+                 altAlnFILE != stdout
+              && altAlnFILE != outFILE
+           ) fclose(altAlnFILE);
+
+           freeSeqMapSTStack(&refST, &refMapST);
+           freeAlnRefStack(&refCacheST);
+           freeSeqSTStack(&queryST);
+
+           exit(-1);
+        } /*If: the aligment falied*/
+
+        /*Convert the matrix indexes to sequence positions*/
+        indexToCoord(
+           alnMtrxST->lenRefUL,
+           alnMtrxST->bestStartIndexUL,
+           refST.offsetUL,
+           queryST.offsetUL
+        );
+
+        indexToCoord(
+           alnMtrxST->lenRefUL,
+           alnMtrxST->bestEndIndexUL,
+           refST.endAlnUL,
+           queryST.endAlnUL
+        );
+
+        refST.offsetUL += alnMtrxST->refOffsetUL;
+        refST.endAlnUL += alnMtrxST->refOffsetUL;
+        queryST.offsetUL += alnMtrxST->qryOffsetUL;
+        queryST.endAlnUL += alnMtrxST->qryOffsetUL;
+
+        fprintf(
+           outFILE,
+           "%li\t%lu\t%lu\t%lu\t%lu\n",
+           alnMtrxST->bestScoreL,
+           refST.offsetUL,
+           refST.endAlnUL,
+           queryST.offsetUL,
+           queryST.endAlnUL
+        );
+
+        freeAlnMatrix(alnMtrxST);
+        alnMtrxST = 0;
+        goto noAlnOutFree;
+     } /*If: only finding the score (two rows)*/
+
+     if(
+           ! settings.bandUL
+        && needleMyersBl(
+              &queryST,
+              &refST,
+              &settings,
+              &matchL,
+              &snpL
+           )
+     ){ /*If: unit costs; use the bit-vector aligner*/
+        alnST =
+           needleMyers(
+              &queryST,
+              &refST,
+              &settings,
+              matchL,
+              snpL,
+              &bestScoreL
+           );
+
+        goto printAlignment; /*Checks for memory errors*/
+     } /*If: unit costs; use the bit-vector aligner*/
+
+     if(settings.bandUL)
+        alnMtrxST =
+           bandAln(&queryST, &refST, 1, &settings);
+     else if(settings.threadsUS > 1 && settings.twoBitBl)
+        alnMtrxTwoBitST =
+           tileAlnTwoBit(&queryST, &refST, 1, &settings);
+     else if(settings.threadsUS > 1)
+        alnMtrxST =
+           tileAln(&queryST, &refST, 1, &settings);
+     else if(
+           settings.vectBl
+        && settings.twoBitBl
+        && !settings.noGapBl
+     ) alnMtrxTwoBitST =
+          alnDirVectTwoBitDispatch(
+             &queryST,
+             &refST,
+             1,          /*Needleman alignment*/
+             &settings
+          );
+     else if(settings.vectBl)
+        alnMtrxST =
+           alnDirVectDispatch(&queryST,&refST,1,&settings);
+     else if(settings.noGapBl)
         alnMtrxST =
            NeedleAlnNoGap(&queryST, &refST, &settings);
      else if(settings.twoBitBl && settings.noGapBl)
@@ -631,7 +1105,7 @@ int main(
 
      if(alnMtrxST == 0 && alnMtrxTwoBitST == 0)
      { /*If: the aligment falied*/
-         freeSeqSTStack(&refST);
+         freeSeqMapSTStack(&refST, &refMapST);
          freeSeqSTStack(&queryST);
 
          fprintf(
@@ -640,9 +1114,12 @@ int main(
          );
 
          if(outFILE != stdout) fclose(outFILE);
-         if(altAlnFILE != stdout) fclose(altAlnFILE);
+         if(
+               altAlnFILE != stdout
+            && altAlnFILE != outFILE
+         ) fclose(altAlnFILE);
 
-         freeSeqSTStack(&refST);
+         freeSeqMapSTStack(&refST, &refMapST);
          freeSeqSTStack(&queryST);
 
          exit(-1);
@@ -684,13 +1161,39 @@ int main(
    } /*If: I am doing a Needleman alignment*/
 
    /******************************************************\
-   * Main Sec-05 Sub-03:
+   * Main Sec-05 Sub-05:
    *  - Check if doing an Waterman alignment
    \******************************************************/
 
    else if(settings.useWaterBl && !settings.refQueryScanBl)
    { /*Else If: doing a waterman alignment*/
-      if(settings.noGapBl)
+      if(settings.bandUL)
+         alnMtrxST =
+            bandAln(&queryST, &refST, 0, &settings);
+      else if(settings.xDropL || settings.zDropL)
+         alnMtrxST =
+            waterDrop(&queryST, &refST, 1, 0, &settings);
+      else if(settings.threadsUS > 1 && settings.twoBitBl)
+         alnMtrxTwoBitST =
+            tileAlnTwoBit(&queryST, &refST, 0, &settings);
+      else if(settings.threadsUS > 1)
+         alnMtrxST =
+            tileAln(&queryST, &refST, 0, &settings);
+      else if(
+            settings.vectBl
+         && settings.twoBitBl
+         && !settings.noGapBl
+      ) alnMtrxTwoBitST =
+           alnDirVectTwoBitDispatch(
+              &queryST,
+              &refST,
+              0,          /*Waterman alignment*/
+              &settings
+           );
+      else if(settings.vectBl)
+         alnMtrxST =
+            alnDirVectDispatch(&queryST,&refST,0,&settings);
+      else if(settings.noGapBl)
          alnMtrxST =
             WatermanAlnNoGap(&queryST, &refST, &settings);
       else if(settings.twoBitBl && settings.noGapBl)
@@ -705,7 +1208,7 @@ int main(
 
       if(alnMtrxST == 0 && alnMtrxTwoBitST == 0)
       { /*If: the aligment falied*/
-          freeSeqSTStack(&refST);
+          freeSeqMapSTStack(&refST, &refMapST);
           freeSeqSTStack(&queryST);
   
          fprintf(
@@ -714,14 +1217,20 @@ int main(
           );
   
          if(outFILE != stdout) fclose(outFILE);
-         if(altAlnFILE != stdout) fclose(altAlnFILE);
+         if(
+               altAlnFILE != stdout
+            && altAlnFILE != outFILE
+         ) fclose(altAlnFILE);
    
-         freeSeqSTStack(&refST);
+         freeSeqMapSTStack(&refST, &refMapST);
          freeSeqSTStack(&queryST);
 
          exit(-1);
       } /*If: the aligment falied*/
 
+      if(settings.pStatsBl && alnMtrxST != 0)
+         waterDropPStats(alnMtrxST, stderr);
+
       if(alnMtrxST != 0)
       { /*If: I did a byte Waterman Smith alignment*/
           alnST =
@@ -758,13 +1267,16 @@ int main(
    } /*Else If: I am doing a single score waterman*/
 
    /*****************************************************\
-   * Main Sec-05 Sub-04:
+   * Main Sec-05 Sub-06:
    *  - Check if doing an query reference scan Waterman
    \*****************************************************/
 
    else if(settings.useWaterBl && settings.refQueryScanBl)
    { /*Else If: Wateman with query reference scan */
-      if(settings.noGapBl)
+      if(settings.xDropL || settings.zDropL)
+         alnMtrxST =
+            waterDrop(&queryST, &refST, 1, 1, &settings);
+      else if(settings.noGapBl)
          alnMtrxST =
             WaterScanNoGap(&queryST, &refST, &settings);
       else if(settings.twoBitBl && settings.noGapBl)
@@ -779,7 +1291,7 @@ int main(
 
       if(alnMtrxST == 0 && alnMtrxTwoBitST == 0)
       { /*If: the aligment falied*/
-         freeSeqSTStack(&refST);
+         freeSeqMapSTStack(&refST, &refMapST);
          freeSeqSTStack(&queryST);
     
          fprintf(
@@ -789,13 +1301,19 @@ int main(
          fprintf(stderr, " reference scan\n");
     
          if(outFILE != stdout) fclose(outFILE);
-         if(altAlnFILE != stdout) fclose(altAlnFILE);
+         if(
+               altAlnFILE != stdout
+            && altAlnFILE != outFILE
+         ) fclose(altAlnFILE);
 
-         freeSeqSTStack(&refST);
+         freeSeqMapSTStack(&refST, &refMapST);
          freeSeqSTStack(&queryST);
 
          exit(-1);
       } /*If: the aligment falied*/
+
+      if(settings.pStatsBl && alnMtrxST != 0)
+         waterDropPStats(alnMtrxST, stderr);
   
       /*Check if I am filtering the alternative scores*/
       /*
@@ -829,16 +1347,20 @@ int main(
          if(settings.justScoresBl)
          { /*If: I am printing out scores only*/
             if(outFILE != stdout) fclose(outFILE);
-            if(altAlnFILE != stdout) fclose(altAlnFILE);
+            if(
+                  altAlnFILE != stdout
+               && altAlnFILE != outFILE
+            ) fclose(altAlnFILE);
 
-            freeSeqSTStack(&refST);
+            freeSeqMapSTStack(&refST, &refMapST);
             freeSeqSTStack(&queryST);
 
             if(alnMtrxST != 0)
               {freeAlnMatrix(alnMtrxST);}
             else
               {freeAlnMatrixTwoBit(alnMtrxTwoBitST);}
-   
+
+            freeAlnSetStack(&settings);
             exit(0);
          } /*If: I am printing out scores only*/
       } /*If: I am not printing full alt alignments*/
@@ -892,12 +1414,14 @@ int main(
 
             if(errUC)
             { /*If: I falied to print out the alignment*/
-               if(altAlnFILE != stdout)
-                  fclose(altAlnFILE);
+               if(
+                     altAlnFILE != stdout
+                  && altAlnFILE != outFILE
+               ) fclose(altAlnFILE);
 
                if(outFILE != stdout) fclose(outFILE);
 
-               freeSeqSTStack(&refST);
+               freeSeqMapSTStack(&refST, &refMapST);
                freeSeqSTStack(&queryST);
 
                if(alnMtrxST != 0)
@@ -950,7 +1474,7 @@ int main(
    } /*Else If: Wateman with query reference scan*/
 
    /******************************************************\
-   * Main Sec-05 Sub-04:
+   * Main Sec-05 Sub-07:
    *  - Check if doing an memory efficent Waterman
    *    alignment that prints out alternative alignment
    *    positions (Gets combined with a Hirschberg)
@@ -958,7 +1482,10 @@ int main(
 
    else if(settings.memWaterBl && settings.refQueryScanBl)
    { /*Else if; memory waterman alignment + scan*/
-     if(settings.noGapBl)
+     if(settings.xDropL || settings.zDropL)
+        alnMtrxST =
+           waterDrop(&queryST, &refST, 0, 1, &settings);
+     else if(settings.noGapBl)
         alnMtrxST =
            memWaterScanNoGap(&queryST,&refST,&settings);
      else
@@ -967,7 +1494,7 @@ int main(
 
       if(alnMtrxST == 0)
       { /*If: the aligment falied*/
-         freeSeqSTStack(&refST);
+         freeSeqMapSTStack(&refST, &refMapST);
          freeSeqSTStack(&queryST);
        
          fprintf(
@@ -977,14 +1504,20 @@ int main(
          fprintf(stderr, " reference scan\n");
        
          if(outFILE != stdout) fclose(outFILE);
-         if(altAlnFILE != stdout) fclose(altAlnFILE);
+         if(
+               altAlnFILE != stdout
+            && altAlnFILE != outFILE
+         ) fclose(altAlnFILE);
    
-         freeSeqSTStack(&refST);
+         freeSeqMapSTStack(&refST, &refMapST);
          freeSeqSTStack(&queryST);
    
          exit(-1);
       } /*If: the aligment falied*/
 
+      if(settings.pStatsBl && alnMtrxST != 0)
+         waterDropPStats(alnMtrxST, stderr);
+
 
       /*Check if I am filtering the alternative scores*/
       /*
@@ -1007,11 +1540,15 @@ int main(
          if(settings.justScoresBl)
          { /*If: I am printing out scores only*/
             if(outFILE != stdout) fclose(outFILE);
-            if(altAlnFILE != stdout) fclose(altAlnFILE);
+            if(
+                  altAlnFILE != stdout
+               && altAlnFILE != outFILE
+            ) fclose(altAlnFILE);
 
-            freeSeqSTStack(&refST);
+            freeSeqMapSTStack(&refST, &refMapST);
             freeSeqSTStack(&queryST);
             freeAlnMatrix(alnMtrxST);
+            freeAlnSetStack(&settings);
    
             exit(0);
          } /*If: I am printing out scores only*/
@@ -1039,7 +1576,18 @@ int main(
                queryST.endAlnUL
             );
 
-            alnST = Hirschberg(&refST,&queryST,&settings);
+            if(settings.threadsUS > 1)
+               alnST =
+                  hirschThread(&refST, &queryST, &settings);
+            else if(settings.vectBl)
+               alnST =
+                  hirschVectDispatch(
+                     &refST,
+                     &queryST,
+                     &settings
+                  );
+            else
+               alnST = Hirschberg(&refST,&queryST,&settings);
             if(alnST == 0) goto memWaterAltErr;
 
             errUC =             
@@ -1061,12 +1609,14 @@ int main(
             { /*If: I falied to print out the alignment*/
                memWaterAltErr:
 
-               if(altAlnFILE != stdout)
-                  fclose(altAlnFILE);
+               if(
+                     altAlnFILE != stdout
+                  && altAlnFILE != outFILE
+               ) fclose(altAlnFILE);
 
                if(outFILE != stdout) fclose(outFILE);
 
-               freeSeqSTStack(&refST);
+               freeSeqMapSTStack(&refST, &refMapST);
                freeSeqSTStack(&queryST);
                freeAlnMatrix(alnMtrxST);
    
@@ -1095,7 +1645,12 @@ int main(
          queryST.endAlnUL
       );
 
-      alnST = Hirschberg(&refST, &queryST, &settings);
+      if(settings.threadsUS > 1)
+         alnST = hirschThread(&refST, &queryST, &settings);
+      else if(settings.vectBl)
+         alnST =
+            hirschVectDispatch(&refST, &queryST, &settings);
+      else alnST = Hirschberg(&refST, &queryST, &settings);
 
       bestScoreL = alnMtrxST->bestScoreL;
       freeAlnMatrix(alnMtrxST); /*No longer need*/
@@ -1105,7 +1660,7 @@ int main(
    } /*Else if; memory waterman alignment + scan*/
 
    /*****************************************************\
-   * Main Sec-05 Sub-05:
+   * Main Sec-05 Sub-08:
    *  - Check if doing an memory efficent Waterman
    *    alignment that prints out a single alignment
    *    (uses a Hirschberg to get the alignment)
@@ -1113,14 +1668,20 @@ int main(
 
    else if(settings.memWaterBl)
    { /*Else I am just finding the best alignment*/
-     if(settings.noGapBl)
+     if(settings.xDropL || settings.zDropL)
+        alnMtrxST =
+           waterDrop(&queryST, &refST, 0, 0, &settings);
+     else if(settings.vectBl)
+        alnMtrxST =
+           memWaterDispatch(&queryST,&refST,&settings);
+     else if(settings.noGapBl)
         alnMtrxST =
            memWaterNoGap(&queryST,&refST,&settings);
      else alnMtrxST = memWater(&queryST,&refST,&settings);
 
       if(alnMtrxST == 0)
       { /*If: the aligment falied*/
-         freeSeqSTStack(&refST);
+         freeSeqMapSTStack(&refST, &refMapST);
          freeSeqSTStack(&queryST);
        
          fprintf(
@@ -1129,14 +1690,20 @@ int main(
          );
        
          if(outFILE != stdout) fclose(outFILE);
-         if(altAlnFILE != stdout) fclose(altAlnFILE);
+         if(
+               altAlnFILE != stdout
+            && altAlnFILE != outFILE
+         ) fclose(altAlnFILE);
    
-         freeSeqSTStack(&refST);
+         freeSeqMapSTStack(&refST, &refMapST);
          freeSeqSTStack(&queryST);
    
          exit(-1);
       } /*If: the aligment falied*/
 
+      if(settings.pStatsBl && alnMtrxST != 0)
+         waterDropPStats(alnMtrxST, stderr);
+
       indexToCoord(
          alnMtrxST->lenRefUL,
          alnMtrxST->bestStartIndexUL,
@@ -1166,7 +1733,12 @@ int main(
          goto noAlnOutFree;
       } /*If I am just printing out coordinates*/
 
-      alnST = Hirschberg(&refST, &queryST, &settings);
+      if(settings.threadsUS > 1)
+         alnST = hirschThread(&refST, &queryST, &settings);
+      else if(settings.vectBl)
+         alnST =
+            hirschVectDispatch(&refST, &queryST, &settings);
+      else alnST = Hirschberg(&refST, &queryST, &settings);
 
       bestScoreL = alnMtrxST->bestScoreL;
       freeAlnMatrix(alnMtrxST); /*No longer need*/
@@ -1176,13 +1748,18 @@ int main(
    } /*Else I am just finding the best alignment*/
 
    /******************************************************\
-   * Main Sec-05 Sub-06:
+   * Main Sec-05 Sub-09:
    *  - Check if doing an Hirschberg alignment
    \******************************************************/
 
    else if(settings.useHirschBl != 0)
    { /*Else if doing an Hirschberg alignment*/
-     if(settings.noGapBl)
+     if(settings.threadsUS > 1)
+       alnST = hirschThread(&refST, &queryST, &settings);
+     else if(settings.vectBl)
+       alnST =
+          hirschVectDispatch(&refST, &queryST, &settings);
+     else if(settings.noGapBl)
        alnST = HirschbergNoGap(&refST,&queryST,&settings);
      else
         alnST = Hirschberg(&refST, &queryST, &settings);
@@ -1194,12 +1771,12 @@ int main(
    } /*Else if doing an Hirschberg alignment*/
 
    /******************************************************\
-   * Main Sec-05 Sub-07:
+   * Main Sec-05 Sub-10:
    *  - Let user know this was an invalid alignment
    \******************************************************/
    else
    { /*If no aignment was requested*/
-      freeSeqSTStack(&refST);
+      freeSeqMapSTStack(&refST, &refMapST);
       freeSeqSTStack(&queryST);
 
       printHelpMesg(stderr, 1); /*short help*/
@@ -1234,9 +1811,12 @@ int main(
    if(alnST == 0)
    { /*If: I falied to make an alignment array*/
       if(outFILE != stdout) fclose(outFILE);
-      if(altAlnFILE != stdout) fclose(altAlnFILE);
+      if(
+            altAlnFILE != stdout
+         && altAlnFILE != outFILE
+      ) fclose(altAlnFILE);
 
-      freeSeqSTStack(&refST);
+      freeSeqMapSTStack(&refST, &refMapST);
       freeSeqSTStack(&queryST);
 
        fprintf(
@@ -1252,8 +1832,8 @@ int main(
    *   - Print out the alignments
    \*****************************************************/
 
-   lookupIndexToSeq(refST.seqCStr);
-   lookupIndexToSeq(queryST.seqCStr);
+   lookupIndexToSeqVect(refST.seqCStr, refST.lenSeqUL);
+   lookupIndexToSeqVect(queryST.seqCStr, queryST.lenSeqUL);
 
    if(
       printAln(
@@ -1270,10 +1850,13 @@ int main(
       fprintf(stderr, "Failed to print alignment\n");
 
       if(outFILE != stdout) fclose(outFILE);
-      if(altAlnFILE != stdout) fclose(altAlnFILE);
+      if(
+            altAlnFILE != stdout
+         && altAlnFILE != outFILE
+      ) fclose(altAlnFILE);
 
       freeAlnST(alnST); /*NEED TO SET UP*/
-      freeSeqSTStack(&refST);
+      freeSeqMapSTStack(&refST, &refMapST);
       freeSeqSTStack(&queryST);
 
       exit(1);
@@ -1289,10 +1872,15 @@ int main(
    noAlnOutFree: /*When memWater just printing positions*/
 
    if(outFILE != stdout) fclose(outFILE);
-   if(altAlnFILE != stdout) fclose(altAlnFILE);
+   if(
+         altAlnFILE != stdout
+      && altAlnFILE != outFILE
+   ) fclose(altAlnFILE);
 
-   freeSeqSTStack(&refST);
+   freeSeqMapSTStack(&refST, &refMapST);
+   freeAlnRefStack(&refCacheST);
    freeSeqSTStack(&queryST);
+   freeAlnSetStack(&settings);
 
    exit(0);
 } /*main*/
@@ -1309,6 +1897,9 @@ int main(
 |  - refFileCStr:
 |    o Pointer to c-string to hold the name of the fasta
 |      file with the reference sequence
+|  - refNameStr:
+|    o Pointer to c-string to hold the name of the entry
+|      in the reference to align to (-ref-name)
 |  - qryFileCStr:
 |    o Pointer to c-string to hold the name of the fasta
 |      file with the query sequence
@@ -1356,6 +1947,7 @@ char * checkInput(
     int *lenArgsInt,     /*Number arguments user input*/
     char *argsCStr[],    /*Array with user arguments*/
     char **refFileCStr,  /*file name of reference file*/
+    char **refNameStr,   /*Reference entry (-ref-name)*/
     char **queryFileCStr,/*File name of the query file*/
     char **outFileStr,     /*Name of the output file*/
     char **altAlnFileStr, /*file: alternative alignments*/
@@ -1434,6 +2026,12 @@ char * checkInput(
             ++iArg;
         } /*If: the user provied a reference sequence*/
 
+        else if(strcmp(tmpCStr, "-ref-name") == 0)
+        { /*Else If: aligning to one reference entry*/
+            *refNameStr = singleArgCStr;
+            ++iArg;
+        } /*Else If: aligning to one reference entry*/
+
         else if(strcmp(tmpCStr, "-query") == 0)
         { /*If: the user provied a query sequence*/
             *queryFileCStr = singleArgCStr;
@@ -1451,6 +2049,7 @@ char * checkInput(
            settings->useWaterBl = 0;
            settings->useHirschBl = 0;
            settings->memWaterBl = 0;
+           settings->useWfaBl = 0;
        } /*Else if using a needleman alignment*/
 
        else if(strcmp(tmpCStr, "-use-water") == 0)
@@ -1459,6 +2058,7 @@ char * checkInput(
           settings->useWaterBl = 1;
            settings->useHirschBl = 0;
            settings->memWaterBl = 0;
+           settings->useWfaBl = 0;
        } /*Else if doing a waterman smith alignment*/
 
        else if(strcmp(tmpCStr, "-use-hirschberg") == 0)
@@ -1467,6 +2067,7 @@ char * checkInput(
            settings->useWaterBl = 0;
            settings->useHirschBl = 1;
            settings->memWaterBl = 0;
+           settings->useWfaBl = 0;
        } /*Else if doing a Hirshberg alignment*/
 
        else if(strcmp(tmpCStr, "-use-mem-water") == 0)
@@ -1475,8 +2076,23 @@ char * checkInput(
            settings->useWaterBl = 0;
            settings->useHirschBl = 0;
            settings->memWaterBl = 1;
+           settings->useWfaBl = 0;
        } /*Else if I am doing a memory effecient water*/
 
+       else if(strcmp(tmpCStr, "-use-wfa") == 0)
+       { /*Else if doing a wavefront alignment*/
+           settings->useNeedleBl = 0;
+           settings->useWaterBl = 0;
+           settings->useHirschBl = 0;
+           settings->memWaterBl = 0;
+           settings->useWfaBl = 1;
+       } /*Else if doing a wavefront alignment*/
+
+       else if(strcmp(tmpCStr, "-wfa-low-mem") == 0)
+          settings->wfaLowMemBl = 1;
+       else if(strcmp(tmpCStr, "-wfa-full-mem") == 0)
+          settings->wfaLowMemBl = 0;
+
        /*************************************************\
        * Fun-01 Sec-02 sub-04:
        *  - Main file format options
@@ -1554,6 +2170,7 @@ char * checkInput(
           settings->refQueryScanBl = 1;
           settings->useNeedleBl = 0;
           settings->useHirschBl = 0;
+          settings->useWfaBl = 0;
 
           if(!(settings->useWaterBl))
              settings->memWaterBl = 1;
@@ -1577,6 +2194,34 @@ char * checkInput(
            ++iArg;
         } /*Else If: have a min score to keep alignment*/
 
+        else if(strcmp(tmpCStr, "-x-drop") == 0)
+        { /*Else If: stopping cells far below the best*/
+           if(
+                 *base10StrToSL(
+                    singleArgCStr,
+                    settings->xDropL
+                 )
+              != '\0'
+           ) return tmpCStr;
+
+           if(settings->xDropL < 0) return tmpCStr;
+           ++iArg;
+        } /*Else If: stopping cells far below the best*/
+
+        else if(strcmp(tmpCStr, "-z-drop") == 0)
+        { /*Else If: stopping rows far below the best*/
+           if(
+                 *base10StrToSL(
+                    singleArgCStr,
+                    settings->zDropL
+                 )
+              != '\0'
+           ) return tmpCStr;
+
+           if(settings->zDropL < 0) return tmpCStr;
+           ++iArg;
+        } /*Else If: stopping rows far below the best*/
+
         /*Check if filtering by query overlaps*/
         else if(strcmp(tmpCStr, "-filt-query") == 0)
            settings->filtQryBl = 1;
@@ -1607,6 +2252,75 @@ char * checkInput(
        *  - General alignment options
        \*************************************************/
 
+       else if(strcmp(tmpCStr, "-vect") == 0)
+          settings->vectBl = 1;
+       else if(strcmp(tmpCStr, "-no-vect") == 0)
+          settings->vectBl = 0;
+
+       else if(strcmp(tmpCStr, "-vect-set") == 0)
+       { /*Else If: picking the vector instruction set*/
+          settings->vectSetC =
+             vectDispatchStrToSet(singleArgCStr);
+
+          if(settings->vectSetC == 0) return tmpCStr;
+          ++iArg;
+       } /*Else If: picking the vector instruction set*/
+
+       else if(strcmp(tmpCStr, "-band") == 0)
+       { /*Else If: doing a banded alignment*/
+          settings->bandAutoBl =
+             strcmp(singleArgCStr, "auto") == 0;
+
+          if(settings->bandAutoBl)
+             settings->bandUL = defBandAutoStart;
+
+          else if(
+                *base10StrToUL(singleArgCStr, settings->bandUL)
+             != '\0'
+          ) return tmpCStr;
+
+          ++iArg;
+       } /*Else If: doing a banded alignment*/
+
+       else if(strcmp(tmpCStr, "-no-band") == 0)
+       { /*Else If: using the full matrix*/
+          settings->bandUL = 0;
+          settings->bandAutoBl = 0;
+       } /*Else If: using the full matrix*/
+
+       else if(strcmp(tmpCStr, "-threads") == 0)
+       { /*Else If: number of threads to use*/
+          if(
+                *base10StrToUS(
+                   singleArgCStr,
+                   settings->threadsUS
+                ) != '\0'
+             || settings->threadsUS == 0
+          ) return tmpCStr;
+
+          if(settings->threadsUS > defMaxThreads)
+             settings->threadsUS = defMaxThreads;
+
+          ++iArg;
+       } /*Else If: number of threads to use*/
+
+       else if(strcmp(tmpCStr, "-batch") == 0)
+          settings->batchBl = 1;
+       else if(strcmp(tmpCStr, "-no-batch") == 0)
+          settings->batchBl = 0;
+       else if(strcmp(tmpCStr, "-longest-first") == 0)
+          settings->longFirstBl = 1;
+       else if(strcmp(tmpCStr, "-no-longest-first") == 0)
+          settings->longFirstBl = 0;
+       else if(strcmp(tmpCStr, "-stats") == 0)
+          settings->pStatsBl = 1;
+       else if(strcmp(tmpCStr, "-no-stats") == 0)
+          settings->pStatsBl = 0;
+       else if(strcmp(tmpCStr, "-qry-rev-comp") == 0)
+          settings->qryRevCmpBl = 1;
+       else if(strcmp(tmpCStr, "-no-qry-rev-comp") == 0)
+          settings->qryRevCmpBl = 0;
+
        else if(strcmp(tmpCStr, "-no-gapextend") == 0)
           settings->noGapBl = 1;
        else if(strcmp(tmpCStr, "-use-gapextend") == 0)
@@ -1820,6 +2534,16 @@ void printHelpMesg(
    );
    fprintf(outFILE, "sequences \n");
 
+   fprintf(
+      outFILE,
+      "alnSeq index -ref ref.fasta"
+      " [-out ref.fasta.alnref]\n"
+   );
+   fprintf(
+      outFILE,
+      "  - Builds a cache of the reference for -ref\n"
+   );
+
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
    ^ Fun-02 Sec-02:
    ^  - Input block
@@ -1850,13 +2574,44 @@ void printHelpMesg(
    fprintf(outFILE, "    -query: [Required]\n");
    fprintf(
       outFILE,
-      "      o Fasta file with query sequence.\n"
+      "      o Fasta or fastq file with query"
+      " sequence.\n"
+   );
+
+   if(defQryRevCmp)
+       fprintf(outFILE, "    -qry-rev-comp: [Yes]\n");
+   else fprintf(outFILE, "    -qry-rev-comp: [No]\n");
+
+   fprintf(
+      outFILE,
+      "      o Align the reverse complement of the query."
+      "\n        -query-start and -query-end are on the"
+      " reverse\n        complement. Not used with"
+      " -batch.\n"
    );
+   fprintf(outFILE, "      o Disable: -no-qry-rev-comp\n");
 
    fprintf(outFILE, "    -ref: [Required]\n");
    fprintf(
       outFILE,
-      "      o Fasta file with reference sequence.\n"
+      "      o Fasta or fastq file with reference"
+      " sequence.\n"
+   );
+   fprintf(
+      outFILE,
+      "      o -ref and -query can be gzip compressed"
+      " (.gz).\n"
+   );
+   fprintf(
+      outFILE,
+      "      o -ref can be a cache from alnSeq index"
+      " (.alnref).\n        The cache is mapped and"
+      " only the entry (or\n        -ref-name region)"
+      " is unpacked. Not used with -batch.\n"
+      "        -use-needle -only-scores unpacks one tile"
+      " at a time.\n"
+      "        The cache must be a file; pipes are read"
+      " as fasta.\n"
    );
 
    fprintf(outFILE, "    -out: [stdout]\n");
@@ -1882,6 +2637,26 @@ void printHelpMesg(
       outFILE,
       "      o Do a Needleman Wunsch alignment.\n" 
    );
+   fprintf(
+      outFILE,
+      "      o Unit costs (one match and one mismatch"
+   );
+   fprintf(
+      outFILE,
+      "\n        score, gap extend = gap open, and"
+   );
+   fprintf(
+      outFILE,
+      "\n        2 * (match - mismatch) = match - 2 * gap)"
+   );
+   fprintf(
+      outFILE,
+      "\n        use a bit-vector (Myers) edit distance"
+   );
+   fprintf(
+      outFILE,
+      "\n        alignment with the same output.\n"
+   );
 
    if(defUseWater)
       fprintf(outFILE, "    -use-water: [Yes]\n");
@@ -1901,31 +2676,400 @@ void printHelpMesg(
       "      o Do a Hirschberg alignment.\n"
    );
 
-   if(defUseMemWater)
-       fprintf(outFILE, "    -use-mem-water: [Yes]\n");
-   else fprintf(outFILE, "    -use-mem-water: [No]\n");
+   if(defUseWfa)
+       fprintf(outFILE, "    -use-wfa: [Yes]\n");
+   else fprintf(outFILE, "    -use-wfa: [No]\n");
 
    fprintf(
       outFILE,
-      "      o Do a memory efficent Waterman alignment.\n"
+      "      o Do a wavefront (WFA) global alignment.\n"
    );
-
    fprintf(
-     outFILE,
-     "      o Uses a Waterman to find the starting and"
+      outFILE,
+      "      o Time and memory depend on the score, so"
    );
-   fprintf(outFILE, " ending\n        positions.");
    fprintf(
       outFILE,
-      " A Hirschberg is then used to find\n"
+      "\n        this is best for nearly the same"
    );
-   fprintf(outFILE, "        the alignment.\n");
-
-   /******************************************************\
-   * Fun-02 Sec-02 Sub-03:
-   *  - Alignment paramaters block
-   \******************************************************/
-
+   fprintf(outFILE, " sequences.\n");
+   fprintf(
+      outFILE,
+      "      o Gap scores have to be below half the"
+   );
+   fprintf(
+      outFILE,
+      "\n        match score and gap extend can not be"
+   );
+   fprintf(
+      outFILE,
+      "\n        worse than gap open (else -use-needle).\n"
+   );
+
+   if(defWfaLowMem)
+       fprintf(outFILE, "    -wfa-low-mem: [Yes]\n");
+   else fprintf(outFILE, "    -wfa-low-mem: [No]\n");
+
+   fprintf(
+      outFILE,
+      "      o Use a bidirectional (BiWFA) -use-wfa that"
+   );
+   fprintf(
+      outFILE,
+      "\n        only keeps the last few wavefronts.\n"
+   );
+   fprintf(
+      outFILE,
+      "      o Disable with -wfa-full-mem.\n"
+   );
+
+   if(defUseMemWater)
+       fprintf(outFILE, "    -use-mem-water: [Yes]\n");
+   else fprintf(outFILE, "    -use-mem-water: [No]\n");
+
+   fprintf(
+      outFILE,
+      "      o Do a memory efficent Waterman alignment.\n"
+   );
+
+   fprintf(
+     outFILE,
+     "      o Uses a Waterman to find the starting and"
+   );
+   fprintf(outFILE, " ending\n        positions.");
+   fprintf(
+      outFILE,
+      " A Hirschberg is then used to find\n"
+   );
+   fprintf(outFILE, "        the alignment.\n");
+
+   if(defUseVect)
+       fprintf(outFILE, "    -vect: [Yes]\n");
+   else fprintf(outFILE, "    -vect: [No]\n");
+
+   fprintf(
+      outFILE,
+      "      o Use vectors (SIMD) for -use-mem-water,"
+   );
+   fprintf(
+      outFILE,
+      "\n        -use-hirschberg, -use-needle, and"
+   );
+   fprintf(
+      outFILE,
+      "\n        -use-water. This needs alnSeq to be"
+   );
+   fprintf(
+      outFILE,
+      "\n        compiled with -DSSE2, -DSSE4, -DAVX2, or"
+   );
+   fprintf(
+      outFILE,
+      "\n        -DVECTDISPATCH (see -flags).\n"
+   );
+   fprintf(
+      outFILE,
+      "      o -use-mem-water, -use-needle, and"
+   );
+   fprintf(
+      outFILE,
+      "\n        -use-water only support the delInsSnp"
+   );
+   fprintf(
+      outFILE,
+      "\n        direction; others use the scalar"
+   );
+   fprintf(outFILE, " alignment.\n");
+   fprintf(
+      outFILE,
+      "      o -use-hirschberg uses 16 bit vectors when the"
+   );
+   fprintf(
+      outFILE,
+      "\n        scores fit and 32 bit vectors for longer"
+   );
+   fprintf(outFILE, " sequences.\n");
+   fprintf(
+      outFILE,
+      "      o -use-needle and -use-water do the same,"
+   );
+   fprintf(
+      outFILE,
+      "\n        but use the scalar alignment for short"
+   );
+   fprintf(outFILE, "\n        references.\n");
+   fprintf(
+      outFILE,
+      "      o Long -use-needle alignments (without"
+   );
+   fprintf(
+      outFILE,
+      "\n        -two-bit) store 8 bit score differences"
+   );
+   fprintf(
+      outFILE,
+      "\n        instead of 32 bit scores.\n"
+   );
+   fprintf(outFILE, "      o Disable: -no-vect\n");
+
+   fprintf(
+      outFILE,
+      "    -vect-set: [%s]\n",
+      vectDispatchSetToStr(defVectSet)
+   );
+   fprintf(
+      outFILE,
+      "      o Vector instruction set for -vect and -batch"
+   );
+   fprintf(
+      outFILE,
+      "\n        (auto, scalar, sse2, sse4, or avx2). auto"
+   );
+   fprintf(
+      outFILE,
+      " uses\n        the %s environment variable",
+      defVectEnvStr
+   );
+   fprintf(
+      outFILE,
+      " or\n        the widest set the cpu has."
+   );
+   fprintf(
+      outFILE,
+      "\n      o Sets the cpu does not have are lowered."
+   );
+   fprintf(
+      outFILE,
+      "\n      o Without -DVECTDISPATCH only scalar and the"
+   );
+   fprintf(
+      outFILE,
+      "\n        set compiled in (see -flags) can be used.\n"
+   );
+
+   if(defBatch)
+       fprintf(outFILE, "    -batch: [Yes]\n");
+   else fprintf(outFILE, "    -batch: [No]\n");
+
+   fprintf(
+      outFILE,
+      "      o Align every query record instead of only"
+   );
+   fprintf(
+      outFILE,
+      " the\n        first. Pairs are aligned together in"
+   );
+   fprintf(
+      outFILE,
+      " vectors\n        (SIMD) when compiled with vector"
+   );
+   fprintf(
+      outFILE,
+      " support.\n      o If -ref has one record, each"
+   );
+   fprintf(
+      outFILE,
+      " query is aligned\n        to it. Otherwise the nth"
+   );
+   fprintf(
+      outFILE,
+      " query is aligned to\n        the nth reference.\n"
+   );
+   fprintf(
+      outFILE,
+      "      o -ref and -query can be fasta or fastq."
+   );
+   fprintf(
+      outFILE,
+      " The\n        reference and scoring settings are"
+   );
+   fprintf(
+      outFILE,
+      " set up once\n        and each alignment is"
+   );
+   fprintf(
+      outFILE,
+      " printed when its batch\n        is done (with"
+   );
+   fprintf(outFILE, " the query and reference ids).\n");
+   fprintf(
+      outFILE,
+      "      o Works with -use-needle, -use-water, and"
+   );
+   fprintf(outFILE, "\n        -use-mem-water.\n");
+   fprintf(
+      outFILE,
+      "      o With -threads over 1 or -use-hirschberg,"
+   );
+   fprintf(
+      outFILE,
+      " each\n        pair is one task for the threads"
+   );
+   fprintf(
+      outFILE,
+      " (no\n        vectors). Idle threads take tasks"
+   );
+   fprintf(
+      outFILE,
+      " from\n        busy threads, and alignments are"
+   );
+   fprintf(outFILE, " printed in\n        input order.\n");
+   fprintf(
+      outFILE,
+      "      o Vector pairs are scored with 8 bit scores"
+   );
+   fprintf(
+      outFILE,
+      " first.\n        Pairs that overflow are redone"
+   );
+   fprintf(outFILE, " with 16 bit,\n        then 32 bit");
+   fprintf(
+      outFILE,
+      " scores. Watermans with\n        -only-scores always"
+   );
+   fprintf(outFILE, " use 32 bit scores.\n");
+   fprintf(outFILE, "      o Disable: -no-batch\n");
+
+   if(defLongFirst)
+       fprintf(outFILE, "    -longest-first: [Yes]\n");
+   else fprintf(outFILE, "    -longest-first: [No]\n");
+
+   fprintf(
+      outFILE,
+      "      o Start the largest (query * reference) -batch"
+   );
+   fprintf(
+      outFILE,
+      "\n        pairs first when using threads, so one"
+   );
+   fprintf(
+      outFILE,
+      " long\n        pair is not left for the end.\n"
+   );
+   fprintf(outFILE, "      o Disable: -no-longest-first\n");
+
+   if(defPStats)
+       fprintf(outFILE, "    -stats: [Yes]\n");
+   else fprintf(outFILE, "    -stats: [No]\n");
+
+   fprintf(
+      outFILE,
+      "      o Print the number of -batch pairs scored with"
+   );
+   fprintf(
+      outFILE,
+      "\n        8 bit, 16 bit, 32 bit, and scalar scores"
+   );
+   fprintf(outFILE, " to\n        stderr.\n");
+   fprintf(
+      outFILE,
+      "      o Also prints the cells scored by -x-drop and"
+   );
+   fprintf(outFILE, "\n        -z-drop to stderr.\n");
+   fprintf(
+      outFILE,
+      "      o Threaded -batch prints the tasks and use"
+   );
+   fprintf(
+      outFILE,
+      " (time\n        in tasks / run time) of each"
+   );
+   fprintf(outFILE, " thread.\n");
+   fprintf(outFILE, "      o Disable: -no-stats\n");
+
+   fprintf(outFILE, "    -threads: [%i]\n", defThreads);
+   fprintf(
+      outFILE,
+      "      o Number of threads to use for -use-hirschberg"
+   );
+   fprintf(
+      outFILE,
+      "\n        and the Hirschberg step of -use-mem-water."
+   );
+   fprintf(outFILE, "\n");
+   fprintf(
+      outFILE,
+      "      o The forward and reverse scores and the two"
+   );
+   fprintf(
+      outFILE,
+      "\n        halves of each split are run at the same"
+   );
+   fprintf(outFILE, " time.\n");
+   fprintf(
+      outFILE,
+      "      o More than one thread uses the scalar"
+   );
+   fprintf(
+      outFILE,
+      " Hirschberg\n        (-vect is ignored).\n"
+   );
+   fprintf(
+      outFILE,
+      "      o -use-needle and -use-water (not -band, -x-drop,"
+   );
+   fprintf(
+      outFILE,
+      "\n        or -z-drop) score tiles of the matrix, one"
+   );
+   fprintf(
+      outFILE,
+      "\n        anti-diagonal of tiles at a time (-vect is"
+   );
+   fprintf(outFILE, "\n        ignored).\n");
+
+   if(defBandAuto)
+      fprintf(outFILE, "    -band: [auto]\n");
+   else if(defBand)
+      fprintf(outFILE, "    -band: [%i]\n", defBand);
+   else fprintf(outFILE, "    -band: [No]\n");
+
+   fprintf(
+      outFILE,
+      "      o Only score and store the cells within this"
+   );
+   fprintf(
+      outFILE,
+      "\n        many cells of the diagonals between the"
+   );
+   fprintf(
+      outFILE,
+      "\n        matrix start and end (-band 100). Uses"
+   );
+   fprintf(
+      outFILE,
+      "\n        query length * band cells instead of query"
+   );
+   fprintf(
+      outFILE,
+      "\n        length * reference length cells.\n"
+   );
+   fprintf(
+      outFILE,
+      "      o -band auto starts with a band of %i and",
+      defBandAutoStart
+   );
+   fprintf(
+      outFILE,
+      "\n        doubles the band till the best path does"
+   );
+   fprintf(outFILE, "\n        not touch a band edge.\n");
+   fprintf(
+      outFILE,
+      "      o Works with -use-needle and -use-water"
+   );
+   fprintf(
+      outFILE,
+      "\n        (not -query-ref-scan). Overrides -vect and"
+   );
+   fprintf(outFILE, "\n        -two-bit.\n");
+   fprintf(outFILE, "      o Disable: -no-band\n");
+
+   /******************************************************\
+   * Fun-02 Sec-02 Sub-03:
+   *  - Alignment paramaters block
+   \******************************************************/
+
    fprintf(outFILE, "  Alignment settings:\n");
 
    if(defUseTwoBit)
@@ -2032,6 +3176,34 @@ void printHelpMesg(
       "      o Last base in reference align (index 1)\n"
    );
 
+   fprintf(outFILE, "    -ref-name: [None]\n");
+   fprintf(
+      outFILE,
+      "      o Name of the reference entry to align to."
+   );
+   fprintf(
+      outFILE,
+      " Only\n        -ref-start to -ref-end of this entry"
+   );
+   fprintf(outFILE, " is read in.\n");
+   fprintf(
+      outFILE,
+      "      o Uses the -ref.fai index (samtools faidx);"
+   );
+   fprintf(
+      outFILE,
+      " this is\n        made when there is no index.\n"
+   );
+   fprintf(
+      outFILE,
+      "      o The reference id is name:start-end and"
+   );
+   fprintf(
+      outFILE,
+      " positions\n        are in the region.\n"
+   );
+   fprintf(outFILE, "      o Not used with -batch.\n");
+
    fprintf(outFILE, "    -query-start: 1\n");
    fprintf(
       outFILE,
@@ -2089,9 +3261,67 @@ void printHelpMesg(
    fprintf(outFILE,"    -min-score: [%i]\n", defMinScore);
    fprintf(
       outFILE,
-      "      o Minimum score needed to keep an\n"
+      "      o Minimum score needed to keep an\n"
+   );
+   fprintf(outFILE, "        alternative alignment.\n");
+
+   if(defXDrop)
+      fprintf(outFILE, "    -x-drop: [%i]\n", defXDrop);
+   else fprintf(outFILE, "    -x-drop: [No]\n");
+
+   fprintf(
+      outFILE,
+      "      o Stop scoring cells that are more than this"
+   );
+   fprintf(
+      outFILE,
+      "\n        below the best score (-x-drop 100)."
+   );
+   fprintf(
+      outFILE,
+      "\n        Once no new alignment can start, only"
+   );
+   fprintf(
+      outFILE,
+      "\n        cells next to kept cells are scored and"
+   );
+   fprintf(
+      outFILE,
+      "\n        the alignment ends when none are kept.\n"
+   );
+
+   if(defZDrop)
+      fprintf(outFILE, "    -z-drop: [%i]\n", defZDrop);
+   else fprintf(outFILE, "    -z-drop: [No]\n");
+
+   fprintf(
+      outFILE,
+      "      o End the alignment when the best score in a"
+   );
+   fprintf(
+      outFILE,
+      "\n        row is more than this + gap extension *"
+   );
+   fprintf(
+      outFILE,
+      "\n        diagonals from the best score below the"
+   );
+   fprintf(
+      outFILE,
+      "\n        best score (-z-drop 200).\n"
+   );
+   fprintf(
+      outFILE,
+      "      o -x-drop and -z-drop work with -use-water and"
+   );
+   fprintf(
+      outFILE,
+      "\n        -use-mem-water. They override -vect and"
+   );
+   fprintf(
+      outFILE,
+      "\n        -two-bit (-band is used over them).\n"
    );
-   fprintf(outFILE, "        alternative alignment.\n");
 
 
    if(defFilterByQueryRef)
@@ -2181,7 +3411,15 @@ void printHelpMesg(
    );
    fprintf(
       outFILE,
-      "      o Only for the memory effiecent Watermans\n"
+      "      o Only for the memory effiecent Watermans"
+   );
+   fprintf(
+      outFILE,
+      "\n        and Needleman (-use-needle) alignments\n"
+   );
+   fprintf(
+      outFILE,
+      "      o Needleman only keeps two rows of scores\n"
    );
    fprintf(
       outFILE,
@@ -2572,6 +3810,38 @@ void printCompileSettings(
       fprintf(outFILE, "   -DDELINSSNP\n");
    #endif
 
+   #if defined AVX512
+      fprintf(outFILE, "   -DAVX512\n");
+   #elif defined AVX2
+      fprintf(outFILE, "   -DAVX2\n");
+   #elif defined SSE4
+      fprintf(outFILE, "   -DSSE4\n");
+   #elif defined NEON
+      fprintf(outFILE, "   -DNEON\n");
+   #elif defined NEON64
+      fprintf(outFILE, "   -DNEON64\n");
+   #elif defined SSE2
+      fprintf(outFILE, "   -DSSE2\n");
+   #endif
+
+   #if defined VECTDISPATCH
+      fprintf(outFILE, "   -DVECTDISPATCH\n");
+   #endif
+
+   #if defined NOMMAP
+      fprintf(outFILE, "   -DNOMMAP\n");
+   #endif
+
+   #if defined ZLIB
+      fprintf(outFILE, "   -DZLIB\n");
+   #endif
+
+   fprintf(
+      outFILE,
+      "Vector set (-vect-set auto): %s\n",
+      vectDispatchSetToStr(vectDispatchPick(defVectAuto))
+   );
+
    if(!pDescBl) return;
 
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
@@ -2601,6 +3871,14 @@ void printCompileSettings(
    ^    - Print out what the -DDELSNPINS flag does
    ^  o fun-03 sec-02 sub-12:
    ^    - Print out what the -DDELINSSNP flag does
+   ^  o fun-03 sec-02 sub-13:
+   ^    - Print out what the vector flags do
+   ^  o fun-03 sec-02 sub-14:
+   ^    - Print out what the -DVECTDISPATCH flag does
+   ^  o fun-03 sec-02 sub-15:
+   ^    - Print out what the -DNOMMAP flag does
+   ^  o fun-03 sec-02 sub-16:
+   ^    - Print out what the -DZLIB flag does
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
    /*****************************************************\
@@ -2805,5 +4083,796 @@ void printCompileSettings(
    );
    fprintf(outFILE, "\n       SNPs/Matches.\n");
 
+   /*****************************************************\
+   * Fun-03 Sec-02 Sub-13:
+   *  - Print out what the vector flags do
+   \*****************************************************/
+
+   fprintf(outFILE, "   -DSSE2, -DSSE4, or -DAVX2:\n");
+   fprintf(
+      outFILE,
+      "     - Compile the vector (SIMD) memWater used by"
+   );
+   fprintf(outFILE, "\n       -vect and the batch aligner");
+   fprintf(outFILE, " used by -batch.\n       Without a");
+   fprintf(outFILE, " flag both use the scalar");
+   fprintf(outFILE, " aligners.\n");
+   fprintf(
+      outFILE,
+      "     - -DSSE4 needs -msse4.1 and -DAVX2 needs -mavx2"
+   );
+   fprintf(outFILE, "\n       (make sse or make avx2)\n");
+
+   /*****************************************************\
+   * Fun-03 Sec-02 Sub-14:
+   *  - Print out what the -DVECTDISPATCH flag does
+   \*****************************************************/
+
+   fprintf(outFILE, "   -DVECTDISPATCH:\n");
+   fprintf(
+      outFILE,
+      "     - Links the SSE2, SSE4, and AVX2 vector code"
+   );
+   fprintf(
+      outFILE,
+      " into\n       one binary and picks the widest set"
+   );
+   fprintf(
+      outFILE,
+      " the cpu\n       has when alnSeq runs (make"
+   );
+   fprintf(outFILE, " dispatch).\n");
+   fprintf(
+      outFILE,
+      "     - Do not use with -DSSE2, -DSSE4, or -DAVX2.\n"
+   );
+
+   /*****************************************************\
+   * Fun-03 Sec-02 Sub-15:
+   *  - Print out what the -DNOMMAP flag does
+   \*****************************************************/
+
+   fprintf(outFILE, "   -DNOMMAP:\n");
+   fprintf(
+      outFILE,
+      "     - Always copy the reference into memory. By"
+   );
+   fprintf(
+      outFILE,
+      "\n       default large fasta references (16 MiB+)"
+   );
+   fprintf(
+      outFILE,
+      " are\n       used in place from a map (mmap) of the"
+   );
+   fprintf(outFILE, " file.\n");
+   fprintf(
+      outFILE,
+      "     - Use for systems without mmap.\n"
+   );
+
+   /*****************************************************\
+   * Fun-03 Sec-02 Sub-16:
+   *  - Print out what the -DZLIB flag does
+   \*****************************************************/
+
+   fprintf(outFILE, "   -DZLIB:\n");
+   fprintf(
+      outFILE,
+      "     - Use the system zlib to read gzip files"
+   );
+   fprintf(
+      outFILE,
+      " instead\n       of the bundled decompressor (make"
+   );
+   fprintf(outFILE, " zlib).\n");
+
    return;
 } /*printCompileSettings*/
+
+/*-------------------------------------------------------\
+| Fun-04: batchAlnFiles
+|   - Aligns every query record to a reference record.
+|     Pairs are aligned defBatchPairs at a time with
+|     batchAln (vectors when compiled with vectors).
+|   - With more than one thread (settings->threadsUS) or
+|     a Hirschberg, each pair is a task for a thread pool
+|     (batchThreadAln). Alignments are still printed in
+|     input order.
+|   - If the reference file has one record, every query
+|     is aligned to it. Otherwise the nth query record is
+|     aligned to the nth reference record.
+| Input:
+|   - refFileStr:
+|     o C-string with the name of the reference fasta or
+|       fastq file
+|   - qryFileStr:
+|     o C-string with the name of the query fasta or fastq
+|       file (any number of records)
+|   - outFileStr:
+|     o C-string with the name of the file to print the
+|       alignments to (0 or "-" for stdout)
+|   - scoreMtrxFileStr:
+|     o C-string with the name of the scoring matrix file
+|       (for printAln)
+|   - settings:
+|     o alnSet structure with the alignment settings
+| Output:
+|   - Prints:
+|     o The alignment for each pair to outFileStr or,
+|       if settings->justScoresBl is 1, a line with the
+|       query id, reference id, score, reference start,
+|       reference end, query start, and query end
+|     o The number of pairs scored with 8, 16, 32 bit, and
+|       scalar scores to stderr (settings->pStatsBl = 1)
+|     o The tasks and use of each thread to stderr
+|       (settings->pStatsBl = 1 and a thread pool)
+|   - Returns:
+|     o 0 for no errors
+|     o 1 for an alignment method that can not be batched
+|     o 2 for an invalid reference file
+|     o 4 for an invalid query file
+|     o 8 if an alignment could not be printed
+|     o 64 for memory errors
+\-------------------------------------------------------*/
+char batchAlnFiles(
+   char *refFileStr,      /*Reference fasta/fastq file*/
+   char *qryFileStr,      /*Query fasta/fastq file*/
+   char *outFileStr,      /*File to print alignments to*/
+   char *scoreMtrxFileStr,/*Scoring matrix file*/
+   struct alnSet *settings/*Alignment settings*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-04 TOC: batchAlnFiles
+   '  - Aligns every query record to a reference record
+   '  o fun-04 sec-01:
+   '    - Variable declerations
+   '  o fun-04 sec-02:
+   '    - Check the settings and allocate memory
+   '  o fun-04 sec-03:
+   '    - Open the files and read the first reference
+   '  o fun-04 sec-04:
+   '    - Read in a batch of pairs and align them
+   '  o fun-04 sec-05:
+   '    - Clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-04 Sec-01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   char errC = 0;
+   uchar qryErrUC = 1; /*1: have more query records*/
+   uchar refErrUC = 1;
+   char pairBl = 0;    /*1: nth query to nth reference*/
+   char mismatchBl = 0;/*1: uneven number of records*/
+   char oldIdC = 0;
+   char *idEndStr = 0;
+
+   ulong numPairsUL = 0;
+   ulong numRefUL = 0; /*References already read in*/
+   ulong ulPair = 0;
+   ulong refStartUL = 0;
+   ulong refEndUL = 0;
+   ulong qryStartUL = 0;
+   ulong qryEndUL = 0;
+
+   /*Pairs per score size; index is bits / 8, 0: scalar*/
+   ulong numBitsAryUL[5] = {0, 0, 0, 0, 0};
+   char bitsC = 0;
+
+   struct seqStruct *qryAryST = 0;
+   struct seqStruct *refAryST = 0;
+   struct seqStruct **qryPtrAryST = 0;
+   struct seqStruct **refPtrAryST = 0;
+   struct seqStruct *qryST = 0;
+   struct seqStruct *refST = 0;
+
+   struct alnMatrix *matrixAryST = 0;
+   struct alnMatrix *mtrxST = 0;
+   struct alnStruct *alnST = 0;
+
+   /*For aligning each pair as a thread pool task*/
+   char poolBl = 0;    /*1: use the thread pool*/
+   struct batchThread threadST;
+   struct batchPair *pairAryST = 0;
+   ulong *orderAryUL = 0; /*Order pairs are started in*/
+
+   FILE *refFILE = 0;
+   FILE *qryFILE = 0;
+   FILE *outFILE = 0;
+   struct seqFile refFileST; /*Block reader for refFILE*/
+   struct seqFile qryFileST; /*Block reader for qryFILE*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-04 Sec-02:
+   ^  - Check the settings and allocate memory
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   threadST.setAryST = 0; /*Marks pool as not started*/
+   initSeqFile(&refFileST);
+   initSeqFile(&qryFileST);
+
+   if(
+         settings->refQueryScanBl
+      || (
+            ! settings->useNeedleBl
+         && ! settings->useWaterBl
+         && ! settings->memWaterBl
+         && ! settings->useHirschBl
+      )
+   ) return 1; /*Only Needleman/Waterman/Hirschberg*/
+
+   poolBl =
+      (settings->threadsUS > 1 || settings->useHirschBl);
+
+   qryAryST =
+      malloc(defBatchPairs * sizeof(struct seqStruct));
+   refAryST =
+      malloc(defBatchPairs * sizeof(struct seqStruct));
+   qryPtrAryST =
+      malloc(defBatchPairs * sizeof(struct seqStruct *));
+   refPtrAryST =
+      malloc(defBatchPairs * sizeof(struct seqStruct *));
+
+   if(poolBl)
+   { /*If: aligning pairs with the thread pool*/
+      pairAryST =
+         calloc(defBatchPairs, sizeof(struct batchPair));
+      orderAryUL = malloc(defBatchPairs * sizeof(ulong));
+   } /*If: aligning pairs with the thread pool*/
+
+   if(
+         qryAryST == 0
+      || refAryST == 0
+      || qryPtrAryST == 0
+      || refPtrAryST == 0
+      || (poolBl && (pairAryST == 0 || orderAryUL == 0))
+   ){ /*If: I had a memory error*/
+      if(qryAryST != 0) free(qryAryST);
+      if(refAryST != 0) free(refAryST);
+      if(qryPtrAryST != 0) free(qryPtrAryST);
+      if(refPtrAryST != 0) free(refPtrAryST);
+      if(pairAryST != 0) free(pairAryST);
+      if(orderAryUL != 0) free(orderAryUL);
+      return 64;
+   } /*If: I had a memory error*/
+
+   for(ulPair = 0; ulPair < defBatchPairs; ++ulPair)
+   { /*Loop: initialize the sequence structures*/
+      initSeqST(&qryAryST[ulPair]);
+      initSeqST(&refAryST[ulPair]);
+   } /*Loop: initialize the sequence structures*/
+
+   if(poolBl)
+   { /*If: aligning pairs with the thread pool*/
+      if(
+         initBatchThread(
+            &threadST,
+            settings->useNeedleBl,
+            ! settings->justScoresBl,
+            settings->useHirschBl,
+            settings
+         )
+      ) {errC = 64; goto cleanUp;}
+
+      for(ulPair = 0; ulPair < defBatchPairs; ++ulPair)
+         pairAryST[ulPair].threadST = &threadST;
+   } /*If: aligning pairs with the thread pool*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-04 Sec-03:
+   ^  - Open the files and read the first reference
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   refFILE = fopen(refFileStr, "r");
+   if(refFILE == 0) {errC = 2; goto cleanUp;}
+
+   qryFILE = fopen(qryFileStr, "r");
+   if(qryFILE == 0) {errC = 4; goto cleanUp;}
+
+   if(openSeqFile(&refFileST, refFILE))
+      {errC = 64; goto cleanUp;}
+   if(openSeqFile(&qryFileST, qryFILE))
+      {errC = 64; goto cleanUp;}
+
+   /*readSeqFile returns 0 (EOF) when no record was read.
+   ` Sequences are converted to lookup indexes as they are
+   ` read in.
+   */
+   for(ulPair = 0; ulPair < 2; ++ulPair)
+   { /*Loop: read the first two references*/
+      refST = &refAryST[ulPair];
+      refErrUC = readSeqFile(&refFileST, refST, 1);
+
+      if(refErrUC == 0 && ulPair > 0) break;
+      if(refErrUC & 64) {errC = 64; goto cleanUp;}
+
+      if(refErrUC != 1 || refST->lenSeqUL == 0)
+         {errC = 2; goto cleanUp;}
+
+      refST->offsetUL = 0;
+      refST->endAlnUL = refST->lenSeqUL - 1;
+      ++numRefUL;
+
+      /*Score profile rows are for the old reference*/
+      freeScoreProfStack(&settings->profST);
+      batchThreadNewRef(&threadST);
+   } /*Loop: read the first two references*/
+
+   /*One reference record means use it for every query*/
+   pairBl = (numRefUL > 1);
+
+   if(outFileStr == 0 || strcmp(outFileStr, "-") == 0)
+   { /*If: printing to stdout*/
+      outFILE = stdout;
+      outFileStr = "out";
+   } /*If: printing to stdout*/
+
+   else outFILE = fopen(outFileStr, "w");
+
+   if(outFILE == 0) {errC = 8; goto cleanUp;}
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-04 Sec-04:
+   ^  - Read in a batch of pairs and align them
+   ^  o fun-04 sec-04 sub-01:
+   ^    - Read in a batch of pairs
+   ^  o fun-04 sec-04 sub-02:
+   ^    - Align the pairs
+   ^  o fun-04 sec-04 sub-03:
+   ^    - Print out the alignments
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   while(qryErrUC == 1)
+   { /*Loop: align all query records*/
+
+      /**************************************************\
+      * Fun-04 Sec-04 Sub-01:
+      *  - Read in a batch of pairs
+      \**************************************************/
+
+      numPairsUL = 0;
+
+      while(numPairsUL < defBatchPairs)
+      { /*Loop: read in a batch of pairs*/
+         qryST = &qryAryST[numPairsUL];
+         qryErrUC = readSeqFile(&qryFileST, qryST, 1);
+
+         if(qryErrUC == 0) break; /*No more queries*/
+         if(qryErrUC & 64) {errC = 64; goto cleanUp;}
+
+         if(qryErrUC != 1 || qryST->lenSeqUL == 0)
+            {errC = 4; goto cleanUp;}
+
+         qryST->offsetUL = 0;
+         qryST->endAlnUL = qryST->lenSeqUL - 1;
+
+         refST = &refAryST[0];
+
+         if(pairBl)
+         { /*If: the nth query goes to the nth reference*/
+            refST = &refAryST[numPairsUL];
+
+            if(numPairsUL >= numRefUL)
+            { /*If: I need to read in the reference*/
+               refErrUC =
+                  readSeqFile(&refFileST, refST, 1);
+
+               if(refErrUC == 0)
+               { /*If: I am out of references*/
+                  mismatchBl = 1;
+                  qryErrUC = 0;
+                  break;
+               } /*If: I am out of references*/
+
+               if(refErrUC & 64) {errC = 64; goto cleanUp;}
+
+               if(refErrUC != 1 || refST->lenSeqUL == 0)
+                  {errC = 2; goto cleanUp;}
+
+               refST->offsetUL = 0;
+               refST->endAlnUL = refST->lenSeqUL - 1;
+
+               /*Rows are for the old reference*/
+               freeScoreProfStack(&settings->profST);
+               batchThreadNewRef(&threadST);
+            } /*If: I need to read in the reference*/
+         } /*If: the nth query goes to the nth reference*/
+
+         qryPtrAryST[numPairsUL] = qryST;
+         refPtrAryST[numPairsUL] = refST;
+         ++numPairsUL;
+      } /*Loop: read in a batch of pairs*/
+
+      /*Check if the query ran out before the references
+      ` I read in at the start
+      */
+      if(pairBl && numPairsUL < numRefUL) mismatchBl = 1;
+      numRefUL = 0;
+
+      if(numPairsUL == 0) break; /*Out of queries*/
+
+      /**************************************************\
+      * Fun-04 Sec-04 Sub-02:
+      *  - Align the pairs
+      \**************************************************/
+
+      if(poolBl)
+      { /*If: each pair is a thread pool task*/
+         for(ulPair = 0; ulPair < numPairsUL; ++ulPair)
+         { /*Loop: set up the pairs*/
+            pairAryST[ulPair].qryST = qryPtrAryST[ulPair];
+            pairAryST[ulPair].refST = refPtrAryST[ulPair];
+         } /*Loop: set up the pairs*/
+
+         if(batchThreadAln(pairAryST,numPairsUL,orderAryUL))
+            {errC = 64; goto cleanUp;}
+      } /*If: each pair is a thread pool task*/
+
+      else
+      { /*Else: align the pairs in vectors*/
+         matrixAryST =
+            batchAlnDispatch(
+               qryPtrAryST,
+               refPtrAryST,
+               numPairsUL,
+               settings->useNeedleBl,
+               ! settings->justScoresBl,
+               settings
+            );
+
+         if(matrixAryST == 0) {errC = 64; goto cleanUp;}
+      } /*Else: align the pairs in vectors*/
+
+      /**************************************************\
+      * Fun-04 Sec-04 Sub-03:
+      *  - Print out the alignments
+      \**************************************************/
+
+      for(ulPair = 0; ulPair < numPairsUL; ++ulPair)
+      { /*Loop: print out each alignment*/
+         qryST = qryPtrAryST[ulPair];
+         refST = refPtrAryST[ulPair];
+
+         if(poolBl) mtrxST = &pairAryST[ulPair].matrixST;
+         else mtrxST = &matrixAryST[ulPair];
+
+         bitsC = mtrxST->scoreBitsC;
+         ++numBitsAryUL[bitsC >> 3];
+
+         if(
+               settings->justScoresBl
+            && ! settings->useHirschBl /*Has no scores*/
+         ){ /*If: only printing the scores*/
+            refStartUL = 0;
+            qryStartUL = 0;
+
+            if(! settings->useNeedleBl)
+               indexToCoord(
+                  mtrxST->lenRefUL,
+                  mtrxST->bestStartIndexUL,
+                  refStartUL,
+                  qryStartUL
+               );
+
+            indexToCoord(
+               mtrxST->lenRefUL,
+               mtrxST->bestEndIndexUL,
+               refEndUL,
+               qryEndUL
+            );
+
+            idEndStr =
+               capIdLen(qryST, qryST->lenIdUL + 1, &oldIdC);
+
+            fprintf(
+               outFILE,
+               "%s\t",
+               qryST->idCStr + (*qryST->idCStr == '>')
+            );
+
+            *idEndStr = oldIdC;
+
+            idEndStr =
+               capIdLen(refST, refST->lenIdUL + 1, &oldIdC);
+
+            fprintf(
+               outFILE,
+               "%s\t%li\t%lu\t%lu\t%lu\t%lu\n",
+               refST->idCStr + (*refST->idCStr == '>'),
+               mtrxST->bestScoreL,
+               refStartUL,
+               refEndUL,
+               qryStartUL,
+               qryEndUL
+            );
+
+            *idEndStr = oldIdC;
+            continue;
+         } /*If: only printing the scores*/
+
+         if(poolBl)
+         { /*If: the task found the alignment*/
+            alnST = pairAryST[ulPair].alnST;
+            pairAryST[ulPair].alnST = 0;
+         } /*If: the task found the alignment*/
+
+         else
+            alnST =
+               dirMatrixToAln(
+                  refST,
+                  qryST,
+                  mtrxST->bestEndIndexUL,
+                  settings,
+                  mtrxST
+               );
+
+         if(alnST == 0) {errC = 64; goto cleanUp;}
+
+         lookupIndexToSeqVect(
+            refST->seqCStr,
+            refST->lenSeqUL
+         );
+
+         lookupIndexToSeqVect(
+            qryST->seqCStr,
+            qryST->lenSeqUL
+         );
+
+         errC =
+            printAln(
+               outFILE,
+               outFileStr,
+               refST,
+               qryST,
+               alnST,
+               mtrxST->bestScoreL,
+               settings,
+               scoreMtrxFileStr
+            );
+
+         /*The reference may be used by later pairs*/
+         seqToLookupIndexVect(
+            refST->seqCStr,
+            refST->lenSeqUL
+         );
+         freeAlnST(alnST);
+         alnST = 0;
+
+         if(errC) {errC = 8; goto cleanUp;}
+      } /*Loop: print out each alignment*/
+
+      freeBatchAln(matrixAryST, numPairsUL);
+      matrixAryST = 0;
+
+      for(
+         ulPair = 0;
+         poolBl && ulPair < numPairsUL;
+         ++ulPair
+      ) freeBatchPair(&pairAryST[ulPair]);
+   } /*Loop: align all query records*/
+
+   if(pairBl && ! mismatchBl)
+      mismatchBl =
+         (readSeqFile(&refFileST, &refAryST[0], 1) == 1);
+
+   if(mismatchBl)
+      fprintf(
+         stderr,
+         "-ref and -query have a different number of"
+         " records; extra records were not aligned\n"
+      );
+
+   if(settings->pStatsBl && poolBl)
+      pPoolStats(&threadST.poolST, stderr);
+
+   else if(settings->pStatsBl)
+      fprintf(
+         stderr,
+         "vector set: %s\n8 bit pairs: %lu\n"
+         "16 bit pairs: %lu\n32 bit pairs: %lu\n"
+         "scalar pairs: %lu\n",
+         vectDispatchSetToStr(settings->vectSetC),
+         numBitsAryUL[1],
+         numBitsAryUL[2],
+         numBitsAryUL[4],
+         numBitsAryUL[0]
+      );
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-04 Sec-05:
+   ^  - Clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   cleanUp:
+
+   freeBatchAln(matrixAryST, numPairsUL);
+
+   /*Stops the threads before the pairs are freed*/
+   freeBatchThread(&threadST);
+
+   for(ulPair = 0; ulPair < defBatchPairs; ++ulPair)
+   { /*Loop: free the sequences*/
+      freeSeqSTStack(&qryAryST[ulPair]);
+      freeSeqSTStack(&refAryST[ulPair]);
+
+      if(poolBl) freeBatchPair(&pairAryST[ulPair]);
+   } /*Loop: free the sequences*/
+
+   free(qryAryST);
+   free(refAryST);
+   free(qryPtrAryST);
+   free(refPtrAryST);
+   if(pairAryST != 0) free(pairAryST);
+   if(orderAryUL != 0) free(orderAryUL);
+
+   freeSeqFileStack(&refFileST);
+   freeSeqFileStack(&qryFileST);
+
+   if(refFILE != 0) fclose(refFILE);
+   if(qryFILE != 0) fclose(qryFILE);
+   if(outFILE != 0 && outFILE != stdout) fclose(outFILE);
+
+   return errC;
+} /*batchAlnFiles*/
+
+/*-------------------------------------------------------\
+| Fun-05: indexRefFile
+|   - Builds a reference cache (.alnref) from the fasta
+|     or fastq file in -ref (alnSeq index). Every entry is
+|     converted to lookup indexes and packed, so -ref can
+|     load the cache without reading the fasta file.
+| Input:
+|   - lenArgsInt:
+|     o Number of arguments the user input
+|   - argsCStr:
+|     o Array of c-strings with the users input arguments
+|       (argsCStr[1] is "index")
+| Output:
+|   - Prints:
+|     o The cache to -out (-ref.alnref by default)
+|     o Errors to stderr
+|   - Returns:
+|     o 0 for no errors
+|     o -1 for errors
+\-------------------------------------------------------*/
+int indexRefFile(
+   int lenArgsInt,   /*Number of arguments*/
+   char *argsCStr[]  /*Arguments (argsCStr[1]: index)*/
+){
+   char *refFileStr = 0;
+   char *outFileStr = 0;
+   char *tmpStr = 0;
+   int iArg = 0;
+   unsigned char errUC = 0;
+
+   FILE *faFILE = 0;
+   FILE *outFILE = 0;
+
+   for(iArg = 2; iArg < lenArgsInt; ++iArg)
+   { /*Loop: get the user input*/
+      if(
+            strcmp(argsCStr[iArg], "-h") == 0
+         || strcmp(argsCStr[iArg], "-help") == 0
+         || strcmp(argsCStr[iArg], "--help") == 0
+      ){ /*If: the user wanted the help message*/
+         fprintf(
+            stdout,
+            "alnSeq index -ref ref.fasta"
+            " [-out ref.fasta.alnref]\n"
+         );
+         fprintf(
+            stdout,
+            "  - Builds a cache of the reference for -ref."
+            " Every entry\n    is converted and packed,"
+            " so alnSeq -ref ref.fasta.alnref\n    does not"
+            " read the fasta file.\n"
+         );
+         fprintf(
+            stdout,
+            "  - Rebuild the cache when the reference (or"
+            " alnSeq build)\n    changes.\n"
+         );
+         return 0;
+      } /*If: the user wanted the help message*/
+
+      if(iArg + 1 >= lenArgsInt) break; /*No value*/
+
+      if(strcmp(argsCStr[iArg], "-ref") == 0)
+         refFileStr = argsCStr[++iArg];
+
+      else if(strcmp(argsCStr[iArg], "-out") == 0)
+         outFileStr = argsCStr[++iArg];
+
+      else break;
+   } /*Loop: get the user input*/
+
+   if(iArg < lenArgsInt || refFileStr == 0)
+   { /*If: the user had invalid input*/
+      fprintf(
+         stderr,
+         "alnSeq index -ref ref.fasta"
+         " [-out ref.fasta.alnref]\n"
+      );
+
+      if(iArg < lenArgsInt)
+         fprintf(stderr, "%s is invalid\n", argsCStr[iArg]);
+
+      return -1;
+   } /*If: the user had invalid input*/
+
+   if(outFileStr == 0)
+   { /*If: the cache is named after the reference*/
+      tmpStr = malloc(strlen(refFileStr) + 8);
+
+      if(tmpStr == 0)
+      { /*If: I had a memory error*/
+         fprintf(stderr, "Memory allocation error\n");
+         return -1;
+      } /*If: I had a memory error*/
+
+      sprintf(tmpStr, "%s.alnref", refFileStr);
+      outFileStr = tmpStr;
+   } /*If: the cache is named after the reference*/
+
+   faFILE = fopen(refFileStr, "r");
+
+   if(faFILE == 0)
+   { /*If: reference file could not be opened*/
+      fprintf(
+        stderr,
+        "Reference (-ref %s) could not be opend\n",
+        refFileStr
+      );
+
+      if(tmpStr != 0) free(tmpStr);
+      return -1;
+   } /*If: reference file could not be opened*/
+
+   outFILE = fopen(outFileStr, "wb");
+
+   if(outFILE == 0)
+   { /*If: the cache file could not be opened*/
+      fprintf(
+        stderr,
+        "Output (-out %s) file is invalid.\n",
+        outFileStr
+      );
+
+      fclose(faFILE);
+      if(tmpStr != 0) free(tmpStr);
+      return -1;
+   } /*If: the cache file could not be opened*/
+
+   errUC = mkAlnRef(faFILE, outFILE);
+
+   fclose(faFILE);
+   if(fclose(outFILE) && ! errUC) errUC = 8;
+
+   if(errUC)
+   { /*If: the cache could not be built*/
+      remove(outFileStr); /*Do not leave part of a cache*/
+
+      if(errUC == 2)
+         fprintf(
+           stderr,
+           "Reference (-ref %s) is not valid\n",
+           refFileStr
+         );
+
+      else if(errUC == 8)
+         fprintf(
+           stderr,
+           "Could not print the cache to %s\n",
+           outFileStr
+         );
+
+      else fprintf(stderr, "Memory allocation error\n");
+   } /*If: the cache could not be built*/
+
+   if(tmpStr != 0) free(tmpStr);
+
+   if(errUC) return -1;
+   return 0;
+} /*indexRefFile*/
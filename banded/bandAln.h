@@ -0,0 +1,648 @@
+/*########################################################
+# Name: bandAln
+# Use:
+#  - Does a Needleman or Waterman alignment that only
+#    scores and stores the cells in a diagonal band
+#    (-band). This uses (query length + 1) * band width
+#    cells instead of (reference length + 1) *
+#    (query length + 1) cells.
+#  - The band covers every diagonal between the start
+#    (0, 0) and end (query length, reference length) of
+#    the matrix, plus the band width on each side.
+#  - Each row of the banded matrix keeps one diagonal in
+#    each column, so the cell above is one column right
+#    and the diagonal cell is in the same column. The
+#    matrix is converted to an alignment with
+#    dirMatrixToAln (lenBandUL is set).
+#  - -band auto (bandAutoBl) doubles the band and redoes
+#    the alignment when the best path touches a band edge
+#  - -no-gap-extend is done by setting the gap extension
+#    penalty to the gap opening penalty
+# Libraries:
+#  - "../needleman/needleman.h"       (No .c File)
+#  - "../needleman/needleNoGap.h"     (No .c File)
+#  - "../waterman/waterman.h"         (No .c File)
+#  - "../waterman/watermanNoGap.h"    (No .c File)
+#  o "../general/genAln.h"            (No .c File)
+#  o "../general/alnMatrixStruct.h"   (No .c File)
+#  o "../general/twoBitArrays.h"      (No .c File)
+#  o "../general/seqStruct.h"         (No .c File)
+#  o "../general/alnSetStruct.h"      (No .c File)
+#  o "../general/alnSeqDefaults.h"    (No .c File)
+#  o "../general/dataTypeShortHand.h" (No .c File)
+# C Standard Libraries:
+#  o <stdlib.h>
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Includes and definitions
+'  o macro-01 bandFullAln:
+'    - Runs the full matrix Needleman or Waterman
+'  o macro-02 bandLimits:
+'    - Finds the first and last diagonal in a band
+'  o fun-03 bandAlnFill:
+'    - Fills in a banded direction matrix for a Needleman
+'      or Waterman alignment
+'  o fun-04 bandEdgeHit:
+'    - Checks if the best path in a banded matrix touches
+'      an edge of the band
+'  o fun-05 bandAln:
+'    - Does a banded Needleman or Waterman alignment
+'      (-band)
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes and definitions
+\-------------------------------------------------------*/
+
+#ifndef BAND_ALN_H
+#define BAND_ALN_H
+
+#include <stdlib.h>
+
+#include "../needleman/needleman.h"
+#include "../needleman/needleNoGap.h"
+#include "../waterman/waterman.h"
+#include "../waterman/watermanNoGap.h"
+
+/*Score for cells outside of the matrix. This is far
+` enough from the min long that adding a penalty can not
+` overflow it
+*/
+#define defBandOutScoreL (-(long) (((ulong) -1) >> 2))
+
+/*-------------------------------------------------------\
+| Macro-01: bandFullAln
+|   - Runs the full matrix Needleman or Waterman
+| Input:
+|   - qryST:
+|     o seqStruct with the query sequence
+|   - refST:
+|     o seqStruct with the reference sequence
+|   - needleBl:
+|     o 1: Needleman alignment
+|     o 0: Waterman alignment
+|   - settings:
+|     o alnSet structure with the alignment settings
+| Output:
+|   - Returns:
+|     o alnMatrix structure with the direction matrix
+|     o 0 for memory errors
+\-------------------------------------------------------*/
+#define bandFullAln(qryST, refST, needleBl, settings)(\
+   (needleBl) ?\
+        (\
+           (settings)->noGapBl ?\
+                NeedleAlnNoGap((qryST),(refST),(settings))\
+              : NeedlemanAln((qryST), (refST), (settings))\
+        )\
+      : (\
+           (settings)->noGapBl ?\
+                WatermanAlnNoGap((qryST),(refST),(settings))\
+              : WatermanAln((qryST), (refST), (settings))\
+        )\
+) /*bandFullAln*/
+
+/*-------------------------------------------------------\
+| Macro-02: bandLimits
+|   - Finds the first and last diagonal (ref - query) in
+|     a band. Diagonals past the ends of the matrix are
+|     removed.
+| Input:
+|   - lenRefUL:
+|     o Number of reference bases being aligned
+|   - lenQryUL:
+|     o Number of query bases being aligned
+|   - bandUL:
+|     o Number of diagonals to add on each side of the
+|       diagonals between the matrix start and end
+|   - startL:
+|     o Will hold the first diagonal in the band
+|   - endL:
+|     o Will hold the last diagonal in the band
+| Output:
+|   - Modifies:
+|     o startL and endL
+\-------------------------------------------------------*/
+#define bandLimits(lenRefUL,lenQryUL,bandUL,startL,endL){\
+   (startL) = -(long) (bandUL);\
+   (endL) = (long) (bandUL);\
+   \
+   if((lenRefUL) < (lenQryUL))\
+      (startL) -= (long) ((lenQryUL) - (lenRefUL));\
+   else\
+      (endL) += (long) ((lenRefUL) - (lenQryUL));\
+   \
+   if((startL) < -(long) (lenQryUL))\
+      (startL) = -(long) (lenQryUL);\
+   \
+   if((endL) > (long) (lenRefUL))\
+      (endL) = (long) (lenRefUL);\
+} /*bandLimits*/
+
+/*-------------------------------------------------------\
+| Fun-03: bandAlnFill
+|   - Fills in a banded direction matrix for a Needleman
+|     or Waterman alignment. The scores and directions are
+|     the same as NeedlemanAln and WatermanAln for every
+|     cell in the band.
+| Input:
+|   - qryST:
+|     o seqStruct with the query sequence and the region
+|       to align (offsetUL and endAlnUL)
+|   - refST:
+|     o seqStruct with the reference sequence and the
+|       region to align (offsetUL and endAlnUL)
+|   - bandUL:
+|     o Number of diagonals to add on each side of the
+|       diagonals between the matrix start and end
+|   - needleBl:
+|     o 1: Needleman alignment
+|     o 0: Waterman alignment
+|   - settings:
+|     o alnSet structure with the alignment settings
+| Output:
+|   - Returns:
+|     o alnMatrix structure with the banded direction
+|       matrix (lenBandUL and bandStartL are set), best
+|       score, and the full matrix index of the best cell
+|     o 0 for memory errors
+\-------------------------------------------------------*/
+static struct alnMatrix * bandAlnFill(
+   struct seqStruct *qryST, /*query sequence and data*/
+   struct seqStruct *refST, /*ref sequence and data*/
+   ulong bandUL,            /*Diagonals on each side*/
+   char needleBl,           /*1: Needleman; 0: Waterman*/
+   struct alnSet *settings  /*Settings for alignment*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-03 TOC: bandAlnFill
+   '  - Fills in a banded direction matrix
+   '  o fun-03 sec-01:
+   '    - Variable declerations
+   '  o fun-03 sec-02:
+   '    - Allocate memory for alignment
+   '  o fun-03 sec-03:
+   '    - Fill in the gap row
+   '  o fun-03 sec-04:
+   '    - Fill the band with scores
+   '  o fun-03 sec-05:
+   '    - Set up for returning the matrix
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-03 Sec-01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*Start of the reference (index 1) & query*/
+   char *refSeqStr = refST->seqCStr + refST->offsetUL - 1;
+   char *qrySeqStr = qryST->seqCStr + qryST->offsetUL;
+   char *profRowC = 0; /*Scores for a query base*/
+
+   ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
+   ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
+
+   /*Band variables*/
+   long bandStartL = 0; /*First diagonal (ref - query)*/
+   long bandEndL = 0;   /*Last diagonal (ref - query)*/
+   ulong lenBandUL = 0; /*Cells per banded row*/
+   long rowStartL = 0;  /*Reference base of 1st row cell*/
+   ulong firstUL = 0;   /*First cell in the matrix*/
+   ulong lastUL = 0;    /*Last cell in the matrix*/
+
+   /*Variables for loops*/
+   ulong ulQry = 0;
+   ulong ulCell = 0;
+
+   /*Scoring variables*/
+   long snpScoreL = 0;
+   long insScoreL = 0;
+   long delScoreL = 0;
+   long *scoreAryL = 0; /*Has a cell before & after band*/
+   long *scoreL = 0;    /*Scores for the band (in place)*/
+   ulong keepDirUL = 0; /*Waterman: keep score?*/
+
+   /*Gap penalities (gap extension is gap open for
+   ` -no-gap-extend)
+   */
+   long gapExtendL =
+      settings->noGapBl ?
+           settings->gapOpenC
+         : settings->gapExtendC;
+
+   short gapDiffS = gapExtendL - settings->gapOpenC;
+
+   /*Direction matrix (1 cell holds a single direction)*/
+   struct alnMatrix *retMatrixST = 0;
+   char *dirRow = 0;   /*Row being filled in*/
+   char *insDir = 0;   /*Direction above a cell*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-03 Sec-02:
+   ^  - Allocate memory for alignment
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   bandLimits(lenRefUL,lenQryUL,bandUL,bandStartL,bandEndL);
+   lenBandUL = (ulong) (bandEndL - bandStartL + 1);
+
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         lenQryUL,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
+   retMatrixST = malloc(sizeof(struct alnMatrix));
+   if(retMatrixST == 0) return 0;
+   initAlnMatrix(retMatrixST);
+
+   retMatrixST->dirMatrix =
+      malloc(
+         ((lenQryUL + 1) * lenBandUL + 1) * sizeof(char)
+      );
+
+   if(retMatrixST->dirMatrix == 0)
+   { /*If: Memory error*/
+      freeAlnMatrix(retMatrixST);
+      return 0;
+   } /*If: Memory error*/
+
+   scoreAryL = malloc((lenBandUL + 2) * sizeof(long));
+      /*+ 2 is for the cells before and after the band*/
+
+   if(scoreAryL == 0)
+   { /*If: I had a memory error*/
+     freeAlnMatrix(retMatrixST);
+     return 0;
+   } /*If: I had a memory error*/
+
+   retMatrixST->lenRefUL = lenRefUL;
+   retMatrixST->refOffsetUL = refST->offsetUL;
+
+   retMatrixST->lenQryUL = lenQryUL;
+   retMatrixST->qryOffsetUL = qryST->offsetUL;
+
+   retMatrixST->lenBandUL = lenBandUL;
+   retMatrixST->bandStartL = bandStartL;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-03 Sec-03:
+   ^  - Fill in the gap row
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*The cells before and after the band are never in the
+   ` alignment
+   */
+   scoreL = scoreAryL + 1;
+   scoreL[-1] = defBandOutScoreL;
+   scoreL[lenBandUL] = defBandOutScoreL;
+
+   dirRow = retMatrixST->dirMatrix;
+
+   for(ulCell = 0; ulCell < lenBandUL; ++ulCell)
+   { /*Loop: fill in the gap row*/
+      rowStartL = bandStartL + (long) ulCell;
+      dirRow[ulCell] = defMvStop;
+
+      if(rowStartL < 0)
+         scoreL[ulCell] = defBandOutScoreL;
+
+      else if(rowStartL == 0 || ! needleBl)
+         scoreL[ulCell] = 0;
+
+      else
+      { /*Else: Needleman deletions*/
+         dirRow[ulCell] = defMvDel;
+
+         scoreL[ulCell] =
+              settings->gapOpenC
+            + (rowStartL - 1) * gapExtendL;
+      } /*Else: Needleman deletions*/
+   } /*Loop: fill in the gap row*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-03 Sec-04:
+   ^  - Fill the band with scores
+   ^  o fun-03 sec-04 sub-01:
+   ^    - Find the cells in this row that are in the matrix
+   ^  o fun-03 sec-04 sub-02:
+   ^    - Fill in the gap column
+   ^  o fun-03 sec-04 sub-03:
+   ^    - Score the cells in the matrix
+   ^  o fun-03 sec-04 sub-04:
+   ^    - Blank the cells past the end of the reference
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(ulQry = 1; ulQry <= lenQryUL; ++ulQry)
+   { /*Loop: fill in each query row*/
+
+      /**************************************************\
+      * Fun-03 Sec-04 Sub-01:
+      *  - Find the cells in this row that are in the
+      *    matrix
+      \**************************************************/
+
+      /*The cell above is one column right and the snp
+      ` (diagonal) cell is in the same column. So, scoreL
+      ` is updated in place from left to right.
+      */
+      dirRow += lenBandUL;
+      insDir = dirRow - lenBandUL + 1;
+
+      rowStartL = (long) ulQry + bandStartL;
+      firstUL = 0;
+
+      if(rowStartL < 0)
+         firstUL = (ulong) -rowStartL;
+
+      lastUL = lenBandUL - 1;
+
+      if((long) lastUL > (long) lenRefUL - rowStartL)
+         lastUL = (ulong) ((long) lenRefUL - rowStartL);
+
+      for(ulCell = 0; ulCell < firstUL; ++ulCell)
+      { /*Loop: blank cells before the reference*/
+         dirRow[ulCell] = defMvStop;
+         scoreL[ulCell] = defBandOutScoreL;
+      } /*Loop: blank cells before the reference*/
+
+      /**************************************************\
+      * Fun-03 Sec-04 Sub-02:
+      *  - Fill in the gap column
+      \**************************************************/
+
+      if(rowStartL + (long) ulCell == 0)
+      { /*If: the gap column is in the band*/
+         if(needleBl)
+         { /*If: Needleman insertions*/
+            dirRow[ulCell] = defMvIns;
+
+            scoreL[ulCell] =
+                 settings->gapOpenC
+               + (long) (ulQry - 1) * gapExtendL;
+         } /*If: Needleman insertions*/
+
+         else
+         { /*Else: Waterman*/
+            dirRow[ulCell] = defMvStop;
+            scoreL[ulCell] = 0;
+         } /*Else: Waterman*/
+
+         ++ulCell;
+      } /*If: the gap column is in the band*/
+
+      /**************************************************\
+      * Fun-03 Sec-04 Sub-03:
+      *  - Score the cells in the matrix
+      \**************************************************/
+
+      profRowC =
+         getScoreProfRow(
+            qrySeqStr[ulQry - 1],
+            refSeqStr,
+            settings
+         ); /*Scores for this query base*/
+
+      for(; ulCell <= lastUL; ++ulCell)
+      { /*Loop: score the cells in this row*/
+         snpScoreL =
+              scoreL[ulCell]
+            + profRowC[rowStartL + (long) ulCell];
+
+         insScoreL =
+              scoreL[ulCell + 1]
+            + (gapDiffS & (-(insDir[ulCell] != defMvSnp)))
+            + settings->gapOpenC;
+
+         /*The first cell uses the cell before the band*/
+         delScoreL =
+              scoreL[(long) ulCell - 1]
+            + (
+                  gapDiffS
+                & (-(dirRow[(long) ulCell - 1] != defMvSnp))
+              )
+            + settings->gapOpenC;
+
+         charMaxScore(
+            scoreL[ulCell],
+            dirRow[ulCell],
+            snpScoreL,
+            insScoreL,
+            delScoreL,
+            settings->bestDirC
+         ); /*Find the best direction*/
+
+         if(! needleBl)
+         { /*If: this is a Waterman*/
+            keepDirUL = -(scoreL[ulCell] > 0);
+            dirRow[ulCell] &= keepDirUL;
+            scoreL[ulCell] &= keepDirUL;
+
+            if(retMatrixST->bestScoreL < scoreL[ulCell])
+            { /*If: have a new best score*/
+               retMatrixST->bestScoreL = scoreL[ulCell];
+
+               retMatrixST->bestEndIndexUL =
+                    ulQry * (lenRefUL + 1)
+                  + (ulong) (rowStartL + (long) ulCell);
+            } /*If: have a new best score*/
+         } /*If: this is a Waterman*/
+      } /*Loop: score the cells in this row*/
+
+      /**************************************************\
+      * Fun-03 Sec-04 Sub-04:
+      *  - Blank the cells past the end of the reference
+      \**************************************************/
+
+      /*This is done after scoring, because the last cell
+      ` uses the score above it
+      */
+      for(; ulCell < lenBandUL; ++ulCell)
+      { /*Loop: blank cells after the reference*/
+         dirRow[ulCell] = defMvStop;
+         scoreL[ulCell] = defBandOutScoreL;
+      } /*Loop: blank cells after the reference*/
+   } /*Loop: fill in each query row*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-03 Sec-05:
+   ^  - Set up for returning the matrix
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*Extra direction after the last row (NeedlemanAln)*/
+   retMatrixST->dirMatrix[(lenQryUL + 1) * lenBandUL] =
+      defMvStop;
+
+   if(needleBl)
+   { /*If: Needleman, the best score is the last cell*/
+      retMatrixST->bestScoreL =
+         scoreL[
+              (long) lenRefUL
+            - (long) lenQryUL
+            - bandStartL
+         ];
+
+      retMatrixST->bestEndIndexUL =
+         lenQryUL * (lenRefUL + 1) + lenRefUL;
+   } /*If: Needleman, the best score is the last cell*/
+
+   free(scoreAryL);
+   scoreAryL = 0;
+
+   return retMatrixST;
+} /*bandAlnFill*/
+
+/*-------------------------------------------------------\
+| Fun-04: bandEdgeHit
+|   - Checks if the best path in a banded matrix touches
+|     an edge of the band. Band edges that are also ends
+|     of the matrix are not counted.
+| Input:
+|   - matrixST:
+|     o alnMatrix with the banded matrix from bandAlnFill
+| Output:
+|   - Returns:
+|     o 1 if the path touches a band edge (the path may
+|       not be the best path)
+|     o 0 if the path stays in the band
+\-------------------------------------------------------*/
+static char bandEdgeHit(
+   struct alnMatrix *matrixST
+){
+   ulong refPosUL = 0;
+   ulong qryPosUL = 0;
+   long diagL = 0; /*Diagonal (ref - query) on*/
+
+   /*Edges of the band*/
+   long lowEdgeL = matrixST->bandStartL;
+   long highEdgeL =
+      matrixST->bandStartL + (long) matrixST->lenBandUL -1;
+
+   char *dirC = matrixST->dirMatrix;
+
+   /*Edges at the ends of the matrix can never be hit*/
+   if(lowEdgeL <= -(long) matrixST->lenQryUL)
+      lowEdgeL = -(long) matrixST->lenQryUL - 1;
+
+   if(highEdgeL >= (long) matrixST->lenRefUL)
+      highEdgeL = (long) matrixST->lenRefUL + 1;
+
+   indexToCoord(
+      matrixST->lenRefUL,
+      matrixST->bestEndIndexUL,
+      refPosUL,
+      qryPosUL
+   ); /*Find the last query/reference base*/
+
+   dirC +=
+      coordToBandIndex(
+         refPosUL,
+         qryPosUL,
+         matrixST->lenBandUL,
+         matrixST->bandStartL
+      );
+
+   diagL = (long) refPosUL - (long) qryPosUL;
+
+   while(*dirC != defMvStop)
+   { /*Loop: follow the path back to its start*/
+      if(diagL == lowEdgeL || diagL == highEdgeL)
+         return 1;
+
+      switch(*dirC)
+      { /*Switch: move to the next cell*/
+         case defMvSnp:
+            dirC -= matrixST->lenBandUL;
+            break;
+
+         case defMvIns:
+            dirC -= matrixST->lenBandUL - 1;
+            ++diagL;
+            break;
+
+         case defMvDel:
+            --dirC;
+            --diagL;
+            break;
+      } /*Switch: move to the next cell*/
+   } /*Loop: follow the path back to its start*/
+
+   return 0;
+} /*bandEdgeHit*/
+
+/*-------------------------------------------------------\
+| Fun-05: bandAln
+|   - Does a banded Needleman or Waterman alignment
+|     (-band). The full matrix aligners are used when the
+|     band would be as large as the full matrix.
+| Input:
+|   - qryST:
+|     o seqStruct with the query sequence and the region
+|       to align (offsetUL and endAlnUL)
+|   - refST:
+|     o seqStruct with the reference sequence and the
+|       region to align (offsetUL and endAlnUL)
+|   - needleBl:
+|     o 1: Needleman alignment (NeedlemanAln)
+|     o 0: Waterman alignment (WatermanAln)
+|   - settings:
+|     o alnSet structure with the alignment settings
+|       (bandUL is the band; bandAutoBl doubles the band
+|       till the path does not touch a band edge)
+| Output:
+|   - Returns:
+|     o alnMatrix structure with the direction matrix
+|       (banded if lenBandUL != 0), the best score, and
+|       the full matrix index of the best score
+|     o 0 for memory errors
+\-------------------------------------------------------*/
+static struct alnMatrix * bandAln(
+   struct seqStruct *qryST, /*query sequence and data*/
+   struct seqStruct *refST, /*ref sequence and data*/
+   char needleBl,           /*1: Needleman; 0: Waterman*/
+   struct alnSet *settings  /*Settings for alignment*/
+){
+   ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
+   ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
+   ulong bandUL = settings->bandUL;
+   long bandStartL = 0;
+   long bandEndL = 0;
+
+   struct alnMatrix *retMatrixST = 0;
+
+   while(1)
+   { /*Loop: till have a band that holds the path*/
+      bandLimits(
+         lenRefUL,
+         lenQryUL,
+         bandUL,
+         bandStartL,
+         bandEndL
+      );
+
+      /*A band with a cell for every reference base takes
+      ` as much memory as the full matrix
+      */
+      if(bandEndL - bandStartL >= (long) lenRefUL)
+         return bandFullAln(qryST,refST,needleBl,settings);
+
+      retMatrixST =
+         bandAlnFill(qryST,refST,bandUL,needleBl,settings);
+
+      if(retMatrixST == 0) return 0;
+      if(! settings->bandAutoBl) return retMatrixST;
+      if(! bandEdgeHit(retMatrixST)) return retMatrixST;
+
+      freeAlnMatrix(retMatrixST);
+      bandUL <<= 1;
+   } /*Loop: till have a band that holds the path*/
+} /*bandAln*/
+
+#endif
@@ -0,0 +1,763 @@
+/*########################################################
+# Name batchAln
+# Use:
+#  o Holds functions to align many query/reference pairs
+#    at once. Each pair gets its own element (lane) in a
+#    vector, so the pairs are scored together
+#    (inter-sequence vectorization).
+#  o Pairs are first scored with 8 bit vectors, then
+#    pairs that overflowed are redone with 16 bit and
+#    then 32 bit vectors (more bits means fewer pairs per
+#    vector).
+#  o This is for many short pairs (amplicons/reads), were
+#    there is not enough work in one pair to fill up a
+#    vector.
+#  o Each pair gets its own alnMatrix structure with the
+#    best score, starting index, and ending index. The
+#    direction matrix (for dirMatrixToAln) can also be
+#    filled in.
+#  o Pairs that the vectors can not do (to long for 32 bit
+#    scores/indexes or an unsupported direction
+#    preference) are
+#    aligned with the scalar aligners.
+# Libraries:
+#   - "batchAlnI8.h"                   (No .c file)
+#   - "batchAlnI16.h"                  (No .c file)
+#   - "batchAlnI32.h"                  (No .c file)
+#   - "../needleman/needleman.h"       (No .c file)
+#   - "../needleman/needleNoGap.h"     (No .c file)
+#   - "../waterman/waterman.h"         (No .c file)
+#   - "../waterman/watermanNoGap.h"    (No .c file)
+#   - "../memWater/memWater.h"         (No .c file)
+#   - "../memWater/memWaterNoGap.h"    (No .c file)
+#   - "../memWater/memWaterVect.h"     (No .c file)
+#   o "genBatchAln.h"                  (No .c file)
+#   o "../general/alnMatrixStruct.h"   (No .c file)
+#   o "../general/dataTypeShortHand.h" (No .c file)
+#   o "../general/alnSetStruct.h"      (No .c file)
+#   o "../general/alnSeqDefaults.h"    (No .c file)
+#   o "../general/seqStruct.h"         (No .c file)
+#   o "../vectWrap/vectWrap.h"         (No .c file)
+#   o "../general/alnScratch.h"        (No .c file)
+# C Standard libraries:
+#   o <stdint.h>
+#   o <stdlib.h>
+#   o <stdio.h>
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+' o fun-01 batchAlnScalar:
+'   - Aligns one pair with the scalar aligners and copies
+'     the result into an alnMatrix structure
+' o fun-02 batchAlnSetUp:
+'   - Sets up the alnMatrix structure for a vector pair
+' o fun-03 batchAlnTier:
+'   - Aligns a list of pairs with the 8, 16, or 32 bit
+'     kernel and keeps the pairs that overflowed
+' o fun-04 batchAln:
+'   - Aligns an array of query/reference pairs. This is
+'     the function to call.
+' o macro-05 freeBatchAln:
+'   - Frees the array of alnMatrix structures returned by
+'     batchAln
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#ifndef BATCH_ALN_H
+#define BATCH_ALN_H
+
+#include <stdint.h>
+
+#include "../needleman/needleman.h"
+#include "../needleman/needleNoGap.h"
+#include "../waterman/waterman.h"
+#include "../waterman/watermanNoGap.h"
+#include "../memWater/memWater.h"
+#include "../memWater/memWaterNoGap.h"
+#include "../memWater/memWaterVect.h"
+
+#include "batchAlnI8.h"
+#include "batchAlnI16.h"
+#include "batchAlnI32.h"
+
+/*Largest matrix (indexes) a pair can have in the vectors*/
+#define defBatchMaxMatrix 0x7fffffff
+
+/*Longest query + reference a pair can have and still
+` have 32 bit scores (no score or gap is over 255)
+*/
+#define defBatchMaxLenSum (0x7fffffff >> 8)
+
+/*-------------------------------------------------------\
+| Fun-01: batchAlnScalar
+|   - Aligns one pair with the scalar aligners and copies
+|     the result into an alnMatrix structure
+| Input:
+|   - qryST:
+|     o seqStruct with the query sequence
+|   - refST:
+|     o seqStruct with the reference sequence
+|   - needleBl:
+|     o 1: Do a Needleman alignment
+|     o 0: Do a Waterman alignment
+|   - dirBl:
+|     o 1: Keep the direction matrix (for dirMatrixToAln)
+|     o 0: Only find the score and start/end indexes
+|   - settings:
+|     o alnSet structure with the alignment settings
+|   - scratchST:
+|     o alnScratch structure (arena) for the score rows of
+|       the Needleman and Waterman aligners, so the rows
+|       are reused from pair to pair
+|   - retMatrixST:
+|     o alnMatrix structure to hold the result
+| Output:
+|   - Modifies:
+|     o retMatrixST to hold the result
+|     o scratchST to hold the score rows
+|   - Returns:
+|     o 0 for no errors
+|     o 64 for memory errors
+\-------------------------------------------------------*/
+static char batchAlnScalar(
+   struct seqStruct *qryST,
+   struct seqStruct *refST,
+   char needleBl,
+   char dirBl,
+   struct alnSet *settings,
+   struct alnScratch *scratchST,
+   struct alnMatrix *retMatrixST
+){
+   struct alnMatrix *tmpMatrixST = 0;
+
+   if(needleBl)
+   { /*If: doing a Needleman alignment*/
+      if(settings->noGapBl)
+         tmpMatrixST=NeedleAlnNoGap(qryST,refST,settings);
+      else
+         tmpMatrixST =
+            NeedlemanAlnScratch(
+               qryST,
+               refST,
+               settings,
+               scratchST
+            );
+   } /*If: doing a Needleman alignment*/
+
+   else if(dirBl)
+   { /*Else If: doing a Waterman with a direction matrix*/
+      if(settings->noGapBl)
+         tmpMatrixST=WatermanAlnNoGap(qryST,refST,settings);
+      else
+         tmpMatrixST =
+            WatermanAlnScratch(
+               qryST,
+               refST,
+               settings,
+               scratchST
+            );
+   } /*Else If: doing a Waterman with a direction matrix*/
+
+   else tmpMatrixST = memWaterVect(qryST, refST, settings);
+      /*memWaterVect is memWater when no vectors*/
+
+   if(tmpMatrixST == 0) return 64;
+
+   if(! dirBl && tmpMatrixST->dirMatrix != 0)
+   { /*If: the caller does not want the direction matrix*/
+      free(tmpMatrixST->dirMatrix);
+      tmpMatrixST->dirMatrix = 0;
+   } /*If: the caller does not want the direction matrix*/
+
+   *retMatrixST = *tmpMatrixST;
+   free(tmpMatrixST); /*Only free the structure*/
+   return 0;
+} /*batchAlnScalar*/
+
+/*-------------------------------------------------------\
+| Fun-02: batchAlnSetUp
+|   - Sets up the alnMatrix structure for a pair that is
+|     aligned in the vectors. This is done once per pair,
+|     so a pair that overflows can be redone with more
+|     bits without redoing this.
+| Input:
+|   - qryST:
+|     o seqStruct with the query sequence
+|   - refST:
+|     o seqStruct with the reference sequence
+|   - needleBl:
+|     o 1: Set up the direction matrix for a Needleman
+|     o 0: Set up the direction matrix for a Waterman
+|   - dirBl:
+|     o 1: Make a direction matrix
+|     o 0: Do not make a direction matrix
+|   - retMatrixST:
+|     o alnMatrix structure to set up
+| Output:
+|   - Modifies:
+|     o retMatrixST to have the lengths and offsets of the
+|       pair
+|     o retMatrixST->dirMatrix to have the gap row and gap
+|       column set up like the scalar aligners (dirBl = 1)
+|   - Returns:
+|     o 0 for no errors
+|     o 64 for memory errors
+\-------------------------------------------------------*/
+static char batchAlnSetUp(
+   struct seqStruct *qryST,
+   struct seqStruct *refST,
+   char needleBl,
+   char dirBl,
+   struct alnMatrix *retMatrixST
+){
+   ulong indexUL = 0;
+
+   initAlnMatrix(retMatrixST);
+
+   retMatrixST->lenQryUL =
+      qryST->endAlnUL - qryST->offsetUL + 1;
+   retMatrixST->qryOffsetUL = qryST->offsetUL;
+
+   retMatrixST->lenRefUL =
+      refST->endAlnUL - refST->offsetUL + 1;
+   retMatrixST->refOffsetUL = refST->offsetUL;
+
+   if(! dirBl) return 0;
+
+   /*Set up the direction matrix like the scalar
+   ` aligners (gap row, gap column, and an extra stop)
+   */
+   indexUL =
+        (retMatrixST->lenRefUL + 1)
+      * (retMatrixST->lenQryUL + 1);
+
+   retMatrixST->dirMatrix =
+      malloc((indexUL + 1) * sizeof(char));
+
+   if(retMatrixST->dirMatrix == 0) return 64;
+
+   retMatrixST->dirMatrix[indexUL] = defMvStop;
+
+   /*Needleman: deletions in the gap row and insertions
+   ` in the gap column. Waterman: all stops.
+   */
+   for(
+      indexUL = 0;
+      indexUL <= retMatrixST->lenRefUL;
+      ++indexUL
+   ) retMatrixST->dirMatrix[indexUL] = defMvDel & -needleBl;
+
+   for(
+      indexUL = 1;
+      indexUL <= retMatrixST->lenQryUL;
+      ++indexUL
+   ) retMatrixST->dirMatrix[
+        indexUL * (retMatrixST->lenRefUL + 1)
+     ] = defMvIns & -needleBl;
+
+   retMatrixST->dirMatrix[0] = defMvStop;
+   return 0;
+} /*batchAlnSetUp*/
+
+#ifndef DEFNOVECT
+
+/*-------------------------------------------------------\
+| Fun-03: batchAlnTier
+|   - Aligns a list of pairs with the 8, 16, or 32 bit
+|     kernel, one vector of pairs at a time
+| Input:
+|   - qryAryST:
+|     o Array of pointers to seqStructs with the query
+|       sequences
+|   - refAryST:
+|     o Array of pointers to seqStructs with the reference
+|       sequences
+|   - tierAryUL:
+|     o Index of each pair (in qryAryST) to align
+|   - numTierUL:
+|     o Pointer to the number of pairs in tierAryUL
+|   - bitsC:
+|     o Number of bits per score (8, 16, or 32)
+|   - needleBl:
+|     o 1: Do Needleman alignments
+|     o 0: Do Waterman alignments
+|   - dirBl:
+|     o 1: Fill in the direction matrixes
+|     o 0: Only find the scores
+|   - settings:
+|     o alnSet structure with the alignment settings
+|   - retAryST:
+|     o Array of alnMatrix structures (set up with
+|       batchAlnSetUp) to hold the results
+| Output:
+|   - Modifies:
+|     o retAryST for each pair that did not overflow
+|     o tierAryUL to only have the pairs that overflowed
+|       or that could not be done with bitsC bits
+|     o numTierUL to be the number of pairs left in
+|       tierAryUL (always 0 for 32 bits)
+|   - Returns:
+|     o 0 for no errors
+|     o 64 for memory errors
+\-------------------------------------------------------*/
+static char batchAlnTier(
+   struct seqStruct **qryAryST,
+   struct seqStruct **refAryST,
+   ulong *tierAryUL,
+   ulong *numTierUL,
+   char bitsC,
+   char needleBl,
+   char dirBl,
+   struct alnSet *settings,
+   struct alnMatrix *retAryST
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-03 TOC: batchAlnTier
+   '  - Aligns a list of pairs with one kernel
+   '  o fun-03 sec-01:
+   '    - Variable declerations
+   '  o fun-03 sec-02:
+   '    - Find the limits of the kernel
+   '  o fun-03 sec-03:
+   '    - Align the pairs
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-03 Sec-01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*8 bit vectors have the most elements*/
+   ulong groupAryUL[defNum8BitElms]; /*Pairs in vector*/
+   char overflowAryC[defNum8BitElms];
+
+   ulong numElmsUL = 0; /*Pairs in one vector*/
+   ulong numGroupUL = 0;
+   ulong numLeftUL = 0; /*Pairs to redo with more bits*/
+   ulong ulPair = 0;
+   ulong ulElm = 0;
+   ulong lenUL = 0;
+
+   long minL = 0;
+   long maxL = 0;
+   long gapL = 0;
+   long extendL = 0;
+   char errC = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-03 Sec-02:
+   ^  - Find the limits of the kernel
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   switch(bitsC)
+   { /*Switch: find the number of pairs per vector*/
+      case 8:
+         numElmsUL = defNum8BitElms;
+         minL = defBatchMinI8;
+         maxL = defBatchMaxI8;
+         break;
+
+      case 16:
+         numElmsUL = defNum16BitElms;
+         minL = defBatchMinI16;
+         maxL = defBatchMaxI16;
+         break;
+
+      default:
+         numElmsUL = defNum32BitElms;
+         break;
+   } /*Switch: find the number of pairs per vector*/
+
+   if(settings->noGapBl) extendL = settings->gapOpenC;
+   else extendL = settings->gapExtendC;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-03 Sec-03:
+   ^  - Align the pairs
+   ^  o fun-03 sec-03 sub-01:
+   ^    - Add pairs to the vector
+   ^  o fun-03 sec-03 sub-02:
+   ^    - Align the pairs in the vector
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*****************************************************\
+   * Fun-03 Sec-03 Sub-01:
+   *  - Add pairs to the vector
+   \*****************************************************/
+
+   /*The extra loop is for the left over pairs*/
+   for(ulPair = 0; ulPair <= *numTierUL; ++ulPair)
+   { /*Loop: align each pair*/
+      if(ulPair < *numTierUL)
+      { /*If: I have a pair to add*/
+         lenUL = retAryST[tierAryUL[ulPair]].lenQryUL;
+
+         if(retAryST[tierAryUL[ulPair]].lenRefUL > lenUL)
+            lenUL = retAryST[tierAryUL[ulPair]].lenRefUL;
+
+         /*The Needleman gap row/column has to fit*/
+         gapL =
+              settings->gapOpenC
+            + extendL * (long) (lenUL - 1);
+
+         if(
+               needleBl
+            && bitsC < 32
+            && (gapL <= minL || gapL >= maxL)
+         ){ /*If: this pair will overflow*/
+            tierAryUL[numLeftUL] = tierAryUL[ulPair];
+            ++numLeftUL;
+            continue;
+         } /*If: this pair will overflow*/
+
+         groupAryUL[numGroupUL] = tierAryUL[ulPair];
+         ++numGroupUL;
+
+         if(numGroupUL < numElmsUL) continue;
+      } /*If: I have a pair to add*/
+
+      if(numGroupUL == 0) continue;
+
+      /**************************************************\
+      * Fun-03 Sec-03 Sub-02:
+      *  - Align the pairs in the vector
+      \**************************************************/
+
+      switch(bitsC)
+      { /*Switch: align with the right number of bits*/
+         case 8:
+            errC =
+               batchAlnI8(
+                  qryAryST,
+                  refAryST,
+                  groupAryUL,
+                  numGroupUL,
+                  needleBl,
+                  dirBl,
+                  settings,
+                  retAryST,
+                  overflowAryC
+               );
+            break;
+
+         case 16:
+            errC =
+               batchAlnI16(
+                  qryAryST,
+                  refAryST,
+                  groupAryUL,
+                  numGroupUL,
+                  needleBl,
+                  dirBl,
+                  settings,
+                  retAryST,
+                  overflowAryC
+               );
+            break;
+
+         default:
+            errC =
+               batchAlnI32(
+                  qryAryST,
+                  refAryST,
+                  groupAryUL,
+                  numGroupUL,
+                  needleBl,
+                  dirBl,
+                  settings,
+                  retAryST
+               );
+
+            for(ulElm = 0; ulElm < numGroupUL; ++ulElm)
+               overflowAryC[ulElm] = 0;
+
+            break;
+      } /*Switch: align with the right number of bits*/
+
+      if(errC) return 64;
+
+      for(ulElm = 0; ulElm < numGroupUL; ++ulElm)
+      { /*Loop: keep the pairs that overflowed*/
+         if(! overflowAryC[ulElm]) continue;
+
+         tierAryUL[numLeftUL] = groupAryUL[ulElm];
+         ++numLeftUL;
+      } /*Loop: keep the pairs that overflowed*/
+
+      numGroupUL = 0;
+   } /*Loop: align each pair*/
+
+   *numTierUL = numLeftUL;
+   return 0;
+} /*batchAlnTier*/
+
+#endif /*DEFNOVECT*/
+
+/*-------------------------------------------------------\
+| Fun-04: batchAln
+|   - Aligns an array of query/reference pairs. Pairs are
+|     aligned one vector of pairs at a time (one pair per
+|     element), so similar length pairs are best.
+|   - Needlemans and alignments with a direction matrix
+|     are first tried with 8 bit scores, then 16 bit
+|     scores, and then 32 bit scores. Each pair is only
+|     redone with more bits if its scores overflowed.
+| Input:
+|   - qryAryST:
+|     o Array of pointers to seqStructs with the query
+|       sequences. The sequences need to be converted
+|       with seqToLookupIndex and offsetUL/endAlnUL need
+|       to be set (index 0)
+|   - refAryST:
+|     o Array of pointers to seqStructs with the reference
+|       sequences (same as qryAryST). The same reference
+|       can be used for many pairs.
+|   - numPairsUL:
+|     o Number of pairs in qryAryST and refAryST
+|   - needleBl:
+|     o 1: Do Needleman alignments
+|     o 0: Do Waterman alignments
+|   - dirBl:
+|     o 1: Fill in the direction matrix for each pair, so
+|          dirMatrixToAln can be used
+|     o 0: Only find the scores and start/end indexes
+|   - settings:
+|     o alnSet structure with the alignment settings
+| Output:
+|   - Returns:
+|     o Array of numPairsUL alnMatrix structures, one for
+|       each pair. Free with freeBatchAln.
+|       - bestScoreL is the score
+|       - bestStartIndexUL is the start (Waterman with
+|         dirBl = 0; 0 otherwise)
+|       - bestEndIndexUL is the end
+|       - dirMatrix is the direction matrix (dirBl = 1)
+|       - scoreBitsC is the number of bits used for the
+|         scores (8, 16, 32, or 0 for scalar)
+|     o 0 for memory errors
+\-------------------------------------------------------*/
+static struct alnMatrix * batchAln(
+   struct seqStruct **qryAryST,
+   struct seqStruct **refAryST,
+   ulong numPairsUL,
+   char needleBl,
+   char dirBl,
+   struct alnSet *settings
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-04 TOC: batchAln
+   '  - Aligns an array of query/reference pairs
+   '  o fun-04 sec-01:
+   '    - Variable declerations
+   '  o fun-04 sec-02:
+   '    - Allocate memory
+   '  o fun-04 sec-03:
+   '    - Align the scalar pairs and set up vector pairs
+   '  o fun-04 sec-04:
+   '    - Align the vector pairs (8, 16, then 32 bits)
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-04 Sec-01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   struct alnMatrix *retAryST = 0;
+   ulong ulPair = 0;
+
+   /*Score rows for the scalar pairs (reused)*/
+   struct alnScratch scratchST;
+
+   #ifndef DEFNOVECT
+      ulong *tierAryUL = 0; /*Pairs to align in vectors*/
+      ulong numTierUL = 0;
+      ulong lenQryUL = 0;
+      ulong lenRefUL = 0;
+      long gapDiffL = 0; /*gap open - gap extend*/
+   #endif
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-04 Sec-02:
+   ^  - Allocate memory
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(numPairsUL == 0) return 0;
+   initAlnScratch(&scratchST);
+
+   retAryST = calloc(numPairsUL, sizeof(struct alnMatrix));
+   if(retAryST == 0) return 0;
+
+   #ifndef DEFNOVECT
+      tierAryUL = malloc(numPairsUL * sizeof(ulong));
+      if(tierAryUL == 0) goto memErr;
+   #endif
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-04 Sec-03:
+   ^  - Align the scalar pairs and set up vector pairs
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(ulPair = 0; ulPair < numPairsUL; ++ulPair)
+   { /*Loop: align each pair*/
+      #ifndef DEFNOVECT
+         lenQryUL =
+              qryAryST[ulPair]->endAlnUL
+            - qryAryST[ulPair]->offsetUL
+            + 1;
+
+         lenRefUL =
+              refAryST[ulPair]->endAlnUL
+            - refAryST[ulPair]->offsetUL
+            + 1;
+
+         if(
+               vectWaterDirBl(settings->bestDirC)
+            && settings->vectSetC != defVectScalar
+            &&    (lenQryUL + 1)
+               <= defBatchMaxMatrix / (lenRefUL + 1)
+            && lenQryUL + lenRefUL <= defBatchMaxLenSum
+         ){ /*If: this pair can go in a vector*/
+            if(
+               batchAlnSetUp(
+                  qryAryST[ulPair],
+                  refAryST[ulPair],
+                  needleBl,
+                  dirBl,
+                  &retAryST[ulPair]
+               )
+            ) goto memErr;
+
+            tierAryUL[numTierUL] = ulPair;
+            ++numTierUL;
+            continue;
+         } /*If: this pair can go in a vector*/
+      #endif
+
+      if(
+         batchAlnScalar(
+            qryAryST[ulPair],
+            refAryST[ulPair],
+            needleBl,
+            dirBl,
+            settings,
+            &scratchST,
+            &retAryST[ulPair]
+         )
+      ) goto memErr;
+   } /*Loop: align each pair*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-04 Sec-04:
+   ^  - Align the vector pairs (8, 16, then 32 bits)
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   #ifndef DEFNOVECT
+      if(settings->noGapBl) gapDiffL = 0;
+      else
+         gapDiffL =
+            settings->gapOpenC - settings->gapExtendC;
+
+      /*The 8 and 16 bit kernels do not find the starting
+      ` index of a Waterman, so they need the direction
+      ` matrix (dirMatrixToAln finds the start)
+      */
+      if(needleBl || dirBl)
+      { /*If: I can use the 8 and 16 bit kernels*/
+         if(
+               gapDiffL >= defBatchMinI8
+            && gapDiffL <= defBatchMaxI8
+            && numTierUL > 0
+            && batchAlnTier(
+                  qryAryST,
+                  refAryST,
+                  tierAryUL,
+                  &numTierUL,
+                  8,
+                  needleBl,
+                  dirBl,
+                  settings,
+                  retAryST
+               )
+         ) goto memErr;
+
+         if(
+               gapDiffL >= defBatchMinI16
+            && gapDiffL <= defBatchMaxI16
+            && numTierUL > 0
+            && batchAlnTier(
+                  qryAryST,
+                  refAryST,
+                  tierAryUL,
+                  &numTierUL,
+                  16,
+                  needleBl,
+                  dirBl,
+                  settings,
+                  retAryST
+               )
+         ) goto memErr;
+      } /*If: I can use the 8 and 16 bit kernels*/
+
+      if(
+            numTierUL > 0
+         && batchAlnTier(
+               qryAryST,
+               refAryST,
+               tierAryUL,
+               &numTierUL,
+               32,
+               needleBl,
+               dirBl,
+               settings,
+               retAryST
+            )
+      ) goto memErr;
+
+      free(tierAryUL);
+   #endif
+
+   freeAlnScratchStack(&scratchST);
+   return retAryST;
+
+   memErr:
+
+   freeAlnScratchStack(&scratchST);
+
+   #ifndef DEFNOVECT
+      if(tierAryUL != 0) free(tierAryUL);
+   #endif
+
+   for(ulPair = 0; ulPair < numPairsUL; ++ulPair)
+      freeAlnMatrixStack(&retAryST[ulPair]);
+
+   free(retAryST);
+   return 0;
+} /*batchAln*/
+
+/*-------------------------------------------------------\
+| Macro-05: freeBatchAln
+|   - Frees the array of alnMatrix structures returned by
+|     batchAln
+| Input:
+|   - matrixAryST:
+|     o Array of alnMatrix structures to free
+|   - numPairsUL:
+|     o Number of structures in matrixAryST
+| Output:
+|   - Frees:
+|     o matrixAryST and each structures direction matrix
+\-------------------------------------------------------*/
+#define freeBatchAln(matrixAryST, numPairsUL){\
+   ulong macroPairUL = 0;\
+   \
+   if((matrixAryST) != 0)\
+   { /*If: I have an array to free*/\
+      for(\
+         macroPairUL = 0;\
+         macroPairUL < (numPairsUL);\
+         ++macroPairUL\
+      ) freeAlnMatrixStack(&(matrixAryST)[macroPairUL]);\
+      \
+      free((matrixAryST));\
+   } /*If: I have an array to free*/\
+} /*freeBatchAln*/
+
+#endif
@@ -0,0 +1,598 @@
+/*########################################################
+# Name batchAlnI32
+# Use:
+#  o Holds the 32 bit batchAln kernel. Each pair gets its
+#    own element (lane) in a 32 bit vector. This is the
+#    only batchAln kernel that finds the starting index
+#    of a Waterman and it will not overflow for matrixes
+#    that fit in 32 bit indexes.
+# Libraries:
+#   - "genBatchAln.h"                  (No .c file)
+#   - "../memWater/memWaterVect.h"     (No .c file)
+#   o "../general/alnMatrixStruct.h"   (No .c file)
+#   o "../general/dataTypeShortHand.h" (No .c file)
+#   o "../general/alnSetStruct.h"      (No .c file)
+#   o "../general/alnSeqDefaults.h"    (No .c file)
+#   o "../general/seqStruct.h"         (No .c file)
+#   o "../vectWrap/vectWrap.h"         (No .c file)
+# C Standard libraries:
+#   o <stdint.h>
+#   o <stdlib.h>
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+' o fun-01 batchAlnI32:
+'   - Aligns up to one vector of pairs at once with 32 bit
+'     scores (one pair per element)
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#ifndef BATCH_ALN_I32_H
+#define BATCH_ALN_I32_H
+
+#include <stdint.h>
+
+#include "genBatchAln.h"
+#include "../memWater/memWaterVect.h"
+
+#ifndef DEFNOVECT
+
+/*-------------------------------------------------------\
+| Fun-01: batchAlnI32
+|   - Aligns up to defNum32BitElms pairs at once with 32
+|     bit scores. Each pair is in its own element (lane)
+|     of the vectors.
+|   - This follows the scalar aligners with the delInsSnp
+|     direction preference: a deletion wins ties with an
+|     insertion, and a snp has to beat both
+| Input:
+|   - qryAryST:
+|     o Array of pointers to seqStructs with the query
+|       sequences (lookup indexes) and offsetUL/endAlnUL
+|   - refAryST:
+|     o Array of pointers to seqStructs with the reference
+|       sequences (lookup indexes) and offsetUL/endAlnUL
+|   - pairAryUL:
+|     o Index of each pair in qryAryST/refAryST to align
+|   - numPairsUL:
+|     o Number of pairs in pairAryUL (<= defNum32BitElms)
+|   - needleBl:
+|     o 1: Do a Needleman alignment
+|     o 0: Do a Waterman alignment
+|   - dirBl:
+|     o 1: Fill in a direction matrix for each pair
+|     o 0: Only find the score and start/end indexes
+|   - settings:
+|     o alnSet structure with the alignment settings
+|   - retAryST:
+|     o Array of alnMatrix structures to hold the results
+|       (indexed the same as qryAryST). These need to be
+|       set up with batchAlnSetUp
+| Output:
+|   - Modifies:
+|     o The alnMatrix structures in retAryST for each pair
+|       in pairAryUL (scoreBitsC is set to 32)
+|   - Returns:
+|     o 0 for no errors
+|     o 64 for memory errors
+\-------------------------------------------------------*/
+static char batchAlnI32(
+   struct seqStruct **qryAryST,
+   struct seqStruct **refAryST,
+   ulong *pairAryUL,
+   ulong numPairsUL,
+   char needleBl,
+   char dirBl,
+   struct alnSet *settings,
+   struct alnMatrix *retAryST
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-01 TOC: batchAlnI32
+   '  - Aligns up to one vector of pairs at once
+   '  o fun-01 sec-01:
+   '    - Variable declerations
+   '  o fun-01 sec-02:
+   '    - Find lengths and allocate memory
+   '  o fun-01 sec-03:
+   '    - Interleave the sequences and set up the gap row
+   '  o fun-01 sec-04:
+   '    - Score the matrices
+   '  o fun-01 sec-05:
+   '    - Copy the results and clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-01 Sec-01:
+   ^  - Variable declerations
+   ^  o fun-01 sec-01 sub-01:
+   ^    - Non-vector variables
+   ^  o fun-01 sec-01 sub-02:
+   ^    - Vectors
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*****************************************************\
+   * Fun-01 Sec-01 Sub-01:
+   *  - Non-vector variables
+   \*****************************************************/
+
+   struct alnMatrix *matrixST = 0;
+
+   ulong lenQryUL = 0; /*Longest query*/
+   ulong lenRefUL = 0; /*Longest reference*/
+
+   ulong ulQry = 0;
+   ulong ulRef = 0;
+   ulong ulElm = 0;
+   ulong ulBase = 0;
+   ulong indexUL = 0;
+
+   ulong lenQryAryUL[defNum32BitElms];
+   ulong lenRefAryUL[defNum32BitElms];
+
+   struct vectMemBlock memST;
+
+   int32_t *lenQryAryI = 0;  /*Query length of each pair*/
+   int32_t *lenRefAryI = 0;  /*Ref length of each pair*/
+   int32_t *tmpAryI = 0;     /*Scores/directions to load*/
+
+   int32_t *scoreAryI = 0;   /*Scores for the last row*/
+   int32_t *snpAryI = 0;     /*-1 if last row was a snp*/
+   int32_t *startAryI = 0;   /*Starting index (Waterman)*/
+
+   char *qryAryC = 0; /*Interleaved query sequences*/
+   char *refAryC = 0; /*Interleaved reference sequences*/
+   char *qryOnC = 0;
+   char *refOnC = 0;
+
+   /*****************************************************\
+   * Fun-01 Sec-01 Sub-02:
+   *  - Vectors
+   \*****************************************************/
+
+   vectI32 zeroVI = zero_retVectI32();
+   vectI32 oneVI = set1_I32_retVectI32(1);
+   vectI32 threeVI = set1_I32_retVectI32(3);
+   vectI32 extendVI;
+   vectI32 gapDiffVI;
+
+   vectI32 lenQryVI;
+   vectI32 lenRefVI;
+   vectI32 rowLenVI;   /*Length of a row (lenRef + 1)*/
+   vectI32 rowIndexVI; /*Index of the gap column cell*/
+   vectI32 indexVI;    /*Index of the current cell*/
+   vectI32 rowOkVI;    /*-1 if this row is in the pair*/
+   vectI32 validVI;    /*-1 if cell is in the pair*/
+
+   vectI32 diagVI;
+   vectI32 diagStartVI;
+
+   vectI32 leftVI;
+   vectI32 leftSnpVI;
+   vectI32 leftStartVI;
+
+   vectI32 upVI;
+   vectI32 upSnpVI;
+   vectI32 upStartVI;
+
+   vectI32 snpVI;
+   vectI32 insVI;
+   vectI32 delVI;
+   vectI32 insBlVI;
+   vectI32 snpBlVI;
+   vectI32 keepVI;
+   vectI32 scoreVI;
+   vectI32 startVI;
+
+   vectI32 bestVI;
+   vectI32 bestStartVI;
+   vectI32 bestEndVI;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-01 Sec-02:
+   ^  - Find lengths and allocate memory
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   batchMaxLen(qryAryST, pairAryUL, numPairsUL, lenQryUL);
+   batchMaxLen(refAryST, pairAryUL, numPairsUL, lenRefUL);
+
+   initVectMemBlock(&memST);
+
+   mallocVectMemBlock(
+      &memST,
+        (3 * (lenRefUL + 1) + 3) * defVectBytes
+      + (lenQryUL + lenRefUL + 2) * defNum32BitElms
+   );
+
+   if(memST.freePtr == 0) return 64;
+
+   scoreAryI = (int32_t *) memST.alnPtr;
+   snpAryI = scoreAryI + (lenRefUL + 1) * defNum32BitElms;
+   startAryI = snpAryI + (lenRefUL + 1) * defNum32BitElms;
+   lenQryAryI = startAryI + (lenRefUL+1) * defNum32BitElms;
+   lenRefAryI = lenQryAryI + defNum32BitElms;
+   tmpAryI = lenRefAryI + defNum32BitElms;
+
+   qryAryC = (char *) (tmpAryI + defNum32BitElms);
+   refAryC = qryAryC + (lenQryUL + 1) * defNum32BitElms;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-01 Sec-03:
+   ^  - Interleave the sequences and set up the gap row
+   ^  o fun-01 sec-03 sub-01:
+   ^    - Interleave the sequences
+   ^  o fun-01 sec-03 sub-02:
+   ^    - Set up the gap row and vectors
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*****************************************************\
+   * Fun-01 Sec-03 Sub-01:
+   *  - Interleave the sequences
+   \*****************************************************/
+
+   batchInterleave(
+      qryAryST,
+      pairAryUL,
+      numPairsUL,
+      defNum32BitElms,
+      lenQryUL,
+      qryAryC,
+      lenQryAryUL
+   );
+
+   batchInterleave(
+      refAryST,
+      pairAryUL,
+      numPairsUL,
+      defNum32BitElms,
+      lenRefUL,
+      refAryC,
+      lenRefAryUL
+   );
+
+   for(ulElm = 0; ulElm < defNum32BitElms; ++ulElm)
+   { /*Loop: get the lengths for the length vectors*/
+      lenQryAryI[ulElm] = (int32_t) lenQryAryUL[ulElm];
+      lenRefAryI[ulElm] = (int32_t) lenRefAryUL[ulElm];
+   } /*Loop: get the lengths for the length vectors*/
+
+   /*****************************************************\
+   * Fun-01 Sec-03 Sub-02:
+   *  - Set up the gap row and vectors
+   \*****************************************************/
+
+   if(settings->noGapBl)
+   { /*If: not using gap extension penalties*/
+      extendVI = set1_I32_retVectI32(settings->gapOpenC);
+      gapDiffVI = zeroVI;
+   } /*If: not using gap extension penalties*/
+
+   else
+   { /*Else: using gap extension penalties*/
+      extendVI = set1_I32_retVectI32(settings->gapExtendC);
+
+      gapDiffVI =
+         set1_I32_retVectI32(
+            settings->gapOpenC - settings->gapExtendC
+         );
+   } /*Else: using gap extension penalties*/
+
+   lenQryVI = load_I32Ary_retVectI32(lenQryAryI);
+   lenRefVI = load_I32Ary_retVectI32(lenRefAryI);
+   rowLenVI = add_vectI32_retVectI32(lenRefVI, oneVI);
+
+   /*The gap row. Needleman: open, then extend each base.
+   ` Waterman: all 0 and each cell is its own start.
+   */
+   scoreVI = zeroVI;
+   indexVI = zeroVI;
+
+   for(ulRef = 0; ulRef <= lenRefUL; ++ulRef)
+   { /*Loop: set up the gap row*/
+      ulElm = ulRef * defNum32BitElms;
+
+      store_vectI32_retAryI32(scoreAryI + ulElm, scoreVI);
+      store_vectI32_retAryI32(snpAryI + ulElm, zeroVI);
+      store_vectI32_retAryI32(startAryI + ulElm, indexVI);
+
+      if(needleBl)
+      { /*If: doing a Needleman*/
+         if(ulRef == 0)
+            scoreVI =
+               set1_I32_retVectI32(settings->gapOpenC);
+         else
+            scoreVI =
+               add_vectI32_retVectI32(scoreVI, extendVI);
+      } /*If: doing a Needleman*/
+
+      indexVI = add_vectI32_retVectI32(indexVI, oneVI);
+   } /*Loop: set up the gap row*/
+
+   bestVI = zeroVI;
+   bestStartVI = zeroVI;
+   bestEndVI = zeroVI;
+   rowIndexVI = zeroVI;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-01 Sec-04:
+   ^  - Score the matrices
+   ^  o fun-01 sec-04 sub-01:
+   ^    - Set up the gap column for this row
+   ^  o fun-01 sec-04 sub-02:
+   ^    - Find the scores for each reference base
+   ^  o fun-01 sec-04 sub-03:
+   ^    - Find the best score (Waterman)
+   ^  o fun-01 sec-04 sub-04:
+   ^    - Save the directions
+   ^  o fun-01 sec-04 sub-05:
+   ^    - Get the scores of Needlemans ending on this row
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(ulQry = 1; ulQry <= lenQryUL; ++ulQry)
+   { /*Loop: score each query base*/
+
+      /**************************************************\
+      * Fun-01 Sec-04 Sub-01:
+      *  - Set up the gap column for this row
+      \**************************************************/
+
+      rowIndexVI =
+         add_vectI32_retVectI32(rowIndexVI, rowLenVI);
+
+      rowOkVI =
+         mask32_retVectI32(
+            cmpgt_vectI32_retMask32(
+               lenQryVI,
+               set1_I32_retVectI32(ulQry - 1)
+            )
+         ); /*ulQry <= length of query*/
+
+      diagVI = load_I32Ary_retVectI32(scoreAryI);
+      diagStartVI = load_I32Ary_retVectI32(startAryI);
+
+      if(! needleBl) leftVI = zeroVI;
+      else if(ulQry == 1)
+         leftVI = set1_I32_retVectI32(settings->gapOpenC);
+      else leftVI = add_vectI32_retVectI32(diagVI,extendVI);
+
+      leftSnpVI = zeroVI;
+      leftStartVI = rowIndexVI;
+
+      store_vectI32_retAryI32(scoreAryI, leftVI);
+      store_vectI32_retAryI32(startAryI, leftStartVI);
+
+      qryOnC = qryAryC + (ulQry - 1) * defNum32BitElms;
+      refOnC = refAryC;
+      indexVI = rowIndexVI;
+
+      /**************************************************\
+      * Fun-01 Sec-04 Sub-02:
+      *  - Find the scores for each reference base
+      \**************************************************/
+
+      for(ulRef = 1; ulRef <= lenRefUL; ++ulRef)
+      { /*Loop: score each reference base*/
+         ulElm = ulRef * defNum32BitElms;
+         indexVI = add_vectI32_retVectI32(indexVI, oneVI);
+
+         for(ulBase = 0; ulBase < defNum32BitElms; ++ulBase)
+            tmpAryI[ulBase] =
+               getBaseScore(
+                  qryOnC[ulBase],
+                  refOnC[ulBase],
+                  settings
+               );
+
+         refOnC += defNum32BitElms;
+
+         upVI = load_I32Ary_retVectI32(scoreAryI + ulElm);
+         upSnpVI = load_I32Ary_retVectI32(snpAryI + ulElm);
+         upStartVI =
+            load_I32Ary_retVectI32(startAryI + ulElm);
+
+         snpVI =
+            add_vectI32_retVectI32(
+               diagVI,
+               load_I32Ary_retVectI32(tmpAryI)
+            );
+
+         insVI =
+            add_vectI32_retVectI32(
+               add_vectI32_retVectI32(upVI, extendVI),
+               and_vectI32_retVectI32(upSnpVI, gapDiffVI)
+            );
+
+         delVI =
+            add_vectI32_retVectI32(
+               add_vectI32_retVectI32(leftVI, extendVI),
+               and_vectI32_retVectI32(leftSnpVI, gapDiffVI)
+            );
+
+         insBlVI =
+            mask32_retVectI32(
+               cmpgt_vectI32_retMask32(insVI, delVI)
+            ); /*Deletions win ties*/
+
+         scoreVI = max_vectI32_retVectI32(delVI, insVI);
+
+         if(needleBl) keepVI = scoreVI;
+         else
+            keepVI = max_vectI32_retVectI32(scoreVI,zeroVI);
+
+         snpBlVI =
+            mask32_retVectI32(
+               cmpgt_vectI32_retMask32(snpVI, keepVI)
+            ); /*Snps have to be better*/
+
+         scoreVI = max_vectI32_retVectI32(scoreVI, snpVI);
+
+         if(! needleBl)
+         { /*If: this is a Waterman (find stops)*/
+            keepVI =
+               mask32_retVectI32(
+                  cmpgt_vectI32_retMask32(scoreVI, zeroVI)
+               );
+
+            scoreVI =
+               and_vectI32_retVectI32(scoreVI, keepVI);
+
+            startVI =
+               vectWaterPick(insBlVI,upStartVI,leftStartVI);
+            startVI =
+               vectWaterPick(snpBlVI, diagStartVI, startVI);
+            startVI = vectWaterPick(keepVI,startVI,indexVI);
+
+            store_vectI32_retAryI32(
+               startAryI + ulElm,
+               startVI
+            );
+            leftStartVI = startVI;
+         } /*If: this is a Waterman (find stops)*/
+
+         store_vectI32_retAryI32(scoreAryI+ulElm, scoreVI);
+         store_vectI32_retAryI32(snpAryI + ulElm, snpBlVI);
+
+         diagVI = upVI;
+         diagStartVI = upStartVI;
+
+         leftVI = scoreVI;
+         leftSnpVI = snpBlVI;
+
+         if(! needleBl || dirBl)
+            validVI =
+               and_vectI32_retVectI32(
+                  rowOkVI,
+                  mask32_retVectI32(
+                     cmpgt_vectI32_retMask32(
+                        lenRefVI,
+                        set1_I32_retVectI32(ulRef - 1)
+                     )
+                  )
+               ); /*Cell is in the pairs matrix*/
+
+         /***********************************************\
+         * Fun-01 Sec-04 Sub-03:
+         *  - Find the best score (Waterman)
+         \***********************************************/
+
+         /*Rows are done in order, so only taking better
+         ` scores keeps the first best score (like the
+         ` scalar Waterman)
+         */
+         if(! needleBl)
+         { /*If: this is a Waterman*/
+            keepVI =
+               and_vectI32_retVectI32(
+                  validVI,
+                  mask32_retVectI32(
+                     cmpgt_vectI32_retMask32(scoreVI,bestVI)
+                  )
+               );
+
+            bestVI = vectWaterPick(keepVI, scoreVI, bestVI);
+
+            bestStartVI =
+               vectWaterPick(keepVI, startVI, bestStartVI);
+
+            bestEndVI =
+               vectWaterPick(keepVI, indexVI, bestEndVI);
+         } /*If: this is a Waterman*/
+
+         /***********************************************\
+         * Fun-01 Sec-04 Sub-04:
+         *  - Save the directions
+         \***********************************************/
+
+         if(! dirBl) continue;
+
+         snpVI =
+            add_vectI32_retVectI32(
+               and_vectI32_retVectI32(insBlVI, oneVI),
+               oneVI
+            ); /*defMvDel (1) or defMvIns (2)*/
+
+         snpVI = vectWaterPick(snpBlVI, threeVI, snpVI);
+
+         if(! needleBl)
+            snpVI =
+               and_vectI32_retVectI32(
+                  snpVI,
+                  mask32_retVectI32(
+                     cmpgt_vectI32_retMask32(scoreVI,zeroVI)
+                  )
+               ); /*Stops (defMvStop is 0)*/
+
+         store_mask32_retUL(
+            indexUL,
+            cmpgt_vectI32_retMask32(zeroVI, validVI)
+         );
+
+         if(indexUL == 0) continue; /*No pairs have cell*/
+
+         store_vectI32_retAryI32(tmpAryI, snpVI);
+
+         batchScatterDir(
+            tmpAryI,
+            pairAryUL,
+            numPairsUL,
+            lenQryAryUL,
+            lenRefAryUL,
+            ulQry,
+            ulRef,
+            retAryST
+         );
+      } /*Loop: score each reference base*/
+
+      /**************************************************\
+      * Fun-01 Sec-04 Sub-05:
+      *  - Get the scores of Needlemans ending on this row
+      \**************************************************/
+
+      if(! needleBl) continue;
+
+      for(ulElm = 0; ulElm < numPairsUL; ++ulElm)
+      { /*Loop: check if any pairs ended*/
+         if(ulQry != (ulong) lenQryAryI[ulElm]) continue;
+
+         matrixST = &retAryST[pairAryUL[ulElm]];
+
+         matrixST->bestScoreL =
+            scoreAryI[
+                 lenRefAryI[ulElm] * defNum32BitElms
+               + ulElm
+            ];
+
+         matrixST->bestEndIndexUL =
+              ulQry * (lenRefAryI[ulElm] + 1)
+            + lenRefAryI[ulElm];
+
+         matrixST->scoreBitsC = 32;
+      } /*Loop: check if any pairs ended*/
+   } /*Loop: score each query base*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-01 Sec-05:
+   ^  - Copy the results and clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(! needleBl)
+   { /*If: I need to copy the Waterman scores*/
+      store_vectI32_retAryI32(scoreAryI, bestVI);
+      store_vectI32_retAryI32(snpAryI, bestStartVI);
+      store_vectI32_retAryI32(startAryI, bestEndVI);
+
+      for(ulElm = 0; ulElm < numPairsUL; ++ulElm)
+      { /*Loop: copy the best scores*/
+         matrixST = &retAryST[pairAryUL[ulElm]];
+         matrixST->bestScoreL = scoreAryI[ulElm];
+         matrixST->bestStartIndexUL = snpAryI[ulElm];
+         matrixST->bestEndIndexUL = startAryI[ulElm];
+         matrixST->scoreBitsC = 32;
+      } /*Loop: copy the best scores*/
+   } /*If: I need to copy the Waterman scores*/
+
+   freeVectMemBlockBuff(&memST);
+   return 0;
+} /*batchAlnI32*/
+
+
+#endif /*DEFNOVECT*/
+#endif
@@ -0,0 +1,639 @@
+/*########################################################
+# Name batchAlnI8
+# Use:
+#  o Holds the 8 bit batchAln kernel. Each pair gets its
+#    own element (lane) in an 8 bit vector, so four times as
+#    many pairs are scored at once as the 32 bit kernel.
+#  o Scores use saturating adds. Pairs that hit the
+#    smallest or largest 8 bit number are marked as
+#    overflowed, so they can be redone with 16 bits.
+#  o This does not find the starting index of a Waterman
+#    (indexes do not fit in 8 bits), only the score,
+#    ending index, and direction matrix.
+# Libraries:
+#   - "genBatchAln.h"                  (No .c file)
+#   o "../general/alnMatrixStruct.h"   (No .c file)
+#   o "../general/dataTypeShortHand.h" (No .c file)
+#   o "../general/alnSetStruct.h"      (No .c file)
+#   o "../general/alnSeqDefaults.h"    (No .c file)
+#   o "../general/seqStruct.h"         (No .c file)
+#   o "../vectWrap/vectWrap.h"         (No .c file)
+# C Standard libraries:
+#   o <stdint.h>
+#   o <stdlib.h>
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+' o fun-01 batchAlnI8:
+'   - Aligns up to one vector of pairs at once with 8 bit
+'     scores (one pair per element)
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#ifndef BATCH_ALN_I8_H
+#define BATCH_ALN_I8_H
+
+#include <stdint.h>
+
+#include "genBatchAln.h"
+
+#ifndef DEFNOVECT
+
+#define defBatchMinI8 -128
+#define defBatchMaxI8 127
+
+/*-------------------------------------------------------\
+| Fun-01: batchAlnI8
+|   - Aligns up to defNum8BitElms pairs at once with 8
+|     bit scores. Each pair is in its own element (lane)
+|     of the vectors.
+|   - This follows the scalar aligners with the delInsSnp
+|     direction preference: a deletion wins ties with an
+|     insertion, and a snp has to beat both
+| Input:
+|   - qryAryST:
+|     o Array of pointers to seqStructs with the query
+|       sequences (lookup indexes) and offsetUL/endAlnUL
+|   - refAryST:
+|     o Array of pointers to seqStructs with the reference
+|       sequences (lookup indexes) and offsetUL/endAlnUL
+|   - pairAryUL:
+|     o Index of each pair in qryAryST/refAryST to align
+|   - numPairsUL:
+|     o Number of pairs in pairAryUL (<= defNum8BitElms)
+|   - needleBl:
+|     o 1: Do a Needleman alignment
+|     o 0: Do a Waterman alignment
+|   - dirBl:
+|     o 1: Fill in a direction matrix for each pair
+|     o 0: Only find the score and ending index
+|   - settings:
+|     o alnSet structure with the alignment settings. The
+|       gap open - gap extension has to fit in 8 bits
+|   - retAryST:
+|     o Array of alnMatrix structures to hold the results
+|       (indexed the same as qryAryST). These need to be
+|       set up with batchAlnSetUp
+|   - overflowAryC:
+|     o Array of numPairsUL characters to mark which pairs
+|       overflowed
+| Output:
+|   - Modifies:
+|     o bestScoreL, bestEndIndexUL, and scoreBitsC (8) in
+|       retAryST for each pair that did not overflow
+|     o The direction matrix of each pair (dirBl = 1).
+|       This is garbage for pairs that overflowed.
+|     o overflowAryC to be 1 for each pair that overflowed
+|       and 0 for the others
+|   - Returns:
+|     o 0 for no errors
+|     o 64 for memory errors
+\-------------------------------------------------------*/
+static char batchAlnI8(
+   struct seqStruct **qryAryST,
+   struct seqStruct **refAryST,
+   ulong *pairAryUL,
+   ulong numPairsUL,
+   char needleBl,
+   char dirBl,
+   struct alnSet *settings,
+   struct alnMatrix *retAryST,
+   char *overflowAryC
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-01 TOC: batchAlnI8
+   '  - Aligns up to one vector of pairs at once
+   '  o fun-01 sec-01:
+   '    - Variable declerations
+   '  o fun-01 sec-02:
+   '    - Find lengths and allocate memory
+   '  o fun-01 sec-03:
+   '    - Interleave the sequences and set up the gap row
+   '  o fun-01 sec-04:
+   '    - Score the matrices
+   '  o fun-01 sec-05:
+   '    - Copy the results and clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-01 Sec-01:
+   ^  - Variable declerations
+   ^  o fun-01 sec-01 sub-01:
+   ^    - Non-vector variables
+   ^  o fun-01 sec-01 sub-02:
+   ^    - Vectors
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*****************************************************\
+   * Fun-01 Sec-01 Sub-01:
+   *  - Non-vector variables
+   \*****************************************************/
+
+   struct alnMatrix *matrixST = 0;
+
+   ulong lenQryUL = 0; /*Longest query*/
+   ulong lenRefUL = 0; /*Longest reference*/
+
+   ulong ulQry = 0;
+   ulong ulRef = 0;
+   ulong ulElm = 0;
+   ulong ulBase = 0;
+   ulong indexUL = 0;
+
+   long gapL = 0;     /*Gap row score*/
+   long extendL = 0;  /*Gap extension score*/
+
+   ulong lenQryAryUL[defNum8BitElms];
+   ulong lenRefAryUL[defNum8BitElms];
+   long bestAryL[defNum8BitElms];   /*Score of each pair*/
+   ulong endAryUL[defNum8BitElms];  /*End of each pair*/
+
+   struct vectMemBlock memST;
+
+   int8_t *scoreAryI = 0;   /*Scores for the last row*/
+   int8_t *snpAryI = 0;     /*-1 if last row was a snp*/
+   int8_t *colOkAryI = 0;   /*-1 if column is in a pair*/
+   int8_t *rowOkAryI = 0;   /*-1 if row is in a pair*/
+   int8_t *tmpAryI = 0;     /*Scores/directions to load*/
+
+   char *qryAryC = 0; /*Interleaved query sequences*/
+   char *refAryC = 0; /*Interleaved reference sequences*/
+   char *qryOnC = 0;
+   char *refOnC = 0;
+
+   /*****************************************************\
+   * Fun-01 Sec-01 Sub-02:
+   *  - Vectors
+   \*****************************************************/
+
+   vectI8 zeroVI = zero_retVectI8();
+   vectI8 oneVI = set1_I8_retVectI8(1);
+   vectI8 threeVI = set1_I8_retVectI8(3);
+   vectI8 minVI = set1_I8_retVectI8(defBatchMinI8);
+   vectI8 maxVI = set1_I8_retVectI8(defBatchMaxI8);
+   vectI8 extendVI;
+   vectI8 gapDiffVI;
+
+   vectI8 rowOkVI;    /*-1 if this row is in the pair*/
+   vectI8 validVI;    /*-1 if cell is in the pair*/
+   vectI8 overflowVI; /*-1 if the pair overflowed*/
+
+   vectI8 diagVI;
+   vectI8 leftVI;
+   vectI8 leftSnpVI;
+   vectI8 upVI;
+   vectI8 upSnpVI;
+
+   vectI8 snpVI;
+   vectI8 insVI;
+   vectI8 delVI;
+   vectI8 insBlVI;
+   vectI8 snpBlVI;
+   vectI8 keepVI;
+   vectI8 scoreVI;
+
+   vectI8 bestVI;
+   vectI8 betterVI;   /*-1 if best score is in this row*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-01 Sec-02:
+   ^  - Find lengths and allocate memory
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   batchMaxLen(qryAryST, pairAryUL, numPairsUL, lenQryUL);
+   batchMaxLen(refAryST, pairAryUL, numPairsUL, lenRefUL);
+
+   initVectMemBlock(&memST);
+
+   mallocVectMemBlock(
+      &memST,
+        (3 * (lenRefUL + 1) + 2) * defVectBytes
+      + (lenQryUL + lenRefUL + 2) * defNum8BitElms
+   );
+
+   if(memST.freePtr == 0) return 64;
+
+   scoreAryI = (int8_t *) memST.alnPtr;
+   snpAryI = scoreAryI + (lenRefUL + 1) * defNum8BitElms;
+   colOkAryI = snpAryI + (lenRefUL + 1) * defNum8BitElms;
+   rowOkAryI = colOkAryI + (lenRefUL+1) * defNum8BitElms;
+   tmpAryI = rowOkAryI + defNum8BitElms;
+
+   qryAryC = (char *) (tmpAryI + defNum8BitElms);
+   refAryC = qryAryC + (lenQryUL + 1) * defNum8BitElms;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-01 Sec-03:
+   ^  - Interleave the sequences and set up the gap row
+   ^  o fun-01 sec-03 sub-01:
+   ^    - Interleave the sequences
+   ^  o fun-01 sec-03 sub-02:
+   ^    - Set up the gap row and valid columns
+   ^  o fun-01 sec-03 sub-03:
+   ^    - Set up the vectors
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*****************************************************\
+   * Fun-01 Sec-03 Sub-01:
+   *  - Interleave the sequences
+   \*****************************************************/
+
+   batchInterleave(
+      qryAryST,
+      pairAryUL,
+      numPairsUL,
+      defNum8BitElms,
+      lenQryUL,
+      qryAryC,
+      lenQryAryUL
+   );
+
+   batchInterleave(
+      refAryST,
+      pairAryUL,
+      numPairsUL,
+      defNum8BitElms,
+      lenRefUL,
+      refAryC,
+      lenRefAryUL
+   );
+
+   /*****************************************************\
+   * Fun-01 Sec-03 Sub-02:
+   *  - Set up the gap row and valid columns
+   \*****************************************************/
+
+   if(settings->noGapBl) extendL = settings->gapOpenC;
+   else extendL = settings->gapExtendC;
+
+   for(ulRef = 0; ulRef <= lenRefUL; ++ulRef)
+   { /*Loop: set up the gap row*/
+      /*Needleman: open, then extend each base*/
+      if(! needleBl || ulRef == 0) gapL = 0;
+      else if(ulRef == 1) gapL = settings->gapOpenC;
+      else gapL += extendL;
+
+      if(gapL < defBatchMinI8) gapL = defBatchMinI8;
+      if(gapL > defBatchMaxI8) gapL = defBatchMaxI8;
+
+      for(ulElm = 0; ulElm < defNum8BitElms; ++ulElm)
+      { /*Loop: set up each pair*/
+         indexUL = ulRef * defNum8BitElms + ulElm;
+
+         scoreAryI[indexUL] = (int8_t) gapL;
+         snpAryI[indexUL] = 0;
+         colOkAryI[indexUL] = -(ulRef<=lenRefAryUL[ulElm]);
+      } /*Loop: set up each pair*/
+   } /*Loop: set up the gap row*/
+
+   for(ulElm = 0; ulElm < defNum8BitElms; ++ulElm)
+   { /*Loop: set up the scores*/
+      bestAryL[ulElm] = 0;
+      endAryUL[ulElm] = 0;
+      tmpAryI[ulElm] = 0;
+
+      if(! needleBl || ulElm >= numPairsUL) continue;
+
+      /*A gap row or column that does not fit will always
+      ` overflow (the insertion/deletion scores are off)
+      */
+      gapL =
+           settings->gapOpenC
+         + extendL * (long) (lenRefAryUL[ulElm] - 1);
+
+      if(gapL <= defBatchMinI8 || gapL >= defBatchMaxI8)
+         tmpAryI[ulElm] = -1;
+
+      gapL =
+           settings->gapOpenC
+         + extendL * (long) (lenQryAryUL[ulElm] - 1);
+
+      if(gapL <= defBatchMinI8 || gapL >= defBatchMaxI8)
+         tmpAryI[ulElm] = -1;
+   } /*Loop: set up the scores*/
+
+   /*****************************************************\
+   * Fun-01 Sec-03 Sub-03:
+   *  - Set up the vectors
+   \*****************************************************/
+
+   overflowVI = load_I8Ary_retVectI8(tmpAryI);
+   extendVI = set1_I8_retVectI8(extendL);
+
+   if(settings->noGapBl) gapDiffVI = zeroVI;
+   else
+      gapDiffVI =
+         set1_I8_retVectI8(
+            settings->gapOpenC - settings->gapExtendC
+         );
+
+   bestVI = zeroVI;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-01 Sec-04:
+   ^  - Score the matrices
+   ^  o fun-01 sec-04 sub-01:
+   ^    - Set up the gap column for this row
+   ^  o fun-01 sec-04 sub-02:
+   ^    - Find the scores for each reference base
+   ^  o fun-01 sec-04 sub-03:
+   ^    - Check for overflows and find the best score
+   ^  o fun-01 sec-04 sub-04:
+   ^    - Save the directions
+   ^  o fun-01 sec-04 sub-05:
+   ^    - Find the ends of the Watermans
+   ^  o fun-01 sec-04 sub-06:
+   ^    - Get the scores of Needlemans ending on this row
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(ulQry = 1; ulQry <= lenQryUL; ++ulQry)
+   { /*Loop: score each query base*/
+
+      /**************************************************\
+      * Fun-01 Sec-04 Sub-01:
+      *  - Set up the gap column for this row
+      \**************************************************/
+
+      for(ulElm = 0; ulElm < defNum8BitElms; ++ulElm)
+         rowOkAryI[ulElm] = -(ulQry <= lenQryAryUL[ulElm]);
+
+      rowOkVI = load_I8Ary_retVectI8(rowOkAryI);
+      diagVI = load_I8Ary_retVectI8(scoreAryI);
+
+      if(! needleBl) leftVI = zeroVI;
+      else if(ulQry == 1)
+         leftVI = set1_I8_retVectI8(settings->gapOpenC);
+      else
+         leftVI =
+            addSat_vectI8_retVectI8(diagVI, extendVI);
+
+      leftSnpVI = zeroVI;
+      betterVI = zeroVI;
+      store_vectI8_retAryI8(scoreAryI, leftVI);
+
+      qryOnC = qryAryC + (ulQry - 1) * defNum8BitElms;
+      refOnC = refAryC;
+
+      /**************************************************\
+      * Fun-01 Sec-04 Sub-02:
+      *  - Find the scores for each reference base
+      \**************************************************/
+
+      for(ulRef = 1; ulRef <= lenRefUL; ++ulRef)
+      { /*Loop: score each reference base*/
+         ulElm = ulRef * defNum8BitElms;
+
+         for(ulBase = 0; ulBase < defNum8BitElms; ++ulBase)
+            tmpAryI[ulBase] =
+               getBaseScore(
+                  qryOnC[ulBase],
+                  refOnC[ulBase],
+                  settings
+               );
+
+         refOnC += defNum8BitElms;
+
+         upVI = load_I8Ary_retVectI8(scoreAryI + ulElm);
+         upSnpVI = load_I8Ary_retVectI8(snpAryI + ulElm);
+
+         snpVI =
+            addSat_vectI8_retVectI8(
+               diagVI,
+               load_I8Ary_retVectI8(tmpAryI)
+            );
+
+         insVI =
+            addSat_vectI8_retVectI8(
+               addSat_vectI8_retVectI8(upVI, extendVI),
+               and_vectI8_retVectI8(upSnpVI, gapDiffVI)
+            );
+
+         delVI =
+            addSat_vectI8_retVectI8(
+               addSat_vectI8_retVectI8(leftVI, extendVI),
+               and_vectI8_retVectI8(leftSnpVI, gapDiffVI)
+            );
+
+         insBlVI =
+            mask8_retVectI8(
+               cmpgt_vectI8_retMask8(insVI, delVI)
+            ); /*Deletions win ties*/
+
+         scoreVI = max_vectI8_retVectI8(delVI, insVI);
+
+         if(needleBl) keepVI = scoreVI;
+         else
+            keepVI = max_vectI8_retVectI8(scoreVI,zeroVI);
+
+         snpBlVI =
+            mask8_retVectI8(
+               cmpgt_vectI8_retMask8(snpVI, keepVI)
+            ); /*Snps have to be better*/
+
+         scoreVI = max_vectI8_retVectI8(scoreVI, snpVI);
+
+         if(! needleBl)
+            scoreVI =
+               and_vectI8_retVectI8(
+                  scoreVI,
+                  mask8_retVectI8(
+                     cmpgt_vectI8_retMask8(scoreVI,zeroVI)
+                  )
+               ); /*Waterman stops (score <= 0)*/
+
+         store_vectI8_retAryI8(scoreAryI+ulElm, scoreVI);
+         store_vectI8_retAryI8(snpAryI + ulElm, snpBlVI);
+
+         diagVI = upVI;
+         leftVI = scoreVI;
+         leftSnpVI = snpBlVI;
+
+         /***********************************************\
+         * Fun-01 Sec-04 Sub-03:
+         *  - Check for overflows and find the best score
+         \***********************************************/
+
+         validVI =
+            and_vectI8_retVectI8(
+               rowOkVI,
+               load_I8Ary_retVectI8(colOkAryI + ulElm)
+            ); /*Cell is in the pairs matrix*/
+
+         /*A score at the limit may have saturated*/
+         keepVI =
+            or_vectI8_retVectI8(
+               or_vectI8_retVectI8(
+                  mask8_retVectI8(
+                     cmpeq_vectI8_retMask8(insVI, minVI)
+                  ),
+                  mask8_retVectI8(
+                     cmpeq_vectI8_retMask8(delVI, minVI)
+                  )
+               ),
+               or_vectI8_retVectI8(
+                  mask8_retVectI8(
+                     cmpeq_vectI8_retMask8(snpVI, minVI)
+                  ),
+                  mask8_retVectI8(
+                     cmpeq_vectI8_retMask8(scoreVI, maxVI)
+                  )
+               )
+            );
+
+         overflowVI =
+            or_vectI8_retVectI8(
+               overflowVI,
+               and_vectI8_retVectI8(validVI, keepVI)
+            );
+
+         /*Rows are done in order, so only taking better
+         ` scores keeps the first best score (like the
+         ` scalar Waterman)
+         */
+         if(! needleBl)
+         { /*If: this is a Waterman*/
+            keepVI =
+               and_vectI8_retVectI8(
+                  validVI,
+                  mask8_retVectI8(
+                     cmpgt_vectI8_retMask8(scoreVI,bestVI)
+                  )
+               );
+
+            bestVI = batchPickI8(keepVI, scoreVI, bestVI);
+            betterVI =
+               or_vectI8_retVectI8(betterVI, keepVI);
+         } /*If: this is a Waterman*/
+
+         /***********************************************\
+         * Fun-01 Sec-04 Sub-04:
+         *  - Save the directions
+         \***********************************************/
+
+         if(! dirBl) continue;
+
+         snpVI =
+            addSat_vectI8_retVectI8(
+               and_vectI8_retVectI8(insBlVI, oneVI),
+               oneVI
+            ); /*defMvDel (1) or defMvIns (2)*/
+
+         snpVI = batchPickI8(snpBlVI, threeVI, snpVI);
+
+         if(! needleBl)
+            snpVI =
+               and_vectI8_retVectI8(
+                  snpVI,
+                  mask8_retVectI8(
+                     cmpgt_vectI8_retMask8(scoreVI,zeroVI)
+                  )
+               ); /*Stops (defMvStop is 0)*/
+
+         store_mask8_retUL(
+            indexUL,
+            cmpgt_vectI8_retMask8(zeroVI, validVI)
+         );
+
+         if(indexUL == 0) continue; /*No pairs have cell*/
+
+         store_vectI8_retAryI8(tmpAryI, snpVI);
+
+         batchScatterDir(
+            tmpAryI,
+            pairAryUL,
+            numPairsUL,
+            lenQryAryUL,
+            lenRefAryUL,
+            ulQry,
+            ulRef,
+            retAryST
+         );
+      } /*Loop: score each reference base*/
+
+      /**************************************************\
+      * Fun-01 Sec-04 Sub-05:
+      *  - Find the ends of the Watermans
+      \**************************************************/
+
+      if(! needleBl)
+      { /*If: this is a Waterman*/
+         store_mask8_retUL(
+            indexUL,
+            cmpgt_vectI8_retMask8(zeroVI, betterVI)
+         );
+
+         if(indexUL == 0) continue; /*No better scores*/
+
+         store_vectI8_retAryI8(tmpAryI, bestVI);
+         store_vectI8_retAryI8(rowOkAryI, betterVI);
+
+         for(ulElm = 0; ulElm < numPairsUL; ++ulElm)
+         { /*Loop: find the first best score in the row*/
+            if(! rowOkAryI[ulElm]) continue;
+
+            bestAryL[ulElm] = tmpAryI[ulElm];
+
+            for(
+               ulRef = 1;
+               ulRef <= lenRefAryUL[ulElm];
+               ++ulRef
+            ){ /*Loop: find the first best score*/
+               if(
+                     scoreAryI[ulRef*defNum8BitElms+ulElm]
+                  == tmpAryI[ulElm]
+               ) break;
+            } /*Loop: find the first best score*/
+
+            endAryUL[ulElm] =
+                 ulQry * (lenRefAryUL[ulElm] + 1)
+               + ulRef;
+         } /*Loop: find the first best score in the row*/
+
+         continue;
+      } /*If: this is a Waterman*/
+
+      /**************************************************\
+      * Fun-01 Sec-04 Sub-06:
+      *  - Get the scores of Needlemans ending on this row
+      \**************************************************/
+
+      for(ulElm = 0; ulElm < numPairsUL; ++ulElm)
+      { /*Loop: check if any pairs ended*/
+         if(ulQry != lenQryAryUL[ulElm]) continue;
+
+         bestAryL[ulElm] =
+            scoreAryI[
+                 lenRefAryUL[ulElm] * defNum8BitElms
+               + ulElm
+            ];
+
+         endAryUL[ulElm] =
+              ulQry * (lenRefAryUL[ulElm] + 1)
+            + lenRefAryUL[ulElm];
+      } /*Loop: check if any pairs ended*/
+   } /*Loop: score each query base*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-01 Sec-05:
+   ^  - Copy the results and clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   store_vectI8_retAryI8(tmpAryI, overflowVI);
+
+   for(ulElm = 0; ulElm < numPairsUL; ++ulElm)
+   { /*Loop: copy the scores*/
+      overflowAryC[ulElm] = (tmpAryI[ulElm] != 0);
+      if(overflowAryC[ulElm]) continue;
+
+      matrixST = &retAryST[pairAryUL[ulElm]];
+      matrixST->bestScoreL = bestAryL[ulElm];
+      matrixST->bestStartIndexUL = 0;
+      matrixST->bestEndIndexUL = endAryUL[ulElm];
+      matrixST->scoreBitsC = 8;
+   } /*Loop: copy the scores*/
+
+   freeVectMemBlockBuff(&memST);
+   return 0;
+} /*batchAlnI8*/
+
+#endif /*DEFNOVECT*/
+#endif
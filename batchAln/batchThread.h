@@ -0,0 +1,510 @@
+/*########################################################
+# Name batchThread
+# Use:
+#  o Holds functions to align many query/reference pairs
+#    with a thread pool (-batch with -threads). Each pair
+#    is one task, so threads that finish their pairs
+#    steal pairs from busy threads.
+#  o Each pair is aligned with the scalar aligners
+#    (NeedlemanAln, WatermanAln, memWater, or Hirschberg).
+#    The alignment (traceback) is also found in the task,
+#    so the direction matrix is freed before the next
+#    pair is started.
+#  o Each thread has its own copy of the settings, so the
+#    score profile rows (setScoreProf) are not shared.
+#  o Each thread has its own arena (alnScratch) for the
+#    score and direction rows, so the rows are reused from
+#    pair to pair instead of being malloced for each pair.
+#  o Pairs can be started from the largest (query length
+#    * reference length) to the smallest, so a long pair
+#    is not left for the end.
+# Libraries:
+#   - "batchAln.h"                     (No .c file)
+#   - "../hirschberg/hirschberg.h"     (No .c file)
+#   - "../hirschberg/hirschbergNoGap.h"(No .c file)
+#   - "../general/threadPool.h"        (No .c file)
+#   o "../general/alnStruct.h"         (No .c file)
+#   o "../general/alnMatrixStruct.h"   (No .c file)
+#   o "../general/dataTypeShortHand.h" (No .c file)
+#   o "../general/alnSetStruct.h"      (No .c file)
+#   o "../general/seqStruct.h"         (No .c file)
+#   o "../general/alnScratch.h"        (No .c file)
+# C Standard libraries:
+#   o <stdlib.h>
+#   o <stdio.h>
+#   o <pthread.h> (POSIX, not C standard)
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+' o header:
+'   - Includes and structures
+' o fun-01 batchThreadPair:
+'   - Aligns one pair (pool task)
+' o macro-02 batchPairCells:
+'   - Gets the number of cells (query length *
+'     reference length) in a pair
+' o fun-03 batchThreadSort:
+'   - Sorts pair indexes by size (largest first)
+' o fun-04 initBatchThread:
+'   - Starts the thread pool and copies the settings for
+'     each thread
+' o fun-05 batchThreadAln:
+'   - Aligns an array of pairs with the thread pool. This
+'     is the function to call.
+' o macro-06 freeBatchPair:
+'   - Frees the alignment and matrix in a batchPair
+' o fun-07 freeBatchThread:
+'   - Stops the thread pool and frees the settings copies
+'     and arenas
+' o macro-08 batchThreadNewRef:
+'   - Frees the score profile rows in each settings copy
+'     (call when a reference is read in)
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes and structures
+\-------------------------------------------------------*/
+
+#ifndef BATCH_THREAD_H
+#define BATCH_THREAD_H
+
+#include "batchAln.h"
+#include "../hirschberg/hirschberg.h"
+#include "../hirschberg/hirschbergNoGap.h"
+#include "../general/threadPool.h"
+
+/*-------------------------------------------------------\
+| Struct-01: batchThread
+|  - Thread pool and settings shared by all pairs
+\-------------------------------------------------------*/
+struct batchThread{
+   struct threadPool poolST; /*Threads to align with*/
+   struct alnSet *setAryST;  /*Settings for each thread*/
+   struct alnScratch *scratchAryST; /*Arena per thread*/
+   int numSetI;              /*Number of settings copies*/
+
+   char needleBl; /*1: Needleman; 0: Waterman/memWater*/
+   char dirBl;    /*1: find the alignment; 0: scores*/
+   char hirschBl; /*1: Hirschberg (always an alignment)*/
+   char longFirstBl; /*1: start the largest pairs first*/
+};
+
+/*-------------------------------------------------------\
+| Struct-02: batchPair
+|  - One query/reference pair (task) and its result
+\-------------------------------------------------------*/
+struct batchPair{
+   struct seqStruct *qryST;  /*Query to align*/
+   struct seqStruct *refST;  /*Reference to align to*/
+   struct batchThread *threadST; /*Pool and settings*/
+
+   struct alnMatrix matrixST;
+     /*Score, start/end indexes, and scoreBitsC. The
+     ` direction matrix is always freed.
+     */
+   struct alnStruct *alnST;  /*Alignment (dirBl/hirschBl)*/
+   char errC;                /*64 for memory errors*/
+
+   struct poolTask taskST;   /*Task for the thread pool*/
+};
+
+/*-------------------------------------------------------\
+| Fun-01: batchThreadPair
+|  - Aligns one pair. This is a thread pool task.
+| Input:
+|  - pairPtr:
+|    o Pointer to a batchPair structure with the pair to
+|      align
+| Output:
+|  - Modifies:
+|    o matrixST in pairPtr to have the score and start/end
+|      indexes (not for Hirschberg)
+|    o alnST in pairPtr to have the alignment (dirBl or
+|      hirschBl is 1)
+|    o errC in pairPtr to be 64 for memory errors
+\-------------------------------------------------------*/
+static void batchThreadPair(
+   void *pairPtr
+){
+   struct batchPair *pairST = (struct batchPair *)pairPtr;
+   struct batchThread *threadST = pairST->threadST;
+   int threadI = poolThreadIndex(&threadST->poolST);
+
+   /*Each thread has its own score profile rows & arena*/
+   struct alnSet *settings = &threadST->setAryST[threadI];
+   struct alnScratch *scratchST =
+      &threadST->scratchAryST[threadI];
+
+   if(threadST->hirschBl)
+   { /*If: doing a Hirschberg alignment*/
+      if(settings->noGapBl)
+         pairST->alnST =
+            HirschbergNoGap(
+               pairST->refST,
+               pairST->qryST,
+               settings
+            );
+      else
+         pairST->alnST =
+            HirschbergScratch(
+               pairST->refST,
+               pairST->qryST,
+               settings,
+               scratchST
+            );
+
+      if(pairST->alnST == 0) pairST->errC = 64;
+      return;
+   } /*If: doing a Hirschberg alignment*/
+
+   if(
+      batchAlnScalar(
+         pairST->qryST,
+         pairST->refST,
+         threadST->needleBl,
+         threadST->dirBl,
+         settings,
+         scratchST,
+         &pairST->matrixST
+      )
+   ){ /*If: I had a memory error*/
+      pairST->errC = 64;
+      return;
+   } /*If: I had a memory error*/
+
+   if(! threadST->dirBl) return;
+
+   pairST->alnST =
+      dirMatrixToAln(
+         pairST->refST,
+         pairST->qryST,
+         pairST->matrixST.bestEndIndexUL,
+         settings,
+         &pairST->matrixST
+      );
+
+   free(pairST->matrixST.dirMatrix);
+   pairST->matrixST.dirMatrix = 0;
+
+   if(pairST->alnST == 0) pairST->errC = 64;
+} /*batchThreadPair*/
+
+/*-------------------------------------------------------\
+| Macro-02: batchPairCells
+|  - Gets the number of cells (query length * reference
+|    length) in a pair
+| Input:
+|  - pairSTPtr:
+|    o Pointer to batchPair with the pair
+| Output:
+|  - Returns:
+|    o The number of cells as a double (can be over the
+|      size of a ulong)
+\-------------------------------------------------------*/
+#define batchPairCells(pairSTPtr)(\
+     (double)\
+        (  (pairSTPtr)->qryST->endAlnUL\
+         - (pairSTPtr)->qryST->offsetUL\
+         + 1\
+        )\
+   * (double)\
+        (  (pairSTPtr)->refST->endAlnUL\
+         - (pairSTPtr)->refST->offsetUL\
+         + 1\
+        )\
+) /*batchPairCells*/
+
+/*-------------------------------------------------------\
+| Fun-03: batchThreadSort
+|  - Sorts pair indexes by the number of cells (query
+|    length * reference length), largest first
+|  - Shell sort taken from:
+|    - Adam Drozdek. 2013. Data Structures and
+|      Algorithims in c++. Cengage Leraning. fourth
+|      edition. pages 505-508
+| Input:
+|  - pairAryST:
+|    o Array of batchPair structures with the pairs
+|  - indexAryUL:
+|    o Array of indexes (into pairAryST) to sort
+|  - numPairsUL:
+|    o Number of indexes in indexAryUL
+| Output:
+|  - Modifies:
+|    o indexAryUL to be sorted by pair size
+\-------------------------------------------------------*/
+static void batchThreadSort(
+   struct batchPair *pairAryST,
+   ulong *indexAryUL,
+   ulong numPairsUL
+){
+   ulong subUL = 1;
+   ulong ulIndex = 0;
+   ulong ulElm = 0;
+   ulong keyUL = 0;
+   double keyDbl = 0;
+
+   /*Recursion formula: h[0] = 1, h[n] = 3 * h[n - 1] +1*/
+   while(subUL < numPairsUL) subUL = (3 * subUL) + 1;
+   subUL = (subUL - 1) / 3;
+
+   while(subUL > 0)
+   { /*Loop: sort each sub array*/
+      for(ulIndex = subUL; ulIndex < numPairsUL; ++ulIndex)
+      { /*Loop: insert each element into its sub array*/
+         keyUL = indexAryUL[ulIndex];
+         keyDbl = batchPairCells(&pairAryST[keyUL]);
+
+         for(
+            ulElm = ulIndex;
+               ulElm >= subUL
+            &&    batchPairCells(
+                     &pairAryST[indexAryUL[ulElm - subUL]]
+                  )
+               < keyDbl;
+            ulElm -= subUL
+         ) indexAryUL[ulElm] = indexAryUL[ulElm - subUL];
+
+         indexAryUL[ulElm] = keyUL;
+      } /*Loop: insert each element into its sub array*/
+
+      subUL = (subUL - 1) / 3;
+   } /*Loop: sort each sub array*/
+} /*batchThreadSort*/
+
+/*-------------------------------------------------------\
+| Fun-04: initBatchThread
+|  - Starts the thread pool and copies the settings for
+|    each thread
+| Input:
+|  - threadST:
+|    o Pointer to batchThread structure to set up
+|  - needleBl:
+|    o 1: Do Needleman alignments
+|    o 0: Do Waterman alignments
+|  - dirBl:
+|    o 1: Find the alignment for each pair
+|    o 0: Only find the scores and start/end indexes
+|  - hirschBl:
+|    o 1: Do Hirschberg alignments (needleBl and dirBl
+|         are ignored)
+|  - settings:
+|    o alnSet structure with the alignment settings.
+|      threadsUS is the number of threads and longFirstBl
+|      is used to order the pairs.
+| Output:
+|  - Modifies:
+|    o threadST to have a running pool, a copy of settings
+|      (without the score profile rows), and an empty
+|      arena for each thread
+|  - Returns:
+|    o 0 for no errors
+|    o 64 for memory errors
+\-------------------------------------------------------*/
+static char initBatchThread(
+   struct batchThread *threadST,
+   char needleBl,
+   char dirBl,
+   char hirschBl,
+   struct alnSet *settings
+){
+   int iSet = 0;
+
+   threadST->numSetI = settings->threadsUS;
+   if(threadST->numSetI < 1) threadST->numSetI = 1;
+   if(threadST->numSetI > defMaxThreads)
+      threadST->numSetI = defMaxThreads;
+
+   threadST->needleBl = needleBl;
+   threadST->dirBl = dirBl;
+   threadST->hirschBl = hirschBl;
+   threadST->longFirstBl = settings->longFirstBl;
+
+   threadST->setAryST =
+      malloc(threadST->numSetI * sizeof(struct alnSet));
+
+   if(threadST->setAryST == 0) return 64;
+
+   threadST->scratchAryST =
+      malloc(threadST->numSetI * sizeof(struct alnScratch));
+
+   if(threadST->scratchAryST == 0)
+   { /*If: I had a memory error*/
+      free(threadST->setAryST);
+      threadST->setAryST = 0;
+      return 64;
+   } /*If: I had a memory error*/
+
+   for(iSet = 0; iSet < threadST->numSetI; ++iSet)
+   { /*Loop: copy the settings for each thread*/
+      threadST->setAryST[iSet] = *settings;
+      initScoreProf(&threadST->setAryST[iSet].profST);
+      threadST->setAryST[iSet].threadsUS = 1;
+      initAlnScratch(&threadST->scratchAryST[iSet]);
+   } /*Loop: copy the settings for each thread*/
+
+   if(initThreadPool(&threadST->poolST, threadST->numSetI))
+   { /*If: I could not start the pool*/
+      free(threadST->setAryST);
+      threadST->setAryST = 0;
+
+      free(threadST->scratchAryST);
+      threadST->scratchAryST = 0;
+      return 64;
+   } /*If: I could not start the pool*/
+
+   return 0;
+} /*initBatchThread*/
+
+/*-------------------------------------------------------\
+| Fun-05: batchThreadAln
+|  - Aligns an array of pairs with the thread pool
+| Input:
+|  - pairAryST:
+|    o Array of batchPair structures with the pairs to
+|      align. qryST, refST, and threadST need to be set.
+|      The sequences need to be converted with
+|      seqToLookupIndex and offsetUL/endAlnUL need to be
+|      set (index 0). The same reference can be used for
+|      many pairs.
+|  - numPairsUL:
+|    o Number of pairs in pairAryST
+|  - indexAryUL:
+|    o Array of numPairsUL ulongs to hold the order the
+|      pairs are started in
+| Output:
+|  - Modifies:
+|    o Each pair in pairAryST to have its result (see
+|      batchThreadPair). Free with freeBatchPair.
+|  - Returns:
+|    o 0 for no errors
+|    o 64 for memory errors
+\-------------------------------------------------------*/
+static char batchThreadAln(
+   struct batchPair *pairAryST,
+   ulong numPairsUL,
+   ulong *indexAryUL
+){
+   struct threadPool *poolST = 0;
+   ulong ulPair = 0;
+   char errC = 0;
+
+   if(numPairsUL == 0) return 0;
+   poolST = &pairAryST[0].threadST->poolST;
+
+   for(ulPair = 0; ulPair < numPairsUL; ++ulPair)
+   { /*Loop: blank the results*/
+      initAlnMatrix(&pairAryST[ulPair].matrixST);
+      pairAryST[ulPair].alnST = 0;
+      pairAryST[ulPair].errC = 0;
+      indexAryUL[ulPair] = ulPair;
+   } /*Loop: blank the results*/
+
+   if(pairAryST[0].threadST->longFirstBl)
+      batchThreadSort(pairAryST, indexAryUL, numPairsUL);
+
+   for(ulPair = 0; ulPair < numPairsUL; ++ulPair)
+      spreadPoolTask(
+         poolST,
+         &pairAryST[indexAryUL[ulPair]].taskST,
+         batchThreadPair,
+         &pairAryST[indexAryUL[ulPair]]
+      );
+
+   for(ulPair = 0; ulPair < numPairsUL; ++ulPair)
+   { /*Loop: wait for each pair to finish*/
+      waitPoolTask(poolST, &pairAryST[ulPair].taskST);
+      errC |= pairAryST[ulPair].errC;
+   } /*Loop: wait for each pair to finish*/
+
+   return errC;
+} /*batchThreadAln*/
+
+/*-------------------------------------------------------\
+| Macro-06: freeBatchPair
+|  - Frees the alignment and matrix in a batchPair
+| Input:
+|  - pairSTPtr:
+|    o Pointer to batchPair to free the results in
+| Output:
+|  - Frees:
+|    o alnST and the arrays in matrixST (pairSTPtr is not
+|      freed)
+\-------------------------------------------------------*/
+#define freeBatchPair(pairSTPtr){\
+   freeAlnMatrixStack(&(pairSTPtr)->matrixST);\
+   \
+   if((pairSTPtr)->alnST != 0)\
+   { /*If: I have an alignment to free*/\
+      freeAlnSTStack((pairSTPtr)->alnST);\
+      free((pairSTPtr)->alnST);\
+      (pairSTPtr)->alnST = 0;\
+   } /*If: I have an alignment to free*/\
+} /*freeBatchPair*/
+
+/*-------------------------------------------------------\
+| Fun-07: freeBatchThread
+|  - Stops the thread pool and frees the settings copies
+|    and arenas
+| Input:
+|  - threadST:
+|    o Pointer to batchThread structure to free
+| Output:
+|  - Frees:
+|    o The pool, the settings copies (with their score
+|      profile rows), and the arenas in threadST
+|      (threadST is not freed)
+\-------------------------------------------------------*/
+static void freeBatchThread(
+   struct batchThread *threadST
+){
+   int iSet = 0;
+
+   if(threadST->setAryST == 0) return; /*Not set up*/
+
+   freeThreadPool(&threadST->poolST);
+
+   for(iSet = 0; iSet < threadST->numSetI; ++iSet)
+   { /*Loop: free each threads memory*/
+      freeScoreProfStack(&threadST->setAryST[iSet].profST);
+      freeAlnScratchStack(&threadST->scratchAryST[iSet]);
+   } /*Loop: free each threads memory*/
+
+   free(threadST->setAryST);
+   threadST->setAryST = 0;
+
+   free(threadST->scratchAryST);
+   threadST->scratchAryST = 0;
+} /*freeBatchThread*/
+
+/*-------------------------------------------------------\
+| Macro-08: batchThreadNewRef
+|  - Frees the score profile rows in each settings copy.
+|    Call this when a reference is read into a buffer
+|    that may have had an old reference (no pairs can be
+|    running).
+| Input:
+|  - threadSTPtr:
+|    o Pointer to batchThread with the settings copies
+| Output:
+|  - Frees:
+|    o The score profile rows in each settings copy
+\-------------------------------------------------------*/
+#define batchThreadNewRef(threadSTPtr){\
+   int macroSetI = 0;\
+   \
+   if((threadSTPtr)->setAryST != 0)\
+   { /*If: the settings have been copied*/\
+      for(\
+         macroSetI = 0;\
+         macroSetI < (threadSTPtr)->numSetI;\
+         ++macroSetI\
+      ) freeScoreProfStack(\
+           &(threadSTPtr)->setAryST[macroSetI].profST\
+        );\
+   } /*If: the settings have been copied*/\
+} /*batchThreadNewRef*/
+
+#endif
@@ -0,0 +1,253 @@
+/*########################################################
+# Name genBatchAln
+# Use:
+#  o Holds macros shared by the batchAln vector kernels
+#    (8, 16, and 32 bit)
+# Libraries:
+#   o "../general/seqStruct.h"         (No .c file)
+#   o "../general/alnMatrixStruct.h"   (No .c file)
+#   o "../general/dataTypeShortHand.h" (No .c file)
+#   o "../vectWrap/vectWrap.h"         (No .c file)
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+' o macro-01 batchMaxLen:
+'   - Finds the longest sequence in a group of pairs
+' o macro-02 batchInterleave:
+'   - Copies the sequences in a group of pairs into one
+'     interleaved array (one pair per vector element)
+' o macro-03 batchPickI8:
+'   - Picks between two vectI8s with a mask
+' o macro-04 batchPickI16:
+'   - Picks between two vectI16s with a mask
+' o macro-05 batchScatterDir:
+'   - Copies a row of directions (one per vector element)
+'     into each pairs direction matrix
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#ifndef GEN_BATCH_ALN_H
+#define GEN_BATCH_ALN_H
+
+#include "../general/seqStruct.h"
+#include "../general/alnMatrixStruct.h"
+#include "../general/dataTypeShortHand.h"
+#include "../vectWrap/vectWrap.h"
+
+/*-------------------------------------------------------\
+| Macro-01: batchMaxLen
+|   - Finds the longest sequence in a group of pairs
+| Input:
+|   - seqAryST:
+|     o Array of pointers to seqStructs (query or
+|       reference) with offsetUL and endAlnUL set
+|   - pairAryUL:
+|     o Index of each pair in seqAryST to check
+|   - numPairsUL:
+|     o Number of pairs in pairAryUL
+|   - lenMaxUL:
+|     o ulong to hold the longest length
+| Output:
+|   - Modifies:
+|     o lenMaxUL to be the longest sequence
+\-------------------------------------------------------*/
+#define batchMaxLen(seqAryST,pairAryUL,numPairsUL,lenMaxUL){\
+   ulong macroPairUL = 0;\
+   struct seqStruct *macroSeqST = 0;\
+   \
+   (lenMaxUL) = 0;\
+   \
+   for(\
+      macroPairUL = 0;\
+      macroPairUL < (numPairsUL);\
+      ++macroPairUL\
+   ){ /*Loop: find the longest sequence*/\
+      macroSeqST = (seqAryST)[(pairAryUL)[macroPairUL]];\
+      \
+      if(\
+           macroSeqST->endAlnUL - macroSeqST->offsetUL + 1\
+         > (lenMaxUL)\
+      ) (lenMaxUL) =\
+           macroSeqST->endAlnUL - macroSeqST->offsetUL + 1;\
+   } /*Loop: find the longest sequence*/\
+} /*batchMaxLen*/
+
+/*-------------------------------------------------------\
+| Macro-02: batchInterleave
+|   - Copies the sequences in a group of pairs into one
+|     interleaved array. Base b of element (lane) e is at
+|     b * numElmsUL + e. Empty lanes and bases past the
+|     end of a sequence are set to 0.
+| Input:
+|   - seqAryST:
+|     o Array of pointers to seqStructs (query or
+|       reference) with offsetUL and endAlnUL set
+|   - pairAryUL:
+|     o Index of each pair in seqAryST to copy
+|   - numPairsUL:
+|     o Number of pairs in pairAryUL
+|   - numElmsUL:
+|     o Number of elements in a vector
+|   - lenMaxUL:
+|     o Longest sequence (from batchMaxLen)
+|   - seqAryC:
+|     o Array of lenMaxUL * numElmsUL characters to hold
+|       the interleaved sequences
+|   - lenAryUL:
+|     o Array of numElmsUL ulongs to hold the length of
+|       each sequence (0 for empty lanes)
+| Output:
+|   - Modifies:
+|     o seqAryC to have the interleaved sequences
+|     o lenAryUL to have the length of each sequence
+\-------------------------------------------------------*/
+#define batchInterleave(\
+   seqAryST,\
+   pairAryUL,\
+   numPairsUL,\
+   numElmsUL,\
+   lenMaxUL,\
+   seqAryC,\
+   lenAryUL\
+){\
+   ulong macroElmUL = 0;\
+   ulong macroBaseUL = 0;\
+   struct seqStruct *macroSeqST = 0;\
+   \
+   for(\
+      macroElmUL = 0;\
+      macroElmUL < (numElmsUL);\
+      ++macroElmUL\
+   ){ /*Loop: interleave each sequence*/\
+      (lenAryUL)[macroElmUL] = 0;\
+      \
+      if(macroElmUL < (numPairsUL))\
+      { /*If: this lane has a pair*/\
+         macroSeqST =\
+            (seqAryST)[(pairAryUL)[macroElmUL]];\
+         \
+         (lenAryUL)[macroElmUL] =\
+              macroSeqST->endAlnUL\
+            - macroSeqST->offsetUL\
+            + 1;\
+      } /*If: this lane has a pair*/\
+      \
+      for(\
+         macroBaseUL = 0;\
+         macroBaseUL < (lenMaxUL);\
+         ++macroBaseUL\
+      ){ /*Loop: copy the sequence*/\
+         if(macroBaseUL < (lenAryUL)[macroElmUL])\
+            (seqAryC)[\
+               macroBaseUL * (numElmsUL) + macroElmUL\
+            ] = macroSeqST->seqCStr[\
+                  macroSeqST->offsetUL + macroBaseUL\
+                ];\
+         \
+         else\
+            (seqAryC)[\
+               macroBaseUL * (numElmsUL) + macroElmUL\
+            ] = 0;\
+      } /*Loop: copy the sequence*/\
+   } /*Loop: interleave each sequence*/\
+} /*batchInterleave*/
+
+/*-------------------------------------------------------\
+| Macro-03: batchPickI8
+|   - Picks between two vectI8s with a mask
+| Input:
+|   - maskVI:
+|     o vectI8 with -1 for elements to take from keepVI
+|       and 0 for elements to take from elseVI
+|   - keepVI:
+|     o vectI8 to take elements from when maskVI is -1
+|   - elseVI:
+|     o vectI8 to take elements from when maskVI is 0
+| Output:
+|   - Returns:
+|     o vectI8 with the picked elements
+\-------------------------------------------------------*/
+#define batchPickI8(maskVI, keepVI, elseVI)(\
+   or_vectI8_retVectI8(\
+      and_vectI8_retVectI8((maskVI), (keepVI)),\
+      andNot_vectI8_retVectI8((maskVI), (elseVI))\
+   )\
+) /*batchPickI8*/
+
+/*-------------------------------------------------------\
+| Macro-04: batchPickI16
+|   - Picks between two vectI16s with a mask
+| Input:
+|   - maskVI:
+|     o vectI16 with -1 for elements to take from keepVI
+|       and 0 for elements to take from elseVI
+|   - keepVI:
+|     o vectI16 to take elements from when maskVI is -1
+|   - elseVI:
+|     o vectI16 to take elements from when maskVI is 0
+| Output:
+|   - Returns:
+|     o vectI16 with the picked elements
+\-------------------------------------------------------*/
+#define batchPickI16(maskVI, keepVI, elseVI)(\
+   or_vectI16_retVectI16(\
+      and_vectI16_retVectI16((maskVI), (keepVI)),\
+      andNot_vectI16_retVectI16((maskVI), (elseVI))\
+   )\
+) /*batchPickI16*/
+
+/*-------------------------------------------------------\
+| Macro-05: batchScatterDir
+|   - Copies the directions for one cell (one direction
+|     per pair) into each pairs direction matrix
+| Input:
+|   - dirAry:
+|     o Array with the direction of each pair (lane)
+|   - pairAryUL:
+|     o Index of each pair in retAryST
+|   - numPairsUL:
+|     o Number of pairs in pairAryUL
+|   - lenQryAryUL:
+|     o Array with the query length of each pair
+|   - lenRefAryUL:
+|     o Array with the reference length of each pair
+|   - qryUL:
+|     o Row (query base) of the cell
+|   - refUL:
+|     o Column (reference base) of the cell
+|   - retAryST:
+|     o Array of alnMatrix structures with the direction
+|       matrixes
+| Output:
+|   - Modifies:
+|     o The direction matrix of each pair that has the
+|       cell
+\-------------------------------------------------------*/
+#define batchScatterDir(\
+   dirAry,\
+   pairAryUL,\
+   numPairsUL,\
+   lenQryAryUL,\
+   lenRefAryUL,\
+   qryUL,\
+   refUL,\
+   retAryST\
+){\
+   ulong macroPairUL = 0;\
+   \
+   for(\
+      macroPairUL = 0;\
+      macroPairUL < (numPairsUL);\
+      ++macroPairUL\
+   ){ /*Loop: copy directions to the pairs matrixes*/\
+      if((refUL) > (lenRefAryUL)[macroPairUL]) continue;\
+      if((qryUL) > (lenQryAryUL)[macroPairUL]) continue;\
+      \
+      (retAryST)[(pairAryUL)[macroPairUL]].dirMatrix[\
+           (qryUL) * ((lenRefAryUL)[macroPairUL] + 1)\
+         + (refUL)\
+      ] = (char) (dirAry)[macroPairUL];\
+   } /*Loop: copy directions to the pairs matrixes*/\
+} /*batchScatterDir*/
+
+#endif
@@ -36,6 +36,9 @@
 '      an matrix.
 '  o fun-09 indexToCoord:
 '    - Gets the coordinates of the reference and query
+'  o fun-10 coordToBandIndex:
+'    - Gets the index of a reference and query coordinate
+'      in a banded matrix
 \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 #ifndef ALNMATRIXSTRUCT_H
@@ -67,6 +70,13 @@ typedef struct alnMatrix
   long *scoreAryL;
   ulong *startIndexAryUL;
   ulong *endIndexAryUL;
+
+  char scoreBitsC; /*Bits per vector score; 0 for scalar*/
+
+  ulong lenBandUL; /*Cells per banded row; 0 if not banded*/
+  long bandStartL; /*Diagonal (ref - query) of 1st cell*/
+
+  ulong cellsScoredUL; /*Cells scored; 0 if not counted*/
 }alnMatrixStruct;
 
 /*-------------------------------------------------------\
@@ -93,6 +103,13 @@ typedef struct alnMatrixTwoBit
   long *scoreAryL;
   ulong *startIndexAryUL;
   ulong *endIndexAryUL;
+
+  char scoreBitsC; /*Bits per vector score; 0 for scalar*/
+
+  ulong lenBandUL; /*Cells per banded row; 0 if not banded*/
+  long bandStartL; /*Diagonal (ref - query) of 1st cell*/
+
+  ulong cellsScoredUL; /*Cells scored; 0 if not counted*/
 }alnMatrixStructTwoBit;
 
 /*-------------------------------------------------------\
@@ -122,6 +139,10 @@ typedef struct alnMatrixTwoBit
    (matrixSTPtr)->scoreAryL = 0;\
    (matrixSTPtr)->startIndexAryUL = 0;\
    (matrixSTPtr)->endIndexAryUL = 0;\
+   (matrixSTPtr)->scoreBitsC = 0;\
+   (matrixSTPtr)->lenBandUL = 0;\
+   (matrixSTPtr)->bandStartL = 0;\
+   (matrixSTPtr)->cellsScoredUL = 0;\
 } /*initAlnMatrixST*/
 
 /*-------------------------------------------------------\
@@ -151,6 +172,10 @@ typedef struct alnMatrixTwoBit
    (matrixSTPtr)->scoreAryL = 0;\
    (matrixSTPtr)->startIndexAryUL = 0;\
    (matrixSTPtr)->endIndexAryUL = 0;\
+   (matrixSTPtr)->scoreBitsC = 0;\
+   (matrixSTPtr)->lenBandUL = 0;\
+   (matrixSTPtr)->bandStartL = 0;\
+   (matrixSTPtr)->cellsScoredUL = 0;\
 } /*initAlnMatrixST*/
 
 /*-------------------------------------------------------\
@@ -312,7 +337,7 @@ typedef struct alnMatrixTwoBit
 |    o The query coordinate that was in the index
 \-------------------------------------------------------*/
 #define indexToQry(refLen, index)(\
-   ((index) / ((refLen) + 1)) - ((index) >= (refLen))\
+   ((index) / ((refLen) + 1)) - ((index) > (refLen))\
    /* Find query coordinates from an index:
    `  - refLen + 1:
    `    o gives the length of each row in the matrix
@@ -320,8 +345,8 @@ typedef struct alnMatrixTwoBit
    `  - index / (refLen + 1)
    `    o The number of rows down, which is the number of
    `      query bases + the gap row
-   `  - index >= refLen
-   `    o Is 1 if the index is divisible by the reference
+   `  - index > refLen
+   `    o Is 1 if the index is past the gap row
    `      This means I have an index 1 value
    `    o else index is in the gap row (index 0)
    `  - position - (index 1 or 0)
@@ -347,7 +372,9 @@ typedef struct alnMatrixTwoBit
 \-------------------------------------------------------*/
 #define indexToRef(refLen, index)(\
      ((index) % ((refLen) + 1))\
-   - (((index) / ((refLen) + 1)) > 0)\
+   - (   (((index) / ((refLen) + 1)) > 0)\
+      && (((index) % ((refLen) + 1)) > 0)\
+     )\
    /* Find reference coordinates from an index:
    `  - refLen + 1:
    `    o gives the length of each row in the matrix
@@ -357,9 +384,10 @@ typedef struct alnMatrixTwoBit
    `      reference bases + the gap row
    `  - index / (refLen + 1)
    `    o Gets the query position
-   `  - (index / (refLen + 1)) > 0
-   `    o Is 0 if I am in the gap column, 1 if on a real
-   `      reference base
+   `  - (index / (refLen + 1)) > 0 && (index % ...) > 0
+   `    o Is 0 if I am in the gap row or gap column, 1 if
+   `      on a real reference base. This keeps starts in
+   `      the gap column from going negative
    `  - position - (index 1 or 0)
    `    o Removes the gap column from the reference if it
    `      is present. This makes sure I get an index 0
@@ -390,5 +418,43 @@ typedef struct alnMatrixTwoBit
    (qryCoord) = indexToQry((refLen), (index));\
 } /*indexToCoord*/
 
+/*-------------------------------------------------------\
+| Fun-10: coordToBandIndex
+|   - Gets the index of a reference and query coordinate
+|     in a banded matrix (see banded/bandAln.h). Each row
+|     of a banded matrix holds lenBandUL cells, with the
+|     first cell on the bandStartL (ref - query) diagonal.
+| Input
+|   - refCoord:
+|     o Reference coordinate (index 0)
+|   - qryCoord:
+|     o Query coordinate (index 0)
+|   - lenBand:
+|     o Number of cells in each row (lenBandUL)
+|   - bandStart:
+|     o Diagonal of the first cell in a row (bandStartL)
+| Output:
+|  - Returns
+|    o The index of the cell in the banded matrix
+\-------------------------------------------------------*/
+#define coordToBandIndex(\
+   refCoord,\
+   qryCoord,\
+   lenBand,\
+   bandStart\
+)(\
+     ((ulong) (qryCoord) + 1) * (lenBand)\
+   + (ulong) (\
+          (long) (refCoord)\
+        - (long) (qryCoord)\
+        - (bandStart)\
+     )\
+   /* The + 1 on the query skips the gap row. The
+   `  diagonal (ref - query) is the same in the full and
+   `  banded matrix, so the diagonal - bandStart is the
+   `  column in the banded row.
+   */\
+) /*coordToBandIndex*/
+
 
 #endif
@@ -0,0 +1,764 @@
+/*########################################################
+# Name: alnRef
+# Use:
+#  - Builds and reads reference cache files (.alnref) made
+#    with "alnSeq index". These hold every entry in a
+#    fasta/fastq file already converted to lookup indexes
+#    and packed into two bits per base (seqPack.h), so the
+#    reference is loaded without reading the fasta file.
+#    o The cache is mapped (mmap) and only the entry (or
+#      region) that is aligned to is unpacked. Nothing is
+#      parsed.
+#    o The file is: a header, then the id, packed bases,
+#      and runs of not packed bases of each entry, then a
+#      table with the offsets of each entry.
+#    o Values are unsigned longs in the order of the cpu
+#      that made the cache. Caches from a different cpu
+#      or lookup index conversion (-DNOSEQCNVT or -DWORDS)
+#      are found by the header and rejected.
+#  - Compile with -DNOMMAP for systems without mmap. The
+#    cache is then read into memory with one fread.
+# Libraries:
+#  - "seqPack.h"
+#  - "faIndex.h"
+#  o "twoBitArrays.h"
+#  o "seqFile.h"
+#  o "seqStruct.h"
+#  o "seqVect.h"
+#  o "alnSetStruct.h"
+#  o "gzRead.h"
+#  o "inflate.h"
+#  o "alnSeqDefaults.h"
+#  o "base10StrToNum.h"
+#  o "dataTypeShortHand.h"
+# C Standard Libraries:
+#  o <stdlib.h>
+#  o <stdio.h>
+#  o <string.h>
+#  o <pthread.h> (POSIX, not C standard)
+#  o <sys/types.h> (POSIX, not C standard)
+#  o <sys/stat.h> (POSIX, not C standard)
+#  o <sys/mman.h> (POSIX, not C standard)
+#  o <fcntl.h> (POSIX, not C standard)
+#  o <unistd.h> (POSIX, not C standard)
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Includes, definitions, and structures
+'  o macro-01 initAlnRef:
+'    - Sets an alnRef structure to no cache
+'  o macro-02 freeAlnRefStack:
+'    - Unmaps (or frees) the cache in an alnRef structure
+'  o fun-03 alnRefPut:
+'    - Prints bytes to a cache file and pads them to the
+'      size of an unsigned long
+'  o fun-04 mkAlnRef:
+'    - Builds a cache (.alnref) from a fasta/fastq file
+'  o fun-05 mapAlnRef:
+'    - Maps a cache file and checks its header
+'  o fun-06 findAlnRef:
+'    - Finds an entry in a cache by its name
+'  o fun-07 readAlnRef:
+'    - Unpacks an entry (or region of an entry) from a
+'      cache, or points to the packed entry
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes, definitions, and structures
+\-------------------------------------------------------*/
+
+#ifndef ALNREF_H
+#define ALNREF_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "seqPack.h"
+#include "faIndex.h"
+
+#ifndef NOMMAP
+   #include <sys/types.h>
+   #include <sys/stat.h>
+   #include <sys/mman.h>
+   #include <fcntl.h>
+   #include <unistd.h>
+#endif
+
+/*First eight bytes of a cache file*/
+#define defAlnRefMagic "alnRef01"
+#define defAlnRefLenMagic 8
+
+/*Header (after the magic): check value, number of
+` entries, offset of the entry table, and file length.
+` The check value has the size of an unsigned long and
+` the lookup index of 'a', so caches from another cpu
+` or conversion are rejected.
+*/
+#define defAlnRefHeadUL 4
+#define defAlnRefCheck\
+   ( (sizeof(ulong) << 8)\
+   | (unsigned char) seqFileCnvt('a')\
+   )
+
+/*Entry table values (unsigned longs for each entry)*/
+#define defAlnRefRecUL 6
+#define defAlnRefIdOff 0    /*Offset of the id*/
+#define defAlnRefLenId 1    /*Length of id ('>' to '\n')*/
+#define defAlnRefLenSeq 2   /*Number of bases*/
+#define defAlnRefLimbOff 3  /*Offset of packed bases*/
+#define defAlnRefNumRuns 4  /*Runs of not packed bases*/
+#define defAlnRefRunOff 5   /*Offset of the runs*/
+
+/*-------------------------------------------------------\
+| Struct-01: alnRef
+|  - Holds a mapped cache file
+\-------------------------------------------------------*/
+struct alnRef{
+   char *mapStr;    /*Start of the map (the file)*/
+   ulong lenMapUL;  /*Bytes mapped*/
+   ulong numRecsUL; /*Number of entries in the cache*/
+   ulong *recAryUL; /*Entry table (in the map)*/
+};
+
+/*-------------------------------------------------------\
+| Macro-01: initAlnRef
+|  - Sets an alnRef structure to no cache
+| Input:
+|  - alnRefST:
+|    o Pointer to alnRef structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in alnRefST to 0
+\-------------------------------------------------------*/
+#define initAlnRef(alnRefST){\
+   (alnRefST)->mapStr = 0;\
+   (alnRefST)->lenMapUL = 0;\
+   (alnRefST)->numRecsUL = 0;\
+   (alnRefST)->recAryUL = 0;\
+} /*initAlnRef*/
+
+/*-------------------------------------------------------\
+| Macro-02: freeAlnRefStack
+|  - Unmaps (or frees for -DNOMMAP) the cache in an
+|    alnRef structure
+| Input:
+|  - alnRefST:
+|    o Pointer to alnRef structure with the cache
+| Output:
+|  - Frees:
+|    o The map in alnRefST (if there is one)
+|  - Modifies:
+|    o All values in alnRefST to 0
+\-------------------------------------------------------*/
+#ifdef NOMMAP
+   #define freeAlnRefStack(alnRefST){\
+      if((alnRefST)->mapStr != 0)\
+         free((alnRefST)->mapStr);\
+      \
+      initAlnRef((alnRefST));\
+   } /*freeAlnRefStack*/
+#else
+   #define freeAlnRefStack(alnRefST){\
+      if((alnRefST)->mapStr != 0)\
+         munmap((alnRefST)->mapStr,(alnRefST)->lenMapUL);\
+      \
+      initAlnRef((alnRefST));\
+   } /*freeAlnRefStack*/
+#endif
+
+/*-------------------------------------------------------\
+| Fun-03: alnRefPut
+|  - Prints bytes to a cache file and pads them with
+|    zeros to the size of an unsigned long, so the next
+|    values are aligned in the map
+| Input:
+|  - dataPtr:
+|    o Pointer to the bytes to print
+|  - lenUL:
+|    o Number of bytes to print
+|  - posULPtr:
+|    o Pointer to unsigned long with the offset of the
+|      end of the file
+|  - outFILE:
+|    o FILE to print the bytes to
+| Output:
+|  - Prints:
+|    o The bytes and padding to outFILE
+|  - Modifies:
+|    o posULPtr to be the new end of the file
+|  - Returns:
+|    o 0: for no errors
+|    o 8: if the bytes could not be printed
+\-------------------------------------------------------*/
+static unsigned char alnRefPut(
+   void *dataPtr,
+   ulong lenUL,
+   ulong *posULPtr,
+   FILE *outFILE
+){
+   ulong zeroUL = 0;
+   ulong padUL = 0;
+
+   if(lenUL > 0 && fwrite(dataPtr,1,lenUL,outFILE) != lenUL)
+      return 8;
+
+   *posULPtr += lenUL;
+   padUL = (sizeof(ulong) - (*posULPtr % sizeof(ulong)))
+         % sizeof(ulong);
+
+   if(padUL > 0 && fwrite(&zeroUL,1,padUL,outFILE) != padUL)
+      return 8;
+
+   *posULPtr += padUL;
+   return 0;
+} /*alnRefPut*/
+
+/*-------------------------------------------------------\
+| Fun-04: mkAlnRef
+|  - Builds a cache (.alnref) from a fasta/fastq file.
+|    Entries are read one at a time, so only the largest
+|    entry is in memory.
+| Input:
+|  - faFILE:
+|    o FILE with the fasta or fastq file (can be gzip
+|      compressed) to build the cache from
+|  - outFILE:
+|    o FILE to print the cache to. This needs to be a
+|      file (not stdout), since the header is printed
+|      last.
+| Output:
+|  - Prints:
+|    o The cache to outFILE
+|  - Returns:
+|    o 0: for no errors
+|    o 2: if faFILE has no entries or an invalid entry
+|    o 8: if the cache could not be printed
+|    o 64: If malloc failed to find memory
+\-------------------------------------------------------*/
+static unsigned char mkAlnRef(
+   FILE *faFILE,
+   FILE *outFILE
+){
+   struct seqFile faFileST;
+   struct seqStruct seqST;
+   struct seqPack packST;
+   ulong headAryUL[defAlnRefHeadUL];
+   ulong *recAryUL = 0;   /*Entry table*/
+   ulong *recUL = 0;      /*Entry on in the table*/
+   ulong numRecsUL = 0;
+   ulong lenRecBuffUL = 0;
+   ulong posUL = 0;       /*Offset of the end of the file*/
+   unsigned char errUC = 0;
+   void *tmpPtr = 0;
+
+   initSeqFile(&faFileST);
+   initSeqST(&seqST);
+   initSeqPack(&packST);
+
+   /*Space for the header; it is printed at the end*/
+   memset(headAryUL, 0, sizeof(headAryUL));
+
+   errUC =
+      alnRefPut(
+         defAlnRefMagic,
+         defAlnRefLenMagic,
+         &posUL,
+         outFILE
+      );
+   if(errUC) goto cleanUp;
+
+   errUC =
+      alnRefPut(
+         headAryUL,
+         sizeof(headAryUL),
+         &posUL,
+         outFILE
+      );
+   if(errUC) goto cleanUp;
+
+   errUC = openSeqFile(&faFileST, faFILE);
+   if(errUC) goto cleanUp;
+
+   while(1)
+   { /*Loop: pack each entry*/
+      errUC = readSeqFile(&faFileST, &seqST, 1);
+
+      if(errUC == 0) break; /*End of file*/
+      if(errUC != 1) goto cleanUp;
+      if(seqST.lenSeqUL == 0) {errUC = 2; goto cleanUp;}
+
+      if(numRecsUL == lenRecBuffUL)
+      { /*If: I need a larger entry table*/
+         lenRecBuffUL = (lenRecBuffUL << 1) + 16;
+
+         tmpPtr =
+            realloc(
+               recAryUL,
+               lenRecBuffUL*defAlnRefRecUL*sizeof(ulong)
+            );
+
+         if(tmpPtr == 0) {errUC = 64; goto cleanUp;}
+         recAryUL = tmpPtr;
+      } /*If: I need a larger entry table*/
+
+      errUC = packSeq(seqST.seqCStr,seqST.lenSeqUL,&packST);
+      if(errUC) goto cleanUp;
+
+      recUL = recAryUL + numRecsUL * defAlnRefRecUL;
+      ++numRecsUL;
+
+      recUL[defAlnRefIdOff] = posUL;
+      recUL[defAlnRefLenId] = seqST.lenIdUL;
+      recUL[defAlnRefLenSeq] = seqST.lenSeqUL;
+
+      errUC =
+         alnRefPut(
+            seqST.idCStr,
+            seqST.lenIdUL,
+            &posUL,
+            outFILE
+         );
+      if(errUC) goto cleanUp;
+
+      recUL[defAlnRefLimbOff] = posUL;
+
+      errUC =
+         alnRefPut(
+            packST.twoBitST.firstLimbUCPtr,
+            packST.twoBitST.lenAryUL,
+            &posUL,
+            outFILE
+         );
+      if(errUC) goto cleanUp;
+
+      /*Runs are the start array, length array, and base
+      ` array. Each array is padded.
+      */
+      recUL[defAlnRefNumRuns] = packST.numRunsUL;
+      recUL[defAlnRefRunOff] = posUL;
+
+      errUC =
+         alnRefPut(
+            packST.runStartAryUL,
+            packST.numRunsUL * sizeof(ulong),
+            &posUL,
+            outFILE
+         );
+      if(errUC) goto cleanUp;
+
+      errUC =
+         alnRefPut(
+            packST.runLenAryUL,
+            packST.numRunsUL * sizeof(ulong),
+            &posUL,
+            outFILE
+         );
+      if(errUC) goto cleanUp;
+
+      errUC =
+         alnRefPut(
+            packST.runBaseAryC,
+            packST.numRunsUL,
+            &posUL,
+            outFILE
+         );
+      if(errUC) goto cleanUp;
+   } /*Loop: pack each entry*/
+
+   if(numRecsUL == 0) {errUC = 2; goto cleanUp;}
+
+   /*Print the entry table and then the header*/
+   headAryUL[0] = defAlnRefCheck;
+   headAryUL[1] = numRecsUL;
+   headAryUL[2] = posUL;
+
+   errUC =
+      alnRefPut(
+         recAryUL,
+         numRecsUL * defAlnRefRecUL * sizeof(ulong),
+         &posUL,
+         outFILE
+      );
+   if(errUC) goto cleanUp;
+
+   headAryUL[3] = posUL;
+
+   if(fseek(outFILE, defAlnRefLenMagic, SEEK_SET))
+      {errUC = 8; goto cleanUp;}
+
+   if(
+         fwrite(headAryUL, 1, sizeof(headAryUL), outFILE)
+      != sizeof(headAryUL)
+   ) {errUC = 8; goto cleanUp;}
+
+   if(fflush(outFILE)) errUC = 8;
+
+   cleanUp:
+   if(recAryUL != 0) free(recAryUL);
+   freeSeqPackStack(&packST);
+   freeSeqSTStack(&seqST);
+   freeSeqFileStack(&faFileST);
+   return errUC;
+} /*mkAlnRef*/
+
+/*-------------------------------------------------------\
+| Fun-05: mapAlnRef
+|  - Maps a cache file (.alnref) and checks its header
+| Input:
+|  - alnRefST:
+|    o Pointer to alnRef structure to hold the map
+|      (should be initialized with initAlnRef)
+|  - fileStr:
+|    o C-string with the name of the file to map
+| Output:
+|  - Modifies:
+|    o alnRefST to have the map and the entry table
+|  - Returns:
+|    o 1: if the file is a cache
+|    o 0: if the file is not a cache, is not a regular
+|         file (pipe), or could not be opened; alnRefST
+|         is not changed and nothing is read from pipes
+|    o 2: if the cache is truncated or was made on a cpu
+|         or with a conversion that differs
+|    o 64: If malloc failed to find memory (-DNOMMAP)
+\-------------------------------------------------------*/
+static unsigned char mapAlnRef(
+   struct alnRef *alnRefST,
+   char *fileStr
+){
+   char magicStr[defAlnRefLenMagic];
+   ulong *headUL = 0;
+   char *mapStr = 0;
+   ulong lenFileUL = 0;
+   ulong minUL = 0;
+   FILE *refFILE = 0;
+
+   #ifndef NOMMAP
+      int fileFD = 0;
+      struct stat fileStat;
+   #endif
+
+   minUL = defAlnRefLenMagic+defAlnRefHeadUL*sizeof(ulong);
+
+   /*Pipes (and other files that are not regular files)
+   ` are never read here, since any bytes read here would
+   ` be lost to the fasta readers
+   */
+   #ifdef NOMMAP
+      refFILE = fopen(fileStr, "rb");
+      if(refFILE == 0) return 0;
+
+      if(fseek(refFILE, 0, SEEK_END))
+      { /*If: this is a pipe (can not seek)*/
+         fclose(refFILE);
+         return 0;
+      } /*If: this is a pipe (can not seek)*/
+
+      lenFileUL = (ulong) ftell(refFILE);
+      rewind(refFILE);
+   #else
+      if(stat(fileStr, &fileStat) != 0) return 0;
+      if(! S_ISREG(fileStat.st_mode)) return 0;
+      lenFileUL = (ulong) fileStat.st_size;
+
+      refFILE = fopen(fileStr, "rb");
+      if(refFILE == 0) return 0;
+   #endif
+
+   /*Check the magic, so fasta files are left to the
+   ` fasta readers
+   */
+   if(
+         fread(magicStr, 1, defAlnRefLenMagic, refFILE)
+      != defAlnRefLenMagic
+   ){ /*If: the file is too small to be a cache*/
+      fclose(refFILE);
+      return 0;
+   } /*If: the file is too small to be a cache*/
+
+   if(memcmp(magicStr, defAlnRefMagic, defAlnRefLenMagic))
+   { /*If: this is not a cache*/
+      fclose(refFILE);
+      return 0;
+   } /*If: this is not a cache*/
+
+   if(lenFileUL < minUL) {fclose(refFILE); return 2;}
+
+   #ifdef NOMMAP
+      rewind(refFILE);
+      mapStr = malloc(lenFileUL);
+      if(mapStr == 0) {fclose(refFILE); return 64;}
+
+      if(fread(mapStr, 1, lenFileUL, refFILE) != lenFileUL)
+      { /*If: the file could not be read*/
+         fclose(refFILE);
+         free(mapStr);
+         return 2;
+      } /*If: the file could not be read*/
+
+      fclose(refFILE);
+   #else
+      fclose(refFILE);
+
+      fileFD = open(fileStr, O_RDONLY);
+      if(fileFD < 0) return 2;
+
+      mapStr =
+         mmap(
+            0,
+            lenFileUL,
+            PROT_READ,
+            MAP_SHARED,
+            fileFD,
+            0
+         );
+
+      close(fileFD); /*The map keeps the file open*/
+      if(mapStr == MAP_FAILED) return 2;
+   #endif
+
+   alnRefST->mapStr = mapStr;
+   alnRefST->lenMapUL = lenFileUL;
+   headUL = (ulong *) (mapStr + defAlnRefLenMagic);
+
+   if(
+         headUL[0] != defAlnRefCheck
+      || headUL[3] != lenFileUL
+      || headUL[1] == 0
+      || headUL[2] > lenFileUL
+      || headUL[2] % sizeof(ulong)
+      ||   headUL[1]
+         > (lenFileUL - headUL[2])
+           / (defAlnRefRecUL * sizeof(ulong))
+   ){ /*If: the header does not match the file*/
+      freeAlnRefStack(alnRefST);
+      return 2;
+   } /*If: the header does not match the file*/
+
+   alnRefST->numRecsUL = headUL[1];
+   alnRefST->recAryUL = (ulong *) (mapStr + headUL[2]);
+   return 1;
+} /*mapAlnRef*/
+
+/*-------------------------------------------------------\
+| Fun-06: findAlnRef
+|  - Finds an entry in a cache by its name
+| Input:
+|  - alnRefST:
+|    o Pointer to alnRef structure with the cache
+|  - nameStr:
+|    o C-string with the name of the entry (the id up to
+|      the first white space)
+| Output:
+|  - Returns:
+|    o Index of the entry in the entry table
+|    o numRecsUL in alnRefST if the entry is not in the
+|      cache
+\-------------------------------------------------------*/
+static ulong findAlnRef(
+   struct alnRef *alnRefST,
+   char *nameStr
+){
+   ulong lenNameUL = strlen(nameStr);
+   ulong recUL = 0;
+   ulong *entryUL = alnRefST->recAryUL;
+   char *idStr = 0;
+
+   for(recUL = 0; recUL < alnRefST->numRecsUL; ++recUL)
+   { /*Loop: check the name of each entry*/
+      idStr = alnRefST->mapStr + entryUL[defAlnRefIdOff];
+
+      if(
+            entryUL[defAlnRefLenId] > lenNameUL + 1
+         && entryUL[defAlnRefIdOff] < alnRefST->lenMapUL
+         &&   entryUL[defAlnRefLenId]
+           <= alnRefST->lenMapUL - entryUL[defAlnRefIdOff]
+         && faIdxName(idStr + 1) == lenNameUL
+         && ! strncmp(idStr + 1, nameStr, lenNameUL)
+      ) break; /*Found the entry*/
+
+      entryUL += defAlnRefRecUL;
+   } /*Loop: check the name of each entry*/
+
+   return recUL;
+} /*findAlnRef*/
+
+/*-------------------------------------------------------\
+| Fun-07: readAlnRef
+|  - Unpacks an entry (or a region of an entry) from a
+|    cache. Only the bases in the region are unpacked.
+| Input:
+|  - alnRefST:
+|    o Pointer to alnRef structure with the cache (from
+|      mapAlnRef)
+|  - nameStr:
+|    o C-string with the name of the entry to read
+|    o 0 to read all of the first entry (startUL and
+|      endUL are ignored), like readSeqFile
+|  - startUL:
+|    o First base in the region (index 0)
+|  - endUL:
+|    o Last base in the region (index 0); 0 is the end
+|      of the entry
+|  - seqST:
+|    o Pointer to seqStruct structure to hold the entry
+|  - packST:
+|    o Pointer to seqPack structure to point to the
+|      packed entry in the map. The bases are then not
+|      unpacked (seqST->packST is set). The map must be
+|      kept till seqST is no longer used.
+|    o 0 to unpack the bases into seqST->seqCStr
+| Output:
+|  - Modifies:
+|    o seqST to have the bases as lookup indexes (or
+|      packST and packStartUL). The id is the id in the
+|      fasta file (nameStr is 0) or >name:start-end (like
+|      readFaRegion).
+|    o packST to have the packed entry (if not 0)
+|  - Returns:
+|    o 1: if the entry (region) was read
+|    o 0: if the entry is not in the cache
+|    o 2: if the entry is not in the file (truncated)
+|    o 4: if the region is not in the entry
+|    o 64: If malloc failed to find memory
+\-------------------------------------------------------*/
+static unsigned char readAlnRef(
+   struct alnRef *alnRefST,
+   char *nameStr,
+   ulong startUL,
+   ulong endUL,
+   struct seqStruct *seqST,
+   struct seqPack *packST
+){
+   struct seqPack mapPackST; /*If not keeping packST*/
+   ulong recUL = 0;
+   ulong *entryUL = 0;
+   ulong lenSeqUL = 0;
+   ulong numRunsUL = 0;
+   ulong lenUL = 0;
+   char *idStr = 0;
+
+   if(nameStr != 0)
+   { /*If: finding the entry by its name*/
+      recUL = findAlnRef(alnRefST, nameStr);
+      if(recUL == alnRefST->numRecsUL) return 0;
+   } /*If: finding the entry by its name*/
+
+   entryUL = alnRefST->recAryUL + recUL * defAlnRefRecUL;
+   lenSeqUL = entryUL[defAlnRefLenSeq];
+   numRunsUL = entryUL[defAlnRefNumRuns];
+   idStr = alnRefST->mapStr + entryUL[defAlnRefIdOff];
+
+   /*Check the entry is in the file*/
+   if(
+         lenSeqUL == 0
+      || entryUL[defAlnRefLenId] < 2
+      || entryUL[defAlnRefIdOff] > alnRefST->lenMapUL
+      ||   entryUL[defAlnRefLenId]
+         > alnRefST->lenMapUL - entryUL[defAlnRefIdOff]
+      || entryUL[defAlnRefLimbOff] > alnRefST->lenMapUL
+      ||   (lenSeqUL >> 2) + 1
+         > alnRefST->lenMapUL - entryUL[defAlnRefLimbOff]
+      || entryUL[defAlnRefRunOff] > alnRefST->lenMapUL
+      || entryUL[defAlnRefRunOff] % sizeof(ulong)
+      ||   numRunsUL
+         > (alnRefST->lenMapUL - entryUL[defAlnRefRunOff])
+           / (2 * sizeof(ulong) + 1)
+   ) return 2;
+
+   if(nameStr == 0)
+   { /*If: reading the whole entry*/
+      startUL = 0;
+      endUL = lenSeqUL - 1;
+   } /*If: reading the whole entry*/
+
+   else if(endUL == 0) endUL = lenSeqUL - 1;
+
+   if(startUL > endUL || endUL >= lenSeqUL) return 4;
+
+   /*The packed entry is used in place in the map*/
+   lenUL = endUL - startUL + 1;
+
+   if(packST != 0)
+   { /*If: keeping the entry packed*/
+      seqST->packST = packST;
+      seqST->packStartUL = startUL;
+      seqST->lenSeqUL = lenUL;
+   } /*If: keeping the entry packed*/
+
+   else
+   { /*Else: unpacking the entry*/
+      seqST->packST = 0;
+      packST = &mapPackST;
+   } /*Else: unpacking the entry*/
+
+   initSeqPack(packST);
+   packST->twoBitST.firstLimbUCPtr =
+      (uchar *) alnRefST->mapStr+entryUL[defAlnRefLimbOff];
+   packST->twoBitST.limbOnUCPtr =
+      packST->twoBitST.firstLimbUCPtr;
+   packST->twoBitST.lenAryUL = (lenSeqUL >> 2) + 1;
+   packST->lenSeqUL = lenSeqUL;
+
+   packST->numRunsUL = numRunsUL;
+   packST->runStartAryUL =
+      (ulong *) (alnRefST->mapStr+entryUL[defAlnRefRunOff]);
+   packST->runLenAryUL = packST->runStartAryUL + numRunsUL;
+   packST->runBaseAryC =
+      (char *) (packST->runLenAryUL + numRunsUL);
+
+   if(seqST->packST == 0)
+   { /*If: unpacking the entry (or region)*/
+      if(seqST->lenSeqBuffUL < lenUL)
+      { /*If: I need a larger sequence buffer*/
+         if(seqST->seqCStr != 0) free(seqST->seqCStr);
+         seqST->seqCStr = malloc(lenUL + 1);
+         seqST->lenSeqBuffUL = 0;
+
+         if(seqST->seqCStr == 0) return 64;
+         seqST->lenSeqBuffUL = lenUL;
+      } /*If: I need a larger sequence buffer*/
+
+      seqST->lenSeqUL =
+         unpackSeq(packST, startUL, lenUL, seqST->seqCStr);
+   } /*If: unpacking the entry (or region)*/
+
+   seqST->lenQUL = 0;
+
+   if(nameStr != 0)
+   { /*If: the id is the region*/
+      if(
+         faIdxRegionId(
+            seqST,
+            idStr + 1,
+            faIdxName(idStr + 1),
+            startUL,
+            endUL
+         )
+      ) return 64;
+
+      return 1;
+   } /*If: the id is the region*/
+
+   lenUL = entryUL[defAlnRefLenId];
+
+   if(seqST->lenIdBuffUL < lenUL + 1)
+   { /*If: I need a larger id buffer*/
+      if(seqST->idCStr != 0) free(seqST->idCStr);
+      seqST->idCStr = malloc(lenUL + 1);
+      seqST->lenIdBuffUL = 0;
+
+      if(seqST->idCStr == 0) return 64;
+      seqST->lenIdBuffUL = lenUL + 1;
+   } /*If: I need a larger id buffer*/
+
+   memcpy(seqST->idCStr, idStr, lenUL);
+   seqST->idCStr[lenUL] = '\0';
+   seqST->lenIdUL = lenUL;
+   return 1;
+} /*readAlnRef*/
+
+#endif
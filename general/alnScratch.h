@@ -0,0 +1,266 @@
+/*########################################################
+# Name: alnScratch
+# Use:
+#  - Holds an arena (scratch buffer) for the rows the
+#    aligners only need while aligning (score rows, index
+#    rows, and direction rows)
+#  - Memory is handed out from one block and is given back
+#    all at once with resetAlnScratch. Requests that do not
+#    fit in the block get their own blocks. On the next
+#    reset the main block is grown to fit everything, so
+#    after a few alignments the arena stops calling malloc.
+#  - An arena is not thread safe. Use one arena per thread.
+# Libraries:
+#  - "dataTypeShortHand.h"
+# C Standard Libraries:
+#  o <stdlib.h>
+#  o <string.h>
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Includes and structures
+'  o macro-01 scratchRoundUp:
+'    - Rounds a size up to the arena alignment
+'  o macro-02 initAlnScratch:
+'    - Sets an alnScratch structure to no memory
+'  o fun-03 getAlnScratch:
+'    - Gets memory from an arena (not set to 0)
+'  o fun-04 callocAlnScratch:
+'    - Gets memory from an arena and sets it to 0
+'  o fun-05 resetAlnScratch:
+'    - Gives back all memory in an arena (keeps the block)
+'  o fun-06 freeAlnScratchStack:
+'    - Frees all memory held by an arena
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes and structures
+\-------------------------------------------------------*/
+
+#ifndef ALN_SCRATCH_H
+#define ALN_SCRATCH_H
+
+#include <stdlib.h>
+#include <string.h>
+#include "dataTypeShortHand.h"
+
+/*Every size handed out is a multiple of this, so longs
+` and ulongs from the arena are aligned
+*/
+#define defScratchAlign 16
+
+/*-------------------------------------------------------\
+| Struct-01: alnScratchBlk
+|  - Header for a block that did not fit in the arena
+\-------------------------------------------------------*/
+struct alnScratchBlk{
+   struct alnScratchBlk *nextST; /*Next extra block*/
+   ulong lenUL;                  /*Bytes after header*/
+};
+
+/*-------------------------------------------------------\
+| Struct-02: alnScratch
+|  - Arena the aligners get their scratch rows from
+\-------------------------------------------------------*/
+struct alnScratch{
+   char *buffStr;     /*Block reused between alignments*/
+   ulong lenBuffUL;   /*Bytes in buffStr*/
+   ulong usedUL;      /*Bytes in buffStr handed out*/
+
+   struct alnScratchBlk *overST; /*Blocks not in buffStr*/
+   ulong lenOverUL;   /*Bytes in overST blocks*/
+};
+
+/*-------------------------------------------------------\
+| Macro-01: scratchRoundUp
+|  - Rounds a size up to the arena alignment
+| Input:
+|  - sizeUL:
+|    o Size in bytes to round up
+| Output:
+|  - Returns:
+|    o sizeUL rounded up to a multiple of defScratchAlign
+\-------------------------------------------------------*/
+#define scratchRoundUp(sizeUL)(\
+     ( ((sizeUL) + defScratchAlign - 1) / defScratchAlign)\
+   * defScratchAlign\
+)
+
+/*-------------------------------------------------------\
+| Macro-02: initAlnScratch
+|  - Sets an alnScratch structure to no memory
+| Input:
+|  - scratchST:
+|    o Pointer to alnScratch structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in scratchST to 0
+\-------------------------------------------------------*/
+#define initAlnScratch(scratchST){\
+   (scratchST)->buffStr = 0;\
+   (scratchST)->lenBuffUL = 0;\
+   (scratchST)->usedUL = 0;\
+   (scratchST)->overST = 0;\
+   (scratchST)->lenOverUL = 0;\
+} /*initAlnScratch*/
+
+/*-------------------------------------------------------\
+| Fun-03: getAlnScratch
+|  - Gets memory from an arena. The memory is not set to
+|    0 (use callocAlnScratch for that).
+| Input:
+|  - scratchST:
+|    o Pointer to alnScratch structure to get memory from
+|  - sizeUL:
+|    o Number of bytes to get
+| Output:
+|  - Modifies:
+|    o scratchST to have sizeUL less bytes free
+|  - Returns:
+|    o Pointer to the memory (valid till the next
+|      resetAlnScratch or freeAlnScratchStack call)
+|    o 0 for memory errors
+\-------------------------------------------------------*/
+static void * getAlnScratch(
+   struct alnScratch *scratchST,
+   ulong sizeUL
+){
+   char *retStr = 0;
+   struct alnScratchBlk *blkST = 0;
+
+   sizeUL = scratchRoundUp(sizeUL);
+
+   if(sizeUL <= scratchST->lenBuffUL - scratchST->usedUL)
+   { /*If: the main block has room*/
+      retStr = scratchST->buffStr + scratchST->usedUL;
+      scratchST->usedUL += sizeUL;
+      return retStr;
+   } /*If: the main block has room*/
+
+   /*Not enough room; get a block that is freed on the
+   ` next reset (the main block grows to fit it then)
+   */
+   blkST =
+      malloc(
+           scratchRoundUp(sizeof(struct alnScratchBlk))
+         + sizeUL
+      );
+
+   if(blkST == 0) return 0;
+
+   blkST->lenUL = sizeUL;
+   blkST->nextST = scratchST->overST;
+   scratchST->overST = blkST;
+   scratchST->lenOverUL += sizeUL;
+
+   return
+        (char *) blkST
+      + scratchRoundUp(sizeof(struct alnScratchBlk));
+} /*getAlnScratch*/
+
+/*-------------------------------------------------------\
+| Fun-04: callocAlnScratch
+|  - Gets memory from an arena and sets it to 0
+| Input:
+|  - scratchST:
+|    o Pointer to alnScratch structure to get memory from
+|  - numElmUL:
+|    o Number of elements to get
+|  - sizeElmUL:
+|    o Number of bytes in one element
+| Output:
+|  - Modifies:
+|    o scratchST to have numElmUL * sizeElmUL less bytes
+|      free
+|  - Returns:
+|    o Pointer to the memory (all bytes set to 0)
+|    o 0 for memory errors
+\-------------------------------------------------------*/
+static void * callocAlnScratch(
+   struct alnScratch *scratchST,
+   ulong numElmUL,
+   ulong sizeElmUL
+){
+   void *retPtr =
+      getAlnScratch(scratchST, numElmUL * sizeElmUL);
+
+   if(retPtr != 0) memset(retPtr, 0, numElmUL*sizeElmUL);
+   return retPtr;
+} /*callocAlnScratch*/
+
+/*-------------------------------------------------------\
+| Fun-05: resetAlnScratch
+|  - Gives back all memory in an arena. The main block is
+|    kept and grown to fit any extra blocks that were used
+|    since the last reset.
+| Input:
+|  - scratchST:
+|    o Pointer to alnScratch structure to reset
+| Output:
+|  - Modifies:
+|    o Frees the extra blocks in scratchST
+|    o buffStr in scratchST to be large enough for all
+|      memory handed out since the last reset. If malloc
+|      fails, buffStr is set to 0 (getAlnScratch still
+|      works, but uses extra blocks).
+|    o usedUL in scratchST to be 0
+\-------------------------------------------------------*/
+static void resetAlnScratch(
+   struct alnScratch *scratchST
+){
+   struct alnScratchBlk *blkST = scratchST->overST;
+   ulong newLenUL = 0;
+
+   scratchST->usedUL = 0;
+   if(blkST == 0) return; /*Everything fit*/
+
+   while(blkST != 0)
+   { /*Loop: free the extra blocks*/
+      scratchST->overST = blkST->nextST;
+      free(blkST);
+      blkST = scratchST->overST;
+   } /*Loop: free the extra blocks*/
+
+   newLenUL = scratchST->lenBuffUL + scratchST->lenOverUL;
+   scratchST->lenOverUL = 0;
+
+   /*The old data is not needed, so no realloc*/
+   if(scratchST->buffStr != 0) free(scratchST->buffStr);
+   scratchST->buffStr = malloc(newLenUL);
+
+   if(scratchST->buffStr == 0) scratchST->lenBuffUL = 0;
+   else scratchST->lenBuffUL = newLenUL;
+} /*resetAlnScratch*/
+
+/*-------------------------------------------------------\
+| Fun-06: freeAlnScratchStack
+|  - Frees all memory held by an arena (not the arena)
+| Input:
+|  - scratchST:
+|    o Pointer to alnScratch structure to free memory in
+| Output:
+|  - Frees:
+|    o All blocks in scratchST
+|  - Modifies:
+|    o All values in scratchST to be 0
+\-------------------------------------------------------*/
+static void freeAlnScratchStack(
+   struct alnScratch *scratchST
+){
+   struct alnScratchBlk *blkST = scratchST->overST;
+
+   while(blkST != 0)
+   { /*Loop: free the extra blocks*/
+      scratchST->overST = blkST->nextST;
+      free(blkST);
+      blkST = scratchST->overST;
+   } /*Loop: free the extra blocks*/
+
+   if(scratchST->buffStr != 0) free(scratchST->buffStr);
+   initAlnScratch(scratchST);
+} /*freeAlnScratchStack*/
+
+#endif
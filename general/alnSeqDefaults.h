@@ -18,8 +18,35 @@
 #define defUseWater 0   /*Do a waterman smith alignment*/
 #define defUseHirsch 0  /*Use a Hirschberg alignment*/
 #define defUseMemWater 0 /*Use a memory efficent water*/
+#define defUseWfa 0 /*Use a wavefront (WFA) alignment*/
+#define defWfaLowMem 0 /*1: -use-wfa is bidirectional*/
 
 #define defUseTwoBit 0 /*1:use two bit arrays; 0 do not*/
+#define defUseVect 0 /*1: use vector memWater; 0 do not*/
+#define defBatch 0 /*1: align every query record; 0 first*/
+#define defBatchPairs 256 /*Pairs to read in per batch*/
+#define defPStats 0 /*1: print bits used per -batch pair*/
+#define defThreads 1 /*Threads to use (-threads)*/
+#define defLongFirst 1 /*1: -batch aligns long pairs first*/
+#define defQryRevCmp 0 /*1: reverse complement query*/
+
+/*Banded Needleman/Waterman (-band)*/
+#define defBand 0     /*Band width; 0 for the full matrix*/
+#define defBandAuto 0 /*1: widen the band till path fits*/
+#define defBandAutoStart 64 /*First band for -band auto*/
+
+/*Early stops for Waterman alignments (0 is off)*/
+#define defXDrop 0 /*-x-drop: stop cells this below best*/
+#define defZDrop 0 /*-z-drop: stop rows this below best*/
+
+/*Vector instruction sets for -vect-set (widest is last)*/
+#define defVectScalar 1 /*Use the scalar aligners*/
+#define defVectSSE2 2
+#define defVectSSE4 3
+#define defVectAVX2 4
+#define defVectNative 6 /*Set picked when compiling*/
+#define defVectAuto 8   /*Pick the widest the cpu has*/
+#define defVectSet defVectAuto
    /*This only applies to Needleman and Waterman*/
 
 #define defJustScoresBl 0 /*memory efficent water only*/
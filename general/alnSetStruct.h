@@ -16,7 +16,10 @@
 ' SOF: Start Of File
 '  o header:
 '    - Has includes and definede variables
-'  o st-01 alnSet:
+'  o st-01 scoreProf:
+'     o Holds the score profile (one row of scores per
+'       query base) for a reference
+'  o st-02 alnSet:
 '     o Holds settings for my alignment program
 '  o fun-01 setBpScore:
 '    - Sets the score for a base pair (reference/query)
@@ -40,7 +43,18 @@
 '  o fun-10 lookupIndexToSeq:
 '    - Converts a sequence of lookup indexs back into
 '      uppercase characters (a-z)
-'  o fun-11 initAlnSet:
+'  o fun-11 scoreProfIndex:
+'    - Converts a query base to its score profile row
+'  o fun-12 initScoreProf:
+'    - Blanks a scoreProf structure (no rows)
+'  o fun-13 freeScoreProfStack:
+'    - Frees the rows in a scoreProf structure
+'  o fun-14 setScoreProf:
+'    - Builds the score profile rows for a query and
+'      reference (reuses rows kept for the reference)
+'  o fun-15 getScoreProfRow:
+'    - Gets the score profile row for a query base
+'  o fun-16 initAlnSet:
 '    - Set all values in altSet (alingment settings)
 '      structure to defaults
 \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
@@ -90,7 +104,25 @@
 #endif
 
 /*-------------------------------------------------------\
-| ST-01: alnSet
+| ST-01: scoreProf
+| Use:
+|  - Holds one row of scores per query base for a
+|    reference. Row b, column i is the score for query
+|    base b and reference base i, so a row is read
+|    straight through when scoring a query base against
+|    the reference (no score matrix lookup per cell).
+|  - Rows are only made for bases in the query and are
+|    kept for the next alignment to the same reference.
+\-------------------------------------------------------*/
+typedef struct scoreProf
+{ /*scoreProf*/
+   char *rowAryC[defMatrixCol]; /*Rows (0 if not made)*/
+   char *refSeqStr;  /*Reference the rows are for*/
+   ulong lenRefUL;   /*Number of reference bases in rows*/
+}scoreProf;
+
+/*-------------------------------------------------------\
+| ST-02: alnSet
 | Use: Holds settings for my alignment program
 \-------------------------------------------------------*/
 typedef struct alnSet
@@ -118,7 +150,18 @@ typedef struct alnSet
    char useWaterBl;
    char useHirschBl;
    char memWaterBl;
+   char useWfaBl;     /*1: use a wavefront alignment*/
+   char wfaLowMemBl;  /*1: bidirectional -use-wfa*/
    char twoBitBl;     /*1: use two bit arrays; 0 do not*/
+   char vectBl;       /*1: use vector memWater; 0 not*/
+   char batchBl;      /*1: align all records; 0 first*/
+   char pStatsBl;     /*1: print -batch precision use*/
+   unsigned short threadsUS; /*Threads to use*/
+   char longFirstBl;  /*1: -batch does long pairs first*/
+   char vectSetC;     /*Vector set to use (defVectAVX2)*/
+   ulong bandUL;      /*-band width; 0 for no band*/
+   char bandAutoBl;   /*1: widen band till path fits*/
+   char qryRevCmpBl;  /*1: reverse complement the query*/
 
    /*Directional priorities (see alnSeqDefualts.h for
    ` options)
@@ -152,6 +195,8 @@ typedef struct alnSet
       */
    char pAltAlns;  /*1: Print out alternative alignments*/
    long minScoreL; /*Min score to keep alignment*/
+   long xDropL; /*-x-drop; 0 for no X-drop*/
+   long zDropL; /*-z-drop; 0 for no Z-drop*/
 
    char scoreMatrixC[defMatrixCol][defMatrixCol];
    char matchMatrixBl[defMatrixCol][defMatrixCol];
@@ -163,6 +208,12 @@ typedef struct alnSet
      `   scoreMatrixC[(uchar) (base1 & defClearNonAlph)-1]
      `               [(uchar) (base2 & defClearNonAlph)-1]
      */
+
+   struct scoreProf profST;
+     /*Score profile rows kept between alignments (see
+     ` setScoreProf). Blank this (freeScoreProfStack) if
+     ` scoreMatrixC or the reference sequence changes.
+     */
 }alnSet;
 
 /*-------------------------------------------------------\
@@ -276,16 +327,16 @@ typedef struct alnSet
 | Fun-03: freeAlnSetStack
 |  - Does a stack free of an alnSet structer
 | Input:
-|  - alnSetST:
-|    o alnSetST to free internal variables in
-|    o alnSetST is not a pointer
+|  - alnSetSTPtr:
+|    o Pointer to alnSetST to free internal variables in
 | Output:
 |  - Free:
-|    o Nothing, there are no heap allocated variables. This
-|      is here in case I decide to have heap allocated
-|      variables on day.
+|    o The score profile rows in alnSetSTPtr->profST
+|      (see freeScoreProfStack)
 \-------------------------------------------------------*/
-#define freeAlnSetStack(alnSetST) ()
+#define freeAlnSetStack(alnSetSTPtr){\
+   freeScoreProfStack(&(alnSetSTPtr)->profST);\
+} /*freeAlnSetStack*/
 
 /*-------------------------------------------------------\
 | Fun-04: freeAlnSet
@@ -710,7 +761,194 @@ static unsigned long readInMatchFile(
 #endif /*end of file*/
 
 /*-------------------------------------------------------\
-| Fun-11: initAlnSet
+| Fun-11: scoreProfIndex
+|  - Converts a query base to its score profile row
+| Input:
+|  - qryBase:
+|    o Query base to get the row for
+| Output:
+|  - Returns:
+|    o Index of the row for qryBase in
+|      scoreProf->rowAryC (same as the first index used
+|      by getBaseScore)
+| Variations:
+|  - WORDS (-DWORDS)
+|    o This is the full ascii matrix (128x128)
+|  - NOSEQCNVT (-DNOSEQCNVT)
+|    o This assumes that the sequences will not be
+|      converted to indexes
+|  - default
+|    o This assumes that the sequences are converted to
+|      indexes
+\-------------------------------------------------------*/
+#if defined WORDS
+   #define scoreProfIndex(qryBase) ((uchar) (qryBase))
+
+#elif defined NOSEQCNVT
+   #define scoreProfIndex(qryBase)(\
+      (uchar) ((qryBase) & defClearNonAlph) - 1\
+   )
+
+#else /*Else the base is pre-converted*/
+   #define scoreProfIndex(qryBase) ((uchar) (qryBase))
+#endif
+
+/*-------------------------------------------------------\
+| Fun-12: initScoreProf
+|  - Blanks a scoreProf structure (no rows)
+| Input:
+|  - profSTPtr:
+|    o Pointer to scoreProf structure to blank
+| Output:
+|  - Modifies:
+|    o All rows in profSTPtr to be 0 and the reference to
+|      be 0 (no reference)
+|  - Note:
+|    o This does not free the rows (freeScoreProfStack)
+\-------------------------------------------------------*/
+#define initScoreProf(profSTPtr){\
+   ulong macroRowUL = 0;\
+   \
+   for(\
+      macroRowUL = 0;\
+      macroRowUL < defMatrixCol;\
+      ++macroRowUL\
+   ) (profSTPtr)->rowAryC[macroRowUL] = 0;\
+   \
+   (profSTPtr)->refSeqStr = 0;\
+   (profSTPtr)->lenRefUL = 0;\
+} /*initScoreProf*/
+
+/*-------------------------------------------------------\
+| Fun-13: freeScoreProfStack
+|  - Frees the rows in a scoreProf structure
+| Input:
+|  - profSTPtr:
+|    o Pointer to scoreProf structure with rows to free
+| Output:
+|  - Frees:
+|    o All rows in profSTPtr
+|  - Modifies:
+|    o profSTPtr to be blank (see initScoreProf)
+\-------------------------------------------------------*/
+#define freeScoreProfStack(profSTPtr){\
+   ulong macroRowUL = 0;\
+   \
+   for(\
+      macroRowUL = 0;\
+      macroRowUL < defMatrixCol;\
+      ++macroRowUL\
+   ){ /*Loop: free the rows*/\
+      if((profSTPtr)->rowAryC[macroRowUL] != 0)\
+         free((profSTPtr)->rowAryC[macroRowUL]);\
+   } /*Loop: free the rows*/\
+   \
+   initScoreProf((profSTPtr));\
+} /*freeScoreProfStack*/
+
+/*-------------------------------------------------------\
+| Fun-14: setScoreProf
+|  - Builds the score profile rows for a query and
+|    reference. Rows already made for the same reference
+|    are reused.
+| Input:
+|  - qrySeqStr:
+|    o First query base that will be aligned
+|  - lenQryUL:
+|    o Number of query bases that will be aligned
+|  - refSeqStr:
+|    o Start of the reference sequence (not the first
+|      aligned base). Every pointer into this sequence
+|      can then be used with getScoreProfRow.
+|  - lenRefUL:
+|    o Number of reference bases in refSeqStr to make
+|      scores for (last aligned base + 1)
+|  - settings:
+|    o Pointer to alnSet structure with the scoring
+|      matrix and profile (settings->profST) to set
+| Output:
+|  - Modifies:
+|    o settings->profST to have a row for each base in
+|      qrySeqStr. Old rows are freed if refSeqStr is a
+|      different sequence or is longer than the kept
+|      rows.
+|  - Returns:
+|    o 0 for no errors
+|    o 64 for memory errors
+\-------------------------------------------------------*/
+static char setScoreProf(
+   char *qrySeqStr,      /*First query base to align*/
+   ulong lenQryUL,       /*Number of query bases*/
+   char *refSeqStr,      /*Start of reference sequence*/
+   ulong lenRefUL,       /*Number of reference bases*/
+   struct alnSet *settings /*Has matrix and profile*/
+){
+   struct scoreProf *profST = &settings->profST;
+   char *rowC = 0;
+   ulong ulQry = 0;
+   ulong ulRef = 0;
+
+   if(
+         profST->refSeqStr != refSeqStr
+      || profST->lenRefUL < lenRefUL
+   ){ /*If: the kept rows are for another reference*/
+      freeScoreProfStack(profST);
+      profST->refSeqStr = refSeqStr;
+      profST->lenRefUL = lenRefUL;
+   } /*If: the kept rows are for another reference*/
+
+   for(ulQry = 0; ulQry < lenQryUL; ++ulQry)
+   { /*Loop: make a row for each query base*/
+      if(
+         profST->rowAryC[scoreProfIndex(qrySeqStr[ulQry])]
+         != 0
+      ) continue; /*Already have this row*/
+
+      rowC = malloc(profST->lenRefUL * sizeof(char));
+      if(rowC == 0) return 64;
+
+      for(ulRef = 0; ulRef < profST->lenRefUL; ++ulRef)
+      { /*Loop: score the query base to the reference*/
+         rowC[ulRef] =
+            getBaseScore(
+               qrySeqStr[ulQry],
+               refSeqStr[ulRef],
+               settings
+            );
+      } /*Loop: score the query base to the reference*/
+
+      profST->rowAryC[scoreProfIndex(qrySeqStr[ulQry])] =
+         rowC;
+   } /*Loop: make a row for each query base*/
+
+   return 0;
+} /*setScoreProf*/
+
+/*-------------------------------------------------------\
+| Fun-15: getScoreProfRow
+|  - Gets the score profile row for a query base
+| Input:
+|  - qryBase:
+|    o Query base to get the row for (setScoreProf must
+|      have been called with a query that had this base)
+|  - refPtr:
+|    o Pointer into the reference sequence given to
+|      setScoreProf
+|  - alnSetSTPtr:
+|    o Pointer to alnSet structure with the profile
+| Output:
+|  - Returns:
+|    o Pointer to the row for qryBase, lined up with
+|      refPtr. So, row[i] is the score for qryBase and
+|      refPtr[i].
+\-------------------------------------------------------*/
+#define getScoreProfRow(qryBase, refPtr, alnSetSTPtr)(\
+     (alnSetSTPtr)->profST.rowAryC[scoreProfIndex(qryBase)]\
+   + ((refPtr) - (alnSetSTPtr)->profST.refSeqStr)\
+) /*getScoreProfRow*/
+
+/*-------------------------------------------------------\
+| Fun-16: initAlnSet
 |  - Set values in altSet (alingment settings) structure
 |    to default values
 | Input:
@@ -724,23 +962,23 @@ static unsigned long readInMatchFile(
 static void initAlnSet(
     struct alnSet *alnSetST /*Has settings to initialize*/
 ){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
-   ' Fun-11 TOC: initAlnSet
+   ' Fun-16 TOC: initAlnSet
    '  - Set values in altSet (alingment settings)
    '    structure to defaults
-   '  o fun-11 sec-01:
+   '  o fun-16 sec-01:
    '    - Set non-matrix variables
-   '  o fun-11 sec-02:
+   '  o fun-16 sec-02:
    '    - Initialize scoring matrix
-   '  o fun-11 sec-03:
+   '  o fun-16 sec-03:
    '    - Initialize match matrix
-   '  o fun-11 sec-04:
+   '  o fun-16 sec-04:
    '    - Handle special DNA scoring cases
-   '  o fun-11 sec-05:
+   '  o fun-16 sec-05:
    '    - Handle special DNA match cases
    \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
-   ^ Fun-11 Sec-01:
+   ^ Fun-16 Sec-01:
    ^  - Set non-matrix variables
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
@@ -762,7 +1000,18 @@ static void initAlnSet(
    alnSetST->useWaterBl = defUseWater;
    alnSetST->useHirschBl = defUseHirsch;
    alnSetST->memWaterBl = defUseMemWater;
+   alnSetST->useWfaBl = defUseWfa;
+   alnSetST->wfaLowMemBl = defWfaLowMem;
    alnSetST->twoBitBl = defUseTwoBit;
+   alnSetST->vectBl = defUseVect;
+   alnSetST->batchBl = defBatch;
+   alnSetST->pStatsBl = defPStats;
+   alnSetST->threadsUS = defThreads;
+   alnSetST->longFirstBl = defLongFirst;
+   alnSetST->vectSetC = defVectSet;
+   alnSetST->bandUL = defBand;
+   alnSetST->bandAutoBl = defBandAuto;
+   alnSetST->qryRevCmpBl = defQryRevCmp;
 
    /*Select direction to keep if everything is equal*/
    alnSetST->bestDirC = defBestDir;
@@ -775,13 +1024,18 @@ static void initAlnSet(
    /*Query reference scan variables*/
    alnSetST->refQueryScanBl = defQueryRefScan;
    alnSetST->minScoreL = defMinScore;
+   alnSetST->xDropL = defXDrop;
+   alnSetST->zDropL = defZDrop;
    alnSetST->filtQryBl = defFilterByQuery;
    alnSetST->filtRefBl = defFilterByRef;
    alnSetST->filtQryRefBl = defFilterByQueryRef;
    alnSetST->pAltAlns = defPAltAln;
+
+   /*No score profile rows till the first alignment*/
+   initScoreProf(&alnSetST->profST);
   
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
-   ^ Fun-11 Sec-02:
+   ^ Fun-16 Sec-02:
    ^  - Initialize scoring matrix
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
@@ -810,7 +1064,7 @@ static void initAlnSet(
    #endif
 
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
-   ^ Fun-11 Sec-03:
+   ^ Fun-16 Sec-03:
    ^  - Initialize match matrix
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
@@ -831,7 +1085,7 @@ static void initAlnSet(
     } /*loop for all columns in the comparison matrix*/
 
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
-   ^ Fun-11 Sec-04:
+   ^ Fun-16 Sec-04:
    ^  - Handle special DNA scoring cases
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
@@ -1156,7 +1410,7 @@ static void initAlnSet(
    #endif
 
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
-   ^ Fun-11 Sec-05:
+   ^ Fun-16 Sec-05:
    ^  - Handle special DNA match cases
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
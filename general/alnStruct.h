@@ -514,7 +514,9 @@ static char alnSTToSeq(
 |      match/snp (mismatch) matrix.
 |  - alnMtrxSTPtr:
 |    o Pointer to an alnMatrix structure with the matrix
-|      to convert.
+|      to convert. This can be a full or banded matrix
+|      (lenBandUL != 0). indexUL is always a full matrix
+|      index.
 | Output:
 |  - Returns:
 |    o alnStruct with the alingment array
@@ -553,6 +555,13 @@ static struct alnStruct * dirMatrixToAln(
   ulong lastRefMatchSnpL = 0;
   ulong lastQryMatchSnpL = 0;
 
+  /*Cells to move back for an insertion or snp. Banded
+  ` matrixes (lenBandUL != 0) keep each diagonal in the
+  ` same column, so a snp moves one row up
+  */
+  ulong insStepUL = lenRefL + 1;
+  ulong snpStepUL = lenRefL + 2;
+
   char *qrySeqStr = 0;
   char *refSeqStr = 0;
 
@@ -624,7 +633,21 @@ static struct alnStruct * dirMatrixToAln(
   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
   /*get direction for the best element*/
-  dirMatrixST += indexUL;
+  if(alnMtrxSTPtr->lenBandUL == 0) dirMatrixST += indexUL;
+
+  else
+  { /*Else: this is a banded matrix*/
+     dirMatrixST +=
+        coordToBandIndex(
+           refPosUL,
+           qryPosUL,
+           alnMtrxSTPtr->lenBandUL,
+           alnMtrxSTPtr->bandStartL
+        );
+
+     snpStepUL = alnMtrxSTPtr->lenBandUL;
+     insStepUL = snpStepUL - 1;
+  } /*Else: this is a banded matrix*/
 
   while(*dirMatrixST != defMvStop)
   { /*While I have more bases in the alignment*/
@@ -638,7 +661,7 @@ static struct alnStruct * dirMatrixToAln(
         --qrySeqStr; /*insertion only query has a base*/
         --qryPosUL;
         ++(alnST->numInssUL);
-        dirMatrixST -= (lenRefL + 1);
+        dirMatrixST -= insStepUL;
           /* lenRefL (index 1) cells per row; need + 1 to
           `  get to the cell above
           */
@@ -665,7 +688,7 @@ static struct alnStruct * dirMatrixToAln(
           ++(alnST->numSnpsUL);
         } /*Else was a SNP*/
 
-        dirMatrixST -= (lenRefL + 2);
+        dirMatrixST -= snpStepUL;
           /*need + 2 to get to the next diagnol cell*/
         --qrySeqStr;
         --qryPosUL;
@@ -1160,6 +1183,8 @@ static char pEMBOSSHead(
        fprintf(outFILE, "# Program: alnSeq-Water\n");
      else if(setting->useHirschBl == 1)
        fprintf(outFILE, "# Program: alnSeq-Hirschberg\n");
+     else if(setting->useWfaBl == 1)
+       fprintf(outFILE, "# Program: alnSeq-WFA\n");
 
      fprintf(outFILE, "# Rundate:  %s\n", dateStr);
 
@@ -1367,6 +1392,8 @@ static void pExpandCigHead(
      fprintf(outFILE, "# Program: alnSeq-Water\n");
    else if(setting->useHirschBl == 1)
      fprintf(outFILE, "# Program: alnSeq-Hirschberg\n");
+   else if(setting->useWfaBl == 1)
+     fprintf(outFILE, "# Program: alnSeq-WFA\n");
 
    /*Check if using the default scoring matrix*/
    if(!scoreMtxFileStr)
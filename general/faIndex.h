@@ -0,0 +1,888 @@
+/*########################################################
+# Name: faIndex
+# Use:
+#  - Builds and reads fasta indexes (.fai files) that use
+#    the same format as samtools faidx. This lets a region
+#    of one entry in a large fasta file be read without
+#    reading the rest of the file.
+#    o Each .fai line is: name, length, offset of the
+#      first base, bases per line, and bytes per line
+#      (bases + new line), split by tabs.
+#    o The offset of a base is found from its line, so
+#      the region is read with one fseek and one fread.
+#  - gzip and fastq files can not be indexed. These are
+#    read entry by entry with readSeqFile (seqFile.h) till
+#    the named entry is found.
+# Libraries:
+#  - "seqFile.h"
+#  o "seqStruct.h"
+#  o "alnSetStruct.h"
+#  o "gzRead.h"
+#  o "inflate.h"
+#  o "alnSeqDefaults.h"
+#  o "base10StrToNum.h"
+#  o "dataTypeShortHand.h"
+# C Standard Libraries:
+#  o <stdlib.h>
+#  o <stdio.h>
+#  o <string.h>
+#  o <pthread.h> (POSIX, not C standard)
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Includes and structures
+'  o macro-01 initFaIdx:
+'    - Sets a faIdx structure to no entry or memory
+'  o macro-02 freeFaIdxStack:
+'    - Frees the name buffer in a faIdx structure
+'  o fun-03 faIdxName:
+'    - Gets the length of the name in a fasta header
+'  o macro-04 pFaIdx:
+'    - Prints an entry as a line in an index (.fai) file
+'  o fun-05 faIdxLine:
+'    - Adds one line of a fasta file to the entry that is
+'      being indexed
+'  o fun-06 mkFaIdx:
+'    - Builds the index (.fai) for a fasta file
+'  o fun-07 findFaIdx:
+'    - Finds an entry in an index (.fai) file
+'  o fun-08 faIdxRegionId:
+'    - Sets the id of a sequence to name:start-end
+'  o fun-09 readFaIdxRegion:
+'    - Reads a region of an indexed entry
+'  o fun-10 scanFaRegion:
+'    - Reads a region of an entry without an index
+'  o fun-11 readFaRegion:
+'    - Reads a region of an entry, with an index when
+'      the file can be indexed
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes and structures
+\-------------------------------------------------------*/
+
+#ifndef FAINDEX_H
+#define FAINDEX_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "seqFile.h"
+
+/*-------------------------------------------------------\
+| Struct-01: faIdx
+|  - Holds one entry (line) of a fasta index
+\-------------------------------------------------------*/
+struct faIdx{
+   char *nameStr;       /*Name of the entry*/
+   ulong lenNameUL;     /*Length of the name*/
+   ulong lenNameBuffUL; /*Size of the name buffer*/
+
+   ulong lenSeqUL;      /*Number of bases in the entry*/
+   ulong offsetUL;      /*Byte offset of the first base*/
+   ulong lineBasesUL;   /*Bases in each line*/
+   ulong lineBytesUL;   /*Bytes in each line*/
+};
+
+/*-------------------------------------------------------\
+| Macro-01: initFaIdx
+|  - Sets a faIdx structure to no entry or memory
+| Input:
+|  - faIdxST:
+|    o Pointer to faIdx structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in faIdxST to 0
+\-------------------------------------------------------*/
+#define initFaIdx(faIdxST){\
+   (faIdxST)->nameStr = 0;\
+   (faIdxST)->lenNameUL = 0;\
+   (faIdxST)->lenNameBuffUL = 0;\
+   (faIdxST)->lenSeqUL = 0;\
+   (faIdxST)->offsetUL = 0;\
+   (faIdxST)->lineBasesUL = 0;\
+   (faIdxST)->lineBytesUL = 0;\
+} /*initFaIdx*/
+
+/*-------------------------------------------------------\
+| Macro-02: freeFaIdxStack
+|  - Frees the name buffer in a faIdx structure
+| Input:
+|  - faIdxST:
+|    o Pointer to faIdx structure to free the name in
+| Output:
+|  - Frees:
+|    o nameStr in faIdxST
+|  - Modifies:
+|    o All values in faIdxST to 0
+\-------------------------------------------------------*/
+#define freeFaIdxStack(faIdxST){\
+   if((faIdxST)->nameStr != 0) free((faIdxST)->nameStr);\
+   initFaIdx((faIdxST));\
+} /*freeFaIdxStack*/
+
+/*-------------------------------------------------------\
+| Fun-03: faIdxName
+|  - Gets the length of the name in a fasta header (the
+|    characters before the first white space)
+| Input:
+|  - headStr:
+|    o C-string with the header, after the '>'
+| Output:
+|  - Returns:
+|    o Number of characters in the name
+\-------------------------------------------------------*/
+static ulong faIdxName(
+   char *headStr
+){
+   ulong lenUL = 0;
+
+   while((unsigned char) headStr[lenUL] > 32) ++lenUL;
+   return lenUL;
+} /*faIdxName*/
+
+/*-------------------------------------------------------\
+| Macro-04: pFaIdx
+|  - Prints an entry as a line in an index (.fai) file
+| Input:
+|  - faIdxST:
+|    o Pointer to faIdx structure with the entry to print.
+|      Nothing is printed when offsetUL is 0 (no entry).
+|  - faiFILE:
+|    o FILE to print the entry to
+| Output:
+|  - Prints:
+|    o The entry to faiFILE
+\-------------------------------------------------------*/
+#define pFaIdx(faIdxST, faiFILE){\
+   if((faIdxST)->offsetUL != 0)\
+      fprintf(\
+         (faiFILE),\
+         "%s\t%lu\t%lu\t%lu\t%lu\n",\
+         (faIdxST)->nameStr,\
+         (faIdxST)->lenSeqUL,\
+         (faIdxST)->offsetUL,\
+         (faIdxST)->lineBasesUL,\
+         (faIdxST)->lineBytesUL\
+      );\
+} /*pFaIdx*/
+
+/*-------------------------------------------------------\
+| Fun-05: faIdxLine
+|  - Adds one line of a fasta file to the entry that is
+|    being indexed. A header line starts a new entry
+|    (print the old entry with pFaIdx first).
+| Input:
+|  - faIdxST:
+|    o Pointer to faIdx structure with the entry being
+|      indexed (nameStr has the name of a new entry)
+|  - headBl:
+|    o 1: The line is a header (nameStr has the name)
+|    o 0: The line is a sequence line
+|  - basesUL:
+|    o Number of bases in the line
+|  - bytesUL:
+|    o Number of bytes in the line (with the new line)
+|  - nextUL:
+|    o Offset of the byte after the line
+|  - shortBlPtr:
+|    o Pointer to a char that is set to 1 when an entry
+|      has a line shorter than its first line. Only the
+|      last line can be short.
+| Output:
+|  - Modifies:
+|    o faIdxST to have the line
+|    o shortBlPtr
+|  - Returns:
+|    o 0: for no errors
+|    o 2: if the lines in the entry have different lengths,
+|         there is sequence before the first header, or
+|         a header has no name
+\-------------------------------------------------------*/
+static unsigned char faIdxLine(
+   struct faIdx *faIdxST,
+   char headBl,
+   ulong basesUL,
+   ulong bytesUL,
+   ulong nextUL,
+   char *shortBlPtr
+){
+   if(headBl)
+   { /*If: this is a header*/
+      if(faIdxST->lenNameUL == 0) return 2;
+
+      faIdxST->lenSeqUL = 0;
+      faIdxST->offsetUL = nextUL;
+      faIdxST->lineBasesUL = 0;
+      faIdxST->lineBytesUL = 0;
+      *shortBlPtr = 0;
+      return 0;
+   } /*If: this is a header*/
+
+   if(basesUL == 0)
+   { /*If: this is a blank line*/
+      if(faIdxST->lineBasesUL != 0) *shortBlPtr = 1;
+      return 0;
+   } /*If: this is a blank line*/
+
+   if(faIdxST->offsetUL == 0) return 2; /*No header*/
+   if(*shortBlPtr) return 2; /*Line after a short line*/
+
+   if(faIdxST->lineBasesUL == 0)
+   { /*If: this is the first line*/
+      faIdxST->lineBasesUL = basesUL;
+      faIdxST->lineBytesUL = bytesUL;
+   } /*If: this is the first line*/
+
+   else if(basesUL > faIdxST->lineBasesUL) return 2;
+   else if(basesUL < faIdxST->lineBasesUL) *shortBlPtr = 1;
+
+   else if(
+         bytesUL != faIdxST->lineBytesUL
+      && bytesUL > basesUL    /*The last line may not*/
+   ) return 2;                /*have a new line*/
+
+   faIdxST->lenSeqUL += basesUL;
+   return 0;
+} /*faIdxLine*/
+
+/*-------------------------------------------------------\
+| Fun-06: mkFaIdx
+|  - Builds the index (.fai) for a fasta file
+| Input:
+|  - faFILE:
+|    o FILE with the fasta file to index (at its start)
+|  - faiFILE:
+|    o FILE to print the index to
+| Output:
+|  - Prints:
+|    o One line per entry in faFILE to faiFILE
+|  - Returns:
+|    o 0: for no errors
+|    o 2: if faFILE can not be indexed (not a fasta file
+|         or lines in an entry have different lengths)
+|    o 64: If malloc failed to find memory
+\-------------------------------------------------------*/
+static unsigned char mkFaIdx(
+   FILE *faFILE,
+   FILE *faiFILE
+){
+   struct faIdx faIdxST;
+   char *buffStr = 0;
+   char *lineStr = 0;
+   char *endStr = 0;
+   ulong lenBuffUL = 0;
+   ulong posUL = 0;
+   ulong partUL = 0;
+   ulong fileUL = 0;  /*Offset of the byte at posUL*/
+   ulong bytesUL = 0; /*Bytes read of the current line*/
+   ulong basesUL = 0;
+   ulong nameUL = 0;
+   char headBl = 0;
+   char nameBl = 0;   /*1: still reading the name*/
+   char lastC = 0;    /*Last byte read*/
+   char shortBl = 0;
+   unsigned char errUC = 0;
+
+   initFaIdx(&faIdxST);
+   buffStr = malloc(defSeqFileBlock);
+   if(buffStr == 0) return 64;
+
+   /*Each line is found with memchr and only its length
+   ` is kept, except for the names in the headers
+   */
+   while(1)
+   { /*Loop: read the file*/
+      lenBuffUL =
+         fread(buffStr, 1, defSeqFileBlock, faFILE);
+      if(lenBuffUL == 0) break;
+
+      posUL = 0;
+
+      while(posUL < lenBuffUL)
+      { /*Loop: find the lines in the block*/
+         lineStr = buffStr + posUL;
+
+         if(bytesUL == 0)
+         { /*If: this is the start of a line*/
+            headBl = (*lineStr == '>');
+            nameBl = headBl;
+
+            if(headBl)
+            { /*If: this line starts a new entry*/
+               pFaIdx(&faIdxST, faiFILE);
+               faIdxST.lenNameUL = 0;
+            } /*If: this line starts a new entry*/
+         } /*If: this is the start of a line*/
+
+         endStr = memchr(lineStr, '\n', lenBuffUL - posUL);
+
+         if(endStr != 0) partUL = endStr - lineStr + 1;
+         else partUL = lenBuffUL - posUL;
+
+         if(nameBl)
+         { /*If: I am still reading the name*/
+            nameUL = 0;
+
+            if(bytesUL == 0) ++nameUL; /*Skip the '>'*/
+
+            while(
+                  nameUL < partUL
+               && (unsigned char) lineStr[nameUL] > 32
+            ) ++nameUL;
+
+            if(nameUL < partUL) nameBl = 0; /*At the end*/
+            if(bytesUL == 0) {++lineStr; --nameUL;}
+
+            errUC =
+               seqFileGrow(
+                  &faIdxST.nameStr,
+                  &faIdxST.lenNameBuffUL,
+                  faIdxST.lenNameUL + nameUL,
+                  0
+               );
+
+            if(errUC) goto cleanUp;
+
+            memcpy(
+               faIdxST.nameStr + faIdxST.lenNameUL,
+               lineStr,
+               nameUL
+            );
+
+            faIdxST.lenNameUL += nameUL;
+            faIdxST.nameStr[faIdxST.lenNameUL] = '\0';
+         } /*If: I am still reading the name*/
+
+         bytesUL += partUL;
+         posUL += partUL;
+         fileUL += partUL;
+
+         if(endStr == 0)
+         { /*If: the line goes into the next block*/
+            lastC = buffStr[lenBuffUL - 1];
+            break;
+         } /*If: the line goes into the next block*/
+
+         /*Remove the new line and any '\r' before it*/
+         basesUL = bytesUL - 1;
+         if(partUL > 1) lastC = endStr[-1];
+         if(basesUL > 0 && lastC == '\r') --basesUL;
+
+         errUC =
+            faIdxLine(
+               &faIdxST,
+               headBl,
+               basesUL,
+               bytesUL,
+               fileUL,
+               &shortBl
+            );
+
+         if(errUC) goto cleanUp;
+         bytesUL = 0;
+      } /*Loop: find the lines in the block*/
+   } /*Loop: read the file*/
+
+   if(bytesUL > 0 && ! headBl)
+   { /*If: the last line has no new line*/
+      basesUL = bytesUL;
+      if(lastC == '\r') --basesUL;
+
+      errUC =
+         faIdxLine(
+            &faIdxST,
+            0,
+            basesUL,
+            bytesUL,
+            fileUL,
+            &shortBl
+         );
+
+      if(errUC) goto cleanUp;
+   } /*If: the last line has no new line*/
+
+   else if(bytesUL > 0) {errUC = 2; goto cleanUp;}
+
+   pFaIdx(&faIdxST, faiFILE); /*Last entry*/
+
+   if(fileUL == 0) errUC = 2; /*Empty file*/
+
+   cleanUp:
+   free(buffStr);
+   freeFaIdxStack(&faIdxST);
+   return errUC;
+} /*mkFaIdx*/
+
+/*-------------------------------------------------------\
+| Fun-07: findFaIdx
+|  - Finds an entry in an index (.fai) file
+| Input:
+|  - faiFILE:
+|    o FILE with the index to search (at its start)
+|  - nameStr:
+|    o C-string with the name of the entry to find
+|  - faIdxST:
+|    o Pointer to faIdx structure to hold the entry
+| Output:
+|  - Modifies:
+|    o faIdxST to have the entry (nameStr is used as a
+|      buffer for the lines in faiFILE)
+|    o faiFILE to be after the entry
+|  - Returns:
+|    o 1: if the entry was found
+|    o 0: if the entry is not in the index
+|    o 2: for an invalid index line
+|    o 64: If malloc failed to find memory
+\-------------------------------------------------------*/
+static unsigned char findFaIdx(
+   FILE *faiFILE,
+   char *nameStr,
+   struct faIdx *faIdxST
+){
+   ulong lenNameUL = strlen(nameStr);
+   ulong lenLineUL = 0;
+   char *tmpStr = 0;
+
+   if(faIdxST->nameStr == 0)
+   { /*If: I need a line buffer*/
+      faIdxST->nameStr = malloc(1024);
+      if(faIdxST->nameStr == 0) return 64;
+      faIdxST->lenNameBuffUL = 1023;
+   } /*If: I need a line buffer*/
+
+   while(1)
+   { /*Loop: check each line in the index*/
+      lenLineUL = 0;
+
+      do{
+         if(lenLineUL + 1 >= faIdxST->lenNameBuffUL)
+         { /*If: the line is longer than the buffer*/
+            if(
+               seqFileGrow(
+                  &faIdxST->nameStr,
+                  &faIdxST->lenNameBuffUL,
+                  faIdxST->lenNameBuffUL << 1,
+                  0
+               )
+            ) return 64;
+         } /*If: the line is longer than the buffer*/
+
+         tmpStr =
+            fgets(
+               faIdxST->nameStr + lenLineUL,
+               faIdxST->lenNameBuffUL - lenLineUL,
+               faiFILE
+            );
+
+         if(tmpStr == 0) break;
+         lenLineUL += strlen(tmpStr);
+      } while(faIdxST->nameStr[lenLineUL - 1] != '\n');
+
+      if(lenLineUL == 0) return 0; /*End of the index*/
+
+      if(
+            lenLineUL <= lenNameUL
+         || faIdxST->nameStr[lenNameUL] != '\t'
+         || strncmp(faIdxST->nameStr, nameStr, lenNameUL)
+      ) continue; /*Not the entry*/
+
+      tmpStr = faIdxST->nameStr + lenNameUL + 1;
+      tmpStr = base10StrToUL(tmpStr, faIdxST->lenSeqUL);
+      if(*tmpStr++ != '\t') return 2;
+      tmpStr = base10StrToUL(tmpStr, faIdxST->offsetUL);
+      if(*tmpStr++ != '\t') return 2;
+      tmpStr = base10StrToUL(tmpStr,faIdxST->lineBasesUL);
+      if(*tmpStr++ != '\t') return 2;
+      tmpStr = base10StrToUL(tmpStr,faIdxST->lineBytesUL);
+      if((unsigned char) *tmpStr > 32) return 2;
+
+      if(faIdxST->lineBytesUL < faIdxST->lineBasesUL)
+         return 2;
+
+      faIdxST->nameStr[lenNameUL] = '\0';
+      faIdxST->lenNameUL = lenNameUL;
+      return 1;
+   } /*Loop: check each line in the index*/
+} /*findFaIdx*/
+
+/*-------------------------------------------------------\
+| Fun-08: faIdxRegionId
+|  - Sets the id of a sequence to >name:start-end (index
+|    1, like samtools faidx)
+| Input:
+|  - seqST:
+|    o Pointer to seqStruct structure to set the id in
+|  - nameStr:
+|    o C-string with the name of the entry
+|  - lenNameUL:
+|    o Number of characters in nameStr to use
+|  - startUL:
+|    o First base in the region (index 0)
+|  - endUL:
+|    o Last base in the region (index 0)
+| Output:
+|  - Modifies:
+|    o idCStr in seqST to have the region (it ends in a
+|      new line, like readSeqFile)
+|  - Returns:
+|    o 0: for no errors
+|    o 64: If malloc failed to find memory
+\-------------------------------------------------------*/
+static unsigned char faIdxRegionId(
+   struct seqStruct *seqST,
+   char *nameStr,
+   ulong lenNameUL,
+   ulong startUL,
+   ulong endUL
+){
+   char *tmpStr = 0;
+   ulong lenIdUL = lenNameUL + 64; /*'>', ':', '-', nums*/
+
+   if(seqST->lenIdBuffUL < lenIdUL)
+   { /*If: I need a larger id buffer*/
+      tmpStr = malloc(lenIdUL + 1);
+      if(tmpStr == 0) return 64;
+
+      /*The name may be in the old id*/
+      memcpy(tmpStr + 1, nameStr, lenNameUL);
+      if(seqST->idCStr != 0) free(seqST->idCStr);
+
+      seqST->idCStr = tmpStr;
+      seqST->lenIdBuffUL = lenIdUL;
+   } /*If: I need a larger id buffer*/
+
+   else memmove(seqST->idCStr + 1, nameStr, lenNameUL);
+
+   seqST->idCStr[0] = '>';
+
+   seqST->lenIdUL = lenNameUL + 1;
+   seqST->lenIdUL +=
+      sprintf(
+         seqST->idCStr + seqST->lenIdUL,
+         ":%lu-%lu\n",
+         startUL + 1,
+         endUL + 1
+      );
+
+   return 0;
+} /*faIdxRegionId*/
+
+/*-------------------------------------------------------\
+| Fun-09: readFaIdxRegion
+|  - Reads a region of an indexed entry. Only the lines
+|    in the region are read.
+| Input:
+|  - faFILE:
+|    o FILE with the fasta file faIdxST is from
+|  - faIdxST:
+|    o Pointer to faIdx structure with the entry (from
+|      findFaIdx)
+|  - startUL:
+|    o First base in the region (index 0)
+|  - endUL:
+|    o Last base in the region (index 0)
+|  - seqST:
+|    o Pointer to seqStruct structure to hold the region
+| Output:
+|  - Modifies:
+|    o seqST to have the region converted to lookup
+|      indexes and the id set to >name:start-end
+|  - Returns:
+|    o 1: if the region was read
+|    o 2: if the file is shorter than the index says or
+|         has white space in the region
+|    o 4: if the region is not in the entry
+|    o 64: If malloc failed to find memory
+\-------------------------------------------------------*/
+static unsigned char readFaIdxRegion(
+   FILE *faFILE,
+   struct faIdx *faIdxST,
+   ulong startUL,
+   ulong endUL,
+   struct seqStruct *seqST
+){
+   ulong firstUL = 0;
+   ulong lastUL = 0;
+   ulong lenUL = 0;
+   ulong ulChar = 0;
+   ulong outUL = 0;
+
+   if(startUL > endUL || endUL >= faIdxST->lenSeqUL)
+      return 4;
+
+   /*Find the bytes the first and last base are at*/
+   firstUL =
+        faIdxST->offsetUL
+      + (startUL / faIdxST->lineBasesUL)
+        * faIdxST->lineBytesUL
+      + startUL % faIdxST->lineBasesUL;
+
+   lastUL =
+        faIdxST->offsetUL
+      + (endUL / faIdxST->lineBasesUL)
+        * faIdxST->lineBytesUL
+      + endUL % faIdxST->lineBasesUL;
+
+   lenUL = lastUL - firstUL + 1;
+
+   if(seqST->lenSeqBuffUL < lenUL)
+   { /*If: I need a larger sequence buffer*/
+      if(seqST->seqCStr != 0) free(seqST->seqCStr);
+      seqST->seqCStr = malloc(lenUL + 1);
+      seqST->lenSeqBuffUL = 0;
+
+      if(seqST->seqCStr == 0) return 64;
+      seqST->lenSeqBuffUL = lenUL;
+   } /*If: I need a larger sequence buffer*/
+
+   /*long is 64 bits on the systems large genomes are on*/
+   if(fseek(faFILE, (long) firstUL, SEEK_SET)) return 2;
+
+   if(fread(seqST->seqCStr, 1, lenUL, faFILE) != lenUL)
+      return 2;
+
+   for(ulChar = 0; ulChar < lenUL; ++ulChar)
+   { /*Loop: remove new lines and convert the bases*/
+      if((unsigned char) seqST->seqCStr[ulChar] < 33)
+         continue;
+
+      seqST->seqCStr[outUL++] =
+         seqFileCnvt(seqST->seqCStr[ulChar]);
+   } /*Loop: remove new lines and convert the bases*/
+
+   if(outUL != endUL - startUL + 1) return 2;
+
+   seqST->seqCStr[outUL] = '\0';
+   seqST->lenSeqUL = outUL;
+   seqST->lenQUL = 0;
+
+   if(
+      faIdxRegionId(
+         seqST,
+         faIdxST->nameStr,
+         faIdxST->lenNameUL,
+         startUL,
+         endUL
+      )
+   ) return 64;
+
+   return 1;
+} /*readFaIdxRegion*/
+
+/*-------------------------------------------------------\
+| Fun-10: scanFaRegion
+|  - Reads a region of an entry without an index. Each
+|    entry is read with readSeqFile till the named entry
+|    is found (for gzip and fastq files).
+| Input:
+|  - faFILE:
+|    o FILE with the fasta or fastq file (at its start)
+|  - nameStr:
+|    o C-string with the name of the entry to find
+|  - startUL:
+|    o First base in the region (index 0)
+|  - endUL:
+|    o Last base in the region (index 0); 0 is the end
+|      of the entry
+|  - seqST:
+|    o Pointer to seqStruct structure to hold the region
+| Output:
+|  - Modifies:
+|    o seqST to have the region converted to lookup
+|      indexes and the id set to >name:start-end
+|  - Returns:
+|    o 1: if the region was read
+|    o 0: if the entry is not in the file
+|    o 2: for an invalid entry
+|    o 4: if the region is not in the entry
+|    o 64: If malloc failed to find memory
+\-------------------------------------------------------*/
+static unsigned char scanFaRegion(
+   FILE *faFILE,
+   char *nameStr,
+   ulong startUL,
+   ulong endUL,
+   struct seqStruct *seqST
+){
+   struct seqFile faFileST;
+   ulong lenNameUL = strlen(nameStr);
+   unsigned char errUC = 0;
+
+   initSeqFile(&faFileST);
+   errUC = openSeqFile(&faFileST, faFILE);
+
+   while(! errUC)
+   { /*Loop: find the entry*/
+      errUC = readSeqFile(&faFileST, seqST, 1);
+      if(errUC != 1) break;
+
+      if(
+            faIdxName(seqST->idCStr + 1) == lenNameUL
+         && ! strncmp(seqST->idCStr+1, nameStr, lenNameUL)
+      ) break; /*Found the entry*/
+
+      errUC = 0;
+   } /*Loop: find the entry*/
+
+   freeSeqFileStack(&faFileST);
+   if(errUC != 1) return errUC;
+
+   if(endUL == 0) endUL = seqST->lenSeqUL - 1;
+
+   if(startUL > endUL || endUL >= seqST->lenSeqUL)
+      return 4;
+
+   memmove(
+      seqST->seqCStr,
+      seqST->seqCStr + startUL,
+      endUL - startUL + 1
+   );
+
+   seqST->lenSeqUL = endUL - startUL + 1;
+   seqST->seqCStr[seqST->lenSeqUL] = '\0';
+   seqST->lenQUL = 0;
+
+   if(
+      faIdxRegionId(
+         seqST,
+         seqST->idCStr + 1,
+         lenNameUL,
+         startUL,
+         endUL
+      )
+   ) return 64;
+
+   return 1;
+} /*scanFaRegion*/
+
+/*-------------------------------------------------------\
+| Fun-11: readFaRegion
+|  - Reads a region of an entry in a fasta file. The
+|    index (file.fai) is used when it exists. If not, it
+|    is built and saved (or kept in a temporary file when
+|    it can not be saved).
+| Input:
+|  - fileStr:
+|    o C-string with the name of the fasta file
+|  - nameStr:
+|    o C-string with the name of the entry to read
+|  - startUL:
+|    o First base in the region (index 0)
+|  - endUL:
+|    o Last base in the region (index 0); 0 is the end
+|      of the entry
+|  - seqST:
+|    o Pointer to seqStruct structure to hold the region
+| Output:
+|  - Modifies:
+|    o seqST to have the region converted to lookup
+|      indexes and the id set to >name:start-end
+|  - Prints:
+|    o The index to file.fai if there was no index
+|  - Returns:
+|    o 1: if the region was read
+|    o 0: if the entry is not in the file
+|    o 2: for an invalid file or index
+|    o 4: if the region is not in the entry
+|    o 8: if the file could not be opened
+|    o 64: If malloc failed to find memory
+| Note:
+|  - The index is not checked against the file, so it
+|    needs to be rebuilt (deleted) when the file changes
+\-------------------------------------------------------*/
+static unsigned char readFaRegion(
+   char *fileStr,
+   char *nameStr,
+   ulong startUL,
+   ulong endUL,
+   struct seqStruct *seqST
+){
+   struct faIdx faIdxST;
+   FILE *faFILE = 0;
+   FILE *faiFILE = 0;
+   char *faiStr = 0;
+   int firstI = 0;
+   unsigned char errUC = 0;
+
+   initFaIdx(&faIdxST);
+
+   faFILE = fopen(fileStr, "r");
+   if(faFILE == 0) return 8;
+
+   /*gzip and fastq files can not be indexed*/
+   do{
+      firstI = getc(faFILE);
+   } while(firstI != EOF && firstI < 33);
+
+   rewind(faFILE);
+
+   if(firstI != '>')
+   { /*If: this is not a plain fasta file*/
+      errUC =
+         scanFaRegion(faFILE,nameStr,startUL,endUL,seqST);
+      goto cleanUp;
+   } /*If: this is not a plain fasta file*/
+
+   faiStr = malloc(strlen(fileStr) + 5);
+   if(faiStr == 0) {errUC = 64; goto cleanUp;}
+
+   sprintf(faiStr, "%s.fai", fileStr);
+   faiFILE = fopen(faiStr, "r");
+
+   if(faiFILE == 0)
+   { /*If: there is no index*/
+      faiFILE = fopen(faiStr, "w+");
+      if(faiFILE == 0) faiFILE = tmpfile(); /*Can not save*/
+      if(faiFILE == 0) {errUC = 8; goto cleanUp;}
+
+      errUC = mkFaIdx(faFILE, faiFILE);
+
+      if(errUC == 2)
+      { /*If: the file can not be indexed*/
+         fclose(faiFILE);
+         faiFILE = 0;
+         remove(faiStr);
+
+         rewind(faFILE);
+         errUC =
+            scanFaRegion(
+               faFILE,
+               nameStr,
+               startUL,
+               endUL,
+               seqST
+            );
+         goto cleanUp;
+      } /*If: the file can not be indexed*/
+
+      if(errUC) goto cleanUp;
+      rewind(faiFILE);
+   } /*If: there is no index*/
+
+   errUC = findFaIdx(faiFILE, nameStr, &faIdxST);
+   if(errUC != 1) goto cleanUp;
+
+   if(endUL == 0) endUL = faIdxST.lenSeqUL - 1;
+
+   errUC =
+      readFaIdxRegion(
+         faFILE,
+         &faIdxST,
+         startUL,
+         endUL,
+         seqST
+      );
+
+   cleanUp:
+   if(faiFILE != 0) fclose(faiFILE);
+   if(faiStr != 0) free(faiStr);
+   freeFaIdxStack(&faIdxST);
+   fclose(faFILE);
+   return errUC;
+} /*readFaRegion*/
+
+#endif
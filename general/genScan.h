@@ -808,10 +808,9 @@
 |   - Maximizes the score for a single base pair in an
 |     waterman query reference scan
 | Input;
-|   - refBase;
-|     o Reference base to find score for
-|   - qryBase;
-|     o Query base to find score for
+|   - baseScore;
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - gapDiff:
 |     o Gap Exentsion score - gap open score.
 |     o This is used to find the indel scores
@@ -835,8 +834,7 @@
 |     o delScore to hold the score for the next deletion
 \-------------------------------------------------------*/
 #define waterScanMaxScore(\
-   refBase,     /*Reference Base*/\
-   qryBase,     /*Query Base*/\
+   baseScore,   /*Score for ref/query bases*/\
    gapDiff,    /*GapExtend - gapOpen*/\
    scoreOn,     /*Score to update*/\
    dirOn,       /*Direction to update*/\
@@ -851,7 +849,7 @@
 ){ /*waterScanMaxScore*/\
    long macroSnpScoreL =\
         (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
     \
     long macroInsScoreL =\
          (scoreOn)\
@@ -885,7 +883,7 @@
     \
     (delScore) =\
          (scoreOn)\
-       + ((gapDiff) & (-(dirOn) != defMvSnp))\
+       + ((gapDiff) & (-((dirOn) != defMvSnp)))\
        + (alnSetPtr)->gapOpenC;\
 } /*waterScanMaxScore*/
 
@@ -895,10 +893,9 @@
 |   - This for the end of a row, were you do not want the
 |     next snp or deletion score
 | Input;
-|   - refBase;
-|     o Reference base to find score for
-|   - qryBase;
-|     o Query base to find score for
+|   - baseScore;
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - gapDiff:
 |     o Gap Exentsion score - gap open score.
 |     o This is used to find the indel scores
@@ -917,8 +914,7 @@
 |     o dirOn to hold the direction of the max score
 \-------------------------------------------------------*/
 #define waterScanMaxEndRowScore(\
-   refBase,     /*Reference Base*/\
-   qryBase,     /*Query Base*/\
+   baseScore,   /*Score for ref/query bases*/\
    gapDiff,    /*GapExtend - gapOpen*/\
    scoreOn,     /*Score to update*/\
    dirOn,       /*Direction to update*/\
@@ -933,7 +929,7 @@
 ){ /*waterMaxEndRowScore*/\
    long macroSnpScoreL =\
       (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
     \
     long macroInsScoreL =\
          (scoreOn)\
@@ -970,10 +966,9 @@
 |     waterman query reference scan. This function does
 |     not apply a gap extension penalty
 | Input;
-|   - refBase;
-|     o Reference base to find score for
-|   - qryBase;
-|     o Query base to find score for
+|   - baseScore;
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - scoreOn:
 |     o Score to update/score for an insertion
 |   - dirOn;
@@ -994,8 +989,7 @@
 |     o delScore to hold the score for the next deletion
 \-------------------------------------------------------*/
 #define waterScanMaxScoreNoGap(\
-   refBase,     /*Reference Base*/\
-   qryBase,     /*Query Base*/\
+   baseScore,   /*Score for ref/query bases*/\
    scoreOn,     /*Score to update*/\
    dirOn,       /*Direction to update*/\
    index,       /*Start of alignment for kept dir*/\
@@ -1009,7 +1003,13 @@
 ){ /*waterScanMaxScoreNoGap*/\
    long macroSnpScoreL =\
         (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
+    \
+    /*scanMaxScore sets scoreOn before it is done with
+    ` the insertion score, so find it first
+    */\
+    long macroInsScoreL =\
+       (scoreOn) + (alnSetPtr)->gapOpenC;\
     \
     ulong keepDirUL = 0;\
     (nextSnpScore) = (scoreOn);/*Score to find next snp*/\
@@ -1019,7 +1019,7 @@
        (dirOn),\
        (index),\
        (macroSnpScoreL),\
-       ((scoreOn) + (alnSetPtr)->gapOpenC),\
+       (macroInsScoreL),\
        (delScore),\
        (snpPos),\
        (insPos),\
@@ -1046,10 +1046,9 @@
 |   - This for the end of a row, were you do not want the
 |     next snp or deletion score
 | Input;
-|   - refBase;
-|     o Reference base to find score for
-|   - qryBase;
-|     o Query base to find score for
+|   - baseScore;
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - scoreOn:
 |     o Score to update/score for an insertion
 |   - dirOn;
@@ -1065,8 +1064,7 @@
 |     o dirOn to hold the direction of the max score
 \-------------------------------------------------------*/
 #define waterScanMaxEndRowScoreNoGap(\
-   refBase,     /*Reference Base*/\
-   qryBase,     /*Query Base*/\
+   baseScore,   /*Score for ref/query bases*/\
    scoreOn,     /*Score to update*/\
    dirOn,       /*Direction to update*/\
    index,       /*Start of alignment for kept dir*/\
@@ -1080,7 +1078,13 @@
 ){ /*waterMaxEndRowScoreNoGap*/\
    long macroSnpScoreL =\
       (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
+    \
+    /*scanMaxScore sets scoreOn before it is done with
+    ` the insertion score, so find it first
+    */\
+    long macroInsScoreL =\
+       (scoreOn) + (alnSetPtr)->gapOpenC;\
     \
     ulong keepDirUL = 0;\
     \
@@ -1089,7 +1093,7 @@
        (dirOn),\
        (index),\
        (macroSnpScoreL),\
-       ((scoreOn) + (alnSetPtr)->gapOpenC),\
+       (macroInsScoreL),\
        (delScore),\
        (snpPos),\
        (insPos),\
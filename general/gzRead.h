@@ -0,0 +1,505 @@
+/*########################################################
+# Name: gzRead
+# Use:
+#  - Reads a gzip file as if it were not compressed. The
+#    file is decompressed on its own thread, which hands
+#    filled blocks to the reader, so decompressing can
+#    happen while the reader parses and aligns.
+#  - The thread fills at most defGzNumBlocks blocks ahead
+#    of the reader, so memory use does not depend on the
+#    file size
+#  - Uses the bundled decompressor (inflate.h) by default.
+#    Compile with -DZLIB (and link with -lz) to use the
+#    system zlib instead.
+# Libraries:
+#  - "inflate.h" (not -DZLIB)
+#  o "dataTypeShortHand.h"
+# C Standard Libraries:
+#  o <stdlib.h>
+#  o <stdio.h>
+#  o <string.h>
+#  o <pthread.h> (POSIX, not C standard)
+#  o <zlib.h> (-DZLIB only; not C standard)
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Includes and structures
+'  o fun-01 gzReadPut:
+'    - Adds decompressed bytes to the blocks (thread)
+'  o fun-02 gzReadThread:
+'    - Decompresses the file (run by the thread)
+'  o fun-03 openGzRead:
+'    - Starts decompressing a gzip file
+'  o fun-04 readGzRead:
+'    - Gets decompressed bytes (like fread)
+'  o fun-05 freeGzReadStack:
+'    - Stops the thread and frees the blocks
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes and structures
+\-------------------------------------------------------*/
+
+#ifndef GZREAD_H
+#define GZREAD_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#ifdef ZLIB
+   #include <zlib.h>
+   #include "dataTypeShortHand.h"
+#else
+   #include "inflate.h"
+#endif
+
+#define defGzBlock (1 << 18)  /*Decompressed bytes a block*/
+#define defGzNumBlocks 4      /*Blocks the thread can fill*/
+#define defGzIn (1 << 16)     /*Compressed bytes per fread*/
+
+/*-------------------------------------------------------\
+| Struct-01: gzRead
+|  - Blocks passed from the decompress thread to the
+|    reader
+|  - Blocks are used as a ring. The reader takes block
+|    takeI and the thread fills block
+|    (takeI + numFullI) % defGzNumBlocks.
+\-------------------------------------------------------*/
+struct gzRead{
+   FILE *inFILE;      /*Compressed file (caller closes)*/
+   uchar *preStr;     /*Bytes read before openGzRead*/
+   ulong lenPreUL;    /*Bytes in preStr*/
+
+   char *blockAryStr[defGzNumBlocks];
+   ulong lenBlockAryUL[defGzNumBlocks]; /*Bytes in block*/
+   int takeI;         /*Block the reader is on*/
+   int numFullI;      /*Blocks filled (and not used)*/
+   ulong usedUL;      /*Bytes used in block takeI*/
+   ulong fillUL;      /*Bytes the thread put in a block*/
+
+   char doneBl;       /*1: thread added its last block*/
+   char stopBl;       /*1: reader wants thread to stop*/
+   uchar errUC;       /*2: bad gzip file; 64: memory*/
+
+   char threadBl;     /*1: the thread was started*/
+   pthread_t threadST;
+   pthread_mutex_t lockMutex;
+     /*Guards takeI, numFullI, doneBl, stopBl, errUC*/
+   pthread_cond_t fullCond;  /*Signaled for new blocks*/
+   pthread_cond_t emptyCond; /*Signaled for used blocks*/
+};
+
+/*-------------------------------------------------------\
+| Fun-01: gzReadPut
+|  - Adds decompressed bytes to the blocks. This is only
+|    called by the decompress thread.
+| Input:
+|  - gzPtr:
+|    o Pointer to the gzRead structure to add bytes to
+|  - outStr:
+|    o Decompressed bytes to add
+|  - lenUL:
+|    o Number of bytes in outStr
+| Output:
+|  - Modifies:
+|    o blocks in gzPtr to have outStr. Waits for the
+|      reader when all blocks are full.
+|  - Returns:
+|    o 0 for no errors
+|    o 1 if the reader wants the thread to stop
+\-------------------------------------------------------*/
+static char gzReadPut(
+   void *gzPtr,
+   uchar *outStr,
+   ulong lenUL
+){
+   struct gzRead *gzST = (struct gzRead *) gzPtr;
+   ulong copyUL = 0;
+   int fillI = 0;
+
+   while(lenUL > 0)
+   { /*Loop: copy the bytes into blocks*/
+      pthread_mutex_lock(&gzST->lockMutex);
+
+      while(
+            gzST->numFullI == defGzNumBlocks
+         && ! gzST->stopBl
+      ) pthread_cond_wait(
+            &gzST->emptyCond,
+            &gzST->lockMutex
+         );
+
+      if(gzST->stopBl)
+      { /*If: the reader is done*/
+         pthread_mutex_unlock(&gzST->lockMutex);
+         return 1;
+      } /*If: the reader is done*/
+
+      fillI =
+         (gzST->takeI + gzST->numFullI) % defGzNumBlocks;
+
+      pthread_mutex_unlock(&gzST->lockMutex);
+
+      /*The reader never touches this block till it is
+      ` marked as full
+      */
+      copyUL = defGzBlock - gzST->fillUL;
+      if(copyUL > lenUL) copyUL = lenUL;
+
+      memcpy(
+         gzST->blockAryStr[fillI] + gzST->fillUL,
+         outStr,
+         copyUL
+      );
+
+      gzST->fillUL += copyUL;
+      outStr += copyUL;
+      lenUL -= copyUL;
+
+      if(gzST->fillUL == defGzBlock)
+      { /*If: I filled a block*/
+         gzST->lenBlockAryUL[fillI] = defGzBlock;
+         gzST->fillUL = 0;
+
+         pthread_mutex_lock(&gzST->lockMutex);
+         ++gzST->numFullI;
+         pthread_cond_signal(&gzST->fullCond);
+         pthread_mutex_unlock(&gzST->lockMutex);
+      } /*If: I filled a block*/
+   } /*Loop: copy the bytes into blocks*/
+
+   return 0;
+} /*gzReadPut*/
+
+/*-------------------------------------------------------\
+| Fun-02: gzReadThread
+|  - Decompresses the file into the blocks (function the
+|    decompress thread runs)
+| Input:
+|  - gzPtr:
+|    o Pointer to the gzRead structure to decompress
+| Output:
+|  - Modifies:
+|    o blocks in gzPtr to have the decompressed file
+|    o errUC in gzPtr to be 2 for invalid gzip files and
+|      64 for memory errors
+|    o doneBl in gzPtr to be 1
+|  - Returns:
+|    o 0
+\-------------------------------------------------------*/
+static void * gzReadThread(
+   void *gzPtr
+){
+   struct gzRead *gzST = (struct gzRead *) gzPtr;
+   uchar errUC = 0;
+   int fillI = 0;
+
+#ifdef ZLIB
+   z_stream zST;
+   uchar *inStr = malloc(defGzIn);
+   uchar *outStr = malloc(defGzBlock);
+   ulong readUL = 0;
+   int zErrI = 0;
+   char endBl = 0;   /*1: at the end of a member*/
+
+   memset(&zST, 0, sizeof(zST));
+
+   if(inStr == 0 || outStr == 0) errUC = 64;
+   else if(inflateInit2(&zST, 15 + 16) != Z_OK) errUC = 64;
+
+   zST.next_in = gzST->preStr;
+   zST.avail_in = (uInt) gzST->lenPreUL;
+
+   while(! errUC)
+   { /*Loop: decompress the file*/
+      if(zST.avail_in == 0)
+      { /*If: I need more input*/
+         readUL =
+            fread(
+               inStr,
+               sizeof(uchar),
+               defGzIn,
+               gzST->inFILE
+            );
+
+         if(readUL == 0)
+         { /*If: the file ended*/
+            if(! endBl) errUC = 2; /*Cut off member*/
+            break;
+         } /*If: the file ended*/
+
+         zST.next_in = inStr;
+         zST.avail_in = (uInt) readUL;
+      } /*If: I need more input*/
+
+      if(endBl)
+      { /*If: checking for another member*/
+         if(*zST.next_in != 0x1f) break; /*Not gzip*/
+         inflateReset(&zST);
+         endBl = 0;
+      } /*If: checking for another member*/
+
+      zST.next_out = outStr;
+      zST.avail_out = defGzBlock;
+      zErrI = inflate(&zST, Z_NO_FLUSH);
+
+      if(zErrI == Z_MEM_ERROR) errUC = 64;
+      else if(zErrI == Z_DATA_ERROR) errUC = 2;
+      else if(zErrI == Z_NEED_DICT) errUC = 2;
+      else if(zErrI == Z_STREAM_END) endBl = 1;
+
+      if(
+            zST.avail_out < defGzBlock
+         && gzReadPut(
+               gzST,
+               outStr,
+               defGzBlock - zST.avail_out
+            )
+      ) break; /*Reader is done*/
+   } /*Loop: decompress the file*/
+
+   inflateEnd(&zST);
+   if(inStr != 0) free(inStr);
+   if(outStr != 0) free(outStr);
+#else
+   struct inflate inflateST;
+
+   errUC =
+      (uchar)
+      initInflate(
+         &inflateST,
+         gzST->inFILE,
+         gzST->preStr,
+         gzST->lenPreUL,
+         gzReadPut,
+         gzST
+      );
+
+   if(! errUC) errUC = (uchar) inflateGz(&inflateST);
+   if(errUC == 4) errUC = 0; /*The reader stopped me*/
+
+   /*Hand off what was decompressed before an error, so
+   ` entries before the bad data can still be read
+   */
+   if(errUC == 2) inflateFlush(&inflateST);
+
+   freeInflateStack(&inflateST);
+#endif
+
+   /*Hand off the last (partly filled) block*/
+   pthread_mutex_lock(&gzST->lockMutex);
+
+   if(gzST->fillUL > 0 && ! gzST->stopBl)
+   { /*If: I have a partly filled block*/
+      fillI =
+         (gzST->takeI + gzST->numFullI) % defGzNumBlocks;
+
+      gzST->lenBlockAryUL[fillI] = gzST->fillUL;
+      ++gzST->numFullI;
+   } /*If: I have a partly filled block*/
+
+   gzST->errUC = errUC;
+   gzST->doneBl = 1;
+   pthread_cond_signal(&gzST->fullCond);
+   pthread_mutex_unlock(&gzST->lockMutex);
+
+   return 0;
+} /*gzReadThread*/
+
+/*-------------------------------------------------------\
+| Fun-03: openGzRead
+|  - Starts decompressing a gzip file on its own thread
+| Input:
+|  - gzST:
+|    o Pointer to gzRead structure to set up
+|  - inFILE:
+|    o gzip FILE to read. Nothing else should read from
+|      inFILE till freeGzReadStack is called.
+|  - preStr:
+|    o Bytes already read from the start of inFILE (the
+|      gzip header check). These are copied.
+|  - lenPreUL:
+|    o Number of bytes in preStr
+| Output:
+|  - Modifies:
+|    o gzST to be decompressing inFILE
+|  - Returns:
+|    o 0 for no errors
+|    o 64 for memory errors (call freeGzReadStack)
+\-------------------------------------------------------*/
+static char openGzRead(
+   struct gzRead *gzST,
+   FILE *inFILE,
+   char *preStr,
+   ulong lenPreUL
+){
+   int iBlock = 0;
+
+   gzST->inFILE = inFILE;
+   gzST->takeI = 0;
+   gzST->numFullI = 0;
+   gzST->usedUL = 0;
+   gzST->fillUL = 0;
+   gzST->doneBl = 0;
+   gzST->stopBl = 0;
+   gzST->errUC = 0;
+   gzST->threadBl = 0;
+   gzST->lenPreUL = lenPreUL;
+
+   for(iBlock = 0; iBlock < defGzNumBlocks; ++iBlock)
+      gzST->blockAryStr[iBlock] = 0;
+
+   gzST->preStr = malloc(lenPreUL + 1);
+   if(gzST->preStr == 0) return 64;
+   memcpy(gzST->preStr, preStr, lenPreUL);
+
+   for(iBlock = 0; iBlock < defGzNumBlocks; ++iBlock)
+   { /*Loop: allocate the blocks*/
+      gzST->blockAryStr[iBlock] = malloc(defGzBlock);
+      if(gzST->blockAryStr[iBlock] == 0) return 64;
+      gzST->lenBlockAryUL[iBlock] = 0;
+   } /*Loop: allocate the blocks*/
+
+   pthread_mutex_init(&gzST->lockMutex, 0);
+   pthread_cond_init(&gzST->fullCond, 0);
+   pthread_cond_init(&gzST->emptyCond, 0);
+   gzST->threadBl = 1;
+
+   if(pthread_create(&gzST->threadST,0,gzReadThread,gzST))
+   { /*If: I could not start the thread*/
+      gzST->threadBl = 0;
+      pthread_mutex_destroy(&gzST->lockMutex);
+      pthread_cond_destroy(&gzST->fullCond);
+      pthread_cond_destroy(&gzST->emptyCond);
+      return 64;
+   } /*If: I could not start the thread*/
+
+   return 0;
+} /*openGzRead*/
+
+/*-------------------------------------------------------\
+| Fun-04: readGzRead
+|  - Gets decompressed bytes from a gzip file (like
+|    fread)
+| Input:
+|  - gzST:
+|    o Pointer to gzRead structure set up by openGzRead
+|  - outStr:
+|    o Buffer to copy the bytes to
+|  - lenUL:
+|    o Most bytes to copy
+| Output:
+|  - Modifies:
+|    o outStr to have the next bytes in the file
+|    o gzST to be past the copied bytes (used blocks are
+|      handed back to the thread)
+|  - Returns:
+|    o Number of bytes copied. This is less than lenUL
+|      only at the end of the file or for errors (check
+|      errUC in gzST).
+\-------------------------------------------------------*/
+static ulong readGzRead(
+   struct gzRead *gzST,
+   char *outStr,
+   ulong lenUL
+){
+   ulong copyUL = 0;
+   ulong doneUL = 0;
+   char *blockStr = 0;
+
+   while(doneUL < lenUL)
+   { /*Loop: copy bytes from the blocks*/
+      pthread_mutex_lock(&gzST->lockMutex);
+
+      while(gzST->numFullI == 0 && ! gzST->doneBl)
+         pthread_cond_wait(
+            &gzST->fullCond,
+            &gzST->lockMutex
+         );
+
+      if(gzST->numFullI == 0)
+      { /*If: there are no more blocks*/
+         pthread_mutex_unlock(&gzST->lockMutex);
+         break;
+      } /*If: there are no more blocks*/
+
+      pthread_mutex_unlock(&gzST->lockMutex);
+
+      /*The thread does not change a full block*/
+      blockStr = gzST->blockAryStr[gzST->takeI];
+      copyUL = gzST->lenBlockAryUL[gzST->takeI];
+      copyUL -= gzST->usedUL;
+      if(copyUL > lenUL - doneUL) copyUL = lenUL - doneUL;
+
+      memcpy(
+         outStr + doneUL,
+         blockStr + gzST->usedUL,
+         copyUL
+      );
+
+      doneUL += copyUL;
+      gzST->usedUL += copyUL;
+
+      if(gzST->usedUL == gzST->lenBlockAryUL[gzST->takeI])
+      { /*If: I used up the block*/
+         pthread_mutex_lock(&gzST->lockMutex);
+         gzST->takeI = (gzST->takeI + 1) % defGzNumBlocks;
+         --gzST->numFullI;
+         gzST->usedUL = 0;
+         pthread_cond_signal(&gzST->emptyCond);
+         pthread_mutex_unlock(&gzST->lockMutex);
+      } /*If: I used up the block*/
+   } /*Loop: copy bytes from the blocks*/
+
+   return doneUL;
+} /*readGzRead*/
+
+/*-------------------------------------------------------\
+| Fun-05: freeGzReadStack
+|  - Stops the decompress thread (if it is running) and
+|    frees the memory in a gzRead structure (not the FILE)
+| Input:
+|  - gzST:
+|    o Pointer to gzRead structure to free memory in
+| Output:
+|  - Frees:
+|    o The blocks in gzST
+|  - Modifies:
+|    o threadBl in gzST to be 0
+\-------------------------------------------------------*/
+static void freeGzReadStack(
+   struct gzRead *gzST
+){
+   int iBlock = 0;
+
+   if(gzST->threadBl)
+   { /*If: I need to stop the thread*/
+      pthread_mutex_lock(&gzST->lockMutex);
+      gzST->stopBl = 1;
+      pthread_cond_signal(&gzST->emptyCond);
+      pthread_mutex_unlock(&gzST->lockMutex);
+
+      pthread_join(gzST->threadST, 0);
+      pthread_mutex_destroy(&gzST->lockMutex);
+      pthread_cond_destroy(&gzST->fullCond);
+      pthread_cond_destroy(&gzST->emptyCond);
+      gzST->threadBl = 0;
+   } /*If: I need to stop the thread*/
+
+   for(iBlock = 0; iBlock < defGzNumBlocks; ++iBlock)
+   { /*Loop: free the blocks*/
+      if(gzST->blockAryStr[iBlock] != 0)
+         free(gzST->blockAryStr[iBlock]);
+      gzST->blockAryStr[iBlock] = 0;
+   } /*Loop: free the blocks*/
+
+   if(gzST->preStr != 0) free(gzST->preStr);
+   gzST->preStr = 0;
+} /*freeGzReadStack*/
+
+#endif
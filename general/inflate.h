@@ -0,0 +1,1078 @@
+/*########################################################
+# Name: inflate
+# Use:
+#  - Holds a small gzip (RFC 1952) and deflate (RFC 1951)
+#    decompressor, so alnSeq can read .gz files without
+#    zlib (keeps the static build)
+#  - Input is read from a FILE as it is needed and output
+#    is handed to a function in chunks, so a file never
+#    has to be decompressed to memory or disk first
+#  - Concatenated gzip files (several members, like bgzip
+#    makes) are read as one file
+#  - Huffman codes of up to defInflateFast bits are found
+#    with one table look up. Longer codes are decoded one
+#    bit at a time (canonical decoding).
+# Libraries:
+#  - "dataTypeShortHand.h"
+# C Standard Libraries:
+#  o <stdlib.h>
+#  o <stdio.h>
+#  o <string.h>
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Includes and structures
+'  o fun-01 initInflate:
+'    - Sets up an inflate structure (allocates memory)
+'  o fun-02 freeInflateStack:
+'    - Frees the memory in an inflate structure
+'  o fun-03 inflateInByte:
+'    - Gets the next byte from the input file
+'  o fun-04 inflateFillBits:
+'    - Adds input bytes to the bit buffer
+'  o fun-05 inflateGetBits:
+'    - Removes bits from the bit buffer
+'  o fun-06 inflateGetByte:
+'    - Gets the next byte after the bit buffer is byte
+'      aligned (headers, stored blocks, and trailers)
+'  o fun-07 inflateCrc:
+'    - Adds new output to the crc32 of a member
+'  o fun-08 inflateFlush:
+'    - Hands the output to the flush function and slides
+'      the window
+'  o fun-09 inflateMkHuff:
+'    - Builds a Huffman table from code lengths
+'  o fun-10 inflateDecode:
+'    - Decodes one Huffman symbol
+'  o fun-11 inflateCodes:
+'    - Decodes the literals and matches in one block
+'  o fun-12 inflateDynamic:
+'    - Reads the code tables for a dynamic block
+'  o fun-13 inflateStored:
+'    - Copies a stored (not compressed) block
+'  o fun-14 inflateGz:
+'    - Decompresses every gzip member in the file
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes and structures
+\-------------------------------------------------------*/
+
+#ifndef INFLATE_H
+#define INFLATE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "dataTypeShortHand.h"
+
+#define defInflateDist (1 << 15)  /*Deflate history size*/
+#define defInflateOut (1 << 18)   /*Bytes per flush*/
+#define defInflateWin (defInflateDist + defInflateOut)
+#define defInflateIn (1 << 16)    /*Bytes per fread*/
+#define defInflateFast 10         /*Bits in fast table*/
+#define defInflateMaxBits 15      /*Longest deflate code*/
+
+/*-------------------------------------------------------\
+| Struct-01: inflateHuff
+|  - Huffman table for literals/lengths or distances
+\-------------------------------------------------------*/
+struct inflateHuff{
+   short countAryS[defInflateMaxBits + 1]; /*Per length*/
+   short symAryS[288];     /*Symbols sorted by code*/
+
+   /*(symbol << 4) | code length; 0 for longer codes*/
+   ushort fastAryUS[1 << defInflateFast];
+};
+
+/*-------------------------------------------------------\
+| Struct-02: inflate
+|  - Holds the input, bit buffer, and output window for
+|    decompressing a gzip file
+\-------------------------------------------------------*/
+struct inflate{
+   FILE *inFILE;
+   uchar *inStr;     /*Input buffer*/
+   ulong lenInUL;    /*Bytes in inStr*/
+   ulong posInUL;    /*Next byte in inStr*/
+
+   ulong bitsUL;     /*Bits read in, but not used*/
+   int numBitsI;     /*Number of bits in bitsUL*/
+
+   /*Output. The last defInflateDist bytes are kept after
+   ` a flush for matches (back references).
+   */
+   uchar *winStr;
+   ulong posWinUL;   /*Next byte to write*/
+   ulong flushUL;    /*First byte not flushed*/
+   ulong crcPosUL;   /*First byte not in crcUI*/
+   ulong totalUL;    /*Bytes output in this member*/
+
+   uint crcUI;       /*crc32 of this member*/
+   uint crcAryUI[256];
+
+   struct inflateHuff lenHuffST;
+   struct inflateHuff distHuffST;
+
+   /*Gets each chunk of output. Returns 0 to keep going
+   ` or not 0 to stop decompressing.
+   */
+   char (*flushFun)(void *, uchar *, ulong);
+   void *flushPtr;   /*First input to flushFun*/
+};
+
+/*-------------------------------------------------------\
+| Fun-01: initInflate
+|  - Sets up an inflate structure
+| Input:
+|  - inflateST:
+|    o Pointer to inflate structure to set up
+|  - inFILE:
+|    o FILE with the gzip file to read
+|  - preStr:
+|    o Bytes already read from inFILE (0 for none). These
+|      are decompressed before anything else in inFILE.
+|  - lenPreUL:
+|    o Number of bytes in preStr
+|  - flushFun:
+|    o Function to give each chunk of output to
+|  - flushPtr:
+|    o First input to flushFun
+| Output:
+|  - Modifies:
+|    o inflateST to be ready for inflateGz
+|  - Returns:
+|    o 0 for no errors
+|    o 64 for memory errors
+\-------------------------------------------------------*/
+static char initInflate(
+   struct inflate *inflateST,
+   FILE *inFILE,
+   uchar *preStr,
+   ulong lenPreUL,
+   char (*flushFun)(void *, uchar *, ulong),
+   void *flushPtr
+){
+   uint crcUI = 0;
+   int iByte = 0;
+   int iBit = 0;
+
+   inflateST->inFILE = inFILE;
+   inflateST->flushFun = flushFun;
+   inflateST->flushPtr = flushPtr;
+   inflateST->bitsUL = 0;
+   inflateST->numBitsI = 0;
+   inflateST->posWinUL = 0;
+   inflateST->flushUL = 0;
+   inflateST->crcPosUL = 0;
+   inflateST->totalUL = 0;
+   inflateST->crcUI = 0;
+
+   if(lenPreUL < defInflateIn) inflateST->inStr =
+      malloc(defInflateIn);
+   else inflateST->inStr = malloc(lenPreUL);
+
+   inflateST->winStr = malloc(defInflateWin);
+
+   if(inflateST->inStr == 0 || inflateST->winStr == 0)
+      return 64;
+
+   if(lenPreUL > 0)
+      memcpy(inflateST->inStr, preStr, lenPreUL);
+
+   inflateST->lenInUL = lenPreUL;
+   inflateST->posInUL = 0;
+
+   /*crc32 table (reversed 0x04c11db7 polynomial)*/
+   for(iByte = 0; iByte < 256; ++iByte)
+   { /*Loop: build the crc32 table*/
+      crcUI = (uint) iByte;
+
+      for(iBit = 0; iBit < 8; ++iBit)
+      { /*Loop: divide out each bit*/
+         if(crcUI & 1) crcUI = 0xedb88320U ^ (crcUI >> 1);
+         else crcUI >>= 1;
+      } /*Loop: divide out each bit*/
+
+      inflateST->crcAryUI[iByte] = crcUI;
+   } /*Loop: build the crc32 table*/
+
+   return 0;
+} /*initInflate*/
+
+/*-------------------------------------------------------\
+| Fun-02: freeInflateStack
+|  - Frees the memory in an inflate structure (not the
+|    FILE)
+| Input:
+|  - inflateST:
+|    o Pointer to inflate structure to free memory in
+| Output:
+|  - Frees:
+|    o inStr and winStr in inflateST (set to 0)
+\-------------------------------------------------------*/
+static void freeInflateStack(
+   struct inflate *inflateST
+){
+   if(inflateST->inStr != 0) free(inflateST->inStr);
+   if(inflateST->winStr != 0) free(inflateST->winStr);
+   inflateST->inStr = 0;
+   inflateST->winStr = 0;
+} /*freeInflateStack*/
+
+/*-------------------------------------------------------\
+| Fun-03: inflateInByte
+|  - Gets the next byte from the input
+| Input:
+|  - inflateST:
+|    o Pointer to inflate structure to read from
+| Output:
+|  - Modifies:
+|    o inStr in inflateST to have the next input block
+|      when the old one is used up
+|  - Returns:
+|    o The next byte
+|    o -1 for end of file
+\-------------------------------------------------------*/
+static int inflateInByte(
+   struct inflate *inflateST
+){
+   if(inflateST->posInUL >= inflateST->lenInUL)
+   { /*If: I need more input*/
+      inflateST->lenInUL =
+         fread(
+            inflateST->inStr,
+            sizeof(uchar),
+            defInflateIn,
+            inflateST->inFILE
+         );
+
+      inflateST->posInUL = 0;
+      if(inflateST->lenInUL == 0) return -1;
+   } /*If: I need more input*/
+
+   return inflateST->inStr[inflateST->posInUL++];
+} /*inflateInByte*/
+
+/*-------------------------------------------------------\
+| Fun-04: inflateFillBits
+|  - Adds input bytes to the bit buffer till it has at
+|    least numBitsI bits or the input ends
+| Input:
+|  - inflateST:
+|    o Pointer to inflate structure to fill
+|  - numBitsI:
+|    o Bits wanted (at most 32)
+| Output:
+|  - Modifies:
+|    o bitsUL and numBitsI in inflateST
+|  - Returns:
+|    o 0 if there are numBitsI bits
+|    o 1 if the input ended first
+\-------------------------------------------------------*/
+static char inflateFillBits(
+   struct inflate *inflateST,
+   int numBitsI
+){
+   int byteI = 0;
+
+   while(inflateST->numBitsI < numBitsI)
+   { /*Loop: add bytes*/
+      byteI = inflateInByte(inflateST);
+      if(byteI < 0) return 1;
+
+      inflateST->bitsUL |=
+         ((ulong) byteI) << inflateST->numBitsI;
+      inflateST->numBitsI += 8;
+   } /*Loop: add bytes*/
+
+   return 0;
+} /*inflateFillBits*/
+
+/*-------------------------------------------------------\
+| Fun-05: inflateGetBits
+|  - Removes bits from the bit buffer (first bit read is
+|    the lowest bit)
+| Input:
+|  - inflateST:
+|    o Pointer to inflate structure to get bits from
+|  - numBitsI:
+|    o Number of bits to get (at most 16)
+|  - errCPtr:
+|    o Set to 2 if the input ended
+| Output:
+|  - Modifies:
+|    o bitsUL and numBitsI in inflateST
+|  - Returns:
+|    o The bits
+\-------------------------------------------------------*/
+static uint inflateGetBits(
+   struct inflate *inflateST,
+   int numBitsI,
+   char *errCPtr
+){
+   uint retUI = 0;
+
+   if(inflateFillBits(inflateST, numBitsI))
+   { /*If: the file ended*/
+      *errCPtr = 2;
+      return 0;
+   } /*If: the file ended*/
+
+   retUI =
+        (uint) inflateST->bitsUL
+      & (((uint) 1 << numBitsI) - 1);
+
+   inflateST->bitsUL >>= numBitsI;
+   inflateST->numBitsI -= numBitsI;
+   return retUI;
+} /*inflateGetBits*/
+
+/*-------------------------------------------------------\
+| Fun-06: inflateGetByte
+|  - Gets the next byte after the bit buffer is byte
+|    aligned (call inflateGetBits with numBitsI % 8 bits
+|    first). Bytes in the bit buffer are used first.
+| Input:
+|  - inflateST:
+|    o Pointer to inflate structure to get byte from
+| Output:
+|  - Modifies:
+|    o bitsUL and numBitsI in inflateST
+|  - Returns:
+|    o The next byte
+|    o -1 for end of file
+\-------------------------------------------------------*/
+static int inflateGetByte(
+   struct inflate *inflateST
+){
+   int retI = 0;
+
+   if(inflateST->numBitsI >= 8)
+   { /*If: I have a byte in the bit buffer*/
+      retI = (int) (inflateST->bitsUL & 0xff);
+      inflateST->bitsUL >>= 8;
+      inflateST->numBitsI -= 8;
+      return retI;
+   } /*If: I have a byte in the bit buffer*/
+
+   return inflateInByte(inflateST);
+} /*inflateGetByte*/
+
+/*-------------------------------------------------------\
+| Fun-07: inflateCrc
+|  - Adds the output not in the crc32 yet to the crc32
+| Input:
+|  - inflateST:
+|    o Pointer to inflate structure to update crcUI in
+| Output:
+|  - Modifies:
+|    o crcUI and crcPosUL in inflateST
+\-------------------------------------------------------*/
+static void inflateCrc(
+   struct inflate *inflateST
+){
+   uint crcUI = inflateST->crcUI ^ 0xffffffffU;
+   ulong ulByte = inflateST->crcPosUL;
+
+   for(; ulByte < inflateST->posWinUL; ++ulByte)
+   { /*Loop: add each byte to the crc32*/
+      crcUI =
+           inflateST->crcAryUI[
+              (crcUI ^ inflateST->winStr[ulByte]) & 0xff
+           ]
+         ^ (crcUI >> 8);
+   } /*Loop: add each byte to the crc32*/
+
+   inflateST->crcUI = crcUI ^ 0xffffffffU;
+   inflateST->crcPosUL = inflateST->posWinUL;
+} /*inflateCrc*/
+
+/*-------------------------------------------------------\
+| Fun-08: inflateFlush
+|  - Hands the output to the flush function. If the
+|    window is full, the last defInflateDist bytes are
+|    moved to the start.
+| Input:
+|  - inflateST:
+|    o Pointer to inflate structure to flush
+| Output:
+|  - Modifies:
+|    o winStr, posWinUL, flushUL, and crcPosUL in
+|      inflateST
+|  - Returns:
+|    o 0 for no errors
+|    o 4 if the flush function wanted to stop
+\-------------------------------------------------------*/
+static char inflateFlush(
+   struct inflate *inflateST
+){
+   inflateCrc(inflateST);
+
+   if(inflateST->posWinUL > inflateST->flushUL)
+   { /*If: I have output to hand off*/
+      if(
+         inflateST->flushFun(
+            inflateST->flushPtr,
+            inflateST->winStr + inflateST->flushUL,
+            inflateST->posWinUL - inflateST->flushUL
+         )
+      ) return 4;
+   } /*If: I have output to hand off*/
+
+   if(inflateST->posWinUL > defInflateDist)
+   { /*If: I need to slide the window*/
+      memmove(
+         inflateST->winStr,
+           inflateST->winStr
+         + inflateST->posWinUL
+         - defInflateDist,
+         defInflateDist
+      );
+
+      inflateST->posWinUL = defInflateDist;
+   } /*If: I need to slide the window*/
+
+   inflateST->flushUL = inflateST->posWinUL;
+   inflateST->crcPosUL = inflateST->posWinUL;
+   return 0;
+} /*inflateFlush*/
+
+/*-------------------------------------------------------\
+| Fun-09: inflateMkHuff
+|  - Builds a Huffman table from code lengths
+| Input:
+|  - huffST:
+|    o Pointer to inflateHuff structure to build
+|  - lenAryUC:
+|    o Code length of each symbol (0 for not used)
+|  - numSymI:
+|    o Number of symbols in lenAryUC
+| Output:
+|  - Modifies:
+|    o huffST to have the table
+|  - Returns:
+|    o 0 for no errors
+|    o 2 if there are too many codes for the lengths
+\-------------------------------------------------------*/
+static char inflateMkHuff(
+   struct inflateHuff *huffST,
+   uchar *lenAryUC,
+   int numSymI
+){
+   short offsetAryS[defInflateMaxBits + 1];
+   int nextCodeAryI[defInflateMaxBits + 1];
+   int iSym = 0;
+   int iLen = 0;
+   int leftI = 1;    /*Codes left (incomplete is ok)*/
+   int codeI = 0;
+   int revI = 0;     /*Code in the order it is read*/
+   int iBit = 0;
+
+   for(iLen = 0; iLen <= defInflateMaxBits; ++iLen)
+      huffST->countAryS[iLen] = 0;
+
+   for(iSym = 0; iSym < numSymI; ++iSym)
+      ++huffST->countAryS[lenAryUC[iSym]];
+
+   huffST->countAryS[0] = 0;
+
+   for(iLen = 1; iLen <= defInflateMaxBits; ++iLen)
+   { /*Loop: check the code lengths are possible*/
+      leftI <<= 1;
+      leftI -= huffST->countAryS[iLen];
+      if(leftI < 0) return 2;
+   } /*Loop: check the code lengths are possible*/
+
+   /*Sort the symbols by code (length, then symbol)*/
+   offsetAryS[1] = 0;
+
+   for(iLen = 1; iLen < defInflateMaxBits; ++iLen)
+      offsetAryS[iLen + 1] =
+         offsetAryS[iLen] + huffST->countAryS[iLen];
+
+   for(iSym = 0; iSym < numSymI; ++iSym)
+   { /*Loop: add the symbols*/
+      if(lenAryUC[iSym] != 0)
+         huffST->symAryS[offsetAryS[lenAryUC[iSym]]++] =
+            (short) iSym;
+   } /*Loop: add the symbols*/
+
+   /*Fill the fast table with the short codes*/
+   memset(huffST->fastAryUS, 0, sizeof(huffST->fastAryUS));
+
+   codeI = 0;
+
+   for(iLen = 1; iLen <= defInflateMaxBits; ++iLen)
+   { /*Loop: find the first code of each length*/
+      codeI = (codeI + huffST->countAryS[iLen - 1]) << 1;
+      nextCodeAryI[iLen] = codeI;
+   } /*Loop: find the first code of each length*/
+
+   for(iSym = 0; iSym < numSymI; ++iSym)
+   { /*Loop: add symbols to the fast table*/
+      iLen = lenAryUC[iSym];
+      if(iLen == 0 || iLen > defInflateFast) continue;
+
+      codeI = nextCodeAryI[iLen]++;
+      revI = 0;
+
+      for(iBit = 0; iBit < iLen; ++iBit)
+         revI |= ((codeI >> iBit) & 1) << (iLen - 1 - iBit);
+
+      for(; revI < (1 << defInflateFast); revI += 1 << iLen)
+         huffST->fastAryUS[revI] =
+            (ushort) ((iSym << 4) | iLen);
+   } /*Loop: add symbols to the fast table*/
+
+   return 0;
+} /*inflateMkHuff*/
+
+/*-------------------------------------------------------\
+| Fun-10: inflateDecode
+|  - Decodes one Huffman symbol
+| Input:
+|  - inflateST:
+|    o Pointer to inflate structure to read from
+|  - huffST:
+|    o Pointer to inflateHuff structure with the codes
+|  - errCPtr:
+|    o Set to 2 for invalid codes or if the input ended
+| Output:
+|  - Modifies:
+|    o bitsUL and numBitsI in inflateST
+|  - Returns:
+|    o The symbol
+\-------------------------------------------------------*/
+static int inflateDecode(
+   struct inflate *inflateST,
+   struct inflateHuff *huffST,
+   char *errCPtr
+){
+   ushort entryUS = 0;
+   int codeI = 0;
+   int firstI = 0;
+   int indexI = 0;
+   int countI = 0;
+   int iLen = 0;
+
+   /*The input may end before all bits are read in*/
+   inflateFillBits(inflateST, defInflateMaxBits);
+
+   entryUS =
+      huffST->fastAryUS[
+           inflateST->bitsUL
+         & ((1 << defInflateFast) - 1)
+      ];
+
+   if(entryUS != 0 && (entryUS&15) <= inflateST->numBitsI)
+   { /*If: the code was in the fast table*/
+      inflateST->bitsUL >>= entryUS & 15;
+      inflateST->numBitsI -= entryUS & 15;
+      return entryUS >> 4;
+   } /*If: the code was in the fast table*/
+
+   for(iLen = 1; iLen <= defInflateMaxBits; ++iLen)
+   { /*Loop: decode one bit at a time*/
+      if(inflateST->numBitsI < iLen) break; /*No input*/
+
+      codeI |= (int) (inflateST->bitsUL >> (iLen-1)) & 1;
+      countI = huffST->countAryS[iLen];
+
+      if(codeI - countI < firstI)
+      { /*If: I found the code*/
+         inflateST->bitsUL >>= iLen;
+         inflateST->numBitsI -= iLen;
+         return huffST->symAryS[indexI + (codeI-firstI)];
+      } /*If: I found the code*/
+
+      indexI += countI;
+      firstI = (firstI + countI) << 1;
+      codeI <<= 1;
+   } /*Loop: decode one bit at a time*/
+
+   *errCPtr = 2;
+   return 0;
+} /*inflateDecode*/
+
+/*-------------------------------------------------------\
+| Fun-11: inflateCodes
+|  - Decodes the literals and matches in a fixed or
+|    dynamic block (tables in lenHuffST and distHuffST)
+| Input:
+|  - inflateST:
+|    o Pointer to inflate structure to decode with
+| Output:
+|  - Modifies:
+|    o winStr in inflateST to have the output
+|  - Returns:
+|    o 0 for no errors
+|    o 2 for invalid data
+|    o 4 if the flush function wanted to stop
+\-------------------------------------------------------*/
+static char inflateCodes(
+   struct inflate *inflateST
+){
+   static const ushort lenBaseAryUS[29] = {
+      3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23,
+      27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163,
+      195, 227, 258
+   };
+
+   static const uchar lenExtraAryUC[29] = {
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3,
+      3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+   };
+
+   static const ushort distBaseAryUS[30] = {
+      1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97,
+      129, 193, 257, 385, 513, 769, 1025, 1537, 2049,
+      3073, 4097, 6145, 8193, 12289, 16385, 24577
+   };
+
+   static const uchar distExtraAryUC[30] = {
+      0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7,
+      7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+   };
+
+   char errC = 0;
+   int symI = 0;
+   ulong lenUL = 0;
+   ulong distUL = 0;
+   uchar *outStr = 0;
+   uchar *matchStr = 0;
+
+   while(1)
+   { /*Loop: decode each symbol*/
+      symI =
+         inflateDecode(
+            inflateST,
+            &inflateST->lenHuffST,
+            &errC
+         );
+
+      if(errC) return errC;
+      if(symI == 256) return 0; /*End of block*/
+
+      if(symI < 256)
+      { /*If: this is a literal*/
+         if(inflateST->posWinUL >= defInflateWin)
+         { /*If: the window is full*/
+            errC = inflateFlush(inflateST);
+            if(errC) return errC;
+         } /*If: the window is full*/
+
+         inflateST->winStr[inflateST->posWinUL++] =
+            (uchar) symI;
+         ++inflateST->totalUL;
+         continue;
+      } /*If: this is a literal*/
+
+      /*Match; find the length and distance*/
+      symI -= 257;
+      if(symI >= 29) return 2;
+
+      lenUL =
+           lenBaseAryUS[symI]
+         + inflateGetBits(
+              inflateST,
+              lenExtraAryUC[symI],
+              &errC
+           );
+
+      symI =
+         inflateDecode(
+            inflateST,
+            &inflateST->distHuffST,
+            &errC
+         );
+
+      if(errC) return errC;
+      if(symI >= 30) return 2;
+
+      distUL =
+           distBaseAryUS[symI]
+         + inflateGetBits(
+              inflateST,
+              distExtraAryUC[symI],
+              &errC
+           );
+
+      if(errC) return errC;
+
+      /*A match can not go before this member*/
+      if(distUL > inflateST->totalUL) return 2;
+
+      if(inflateST->posWinUL + lenUL > defInflateWin)
+      { /*If: the match will not fit in the window*/
+         errC = inflateFlush(inflateST);
+         if(errC) return errC;
+      } /*If: the match will not fit in the window*/
+
+      /*The match and output can overlap (runs), so the
+      ` bytes are copied one at a time
+      */
+      outStr = inflateST->winStr + inflateST->posWinUL;
+      matchStr = outStr - distUL;
+      inflateST->posWinUL += lenUL;
+      inflateST->totalUL += lenUL;
+
+      while(lenUL-- > 0) *outStr++ = *matchStr++;
+   } /*Loop: decode each symbol*/
+} /*inflateCodes*/
+
+/*-------------------------------------------------------\
+| Fun-12: inflateDynamic
+|  - Reads the code tables for a dynamic block into
+|    lenHuffST and distHuffST
+| Input:
+|  - inflateST:
+|    o Pointer to inflate structure to read from
+| Output:
+|  - Modifies:
+|    o lenHuffST and distHuffST in inflateST
+|  - Returns:
+|    o 0 for no errors
+|    o 2 for invalid data
+\-------------------------------------------------------*/
+static char inflateDynamic(
+   struct inflate *inflateST
+){
+   static const uchar orderAryUC[19] = {
+      16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13,
+      2, 14, 1, 15
+   };
+
+   uchar lenAryUC[320]; /*Literal/length + distance*/
+   char errC = 0;
+   int numLenI = 0;     /*Literal/length codes*/
+   int numDistI = 0;    /*Distance codes*/
+   int numCodeI = 0;    /*Code length codes*/
+   int indexI = 0;
+   int symI = 0;
+   int repeatI = 0;
+   uchar lenUC = 0;
+
+   numLenI = inflateGetBits(inflateST, 5, &errC) + 257;
+   numDistI = inflateGetBits(inflateST, 5, &errC) + 1;
+   numCodeI = inflateGetBits(inflateST, 4, &errC) + 4;
+
+   if(errC) return errC;
+   if(numLenI > 286 || numDistI > 30) return 2;
+
+   /*Code lengths for the code length codes*/
+   for(indexI = 0; indexI < 19; ++indexI)
+      lenAryUC[orderAryUC[indexI]] = 0;
+
+   for(indexI = 0; indexI < numCodeI; ++indexI)
+      lenAryUC[orderAryUC[indexI]] =
+         (uchar) inflateGetBits(inflateST, 3, &errC);
+
+   if(errC) return errC;
+
+   if(inflateMkHuff(&inflateST->lenHuffST, lenAryUC, 19))
+      return 2;
+
+   /*Code lengths for the literal/length and distance
+   ` codes (one list)
+   */
+   indexI = 0;
+
+   while(indexI < numLenI + numDistI)
+   { /*Loop: read the code lengths*/
+      symI =
+         inflateDecode(
+            inflateST,
+            &inflateST->lenHuffST,
+            &errC
+         );
+
+      if(errC) return errC;
+
+      if(symI < 16)
+      { /*If: this is a length*/
+         lenAryUC[indexI++] = (uchar) symI;
+         continue;
+      } /*If: this is a length*/
+
+      lenUC = 0;
+
+      if(symI == 16)
+      { /*If: repeating the last length*/
+         if(indexI == 0) return 2;
+         lenUC = lenAryUC[indexI - 1];
+         repeatI = 3 + inflateGetBits(inflateST, 2, &errC);
+      } /*If: repeating the last length*/
+
+      else if(symI == 17)
+         repeatI = 3 + inflateGetBits(inflateST, 3, &errC);
+
+      else
+         repeatI = 11 + inflateGetBits(inflateST, 7, &errC);
+
+      if(errC) return errC;
+      if(indexI + repeatI > numLenI + numDistI) return 2;
+
+      while(repeatI-- > 0) lenAryUC[indexI++] = lenUC;
+   } /*Loop: read the code lengths*/
+
+   if(lenAryUC[256] == 0) return 2; /*No end of block*/
+
+   if(inflateMkHuff(&inflateST->lenHuffST,lenAryUC,numLenI))
+      return 2;
+
+   if(
+      inflateMkHuff(
+         &inflateST->distHuffST,
+         lenAryUC + numLenI,
+         numDistI
+      )
+   ) return 2;
+
+   return 0;
+} /*inflateDynamic*/
+
+/*-------------------------------------------------------\
+| Fun-13: inflateStored
+|  - Copies a stored (not compressed) block to the output
+| Input:
+|  - inflateST:
+|    o Pointer to inflate structure to read from
+| Output:
+|  - Modifies:
+|    o winStr in inflateST to have the block
+|  - Returns:
+|    o 0 for no errors
+|    o 2 for invalid data
+|    o 4 if the flush function wanted to stop
+\-------------------------------------------------------*/
+static char inflateStored(
+   struct inflate *inflateST
+){
+   char errC = 0;
+   int byteI = 0;
+   int iByte = 0;
+   uint lenUI = 0;
+   uint notLenUI = 0;
+
+   /*Stored blocks start on a byte*/
+   inflateGetBits(
+      inflateST,
+      inflateST->numBitsI & 7,
+      &errC
+   );
+
+   for(iByte = 0; iByte < 4; ++iByte)
+   { /*Loop: read the length and its complement*/
+      byteI = inflateGetByte(inflateST);
+      if(byteI < 0) return 2;
+
+      if(iByte < 2) lenUI |= ((uint) byteI) << (iByte*8);
+      else notLenUI |= ((uint) byteI) << ((iByte-2) * 8);
+   } /*Loop: read the length and its complement*/
+
+   if(lenUI != (~notLenUI & 0xffff)) return 2;
+
+   while(lenUI-- > 0)
+   { /*Loop: copy the block*/
+      byteI = inflateGetByte(inflateST);
+      if(byteI < 0) return 2;
+
+      if(inflateST->posWinUL >= defInflateWin)
+      { /*If: the window is full*/
+         errC = inflateFlush(inflateST);
+         if(errC) return errC;
+      } /*If: the window is full*/
+
+      inflateST->winStr[inflateST->posWinUL++] =
+         (uchar) byteI;
+      ++inflateST->totalUL;
+   } /*Loop: copy the block*/
+
+   return 0;
+} /*inflateStored*/
+
+/*-------------------------------------------------------\
+| Fun-14: inflateGz
+|  - Decompresses every gzip member in the input. Each
+|    chunk of output is handed to flushFun.
+| Input:
+|  - inflateST:
+|    o Pointer to inflate structure set up by initInflate
+| Output:
+|  - Modifies:
+|    o inflateST to be at the end of the input
+|  - Returns:
+|    o 0 for no errors
+|    o 2 for invalid data, a bad crc32 or length, or a
+|      file that ended early
+|    o 4 if the flush function wanted to stop
+\-------------------------------------------------------*/
+static char inflateGz(
+   struct inflate *inflateST
+){
+   uchar lenAryUC[288];
+   char errC = 0;
+   char lastBl = 0;
+   int byteI = 0;
+   int iByte = 0;
+   uint flagUI = 0;
+   uint lenUI = 0;
+   uint typeUI = 0;
+   ulong checkUL = 0;
+   char memberBl = 0;   /*1: read at least one member*/
+
+   while(1)
+   { /*Loop: read each gzip member*/
+
+      /**************************************************\
+      * Fun-14 Sec-01:
+      *  - Read the gzip header
+      \**************************************************/
+
+      byteI = inflateGetByte(inflateST);
+
+      /*Anything after a member that is not a gzip member
+      ` (like zero padding) is ignored
+      */
+      if(byteI != 0x1f)
+      { /*If: this is not a gzip member*/
+         if(memberBl) break; /*End of the file*/
+         return 2;
+      } /*If: this is not a gzip member*/
+
+      if(inflateGetByte(inflateST) != 0x8b) return 2;
+      if(inflateGetByte(inflateST) != 8) return 2;
+
+      flagUI = (uint) inflateGetByte(inflateST);
+
+      for(iByte = 0; iByte < 6; ++iByte)
+         if(inflateGetByte(inflateST) < 0) return 2;
+
+      if(flagUI & 4)
+      { /*If: there is an extra field*/
+         lenUI = (uint) inflateGetByte(inflateST);
+         lenUI |= (uint) inflateGetByte(inflateST) << 8;
+
+         while(lenUI-- > 0)
+            if(inflateGetByte(inflateST) < 0) return 2;
+      } /*If: there is an extra field*/
+
+      if(flagUI & 8)
+      { /*If: there is a file name*/
+         do{
+            byteI = inflateGetByte(inflateST);
+            if(byteI < 0) return 2;
+         } while(byteI != 0);
+      } /*If: there is a file name*/
+
+      if(flagUI & 16)
+      { /*If: there is a comment*/
+         do{
+            byteI = inflateGetByte(inflateST);
+            if(byteI < 0) return 2;
+         } while(byteI != 0);
+      } /*If: there is a comment*/
+
+      if(flagUI & 2)
+      { /*If: there is a header crc*/
+         inflateGetByte(inflateST);
+         if(inflateGetByte(inflateST) < 0) return 2;
+      } /*If: there is a header crc*/
+
+      inflateST->totalUL = 0;
+      inflateST->crcUI = 0;
+      inflateST->crcPosUL = inflateST->posWinUL;
+
+      /**************************************************\
+      * Fun-14 Sec-02:
+      *  - Decompress the deflate blocks
+      \**************************************************/
+
+      do{
+         lastBl = (char) inflateGetBits(inflateST,1,&errC);
+         typeUI = inflateGetBits(inflateST, 2, &errC);
+         if(errC) return errC;
+
+         if(typeUI == 0) errC = inflateStored(inflateST);
+
+         else if(typeUI == 1)
+         { /*Else If: fixed Huffman codes*/
+            for(lenUI = 0; lenUI < 144; ++lenUI)
+               lenAryUC[lenUI] = 8;
+            for(; lenUI < 256; ++lenUI)
+               lenAryUC[lenUI] = 9;
+            for(; lenUI < 280; ++lenUI)
+               lenAryUC[lenUI] = 7;
+            for(; lenUI < 288; ++lenUI)
+               lenAryUC[lenUI] = 8;
+
+            inflateMkHuff(
+               &inflateST->lenHuffST,
+               lenAryUC,
+               288
+            );
+
+            for(lenUI = 0; lenUI < 30; ++lenUI)
+               lenAryUC[lenUI] = 5;
+
+            inflateMkHuff(
+               &inflateST->distHuffST,
+               lenAryUC,
+               30
+            );
+
+            errC = inflateCodes(inflateST);
+         } /*Else If: fixed Huffman codes*/
+
+         else if(typeUI == 2)
+         { /*Else If: dynamic Huffman codes*/
+            errC = inflateDynamic(inflateST);
+            if(! errC) errC = inflateCodes(inflateST);
+         } /*Else If: dynamic Huffman codes*/
+
+         else errC = 2;
+
+         if(errC) return errC;
+      } while(! lastBl);
+
+      /**************************************************\
+      * Fun-14 Sec-03:
+      *  - Check the crc32 and length in the trailer
+      \**************************************************/
+
+      inflateCrc(inflateST);
+      inflateGetBits(
+         inflateST,
+         inflateST->numBitsI & 7,
+         &errC
+      );
+
+      for(iByte = 0; iByte < 8; ++iByte)
+      { /*Loop: read the trailer*/
+         byteI = inflateGetByte(inflateST);
+         if(byteI < 0) return 2;
+
+         if(iByte == 0) checkUL = 0;
+         if(iByte == 4)
+         { /*If: checking the crc32*/
+            if(checkUL != inflateST->crcUI) return 2;
+            checkUL = 0;
+         } /*If: checking the crc32*/
+
+         checkUL |= ((ulong) byteI) << ((iByte & 3) * 8);
+      } /*Loop: read the trailer*/
+
+      if(checkUL != (inflateST->totalUL & 0xffffffffUL))
+         return 2;
+
+      memberBl = 1;
+   } /*Loop: read each gzip member*/
+
+   return inflateFlush(inflateST);
+} /*inflateGz*/
+
+#endif
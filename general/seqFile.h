@@ -0,0 +1,724 @@
+/*########################################################
+# Name: seqFile
+# Use:
+#  - Holds a block buffered reader for fasta and fastq
+#    files. This is faster than readFaSeq/readFqSeq
+#    (seqStruct.h) for large files:
+#    o The file is read in large blocks and lines are
+#      found with memchr, instead of one fgets per line
+#    o Sequence buffers grow geometrically (double), so a
+#      long sequence is not realloced every 1024 bytes.
+#      The growth is capped by the number of bytes left in
+#      the file (fseek/ftell), so a large reference is not
+#      given twice the memory it needs.
+#    o Sequences can be converted to lookup indexes
+#      (seqToLookupIndex) as they are copied out of the
+#      block, so no second pass is needed
+#  - The seqFile structure owns the block, so all reads
+#    from a file need to go through the same seqFile
+#  - gzip files are found from their first two bytes and
+#    are decompressed on their own thread (gzRead.h), so
+#    .fa.gz and .fq.gz files can be read directly
+# Libraries:
+#  - "seqStruct.h"
+#  - "alnSetStruct.h"
+#  - "gzRead.h"
+#  - "seqVect.h"
+#  o "inflate.h"
+#  o "../vectWrap/vectWrap.h"
+#  o "alnSeqDefaults.h"
+#  o "base10StrToNum.h"
+#  o "dataTypeShortHand.h"
+# C Standard Libraries:
+#  o <stdlib.h>
+#  o <stdio.h>
+#  o <string.h>
+#  o <pthread.h> (POSIX, not C standard)
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Includes and structures
+'  o macro-01 seqFileCnvt:
+'    - Converts a base to its lookup index (or does
+'      nothing for -DWORDS/-DNOSEQCNVT)
+'  o macro-02 initSeqFile:
+'    - Sets a seqFile structure to no file or memory
+'  o fun-03 openSeqFile:
+'    - Sets up a seqFile structure to read a FILE
+'  o fun-04 seqFileFill:
+'    - Reads the next block of the file into the buffer
+'  o fun-05 seqFileGrow:
+'    - Grows a sequence, id, or q-score buffer
+'  o fun-06 seqFileLine:
+'    - Adds the next line in the file to a buffer
+'  o fun-07 seqFilePeek:
+'    - Gets the next character in the file (not removed)
+'  o fun-08 seqFileSkipLine:
+'    - Moves past the next line in the file
+'  o fun-09 readSeqFile:
+'    - Reads the next fasta or fastq entry
+'  o macro-10 freeSeqFileStack:
+'    - Frees the block in a seqFile and stops the gzip
+'      thread (not the FILE)
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes and structures
+\-------------------------------------------------------*/
+
+#ifndef SEQ_FILE_H
+#define SEQ_FILE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "seqStruct.h"
+#include "alnSetStruct.h"
+#include "gzRead.h"
+#include "seqVect.h"
+
+/*Bytes read from the file at a time*/
+#define defSeqFileBlock (1 << 20)
+
+/*Smallest size for an id, sequence, or q-score buffer*/
+#define defSeqFileMinBuff 1024
+
+/*-------------------------------------------------------\
+| Struct-01: seqFile
+|  - File and block being read by readSeqFile
+\-------------------------------------------------------*/
+struct seqFile{
+   FILE *inFILE;     /*File to read (caller closes)*/
+
+   char *buffStr;    /*Block read in from inFILE*/
+   ulong lenBuffUL;  /*Bytes buffStr can hold*/
+   ulong posUL;      /*Next byte to parse in buffStr*/
+   ulong endUL;      /*Number of bytes in buffStr*/
+
+   ulong leftUL;     /*Bytes not read in (0 is unknown)*/
+
+   struct gzRead *gzST; /*Decompresses gzip files*/
+   unsigned char errUC; /*2: bad gzip file; 64: memory*/
+};
+
+/*-------------------------------------------------------\
+| Macro-01: seqFileCnvt
+|  - Converts a base to its lookup index. This is the
+|    same conversion as seqToLookupIndex (alnSetStruct.h)
+| Input:
+|  - baseC:
+|    o Base to convert
+| Output:
+|  - Returns:
+|    o Lookup index of baseC
+| Variations:
+|  - WORDS (-DWORDS) or NOSEQCNVT (-DNOSEQCNVT)
+|    o No conversion (returns baseC)
+\-------------------------------------------------------*/
+#if defined WORDS || defined NOSEQCNVT
+   #define seqFileCnvt(baseC) (baseC)
+#else
+   #define seqFileCnvt(baseC) ((baseC) & defClearNonAlph)
+#endif
+
+/*-------------------------------------------------------\
+| Macro-02: initSeqFile
+|  - Sets a seqFile structure to no file or memory
+| Input:
+|  - seqFileST:
+|    o Pointer to seqFile structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in seqFileST to 0
+\-------------------------------------------------------*/
+#define initSeqFile(seqFileST){\
+   (seqFileST)->inFILE = 0;\
+   (seqFileST)->buffStr = 0;\
+   (seqFileST)->lenBuffUL = 0;\
+   (seqFileST)->posUL = 0;\
+   (seqFileST)->endUL = 0;\
+   (seqFileST)->leftUL = 0;\
+   (seqFileST)->gzST = 0;\
+   (seqFileST)->errUC = 0;\
+} /*initSeqFile*/
+
+/*-------------------------------------------------------\
+| Fun-03: openSeqFile
+|  - Sets up a seqFile structure to read a FILE. The
+|    block is sized from the file size (ftell), so small
+|    files do not get a full block.
+|  - The first block is read in to check if the file is
+|    a gzip file. gzip files are decompressed on their
+|    own thread.
+| Input:
+|  - seqFileST:
+|    o Pointer to seqFile structure to set up (should be
+|      initialized with initSeqFile). An old block is
+|      freed, since it was sized for the old file.
+|  - inFILE:
+|    o FILE to read. Nothing else should read from inFILE
+|      till seqFileST is done with it.
+| Output:
+|  - Modifies:
+|    o seqFileST to read inFILE
+|  - Returns:
+|    o 0 for no errors
+|    o 64 for memory errors (or if the decompress thread
+|      could not be started)
+\-------------------------------------------------------*/
+static char openSeqFile(
+   struct seqFile *seqFileST,
+   FILE *inFILE
+){
+   long posL = 0;
+   long endL = 0;
+
+   seqFileST->inFILE = inFILE;
+   seqFileST->posUL = 0;
+   seqFileST->endUL = 0;
+   seqFileST->leftUL = 0;
+   seqFileST->errUC = 0;
+
+   if(seqFileST->gzST != 0)
+   { /*If: I was reading a gzip file*/
+      freeGzReadStack(seqFileST->gzST);
+      free(seqFileST->gzST);
+      seqFileST->gzST = 0;
+   } /*If: I was reading a gzip file*/
+
+   /*The file size is only a hint (pipes can not seek)*/
+   posL = ftell(inFILE);
+
+   if(posL >= 0 && fseek(inFILE, 0, SEEK_END) == 0)
+   { /*If: I can find the size of the file*/
+      endL = ftell(inFILE);
+      fseek(inFILE, posL, SEEK_SET);
+
+      if(endL > posL)
+         seqFileST->leftUL = (ulong) (endL - posL);
+   } /*If: I can find the size of the file*/
+
+   if(seqFileST->buffStr != 0) free(seqFileST->buffStr);
+
+   seqFileST->lenBuffUL = defSeqFileBlock;
+
+   if(
+         seqFileST->leftUL != 0
+      && seqFileST->leftUL < seqFileST->lenBuffUL
+   ) seqFileST->lenBuffUL = seqFileST->leftUL + 1;
+
+   seqFileST->buffStr = malloc(seqFileST->lenBuffUL);
+
+   if(seqFileST->buffStr == 0)
+   { /*If: I had a memory error*/
+      seqFileST->lenBuffUL = 0;
+      return 64;
+   } /*If: I had a memory error*/
+
+   seqFileST->endUL =
+      fread(
+         seqFileST->buffStr,
+         sizeof(char),
+         seqFileST->lenBuffUL,
+         inFILE
+      );
+
+   if(seqFileST->endUL < seqFileST->leftUL)
+      seqFileST->leftUL -= seqFileST->endUL;
+   else seqFileST->leftUL = 0;
+
+   if(
+         seqFileST->endUL < 2
+      || (uchar) seqFileST->buffStr[0] != 0x1f
+      || (uchar) seqFileST->buffStr[1] != 0x8b
+   ) return 0; /*Not a gzip file*/
+
+   /*gzip file; the bytes read in go to the decompressor
+   ` and the block is refilled with decompressed bytes
+   */
+   seqFileST->gzST = malloc(sizeof(struct gzRead));
+   if(seqFileST->gzST == 0) return 64;
+
+   if(
+      openGzRead(
+         seqFileST->gzST,
+         inFILE,
+         seqFileST->buffStr,
+         seqFileST->endUL
+      )
+   ) return 64; /*freeSeqFileStack stops the thread*/
+
+   seqFileST->endUL = 0;
+   seqFileST->leftUL = 0; /*Decompressed size unknown*/
+
+   if(seqFileST->lenBuffUL < defSeqFileBlock)
+   { /*If: the block was sized for the compressed file*/
+      free(seqFileST->buffStr);
+      seqFileST->lenBuffUL = defSeqFileBlock;
+      seqFileST->buffStr = malloc(seqFileST->lenBuffUL);
+
+      if(seqFileST->buffStr == 0)
+      { /*If: I had a memory error*/
+         seqFileST->lenBuffUL = 0;
+         return 64;
+      } /*If: I had a memory error*/
+   } /*If: the block was sized for the compressed file*/
+
+   return 0;
+} /*openSeqFile*/
+
+/*-------------------------------------------------------\
+| Fun-04: seqFileFill
+|  - Reads the next block of the file into the buffer.
+|    Bytes that have not been parsed yet are moved to the
+|    start of the buffer first.
+| Input:
+|  - seqFileST:
+|    o Pointer to seqFile structure to read into
+| Output:
+|  - Modifies:
+|    o buffStr in seqFileST to have the next block
+|    o posUL in seqFileST to be 0 and endUL to be the
+|      number of bytes in buffStr
+|    o leftUL in seqFileST to have the bytes read removed
+|    o errUC in seqFileST to have gzip errors (2 or 64)
+|  - Returns:
+|    o Number of new bytes read (0 for end of file or
+|      when the buffer is full)
+\-------------------------------------------------------*/
+static ulong seqFileFill(
+   struct seqFile *seqFileST
+){
+   ulong readUL = 0;
+
+   if(seqFileST->posUL > 0)
+   { /*If: I need to move the unparsed bytes up*/
+      seqFileST->endUL -= seqFileST->posUL;
+
+      memmove(
+         seqFileST->buffStr,
+         seqFileST->buffStr + seqFileST->posUL,
+         seqFileST->endUL
+      );
+
+      seqFileST->posUL = 0;
+   } /*If: I need to move the unparsed bytes up*/
+
+   if(seqFileST->endUL >= seqFileST->lenBuffUL) return 0;
+
+   if(seqFileST->gzST != 0)
+   { /*If: reading a gzip file*/
+      readUL =
+         readGzRead(
+            seqFileST->gzST,
+            seqFileST->buffStr + seqFileST->endUL,
+            seqFileST->lenBuffUL - seqFileST->endUL
+         );
+
+      /*Errors look like the end of the file*/
+      if(readUL == 0)
+         seqFileST->errUC = seqFileST->gzST->errUC;
+   } /*If: reading a gzip file*/
+
+   else
+      readUL =
+         fread(
+            seqFileST->buffStr + seqFileST->endUL,
+            sizeof(char),
+            seqFileST->lenBuffUL - seqFileST->endUL,
+            seqFileST->inFILE
+         );
+
+   seqFileST->endUL += readUL;
+
+   if(readUL < seqFileST->leftUL)
+      seqFileST->leftUL -= readUL;
+   else seqFileST->leftUL = 0;
+
+   return readUL;
+} /*seqFileFill*/
+
+/*-------------------------------------------------------\
+| Fun-05: seqFileGrow
+|  - Grows a sequence, id, or q-score buffer. The size is
+|    doubled, but is not made larger than what is left in
+|    the file.
+| Input:
+|  - buffStrPtr:
+|    o Pointer to the buffer to grow (can point to 0)
+|  - lenBuffULPtr:
+|    o Pointer to the size of the buffer (one byte less
+|      than what is allocated, like addLineToBuffSeqFun)
+|  - needUL:
+|    o Smallest size the buffer can be
+|  - leftUL:
+|    o Bytes left in the file (0 if not known)
+| Output:
+|  - Modifies:
+|    o buffStrPtr to point to the larger buffer
+|    o lenBuffULPtr to have the new size
+|  - Returns:
+|    o 0 for no errors
+|    o 64 for memory errors (buffStrPtr is not changed)
+\-------------------------------------------------------*/
+static char seqFileGrow(
+   char **buffStrPtr,
+   ulong *lenBuffULPtr,
+   ulong needUL,
+   ulong leftUL
+){
+   char *tmpStr = 0;
+   ulong newLenUL = *lenBuffULPtr << 1;
+
+   if(newLenUL < defSeqFileMinBuff)
+      newLenUL = defSeqFileMinBuff;
+
+   /*The rest of a line can not be longer than the file*/
+   if(leftUL != 0 && newLenUL > needUL + leftUL)
+      newLenUL = needUL + leftUL;
+
+   if(newLenUL < needUL) newLenUL = needUL;
+
+   tmpStr = realloc(*buffStrPtr, newLenUL + 1);
+   if(tmpStr == 0) return 64;
+
+   *buffStrPtr = tmpStr;
+   *lenBuffULPtr = newLenUL;
+   return 0;
+} /*seqFileGrow*/
+
+/*-------------------------------------------------------\
+| Fun-06: seqFileLine
+|  - Adds the next line in the file to the end of a
+|    buffer
+| Input:
+|  - seqFileST:
+|    o Pointer to seqFile structure to read the line from
+|  - buffStrPtr:
+|    o Pointer to the buffer to add the line to
+|  - lenBuffULPtr:
+|    o Pointer to the size of the buffer
+|  - lenULPtr:
+|    o Pointer to the number of bytes in the buffer. The
+|      line is added after these bytes.
+|  - idBl:
+|    o 1: Keep the line as is, with its new line (ids)
+|    o 0: Remove white space at the end of the line
+|  - cnvtBl:
+|    o 1: Convert the line to lookup indexes (seqFileCnvt)
+|    o 0: Copy the line as is
+| Output:
+|  - Modifies:
+|    o buffStrPtr to have the line (grown if needed). It
+|      always ends in '\0'.
+|    o lenBuffULPtr to have the new buffer size
+|    o lenULPtr to have the bytes in the buffer
+|    o seqFileST to be on the next line
+|  - Returns:
+|    o 1 if a line was read (the last line may not end
+|      in a new line)
+|    o 0 for end of file (nothing was read)
+|    o 64 for memory errors
+\-------------------------------------------------------*/
+static unsigned char seqFileLine(
+   struct seqFile *seqFileST,
+   char **buffStrPtr,
+   ulong *lenBuffULPtr,
+   ulong *lenULPtr,
+   char idBl,
+   char cnvtBl
+){
+   char *lineStr = 0;
+   char *endStr = 0;
+   char *outStr = 0;
+   ulong lenLineUL = 0; /*Bytes in block for the line*/
+   ulong keepUL = 0;    /*Bytes to copy to the buffer*/
+   char doneBl = 0;
+
+   if(
+         seqFileST->posUL >= seqFileST->endUL
+      && ! seqFileFill(seqFileST)
+   ) return 0; /*End of file*/
+
+   while(! doneBl)
+   { /*Loop: copy the line one block at a time*/
+      lineStr = seqFileST->buffStr + seqFileST->posUL;
+      lenLineUL = seqFileST->endUL - seqFileST->posUL;
+      endStr = memchr(lineStr, '\n', lenLineUL);
+
+      if(endStr != 0)
+      { /*If: the line ends in this block*/
+         lenLineUL = endStr - lineStr;
+         seqFileST->posUL += lenLineUL + 1;
+         keepUL = lenLineUL + idBl; /*idBl keeps '\n'*/
+         doneBl = 1;
+      } /*If: the line ends in this block*/
+
+      else
+      { /*Else: the line goes into the next block*/
+         keepUL = lenLineUL;
+         seqFileST->posUL = seqFileST->endUL;
+      } /*Else: the line goes into the next block*/
+
+      if(! idBl)
+      { /*If: removing white space at the line end*/
+         while(keepUL > 0 && lineStr[keepUL - 1] < 33)
+            --keepUL;
+
+         /*White space at the end of a block might be in
+         ` the middle of the line. It is kept in the block
+         ` (unless it fills the block) for the next pass.
+         */
+         if(! doneBl && keepUL < lenLineUL)
+         { /*If: I have white space to keep for later*/
+            if(
+                  lineStr + keepUL == seqFileST->buffStr
+               && seqFileST->endUL == seqFileST->lenBuffUL
+            ) keepUL = lenLineUL; /*Can not hold a block*/
+
+            seqFileST->posUL -= lenLineUL - keepUL;
+         } /*If: I have white space to keep for later*/
+      } /*If: removing white space at the line end*/
+
+      if(*lenULPtr + keepUL + 1 > *lenBuffULPtr)
+      { /*If: I need a larger buffer*/
+         if(
+            seqFileGrow(
+               buffStrPtr,
+               lenBuffULPtr,
+               *lenULPtr + keepUL + 1,
+                 seqFileST->leftUL
+               + (seqFileST->endUL - seqFileST->posUL)
+            )
+         ) return 64;
+      } /*If: I need a larger buffer*/
+
+      outStr = *buffStrPtr + *lenULPtr;
+
+      if(cnvtBl) cnvtSeqVect(outStr, lineStr, keepUL);
+      else memcpy(outStr, lineStr, keepUL);
+
+      *lenULPtr += keepUL;
+      (*buffStrPtr)[*lenULPtr] = '\0';
+
+      if(! doneBl && ! seqFileFill(seqFileST))
+      { /*If: the file ended without a new line*/
+         seqFileST->posUL = seqFileST->endUL;
+         doneBl = 1;
+      } /*If: the file ended without a new line*/
+   } /*Loop: copy the line one block at a time*/
+
+   return 1;
+} /*seqFileLine*/
+
+/*-------------------------------------------------------\
+| Fun-07: seqFilePeek
+|  - Gets the next character in the file without
+|    removing it
+| Input:
+|  - seqFileST:
+|    o Pointer to seqFile structure to get character from
+| Output:
+|  - Returns:
+|    o Next character in the file
+|    o EOF at the end of the file
+\-------------------------------------------------------*/
+static int seqFilePeek(
+   struct seqFile *seqFileST
+){
+   if(
+         seqFileST->posUL >= seqFileST->endUL
+      && ! seqFileFill(seqFileST)
+   ) return EOF;
+
+   return (uchar) seqFileST->buffStr[seqFileST->posUL];
+} /*seqFilePeek*/
+
+/*-------------------------------------------------------\
+| Fun-08: seqFileSkipLine
+|  - Moves past the next line in the file
+| Input:
+|  - seqFileST:
+|    o Pointer to seqFile structure to skip a line in
+| Output:
+|  - Modifies:
+|    o seqFileST to be on the start of the next line
+\-------------------------------------------------------*/
+static void seqFileSkipLine(
+   struct seqFile *seqFileST
+){
+   char *endStr = 0;
+
+   while(seqFilePeek(seqFileST) != EOF)
+   { /*Loop: find the end of the line*/
+      endStr =
+         memchr(
+            seqFileST->buffStr + seqFileST->posUL,
+            '\n',
+            seqFileST->endUL - seqFileST->posUL
+         );
+
+      if(endStr != 0)
+      { /*If: I found the end of the line*/
+         seqFileST->posUL =
+            endStr - seqFileST->buffStr + 1;
+         return;
+      } /*If: I found the end of the line*/
+
+      seqFileST->posUL = seqFileST->endUL;
+   } /*Loop: find the end of the line*/
+} /*seqFileSkipLine*/
+
+/*-------------------------------------------------------\
+| Fun-09: readSeqFile
+|  - Reads the next fasta or fastq entry. The format is
+|    found from the first character of the entry ('>' for
+|    fasta and '@' for fastq), so a file can be either.
+| Input:
+|  - seqFileST:
+|    o Pointer to seqFile structure with the file to read
+|      (set up with openSeqFile)
+|  - seqST:
+|    o Pointer to seqStruct structure to hold the entry
+|  - cnvtBl:
+|    o 1: Convert the sequence to lookup indexes, so
+|         seqToLookupIndex does not need to be called
+|    o 0: Keep the sequence as is
+| Output:
+|  - Modifies:
+|    o seqST to hold the entry. The id keeps its new line
+|      (like readFaSeq). A fastq header has its '@'
+|      changed to '>', so ids print the same for both
+|      formats.
+|    o seqFileST to be on the next entry
+|  - Returns:
+|     o 0: if EOF (no entry was read)
+|     o 1: if an entry was read (this includes the last
+|          entry in a file without an ending new line)
+|     o 2: for an invalid entry (or a bad gzip file)
+|     o 64: If malloc failed to find memory
+| Note:
+|   - Fastq q-score lines are read till the q-score entry
+|     is as long as the sequence
+\-------------------------------------------------------*/
+static unsigned char readSeqFile(
+   struct seqFile *seqFileST,
+   struct seqStruct *seqST,
+   char cnvtBl
+){
+   int firstI = 0;
+
+   do{
+      firstI = seqFilePeek(seqFileST);
+      if(firstI >= 33) break;
+      if(firstI != EOF) ++seqFileST->posUL;
+   } while(firstI != EOF); /*Skip blank lines*/
+
+   if(firstI == EOF) return seqFileST->errUC; /*0: EOF*/
+   if(firstI != '>' && firstI != '@') return 2;
+
+   seqST->lenIdUL = 0;
+   seqST->lenSeqUL = 0;
+   seqST->lenQUL = 0;
+
+   if(
+      seqFileLine(
+         seqFileST,
+         &seqST->idCStr,
+         &seqST->lenIdBuffUL,
+         &seqST->lenIdUL,
+         1,
+         0
+      ) & 64
+   ) return 64;
+
+   if(seqST->seqCStr != 0) *seqST->seqCStr = '\0';
+
+   while(1)
+   { /*Loop: read in the sequence lines*/
+      firstI = seqFilePeek(seqFileST);
+
+      if(firstI == EOF)
+      { /*If: I hit the end of the file*/
+         if(*seqST->idCStr == '@') return 2; /*No q-score*/
+         break;
+      } /*If: I hit the end of the file*/
+
+      if(firstI == '>' && *seqST->idCStr == '>') break;
+      if(firstI == '+' && *seqST->idCStr == '@') break;
+
+      if(
+         seqFileLine(
+            seqFileST,
+            &seqST->seqCStr,
+            &seqST->lenSeqBuffUL,
+            &seqST->lenSeqUL,
+            0,
+            cnvtBl
+         ) & 64
+      ) return 64;
+   } /*Loop: read in the sequence lines*/
+
+   if(seqFileST->errUC) return seqFileST->errUC;
+   if(seqST->lenSeqUL == 0) return 2;
+   if(*seqST->idCStr == '>') return 1;
+
+   /*Fastq entry; skip the spacer and read the q-score*/
+   seqFileSkipLine(seqFileST);
+
+   if(seqST->qCStr != 0) *seqST->qCStr = '\0';
+
+   while(seqST->lenQUL < seqST->lenSeqUL)
+   { /*Loop: read in the q-score lines*/
+      firstI =
+         seqFileLine(
+            seqFileST,
+            &seqST->qCStr,
+            &seqST->lenQBuffUL,
+            &seqST->lenQUL,
+            0,
+            0
+         );
+
+      if(firstI & 64) return 64;
+      if(firstI == 0) return 2; /*Truncated q-score*/
+   } /*Loop: read in the q-score lines*/
+
+   if(seqFileST->errUC) return seqFileST->errUC;
+
+   *seqST->idCStr = '>';
+   return 1;
+} /*readSeqFile*/
+
+/*-------------------------------------------------------\
+| Macro-10: freeSeqFileStack
+|  - Frees the block in a seqFile structure and stops the
+|    decompress thread (gzip files). The FILE is not
+|    closed.
+| Input:
+|  - seqFileST:
+|    o Pointer to seqFile structure to free the block in
+| Output:
+|  - Frees:
+|    o buffStr and gzST in seqFileST
+|  - Modifies:
+|    o All values in seqFileST to be 0
+\-------------------------------------------------------*/
+#define freeSeqFileStack(seqFileST){\
+   if((seqFileST)->buffStr != 0)\
+      free((seqFileST)->buffStr);\
+   \
+   if((seqFileST)->gzST != 0)\
+   { /*If: I need to stop the decompress thread*/\
+      freeGzReadStack((seqFileST)->gzST);\
+      free((seqFileST)->gzST);\
+   } /*If: I need to stop the decompress thread*/\
+   \
+   initSeqFile((seqFileST));\
+} /*freeSeqFileStack*/
+
+#endif
@@ -0,0 +1,294 @@
+/*########################################################
+# Name: seqMap
+# Use:
+#  - Loads a large fasta reference by memory mapping the
+#    file (mmap), instead of copying it into a malloced
+#    buffer.
+#    o The sequence lines are moved to the start of the
+#      map (new lines removed) and converted to lookup
+#      indexes in one pass. The sequence is then used in
+#      place, so the file is never held twice.
+#    o The map is private (copy on write), so changes to
+#      the sequence never reach the file. Pages past the
+#      end of the sequence are unmapped.
+#    o Only the first entry is read. Fastq files, non
+#      regular files (pipes), and files smaller than
+#      defSeqMapMin are not mapped (use readSeqFile).
+#  - Compile with -DNOMMAP for systems without mmap. All
+#    files are then left to readSeqFile.
+# Libraries:
+#  - "seqFile.h"
+#  o "seqStruct.h"
+#  o "seqVect.h"
+#  o "alnSetStruct.h"
+#  o "alnSeqDefaults.h"
+#  o "base10StrToNum.h"
+#  o "dataTypeShortHand.h"
+# C Standard Libraries:
+#  o <stdlib.h>
+#  o <stdio.h>
+#  o <string.h>
+#  o <sys/types.h> (POSIX, not C standard)
+#  o <sys/stat.h> (POSIX, not C standard)
+#  o <sys/mman.h> (POSIX, not C standard)
+#  o <fcntl.h> (POSIX, not C standard)
+#  o <unistd.h> (POSIX, not C standard)
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Includes and structures
+'  o macro-01 initSeqMap:
+'    - Sets a seqMap structure to no map
+'  o fun-02 mapSeqFile:
+'    - Reads the first fasta entry in a file with mmap
+'  o macro-03 freeSeqMapSTStack:
+'    - Frees a seqStruct that may have a mapped sequence
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes and structures
+\-------------------------------------------------------*/
+
+#ifndef SEQMAP_H
+#define SEQMAP_H
+
+#include <stdlib.h>
+#include <string.h>
+#include "seqFile.h"
+
+#ifndef NOMMAP
+   #include <sys/types.h>
+   #include <sys/stat.h>
+   #include <sys/mman.h>
+   #include <fcntl.h>
+   #include <unistd.h>
+#endif
+
+/*Files smaller than this are read with readSeqFile*/
+#define defSeqMapMin (1 << 24) /*16 MiB*/
+
+/*-------------------------------------------------------\
+| Struct-01: seqMap
+|  - Holds the map a sequence was read into
+\-------------------------------------------------------*/
+struct seqMap{
+   char *mapStr;   /*Start of the map (the sequence)*/
+   ulong lenMapUL; /*Bytes mapped*/
+};
+
+/*-------------------------------------------------------\
+| Macro-01: initSeqMap
+|  - Sets a seqMap structure to no map
+| Input:
+|  - seqMapST:
+|    o Pointer to seqMap structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in seqMapST to 0
+\-------------------------------------------------------*/
+#define initSeqMap(seqMapST){\
+   (seqMapST)->mapStr = 0;\
+   (seqMapST)->lenMapUL = 0;\
+} /*initSeqMap*/
+
+/*-------------------------------------------------------\
+| Fun-02: mapSeqFile
+|  - Reads the first fasta entry in a file by mapping the
+|    file. The sequence is left in the map.
+| Input:
+|  - seqMapST:
+|    o Pointer to seqMap structure to hold the map (should
+|      be initialized with initSeqMap)
+|  - fileStr:
+|    o C-string with the name of the file to map
+|  - seqST:
+|    o Pointer to seqStruct structure to hold the entry
+| Output:
+|  - Modifies:
+|    o seqST to hold the entry. The id is malloced and
+|      keeps its new line (like readSeqFile). seqCStr
+|      points to the map and is converted to lookup
+|      indexes. Use freeSeqMapSTStack to free seqST.
+|    o seqMapST to have the map
+|  - Returns:
+|    o 1: if the entry was read
+|    o 0: if the file has no entry
+|    o 2: for an invalid entry
+|    o 4: if the file was not mapped (use readSeqFile);
+|         seqST is not changed
+|    o 64: If malloc failed to find memory
+\-------------------------------------------------------*/
+static unsigned char mapSeqFile(
+   struct seqMap *seqMapST,
+   char *fileStr,
+   struct seqStruct *seqST
+){
+#ifdef NOMMAP
+   return 4; /*No mmap; readSeqFile reads every file*/
+#else
+   int fileFD = 0;
+   struct stat fileStat;
+   char *mapStr = 0;
+   char *lineStr = 0;
+   char *endStr = 0;
+   ulong lenFileUL = 0;
+   ulong posUL = 0;
+   ulong lenLineUL = 0;
+   ulong outUL = 0;     /*Bases moved to the start*/
+   ulong pageUL = 0;
+   ulong keepUL = 0;    /*Bytes to keep mapped*/
+   unsigned char errUC = 0;
+
+   fileFD = open(fileStr, O_RDONLY);
+   if(fileFD < 0) return 4; /*readSeqFile reports this*/
+
+   if(
+         fstat(fileFD, &fileStat) != 0
+      || ! S_ISREG(fileStat.st_mode)
+      || fileStat.st_size < defSeqMapMin
+   ){ /*If: I can not (or should not) map the file*/
+      close(fileFD);
+      return 4;
+   } /*If: I can not (or should not) map the file*/
+
+   lenFileUL = (ulong) fileStat.st_size;
+
+   mapStr =
+      mmap(
+         0,
+         lenFileUL,
+         PROT_READ | PROT_WRITE,
+         MAP_PRIVATE,
+         fileFD,
+         0
+      );
+
+   close(fileFD); /*The map keeps the file open*/
+   if(mapStr == MAP_FAILED) return 4;
+
+   /*Skip blank lines before the header*/
+   while(
+         posUL < lenFileUL
+      && (unsigned char) mapStr[posUL] < 33
+   ) ++posUL;
+
+   if(posUL == lenFileUL) {errUC = 0; goto unmap;}
+   if(mapStr[posUL] != '>') {errUC = 4; goto unmap;}
+
+   /*Copy the header (with its new line) out of the map*/
+   endStr = memchr(mapStr+posUL, '\n', lenFileUL-posUL);
+   if(endStr == 0) {errUC = 2; goto unmap;} /*No seq*/
+
+   lenLineUL = endStr - (mapStr + posUL) + 1;
+
+   if(seqST->lenIdBuffUL < lenLineUL + 1)
+   { /*If: I need a larger id buffer*/
+      if(seqST->idCStr != 0) free(seqST->idCStr);
+      seqST->idCStr = malloc(lenLineUL + 1);
+      seqST->lenIdBuffUL = 0;
+
+      if(seqST->idCStr == 0) {errUC = 64; goto unmap;}
+      seqST->lenIdBuffUL = lenLineUL + 1;
+   } /*If: I need a larger id buffer*/
+
+   memcpy(seqST->idCStr, mapStr + posUL, lenLineUL);
+   seqST->idCStr[lenLineUL] = '\0';
+   seqST->lenIdUL = lenLineUL;
+   posUL += lenLineUL;
+
+   /*Move the sequence lines to the start of the map. The
+   ` header is at least 2 bytes ('>' and '\n'), so the
+   ` bases never pass the line they are copied from.
+   */
+   while(posUL < lenFileUL)
+   { /*Loop: move each sequence line*/
+      lineStr = mapStr + posUL;
+      if(*lineStr == '>') break; /*Next entry*/
+
+      endStr = memchr(lineStr, '\n', lenFileUL - posUL);
+
+      if(endStr != 0) lenLineUL = endStr - lineStr;
+      else lenLineUL = lenFileUL - posUL;
+
+      posUL += lenLineUL + 1;
+
+      while(lenLineUL > 0 && lineStr[lenLineUL - 1] < 33)
+         --lenLineUL; /*Remove white space at the end*/
+
+      cnvtSeqVect(mapStr + outUL, lineStr, lenLineUL);
+      outUL += lenLineUL;
+   } /*Loop: move each sequence line*/
+
+   if(outUL == 0) {errUC = 2; goto unmap;}
+   mapStr[outUL] = '\0';
+
+   /*Give back the pages after the sequence*/
+   pageUL = (ulong) sysconf(_SC_PAGESIZE);
+   if(pageUL == 0) pageUL = 4096;
+   keepUL = ((outUL + pageUL) / pageUL) * pageUL;
+
+   if(keepUL < lenFileUL)
+   { /*If: there are pages after the sequence*/
+      munmap(mapStr + keepUL, lenFileUL - keepUL);
+      lenFileUL = keepUL;
+   } /*If: there are pages after the sequence*/
+
+   if(seqST->seqCStr != 0) free(seqST->seqCStr);
+   seqST->seqCStr = mapStr;
+   seqST->lenSeqUL = outUL;
+   seqST->lenSeqBuffUL = lenFileUL;
+   seqST->lenQUL = 0;
+
+   seqMapST->mapStr = mapStr;
+   seqMapST->lenMapUL = lenFileUL;
+   return 1;
+
+   unmap:
+   munmap(mapStr, lenFileUL);
+   return errUC;
+#endif
+} /*mapSeqFile*/
+
+/*-------------------------------------------------------\
+| Macro-03: freeSeqMapSTStack
+|  - Frees the variables in a seqStruct whose sequence
+|    may be in a map from mapSeqFile
+| Input:
+|  - seqSTPtr:
+|    o Pointer to seqStruct structure to free variables in
+|  - seqMapSTPtr:
+|    o Pointer to the seqMap structure used with seqSTPtr
+| Output:
+|  - Frees:
+|    o The map in seqMapSTPtr (if there is one)
+|    o The variables in seqSTPtr (see freeSeqSTStack)
+|  - Modifies:
+|    o All values in seqMapSTPtr to 0
+\-------------------------------------------------------*/
+#ifdef NOMMAP
+   #define freeSeqMapSTStack(seqSTPtr, seqMapSTPtr){\
+      freeSeqSTStack((seqSTPtr));\
+   } /*freeSeqMapSTStack*/
+#else
+   #define freeSeqMapSTStack(seqSTPtr, seqMapSTPtr){\
+      if((seqMapSTPtr)->mapStr != 0)\
+      { /*If: the sequence is in a map*/\
+         munmap(\
+            (seqMapSTPtr)->mapStr,\
+            (seqMapSTPtr)->lenMapUL\
+         );\
+         \
+         if((seqSTPtr)->seqCStr==(seqMapSTPtr)->mapStr)\
+            (seqSTPtr)->seqCStr = 0;\
+         \
+         initSeqMap((seqMapSTPtr));\
+      } /*If: the sequence is in a map*/\
+      \
+      freeSeqSTStack((seqSTPtr));\
+   } /*freeSeqMapSTStack*/
+#endif
+
+#endif
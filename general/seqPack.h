@@ -0,0 +1,489 @@
+/*########################################################
+# Name: seqPack
+# Use:
+#  - Holds a sequence packed into two bits per base
+#    (twoBitArrays.h), which is a quarter of the memory of
+#    a byte per base sequence
+#    o A, C, G, and T are packed. Any other base (N, IUPAC
+#      codes, or lower case when the sequence was not
+#      converted) is kept in a list of runs (start,
+#      length, base), so unpacking gives back the same
+#      sequence.
+#    o The aligners use one byte per base, so bases are
+#      unpacked one tile (any part of the sequence) at a
+#      time with unpackSeq. seqPackTile gets a tile from
+#      a seqStruct that may or may not be packed.
+#  - Sequences should be converted to lookup indexes
+#    first (seqFileCnvt), so lower case bases are packed
+# Libraries:
+#  - "twoBitArrays.h"
+#  - "seqFile.h"
+#  o "seqStruct.h"
+#  o "alnSetStruct.h"
+#  o "gzRead.h"
+#  o "inflate.h"
+#  o "alnSeqDefaults.h"
+#  o "base10StrToNum.h"
+#  o "dataTypeShortHand.h"
+# C Standard Libraries:
+#  o <stdlib.h>
+#  o <stdio.h>
+#  o <string.h>
+#  o <pthread.h> (POSIX, not C standard)
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Includes and structures
+'  o macro-01 seqPackCode:
+'    - Gets the two bit code of a base (4 if the base is
+'      not A, C, G, or T)
+'  o macro-02 initSeqPack:
+'    - Sets a seqPack structure to no sequence or memory
+'  o macro-03 freeSeqPackStack:
+'    - Frees the arrays in a seqPack structure
+'  o fun-04 seqPackAddRun:
+'    - Adds a base to the runs of not packed bases
+'  o fun-05 packSeq:
+'    - Packs a sequence into a seqPack structure
+'  o fun-06 seqPackFindRun:
+'    - Finds the first run that ends after a position
+'  o fun-07 unpackSeq:
+'    - Unpacks part of a packed sequence
+'  o fun-08 seqPackTile:
+'    - Gets a tile of bases from a packed or not packed
+'      seqStruct
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes and structures
+\-------------------------------------------------------*/
+
+#ifndef SEQPACK_H
+#define SEQPACK_H
+
+#include <stdlib.h>
+#include <string.h>
+#include "twoBitArrays.h"
+#include "seqFile.h"
+
+/*-------------------------------------------------------\
+| Struct-01: seqPack
+|  - Holds a sequence packed into two bits per base
+\-------------------------------------------------------*/
+struct seqPack{
+   struct twoBitAry twoBitST; /*Packed bases (limbs)*/
+   ulong lenSeqUL;            /*Number of bases*/
+
+   /*Runs of bases that are not A, C, G, or T. These are
+   ` 0 (A) in the two bit array.
+   */
+   ulong *runStartAryUL;      /*First base in each run*/
+   ulong *runLenAryUL;        /*Bases in each run*/
+   char *runBaseAryC;         /*Base in each run*/
+   ulong numRunsUL;           /*Number of runs*/
+   ulong lenRunBuffUL;        /*Runs the arrays can hold*/
+};
+
+/*-------------------------------------------------------\
+| Macro-01: seqPackCode
+|  - Gets the two bit code of a base (lookup index or
+|    letter for -DNOSEQCNVT)
+| Input:
+|  - baseC:
+|    o Base to get the code for
+| Output:
+|  - Returns:
+|    o 0 to 3 for A, C, G, and T
+|    o 4 for any other base
+\-------------------------------------------------------*/
+#define seqPackCode(baseC)(\
+     (baseC) == seqFileCnvt('A') ? 0\
+   : (baseC) == seqFileCnvt('C') ? 1\
+   : (baseC) == seqFileCnvt('G') ? 2\
+   : (baseC) == seqFileCnvt('T') ? 3\
+   : 4\
+) /*seqPackCode*/
+
+/*-------------------------------------------------------\
+| Macro-02: initSeqPack
+|  - Sets a seqPack structure to no sequence or memory
+| Input:
+|  - seqPackST:
+|    o Pointer to seqPack structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in seqPackST to 0
+\-------------------------------------------------------*/
+#define initSeqPack(seqPackST){\
+   (seqPackST)->twoBitST.firstLimbUCPtr = 0;\
+   (seqPackST)->twoBitST.limbOnUCPtr = 0;\
+   (seqPackST)->twoBitST.elmOnC = 0;\
+   (seqPackST)->twoBitST.lenAryUL = 0;\
+   (seqPackST)->lenSeqUL = 0;\
+   (seqPackST)->runStartAryUL = 0;\
+   (seqPackST)->runLenAryUL = 0;\
+   (seqPackST)->runBaseAryC = 0;\
+   (seqPackST)->numRunsUL = 0;\
+   (seqPackST)->lenRunBuffUL = 0;\
+} /*initSeqPack*/
+
+/*-------------------------------------------------------\
+| Macro-03: freeSeqPackStack
+|  - Frees the arrays in a seqPack structure
+| Input:
+|  - seqPackST:
+|    o Pointer to seqPack structure to free arrays in
+| Output:
+|  - Frees:
+|    o The two bit array and run arrays in seqPackST
+|  - Modifies:
+|    o All values in seqPackST to 0
+\-------------------------------------------------------*/
+#define freeSeqPackStack(seqPackST){\
+   freeTwoBitStack(&(seqPackST)->twoBitST);\
+   \
+   if((seqPackST)->runStartAryUL != 0)\
+      free((seqPackST)->runStartAryUL);\
+   if((seqPackST)->runLenAryUL != 0)\
+      free((seqPackST)->runLenAryUL);\
+   if((seqPackST)->runBaseAryC != 0)\
+      free((seqPackST)->runBaseAryC);\
+   \
+   initSeqPack((seqPackST));\
+} /*freeSeqPackStack*/
+
+/*-------------------------------------------------------\
+| Fun-04: seqPackAddRun
+|  - Adds a base to the runs of bases that are not A, C,
+|    G, or T. The base is added to the last run when it
+|    continues the run.
+| Input:
+|  - seqPackST:
+|    o Pointer to seqPack structure to add the base to
+|  - posUL:
+|    o Position of the base (index 0)
+|  - baseC:
+|    o Base to add
+| Output:
+|  - Modifies:
+|    o The run arrays in seqPackST (grown if needed)
+|  - Returns:
+|    o 0: for no errors
+|    o 64: If malloc failed to find memory
+\-------------------------------------------------------*/
+static unsigned char seqPackAddRun(
+   struct seqPack *seqPackST,
+   ulong posUL,
+   char baseC
+){
+   ulong lastUL = seqPackST->numRunsUL - 1;
+   ulong lenUL = 0;
+   void *tmpPtr = 0;
+
+   if(
+         seqPackST->numRunsUL > 0
+      && seqPackST->runBaseAryC[lastUL] == baseC
+      &&   seqPackST->runStartAryUL[lastUL]
+         + seqPackST->runLenAryUL[lastUL]
+        == posUL
+   ){ /*If: this base continues the last run*/
+      ++seqPackST->runLenAryUL[lastUL];
+      return 0;
+   } /*If: this base continues the last run*/
+
+   if(seqPackST->numRunsUL == seqPackST->lenRunBuffUL)
+   { /*If: I need larger run arrays*/
+      lenUL = (seqPackST->lenRunBuffUL << 1) + 16;
+
+      tmpPtr =
+         realloc(
+            seqPackST->runStartAryUL,
+            lenUL * sizeof(ulong)
+         );
+      if(tmpPtr == 0) return 64;
+      seqPackST->runStartAryUL = tmpPtr;
+
+      tmpPtr =
+         realloc(
+            seqPackST->runLenAryUL,
+            lenUL * sizeof(ulong)
+         );
+      if(tmpPtr == 0) return 64;
+      seqPackST->runLenAryUL = tmpPtr;
+
+      tmpPtr = realloc(seqPackST->runBaseAryC, lenUL);
+      if(tmpPtr == 0) return 64;
+      seqPackST->runBaseAryC = tmpPtr;
+
+      seqPackST->lenRunBuffUL = lenUL;
+   } /*If: I need larger run arrays*/
+
+   lastUL = seqPackST->numRunsUL++;
+   seqPackST->runStartAryUL[lastUL] = posUL;
+   seqPackST->runLenAryUL[lastUL] = 1;
+   seqPackST->runBaseAryC[lastUL] = baseC;
+   return 0;
+} /*seqPackAddRun*/
+
+/*-------------------------------------------------------\
+| Fun-05: packSeq
+|  - Packs a sequence into a seqPack structure
+| Input:
+|  - seqStr:
+|    o C-string with the sequence to pack (converted to
+|      lookup indexes with seqFileCnvt)
+|  - lenSeqUL:
+|    o Number of bases in seqStr
+|  - seqPackST:
+|    o Pointer to seqPack structure to hold the packed
+|      sequence (old values are freed)
+| Output:
+|  - Modifies:
+|    o seqPackST to have the packed sequence
+|  - Returns:
+|    o 0: for no errors
+|    o 64: If malloc failed to find memory
+\-------------------------------------------------------*/
+static unsigned char packSeq(
+   char *seqStr,
+   ulong lenSeqUL,
+   struct seqPack *seqPackST
+){
+   ulong ulBase = 0;
+   ulong ulLimb = 0;
+   uchar limbUC = 0;
+   uchar codeUC = 0;
+   uchar *limbAryUC = 0;
+
+   freeSeqPackStack(seqPackST);
+
+   /*Four bases per limb, plus one limb so the last limb
+   ` can always be read
+   */
+   limbAryUC = malloc((lenSeqUL >> 2) + 1);
+   if(limbAryUC == 0) return 64;
+
+   seqPackST->twoBitST.firstLimbUCPtr = limbAryUC;
+   seqPackST->twoBitST.limbOnUCPtr = limbAryUC;
+   seqPackST->twoBitST.lenAryUL = (lenSeqUL >> 2) + 1;
+   seqPackST->lenSeqUL = lenSeqUL;
+
+   for(ulBase = 0; ulBase < lenSeqUL; ++ulBase)
+   { /*Loop: pack each base*/
+      codeUC = seqPackCode(seqStr[ulBase]);
+
+      if(codeUC == 4)
+      { /*If: this base can not be packed*/
+         if(seqPackAddRun(seqPackST,ulBase,seqStr[ulBase]))
+         { /*If: I had a memory error*/
+            freeSeqPackStack(seqPackST);
+            return 64;
+         } /*If: I had a memory error*/
+
+         codeUC = 0;
+      } /*If: this base can not be packed*/
+
+      /*Same order as getTwoBitElm (first base in the low
+      ` bits of the limb)
+      */
+      limbUC |= codeUC << ((ulBase & 3) << 1);
+
+      if((ulBase & 3) == 3)
+      { /*If: the limb is full*/
+         limbAryUC[ulLimb++] = limbUC;
+         limbUC = 0;
+      } /*If: the limb is full*/
+   } /*Loop: pack each base*/
+
+   limbAryUC[ulLimb] = limbUC; /*Last (partial) limb*/
+   return 0;
+} /*packSeq*/
+
+/*-------------------------------------------------------\
+| Fun-06: seqPackFindRun
+|  - Finds the first run of not packed bases that ends
+|    after a position (binary search)
+| Input:
+|  - seqPackST:
+|    o Pointer to seqPack structure with the runs
+|  - posUL:
+|    o Position to find the run for (index 0)
+| Output:
+|  - Returns:
+|    o Index of the first run that ends after posUL
+|    o numRunsUL if no run ends after posUL
+\-------------------------------------------------------*/
+static ulong seqPackFindRun(
+   struct seqPack *seqPackST,
+   ulong posUL
+){
+   ulong startUL = 0;
+   ulong endUL = seqPackST->numRunsUL;
+   ulong midUL = 0;
+
+   while(startUL < endUL)
+   { /*Loop: binary search for the run*/
+      midUL = startUL + ((endUL - startUL) >> 1);
+
+      if(
+            seqPackST->runStartAryUL[midUL]
+          + seqPackST->runLenAryUL[midUL]
+         <= posUL
+      ) startUL = midUL + 1;
+
+      else endUL = midUL;
+   } /*Loop: binary search for the run*/
+
+   return startUL;
+} /*seqPackFindRun*/
+
+/*-------------------------------------------------------\
+| Fun-07: unpackSeq
+|  - Unpacks part of a packed sequence (a tile) into one
+|    byte per base
+| Input:
+|  - seqPackST:
+|    o Pointer to seqPack structure with the sequence
+|  - startUL:
+|    o First base to unpack (index 0)
+|  - lenUL:
+|    o Number of bases to unpack (is cut at the end of
+|      the sequence)
+|  - outStr:
+|    o C-string to unpack the bases into (needs room for
+|      lenUL + 1 bytes)
+| Output:
+|  - Modifies:
+|    o outStr to have the bases and end in '\0'
+|  - Returns:
+|    o Number of bases unpacked
+\-------------------------------------------------------*/
+static ulong unpackSeq(
+   struct seqPack *seqPackST,
+   ulong startUL,
+   ulong lenUL,
+   char *outStr
+){
+   char codeToBaseAryC[4];
+   uchar *limbUC = 0;
+   uchar limbOnUC = 0;
+   ulong ulBase = 0;
+   ulong runUL = 0;
+   ulong runStartUL = 0;
+   ulong runEndUL = 0;
+   ulong endUL = 0;
+
+   if(startUL >= seqPackST->lenSeqUL) lenUL = 0;
+   else if(lenUL > seqPackST->lenSeqUL - startUL)
+      lenUL = seqPackST->lenSeqUL - startUL;
+
+   outStr[lenUL] = '\0';
+   if(lenUL == 0) return 0;
+
+   codeToBaseAryC[0] = seqFileCnvt('A');
+   codeToBaseAryC[1] = seqFileCnvt('C');
+   codeToBaseAryC[2] = seqFileCnvt('G');
+   codeToBaseAryC[3] = seqFileCnvt('T');
+
+   /*Unpack the bases before the first full limb*/
+   limbUC = seqPackST->twoBitST.firstLimbUCPtr+(startUL>>2);
+   limbOnUC = *limbUC++ >> ((startUL & 3) << 1);
+
+   for(
+      ulBase = 0;
+      ulBase < lenUL && ((startUL + ulBase) & 3) != 0;
+      ++ulBase
+   ){ /*Loop: unpack bases till at the next limb*/
+      outStr[ulBase] = codeToBaseAryC[limbOnUC & 3];
+      limbOnUC >>= 2;
+   } /*Loop: unpack bases till at the next limb*/
+
+   if(ulBase == 0) --limbUC; /*startUL starts a limb*/
+
+   /*Unpack four bases (one limb) at a time*/
+   while(ulBase + 4 <= lenUL)
+   { /*Loop: unpack each full limb*/
+      limbOnUC = *limbUC++;
+      outStr[ulBase] = codeToBaseAryC[limbOnUC & 3];
+      outStr[ulBase+1] = codeToBaseAryC[(limbOnUC>>2)&3];
+      outStr[ulBase+2] = codeToBaseAryC[(limbOnUC>>4)&3];
+      outStr[ulBase+3] = codeToBaseAryC[limbOnUC >> 6];
+      ulBase += 4;
+   } /*Loop: unpack each full limb*/
+
+   if(ulBase < lenUL) limbOnUC = *limbUC;
+
+   while(ulBase < lenUL)
+   { /*Loop: unpack the last bases*/
+      outStr[ulBase++] = codeToBaseAryC[limbOnUC & 3];
+      limbOnUC >>= 2;
+   } /*Loop: unpack the last bases*/
+
+   /*Put back the bases that were not packed*/
+   endUL = startUL + lenUL;
+
+   for(
+      runUL = seqPackFindRun(seqPackST, startUL);
+      runUL < seqPackST->numRunsUL;
+      ++runUL
+   ){ /*Loop: copy the runs in the tile*/
+      runStartUL = seqPackST->runStartAryUL[runUL];
+      if(runStartUL >= endUL) break;
+
+      runEndUL = runStartUL + seqPackST->runLenAryUL[runUL];
+      if(runEndUL > endUL) runEndUL = endUL;
+      if(runStartUL < startUL) runStartUL = startUL;
+
+      memset(
+         outStr + runStartUL - startUL,
+         seqPackST->runBaseAryC[runUL],
+         runEndUL - runStartUL
+      );
+   } /*Loop: copy the runs in the tile*/
+
+   return lenUL;
+} /*unpackSeq*/
+
+/*-------------------------------------------------------\
+| Fun-08: seqPackTile
+|  - Gets a tile (part) of the bases in a seqStruct.
+|    Packed sequences (seqST->packST) are unpacked into
+|    a buffer; other sequences are used in place.
+| Input:
+|  - seqST:
+|    o Pointer to seqStruct structure with the sequence
+|  - startUL:
+|    o First base in the tile (index 0)
+|  - lenUL:
+|    o Number of bases in the tile
+|  - bufStr:
+|    o C-string to unpack the tile into (needs room for
+|      lenUL + 1 bytes). Only used for packed sequences.
+| Output:
+|  - Modifies:
+|    o bufStr to have the tile if seqST is packed
+|  - Returns:
+|    o Pointer to the first base in the tile
+\-------------------------------------------------------*/
+static char * seqPackTile(
+   struct seqStruct *seqST,
+   ulong startUL,
+   ulong lenUL,
+   char *bufStr
+){
+   if(seqST->packST == 0) return seqST->seqCStr + startUL;
+
+   unpackSeq(
+      seqST->packST,
+      seqST->packStartUL + startUL,
+      lenUL,
+      bufStr
+   );
+
+   return bufStr;
+} /*seqPackTile*/
+
+#endif
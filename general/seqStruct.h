@@ -42,6 +42,9 @@
 '     - Copies read id to a buffer and adds in endIdC to
 '       the end. If needed, this function will add right
 '       padding of spaces to the end.
+'  o fun-12 readFaOrFqSeq:
+'    - Reads the next fasta or fastq entry (format is
+'      found from the first character of the entry)
 \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 /*--------------------------------------------------------\
@@ -55,6 +58,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+struct seqPack; /*Two bit sequence (seqPack.h)*/
+
 /*--------------------------------------------------------\
 | Struct-01: seqStruct
 |  - Holds sequence and length of a input sequence
@@ -75,6 +80,12 @@ typedef struct seqStruct
 
   unsigned long  offsetUL;    /*Offset for an alignment*/
   unsigned long  endAlnUL;    /*Marks end of alignment*/
+
+  /*Packed bases (not owned); seqCStr is not used. Only
+  ` aligners that read bases with seqPackTile take these
+  */
+  struct seqPack *packST;     /*Bases, two bits each*/
+  unsigned long  packStartUL; /*packST base at index 0*/
 }seqStruct;
 
 /*--------------------------------------------------------\
@@ -630,7 +641,7 @@ static void reverseComplementSeq(
     if(seqST->qCStr != 0 && *seqST->qCStr != '\0')
     { /*If have a Q-score entry*/
       qCStr = seqST->qCStr;
-      qEndCStr = seqST->qCStr + seqST->lenQUL;
+      qEndCStr = seqST->qCStr + seqST->lenQUL - 1;
     } /*If have a Q-score entry*/
 
     while(endCStr > seqCStr)
@@ -646,7 +657,7 @@ static void reverseComplementSeq(
           *qEndCStr = swapC;
 
           ++qCStr;
-          --endCStr;
+          --qEndCStr;
         } /*If I also need to swap Q-scores*/
         
         ++seqCStr;
@@ -718,6 +729,9 @@ static void reverseCStr(
    \
    (seqSTPtr)->offsetUL = 0;\
    (seqSTPtr)->endAlnUL = 0;\
+   \
+   (seqSTPtr)->packST = 0;\
+   (seqSTPtr)->packStartUL = 0;\
 } /*initSeqST*/
 
 /*--------------------------------------------------------\
@@ -731,6 +745,7 @@ static void reverseCStr(
 |    o Sets id, sequence, and Q-score entreis to start
 |      with '\0' and the id, sequence, and Q-score lengths
 |      to 0. This does not change the buffer lengths.
+|    o Sets packST (packed bases) to 0
 \--------------------------------------------------------*/
 #define blankSeqST(seqSTPtr){\
    if((seqSTPtr)->idCStr != 0) *(seqSTPtr)->idCStr = '\0';\
@@ -744,6 +759,9 @@ static void reverseCStr(
    \
    (seqSTPtr)->offsetUL = 0;\
    (seqSTPtr)->endAlnUL = 0;\
+   \
+   (seqSTPtr)->packST = 0;\
+   (seqSTPtr)->packStartUL = 0;\
 } /*blankSeqST*/
 
 /*--------------------------------------------------------\
@@ -858,4 +876,57 @@ static char * cpReadIdRPad(
    return buffStr;
 } /*cpReadIdRPad*/
 
+/*--------------------------------------------------------\
+| Fun-12: readFaOrFqSeq
+|  - Reads the next fasta or fastq entry. The format is
+|    found from the first character of the entry ('>' for
+|    fasta and '@' for fastq), so a file can be either.
+| Input:
+|  - inFILE:
+|    o Pointer to FILE handle to a fasta or fastq file to
+|      get the next entry from
+|  - seqST:
+|    o Pointer to seqStruct structure to hold the entry
+| Output:
+|  - Modifies:
+|    o seqST to hold the entry. A fastq header has its '@'
+|      changed to '>', so ids print the same for both
+|      formats
+|  - Returns:
+|     o 0: if EOF (no entry was read)
+|     o 1: if an entry was read (this includes the last
+|          entry in a file without an ending new line)
+|     o 2: for an invalid entry
+|     o 64: If malloc failed to find memory
+\--------------------------------------------------------*/
+static unsigned char readFaOrFqSeq(
+  FILE *inFILE,           /*fasta or fastq file*/
+  struct seqStruct *seqST /*Will hold one entry*/
+){
+    int firstI = 0;
+    unsigned char errUC = 0;
+
+    if(inFILE == 0) return 2;
+
+    do{
+        firstI = getc(inFILE);
+    } while(firstI != EOF && firstI < 33);/*blank lines*/
+
+    if(firstI == EOF) return 0;
+    ungetc(firstI, inFILE);
+
+    if(firstI == '>') errUC = readFaSeq(inFILE, seqST);
+    else if(firstI == '@') errUC = readFqSeq(inFILE, seqST);
+    else return 2;
+
+    if(errUC & 64) return 64;
+    if(errUC & 2) return 2;
+    if(seqST->lenSeqUL == 0) return 2;
+
+    if(firstI == '@') *seqST->idCStr = '>';
+
+    /*0 is the last entry in a file with no ending '\n'*/
+    return 1;
+} /*readFaOrFqSeq*/
+
 #endif
@@ -0,0 +1,384 @@
+/*########################################################
+# Name: seqVect
+# Use:
+#  - Holds vector (SIMD) versions of the sequence passes
+#    that touch every base:
+#    o Converting bases to lookup indexes and back
+#      (seqToLookupIndex and lookupIndexToSeq in
+#      alnSetStruct.h)
+#    o Reverse complementing a sequence and reversing a
+#      q-score entry (reverseComplementSeq and reverseCStr
+#      in seqStruct.h)
+#  - The lookup index conversions use and/or, so they are
+#    vectorized for SSE2, SSE4, and AVX2 builds. The
+#    complement and reverse use byte shuffles (table
+#    lookups), so they are only vectorized for SSE4 and
+#    AVX2 builds (defVectShuffle in vectWrap.h).
+#  - Builds without vectors (or NEON/AVX512) use the
+#    scalar versions, which give the same output
+# Libraries:
+#  - "../vectWrap/vectWrap.h"
+#  - "alnSetStruct.h"
+#  - "seqStruct.h"
+#  o "alnSeqDefaults.h"
+#  o "base10StrToNum.h"
+#  o "dataTypeShortHand.h"
+# C Standard Libraries:
+#  o <stdlib.h>
+#  o <stdio.h>
+#  o <string.h>
+#  o <limits.h> (vector builds)
+#  o <stdint.h> (vector builds)
+#  o <immintrin.h> (vector builds)
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Includes and definitions
+'  o fun-01 cnvtSeqVect:
+'    - Copies a sequence and converts it to lookup indexes
+'  o macro-02 seqToLookupIndexVect:
+'    - Converts a sequence to lookup indexes in place
+'  o fun-03 lookupIndexToSeqVect:
+'    - Converts lookup indexes back to bases
+'  o fun-04 reverseCStrVect:
+'    - Reverses a c-string
+'  o fun-05 reverseComplementSeqVect:
+'    - Reverse complements a sequence (and reverses its
+'      q-score entry)
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes and definitions
+\-------------------------------------------------------*/
+
+#ifndef SEQVECT_H
+#define SEQVECT_H
+
+#include <string.h>
+#include "../vectWrap/vectWrap.h"
+#include "alnSetStruct.h"
+#include "seqStruct.h"
+
+/*The NEON and AVX512 wrappers are not tested with these
+` functions, so they use the scalar versions
+*/
+#if defined AVX2 || defined SSE2
+   #define defSeqVect
+#endif
+
+#if ! defined defSeqVect
+   #undef defVectShuffle
+#endif
+
+/*-------------------------------------------------------\
+| Fun-01: cnvtSeqVect
+|  - Copies a sequence and converts it to lookup indexes
+|    (same as seqToLookupIndex)
+| Input:
+|  - outStr:
+|    o C-string to copy the converted sequence to. This
+|      can be inStr or before inStr (bases are moved to
+|      the start of a buffer)
+|  - inStr:
+|    o C-string with the sequence to convert
+|  - lenUL:
+|    o Number of bases to convert
+| Output:
+|  - Modifies:
+|    o outStr to have lenUL lookup indexes (no '\0' is
+|      added)
+| Variations:
+|  - WORDS (-DWORDS) or NOSEQCNVT (-DNOSEQCNVT)
+|    o No conversion (only copies)
+\-------------------------------------------------------*/
+static void cnvtSeqVect(
+   char *outStr,
+   char *inStr,
+   ulong lenUL
+){
+#if defined WORDS || defined NOSEQCNVT
+   if(outStr != inStr) memmove(outStr, inStr, lenUL);
+#else
+   ulong ulChar = 0;
+
+   #ifdef defSeqVect
+      vectU8 clearVectU8 =
+         set1_U8_retVectU8(defClearNonAlph);
+      vectU8 seqVectU8;
+
+      /*The store never passes the next load, since
+      ` outStr is at or before inStr
+      */
+      while(ulChar + defVectBytes <= lenUL)
+      { /*Loop: convert a vector of bases at a time*/
+         seqVectU8 = loadu_U8Ary_retVectU8(inStr + ulChar);
+
+         seqVectU8 =
+            and_vectU8_retVectU8(seqVectU8, clearVectU8);
+
+         storeu_vectU8_retAryU8(outStr + ulChar, seqVectU8);
+         ulChar += defVectBytes;
+      } /*Loop: convert a vector of bases at a time*/
+   #endif
+
+   for(; ulChar < lenUL; ++ulChar)
+      outStr[ulChar] = inStr[ulChar] & defClearNonAlph;
+#endif
+} /*cnvtSeqVect*/
+
+/*-------------------------------------------------------\
+| Macro-02: seqToLookupIndexVect
+|  - Converts a sequence to lookup indexes in place
+|    (vector version of seqToLookupIndex)
+| Input:
+|  - seqStr:
+|    o C-string with the sequence to convert
+|  - lenUL:
+|    o Number of bases in seqStr
+| Output:
+|  - Modifies:
+|    o seqStr to have lookup indexes instead of bases
+\-------------------------------------------------------*/
+#define seqToLookupIndexVect(seqStr, lenUL)\
+   (cnvtSeqVect((seqStr), (seqStr), (lenUL)))
+
+/*-------------------------------------------------------\
+| Fun-03: lookupIndexToSeqVect
+|  - Converts lookup indexes back to upper case bases
+|    (vector version of lookupIndexToSeq)
+| Input:
+|  - seqStr:
+|    o C-string with the lookup indexes to convert
+|  - lenUL:
+|    o Number of lookup indexes in seqStr
+| Output:
+|  - Modifies:
+|    o seqStr to have bases instead of lookup indexes
+| Variations:
+|  - WORDS (-DWORDS) or NOSEQCNVT (-DNOSEQCNVT)
+|    o No conversion
+\-------------------------------------------------------*/
+static void lookupIndexToSeqVect(
+   char *seqStr,
+   ulong lenUL
+){
+#if defined WORDS || defined NOSEQCNVT
+   return;
+#else
+   ulong ulChar = 0;
+
+   #ifdef defSeqVect
+      vectU8 setVectU8 = set1_U8_retVectU8(64);
+      vectU8 seqVectU8;
+
+      while(ulChar + defVectBytes <= lenUL)
+      { /*Loop: convert a vector of indexes at a time*/
+         seqVectU8 = loadu_U8Ary_retVectU8(seqStr+ulChar);
+         seqVectU8 =
+            or_vectU8_retVectU8(seqVectU8, setVectU8);
+         storeu_vectU8_retAryU8(seqStr + ulChar, seqVectU8);
+         ulChar += defVectBytes;
+      } /*Loop: convert a vector of indexes at a time*/
+   #endif
+
+   for(; ulChar < lenUL; ++ulChar) seqStr[ulChar] |= 64;
+#endif
+} /*lookupIndexToSeqVect*/
+
+/*-------------------------------------------------------\
+| Fun-04: reverseCStrVect
+|  - Reverses a c-string (vector version of reverseCStr)
+| Input:
+|  - inStr:
+|    o C-string to reverse
+|  - lenUL:
+|    o Length of inStr (index 1)
+| Output:
+|  - Modifies:
+|    o inStr to be backwards (end at start, start at end)
+\-------------------------------------------------------*/
+static void reverseCStrVect(
+   char *inStr,
+   ulong lenUL
+){
+#ifdef defVectShuffle
+   char *endStr = inStr + lenUL; /*One past the end*/
+   vectU8 startVectU8;
+   vectU8 endVectU8;
+
+   while(endStr - inStr >= (defVectBytes << 1))
+   { /*Loop: swap a vector from each end*/
+      endStr -= defVectBytes;
+
+      startVectU8 = loadu_U8Ary_retVectU8(inStr);
+      endVectU8 = loadu_U8Ary_retVectU8(endStr);
+
+      storeu_vectU8_retAryU8(
+         inStr,
+         rev_vectU8_retVectU8(endVectU8)
+      );
+
+      storeu_vectU8_retAryU8(
+         endStr,
+         rev_vectU8_retVectU8(startVectU8)
+      );
+
+      inStr += defVectBytes;
+   } /*Loop: swap a vector from each end*/
+
+   reverseCStr(inStr, endStr - inStr); /*Middle bases*/
+#else
+   reverseCStr(inStr, lenUL);
+#endif
+} /*reverseCStrVect*/
+
+/*-------------------------------------------------------\
+| Fun-05: reverseComplementSeqVect
+|  - Reverse complements a sequence and reverses its
+|    q-score entry (vector version of
+|    reverseComplementSeq)
+| Input:
+|  - seqST:
+|    o Pointer to seqStruct structure with a sequence to
+|      reverse complement (bases, not lookup indexes)
+| Output:
+|  - Modifies:
+|    o seqCStr in seqST to be reverse complemented (the
+|      same bases as complementBase gives)
+|    o qCStr in seqST to be reversed
+\-------------------------------------------------------*/
+static void reverseComplementSeqVect(
+   struct seqStruct *seqST
+){
+#ifdef defVectShuffle
+   /*Complement of each letter, by (letter & 31). The
+   ` first table is @ to O and the second is P to _.
+   */
+   char lowTblAryC[16] =
+      {0, 'T', 'V', 'G', 'H', 0, 0, 'C',
+       'D', 0, 0, 'M', 0, 'K', 'N', 0};
+   char highTblAryC[16] =
+      {0, 0, 'Y', 'S', 'A', 'A', 'B', 'W',
+       0, 'R', 0, 0, 0, 0, 0, 0};
+
+   char *startStr = seqST->seqCStr;
+   char *endStr = seqST->seqCStr + seqST->lenSeqUL;
+   char swapC = 0;
+
+   vectU8 lowTblVectU8 =
+      loadTbl_U8Ary_retVectU8(lowTblAryC);
+   vectU8 highTblVectU8 =
+      loadTbl_U8Ary_retVectU8(highTblAryC);
+   vectU8 fifteenVectU8 = set1_U8_retVectU8(15);
+   vectU8 sixteenVectU8 = set1_U8_retVectU8(16);
+   vectU8 letterVectU8 = set1_U8_retVectU8((char) 0xC0);
+   vectU8 sixtyFourVectU8 = set1_U8_retVectU8(64);
+
+   vectU8 startVectU8;
+   vectU8 endVectU8;
+   vectU8 indexVectU8;
+   vectU8 highVectU8;
+   vectU8 validVectU8;
+
+   /*Complements the bases in seqVectU8. Letters are 64 to
+   ` 127; anything else is 0 (like complementBase)
+   */
+   #define cmpVectSeqVect(seqVectU8){\
+      indexVectU8 =\
+         and_vectU8_retVectU8((seqVectU8), fifteenVectU8);\
+      \
+      highVectU8 =\
+         mask8_retVectU8(\
+            cmpeq_vectU8_retMask8(\
+               and_vectU8_retVectU8(\
+                  (seqVectU8),\
+                  sixteenVectU8\
+               ),\
+               sixteenVectU8\
+            )\
+         );\
+      \
+      validVectU8 =\
+         mask8_retVectU8(\
+            cmpeq_vectU8_retMask8(\
+               and_vectU8_retVectU8(\
+                  (seqVectU8),\
+                  letterVectU8\
+               ),\
+               sixtyFourVectU8\
+            )\
+         );\
+      \
+      (seqVectU8) =\
+         or_vectU8_retVectU8(\
+            and_vectU8_retVectU8(\
+               highVectU8,\
+               shuffle_vectU8_retVectU8(\
+                  highTblVectU8,\
+                  indexVectU8\
+               )\
+            ),\
+            andNot_vectU8_retVectU8(\
+               highVectU8,\
+               shuffle_vectU8_retVectU8(\
+                  lowTblVectU8,\
+                  indexVectU8\
+               )\
+            )\
+         );\
+      \
+      (seqVectU8) =\
+         and_vectU8_retVectU8((seqVectU8), validVectU8);\
+   } /*cmpVectSeqVect*/
+
+   while(endStr - startStr >= (defVectBytes << 1))
+   { /*Loop: swap a vector from each end*/
+      endStr -= defVectBytes;
+
+      startVectU8 = loadu_U8Ary_retVectU8(startStr);
+      endVectU8 = loadu_U8Ary_retVectU8(endStr);
+
+      cmpVectSeqVect(startVectU8);
+      cmpVectSeqVect(endVectU8);
+
+      storeu_vectU8_retAryU8(
+         startStr,
+         rev_vectU8_retVectU8(endVectU8)
+      );
+
+      storeu_vectU8_retAryU8(
+         endStr,
+         rev_vectU8_retVectU8(startVectU8)
+      );
+
+      startStr += defVectBytes;
+   } /*Loop: swap a vector from each end*/
+
+   #undef cmpVectSeqVect
+
+   /*Reverse complement the middle bases*/
+   --endStr;
+
+   while(endStr > startStr)
+   { /*Loop: reverse complement one base at a time*/
+      swapC = *startStr;
+      *startStr = complementBase(*endStr);
+      *endStr = complementBase(swapC);
+      ++startStr;
+      --endStr;
+   } /*Loop: reverse complement one base at a time*/
+
+   if(endStr == startStr)
+      *startStr = complementBase(*startStr);
+
+   if(seqST->qCStr != 0 && *seqST->qCStr != '\0')
+      reverseCStrVect(seqST->qCStr, seqST->lenQUL);
+#else
+   reverseComplementSeq(seqST);
+#endif
+} /*reverseComplementSeqVect*/
+
+#endif
@@ -0,0 +1,654 @@
+/*########################################################
+# Name: threadPool
+# Use:
+#  - Holds a small work stealing thread pool for running
+#    alignment tasks (pieces of one alignment or whole
+#    alignments) in parallel
+#  - Each thread has its own deque (double ended queue) of
+#    tasks. A thread runs the newest task in its own deque
+#    (bottom) first. A thread with an empty deque steals
+#    the oldest task (top) from another threads deque, so
+#    uneven tasks get spread out.
+#  - A thread waiting on a task runs queued tasks till its
+#    task is finished, so recursive tasks (a task that
+#    adds and waits on other tasks) can not dead lock.
+#  - The thread calling initThreadPool is counted as one
+#    of the threads, so a pool of 1 thread runs every task
+#    when it is added.
+#  - The number of tasks and time spent in tasks is kept
+#    for each thread (see pPoolStats)
+# Libraries:
+# C Standard Libraries:
+#  o <stdlib.h>
+#  o <stdio.h>
+#  o <pthread.h> (POSIX, not C standard)
+#  o <sys/time.h> (POSIX, not C standard)
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Includes and structures
+'  o fun-01 poolTimeDbl:
+'    - Gets the current time in seconds
+'  o fun-02 poolTakeTask:
+'    - Takes a task from a threads deque or steals one
+'      from another thread (pool is locked)
+'  o fun-03 poolRunTask:
+'    - Runs a taken task and marks it as done (pool is
+'      locked)
+'  o fun-04 poolWorker:
+'    - Function each worker thread runs
+'  o fun-05 initThreadPool:
+'    - Starts the worker threads for a thread pool
+'  o fun-06 poolThreadIndex:
+'    - Gets the index of the calling thread in a pool
+'  o fun-07 addPoolTask:
+'    - Adds a task to the bottom of the calling threads
+'      deque
+'  o fun-08 spreadPoolTask:
+'    - Adds a task to the top of the next threads deque
+'      (round robin), so a list of tasks is split up
+'  o fun-09 waitPoolTask:
+'    - Waits for a task to finish, running other tasks
+'      while waiting
+'  o fun-10 pPoolStats:
+'    - Prints the tasks run by and the use of each thread
+'  o fun-11 freeThreadPool:
+'    - Stops the worker threads and frees the pool
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes and structures
+\-------------------------------------------------------*/
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+/*Most threads a pool can have (-threads)*/
+#define defMaxThreads 256
+
+/*-------------------------------------------------------\
+| Struct-01: poolTask
+|  - One task (function and input) to run in a pool
+|  - The caller owns the memory. It must stay valid till
+|    waitPoolTask returns for the task.
+\-------------------------------------------------------*/
+struct poolTask{
+   void (*funPtr)(void *); /*Function to run*/
+   void *argPtr;           /*Input for funPtr*/
+   char doneBl;            /*1: task is finished*/
+   struct poolTask *upST;  /*Task above (older) in deque*/
+   struct poolTask *downST;/*Task below (newer) in deque*/
+};
+
+/*-------------------------------------------------------\
+| Struct-02: poolDeque
+|  - Tasks queued for one thread. The owner takes from
+|    the bottom and other threads steal from the top.
+\-------------------------------------------------------*/
+struct poolDeque{
+   struct poolTask *topST;    /*Oldest task (stolen)*/
+   struct poolTask *bottomST; /*Newest task (owner runs)*/
+};
+
+/*-------------------------------------------------------\
+| Struct-03: poolThread
+|  - Input for and stats kept by one thread in a pool
+\-------------------------------------------------------*/
+struct poolThread{
+   struct threadPool *poolST; /*Pool thread is in*/
+   int indexI;                /*Index of the thread*/
+   unsigned long numTasksUL;  /*Tasks the thread ran*/
+   unsigned long numStolenUL; /*Tasks taken from others*/
+   double busyDbl;            /*Seconds spent in tasks*/
+};
+
+/*-------------------------------------------------------\
+| Struct-04: threadPool
+|  - Worker threads and the deques of tasks to run
+|  - Index 0 in dequeAry and threadAryST is the thread
+|    that called initThreadPool
+\-------------------------------------------------------*/
+struct threadPool{
+   pthread_t *threadAry;   /*Worker threads*/
+   int numWorkersI;        /*Number of started workers*/
+
+   struct poolDeque *dequeAry;   /*numWorkersI + 1*/
+   struct poolThread *threadAryST;/*numWorkersI + 1*/
+   int nextDequeI;         /*Next deque for spreadPoolTask*/
+   long numQueuedL;        /*Tasks in all deques*/
+
+   pthread_key_t indexKey; /*Has each threads poolThread*/
+   pthread_mutex_t lockMutex;
+     /*Guards the deques, doneBl, and the stats*/
+   pthread_cond_t wakeCond;
+     /*Signaled for new tasks, finished tasks, and stop*/
+
+   double startDbl;        /*Time the pool was started*/
+   char stopBl;            /*1: workers should exit*/
+};
+
+/*-------------------------------------------------------\
+| Fun-01: poolTimeDbl
+|  - Gets the current time in seconds
+| Output:
+|  - Returns:
+|    o Seconds (with fractions) since the epoch
+\-------------------------------------------------------*/
+static double poolTimeDbl(
+   void
+){
+   struct timeval timeST;
+   gettimeofday(&timeST, 0);
+   return timeST.tv_sec + (timeST.tv_usec / 1000000.0);
+} /*poolTimeDbl*/
+
+/*-------------------------------------------------------\
+| Fun-02: poolTakeTask
+|  - Takes the bottom task from a threads deque. If the
+|    deque is empty the top task of the next non-empty
+|    deque is stolen.
+| Input:
+|  - poolST:
+|    o Pointer to threadPool to get a task from. The
+|      lockMutex must be locked.
+|  - indexI:
+|    o Index of the thread taking the task
+| Output:
+|  - Modifies:
+|    o The deque the task was in to not have the task
+|  - Returns:
+|    o Pointer to the taken poolTask
+|    o 0 if there were no tasks
+\-------------------------------------------------------*/
+static struct poolTask * poolTakeTask(
+   struct threadPool *poolST,
+   int indexI
+){
+   struct poolDeque *dequeST = &poolST->dequeAry[indexI];
+   struct poolTask *taskST = dequeST->bottomST;
+   int numDequeI = poolST->numWorkersI + 1;
+   int iDeque = 0;
+
+   if(taskST != 0)
+   { /*If: this thread has its own task*/
+      dequeST->bottomST = taskST->upST;
+
+      if(dequeST->bottomST == 0) dequeST->topST = 0;
+      else dequeST->bottomST->downST = 0;
+
+      --poolST->numQueuedL;
+      return taskST;
+   } /*If: this thread has its own task*/
+
+   for(iDeque = 1; iDeque < numDequeI; ++iDeque)
+   { /*Loop: find a deque to steal from*/
+      dequeST =
+         &poolST->dequeAry[(indexI + iDeque) % numDequeI];
+
+      taskST = dequeST->topST;
+      if(taskST == 0) continue;
+
+      dequeST->topST = taskST->downST;
+
+      if(dequeST->topST == 0) dequeST->bottomST = 0;
+      else dequeST->topST->upST = 0;
+
+      --poolST->numQueuedL;
+      ++poolST->threadAryST[indexI].numStolenUL;
+      return taskST;
+   } /*Loop: find a deque to steal from*/
+
+   return 0;
+} /*poolTakeTask*/
+
+/*-------------------------------------------------------\
+| Fun-03: poolRunTask
+|  - Runs a taken task
+| Input:
+|  - poolST:
+|    o Pointer to threadPool the task is from. The
+|      lockMutex must be locked
+|  - taskST:
+|    o Pointer to the poolTask to run (from poolTakeTask)
+|  - indexI:
+|    o Index of the thread running the task
+| Output:
+|  - Modifies:
+|    o doneBl in the task to be 1
+|    o The stats for thread indexI
+|  - Note:
+|    o lockMutex is unlocked while the task runs and is
+|      locked again when this returns
+\-------------------------------------------------------*/
+static void poolRunTask(
+   struct threadPool *poolST,
+   struct poolTask *taskST,
+   int indexI
+){
+   double startDbl = 0;
+
+   pthread_mutex_unlock(&poolST->lockMutex);
+   startDbl = poolTimeDbl();
+   taskST->funPtr(taskST->argPtr);
+   startDbl = poolTimeDbl() - startDbl;
+   pthread_mutex_lock(&poolST->lockMutex);
+
+   poolST->threadAryST[indexI].busyDbl += startDbl;
+   ++poolST->threadAryST[indexI].numTasksUL;
+
+   taskST->doneBl = 1;
+   pthread_cond_broadcast(&poolST->wakeCond);
+} /*poolRunTask*/
+
+/*-------------------------------------------------------\
+| Fun-04: poolWorker
+|  - Function each worker thread runs. It runs tasks till
+|    the pool is stopped and the deques are empty
+| Input:
+|  - threadPtr:
+|    o Pointer to the poolThread for the worker
+| Output:
+|  - Returns:
+|    o 0
+\-------------------------------------------------------*/
+static void * poolWorker(
+   void *threadPtr
+){
+   struct poolThread *threadST =
+      (struct poolThread *) threadPtr;
+   struct threadPool *poolST = threadST->poolST;
+   struct poolTask *taskST = 0;
+
+   pthread_setspecific(poolST->indexKey, threadST);
+   pthread_mutex_lock(&poolST->lockMutex);
+
+   while(! poolST->stopBl || poolST->numQueuedL > 0)
+   { /*Loop: run tasks till told to stop*/
+      taskST = poolTakeTask(poolST, threadST->indexI);
+
+      if(taskST != 0)
+         poolRunTask(poolST, taskST, threadST->indexI);
+
+      else
+         pthread_cond_wait(
+            &poolST->wakeCond,
+            &poolST->lockMutex
+         );
+   } /*Loop: run tasks till told to stop*/
+
+   pthread_mutex_unlock(&poolST->lockMutex);
+   return 0;
+} /*poolWorker*/
+
+/*-------------------------------------------------------\
+| Fun-05: initThreadPool
+|  - Starts the worker threads for a thread pool
+| Input:
+|  - poolST:
+|    o Pointer to threadPool to set up
+|  - numThreadsI:
+|    o Number of threads to use, counting the thread
+|      calling initThreadPool (so numThreadsI - 1 workers
+|      are started)
+| Output:
+|  - Modifies:
+|    o poolST to have numThreadsI - 1 running workers.
+|      If a thread can not be started the pool uses the
+|      threads that did start.
+|  - Returns:
+|    o 0 for success
+|    o 64 for memory errors
+\-------------------------------------------------------*/
+static char initThreadPool(
+   struct threadPool *poolST,
+   int numThreadsI
+){
+   int iThread = 0;
+
+   poolST->threadAry = 0;
+   poolST->numWorkersI = 0;
+   poolST->nextDequeI = 0;
+   poolST->numQueuedL = 0;
+   poolST->stopBl = 0;
+   poolST->startDbl = poolTimeDbl();
+
+   if(numThreadsI > defMaxThreads)
+      numThreadsI = defMaxThreads;
+   if(numThreadsI < 1) numThreadsI = 1;
+
+   poolST->dequeAry =
+      calloc(numThreadsI, sizeof(struct poolDeque));
+   poolST->threadAryST =
+      calloc(numThreadsI, sizeof(struct poolThread));
+
+   if(numThreadsI > 1)
+      poolST->threadAry =
+         malloc((numThreadsI - 1) * sizeof(pthread_t));
+
+   if(
+         poolST->dequeAry == 0
+      || poolST->threadAryST == 0
+      || (numThreadsI > 1 && poolST->threadAry == 0)
+   ){ /*If: I had a memory error*/
+      if(poolST->dequeAry != 0) free(poolST->dequeAry);
+      if(poolST->threadAryST!=0) free(poolST->threadAryST);
+      if(poolST->threadAry != 0) free(poolST->threadAry);
+      poolST->dequeAry = 0;
+      poolST->threadAryST = 0;
+      poolST->threadAry = 0;
+      return 64;
+   } /*If: I had a memory error*/
+
+   for(iThread = 0; iThread < numThreadsI; ++iThread)
+   { /*Loop: set up each threads stats*/
+      poolST->threadAryST[iThread].poolST = poolST;
+      poolST->threadAryST[iThread].indexI = iThread;
+   } /*Loop: set up each threads stats*/
+
+   pthread_mutex_init(&poolST->lockMutex, 0);
+   pthread_cond_init(&poolST->wakeCond, 0);
+   pthread_key_create(&poolST->indexKey, 0);
+   pthread_setspecific(
+      poolST->indexKey,
+      &poolST->threadAryST[0]
+   );
+
+   for(iThread = 1; iThread < numThreadsI; ++iThread)
+   { /*Loop: start the workers*/
+      if(
+         pthread_create(
+            &poolST->threadAry[poolST->numWorkersI],
+            0,
+            poolWorker,
+            &poolST->threadAryST[iThread]
+         )
+      ) break; /*Could not make more threads*/
+
+      /*Started workers read numWorkersI (poolTakeTask)*/
+      pthread_mutex_lock(&poolST->lockMutex);
+      ++poolST->numWorkersI;
+      pthread_mutex_unlock(&poolST->lockMutex);
+   } /*Loop: start the workers*/
+
+   return 0;
+} /*initThreadPool*/
+
+/*-------------------------------------------------------\
+| Fun-06: poolThreadIndex
+|  - Gets the index of the calling thread in a pool
+| Input:
+|  - poolST:
+|    o Pointer to threadPool to get the index from
+| Output:
+|  - Returns:
+|    o Index of the thread (0 is the thread that called
+|      initThreadPool). This is 0 for threads not in the
+|      pool.
+\-------------------------------------------------------*/
+static int poolThreadIndex(
+   struct threadPool *poolST
+){
+   struct poolThread *threadST =
+      (struct poolThread *)
+      pthread_getspecific(poolST->indexKey);
+
+   if(threadST == 0) return 0;
+   return threadST->indexI;
+} /*poolThreadIndex*/
+
+/*-------------------------------------------------------\
+| Fun-07: addPoolTask
+|  - Adds a task to the bottom of the calling threads
+|    deque (it is the next task the thread will run)
+| Input:
+|  - poolST:
+|    o Pointer to threadPool to add the task to
+|  - taskST:
+|    o Pointer to poolTask to add (caller owns this)
+|  - funPtr:
+|    o Function to run for the task
+|  - argPtr:
+|    o Input to give to funPtr
+| Output:
+|  - Modifies:
+|    o taskST to have funPtr and argPtr
+|    o poolST to have taskST at the bottom of the calling
+|      threads deque
+|  - Note:
+|    o If the pool has no workers, the task is run now
+\-------------------------------------------------------*/
+static void addPoolTask(
+   struct threadPool *poolST,
+   struct poolTask *taskST,
+   void (*funPtr)(void *),
+   void *argPtr
+){
+   struct poolDeque *dequeST = 0;
+   int indexI = 0;
+
+   taskST->funPtr = funPtr;
+   taskST->argPtr = argPtr;
+   taskST->doneBl = 0;
+   taskST->upST = 0;
+   taskST->downST = 0;
+
+   if(poolST->numWorkersI == 0)
+   { /*If: there are no workers*/
+      pthread_mutex_lock(&poolST->lockMutex);
+      poolRunTask(poolST, taskST, 0);
+      pthread_mutex_unlock(&poolST->lockMutex);
+      return;
+   } /*If: there are no workers*/
+
+   indexI = poolThreadIndex(poolST);
+   pthread_mutex_lock(&poolST->lockMutex);
+
+   dequeST = &poolST->dequeAry[indexI];
+   taskST->upST = dequeST->bottomST;
+
+   if(dequeST->bottomST == 0) dequeST->topST = taskST;
+   else dequeST->bottomST->downST = taskST;
+   dequeST->bottomST = taskST;
+
+   ++poolST->numQueuedL;
+   pthread_cond_signal(&poolST->wakeCond);
+   pthread_mutex_unlock(&poolST->lockMutex);
+} /*addPoolTask*/
+
+/*-------------------------------------------------------\
+| Fun-08: spreadPoolTask
+|  - Adds a task to the top of the next threads deque
+|    (round robin). So, tasks added in order with this
+|    are split evenly between the threads. Each thread
+|    runs its share in the order added, and the last
+|    added tasks are the first stolen.
+| Input:
+|  - poolST:
+|    o Pointer to threadPool to add the task to
+|  - taskST:
+|    o Pointer to poolTask to add (caller owns this)
+|  - funPtr:
+|    o Function to run for the task
+|  - argPtr:
+|    o Input to give to funPtr
+| Output:
+|  - Modifies:
+|    o taskST to have funPtr and argPtr
+|    o poolST to have taskST at the top of a deque
+|  - Note:
+|    o If the pool has no workers, the task is run now
+\-------------------------------------------------------*/
+static void spreadPoolTask(
+   struct threadPool *poolST,
+   struct poolTask *taskST,
+   void (*funPtr)(void *),
+   void *argPtr
+){
+   struct poolDeque *dequeST = 0;
+
+   if(poolST->numWorkersI == 0)
+   { /*If: there are no workers*/
+      addPoolTask(poolST, taskST, funPtr, argPtr);
+      return;
+   } /*If: there are no workers*/
+
+   taskST->funPtr = funPtr;
+   taskST->argPtr = argPtr;
+   taskST->doneBl = 0;
+   taskST->upST = 0;
+
+   pthread_mutex_lock(&poolST->lockMutex);
+
+   dequeST = &poolST->dequeAry[poolST->nextDequeI];
+   ++poolST->nextDequeI;
+
+   if(poolST->nextDequeI > poolST->numWorkersI)
+      poolST->nextDequeI = 0;
+
+   taskST->downST = dequeST->topST;
+
+   if(dequeST->topST == 0) dequeST->bottomST = taskST;
+   else dequeST->topST->upST = taskST;
+   dequeST->topST = taskST;
+
+   ++poolST->numQueuedL;
+   pthread_cond_signal(&poolST->wakeCond);
+   pthread_mutex_unlock(&poolST->lockMutex);
+} /*spreadPoolTask*/
+
+/*-------------------------------------------------------\
+| Fun-09: waitPoolTask
+|  - Waits for a task to finish. Queued tasks are run
+|    while waiting, so the calling thread is not idle
+| Input:
+|  - poolST:
+|    o Pointer to threadPool the task was added to
+|  - taskST:
+|    o Pointer to poolTask to wait for
+| Output:
+|  - Returns when taskST has finished
+\-------------------------------------------------------*/
+static void waitPoolTask(
+   struct threadPool *poolST,
+   struct poolTask *taskST
+){
+   struct poolTask *runST = 0;
+   int indexI = 0;
+
+   if(poolST->numWorkersI == 0) return; /*Already ran*/
+
+   indexI = poolThreadIndex(poolST);
+   pthread_mutex_lock(&poolST->lockMutex);
+
+   while(! taskST->doneBl)
+   { /*Loop: till the task is finished*/
+      runST = poolTakeTask(poolST, indexI);
+
+      if(runST != 0) poolRunTask(poolST, runST, indexI);
+
+      else
+         pthread_cond_wait(
+            &poolST->wakeCond,
+            &poolST->lockMutex
+         );
+   } /*Loop: till the task is finished*/
+
+   pthread_mutex_unlock(&poolST->lockMutex);
+} /*waitPoolTask*/
+
+/*-------------------------------------------------------\
+| Fun-10: pPoolStats
+|  - Prints the number of tasks run, tasks stolen, and
+|    use (time in tasks / time since initThreadPool) of
+|    each thread in a pool
+| Input:
+|  - poolST:
+|    o Pointer to threadPool to print stats for. There
+|      should be no running tasks.
+|  - outFILE:
+|    o FILE to print the stats to
+| Output:
+|  - Prints:
+|    o One line per thread to outFILE
+\-------------------------------------------------------*/
+static void pPoolStats(
+   struct threadPool *poolST,
+   FILE *outFILE
+){
+   double wallDbl = poolTimeDbl() - poolST->startDbl;
+   int iThread = 0;
+
+   if(wallDbl <= 0) wallDbl = 1;
+
+   pthread_mutex_lock(&poolST->lockMutex);
+
+   for(
+      iThread = 0;
+      iThread <= poolST->numWorkersI;
+      ++iThread
+   ) fprintf(
+         outFILE,
+         "thread %i: %lu tasks (%lu stolen) %.2fs busy"
+         " (%.1f%% use)\n",
+         iThread,
+         poolST->threadAryST[iThread].numTasksUL,
+         poolST->threadAryST[iThread].numStolenUL,
+         poolST->threadAryST[iThread].busyDbl,
+         100 * poolST->threadAryST[iThread].busyDbl
+            / wallDbl
+      );
+
+   pthread_mutex_unlock(&poolST->lockMutex);
+} /*pPoolStats*/
+
+/*-------------------------------------------------------\
+| Fun-11: freeThreadPool
+|  - Stops the worker threads (after the deques are
+|    empty) and frees the memory in a pool
+| Input:
+|  - poolST:
+|    o Pointer to threadPool to free
+| Output:
+|  - Frees:
+|    o The arrays in poolST (poolST is not freed)
+\-------------------------------------------------------*/
+static void freeThreadPool(
+   struct threadPool *poolST
+){
+   int iThread = 0;
+
+   pthread_mutex_lock(&poolST->lockMutex);
+   poolST->stopBl = 1;
+   pthread_cond_broadcast(&poolST->wakeCond);
+   pthread_mutex_unlock(&poolST->lockMutex);
+
+   for(
+      iThread = 0;
+      iThread < poolST->numWorkersI;
+      ++iThread
+   ) pthread_join(poolST->threadAry[iThread], 0);
+
+   if(poolST->threadAry != 0) free(poolST->threadAry);
+   if(poolST->dequeAry != 0) free(poolST->dequeAry);
+   if(poolST->threadAryST!=0) free(poolST->threadAryST);
+
+   poolST->threadAry = 0;
+   poolST->dequeAry = 0;
+   poolST->threadAryST = 0;
+   poolST->numWorkersI = 0;
+
+   pthread_setspecific(poolST->indexKey, 0);
+   pthread_key_delete(poolST->indexKey);
+   pthread_cond_destroy(&poolST->wakeCond);
+   pthread_mutex_destroy(&poolST->lockMutex);
+} /*freeThreadPool*/
+
+#endif
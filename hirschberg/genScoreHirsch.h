@@ -54,10 +54,9 @@
 |   - Gets a single score for a single base pair in an
 |     Hirschberg alignment
 | Input:
-|   - refBase:
-|     o Reference base to get the score for (character)
-|   - qryBase:
-|     o Query base to get the score for (character)
+|   - baseScore:
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - gapDiff:
 |     o The gap extension penatly - gap starting penatly.
 |       This is used to find the insertion and deltion
@@ -87,8 +86,7 @@
 |     o delScore to hold the next deletion score
 \-------------------------------------------------------*/
 #define hirschScore(\
-   refBase,  /*Reference base*/\
-   qryBase,  /*Query sequence*/\
+   baseScore, /*Score for ref/query bases*/\
    gapDiff,  /*gapExtend - gapOpen; used for gap score*/\
    scoreOn,  /*Score on and holds the new maximum*/\
    dirOn,    /*Current direction & holds next direction*/\
@@ -98,7 +96,7 @@
 ){ /*hirschScore*/\
    long macroSnpScoreL =\
         (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
    \
    /*Get the insertion score*/\
    long macroInsScoreL =\
@@ -137,10 +135,9 @@
 |   - Finds the last score for the last base pair in a
 |     row for a Hirschberg alignment
 | Input:
-|   - refBase:
-|     o Reference base to get the score for (character)
-|   - qryBase:
-|     o Query base to get the score for (character)
+|   - baseScore:
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - gapDiff:
 |     o The gap extension penatly - gap starting penatly.
 |       This is used to find the insertion and deltion
@@ -165,8 +162,7 @@
 |     o dirOn to hold the next direction
 \-------------------------------------------------------*/
 #define hirschScoreRowEnd(\
-   refBase,  /*Reference base*/\
-   qryBase,  /*Query sequence*/\
+   baseScore, /*Score for ref/query bases*/\
    gapDiff,  /*gapExtend - gapOpen; used for gap score*/\
    scoreOn,  /*Holds new maxium score*/\
    dirOn,    /*Current direction (updated)*/\
@@ -176,7 +172,7 @@
 ){ /*hirschScoreRowEnd*/\
    long macroSnpScoreL =\
         (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
    \
    /*Get the insertion score*/\
    long macroInsScoreL =\
@@ -276,6 +272,7 @@
    long macroGapColL = 0;\
    long macro_score_for_next_snp_L = 0;\
    long macroDelScoreL = 0;\
+   char *macroProfRowC = 0; /*Query base scores*/\
    \
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
    ^ Fun-03 Sec-02:
@@ -313,6 +310,12 @@
       qryBaseMac < (qryStart) + (qryLen);\
       ++qryBaseMac\
    ){ /*Loop: score all query bases (rows)*/\
+      macroProfRowC =\
+         getScoreProfRow(\
+            (qrySeqStr)[qryBaseMac],\
+            (refSeqStr),\
+            (alnSetPtr)\
+         ); /*Scores for this query base*/\
       \
       for(\
          refBaseMac = (refStart);\
@@ -320,8 +323,7 @@
          ++refBaseMac\
       ){ /*Loop: Find the max scores for a single row*/\
         hirschScore(\
-           (refSeqStr)[refBaseMac],\
-           (qrySeqStr)[qryBaseMac],\
+           macroProfRowC[refBaseMac],\
            gapDiffS,\
            (scoreAry)[refBaseMac],\
            (dirAry)[refBaseMac],\
@@ -332,8 +334,7 @@
       } /*Loop: Find the max scores for a single row*/\
       \
       hirschScoreRowEnd(\
-         (refSeqStr)[refBaseMac],\
-         (qrySeqStr)[qryBaseMac],\
+         macroProfRowC[refBaseMac],\
          gapDiffS,\
          (scoreAry)[refBaseMac],\
          (dirAry)[refBaseMac],\
@@ -438,6 +439,7 @@
    long macroGapColL = 0;\
    long macro_score_for_next_snp_L = 0;\
    long macroDelScoreL = 0;\
+   char *macroProfRowC = 0; /*Query base scores*/\
    \
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
    ^ Fun-04 Sec-02:
@@ -480,6 +482,12 @@
       qryBaseMac >= (qryStart);\
       --qryBaseMac\
    ){ /*Loop: score all query bases (rows)*/\
+      macroProfRowC =\
+         getScoreProfRow(\
+            (qrySeqStr)[qryBaseMac],\
+            (refSeqStr),\
+            (alnSetPtr)\
+         ); /*Scores for this query base*/\
       \
       for(\
          refBaseMac = (refStart) + (refLen) - 1;\
@@ -487,8 +495,7 @@
          --refBaseMac\
       ){ /*Loop: Find the max scores for a single row*/\
          hirschScore(\
-            (refSeqStr)[refBaseMac],\
-            (qrySeqStr)[qryBaseMac],\
+            macroProfRowC[refBaseMac],\
             gapDiffS,\
             (scoreAry)[refBaseMac],\
             (dirAry)[refBaseMac],\
@@ -499,8 +506,7 @@
       } /*Loop: Find the max scores for a single row*/\
       \
       hirschScoreRowEnd(\
-         (refSeqStr)[refBaseMac],\
-         (qrySeqStr)[qryBaseMac],\
+         macroProfRowC[refBaseMac],\
          gapDiffS,\
          (scoreAry)[refBaseMac],\
          (dirAry)[refBaseMac],\
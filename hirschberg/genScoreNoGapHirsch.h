@@ -57,10 +57,9 @@
 |   - Gets a single score for a single base pair in an
 |     Hirschberg alignment without gap extensions penatly
 | Input:
-|   - refBase:
-|     o Reference base to get the score for (character)
-|   - qryBase:
-|     o Query base to get the score for (character)
+|   - baseScore:
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - scoreOn:
 |     o Score to updated and used to find insertions
 |   - nextSnpScore:
@@ -80,8 +79,7 @@
 |     o delScore to hold the next deletion score
 \-------------------------------------------------------*/
 #define hirschScoreNoGap(\
-   refBase,  /*Reference base*/\
-   qryBase,  /*Query sequence*/\
+   baseScore, /*Score for ref/query bases*/\
    scoreOn,  /*Score on and holds the new maximum*/\
    nextSnpScore, /*Holds score used to get snp score*/\
    delScore,  /*Holds the deletion score*/\
@@ -89,7 +87,7 @@
 ){ /*hirschScoreNoGap*/\
    long macroSnpScoreL =\
         (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
    \
    /*Get the insertion score*/\
    long macroInsScoreL=(scoreOn) + (alnSetPtr)->gapOpenC;\
@@ -116,10 +114,9 @@
 |     row for a Hirschberg alignment without a gap
 |     extension penalty
 | Input:
-|   - refBase:
-|     o Reference base to get the score for (character)
-|   - qryBase:
-|     o Query base to get the score for (character)
+|   - baseScore:
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - gapDiff:
 |     o The gap extension penatly - gap starting penatly.
 |       This is used to find the insertion and deltion
@@ -144,8 +141,7 @@
 |     o dirOn to hold the next direction
 \-------------------------------------------------------*/
 #define hirschScoreRowEndNoGap(\
-   refBase,  /*Reference base*/\
-   qryBase,  /*Query sequence*/\
+   baseScore, /*Score for ref/query bases*/\
    scoreOn,  /*Holds new maxium score*/\
    nextSnpScore, /*Holds score used to get snp score*/\
    delScore,  /*Holds the deletion score*/\
@@ -153,7 +149,7 @@
 ){ /*hirschScoreRowEndNoGap*/\
    long macroSnpScoreL =\
         (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
    \
    /*Get the insertion score*/\
    long macroInsScoreL=(scoreOn) + (alnSetPtr)->gapOpenC;\
@@ -235,6 +231,7 @@
    long macroGapColL = 0;\
    long macro_score_for_next_snp_L = 0;\
    long macroDelScoreL = 0;\
+   char *macroProfRowC = 0; /*Query base scores*/\
    \
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
    ^ Fun-03 Sec-02:
@@ -269,6 +266,12 @@
       qryBaseMac < (qryStart) + (qryLen);\
       ++qryBaseMac\
    ){ /*Loop: score all query bases (rows)*/\
+      macroProfRowC =\
+         getScoreProfRow(\
+            (qrySeqStr)[qryBaseMac],\
+            (refSeqStr),\
+            (alnSetPtr)\
+         ); /*Scores for this query base*/\
       \
       for(\
          refBaseMac = (refStart);\
@@ -276,8 +279,7 @@
          ++refBaseMac\
       ){ /*Loop: Find the max scores for a single row*/\
          hirschScoreNoGap(\
-            (refSeqStr)[refBaseMac],\
-            (qrySeqStr)[qryBaseMac],\
+            macroProfRowC[refBaseMac],\
             (scoreAry)[refBaseMac],\
             macro_score_for_next_snp_L,\
             macroDelScoreL,\
@@ -286,8 +288,7 @@
       } /*Loop: Find the max scores for a single row*/\
       \
       hirschScoreRowEndNoGap(\
-         (refSeqStr)[refBaseMac],\
-         (qrySeqStr)[qryBaseMac],\
+         macroProfRowC[refBaseMac],\
          (scoreAry)[refBaseMac],\
          macro_score_for_next_snp_L,\
          macroDelScoreL,\
@@ -381,6 +382,7 @@
    long macroGapColL = 0;\
    long macro_score_for_next_snp_L = 0;\
    long macroDelScoreL = 0;\
+   char *macroProfRowC = 0; /*Query base scores*/\
    \
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
    ^ Fun-04 Sec-02:
@@ -419,6 +421,12 @@
       qryBaseMac >= (qryStart);\
       --qryBaseMac\
    ){ /*Loop: score all query bases (rows)*/\
+      macroProfRowC =\
+         getScoreProfRow(\
+            (qrySeqStr)[qryBaseMac],\
+            (refSeqStr),\
+            (alnSetPtr)\
+         ); /*Scores for this query base*/\
       \
       for(\
          refBaseMac = (refStart) + (refLen) - 1;\
@@ -426,8 +434,7 @@
          --refBaseMac\
       ){ /*Loop: Find the max scores for a single row*/\
          hirschScoreNoGap(\
-            (refSeqStr)[refBaseMac],\
-            (qrySeqStr)[qryBaseMac],\
+            macroProfRowC[refBaseMac],\
             (scoreAry)[refBaseMac],\
             macro_score_for_next_snp_L,\
             macroDelScoreL,\
@@ -436,8 +443,7 @@
       } /*Loop: Find the max scores for a single row*/\
       \
       hirschScoreRowEndNoGap(\
-         (refSeqStr)[refBaseMac],\
-         (qrySeqStr)[qryBaseMac],\
+         macroProfRowC[refBaseMac],\
          (scoreAry)[refBaseMac],\
          macro_score_for_next_snp_L,\
          macroDelScoreL,\
@@ -0,0 +1,483 @@
+/*########################################################
+# Name: hirschThread
+# Use:
+#  - Holds functions for doing a Hirschberg global
+#    alignment with more than one thread (-threads)
+#  - The forward and reverse scoring steps are run at the
+#    same time, then the two halves (left/right of the
+#    midpoint) are run at the same time. Pieces with fewer
+#    than defHirschThreadMinCells cells are aligned with
+#    HirschbergFun or HirschbergFunNoGap.
+#  - Each piece only reads and writes its own reference
+#    range in the score rows, direction row, and the
+#    reference alignment array (and its own query range in
+#    the query alignment array). So the halves can share
+#    the same rows without overwriting each other.
+# Libraries:
+#  - "hirschberg.h"                   (No .c File)
+#  - "hirschbergNoGap.h"              (No .c File)
+#  - "../general/threadPool.h"        (No .c File)
+#  o "genScoreHirsch.h"               (No .c File)
+#  o "genScoreNoGapHirsch.h"          (No .c File)
+#  o "genHirsch.h"                    (No .c File)
+#  o "../general/alnStruct.h"         (No .c File)
+#  o "../general/seqStruct.h"         (No .c File)
+#  o "../general/alnSetStruct.h"      (No .c File)
+#  o "../general/alnSeqDefaults.h"    (No .c File)
+#  o "../general/genAln.h"            (No .c File)
+#  o "../general/dataTypeShortHand.h" (No .c File)
+#  o "../general/alnMatrixStruct.h"   (No .c File)
+#  o "../general/genMath.h"           (No .c File)
+# C Standard Libraries:
+#  o <stdlib.h>
+#  o <stdio.h>
+#  o <pthread.h> (POSIX, not C standard)
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Includes, definitions, and structures
+'  o fun-01 hirschThreadForScore:
+'    - Finds the forward scores for a piece (pool task)
+'  o fun-02 hirschThreadFun:
+'    - Does the recursive part of a threaded Hirschberg
+'      (pool task)
+'  o fun-03 hirschThread:
+'    - Sets up for and calls the recursive function to
+'      run a threaded Hirschberg alignment
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes, definitions, and structures
+\-------------------------------------------------------*/
+
+#ifndef HIRSCH_THREAD_H
+#define HIRSCH_THREAD_H
+
+#include "hirschberg.h"
+#include "hirschbergNoGap.h"
+#include "../general/threadPool.h"
+
+#define defHirschThreadMinCells 262144
+   /*Pieces with fewer cells (reference * query bases)
+   ` than this are done by one thread. Smaller pieces
+   ` spend more time handing off tasks than scoring.
+   */
+
+/*-------------------------------------------------------\
+| Struct-01: hirschPiece
+|  - Input for one piece of a threaded Hirschberg (the
+|    same input as HirschbergFun)
+\-------------------------------------------------------*/
+struct hirschPiece{
+   char *refSeqStr;  /*Reference sequence*/
+   ulong refStartUL; /*1st reference base to align*/
+   ulong refLenUL;   /*Number of reference bases*/
+
+   char *qrySeqStr;  /*Query sequence*/
+   ulong qryStartUL; /*1st query base to align*/
+   ulong qryLenUL;   /*Number of query bases*/
+
+   long *forScoreRowL; /*Holds final forward row*/
+   long *revScoreRowL; /*For finding reverse scores*/
+
+   char *refAlnST;  /*Holds output reference alignment*/
+   char *qryAlnST;  /*Holds the output query alignment*/
+   char *dirRow;    /*Direction row for reverse scores*/
+
+   long gapColL;    /*Gap column score (scoring tasks)*/
+
+   struct alnSet *settings;   /*Settings for alignment*/
+   struct threadPool *poolST; /*Pool to add tasks to*/
+};
+
+/*-------------------------------------------------------\
+| Fun-01: hirschThreadForScore
+|  - Finds the forward scores for the first half of the
+|    query in a piece (scoreHirschFor/NoGap). This is run
+|    as a pool task.
+| Input:
+|  - pieceST:
+|    o Pointer to a hirschPiece with the piece to score
+| Output:
+|  - Modifies:
+|    o forScoreRowL in pieceST to have the forward scores
+|    o refAlnST in pieceST (used as a direction row)
+|    o gapColL in pieceST to have the gap column score
+\-------------------------------------------------------*/
+static void hirschThreadForScore(
+   void *pieceST /*hirschPiece to score*/
+){
+   struct hirschPiece *pST = (struct hirschPiece *) pieceST;
+
+   if(pST->settings->noGapBl)
+      pST->gapColL =
+         scoreHirschForNoGap(
+           pST->refSeqStr,
+           pST->refStartUL,
+           pST->refLenUL,
+           pST->qrySeqStr,
+           pST->qryStartUL,
+           pST->qryLenUL / 2,
+           pST->forScoreRowL,
+           pST->settings
+         );
+
+   else
+      pST->gapColL =
+         scoreHirschFor(
+           pST->refSeqStr,
+           pST->refStartUL,
+           pST->refLenUL,
+           pST->qrySeqStr,
+           pST->qryStartUL,
+           pST->qryLenUL / 2,
+           pST->forScoreRowL,
+           pST->refAlnST,
+           pST->settings
+         );
+} /*hirschThreadForScore*/
+
+/*-------------------------------------------------------\
+| Fun-02: hirschThreadFun
+|  - Does the recursive part of a threaded Hirschberg
+|    alignment. This is run as a pool task.
+| Input:
+|  - pieceST:
+|    o Pointer to a hirschPiece with the piece to align
+| Output:
+|  - Modifies:
+|    o refAlnST in pieceST to have the reference alignment
+|      for the pieces reference bases
+|    o qryAlnST in pieceST to have the query alignment for
+|      the pieces query bases
+\-------------------------------------------------------*/
+static void hirschThreadFun(
+   void *pieceST /*hirschPiece to align*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-02 TOC: hirschThreadFun
+   '  - Does the recursive part of a threaded Hirschberg
+   '  o fun-02 sec-01:
+   '    - Variable declerations
+   '  o fun-02 sec-02:
+   '    - Use one thread for small pieces
+   '  o fun-02 sec-03:
+   '    - Get the forward and reverse scores
+   '  o fun-02 sec-04:
+   '    - Find the midpoint
+   '  o fun-02 sec-05:
+   '    - Align the left and right halves
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^  Fun-02 Sec-01:
+   ^    - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   struct hirschPiece *pST = (struct hirschPiece *) pieceST;
+   struct hirschPiece leftST; /*Piece left of midpoint*/
+   struct hirschPiece rightST;/*Piece right of midpoint*/
+   struct poolTask taskST;
+
+   ulong halfQryUL = pST->qryLenUL / 2;
+   long *forScoreRowL = pST->forScoreRowL;
+   long *revScoreRowL = pST->revScoreRowL;
+   long revGapColL = 0;
+   ulong midPointUL = 0;
+   ulong ulFor = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^  Fun-02 Sec-02:
+   ^    - Use one thread for small pieces
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*This also sends the leaf cases (0 or 1 bases) to the
+   ` single thread Hirschberg
+   */
+   if(
+         pST->refLenUL < 2
+      || pST->qryLenUL < 2
+      ||   pST->refLenUL * pST->qryLenUL
+         < defHirschThreadMinCells
+   ){ /*If: this piece is to small to split up*/
+      if(pST->settings->noGapBl)
+         HirschbergFunNoGap(
+            pST->refSeqStr,
+            pST->refStartUL,
+            pST->refLenUL,
+            pST->qrySeqStr,
+            pST->qryStartUL,
+            pST->qryLenUL,
+            forScoreRowL,
+            revScoreRowL,
+            pST->refAlnST,
+            pST->qryAlnST,
+            pST->settings
+         );
+
+      else
+         HirschbergFun(
+            pST->refSeqStr,
+            pST->refStartUL,
+            pST->refLenUL,
+            pST->qrySeqStr,
+            pST->qryStartUL,
+            pST->qryLenUL,
+            forScoreRowL,
+            revScoreRowL,
+            pST->refAlnST,
+            pST->qryAlnST,
+            pST->dirRow,
+            pST->settings
+         );
+
+      return;
+   } /*If: this piece is to small to split up*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^  Fun-02 Sec-03:
+   ^    - Get the forward and reverse scores
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*The forward step uses forScoreRowL and refAlnST and
+   ` the reverse step uses revScoreRowL and dirRow, so
+   ` they can be run at the same time
+   */
+   addPoolTask(
+      pST->poolST,
+      &taskST,
+      hirschThreadForScore,
+      pST
+   );
+
+   if(pST->settings->noGapBl)
+      revGapColL =
+         scoreHirschRevNoGap(
+           pST->refSeqStr,
+           pST->refStartUL,
+           pST->refLenUL,
+           pST->qrySeqStr,
+           pST->qryStartUL + halfQryUL,
+           pST->qryLenUL - halfQryUL,
+           revScoreRowL,
+           pST->settings
+         );
+
+   else
+      revGapColL =
+         scoreHirschRev(
+           pST->refSeqStr,
+           pST->refStartUL,
+           pST->refLenUL,
+           pST->qrySeqStr,
+           pST->qryStartUL + halfQryUL,
+           pST->qryLenUL - halfQryUL,
+           revScoreRowL,
+           pST->dirRow,
+           pST->settings
+         );
+
+   waitPoolTask(pST->poolST, &taskST);
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^  Fun-02 Sec-04:
+   ^   - Find the midpoint
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   forScoreRowL[pST->refStartUL + pST->refLenUL - 1] +=
+      revGapColL;
+
+   midPointUL = pST->refStartUL + pST->refLenUL - 1;
+
+   for(
+      ulFor = pST->refStartUL;
+      ulFor < pST->refStartUL + pST->refLenUL - 1;
+      ++ulFor
+   ){ /*Loop; add up all scores*/
+      forScoreRowL[ulFor] += revScoreRowL[ulFor + 1];
+        /*The reverse row is already reversed*/
+
+      if(forScoreRowL[ulFor] > forScoreRowL[midPointUL])
+         midPointUL = ulFor;
+   } /*Loop; add up all scores*/
+
+   pST->gapColL += revScoreRowL[pST->refStartUL];
+
+   if(pST->gapColL > forScoreRowL[midPointUL])
+      midPointUL = 0;
+   else midPointUL = midPointUL + 1 - pST->refStartUL;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^  Fun-02 Sec-05:
+   ^    - Align the left and right halves
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   leftST = *pST;
+   leftST.refLenUL = midPointUL;
+   leftST.qryLenUL = halfQryUL;
+
+   rightST = *pST;
+   rightST.refStartUL += midPointUL;
+   rightST.refLenUL -= midPointUL;
+   rightST.qryStartUL += halfQryUL;
+   rightST.qryLenUL -= halfQryUL;
+
+   addPoolTask(
+      pST->poolST,
+      &taskST,
+      hirschThreadFun,
+      &leftST
+   );
+
+   hirschThreadFun(&rightST);
+   waitPoolTask(pST->poolST, &taskST);
+} /*hirschThreadFun*/
+
+/*-------------------------------------------------------\
+| Fun-03: hirschThread
+|  - Sets up for and calls the recursive function to run
+|    a Hirschberg alignment with settings->threadsUS
+|    threads
+| Input:
+|  - refST:
+|    o Pointer to seqStruct structure with the reference
+|      sequence and the first base (offsetUL) and last
+|      base (endAlnUL) to align (both are index 0)
+|  - qryST:
+|    o Pointer to seqStruct structure with the query
+|      sequence and the first base (offsetUL) and last
+|      base (endAlnUL) to align (both are index 0)
+|  - settings:
+|    o Pointer to alnSet structure with the settings for
+|      the alignment (noGapBl picks the gap scoring)
+| Output:
+|  - Returns:
+|    o A alignment structure with the alignment (same as
+|      Hirschberg or HirschbergNoGap)
+|    o 0 For memory errors
+\-------------------------------------------------------*/
+static struct alnStruct * hirschThread(
+  struct seqStruct *refST, /*Reference sequence to align*/
+  struct seqStruct *qryST, /*Qeury sequence to align*/
+  struct alnSet *settings  /*Settings for alignment*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-03 TOC: hirschThread
+   '  - Sets up for and calls the recursive function to
+   '    run a threaded Hirschberg alignment
+   '  o fun-03 sec-01:
+   '    - Variable declerations
+   '  o fun-03 sec-02:
+   '    - Memory allocation (set up for Hirschberg)
+   '  o fun-03 sec-03:
+   '    - Run the hirschberg alignment
+   '  o fun-03 sec-04:
+   '    - Clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^  Fun-03 Sec-01:
+   ^    - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
+   ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
+     /*+ 1 to convert to index 1 (values are index 0)*/
+
+   struct alnStruct *alnST = 0;
+   struct hirschPiece pieceST;
+   struct threadPool poolST;
+
+   long *forwardScoreRowL = 0;
+   long *reverseScoreRowL = 0;
+
+   char *refAln = 0;
+   char *qryAln = 0;
+   char *dirRow = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^  Fun-03 Sec-02:
+   ^   - Memory allocation (set up for Hirschberg)
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*The profile is made before starting the threads, so
+   ` every thread only reads it
+   */
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         lenQryUL,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
+   refAln = calloc(lenRefUL + 1, sizeof(char));
+   if(refAln == 0) goto memErr;
+   refAln[lenRefUL] = defEndAlnFlag;
+
+   dirRow = calloc(lenRefUL + 1, sizeof(char));
+   if(dirRow == 0) goto memErr;
+
+   qryAln = calloc(lenQryUL + 1, sizeof(char));
+   if(qryAln == 0) goto memErr;
+
+   forwardScoreRowL = malloc(sizeof(long) * lenRefUL);
+   if(forwardScoreRowL == 0) goto memErr;
+
+   reverseScoreRowL = malloc(sizeof(long) * lenRefUL);
+   if(reverseScoreRowL == 0) goto memErr;
+
+   if(initThreadPool(&poolST, settings->threadsUS))
+      goto memErr;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^  Fun-03 Sec-03:
+   ^    - Run the hirschberg alignment
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*Sending in offset values, because alignment array is
+   ` sized to the alignmnet region
+   */
+   pieceST.refSeqStr = refST->seqCStr + refST->offsetUL;
+   pieceST.refStartUL = 0;
+   pieceST.refLenUL = lenRefUL;
+
+   pieceST.qrySeqStr = qryST->seqCStr + qryST->offsetUL;
+   pieceST.qryStartUL = 0;
+   pieceST.qryLenUL = lenQryUL;
+
+   pieceST.forScoreRowL = forwardScoreRowL;
+   pieceST.revScoreRowL = reverseScoreRowL;
+   pieceST.refAlnST = refAln;
+   pieceST.qryAlnST = qryAln;
+   pieceST.dirRow = dirRow;
+   pieceST.gapColL = 0;
+   pieceST.settings = settings;
+   pieceST.poolST = &poolST;
+
+   hirschThreadFun(&pieceST);
+   freeThreadPool(&poolST);
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^  Fun-03 Sec-04:
+   ^    - Clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   alnST =
+     hirschToAlnST(refST,qryST,settings,refAln,qryAln);
+
+   memErr:
+
+   free(forwardScoreRowL);
+   free(reverseScoreRowL);
+   free(dirRow);
+   free(refAln);
+   free(qryAln);
+
+   return alnST; /*Is 0 for memory errors*/
+} /*hirschThread*/
+
+#endif
@@ -0,0 +1,837 @@
+/*########################################################
+# Name: hirschVect
+# Use:
+#  - Holds functions for doing a Hirschberg global
+#    alignment with vector (SIMD) scoring
+#  - The recursion and output are the same as Hirschberg,
+#    but each scoring step uses a striped 16 bit or 32 bit
+#    kernel. The kernel is picked for each step from the
+#    length of the region and the largest penalty, so the
+#    16 bit kernel is used whenever its scores can not
+#    overflow and the 32 bit kernel removes the 32,767
+#    base limit of 16 bits.
+#  - -no-gap-extend is done by setting the gap extension
+#    penalty to the gap opening penalty, which gives the
+#    same alignment as HirschbergNoGap
+# Libraries:
+#  - "hirschberg.h"                   (No .c File)
+#  - "hirschVectScoreI16.h"           (No .c File)
+#  - "hirschVectScoreI32.h"           (No .c File)
+#  o "genScoreHirsch.h"               (No .c File)
+#  o "genHirsch.h"                    (No .c File)
+#  o "../general/alnStruct.h"         (No .c File)
+#  o "../general/seqStruct.h"         (No .c File)
+#  o "../general/alnSetStruct.h"      (No .c File)
+#  o "../general/alnSeqDefaults.h"    (No .c File)
+#  o "../general/genAln.h"            (No .c File)
+#  o "../general/dataTypeShortHand.h" (No .c File)
+#  o "../vectWrap/vectWrap.h"         (No .c File)
+# C Standard Libraries:
+#  o <stdint.h>
+#  o <stdlib.h>
+#  o <stdio.h>
+#  o <string.h>
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Includes and definitions
+'  o macro-01 hirschVectInsTieBl:
+'    - Checks if an insertion wins a tie with a snp
+'  o macro-02 hirschVectDelTieBl:
+'    - Checks if a deletion wins a tie with a snp
+'  o macro-03 hirschVectBits:
+'    - Picks the number of bits to score a region with
+'  o fun-04 hirschVectScore:
+'    - Finds the last row of scores for one half of a
+'      Hirschberg with the kernel picked by hirschVectBits
+'  o fun-05 hirschVectFun:
+'    - Does the recursive part of a vector Hirschberg
+'  o fun-06 hirschVect:
+'    - Sets up for and calls the recursive function to run
+'      a vector Hirschberg alignment
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes and definitions
+\-------------------------------------------------------*/
+
+#ifndef HIRSCH_VECT_H
+#define HIRSCH_VECT_H
+
+#include "hirschberg.h"
+#include "hirschbergNoGap.h"
+#include "hirschVectScoreI16.h"
+#include "hirschVectScoreI32.h"
+
+/*Largest scores the 16 and 32 bit kernels can hold*/
+#define defHirschMaxI16 32767
+#define defHirschMaxI32 2147483647
+
+/*-------------------------------------------------------\
+| Macro-01: hirschVectInsTieBl
+|   - Checks if an insertion wins a tie with a snp (see
+|     maxGapScore in genHirsch.h)
+| Input:
+|   - pref:
+|     o The direction preference (settings->bestDirC)
+| Output:
+|   - Returns:
+|     o 1 if an insertion wins a tie with a snp
+|     o 0 if a snp wins the tie
+\-------------------------------------------------------*/
+
+/*-------------------------------------------------------\
+| Macro-02: hirschVectDelTieBl
+|   - Checks if a deletion wins a tie with a snp (see
+|     maxGapScore in genHirsch.h)
+| Input:
+|   - pref:
+|     o The direction preference (settings->bestDirC)
+| Output:
+|   - Returns:
+|     o 1 if a deletion wins a tie with a snp
+|     o 0 if a snp wins the tie
+\-------------------------------------------------------*/
+#if defined DELINSSNP || defined INSDELSNP
+   #define hirschVectInsTieBl(pref) 1
+   #define hirschVectDelTieBl(pref) 1
+
+#elif defined INSSNPDEL
+   #define hirschVectInsTieBl(pref) 1
+   #define hirschVectDelTieBl(pref) 0
+
+#elif defined DELSNPINS
+   #define hirschVectInsTieBl(pref) 0
+   #define hirschVectDelTieBl(pref) 1
+
+#elif defined SNPINSDEL || defined SNPDELINS
+   #define hirschVectInsTieBl(pref) 0
+   #define hirschVectDelTieBl(pref) 0
+
+#else
+   #define hirschVectInsTieBl(pref)(\
+         (pref) == defInsDelSnp\
+      || (pref) == defDelInsSnp\
+      || (pref) == defInsSnpDel\
+   )
+
+   #define hirschVectDelTieBl(pref)(\
+         (pref) == defInsDelSnp\
+      || (pref) == defDelInsSnp\
+      || (pref) == defDelSnpIns\
+   )
+#endif
+
+#ifdef DEFNOVECT
+   /*No vector support was compiled in, use the scalar
+   ` Hirschberg instead
+   */
+   #define hirschVect(refST, qryST, settings)(\
+      (settings)->noGapBl ?\
+           HirschbergNoGap((refST), (qryST), (settings))\
+         : Hirschberg((refST), (qryST), (settings))\
+   )
+#else
+
+/*-------------------------------------------------------\
+| Macro-03: hirschVectBits
+|   - Picks the number of bits to score a region with
+| Input:
+|   - qryLenUL:
+|     o Number of query bases in the region
+|   - refLenUL:
+|     o Number of reference bases in the region
+|   - maxPenL:
+|     o Largest absolute score or gap penalty (a cell is
+|       at most this far from the cell it came from)
+| Output:
+|   - Returns:
+|     o 16 if no score can overflow 16 bits
+|     o 32 if no score can overflow 32 bits
+|     o 0 if the scalar scoring step has to be used
+| Note:
+|   - A path has at most qryLenUL + refLenUL steps. The
+|     striped columns add up to one vector of padding rows
+|     and the gap/indel rows add one more step.
+\-------------------------------------------------------*/
+#define hirschVectBits(qryLenUL, refLenUL, maxPenL)(\
+   (qryLenUL) < defNum32BitElms ?\
+      0 /*Scalar is faster for a few query bases*/\
+   :   ((qryLenUL) + (refLenUL) + defNum16BitElms + 2)\
+     * (ulong) (maxPenL)\
+     <= defHirschMaxI16 ?\
+      16\
+   :   ((qryLenUL) + (refLenUL) + defNum32BitElms + 2)\
+     * (ulong) (maxPenL)\
+     <= defHirschMaxI32 ?\
+      32\
+   : 0\
+) /*hirschVectBits*/
+
+/*-------------------------------------------------------\
+| Fun-04: hirschVectScore
+|  - Finds the last row of scores for one half of a
+|    Hirschberg with the kernel picked by hirschVectBits
+| Input:
+|  - refSeqStr:
+|    o Reference sequence to align
+|  - refStartUL:
+|    o First base to align in the reference (index 0)
+|  - refLenUL:
+|    o Number of bases to align in the reference (index 1)
+|  - qrySeqStr:
+|    o Query sequence to align
+|  - qryStartUL:
+|    o First base to align in the query (index 0)
+|  - qryLenUL:
+|    o Number of bases to align in the query (index 1)
+|  - revBl:
+|    o 0: Score forwards (scoreHirschFor)
+|    o 1: Score backwards (scoreHirschRev)
+|  - scoreRowL:
+|    o Row to fill with the last row of scores
+|  - dirRow:
+|    o Direction row for the scalar scoring step
+|  - buffAryI:
+|    o Vector aligned buffer for the vector kernels (see
+|      hirschVectScoreI32)
+|  - profIndexAryUL:
+|    o Array of 256 zeros for the vector kernels
+|  - maxPenL:
+|    o Largest absolute score or gap penalty
+|  - settings:
+|    o Pointer to alnSet structure with the settings for
+|      the alignment
+| Output:
+|  - Modifies:
+|    o scoreRowL to have the last row of scores
+|  - Returns:
+|    o The gap column score
+\-------------------------------------------------------*/
+static long hirschVectScore(
+  char *refSeqStr,  /*Reference sequence*/
+  ulong refStartUL, /*1st reference base to align*/
+  ulong refLenUL,   /*number of reference bases to align*/
+  char *qrySeqStr,  /*Query sequence*/
+  ulong qryStartUL, /*1st query base to align (index 0)*/
+  ulong qryLenUL,   /*number of query bases to align*/
+  char revBl,       /*1: score backwards*/
+  long *scoreRowL,  /*Gets the last row of scores*/
+  char *dirRow,     /*Direction row for scalar scoring*/
+  void *buffAryI,   /*Buffer for the vector kernels*/
+  ulong *profIndexAryUL, /*Maps bases to profiles*/
+  long maxPenL,     /*Largest penalty*/
+  struct alnSet *settings /*Settings for alignment*/
+){
+   switch(hirschVectBits(qryLenUL, refLenUL, maxPenL))
+   { /*Switch: Find the kernel to use*/
+      case 16:
+         return
+            hirschVectScoreI16(
+               refSeqStr,
+               refStartUL,
+               refLenUL,
+               qrySeqStr,
+               qryStartUL,
+               qryLenUL,
+               revBl,
+               scoreRowL,
+               (int16_t *) buffAryI,
+               profIndexAryUL,
+               hirschVectInsTieBl(settings->bestDirC),
+               hirschVectDelTieBl(settings->bestDirC),
+               settings
+            );
+
+      case 32:
+         return
+            hirschVectScoreI32(
+               refSeqStr,
+               refStartUL,
+               refLenUL,
+               qrySeqStr,
+               qryStartUL,
+               qryLenUL,
+               revBl,
+               scoreRowL,
+               (int32_t *) buffAryI,
+               profIndexAryUL,
+               hirschVectInsTieBl(settings->bestDirC),
+               hirschVectDelTieBl(settings->bestDirC),
+               settings
+            );
+   } /*Switch: Find the kernel to use*/
+
+   if(revBl)
+      return
+         scoreHirschRev(
+            refSeqStr,
+            refStartUL,
+            refLenUL,
+            qrySeqStr,
+            qryStartUL,
+            qryLenUL,
+            scoreRowL,
+            dirRow,
+            settings
+         );
+
+   return
+      scoreHirschFor(
+         refSeqStr,
+         refStartUL,
+         refLenUL,
+         qrySeqStr,
+         qryStartUL,
+         qryLenUL,
+         scoreRowL,
+         dirRow,
+         settings
+      );
+} /*hirschVectScore*/
+
+/*-------------------------------------------------------\
+| Fun-05: hirschVectFun
+|  - Does the recursive part of a vector Hirschberg. This
+|    is HirschbergFun with hirschVectScore for the scoring
+|    steps.
+| Input
+|  - refSeqStr:
+|    o reference sequence to align
+|  - refStartUL:
+|    o First base to align in the reference (index 0)
+|  - refLenUL:
+|    o Number of bases to align in the reference (index 1)
+|  - qrySeqStr:
+|    o query sequence to align
+|  - qryStartUL:
+|    o First base to align in the query (index 0)
+|  - qryLenUL:
+|    o Number of bases to align in the query (index 1)
+|  - forScoreRowL:
+|    o Row holding the forward (1st half of query) scores
+|    o Must be the size of the full length reference
+|  - revScoreRowL:
+|    o Row holding the reverse (last half of query) scores
+|    o Must be the size of the full length reference
+|  - refAlnST:
+|    o Holds the reference alignment and is a temporary
+|      row for finding directions
+|  - qryAlnST:
+|    o Holds the query alignment
+|  - dirRow:
+|    o Is used for finding the directions in the scalar
+|      scoring step
+|  - buffAryI:
+|    o Vector aligned buffer for the vector kernels
+|  - profIndexAryUL:
+|    o Array of 256 zeros for the vector kernels
+|  - maxPenL:
+|    o Largest absolute score or gap penalty
+|  - settings:
+|    o Pointer to alnSet structure with the settings for
+|      the alignment
+| Output:
+|  - Modifies:
+|    o refAlnST to hold the reference alignment
+|    o qryAlnST to hold the query alignment
+\-------------------------------------------------------*/
+static void hirschVectFun(
+  char *refSeqStr,  /*Reference sequence*/
+  ulong refStartUL, /*1st reference base to align*/
+  ulong refLenUL,   /*number of reference bases to align*/
+
+  char *qrySeqStr,  /*Query sequence*/
+  ulong qryStartUL, /*1st query base to align (index 0)*/
+  ulong qryLenUL,   /*number of query bases to align*/
+
+  long *forScoreRowL, /*Holds final forward row*/
+  long *revScoreRowL, /*For finding reverse scores*/
+
+  char *refAlnST,  /*Holds output reference alignment*/
+  char *qryAlnST,  /*Holds the output query alignment*/
+  char *dirRow,    /*Direction row for scalar scoring*/
+
+  void *buffAryI,         /*Buffer for vector kernels*/
+  ulong *profIndexAryUL,  /*Maps bases to profiles*/
+  long maxPenL,           /*Largest penalty*/
+  struct alnSet *settings /*Settings for alignment*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-05 TOC: hirschVectFun
+   '  - Does the recursive part of a vector Hirschberg
+   '  o fun-05 sec-01:
+   '    - Variable declerations
+   '  o fun-05 sec-02:
+   '    - Check if on a leaf (final part of alignment)
+   '  o fun-05 sec-03:
+   '    - Get scores
+   '  o fun-05 sec-04:
+   '    - Find the midpoint
+   '  o fun-05 sec-05:
+   '    - Run the next hirschberg alignment
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^  Fun-05 Sec-01:
+   ^    - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   long forGapColL = 0;
+   long revGapColL = 0;
+   ulong midPointUL = 0;
+   ulong ulFor = 0; /*Loop iterator (forward score)*/
+   ulong ulGapOn = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-05 Sec-02:
+   ^  - Check if on a leaf (final part of alignment)
+   ^  o fun-05 sec-02 sub-01:
+   ^    - Handle cases were I have just insertions
+   ^  o fun-05 sec-02 sub-02:
+   ^    - Handle cases were I have just deletions
+   ^  o fun-05 sec-02 sub-03:
+   ^    - Handle cases were I have to align last ref base
+   ^  o fun-05 sec-02 sub-04:
+   ^    - Handle cases were I have to align last query base
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*****************************************************\
+   * Fun-05 Sec-02 Sub-01:
+   *  - Handle cases were I have just insertions
+   \*****************************************************/
+
+   if(refLenUL == 0)
+   { /*If all remaing bases are query insertions*/
+      for(
+         ulGapOn = qryStartUL;
+         ulGapOn < qryLenUL + qryStartUL;
+         ++ulGapOn
+      ) qryAlnST[ulGapOn] = defGapFlag;
+
+      return; /*Nothing else to do*/
+   } /*If all remaing bases are query insertions*/
+
+   /*****************************************************\
+   * Fun-05 Sec-02 Sub-02:
+   *  - Handle cases were I have just deletions
+   \*****************************************************/
+
+   if(qryLenUL == 0)
+   { /*If all remaing bases are query deletions*/
+      for(
+         ulGapOn = refStartUL;
+         ulGapOn < refLenUL + refStartUL;
+         ++ulGapOn
+      ) refAlnST[ulGapOn] = defGapFlag;
+
+      return; /*Nothing else to do*/
+   } /*If all remaing bases are query deletions*/
+
+   /*****************************************************\
+   * Fun-05 Sec-02 Sub-03:
+   *  - Handle cases were I have to align last ref base
+   \*****************************************************/
+
+   if(refLenUL == 1)
+   { /*If I have to align the last reference base*/
+      if(qryLenUL == 1)
+      { /*If bases are aligned (one ref & one query)*/
+         qryAlnST[qryStartUL] = defSnpFlag;
+         refAlnST[refStartUL] = defSnpFlag;
+         return; /*Finished*/
+      } /*If bases are aligned (one ref & one query)*/
+
+      positionSingleBase(
+        refSeqStr[refStartUL],  /*ref base*/
+        refStartUL,             /*Position of ref base*/
+        qrySeqStr,              /*first base of query*/
+        qryStartUL,             /*positoin of query*/
+        qryLenUL,               /*Length of the query*/
+        refAlnST,               /*Array to hold alignment*/
+        qryAlnST,               /*Array to hold alignment*/
+        settings                /*Has Scoring variables*/
+      );
+
+      return; /*This base is now aligned*/
+   } /*If I have to align the last reference base*/
+
+   /*****************************************************\
+   * Fun-05 Sec-02 Sub-04:
+   *  - Handle cases were I have to align last query base
+   \*****************************************************/
+
+   if(qryLenUL == 1)
+   { /*If I have to align the last query base*/
+      positionSingleBase(
+        qrySeqStr[qryStartUL],  /*query base*/
+        qryStartUL,             /*Position of query base*/
+        refSeqStr,              /*first base of reference*/
+        refStartUL,             /*positoin of reference*/
+        refLenUL,               /*Length of the reference*/
+        qryAlnST,               /*Array to hold alignment*/
+        refAlnST,               /*Array to hold alignment*/
+        settings                /*Has Scoring variables*/
+      );
+
+      return; /*Finshed aligning this query base*/
+   } /*If I have to align the last query base*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-05 Sec-03:
+   ^  - Get scores
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   forGapColL =
+      hirschVectScore(
+         refSeqStr,       /*Entire reference sequence*/
+         refStartUL,      /*Starting base of ref target*/
+         refLenUL,        /*length of ref target region*/
+         qrySeqStr,       /*Query seq with coordinates*/
+         qryStartUL,      /*Starting base of query target*/
+         qryLenUL / 2,    /*Length of query target region*/
+         0,               /*Score forwards*/
+         forScoreRowL,    /*Array of scores to fill*/
+         refAlnST,        /*direction row for gap extend*/
+         buffAryI,        /*Buffer for vector kernels*/
+         profIndexAryUL,  /*For the query profiles*/
+         maxPenL,         /*For picking the kernel*/
+         settings         /*setttings to use*/
+      ); /*Get the scores for the forward direction*/
+
+   revGapColL =
+      hirschVectScore(
+         refSeqStr,       /*Entire reference sequence*/
+         refStartUL,      /*Starting base of ref target*/
+         refLenUL,        /*length of ref target region*/
+         qrySeqStr,       /*Query seq with coordinates*/
+         qryStartUL + (qryLenUL / 2),/*new query start*/
+         qryLenUL - (qryLenUL / 2),  /*New query length*/
+         1,               /*Score backwards*/
+         revScoreRowL,    /*Array of scores to fill*/
+         dirRow,          /*direction row for gap extend*/
+         buffAryI,        /*Buffer for vector kernels*/
+         profIndexAryUL,  /*For the query profiles*/
+         maxPenL,         /*For picking the kernel*/
+         settings         /*setttings to use*/
+      ); /*Get the scores for the reverse direction*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^  Fun-05 Sec-04:
+   ^   - Find the midpoint
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   forScoreRowL[refStartUL + refLenUL - 1] += revGapColL;
+   midPointUL = refStartUL + refLenUL - 1;
+
+   for(
+      ulFor = refStartUL;
+      ulFor < refStartUL + refLenUL - 1;
+      ++ulFor
+   ){ /*Loop; add up all scores*/
+      forScoreRowL[ulFor] += revScoreRowL[ulFor + 1];
+        /*The reverse row is already reversed*/
+
+      if(forScoreRowL[ulFor] > forScoreRowL[midPointUL])
+         midPointUL = ulFor;
+   } /*Loop; add up all scores*/
+
+   forGapColL += revScoreRowL[refStartUL];
+
+   if(forGapColL > forScoreRowL[midPointUL])
+      midPointUL = 0;
+   else midPointUL = midPointUL + 1 - refStartUL;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^  Fun-05 Sec-05:
+   ^    - Run the next hirschberg alignment
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   hirschVectFun(
+     refSeqStr,      /*Full reference sequence*/
+     refStartUL,     /*Start of reference target region*/
+     midPointUL,     /*Length of new reference sequence*/
+     qrySeqStr,      /*Full query sequence*/
+     qryStartUL,     /*Start of query target region*/
+     qryLenUL / 2,   /*Length of query target region*/
+     forScoreRowL,   /*For scoring*/
+     revScoreRowL,   /*For scoring*/
+     refAlnST,       /*Holds reference alignment*/
+     qryAlnST,       /*Holds query alignment*/
+     dirRow,         /*For scalar scoring*/
+     buffAryI,       /*For vector scoring*/
+     profIndexAryUL, /*For vector scoring*/
+     maxPenL,        /*For picking the kernel*/
+     settings        /*Settings for the alignment*/
+   );
+
+   hirschVectFun(
+     refSeqStr,              /*Full reference sequence*/
+     refStartUL + midPointUL,/*New reference start*/
+     refLenUL - midPointUL,  /*New reference end*/
+     qrySeqStr,              /*Full query sequence*/
+     qryStartUL + (qryLenUL / 2),/*New query start*/
+     qryLenUL - (qryLenUL / 2),  /*New query length*/
+     forScoreRowL,           /*For scoring*/
+     revScoreRowL,           /*For scoring*/
+     refAlnST,               /*Holds reference alingment*/
+     qryAlnST,               /*Holds query alingment*/
+     dirRow,                 /*For scalar scoring*/
+     buffAryI,               /*For vector scoring*/
+     profIndexAryUL,         /*For vector scoring*/
+     maxPenL,                /*For picking the kernel*/
+     settings                /*Settings for alignment*/
+   );
+
+   return;
+} /*hirschVectFun*/
+
+/*-------------------------------------------------------\
+| Fun-06: hirschVect
+|  - Sets up for and calls the recursive function to run
+|    a Hirschberg alignment with vector scoring
+| Input:
+|  - refST:
+|    o Pointer to seqStruct structure with the reference
+|      sequence and the first base (offsetUL) and last
+|      base (endAlnUL) to align (both are index 0)
+|  - qryST:
+|    o Pointer to seqStruct structure with the query
+|      sequence and the first base (offsetUL) and last
+|      base (endAlnUL) to align (both are index 0)
+|  - settings:
+|    o Pointer to alnSet structure with the settings for
+|      the alignment
+| Output:
+|  - Returns:
+|    o A alignment structure with the alignment (same as
+|      Hirschberg or HirschbergNoGap)
+|    o 0 For memory errors
+\-------------------------------------------------------*/
+static struct alnStruct * hirschVect(
+  struct seqStruct *refST, /*Reference sequence to align*/
+  struct seqStruct *qryST, /*Qeury sequence to align*/
+  struct alnSet *settings  /*Settings for alignment*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-06 TOC: hirschVect
+   '  - Sets up for and calls the recursive function to
+   '    run a vector Hirschberg alignment
+   '  o fun-06 sec-01:
+   '    - Variable declerations
+   '  o fun-06 sec-02:
+   '    - Find the settings and largest penalty
+   '  o fun-06 sec-03:
+   '    - Memory allocation (set up for Hirschberg)
+   '  o fun-06 sec-04:
+   '    - Run the hirschberg alignment
+   '  o fun-06 sec-05:
+   '    - Clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^  Fun-06 Sec-01:
+   ^    - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
+   ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
+     /*+ 1 to convert to index 1 (values are index 0)*/
+
+   ulong profIndexAryUL[256];
+   ulong numProfUL = 0;
+   ulong ulBase = 0;
+   ulong ulCol = 0;
+   long maxPenL = 0;
+
+   long *forwardScoreRowL = 0;
+   long *reverseScoreRowL = 0;
+
+   struct alnStruct *alnST = 0;
+   struct alnSet gapSetST; /*Settings with the gap penalty*/
+   struct vectMemBlock memST;
+
+   char *refAln = 0;
+   char *qryAln = 0;
+   char *dirRow = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^  Fun-06 Sec-02:
+   ^   - Find the settings and largest penalty
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(settings->vectSetC == defVectScalar)
+   { /*If: the user wanted the scalar aligners*/
+      if(settings->noGapBl)
+         return HirschbergNoGap(refST, qryST, settings);
+
+      return Hirschberg(refST, qryST, settings);
+   } /*If: the user wanted the scalar aligners*/
+
+   /*The scalar scoring steps use the profile. It is made
+   ` before copying the settings so the rows are kept in
+   ` settings.
+   */
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         lenQryUL,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
+   gapSetST = *settings;
+
+   /*No gap extension is a gap extension of gap open*/
+   if(gapSetST.noGapBl)
+      gapSetST.gapExtendC = gapSetST.gapOpenC;
+
+   maxPenL = gapSetST.gapOpenC;
+   if(maxPenL < 0) maxPenL = -maxPenL;
+
+   if(gapSetST.gapExtendC > maxPenL)
+      maxPenL = gapSetST.gapExtendC;
+   else if(-gapSetST.gapExtendC > maxPenL)
+      maxPenL = -gapSetST.gapExtendC;
+
+   for(ulBase = 0; ulBase < defMatrixCol; ++ulBase)
+   { /*Loop: find the largest score in the matrix*/
+      for(ulCol = 0; ulCol < defMatrixCol; ++ulCol)
+      { /*Loop: check each column*/
+         if(gapSetST.scoreMatrixC[ulBase][ulCol] > maxPenL)
+            maxPenL = gapSetST.scoreMatrixC[ulBase][ulCol];
+
+         else if(
+            -gapSetST.scoreMatrixC[ulBase][ulCol] > maxPenL
+         ) maxPenL = -gapSetST.scoreMatrixC[ulBase][ulCol];
+      } /*Loop: check each column*/
+   } /*Loop: find the largest score in the matrix*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^  Fun-06 Sec-03:
+   ^   - Memory allocation (set up for Hirschberg)
+   ^   o fun-06 sec-03 sub-01:
+   ^     - Initalize the ouput alignment arrays
+   ^   o fun-06 sec-03 sub-02:
+   ^     - Initalize the scoring rows
+   ^   o fun-06 sec-03 sub-03:
+   ^     - Initalize the vector buffer
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*****************************************************\
+   * Fun-06 Sec-03 Sub-01:
+   *  - Initalize the ouput alignment arrays
+   \*****************************************************/
+
+   initVectMemBlock(&memST);
+
+   refAln = calloc(lenRefUL + 1, sizeof(char));
+   if(refAln == 0) goto memErr;
+   refAln[lenRefUL] = defEndAlnFlag;
+
+   dirRow = calloc(lenRefUL + 1, sizeof(char));
+   if(dirRow == 0) goto memErr;
+
+   qryAln = calloc(lenQryUL + 1, sizeof(char));
+   if(qryAln == 0) goto memErr;
+
+   /*****************************************************\
+   * Fun-06 Sec-03 Sub-02:
+   *  - Initalize the scoring rows
+   \*****************************************************/
+
+   forwardScoreRowL = malloc(sizeof(long) * lenRefUL);
+   if(forwardScoreRowL == 0) goto memErr;
+
+   reverseScoreRowL = malloc(sizeof(long) * lenRefUL);
+   if(reverseScoreRowL == 0) goto memErr;
+
+   /*****************************************************\
+   * Fun-06 Sec-03 Sub-03:
+   *  - Initalize the vector buffer
+   \*****************************************************/
+
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+      profIndexAryUL[ulBase] = 0;
+
+   /*Find the number of profiles I need*/
+   for(ulBase = 0; ulBase < lenRefUL; ++ulBase)
+   { /*Loop: find the bases in the reference*/
+      ulCol =
+         (uchar) refST->seqCStr[refST->offsetUL + ulBase];
+
+      if(profIndexAryUL[ulCol] == 0)
+      { /*If: this is a new base*/
+         ++numProfUL;
+         profIndexAryUL[ulCol] = numProfUL;
+      } /*If: this is a new base*/
+   } /*Loop: find the bases in the reference*/
+
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+      profIndexAryUL[ulBase] = 0;
+
+   /*Each kernel needs a profile for each base, four
+   ` striped columns, and one vector (lane 0 mask). A
+   ` striped column is at most one vector longer than the
+   ` query. 32 bits is the largest element.
+   */
+   mallocVectMemBlock(
+      &memST,
+        (numProfUL + 5) * (lenQryUL + defNum8BitElms)
+      * sizeof(int32_t)
+   );
+
+   if(memST.freePtr == 0) goto memErr;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^  Fun-06 Sec-04:
+   ^    - Run the Hirschberg alignment
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*Sending in offset values, because alignment array is
+   ` sized to the alignmnet region
+   */
+   hirschVectFun(
+     refST->seqCStr + refST->offsetUL,
+     0,                /*1st reference base to align*/
+     lenRefUL,         /*Length of ref region to align*/
+     qryST->seqCStr + qryST->offsetUL,
+     0,                /*1st query base to align*/
+     lenQryUL,         /*length of query target region*/
+     forwardScoreRowL, /*For scoring*/
+     reverseScoreRowL, /*For scoring*/
+     refAln,           /*Holds the reference alignment*/
+     qryAln,           /*Holds the query alignment*/
+     dirRow,           /*Direction row for scalar scoring*/
+     memST.alnPtr,     /*Buffer for vector scoring*/
+     profIndexAryUL,   /*Maps bases to query profiles*/
+     maxPenL,          /*For picking the kernel*/
+     &gapSetST         /*Settings for the alignment*/
+   );
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^  Fun-06 Sec-05:
+   ^    - Clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   alnST =
+     hirschToAlnST(refST,qryST,settings,refAln,qryAln);
+
+   memErr:
+
+   freeVectMemBlockBuff(&memST);
+
+   free(forwardScoreRowL);
+   free(reverseScoreRowL);
+   free(dirRow);
+   free(refAln);
+   free(qryAln);
+
+   return alnST; /*Is 0 for memory errors*/
+} /*hirschVect*/
+
+#endif /*DEFNOVECT*/
+#endif
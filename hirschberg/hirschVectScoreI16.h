@@ -0,0 +1,611 @@
+/*########################################################
+# Name hirschVectScoreI16
+# Use:
+#  o Holds the 16 bit vector scoring step for a Hirschberg
+#    alignment (see hirschVect.h). This finds the same last
+#    row of scores as scoreHirschFor and scoreHirschRev.
+#  o The query is striped (Farrar) across 16 bit vectors
+#    and each reference base is scored against the full
+#    query in one pass. A lazy-F loop then corrects the
+#    insertions that cross segments. The last query row is
+#    copied out after each reference base.
+#  o There are no overflow checks. hirschVect only uses
+#    this when every score in the region fits in 16 bits
+#    (see hirschVectBits), else it uses the 32 bit kernel.
+# Libraries:
+#   - "genHirsch.h"                    (No .c file)
+#   o "../general/alnSetStruct.h"      (No .c file)
+#   o "../general/alnSeqDefaults.h"    (No .c file)
+#   o "../general/dataTypeShortHand.h" (No .c file)
+#   - "../vectWrap/vectWrap.h"         (No .c file)
+# C Standard libraries:
+#   - <stdint.h>
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+' o macro-01 hirschVectScoreSegI16:
+'   - Scores one segment (vector) of the striped query for
+'     a single reference base
+' o fun-02 hirschVectScoreI16:
+'   - Finds the last row of scores for a Hirschberg with
+'     16 bit vectors (forward or reverse direction)
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#ifndef HIRSCH_VECT_SCORE_I16_H
+#define HIRSCH_VECT_SCORE_I16_H
+
+#include <stdint.h>
+
+#include "genHirsch.h"
+#include "../vectWrap/vectWrap.h"
+
+#ifndef DEFNOVECT
+
+/*Smallest 16 bit score; is never added to*/
+#define defHirschMinI16 (-32767 - 1)
+
+/*-------------------------------------------------------\
+| Macro-01: hirschVectScoreSegI16
+|   - Scores one segment (vector) of the striped query for
+|     a single reference base
+|   - This follows hirschScore, so a gap is kept if an
+|     insertion or deletion beats the snp. insTieVI and
+|     delTieVI decide if a gap wins a tie with a snp.
+| Input:
+|   - diagVI:
+|     o Scores for the cells on the diagnol (snp)
+|   - profVI:
+|     o Query profile scores for this reference base
+|   - leftVI:
+|     o Scores for the cells to the left (deletions)
+|   - leftGapVI:
+|     o -1 if the left cell was a gap, else 0
+|   - insVI:
+|     o Insertion score (cell above + gap penalty)
+|   - openVI:
+|     o Gap opening penalty
+|   - gapDiffVI:
+|     o Gap extension penalty - gap opening penalty
+|   - insTieVI:
+|     o -1 if an insertion wins a tie with a snp
+|   - delTieVI:
+|     o -1 if a deletion wins a tie with a snp
+|   - scoreVI:
+|     o Will hold the score for each cell
+|   - gapVI:
+|     o Will hold -1 if a cell was a gap, else 0
+| Output:
+|   - Modifies:
+|     o scoreVI and gapVI
+\-------------------------------------------------------*/
+#define hirschVectScoreSegI16(\
+   diagVI,     /*Diagnol scores*/\
+   profVI,     /*Query profile for the reference base*/\
+   leftVI,     /*Scores to the left*/\
+   leftGapVI,  /*-1 if left cell was a gap*/\
+   insVI,      /*Insertion scores*/\
+   openVI,     /*Gap opening penalty*/\
+   gapDiffVI,  /*gap extension - gap open*/\
+   insTieVI,   /*-1: insertions win ties with snps*/\
+   delTieVI,   /*-1: deletions win ties with snps*/\
+   scoreVI,    /*Gets scores*/\
+   gapVI       /*Gets -1 for gaps, 0 for snps*/\
+){ /*hirschVectScoreSegI16*/\
+   vectI16 macroSnpVI =\
+      add_vectI16_retVectI16((diagVI), (profVI));\
+   \
+   vectI16 macroDelVI =\
+      add_vectI16_retVectI16(\
+         add_vectI16_retVectI16((leftVI), (openVI)),\
+         and_vectI16_retVectI16((leftGapVI), (gapDiffVI))\
+      );\
+   \
+   (gapVI) =\
+      or_vectI16_retVectI16(\
+         mask16_retVectI16(\
+            cmpgt_vectI16_retMask16(macroDelVI, macroSnpVI)\
+         ),\
+         and_vectI16_retVectI16(\
+            (delTieVI),\
+            mask16_retVectI16(\
+               cmpeq_vectI16_retMask16(\
+                  macroDelVI,\
+                  macroSnpVI\
+               )\
+            )\
+         )\
+      );\
+   \
+   (gapVI) =\
+      or_vectI16_retVectI16(\
+         (gapVI),\
+         mask16_retVectI16(\
+            cmpgt_vectI16_retMask16((insVI), macroSnpVI)\
+         )\
+      );\
+   \
+   (gapVI) =\
+      or_vectI16_retVectI16(\
+         (gapVI),\
+         and_vectI16_retVectI16(\
+            (insTieVI),\
+            mask16_retVectI16(\
+               cmpeq_vectI16_retMask16((insVI), macroSnpVI)\
+            )\
+         )\
+      );\
+   \
+   (scoreVI) = max_vectI16_retVectI16(macroDelVI, (insVI));\
+   (scoreVI) = max_vectI16_retVectI16((scoreVI), macroSnpVI);\
+} /*hirschVectScoreSegI16*/
+
+/*-------------------------------------------------------\
+| Fun-02: hirschVectScoreI16
+|   - Finds the last row of scores for a Hirschberg with
+|     a striped query and 16 bit vectors
+| Input:
+|   - refSeqStr:
+|     o C-string with the reference sequence to align
+|   - refStartUL:
+|     o First base to align in the reference (index 0)
+|   - refLenUL:
+|     o Number of bases to align in the reference
+|       (index 1)
+|   - qrySeqStr:
+|     o C-string with the query sequence to align
+|   - qryStartUL:
+|     o First base to align in the query (index 0)
+|   - qryLenUL:
+|     o Number of bases to align in the query (index 1)
+|   - revBl:
+|     o 0: Score forwards (same as scoreHirschFor)
+|     o 1: Score backwards (same as scoreHirschRev)
+|   - scoreRowL:
+|     o Array to fill with the last row of scores
+|   - buffAryI:
+|     o Vector aligned buffer to hold the query profile
+|       and the striped columns. It must hold
+|       (number profiles + 4) * (qryLenUL + vector length)
+|       int16_t's
+|   - profIndexAryUL:
+|     o Array of 256 ulongs set to 0. This is used to map
+|       reference bases to their profile and is set back
+|       to 0 before returning
+|   - insTieBl:
+|     o 1: an insertion wins a tie with a snp; 0 does not
+|   - delTieBl:
+|     o 1: a deletion wins a tie with a snp; 0 does not
+|   - settings:
+|     o alnSet structure with the gap penalties and the
+|       scoring matrix
+| Output:
+|   - Modifies:
+|     o scoreRowL to hold the last row of scores
+|   - Returns:
+|     o The gap column score
+\-------------------------------------------------------*/
+static long hirschVectScoreI16(
+   char *refSeqStr,  /*Reference sequence*/
+   ulong refStartUL, /*1st reference base to score*/
+   ulong refLenUL,   /*Number of reference bases*/
+   char *qrySeqStr,  /*Query sequence*/
+   ulong qryStartUL, /*1st query base to score*/
+   ulong qryLenUL,   /*Number of query bases*/
+   char revBl,       /*1: score backwards*/
+   long *scoreRowL,  /*Gets the last row of scores*/
+   int16_t *buffAryI,       /*Vector aligned buffer*/
+   ulong *profIndexAryUL,   /*Maps bases to profiles*/
+   char insTieBl,    /*1: insertions win snp ties*/
+   char delTieBl,    /*1: deletions win snp ties*/
+   struct alnSet *settings  /*Settings for alignment*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-02 TOC: hirschVectScoreI16
+   '  - Finds the last row of scores for a Hirschberg
+   '  o fun-02 sec-01:
+   '    - Variable declerations
+   '  o fun-02 sec-02:
+   '    - Build the query profile
+   '  o fun-02 sec-03:
+   '    - Set up the gap column and constant vectors
+   '  o fun-02 sec-04:
+   '    - Score each reference base
+   '  o fun-02 sec-05:
+   '    - Clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*Number of vectors in one striped column*/
+   ulong lenSegUL =
+      (qryLenUL + defNum16BitElms - 1) / defNum16BitElms;
+
+   /*Number of elements in one striped column*/
+   ulong lenColUL = lenSegUL * defNum16BitElms;
+
+   /*Index of the last query row in a striped column*/
+   ulong lastRowUL =
+        ((qryLenUL - 1) % lenSegUL) * defNum16BitElms
+      + (qryLenUL - 1) / lenSegUL;
+
+   ulong ulRef = 0;
+   ulong ulSeg = 0;
+   ulong ulElm = 0;
+   ulong ulBase = 0;
+   ulong rowUL = 0;
+   ulong offsetUL = 0;
+   ulong maskUL = 0;
+   ulong numProfUL = 0;
+
+   int16_t topI = 0;     /*Score of the indel row*/
+   int16_t lastTopI = 0; /*Last score in the indel row*/
+
+   int16_t *profAryI = 0;  /*Query profile*/
+   int16_t *profOnI = 0;   /*Profile for reference base*/
+   int16_t *lane0AryI = 0; /*-1 for lane 0, else 0*/
+
+   int16_t *scoreAryI = 0;    /*Current column*/
+   int16_t *gapAryI = 0;
+   int16_t *oldScoreAryI = 0; /*Last column*/
+   int16_t *oldGapAryI = 0;
+   int16_t *swapPtrI = 0;
+
+   vectI16 zeroVI = zero_retVectI16();
+   vectI16 minVI = set1_I16_retVectI16(defHirschMinI16);
+
+   vectI16 openVI;
+   vectI16 gapDiffVI;
+   vectI16 insTieVI;
+   vectI16 delTieVI;
+   vectI16 lane0VI;
+
+   vectI16 topInsVI;   /*Insertion from the indel row*/
+   vectI16 firstDiagVI;
+   vectI16 diagVI;
+   vectI16 leftVI;
+   vectI16 leftGapVI;
+   vectI16 insVI;
+   vectI16 scoreVI;
+   vectI16 gapVI;
+   vectI16 sameVI;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-02:
+   ^  - Build the query profile
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(
+      ulRef = refStartUL;
+      ulRef < refStartUL + refLenUL;
+      ++ulRef
+   ){ /*Loop: find the bases in the reference*/
+      if(profIndexAryUL[(uchar) refSeqStr[ulRef]] == 0)
+      { /*If: this is a new base*/
+         ++numProfUL;
+         profIndexAryUL[(uchar) refSeqStr[ulRef]] =
+            numProfUL;
+      } /*If: this is a new base*/
+   } /*Loop: find the bases in the reference*/
+
+   profAryI = buffAryI;
+   scoreAryI = profAryI + numProfUL * lenColUL;
+   gapAryI = scoreAryI + lenColUL;
+   oldScoreAryI = gapAryI + lenColUL;
+   oldGapAryI = oldScoreAryI + lenColUL;
+   lane0AryI = oldGapAryI + lenColUL;
+
+   /* Element ulElm in segment ulSeg is query row
+   `  ulElm * lenSegUL + ulSeg (striped). Rows are read
+   `  from the end of the query for the reverse direction.
+   */
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+   { /*Loop: build the profile for each reference base*/
+      if(profIndexAryUL[ulBase] == 0) continue;
+
+      profOnI =
+         profAryI + (profIndexAryUL[ulBase] - 1) * lenColUL;
+
+      for(ulSeg = 0; ulSeg < lenSegUL; ++ulSeg)
+      { /*Loop: Fill in each segment*/
+         for(ulElm = 0; ulElm < defNum16BitElms; ++ulElm)
+         { /*Loop: Fill in each element*/
+            rowUL = ulElm * lenSegUL + ulSeg;
+
+            if(rowUL >= qryLenUL) *profOnI = 0;
+
+            else if(revBl)
+               *profOnI =
+                  getBaseScore(
+                     qrySeqStr[qryStartUL+qryLenUL-1-rowUL],
+                     (char) ulBase,
+                     settings
+                  );
+
+            else
+               *profOnI =
+                  getBaseScore(
+                     qrySeqStr[qryStartUL + rowUL],
+                     (char) ulBase,
+                     settings
+                  );
+
+            ++profOnI;
+         } /*Loop: Fill in each element*/
+      } /*Loop: Fill in each segment*/
+   } /*Loop: build the profile for each reference base*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-03:
+   ^  - Set up the gap column and constant vectors
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(ulSeg = 0; ulSeg < lenSegUL; ++ulSeg)
+   { /*Loop: set up each segment*/
+      for(ulElm = 0; ulElm < defNum16BitElms; ++ulElm)
+      { /*Loop: set up each element*/
+         rowUL = ulElm * lenSegUL + ulSeg;
+         offsetUL = ulSeg * defNum16BitElms + ulElm;
+
+         /*The gap column is gapOpen + row * gapExtend and
+         ` is always extended (see scoreHirschFor)
+         */
+         oldScoreAryI[offsetUL] =
+              settings->gapOpenC
+            + (int16_t) rowUL * settings->gapExtendC;
+
+         oldGapAryI[offsetUL] = -1;
+      } /*Loop: set up each element*/
+   } /*Loop: set up each segment*/
+
+   for(ulElm = 0; ulElm < defNum16BitElms; ++ulElm)
+      lane0AryI[ulElm] = -(ulElm == 0);
+
+   lane0VI = load_I16Ary_retVectI16(lane0AryI);
+   openVI = set1_I16_retVectI16(settings->gapOpenC);
+
+   gapDiffVI =
+      set1_I16_retVectI16(
+         settings->gapExtendC - settings->gapOpenC
+      );
+
+   insTieVI = set1_I16_retVectI16(-((int16_t) insTieBl));
+   delTieVI = set1_I16_retVectI16(-((int16_t) delTieBl));
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-04:
+   ^  - Score each reference base
+   ^  o fun-02 sec-04 sub-01:
+   ^    - Set up for the next reference base
+   ^  o fun-02 sec-04 sub-02:
+   ^    - Score each segment (insertions stay in lane)
+   ^  o fun-02 sec-04 sub-03:
+   ^    - Lazy-F loop; move insertions across lanes
+   ^  o fun-02 sec-04 sub-04:
+   ^    - Copy out the last row and swap columns
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   lastTopI = 0;            /*Corner of the matrix*/
+   topI = settings->gapOpenC;
+
+   for(ulRef = 0; ulRef < refLenUL; ++ulRef)
+   { /*Loop: score each reference base*/
+
+      /**************************************************\
+      * Fun-02 Sec-04 Sub-01:
+      *  - Set up for the next reference base
+      \**************************************************/
+
+      if(revBl) ulBase = refStartUL + refLenUL - 1 - ulRef;
+      else ulBase = refStartUL + ulRef;
+
+      profOnI =
+           profAryI
+         +   (profIndexAryUL[(uchar) refSeqStr[ulBase]] - 1)
+           * lenColUL;
+
+      /*The indel row is always a gap, so the first query
+      ` row gets an extended insertion
+      */
+      topInsVI =
+         and_vectI16_retVectI16(
+            lane0VI,
+            set1_I16_retVectI16(topI + settings->gapExtendC)
+         );
+
+      /*Segment 0 is the row below the last segment, but
+      ` shifted one element. Lane 0 is under the indel row
+      */
+      offsetUL = (lenSegUL - 1) * defNum16BitElms;
+
+      firstDiagVI =
+         or_vectI16_retVectI16(
+            slvect_vectI16_retVectI16(
+               load_I16Ary_retVectI16(oldScoreAryI + offsetUL),
+               1
+            ),
+            and_vectI16_retVectI16(
+               lane0VI,
+               set1_I16_retVectI16(lastTopI)
+            )
+         );
+
+      diagVI = firstDiagVI;
+
+      /*The first pass does not carry insertions between
+      ` lanes. The lazy-F loop fixes this.
+      */
+      insVI =
+         or_vectI16_retVectI16(
+            topInsVI,
+            andNot_vectI16_retVectI16(lane0VI, minVI)
+         );
+
+      /**************************************************\
+      * Fun-02 Sec-04 Sub-02:
+      *  - Score each segment (insertions stay in lane)
+      \**************************************************/
+
+      for(ulSeg = 0; ulSeg < lenSegUL; ++ulSeg)
+      { /*Loop: score each segment*/
+         offsetUL = ulSeg * defNum16BitElms;
+
+         leftVI = load_I16Ary_retVectI16(oldScoreAryI+offsetUL);
+         leftGapVI = load_I16Ary_retVectI16(oldGapAryI+offsetUL);
+
+         hirschVectScoreSegI16(
+            diagVI,
+            load_I16Ary_retVectI16(profOnI + offsetUL),
+            leftVI,
+            leftGapVI,
+            insVI,
+            openVI,
+            gapDiffVI,
+            insTieVI,
+            delTieVI,
+            scoreVI,
+            gapVI
+         );
+
+         store_vectI16_retAryI16(scoreAryI+offsetUL,scoreVI);
+         store_vectI16_retAryI16(gapAryI + offsetUL, gapVI);
+
+         /*Insertion score for the next segment*/
+         insVI =
+            add_vectI16_retVectI16(
+               add_vectI16_retVectI16(scoreVI, openVI),
+               and_vectI16_retVectI16(gapVI, gapDiffVI)
+            );
+
+         diagVI = leftVI;
+      } /*Loop: score each segment*/
+
+      /**************************************************\
+      * Fun-02 Sec-04 Sub-03:
+      *  - Lazy-F loop; move insertions across lanes
+      \**************************************************/
+
+      /* Each segment is rescored with the insertion from
+      `  the lane below until no cell in a segment changes.
+      `  A segment with no changes means every later
+      `  segment was scored with the right insertions.
+      */
+      insVI =
+         or_vectI16_retVectI16(
+            slvect_vectI16_retVectI16(insVI, 1),
+            topInsVI
+         );
+
+      diagVI = firstDiagVI;
+      ulSeg = 0;
+
+      while(1)
+      { /*Loop: Lazy-F loop*/
+         offsetUL = ulSeg * defNum16BitElms;
+
+         leftVI = load_I16Ary_retVectI16(oldScoreAryI+offsetUL);
+         leftGapVI = load_I16Ary_retVectI16(oldGapAryI+offsetUL);
+
+         hirschVectScoreSegI16(
+            diagVI,
+            load_I16Ary_retVectI16(profOnI + offsetUL),
+            leftVI,
+            leftGapVI,
+            insVI,
+            openVI,
+            gapDiffVI,
+            insTieVI,
+            delTieVI,
+            scoreVI,
+            gapVI
+         );
+
+         /*Check if any cell in this segment changed*/
+         sameVI =
+            and_vectI16_retVectI16(
+               mask16_retVectI16(
+                  cmpeq_vectI16_retMask16(
+                     scoreVI,
+                     load_I16Ary_retVectI16(scoreAryI+offsetUL)
+                  )
+               ),
+               mask16_retVectI16(
+                  cmpeq_vectI16_retMask16(
+                     gapVI,
+                     load_I16Ary_retVectI16(gapAryI+offsetUL)
+                  )
+               )
+            );
+
+         store_mask16_retUL(
+            maskUL,
+            cmpgt_vectI16_retMask16(zeroVI, sameVI)
+         ); /*sameVI is -1 (< 0) for unchanged cells*/
+
+         if(maskUL == defMvMask16) break;
+
+         store_vectI16_retAryI16(scoreAryI+offsetUL,scoreVI);
+         store_vectI16_retAryI16(gapAryI + offsetUL, gapVI);
+
+         insVI =
+            add_vectI16_retVectI16(
+               add_vectI16_retVectI16(scoreVI, openVI),
+               and_vectI16_retVectI16(gapVI, gapDiffVI)
+            );
+
+         diagVI = leftVI;
+         ++ulSeg;
+
+         if(ulSeg == lenSegUL)
+         { /*If: I need to move to the next lane*/
+            insVI =
+               or_vectI16_retVectI16(
+                  slvect_vectI16_retVectI16(insVI, 1),
+                  topInsVI
+               );
+
+            diagVI = firstDiagVI;
+            ulSeg = 0;
+         } /*If: I need to move to the next lane*/
+      } /*Loop: Lazy-F loop*/
+
+      /**************************************************\
+      * Fun-02 Sec-04 Sub-04:
+      *  - Copy out the last row and swap columns
+      \**************************************************/
+
+      scoreRowL[ulBase] = scoreAryI[lastRowUL];
+
+      lastTopI = topI;
+      topI += settings->gapExtendC;
+
+      swapPtrI = scoreAryI;
+      scoreAryI = oldScoreAryI;
+      oldScoreAryI = swapPtrI;
+
+      swapPtrI = gapAryI;
+      gapAryI = oldGapAryI;
+      oldGapAryI = swapPtrI;
+   } /*Loop: score each reference base*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-05:
+   ^  - Clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(
+      ulRef = refStartUL;
+      ulRef < refStartUL + refLenUL;
+      ++ulRef
+   ) profIndexAryUL[(uchar) refSeqStr[ulRef]] = 0;
+
+   /*The gap column for the last query row*/
+   return
+        settings->gapOpenC
+      + (long) (qryLenUL - 1) * settings->gapExtendC;
+} /*hirschVectScoreI16*/
+
+#endif /*DEFNOVECT*/
+#endif
@@ -0,0 +1,608 @@
+/*########################################################
+# Name hirschVectScoreI32
+# Use:
+#  o Holds the 32 bit vector scoring step for a Hirschberg
+#    alignment (see hirschVect.h). This finds the same last
+#    row of scores as scoreHirschFor and scoreHirschRev.
+#  o The query is striped (Farrar) across 32 bit vectors
+#    and each reference base is scored against the full
+#    query in one pass. A lazy-F loop then corrects the
+#    insertions that cross segments. The last query row is
+#    copied out after each reference base.
+# Libraries:
+#   - "genHirsch.h"                    (No .c file)
+#   o "../general/alnSetStruct.h"      (No .c file)
+#   o "../general/alnSeqDefaults.h"    (No .c file)
+#   o "../general/dataTypeShortHand.h" (No .c file)
+#   - "../vectWrap/vectWrap.h"         (No .c file)
+# C Standard libraries:
+#   - <stdint.h>
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+' o macro-01 hirschVectScoreSegI32:
+'   - Scores one segment (vector) of the striped query for
+'     a single reference base
+' o fun-02 hirschVectScoreI32:
+'   - Finds the last row of scores for a Hirschberg with
+'     32 bit vectors (forward or reverse direction)
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#ifndef HIRSCH_VECT_SCORE_I32_H
+#define HIRSCH_VECT_SCORE_I32_H
+
+#include <stdint.h>
+
+#include "genHirsch.h"
+#include "../vectWrap/vectWrap.h"
+
+#ifndef DEFNOVECT
+
+/*Smallest 32 bit score; is never added to*/
+#define defHirschMinI32 (-2147483647 - 1)
+
+/*-------------------------------------------------------\
+| Macro-01: hirschVectScoreSegI32
+|   - Scores one segment (vector) of the striped query for
+|     a single reference base
+|   - This follows hirschScore, so a gap is kept if an
+|     insertion or deletion beats the snp. insTieVI and
+|     delTieVI decide if a gap wins a tie with a snp.
+| Input:
+|   - diagVI:
+|     o Scores for the cells on the diagnol (snp)
+|   - profVI:
+|     o Query profile scores for this reference base
+|   - leftVI:
+|     o Scores for the cells to the left (deletions)
+|   - leftGapVI:
+|     o -1 if the left cell was a gap, else 0
+|   - insVI:
+|     o Insertion score (cell above + gap penalty)
+|   - openVI:
+|     o Gap opening penalty
+|   - gapDiffVI:
+|     o Gap extension penalty - gap opening penalty
+|   - insTieVI:
+|     o -1 if an insertion wins a tie with a snp
+|   - delTieVI:
+|     o -1 if a deletion wins a tie with a snp
+|   - scoreVI:
+|     o Will hold the score for each cell
+|   - gapVI:
+|     o Will hold -1 if a cell was a gap, else 0
+| Output:
+|   - Modifies:
+|     o scoreVI and gapVI
+\-------------------------------------------------------*/
+#define hirschVectScoreSegI32(\
+   diagVI,     /*Diagnol scores*/\
+   profVI,     /*Query profile for the reference base*/\
+   leftVI,     /*Scores to the left*/\
+   leftGapVI,  /*-1 if left cell was a gap*/\
+   insVI,      /*Insertion scores*/\
+   openVI,     /*Gap opening penalty*/\
+   gapDiffVI,  /*gap extension - gap open*/\
+   insTieVI,   /*-1: insertions win ties with snps*/\
+   delTieVI,   /*-1: deletions win ties with snps*/\
+   scoreVI,    /*Gets scores*/\
+   gapVI       /*Gets -1 for gaps, 0 for snps*/\
+){ /*hirschVectScoreSegI32*/\
+   vectI32 macroSnpVI =\
+      add_vectI32_retVectI32((diagVI), (profVI));\
+   \
+   vectI32 macroDelVI =\
+      add_vectI32_retVectI32(\
+         add_vectI32_retVectI32((leftVI), (openVI)),\
+         and_vectI32_retVectI32((leftGapVI), (gapDiffVI))\
+      );\
+   \
+   (gapVI) =\
+      or_vectI32_retVectI32(\
+         mask32_retVectI32(\
+            cmpgt_vectI32_retMask32(macroDelVI, macroSnpVI)\
+         ),\
+         and_vectI32_retVectI32(\
+            (delTieVI),\
+            mask32_retVectI32(\
+               cmpeq_vectI32_retMask32(\
+                  macroDelVI,\
+                  macroSnpVI\
+               )\
+            )\
+         )\
+      );\
+   \
+   (gapVI) =\
+      or_vectI32_retVectI32(\
+         (gapVI),\
+         mask32_retVectI32(\
+            cmpgt_vectI32_retMask32((insVI), macroSnpVI)\
+         )\
+      );\
+   \
+   (gapVI) =\
+      or_vectI32_retVectI32(\
+         (gapVI),\
+         and_vectI32_retVectI32(\
+            (insTieVI),\
+            mask32_retVectI32(\
+               cmpeq_vectI32_retMask32((insVI), macroSnpVI)\
+            )\
+         )\
+      );\
+   \
+   (scoreVI) = max_vectI32_retVectI32(macroDelVI, (insVI));\
+   (scoreVI) = max_vectI32_retVectI32((scoreVI), macroSnpVI);\
+} /*hirschVectScoreSegI32*/
+
+/*-------------------------------------------------------\
+| Fun-02: hirschVectScoreI32
+|   - Finds the last row of scores for a Hirschberg with
+|     a striped query and 32 bit vectors
+| Input:
+|   - refSeqStr:
+|     o C-string with the reference sequence to align
+|   - refStartUL:
+|     o First base to align in the reference (index 0)
+|   - refLenUL:
+|     o Number of bases to align in the reference
+|       (index 1)
+|   - qrySeqStr:
+|     o C-string with the query sequence to align
+|   - qryStartUL:
+|     o First base to align in the query (index 0)
+|   - qryLenUL:
+|     o Number of bases to align in the query (index 1)
+|   - revBl:
+|     o 0: Score forwards (same as scoreHirschFor)
+|     o 1: Score backwards (same as scoreHirschRev)
+|   - scoreRowL:
+|     o Array to fill with the last row of scores
+|   - buffAryI:
+|     o Vector aligned buffer to hold the query profile
+|       and the striped columns. It must hold
+|       (number profiles + 4) * (qryLenUL + vector length)
+|       int32_t's
+|   - profIndexAryUL:
+|     o Array of 256 ulongs set to 0. This is used to map
+|       reference bases to their profile and is set back
+|       to 0 before returning
+|   - insTieBl:
+|     o 1: an insertion wins a tie with a snp; 0 does not
+|   - delTieBl:
+|     o 1: a deletion wins a tie with a snp; 0 does not
+|   - settings:
+|     o alnSet structure with the gap penalties and the
+|       scoring matrix
+| Output:
+|   - Modifies:
+|     o scoreRowL to hold the last row of scores
+|   - Returns:
+|     o The gap column score
+\-------------------------------------------------------*/
+static long hirschVectScoreI32(
+   char *refSeqStr,  /*Reference sequence*/
+   ulong refStartUL, /*1st reference base to score*/
+   ulong refLenUL,   /*Number of reference bases*/
+   char *qrySeqStr,  /*Query sequence*/
+   ulong qryStartUL, /*1st query base to score*/
+   ulong qryLenUL,   /*Number of query bases*/
+   char revBl,       /*1: score backwards*/
+   long *scoreRowL,  /*Gets the last row of scores*/
+   int32_t *buffAryI,       /*Vector aligned buffer*/
+   ulong *profIndexAryUL,   /*Maps bases to profiles*/
+   char insTieBl,    /*1: insertions win snp ties*/
+   char delTieBl,    /*1: deletions win snp ties*/
+   struct alnSet *settings  /*Settings for alignment*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-02 TOC: hirschVectScoreI32
+   '  - Finds the last row of scores for a Hirschberg
+   '  o fun-02 sec-01:
+   '    - Variable declerations
+   '  o fun-02 sec-02:
+   '    - Build the query profile
+   '  o fun-02 sec-03:
+   '    - Set up the gap column and constant vectors
+   '  o fun-02 sec-04:
+   '    - Score each reference base
+   '  o fun-02 sec-05:
+   '    - Clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*Number of vectors in one striped column*/
+   ulong lenSegUL =
+      (qryLenUL + defNum32BitElms - 1) / defNum32BitElms;
+
+   /*Number of elements in one striped column*/
+   ulong lenColUL = lenSegUL * defNum32BitElms;
+
+   /*Index of the last query row in a striped column*/
+   ulong lastRowUL =
+        ((qryLenUL - 1) % lenSegUL) * defNum32BitElms
+      + (qryLenUL - 1) / lenSegUL;
+
+   ulong ulRef = 0;
+   ulong ulSeg = 0;
+   ulong ulElm = 0;
+   ulong ulBase = 0;
+   ulong rowUL = 0;
+   ulong offsetUL = 0;
+   ulong maskUL = 0;
+   ulong numProfUL = 0;
+
+   int32_t topI = 0;     /*Score of the indel row*/
+   int32_t lastTopI = 0; /*Last score in the indel row*/
+
+   int32_t *profAryI = 0;  /*Query profile*/
+   int32_t *profOnI = 0;   /*Profile for reference base*/
+   int32_t *lane0AryI = 0; /*-1 for lane 0, else 0*/
+
+   int32_t *scoreAryI = 0;    /*Current column*/
+   int32_t *gapAryI = 0;
+   int32_t *oldScoreAryI = 0; /*Last column*/
+   int32_t *oldGapAryI = 0;
+   int32_t *swapPtrI = 0;
+
+   vectI32 zeroVI = zero_retVectI32();
+   vectI32 minVI = set1_I32_retVectI32(defHirschMinI32);
+
+   vectI32 openVI;
+   vectI32 gapDiffVI;
+   vectI32 insTieVI;
+   vectI32 delTieVI;
+   vectI32 lane0VI;
+
+   vectI32 topInsVI;   /*Insertion from the indel row*/
+   vectI32 firstDiagVI;
+   vectI32 diagVI;
+   vectI32 leftVI;
+   vectI32 leftGapVI;
+   vectI32 insVI;
+   vectI32 scoreVI;
+   vectI32 gapVI;
+   vectI32 sameVI;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-02:
+   ^  - Build the query profile
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(
+      ulRef = refStartUL;
+      ulRef < refStartUL + refLenUL;
+      ++ulRef
+   ){ /*Loop: find the bases in the reference*/
+      if(profIndexAryUL[(uchar) refSeqStr[ulRef]] == 0)
+      { /*If: this is a new base*/
+         ++numProfUL;
+         profIndexAryUL[(uchar) refSeqStr[ulRef]] =
+            numProfUL;
+      } /*If: this is a new base*/
+   } /*Loop: find the bases in the reference*/
+
+   profAryI = buffAryI;
+   scoreAryI = profAryI + numProfUL * lenColUL;
+   gapAryI = scoreAryI + lenColUL;
+   oldScoreAryI = gapAryI + lenColUL;
+   oldGapAryI = oldScoreAryI + lenColUL;
+   lane0AryI = oldGapAryI + lenColUL;
+
+   /* Element ulElm in segment ulSeg is query row
+   `  ulElm * lenSegUL + ulSeg (striped). Rows are read
+   `  from the end of the query for the reverse direction.
+   */
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+   { /*Loop: build the profile for each reference base*/
+      if(profIndexAryUL[ulBase] == 0) continue;
+
+      profOnI =
+         profAryI + (profIndexAryUL[ulBase] - 1) * lenColUL;
+
+      for(ulSeg = 0; ulSeg < lenSegUL; ++ulSeg)
+      { /*Loop: Fill in each segment*/
+         for(ulElm = 0; ulElm < defNum32BitElms; ++ulElm)
+         { /*Loop: Fill in each element*/
+            rowUL = ulElm * lenSegUL + ulSeg;
+
+            if(rowUL >= qryLenUL) *profOnI = 0;
+
+            else if(revBl)
+               *profOnI =
+                  getBaseScore(
+                     qrySeqStr[qryStartUL+qryLenUL-1-rowUL],
+                     (char) ulBase,
+                     settings
+                  );
+
+            else
+               *profOnI =
+                  getBaseScore(
+                     qrySeqStr[qryStartUL + rowUL],
+                     (char) ulBase,
+                     settings
+                  );
+
+            ++profOnI;
+         } /*Loop: Fill in each element*/
+      } /*Loop: Fill in each segment*/
+   } /*Loop: build the profile for each reference base*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-03:
+   ^  - Set up the gap column and constant vectors
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(ulSeg = 0; ulSeg < lenSegUL; ++ulSeg)
+   { /*Loop: set up each segment*/
+      for(ulElm = 0; ulElm < defNum32BitElms; ++ulElm)
+      { /*Loop: set up each element*/
+         rowUL = ulElm * lenSegUL + ulSeg;
+         offsetUL = ulSeg * defNum32BitElms + ulElm;
+
+         /*The gap column is gapOpen + row * gapExtend and
+         ` is always extended (see scoreHirschFor)
+         */
+         oldScoreAryI[offsetUL] =
+              settings->gapOpenC
+            + (int32_t) rowUL * settings->gapExtendC;
+
+         oldGapAryI[offsetUL] = -1;
+      } /*Loop: set up each element*/
+   } /*Loop: set up each segment*/
+
+   for(ulElm = 0; ulElm < defNum32BitElms; ++ulElm)
+      lane0AryI[ulElm] = -(ulElm == 0);
+
+   lane0VI = load_I32Ary_retVectI32(lane0AryI);
+   openVI = set1_I32_retVectI32(settings->gapOpenC);
+
+   gapDiffVI =
+      set1_I32_retVectI32(
+         settings->gapExtendC - settings->gapOpenC
+      );
+
+   insTieVI = set1_I32_retVectI32(-((int32_t) insTieBl));
+   delTieVI = set1_I32_retVectI32(-((int32_t) delTieBl));
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-04:
+   ^  - Score each reference base
+   ^  o fun-02 sec-04 sub-01:
+   ^    - Set up for the next reference base
+   ^  o fun-02 sec-04 sub-02:
+   ^    - Score each segment (insertions stay in lane)
+   ^  o fun-02 sec-04 sub-03:
+   ^    - Lazy-F loop; move insertions across lanes
+   ^  o fun-02 sec-04 sub-04:
+   ^    - Copy out the last row and swap columns
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   lastTopI = 0;            /*Corner of the matrix*/
+   topI = settings->gapOpenC;
+
+   for(ulRef = 0; ulRef < refLenUL; ++ulRef)
+   { /*Loop: score each reference base*/
+
+      /**************************************************\
+      * Fun-02 Sec-04 Sub-01:
+      *  - Set up for the next reference base
+      \**************************************************/
+
+      if(revBl) ulBase = refStartUL + refLenUL - 1 - ulRef;
+      else ulBase = refStartUL + ulRef;
+
+      profOnI =
+           profAryI
+         +   (profIndexAryUL[(uchar) refSeqStr[ulBase]] - 1)
+           * lenColUL;
+
+      /*The indel row is always a gap, so the first query
+      ` row gets an extended insertion
+      */
+      topInsVI =
+         and_vectI32_retVectI32(
+            lane0VI,
+            set1_I32_retVectI32(topI + settings->gapExtendC)
+         );
+
+      /*Segment 0 is the row below the last segment, but
+      ` shifted one element. Lane 0 is under the indel row
+      */
+      offsetUL = (lenSegUL - 1) * defNum32BitElms;
+
+      firstDiagVI =
+         or_vectI32_retVectI32(
+            slvect_vectI32_retVectI32(
+               load_I32Ary_retVectI32(oldScoreAryI + offsetUL),
+               1
+            ),
+            and_vectI32_retVectI32(
+               lane0VI,
+               set1_I32_retVectI32(lastTopI)
+            )
+         );
+
+      diagVI = firstDiagVI;
+
+      /*The first pass does not carry insertions between
+      ` lanes. The lazy-F loop fixes this.
+      */
+      insVI =
+         or_vectI32_retVectI32(
+            topInsVI,
+            andNot_vectI32_retVectI32(lane0VI, minVI)
+         );
+
+      /**************************************************\
+      * Fun-02 Sec-04 Sub-02:
+      *  - Score each segment (insertions stay in lane)
+      \**************************************************/
+
+      for(ulSeg = 0; ulSeg < lenSegUL; ++ulSeg)
+      { /*Loop: score each segment*/
+         offsetUL = ulSeg * defNum32BitElms;
+
+         leftVI = load_I32Ary_retVectI32(oldScoreAryI+offsetUL);
+         leftGapVI = load_I32Ary_retVectI32(oldGapAryI+offsetUL);
+
+         hirschVectScoreSegI32(
+            diagVI,
+            load_I32Ary_retVectI32(profOnI + offsetUL),
+            leftVI,
+            leftGapVI,
+            insVI,
+            openVI,
+            gapDiffVI,
+            insTieVI,
+            delTieVI,
+            scoreVI,
+            gapVI
+         );
+
+         store_vectI32_retAryI32(scoreAryI+offsetUL,scoreVI);
+         store_vectI32_retAryI32(gapAryI + offsetUL, gapVI);
+
+         /*Insertion score for the next segment*/
+         insVI =
+            add_vectI32_retVectI32(
+               add_vectI32_retVectI32(scoreVI, openVI),
+               and_vectI32_retVectI32(gapVI, gapDiffVI)
+            );
+
+         diagVI = leftVI;
+      } /*Loop: score each segment*/
+
+      /**************************************************\
+      * Fun-02 Sec-04 Sub-03:
+      *  - Lazy-F loop; move insertions across lanes
+      \**************************************************/
+
+      /* Each segment is rescored with the insertion from
+      `  the lane below until no cell in a segment changes.
+      `  A segment with no changes means every later
+      `  segment was scored with the right insertions.
+      */
+      insVI =
+         or_vectI32_retVectI32(
+            slvect_vectI32_retVectI32(insVI, 1),
+            topInsVI
+         );
+
+      diagVI = firstDiagVI;
+      ulSeg = 0;
+
+      while(1)
+      { /*Loop: Lazy-F loop*/
+         offsetUL = ulSeg * defNum32BitElms;
+
+         leftVI = load_I32Ary_retVectI32(oldScoreAryI+offsetUL);
+         leftGapVI = load_I32Ary_retVectI32(oldGapAryI+offsetUL);
+
+         hirschVectScoreSegI32(
+            diagVI,
+            load_I32Ary_retVectI32(profOnI + offsetUL),
+            leftVI,
+            leftGapVI,
+            insVI,
+            openVI,
+            gapDiffVI,
+            insTieVI,
+            delTieVI,
+            scoreVI,
+            gapVI
+         );
+
+         /*Check if any cell in this segment changed*/
+         sameVI =
+            and_vectI32_retVectI32(
+               mask32_retVectI32(
+                  cmpeq_vectI32_retMask32(
+                     scoreVI,
+                     load_I32Ary_retVectI32(scoreAryI+offsetUL)
+                  )
+               ),
+               mask32_retVectI32(
+                  cmpeq_vectI32_retMask32(
+                     gapVI,
+                     load_I32Ary_retVectI32(gapAryI+offsetUL)
+                  )
+               )
+            );
+
+         store_mask32_retUL(
+            maskUL,
+            cmpgt_vectI32_retMask32(zeroVI, sameVI)
+         ); /*sameVI is -1 (< 0) for unchanged cells*/
+
+         if(maskUL == defMvMask32) break;
+
+         store_vectI32_retAryI32(scoreAryI+offsetUL,scoreVI);
+         store_vectI32_retAryI32(gapAryI + offsetUL, gapVI);
+
+         insVI =
+            add_vectI32_retVectI32(
+               add_vectI32_retVectI32(scoreVI, openVI),
+               and_vectI32_retVectI32(gapVI, gapDiffVI)
+            );
+
+         diagVI = leftVI;
+         ++ulSeg;
+
+         if(ulSeg == lenSegUL)
+         { /*If: I need to move to the next lane*/
+            insVI =
+               or_vectI32_retVectI32(
+                  slvect_vectI32_retVectI32(insVI, 1),
+                  topInsVI
+               );
+
+            diagVI = firstDiagVI;
+            ulSeg = 0;
+         } /*If: I need to move to the next lane*/
+      } /*Loop: Lazy-F loop*/
+
+      /**************************************************\
+      * Fun-02 Sec-04 Sub-04:
+      *  - Copy out the last row and swap columns
+      \**************************************************/
+
+      scoreRowL[ulBase] = scoreAryI[lastRowUL];
+
+      lastTopI = topI;
+      topI += settings->gapExtendC;
+
+      swapPtrI = scoreAryI;
+      scoreAryI = oldScoreAryI;
+      oldScoreAryI = swapPtrI;
+
+      swapPtrI = gapAryI;
+      gapAryI = oldGapAryI;
+      oldGapAryI = swapPtrI;
+   } /*Loop: score each reference base*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-05:
+   ^  - Clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(
+      ulRef = refStartUL;
+      ulRef < refStartUL + refLenUL;
+      ++ulRef
+   ) profIndexAryUL[(uchar) refSeqStr[ulRef]] = 0;
+
+   /*The gap column for the last query row*/
+   return
+        settings->gapOpenC
+      + (long) (qryLenUL - 1) * settings->gapExtendC;
+} /*hirschVectScoreI32*/
+
+#endif /*DEFNOVECT*/
+#endif
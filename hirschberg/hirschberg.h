@@ -15,6 +15,7 @@
 #  o "../general/dataTypeShortHand.h" (No .c File)
 #  o "../general/alnMatrixStruct.h"   (No .c File)
 #  o "../general/genMath.h"           (No .c File)
+#  - "../general/alnScratch.h"        (No .c File)
 # C Standard Libraries:
 #  o <time.h>
 #  o <stdlib.h>
@@ -28,7 +29,10 @@
 '    - Includes and definitions
 '  o fun-01 HirschbergFun:
 '    - Does the recursive part of a Hirschberg alignment
-'  o fun-02 Hirschberg:
+'  o fun-02 HirschbergScratch:
+'    - Sets up for and calls the recursvie function to
+'      run a Hirschberg alignment (rows from an arena)
+'  o fun-03 Hirschberg:
 '    - Sets up for and calls the recursvie function to
 '      run a Hirschberg alignment
 \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
@@ -42,6 +46,7 @@
 #define HIRSCHBERG_H
 
 #include "genScoreHirsch.h"
+#include "../general/alnScratch.h"
 
 /*-------------------------------------------------------\
 | Fun-01: HirschbergFun
@@ -348,9 +353,11 @@ static void HirschbergFun(
 } /*HirschbergFun*/
 
 /*-------------------------------------------------------\
-| Fun-02: Hirschberg
+| Fun-02: HirschbergScratch
 |  - Sets up for and calls the recursvie function to
-|    run a Hirschberg alignment
+|    run a Hirschberg alignment. The score rows,
+|    direction row, and alignment rows are taken from an
+|    arena.
 | Input:
 |  - refST:
 |    o Pointer to seqStruct structure with the reference
@@ -363,17 +370,25 @@ static void HirschbergFun(
 |  - settings:
 |    o Pointer to alnSet structure with the settings for
 |      the alignment
+|  - scratchST:
+|    o alnScratch structure (arena) to get the rows from.
+|      This is reset first, so memory from earlier calls
+|      is no longer valid.
 | Output:
+|  - Modifies:
+|    o scratchST to hold the rows
 |  - Returns:
-|    o A alignment structure with the alignment
+|    o A alignment structure with the alignment (not in
+|      scratchST)
 |    o 0 For memory errors
 \-------------------------------------------------------*/
-static struct alnStruct * Hirschberg(
+static struct alnStruct * HirschbergScratch(
   struct seqStruct *refST, /*Reference sequence to align*/
   struct seqStruct *qryST, /*Qeury sequence to align*/
-  struct alnSet *settings  /*Settings for alignment*/
+  struct alnSet *settings, /*Settings for alignment*/
+  struct alnScratch *scratchST /*Arena for rows*/
 ){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
-   ' Fun-02 TOC: Hirschberg
+   ' Fun-02 TOC: HirschbergScratch
    '  - Sets up for and calls the recursvie function to
    '    run a Hirschberg alignment
    '  o fun-02 sec-01:
@@ -420,69 +435,47 @@ static struct alnStruct * Hirschberg(
    *  - Initalize the ouput alignment structure 
    \*****************************************************/
 
-   refAln = calloc(lenRefUL + 1, sizeof(char));
-   if(refAln == 0) return 0;
-   *(refAln + lenRefUL) = defEndAlnFlag;
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         lenQryUL,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
 
-   dirRow = calloc(lenRefUL + 1, sizeof(char));
+   /*Rows from the last alignment are no longer needed*/
+   resetAlnScratch(scratchST);
 
-   if(dirRow == 0)
-   { /*If I could not make another direction row*/
-      free(refAln);
-      refAln = 0;
-      return 0;
-   } /*If I could not make another direction row*/
+   refAln =
+      callocAlnScratch(scratchST,lenRefUL+1,sizeof(char));
 
-   qryAln = calloc(lenQryUL + 1, sizeof(char));
+   qryAln =
+      callocAlnScratch(scratchST,lenQryUL+1,sizeof(char));
 
-   if(qryAln == 0)
-   { /*If I could not make another direction row*/
-      free(refAln);
-      refAln = 0;
+   dirRow =
+      callocAlnScratch(scratchST,lenRefUL+1,sizeof(char));
 
-      free(dirRow);
-      dirRow = 0;
+   if(refAln == 0 || qryAln == 0 || dirRow == 0)
+      return 0; /*Memory error*/
 
-      return 0;
-   } /*If I could not make another direction row*/
+   *(refAln + lenRefUL) = defEndAlnFlag;
 
    /*****************************************************\
    * Fun-02 Sec-02 Sub-02:
    *  - Initalize the scoring rows
    \*****************************************************/
 
-   forwardScoreRowL = malloc(sizeof(long) * lenRefUL);
-
-   if(forwardScoreRowL == 0)
-   { /*If had a memory allocatoin error*/
-     free(refAln);
-     refAln = 0;
-
-     free(qryAln);
-     qryAln = 0;
-
-     free(dirRow);
-     dirRow = 0;
-
-     return 0;
-   } /*If had a memory allocatoin error*/
-
-   reverseScoreRowL = malloc(sizeof(long) * lenRefUL);
+   forwardScoreRowL =
+      getAlnScratch(scratchST, sizeof(long) * lenRefUL);
 
-   if(reverseScoreRowL == 0)
-   { /*If had a memory allocatoin error*/
-     free(refAln);
-     refAln = 0;
+   reverseScoreRowL =
+      getAlnScratch(scratchST, sizeof(long) * lenRefUL);
 
-     free(qryAln);
-     qryAln = 0;
-
-     free(dirRow);
-     dirRow = 0;
-
-     free(forwardScoreRowL);
-     return 0;
-   } /*If had a memory allocatoin error*/
+   if(forwardScoreRowL == 0 || reverseScoreRowL == 0)
+      return 0; /*Memory error*/
 
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
    ^  Fun-02 Sec-03:
@@ -513,23 +506,53 @@ static struct alnStruct * Hirschberg(
    ^    - Clean up
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
-   free(forwardScoreRowL);
-   free(reverseScoreRowL);
- 
-   free(dirRow);
-   dirRow = 0;
-
-
    alnST =
      hirschToAlnST(refST,qryST,settings,refAln,qryAln);
 
-   free(refAln);
+   /*The rows are kept in scratchST for the next call*/
    refAln = 0;
-
-   free(qryAln);
    qryAln = 0;
+   dirRow = 0;
 
    return alnST; /*Is 0 if twoBitAlnToAlnSt failed*/
+} /*HirschbergScratch*/
+
+/*-------------------------------------------------------\
+| Fun-03: Hirschberg
+|  - Sets up for and calls the recursvie function to
+|    run a Hirschberg alignment (uses a temporary arena)
+| Input:
+|  - refST:
+|    o Pointer to seqStruct structure with the reference
+|      sequence and the first base (offsetUL) and last
+|      base (endAlnUL) to align (both are index 0)
+|  - qryST:
+|    o Pointer to seqStruct structure with the query
+|      sequence and the first base (offsetUL) and last
+|      base (endAlnUL) to align (both are index 0)
+|  - settings:
+|    o Pointer to alnSet structure with the settings for
+|      the alignment
+| Output:
+|  - Returns:
+|    o A alignment structure with the alignment
+|    o 0 For memory errors
+\-------------------------------------------------------*/
+static struct alnStruct * Hirschberg(
+  struct seqStruct *refST, /*Reference sequence to align*/
+  struct seqStruct *qryST, /*Qeury sequence to align*/
+  struct alnSet *settings  /*Settings for alignment*/
+){
+   struct alnScratch scratchST;
+   struct alnStruct *alnST = 0;
+
+   initAlnScratch(&scratchST);
+
+   alnST =
+      HirschbergScratch(refST,qryST,settings,&scratchST);
+
+   freeAlnScratchStack(&scratchST);
+   return alnST;
 } /*Hirschberg*/
 
 #endif
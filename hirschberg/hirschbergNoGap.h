@@ -410,6 +410,17 @@ static struct alnStruct * HirschbergNoGap(
    *  - Initalize the ouput alignment structure 
    \*****************************************************/
 
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         lenQryUL,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
    refAln = calloc(lenRefUL + 1, sizeof(char));
    if(refAln == 0) return 0;
    *(refAln + lenRefUL) = defEndAlnFlag;
@@ -0,0 +1,389 @@
+/*########################################################
+# Name memNeedle
+# Use:
+#  o Holds functions doing a memory efficent Needleman
+#    Wunsch pairwise alignment. This only keeps two rows
+#    (a score row and a direction row), so it only finds
+#    the score. The returned indexes are for the first and
+#    last cells of the global alignment.
+#  o The reference is scored one tile of defMemNeedleTile
+#    bases at a time (every query base, then the next
+#    tile). The rows are only a tile long and a column
+#    of scores carries the last tile to the next tile.
+#    Packed references (seqPack.h) are unpacked one tile
+#    at a time.
+#  o Coversion macros are in alnMatrixsStruct.h:
+#    indexToQry (fun-07), indexToRef (fun-08), and
+#    indexToCoord (fun-09)
+# Libraries:
+#   - "../needleman/genNeedle.h"       (No .c file)
+#   - "../needleman/genNeedleNoGap.h"  (No .c file)
+#   o "../general/genAln.h"            (No .c file)
+#   o "../general/genMath.h"           (No .c file)
+#   - "../general/alnMatrixStruct.h"   (No .c file)
+#   o "../general/twoBitArrays.h"      (No .c file)
+#   o "../general/dataTypeShortHand.h" (No .c file)
+#   - "../general/alnSetStruct.h"      (No .c file)
+#   o "../general/alnSeqDefaults.h"    (No .c file)
+#   - "../general/seqStruct.h"         (No .c file)
+#   - "../general/seqPack.h"           (No .c file)
+# C Standard libraries:
+#   o <stdlib.h>
+#   o <stdio.h>
+########################################################*/
+
+#ifndef MEM_NEEDLE_H
+#define MEM_NEEDLE_H
+
+#include "../needleman/genNeedle.h"
+#include "../needleman/genNeedleNoGap.h"
+#include "../general/alnMatrixStruct.h"
+#include "../general/alnSetStruct.h"
+#include "../general/seqStruct.h"
+#include "../general/seqPack.h"
+
+#define defMemNeedleTile 4096
+   /*Reference bases scored (and unpacked) at a time*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' memNeedle SOF: Start Of Functions
+' o fun-01 memNeedle:
+'   - Find the score of a Needleman Wunsch alignment
+'     with only two rows of memory
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Fun-01: memNeedle
+|   - Finds the score of a Needleman Wunsch alignment
+|     using one score row and one direction row per tile
+|     of the reference
+|   - This uses the same scoring as NeedlemanAln and
+|     NeedleAlnNoGap (settings->noGapBl picks the one)
+| Input;
+|   - qryST:
+|     o SeqStruct with the query sequence and index 0
+|       coordinates to start (offsetUL)/end (endAlnUL) the
+|       alignment.
+|   - refST:
+|     o SeqStruct with the reference sequence and index 0
+|       coordinates to start (offsetUL)/end (endAlnUL) the
+|       alignment. This can be packed (refST->packST).
+|   - settings:
+|     o alnSet structure with the setttings, such as
+|       gap open, gap extend, scoring matrix, and
+|       preffered direction.
+| Output:
+|  - Modifies:
+|    o settings->profST is blanked (the profile is only
+|      made for one tile at a time)
+|  - Returns:
+|    o alnMatrix struct with the score and the start
+|      (bestStartIndexUL) and end (bestEndIndexUL) indexes
+|      of the alignment. There is no direction matrix.
+|    o 0 for memory allocation errors
+\-------------------------------------------------------*/
+static struct alnMatrix * memNeedle(
+    struct seqStruct *qryST, /*query sequence*/
+    struct seqStruct *refST, /*ref sequence*/
+    struct alnSet *settings  /*Settings for alignment*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-01 TOC: memNeedle
+   '  - Finds the score of a Needleman Wunsch alignment
+   '    with only two rows of memory
+   '  o fun-01 sec-01:
+   '    - Variable declerations
+   '  o fun-01 sec-02:
+   '    - Allocate memory for alignment
+   '  o fun-01 sec-03:
+   '    - Fill in the initial negatives for the query
+   '  o fun-01 sec-04:
+   '    - Find the scores for each tile of the reference
+   '  o fun-01 sec-05:
+   '    - Set up for returing matrix (clean up/wrap up)
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-01 Sec-01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*Get start & end of query & reference sequences*/
+   char *refSeqStr = 0;
+   char *qrySeqStr = 0;
+   char *profRowC = 0; /*Scores for a query base*/
+   char *tileBuffStr = 0; /*Unpacked tile (packed refs)*/
+
+   ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
+   ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
+
+   /*Variables for loops*/
+   ulong ulRef = 0;
+   ulong ulQry = 0;
+   ulong tileStartUL = 0; /*First ref base in the tile*/
+   ulong lenTileUL = 0;   /*Ref bases in the tile*/
+
+   /*Scoring variables*/
+   long nextSnpScoreL = 0;/*Score for the next match/snp*/
+   long delScoreL = 0;    /*Score for doing an deletion*/
+   long *scoreAryL = 0;   /*Row of scores (one tile)*/
+   long *colScoreL = 0;   /*Last column of the last tile*/
+   long cornerL = 0;      /*colScoreL of the last row*/
+
+   /*Gap penalities*/
+   short gapDiffS =
+      settings->gapExtendC - settings->gapOpenC;
+
+   /*Used to fill in the gap row and gap column*/
+   short gapExtendS = settings->gapExtendC;
+
+   /*The directions are only used to find gap extensions*/
+   struct alnMatrix *retMatrixST = 0;
+   char *dirRow = 0;  /*Holds directions for one row*/
+   char *colDirC = 0; /*Directions for colScoreL*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-01 Sec-02:
+   ^  - Allocate memory for alignment
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(settings->noGapBl) gapExtendS = settings->gapOpenC;
+
+   retMatrixST = malloc(sizeof(struct alnMatrix));
+   if(retMatrixST == 0) return 0;
+   initAlnMatrix(retMatrixST);
+
+   dirRow = malloc((defMemNeedleTile + 1) * sizeof(char));
+   scoreAryL =
+      malloc((defMemNeedleTile + 1) * sizeof(long));
+   colDirC = malloc((lenQryUL + 1) * sizeof(char));
+   colScoreL = malloc((lenQryUL + 1) * sizeof(long));
+
+   if(refST->packST != 0)
+      tileBuffStr = malloc(defMemNeedleTile + 1);
+
+   if(
+         dirRow == 0
+      || scoreAryL == 0
+      || colDirC == 0
+      || colScoreL == 0
+      || (refST->packST != 0 && tileBuffStr == 0)
+   ){ /*If: Memory error*/
+      freeAlnMatrix(retMatrixST);
+      retMatrixST = 0;
+      goto cleanUp;
+   } /*If: Memory error*/
+
+   retMatrixST->lenRefUL = lenRefUL;
+   retMatrixST->refOffsetUL = refST->offsetUL;
+
+   retMatrixST->lenQryUL = lenQryUL;
+   retMatrixST->qryOffsetUL = qryST->offsetUL;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-01 Sec-03:
+   ^  - Fill in the initial negatives for the query
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*The gap column is the last column before the first
+   ` tile. Its deletions are always gap extensions.
+   */
+   colDirC[0] = defMvStop;
+   colScoreL[0] = 0;
+   colDirC[1] = defMvIns;
+   colScoreL[1] = settings->gapOpenC;
+
+   for(ulQry = 2; ulQry <= lenQryUL; ++ulQry)
+   { /*loop; till have initalized the gap column*/
+     colDirC[ulQry] = defMvIns;
+     colScoreL[ulQry] = colScoreL[ulQry - 1] + gapExtendS;
+   } /*loop; till have initalized the gap column*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-01 Sec-04:
+   ^  - Find the scores for each tile of the reference
+   ^  o fun-01 sec-04 sub-01:
+   ^    - Get the tile and fill in its gap row
+   ^  o fun-01 sec-04 sub-02:
+   ^    - Set up the deletion and snp scores for a row
+   ^  o fun-01 sec-04 sub-03:
+   ^    - Get scores for each row (gap extension)
+   ^  o fun-01 sec-04 sub-04:
+   ^    - Get scores for each row (no gap extension)
+   ^  o fun-01 sec-04 sub-05:
+   ^    - Keep the last column for the next tile
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   qrySeqStr = qryST->seqCStr + qryST->offsetUL;
+
+   for(
+      tileStartUL = 0;
+      tileStartUL < lenRefUL;
+      tileStartUL += lenTileUL
+   ){ /*Loop: score each tile of the reference*/
+
+      /**************************************************\
+      * Fun-01 Sec-04 Sub-01:
+      *  - Get the tile and fill in its gap row
+      \**************************************************/
+
+      lenTileUL = lenRefUL - tileStartUL;
+
+      if(lenTileUL > defMemNeedleTile)
+         lenTileUL = defMemNeedleTile;
+
+      refSeqStr =
+         seqPackTile(
+            refST,
+            refST->offsetUL + tileStartUL,
+            lenTileUL,
+            tileBuffStr
+         );
+
+      /*The buffer is reused, so old rows can not be
+      ` found by the reference pointer
+      */
+      freeScoreProfStack(&settings->profST);
+
+      if(
+         setScoreProf(
+            qrySeqStr,
+            lenQryUL,
+            refSeqStr,
+            lenTileUL,
+            settings
+         )
+      ){ /*If: Memory error*/
+         freeAlnMatrix(retMatrixST);
+         retMatrixST = 0;
+         goto cleanUp;
+      } /*If: Memory error*/
+
+      refSeqStr -= 1; /*Index 1 is the first base*/
+
+      /*Gap row (first row) for the tile*/
+      for(ulRef = 1; ulRef <= lenTileUL; ++ulRef)
+      { /*Loop: initalize the first row*/
+         dirRow[ulRef] = defMvDel;
+
+         scoreAryL[ulRef] =
+              settings->gapOpenC
+            + (long) (tileStartUL + ulRef - 1) * gapExtendS;
+      } /*Loop: initalize the first row*/
+
+      cornerL = colScoreL[0];
+      colScoreL[0] = scoreAryL[lenTileUL];
+
+      for(ulQry = 0; ulQry < lenQryUL; ++ulQry)
+      { /*loop; find the scores for each query base*/
+
+         /***********************************************\
+         * Fun-01 Sec-04 Sub-02:
+         *  - Set up the deletion and snp scores for a row
+         \***********************************************/
+
+         profRowC =
+            getScoreProfRow(
+               qrySeqStr[ulQry],
+               refSeqStr,
+               settings
+            ); /*Scores for this query base*/
+
+         /*The snp score is the last column of the row
+         ` above (before it was updated for this tile)
+         */
+         nextSnpScoreL = cornerL;
+         cornerL = colScoreL[ulQry + 1];
+
+         delScoreL = cornerL + settings->gapOpenC;
+
+         if(
+               ! settings->noGapBl
+            && colDirC[ulQry + 1] != defMvSnp
+         ) delScoreL += gapDiffS;
+
+         /***********************************************\
+         * Fun-01 Sec-04 Sub-03:
+         *  - Get scores for each row (gap extension)
+         \***********************************************/
+
+         /*The direction row holds the directions of the
+         ` last row until a cell is updated, so it is both
+         ` the insertion direction and the new direction.
+         */
+         if(! settings->noGapBl)
+         { /*If: using gap extension penalties*/
+            for(ulRef = 1; ulRef <= lenTileUL; ++ulRef)
+            { /*Loop: compare 1 query to the tile*/
+               needleMaxScore(
+                  profRowC[ulRef],
+                  gapDiffS,
+                  scoreAryL[ulRef],
+                  dirRow[ulRef],
+                  dirRow[ulRef],
+                  nextSnpScoreL,
+                  delScoreL,
+                  settings
+               );
+            } /*Loop: compare 1 query to the tile*/
+         } /*If: using gap extension penalties*/
+
+         /***********************************************\
+         * Fun-01 Sec-04 Sub-04:
+         *  - Get scores for each row (no gap extension)
+         \***********************************************/
+
+         else
+         { /*Else: every gap uses the gap opening penalty*/
+            for(ulRef = 1; ulRef <= lenTileUL; ++ulRef)
+            { /*Loop: compare 1 query to the tile*/
+               needleMaxScoreNoGap(
+                  profRowC[ulRef],
+                  scoreAryL[ulRef],
+                  dirRow[ulRef],
+                  dirRow[ulRef],
+                  nextSnpScoreL,
+                  delScoreL,
+                  settings
+               );
+            } /*Loop: compare 1 query to the tile*/
+         } /*Else: every gap uses the gap opening penalty*/
+
+         /***********************************************\
+         * Fun-01 Sec-04 Sub-05:
+         *  - Keep the last column for the next tile
+         \***********************************************/
+
+         colScoreL[ulQry + 1] = scoreAryL[lenTileUL];
+         colDirC[ulQry + 1] = dirRow[lenTileUL];
+      } /*loop; find the scores for each query base*/
+   } /*Loop: score each tile of the reference*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-01 Sec-05:
+   ^  - Set up for returing the matrix (clean up/wrap up)
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*Set the best score to the cornor right cell*/
+   retMatrixST->bestScoreL = colScoreL[lenQryUL];
+
+   /*First base pair (query 0, ref 0) and the last cell*/
+   retMatrixST->bestStartIndexUL = lenRefUL + 2;
+
+   retMatrixST->bestEndIndexUL =
+      (lenQryUL + 1) * (lenRefUL + 1) - 1;
+
+   cleanUp:
+
+   /*The rows are for a tile that is freed or reused*/
+   freeScoreProfStack(&settings->profST);
+
+   if(dirRow != 0) free(dirRow);
+   if(scoreAryL != 0) free(scoreAryL);
+   if(colDirC != 0) free(colDirC);
+   if(colScoreL != 0) free(colScoreL);
+   if(tileBuffStr != 0) free(tileBuffStr);
+
+   return retMatrixST;
+} /*memNeedle*/
+
+#endif
@@ -17,6 +17,7 @@
 #   - "../general/alnSetStruct.h"      (No .c file)
 #   o "../general/alnSeqDefaults.h"    (No .c file)
 #   - "../general/seqStruct.h"         (No .c file)
+#   - "../general/alnScratch.h"        (No .c file)
 # C Standard libraries:
 #   o <stdlib.h>
 #   o <stdio.h>
@@ -28,18 +29,23 @@
 #include "../general/genScan.h"
 #include "../general/alnSetStruct.h"
 #include "../general/seqStruct.h"
+#include "../general/alnScratch.h"
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
 ' memWater SOF: Start Of Functions
-' o fun-01 memWater:
+' o fun-01 memWaterScratch:
+'   - Run a memory efficent Waterman Smith alignment on
+'     input sequences with rows from an arena
+' o fun-02 memWater:
 '   - Run a memory efficent Waterman Smith alignment on
 '     input sequences
 \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 /*-------------------------------------------------------\
-| Fun-01: memWater
+| Fun-01: memWaterScratch
 |   - Performs a memory efficent Smith Waterman alignment
-|     on a pair of sequences
+|     on a pair of sequences. The score, direction, and
+|     index rows are taken from an arena.
 | Input;
 |   - qryST:
 |     o SeqStruct with the query sequence and index 0
@@ -53,15 +59,22 @@
 |     o alnSet structure with the setttings, such as
 |       gap open, gap extend, scoring matrix, and
 |       preffered direction.
+|   - scratchST:
+|     o alnScratch structure (arena) to get the rows from.
+|       This is reset first, so memory from earlier calls
+|       is no longer valid.
 | Output:
+|  - Modifies:
+|    o scratchST to hold the rows
 |  - Returns:
 |    o alnMatrix struct with the best score
 |    o 0 for memory allocation errors
 \-------------------------------------------------------*/
-static struct alnMatrix * memWater(
+static struct alnMatrix * memWaterScratch(
     struct seqStruct *qryST, /*query sequence*/
     struct seqStruct *refST, /*ref sequence*/
-    struct alnSet *settings  /*Settings for alignment*/
+    struct alnSet *settings, /*Settings for alignment*/
+    struct alnScratch *scratchST /*Arena for rows*/
 ){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
    ' Fun-01 TOC: memWaterAln
    '  - Run a memory efficent Waterman Smith alignment on
@@ -100,6 +113,7 @@ static struct alnMatrix * memWater(
    /*Get start & end of query and reference sequences*/
    char *refSeqStr = 0;
    char *qrySeqStr = 0;
+   char *profRowC = 0; /*Scores for a query base*/
 
    ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
    ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
@@ -150,25 +164,34 @@ static struct alnMatrix * memWater(
    *  - Allocate memory for the alignment
    \****************************************************/
 
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         qryST->endAlnUL - qryST->offsetUL + 1,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
    retMatrixST = malloc(sizeof(struct alnMatrix));
    if(retMatrixST == 0) return 0;
    initAlnMatrix(retMatrixST);
 
-   dirRow = malloc((lenRefUL + 1) * sizeof(char));
+   /*Rows from the last alignment are no longer needed*/
+   resetAlnScratch(scratchST);
 
-   if(dirRow == 0)
-   { /*If: Memory error*/
-      freeAlnMatrix(retMatrixST);
-      return 0;
-   } /*If: Memory error*/
+   dirRow =
+      getAlnScratch(scratchST,(lenRefUL + 1)*sizeof(char));
 
-   scoreAryL = malloc((lenRefUL + 1) * sizeof(long));
+   scoreAryL =
+      getAlnScratch(scratchST,(lenRefUL + 1)*sizeof(long));
    /*+ 1 is for the indel column*/
 
-   if(scoreAryL == 0)
+   if(dirRow == 0 || scoreAryL == 0)
    { /*If I had a memory error*/
      freeAlnMatrix(retMatrixST);
-     free(dirRow);
      return 0;
    } /*If I had a memory error*/
 
@@ -183,30 +206,16 @@ static struct alnMatrix * memWater(
    *  - Get memory for keeping track of starting indexes
    \*****************************************************/
 
-   /*Set up the first row of starting indexes*/
-   indexAryUL = malloc((lenRefUL + 1) * sizeof(ulong));
-
-   if(indexAryUL == 0)
-   { /*If had a memory error*/
-      free(scoreAryL);
-
-      freeAlnMatrix(retMatrixST);
-      free(dirRow);
-
-      return 0;
-   } /*If had a memory error*/
+   /*Two rows of starting indexes*/
+   indexAryUL =
+      getAlnScratch(scratchST,(lenRefUL + 1)*sizeof(ulong));
 
-   /*Set up the second row of indexs (so have two rows)*/
-   oldIndexAryUL = malloc((lenRefUL + 1) * sizeof(ulong));
+   oldIndexAryUL =
+      getAlnScratch(scratchST,(lenRefUL + 1)*sizeof(ulong));
 
-   if(oldIndexAryUL == 0)
+   if(indexAryUL == 0 || oldIndexAryUL == 0)
    { /*If had a memory error*/
-      free(indexAryUL);
-      free(scoreAryL);
-
       freeAlnMatrix(retMatrixST);
-      free(dirRow);
-
       return 0;
    } /*If had a memory error*/
 
@@ -272,6 +281,12 @@ static struct alnMatrix * memWater(
       ulQryBase <= qryST->endAlnUL - qryST->offsetUL;
       ++ulQryBase
    ){ /*loop; compare query base against all ref bases*/
+      profRowC =
+         getScoreProfRow(
+            qrySeqStr[ulQryBase],
+            refSeqStr,
+            settings
+         ); /*Scores for this query base*/
 
       for(
          ulRefBase = 1;
@@ -279,8 +294,7 @@ static struct alnMatrix * memWater(
          ++ulRefBase
       ){ /*loop; compare one query to one reference base*/
          waterScanMaxScore(
-            refSeqStr[ulRefBase],
-            qrySeqStr[ulQryBase],
+            profRowC[ulRefBase],
             gapDiffS,
             scoreAryL[ulRefBase],
             dirRow[ulRefBase],
@@ -318,8 +332,7 @@ static struct alnMatrix * memWater(
       \***************************************************/
 
       waterScanMaxEndRowScore(
-         refSeqStr[ulRefBase],
-         qrySeqStr[ulQryBase],
+         profRowC[ulRefBase],
          gapDiffS,
          scoreAryL[ulRefBase],
          dirRow[ulRefBase],
@@ -374,6 +387,9 @@ static struct alnMatrix * memWater(
       indexAryUL = oldIndexAryUL;
       oldIndexAryUL = swapPtrUL;
 
+      /*The gap column is a stop, so it is its own start*/
+      indexAryUL[0] = indexUL;
+
       ++indexUL; /*Set index for the next base pair*/
    } /*loop; compare query base against all ref bases*/
 
@@ -391,17 +407,52 @@ static struct alnMatrix * memWater(
    *  - clean up
    \*****************************************************/
 
-   free(dirRow);
-   free(scoreAryL);
-   free(indexAryUL);
-   free(oldIndexAryUL);
-
+   /*The rows are kept in scratchST for the next call*/
    dirRow = 0;
    scoreAryL = 0;
    indexAryUL = 0;
    oldIndexAryUL = 0;
 
    return retMatrixST;
-} /*memWaterAln*/
+} /*memWaterScratch*/
+
+/*-------------------------------------------------------\
+| Fun-02: memWater
+|   - Performs a memory efficent Smith Waterman alignment
+|     on a pair of sequences (uses a temporary arena)
+| Input;
+|   - qryST:
+|     o SeqStruct with the query sequence and index 0
+|       coordinates to start (offsetUL)/end (endAlnUL) the
+|       alignment.
+|   - refST:
+|     o SeqStruct with the reference sequence and index 0
+|       coordinates to start (offsetUL)/end (endAlnUL) the
+|       alignment
+|   - settings:
+|     o alnSet structure with the setttings, such as
+|       gap open, gap extend, scoring matrix, and
+|       preffered direction.
+| Output:
+|  - Returns:
+|    o alnMatrix struct with the best score
+|    o 0 for memory allocation errors
+\-------------------------------------------------------*/
+static struct alnMatrix * memWater(
+    struct seqStruct *qryST, /*query sequence*/
+    struct seqStruct *refST, /*ref sequence*/
+    struct alnSet *settings  /*Settings for alignment*/
+){
+   struct alnScratch scratchST;
+   struct alnMatrix *retMatrixST = 0;
+
+   initAlnScratch(&scratchST);
+
+   retMatrixST =
+      memWaterScratch(qryST, refST, settings, &scratchST);
+
+   freeAlnScratchStack(&scratchST);
+   return retMatrixST;
+} /*memWater*/
 
 #endif
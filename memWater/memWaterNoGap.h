@@ -102,6 +102,7 @@ static struct alnMatrix * memWaterNoGap(
    /*Get start & end of query and reference sequences*/
    char *refSeqStr = 0;
    char *qrySeqStr = 0;
+   char *profRowC = 0; /*Scores for a query base*/
 
    ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
    ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
@@ -148,6 +149,17 @@ static struct alnMatrix * memWaterNoGap(
    *  - Allocate memory for the alignment
    \****************************************************/
 
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         qryST->endAlnUL - qryST->offsetUL + 1,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
    retMatrixST = malloc(sizeof(struct alnMatrix));
    if(retMatrixST == 0) return 0;
    initAlnMatrix(retMatrixST);
@@ -270,6 +282,12 @@ static struct alnMatrix * memWaterNoGap(
       ulQryBase <= qryST->endAlnUL - qryST->offsetUL;
       ++ulQryBase
    ){ /*loop; compare query base against all ref bases*/
+      profRowC =
+         getScoreProfRow(
+            qrySeqStr[ulQryBase],
+            refSeqStr,
+            settings
+         ); /*Scores for this query base*/
 
       for(
          ulRefBase = 1;
@@ -277,8 +295,7 @@ static struct alnMatrix * memWaterNoGap(
          ++ulRefBase
       ){ /*loop; compare one query to one reference base*/
          waterScanMaxScoreNoGap(
-            refSeqStr[ulRefBase],
-            qrySeqStr[ulQryBase],
+            profRowC[ulRefBase],
             scoreAryL[ulRefBase],
             dirRow[ulRefBase],
             indexAryUL[ulRefBase],
@@ -315,8 +332,7 @@ static struct alnMatrix * memWaterNoGap(
       \***************************************************/
 
       waterScanMaxEndRowScoreNoGap(
-         refSeqStr[ulRefBase],
-         qrySeqStr[ulQryBase],
+         profRowC[ulRefBase],
          scoreAryL[ulRefBase],
          dirRow[ulRefBase],
          indexAryUL[ulRefBase],
@@ -370,6 +386,9 @@ static struct alnMatrix * memWaterNoGap(
       indexAryUL = oldIndexAryUL;
       oldIndexAryUL = swapPtrUL;
 
+      /*The gap column is a stop, so it is its own start*/
+      indexAryUL[0] = indexUL;
+
       ++indexUL; /*Set index for the next base pair*/
    } /*loop; compare query base against all ref bases*/
 
@@ -20,6 +20,7 @@
 #   - "../general/alnSetStruct.h"      (No .c file)
 #   o "../general/alnSeqDefaults.h"    (No .c file)
 #   - "../general/seqStruct.h"         (No .c file)
+#   - "../general/alnScratch.h"        (No .c file)
 # C Standard libraries:
 #   o <stdlib.h>
 #   o <stdint.h>
@@ -32,18 +33,24 @@
 #include "../general/genScan.h"
 #include "../general/alnSetStruct.h"
 #include "../general/seqStruct.h"
+#include "../general/alnScratch.h"
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
 ' SOF: Start Of File
-' o fun-01 memWaterScan:
+' o fun-01 memWaterScanScratch:
+'   - Run a memory efficent Waterman Smith alignment that
+'     returns alternative alignmetns (rows from an arena)
+' o fun-02 memWaterScan:
 '   - Run a memory efficent Waterman Smith alignment that
 '     returns alternative alignmetns
 \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 /*-------------------------------------------------------\
-| Fun-01: memWaterScan
+| Fun-01: memWaterScanScratch
 |   - Performs a memory efficent Smith Waterman alignment
-|     with a query/reference scan on a pair of sequences
+|     with a query/reference scan on a pair of sequences.
+|     The score, direction, and index rows are taken from
+|     an arena.
 | Input;
 |   - qryST:
 |     o SeqStruct with the query sequence and index 0
@@ -57,17 +64,25 @@
 |     o alnSet structure with the setttings, such as
 |       gap open, gap extend, scoring matrix, and
 |       preffered direction.
+|   - scratchST:
+|     o alnScratch structure (arena) to get the rows from.
+|       This is reset first, so memory from earlier calls
+|       is no longer valid.
 | Output:
+|  - Modifies:
+|    o scratchST to hold the rows
 |  - Returns:
-|    o an alnMatrix struct with the best scores
+|    o an alnMatrix struct with the best scores (the
+|      kept score and index arrays are not in scratchST)
 |    o 0 for memory allocation errors
 \-------------------------------------------------------*/
-static struct alnMatrix * memWaterScan(
+static struct alnMatrix * memWaterScanScratch(
     struct seqStruct *qryST, /*query sequence*/
     struct seqStruct *refST, /*ref sequence*/
-    struct alnSet *settings  /*Settings for alignment*/
+    struct alnSet *settings, /*Settings for alignment*/
+    struct alnScratch *scratchST /*Arena for rows*/
 ){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
-   ' Fun-01 TOC: memWaterScan
+   ' Fun-01 TOC: memWaterScanScratch
    '  - Run a memory efficent Waterman Smith alignment on
    '    input sequences and try to get the best score for
    '    each query and reference base
@@ -105,6 +120,7 @@ static struct alnMatrix * memWaterScan(
    /*Get start & end of query and reference sequences*/
    char *refSeqStr = 0;
    char *qrySeqStr = 0;
+   char *profRowC = 0; /*Scores for a query base*/
 
    ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
    ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
@@ -172,26 +188,34 @@ static struct alnMatrix * memWaterScan(
    *  - Allocate memory for the alignment
    \*****************************************************/
 
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         qryST->endAlnUL - qryST->offsetUL + 1,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
    retMatrixST = malloc(1 * sizeof(struct alnMatrix));
    if(retMatrixST == 0) return 0;
    initAlnMatrix(retMatrixST);
 
-   dirRow = malloc((lenRefUL + 1) * sizeof(char));
+   /*Rows from the last alignment are no longer needed*/
+   resetAlnScratch(scratchST);
 
-   if(dirRow == 0)
-   { /*If: Memory error*/
-      freeAlnMatrix(retMatrixST);
-      free(dirRow);
-      return 0;
-   } /*If: Memory error*/
+   dirRow =
+      getAlnScratch(scratchST,(lenRefUL + 1)*sizeof(char));
 
-   scoreAryL = calloc((lenRefUL + 1), sizeof(long));
+   scoreAryL =
+      callocAlnScratch(scratchST, lenRefUL+1, sizeof(long));
    /*+ 1 is for the indel column*/
 
-   if(scoreAryL == 0)
+   if(dirRow == 0 || scoreAryL == 0)
    { /*If I had a memory error*/
      freeAlnMatrix(retMatrixST);
-     free(dirRow);
      return 0;
    } /*If I had a memory error*/
 
@@ -215,9 +239,7 @@ static struct alnMatrix * memWaterScan(
 
    if(refScoreAryL == 0)
    { /*If had a memory error*/
-      free(scoreAryL);
       freeAlnMatrix(retMatrixST);
-      free(dirRow);
       return 0;
    } /*If had a memory error*/
 
@@ -233,9 +255,7 @@ static struct alnMatrix * memWaterScan(
 
    if(refIndexAryUL == 0)
    { /*If had a memory error*/
-      free(scoreAryL);
       freeAlnMatrix(retMatrixST);
-      free(dirRow);
       return 0;
    } /*If had a memory error*/
 
@@ -247,9 +267,7 @@ static struct alnMatrix * memWaterScan(
 
    if(refEndIndexAryUL == 0)
    { /*If had a memory error*/
-      free(scoreAryL);
       freeAlnMatrix(retMatrixST);
-      free(dirRow);
       return 0;
    } /*If had a memory error*/
 
@@ -261,26 +279,16 @@ static struct alnMatrix * memWaterScan(
    *  - Get memory for keeping track of starting indexes
    \*****************************************************/
 
-   /*Set up the first row of starting indexes*/
-   indexAryUL = malloc((lenRefUL + 1) * sizeof(ulong));
-
-   if(indexAryUL == 0)
-   { /*If had a memory error*/
-      free(scoreAryL);
-      freeAlnMatrix(retMatrixST);
-      free(dirRow);
-      return 0;
-   } /*If had a memory error*/
+   /*Two rows of starting indexes*/
+   indexAryUL =
+      getAlnScratch(scratchST,(lenRefUL + 1)*sizeof(ulong));
 
-   /*Set up the second row of indexs (so have two rows)*/
-   oldIndexAryUL = malloc((lenRefUL + 1) * sizeof(ulong));
+   oldIndexAryUL =
+      getAlnScratch(scratchST,(lenRefUL + 1)*sizeof(ulong));
 
-   if(oldIndexAryUL == 0)
+   if(indexAryUL == 0 || oldIndexAryUL == 0)
    { /*If had a memory error*/
-      free(indexAryUL);
-      free(scoreAryL);
       freeAlnMatrix(retMatrixST);
-      free(dirRow);
       return 0;
    } /*If had a memory error*/
 
@@ -352,6 +360,12 @@ static struct alnMatrix * memWaterScan(
       ulQry <= qryST->endAlnUL - qryST->offsetUL;
       ++ulQry
    ){ /*loop; compare query base against all qry bases*/
+      profRowC =
+         getScoreProfRow(
+            qrySeqStr[ulQry],
+            refSeqStr,
+            settings
+         ); /*Scores for this query base*/
 
       for(
          ulRef = 1;
@@ -359,8 +373,7 @@ static struct alnMatrix * memWaterScan(
          ++ulRef
       ){ /*loop; compare one query to one reference base*/
          waterScanMaxScore(
-            refSeqStr[ulRef],
-            qrySeqStr[ulQry],
+            profRowC[ulRef],
             gapDiffS,
             scoreAryL[ulRef],
             dirRow[ulRef],
@@ -413,8 +426,7 @@ static struct alnMatrix * memWaterScan(
          ++ulRef
       ){ /*loop; compare one query to one reference base*/
          waterScanMaxScore(
-            refSeqStr[ulRef],
-            qrySeqStr[ulQry],
+            profRowC[ulRef],
             gapDiffS,
             scoreAryL[ulRef],
             dirRow[ulRef],
@@ -455,8 +467,7 @@ static struct alnMatrix * memWaterScan(
       \***************************************************/
 
       waterScanMaxEndRowScore(
-         refSeqStr[ulRef],
-         qrySeqStr[ulQry],
+         profRowC[ulRef],
          gapDiffS,
          scoreAryL[ulRef],
          dirRow[ulRef],
@@ -509,6 +520,9 @@ static struct alnMatrix * memWaterScan(
       indexAryUL = oldIndexAryUL;
       oldIndexAryUL = swapPtrUL;
 
+      /*The gap column is a stop, so it is its own start*/
+      indexAryUL[0] = indexUL;
+
       ++indexUL; /*Set index for the next base pair*/
    } /*loop; compare query base against all ref bases*/
 
@@ -526,11 +540,7 @@ static struct alnMatrix * memWaterScan(
    *  - clean up
    \*****************************************************/
 
-   free(dirRow);
-   free(indexAryUL);
-   free(oldIndexAryUL);
-   free(scoreAryL);
-
+   /*The rows are kept in scratchST for the next call*/
    dirRow = 0;
    scoreAryL = 0;
    indexAryUL = 0;
@@ -562,6 +572,46 @@ static struct alnMatrix * memWaterScan(
       } /*If I have a new best score*/
    } /*Loop: Find the highest score*/
 
+   return retMatrixST;
+} /*memWaterScanScratch*/
+
+/*-------------------------------------------------------\
+| Fun-02: memWaterScan
+|   - Performs a memory efficent Smith Waterman alignment
+|     with a query/reference scan on a pair of sequences
+|     (uses a temporary arena)
+| Input;
+|   - qryST:
+|     o SeqStruct with the query sequence and index 0
+|       coordinates to start (offsetUL)/end (endAlnUL) the
+|       alignment.
+|   - refST:
+|     o SeqStruct with the reference sequence and index 0
+|       coordinates to start (offsetUL)/end (endAlnUL) the
+|       alignment
+|   - settings:
+|     o alnSet structure with the setttings, such as
+|       gap open, gap extend, scoring matrix, and
+|       preffered direction.
+| Output:
+|  - Returns:
+|    o an alnMatrix struct with the best scores
+|    o 0 for memory allocation errors
+\-------------------------------------------------------*/
+static struct alnMatrix * memWaterScan(
+    struct seqStruct *qryST, /*query sequence*/
+    struct seqStruct *refST, /*ref sequence*/
+    struct alnSet *settings  /*Settings for alignment*/
+){
+   struct alnScratch scratchST;
+   struct alnMatrix *retMatrixST = 0;
+
+   initAlnScratch(&scratchST);
+
+   retMatrixST =
+      memWaterScanScratch(qryST,refST,settings,&scratchST);
+
+   freeAlnScratchStack(&scratchST);
    return retMatrixST;
 } /*memWaterScan*/
 
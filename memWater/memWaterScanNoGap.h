@@ -106,6 +106,7 @@ static struct alnMatrix * memWaterScanNoGap(
    /*Get start & end of query and reference sequences*/
    char *refSeqStr = 0;
    char *qrySeqStr = 0;
+   char *profRowC = 0; /*Scores for a query base*/
 
    ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
    ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
@@ -169,6 +170,17 @@ static struct alnMatrix * memWaterScanNoGap(
    *  - Allocate memory for the alignment
    \*****************************************************/
 
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         qryST->endAlnUL - qryST->offsetUL + 1,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
    retMatrixST = malloc(1 * sizeof(struct alnMatrix));
    if(retMatrixST == 0) return 0;
    initAlnMatrix(retMatrixST);
@@ -349,6 +361,12 @@ static struct alnMatrix * memWaterScanNoGap(
       ulQry <= qryST->endAlnUL - qryST->offsetUL;
       ++ulQry
    ){ /*loop; compare query base against all qry bases*/
+      profRowC =
+         getScoreProfRow(
+            qrySeqStr[ulQry],
+            refSeqStr,
+            settings
+         ); /*Scores for this query base*/
 
       for(
          ulRef = 1;
@@ -356,8 +374,7 @@ static struct alnMatrix * memWaterScanNoGap(
          ++ulRef
       ){ /*loop; compare one query to one reference base*/
          waterScanMaxScoreNoGap(
-            refSeqStr[ulRef],
-            qrySeqStr[ulQry],
+            profRowC[ulRef],
             scoreAryL[ulRef],
             dirRow[ulRef],
             indexAryUL[ulRef],
@@ -409,8 +426,7 @@ static struct alnMatrix * memWaterScanNoGap(
          ++ulRef
       ){ /*loop; compare one query to one reference base*/
          waterScanMaxScoreNoGap(
-            refSeqStr[ulRef],
-            qrySeqStr[ulQry],
+            profRowC[ulRef],
             scoreAryL[ulRef],
             dirRow[ulRef],
             indexAryUL[ulRef],
@@ -450,8 +466,7 @@ static struct alnMatrix * memWaterScanNoGap(
       \***************************************************/
 
       waterScanMaxEndRowScoreNoGap(
-         refSeqStr[ulRef],
-         qrySeqStr[ulQry],
+         profRowC[ulRef],
          scoreAryL[ulRef],
          dirRow[ulRef],
          indexAryUL[ulRef],
@@ -503,6 +518,9 @@ static struct alnMatrix * memWaterScanNoGap(
       indexAryUL = oldIndexAryUL;
       oldIndexAryUL = swapPtrUL;
 
+      /*The gap column is a stop, so it is its own start*/
+      indexAryUL[0] = indexUL;
+
       ++indexUL; /*Set index for the next base pair*/
    } /*loop; compare query base against all ref bases*/
 
@@ -0,0 +1,975 @@
+/*########################################################
+# Name memWaterVect
+# Use:
+#  o Holds functions doing a memory efficent Smith
+#    Waterman alignment with vectors. The query is striped
+#    (Farrar) across 32 bit vectors and each reference base
+#    is scored against the full query in one pass. A lazy-F
+#    loop then corrects insertions that cross segments.
+#  o These return the same alnMatrix structure (best score,
+#    starting index, and ending index) as memWater.
+#  o Only the delInsSnp direction preference is supported.
+#    Other preferences fall back to memWater.
+#  o Coversion macros are in alnMatrixsStruct.h:
+#    indexToQry (fun-07), indexToRef (fun-08), and
+#    indexToCoord (fun-09)
+# Libraries:
+#   - "memWater.h"                     (No .c file)
+#   - "memWaterNoGap.h"                (No .c file)
+#   o "../general/genScan.h"           (No .c file)
+#   o "../general/alnMatrixStruct.h"   (No .c file)
+#   o "../general/dataTypeShortHand.h" (No .c file)
+#   o "../general/alnSetStruct.h"      (No .c file)
+#   o "../general/alnSeqDefaults.h"    (No .c file)
+#   o "../general/seqStruct.h"         (No .c file)
+#   - "../vectWrap/vectWrap.h"         (No .c file)
+#   o Compiler flag determined
+#     i) or "vectWrapAVX512.h"
+#     ii) or "vectWrapAVX2.h"
+#     iii) or "vectWrapSSE.h"
+#     iv) or "vectWrapNEON.h"
+#     v) or "vectWrapNEON64.h"
+# C Standard libraries:
+#   - <stdint.h>
+#   o <stdlib.h>
+#   o <stdio.h>
+########################################################*/
+
+#ifndef MEM_WATER_VECT_H
+#define MEM_WATER_VECT_H
+
+#include <stdint.h>
+
+#include "memWater.h"
+#include "memWaterNoGap.h"
+#include "../vectWrap/vectWrap.h"
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+' o macro-01 vectWaterDirBl:
+'   - Checks if the direction preference can be done with
+'     the vector kernels (only delInsSnp)
+' o macro-02 vectWaterPick:
+'   - Picks elements from one of two vectors using a mask
+' o macro-03 vectWaterScoreSeg:
+'   - Scores one segment (vector) of the striped query for
+'     a single reference base
+' o fun-04 memWaterVect:
+'   - Run a memory efficent Waterman Smith alignment with
+'     a striped query profile
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Macro-01: vectWaterDirBl
+|   - Checks if the direction preference can be done with
+|     the vector kernels. Only delInsSnp is supported.
+| Input:
+|   - pref:
+|     o The direction preference (settings->bestDirC)
+| Output:
+|   - Returns:
+|     o 1 if the vector kernels can be used
+|     o 0 if the scalar kernels have to be used
+\-------------------------------------------------------*/
+#if defined DELINSSNP
+   #define vectWaterDirBl(pref) 1
+
+#elif defined SNPINSDEL || defined SNPDELINS
+   #define vectWaterDirBl(pref) 0
+
+#elif defined INSSNPDEL || defined INSDELSNP
+   #define vectWaterDirBl(pref) 0
+
+#elif defined DELSNPINS
+   #define vectWaterDirBl(pref) 0
+
+#else
+   #define vectWaterDirBl(pref) ((pref) == defDelInsSnp)
+#endif
+
+#ifdef DEFNOVECT
+   /*No vector support was compiled in, use the scalar
+   ` memWater instead
+   */
+   #define memWaterVect(qryST, refST, settings)(\
+      (settings)->noGapBl ?\
+           memWaterNoGap((qryST), (refST), (settings))\
+         : memWater((qryST), (refST), (settings))\
+   )
+#else
+
+/*-------------------------------------------------------\
+| Macro-02: vectWaterPick
+|   - Picks elements from one of two vectors using a mask
+| Input:
+|   - maskVI:
+|     o vectI32 with -1 for elements to take from keepVI
+|       and 0 for elements to take from elseVI
+|   - keepVI:
+|     o vectI32 to take elements from when mask is -1
+|   - elseVI:
+|     o vectI32 to take elements from when mask is 0
+| Output:
+|   - Returns:
+|     o vectI32 with the picked elements
+\-------------------------------------------------------*/
+#define vectWaterPick(maskVI, keepVI, elseVI)(\
+   or_vectI32_retVectI32(\
+      and_vectI32_retVectI32((maskVI), (keepVI)),\
+      andNot_vectI32_retVectI32((maskVI), (elseVI))\
+   )\
+) /*vectWaterPick*/
+
+/*-------------------------------------------------------\
+| Macro-03: vectWaterScoreSeg
+|   - Scores one segment (vector) of the striped query for
+|     a single reference base
+|   - This follows waterScanMaxScore with delInsSnp, so
+|     a deletion wins ties with an insertion and a snp has
+|     to beat both to be kept
+| Input:
+|   - diagVI:
+|     o Scores for the cells on the diagnol (snp)
+|   - diagRowVI:
+|     o Starting query row of the diagnol cells
+|   - diagColVI:
+|     o Starting reference column of the diagnol cells
+|   - profVI:
+|     o Query profile scores for this reference base
+|   - leftVI:
+|     o Scores for the cells to the left (deletions)
+|   - leftSnpVI:
+|     o -1 if the left cell was a snp, else 0
+|   - leftRowVI:
+|     o Starting query row of the left cells
+|   - leftColVI:
+|     o Starting reference column of the left cells
+|   - insVI:
+|     o Insertion score (cell above + gap penalty)
+|   - insRowVI:
+|     o Starting query row of the cells above
+|   - insColVI:
+|     o Starting reference column of the cells above
+|   - validVI:
+|     o -1 for real query bases, 0 for padding at the end
+|   - rowVI:
+|     o Query row of each cell (start if the cell stops)
+|   - colVI:
+|     o Reference column of each cell
+|   - extendVI:
+|     o Gap extension penalty
+|   - gapDiffVI:
+|     o Gap open penalty - gap extension penalty
+|   - zeroVI:
+|     o vector of zeros
+|   - scoreVI:
+|     o Will hold the score for each cell
+|   - snpVI:
+|     o Will hold -1 if a cell was a snp, else 0
+|   - startRowVI:
+|     o Will hold the starting query row for each cell
+|   - startColVI:
+|     o Will hold the starting reference column for each
+|       cell
+| Output:
+|   - Modifies:
+|     o scoreVI, snpVI, startRowVI, and startColVI
+\-------------------------------------------------------*/
+#define vectWaterScoreSeg(\
+   diagVI,     /*Diagnol scores*/\
+   diagRowVI,  /*Diagnol starting query rows*/\
+   diagColVI,  /*Diagnol starting reference columns*/\
+   profVI,     /*Query profile for the reference base*/\
+   leftVI,     /*Scores to the left*/\
+   leftSnpVI,  /*-1 if left cell was snp*/\
+   leftRowVI,  /*Left starting query rows*/\
+   leftColVI,  /*Left starting reference columns*/\
+   insVI,      /*Insertion scores*/\
+   insRowVI,   /*Starting query rows of cells above*/\
+   insColVI,   /*Starting ref columns of cells above*/\
+   validVI,    /*-1 for query bases; 0 for padding*/\
+   rowVI,      /*Query row of each cell*/\
+   colVI,      /*Reference column of each cell*/\
+   extendVI,   /*Gap extension penalty*/\
+   gapDiffVI,  /*gap open - gap extension*/\
+   zeroVI,     /*Vector of zeros*/\
+   scoreVI,    /*Gets scores*/\
+   snpVI,      /*Gets -1 for snps, 0 for other*/\
+   startRowVI, /*Gets starting query rows*/\
+   startColVI  /*Gets starting reference columns*/\
+){ /*vectWaterScoreSeg*/\
+   vectI32 macroSnpVI =\
+      add_vectI32_retVectI32((diagVI), (profVI));\
+   \
+   vectI32 macroDelVI =\
+      add_vectI32_retVectI32(\
+         add_vectI32_retVectI32((leftVI), (extendVI)),\
+         and_vectI32_retVectI32((leftSnpVI), (gapDiffVI))\
+      );\
+   \
+   vectI32 macroInsBlVI =\
+      mask32_retVectI32(\
+         cmpgt_vectI32_retMask32((insVI), macroDelVI)\
+      ); /*Insertions only win if they beat deletions*/\
+   \
+   vectI32 macroKeepVI;\
+   \
+   (scoreVI) = max_vectI32_retVectI32(macroDelVI, (insVI));\
+   \
+   (snpVI) =\
+      mask32_retVectI32(\
+         cmpgt_vectI32_retMask32(\
+            macroSnpVI,\
+            max_vectI32_retVectI32((scoreVI), (zeroVI))\
+         )\
+      );\
+   (snpVI) = and_vectI32_retVectI32((snpVI), (validVI));\
+   \
+   (scoreVI) = max_vectI32_retVectI32((scoreVI), macroSnpVI);\
+   \
+   /*Find if keeping score of if alignment stops*/\
+   macroKeepVI =\
+      and_vectI32_retVectI32(\
+         mask32_retVectI32(\
+            cmpgt_vectI32_retMask32((scoreVI), (zeroVI))\
+         ),\
+         (validVI)\
+      );\
+   \
+   (scoreVI) = and_vectI32_retVectI32((scoreVI), macroKeepVI);\
+   \
+   /*Find the start of the alignment*/\
+   (startRowVI) =\
+      vectWaterPick(macroInsBlVI, (insRowVI), (leftRowVI));\
+   (startRowVI) =\
+      vectWaterPick((snpVI), (diagRowVI), (startRowVI));\
+   (startRowVI) =\
+      vectWaterPick(macroKeepVI, (startRowVI), (rowVI));\
+   \
+   (startColVI) =\
+      vectWaterPick(macroInsBlVI, (insColVI), (leftColVI));\
+   (startColVI) =\
+      vectWaterPick((snpVI), (diagColVI), (startColVI));\
+   (startColVI) =\
+      vectWaterPick(macroKeepVI, (startColVI), (colVI));\
+} /*vectWaterScoreSeg*/
+
+/*-------------------------------------------------------\
+| Fun-04: memWaterVect
+|   - Performs a memory efficent Smith Waterman alignment
+|     on a pair of sequences using a striped query profile
+|     and 32 bit vectors
+| Input;
+|   - qryST:
+|     o SeqStruct with the query sequence and index 0
+|       coordinates to start (offsetUL)/end (endAlnUL) the
+|       alignment.
+|   - refST:
+|     o SeqStruct with the reference sequence and index 0
+|       coordinates to start (offsetUL)/end (endAlnUL) the
+|       alignment
+|   - settings:
+|     o alnSet structure with the setttings, such as
+|       gap open, gap extend, scoring matrix, and
+|       preffered direction.
+| Output:
+|  - Returns:
+|    o alnMatrix struct with the best score
+|    o 0 for memory allocation errors
+\-------------------------------------------------------*/
+static struct alnMatrix * memWaterVect(
+    struct seqStruct *qryST, /*query sequence*/
+    struct seqStruct *refST, /*ref sequence*/
+    struct alnSet *settings  /*Settings for alignment*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-04 TOC: memWaterVect
+   '  - Run a memory efficent Waterman Smith alignment on
+   '    input sequences with a striped query profile
+   '  o fun-04 sec-01:
+   '    - Variable declerations
+   '  o fun-04 sec-02:
+   '    - Allocate memory for alignment
+   '  o fun-04 sec-03:
+   '    - Build the query profile and the gap column
+   '  o fun-04 sec-04:
+   '    - Fill the matrix with scores
+   '  o fun-04 sec-05:
+   '    - Clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-04 Sec-01: Variable declerations
+   ^  o fun-04 sec-01 sub-01:
+   ^    - Variables dealing with the query and reference
+   ^  o fun-04 sec-01 sub-02:
+   ^    - Variables holding the striped columns
+   ^  o fun-04 sec-01 sub-03:
+   ^    - Vectors
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*****************************************************\
+   * Fun-04 Sec-01 Sub-01:
+   *  - Variables dealing with the query and reference
+   \*****************************************************/
+
+   char *refSeqStr = 0;
+   char *qrySeqStr = 0;
+
+   ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
+   ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
+
+   /*Number of vectors in one striped column*/
+   ulong lenSegUL =
+      (lenQryUL + defNum32BitElms - 1) / defNum32BitElms;
+
+   /*Number of elements in one striped column*/
+   ulong lenColUL = lenSegUL * defNum32BitElms;
+
+   /*Iterators for loops*/
+   ulong ulRef = 0;
+   ulong ulSeg = 0;
+   ulong ulElm = 0;
+   ulong ulBase = 0;
+   ulong offsetUL = 0;
+
+   /*For finding the best score*/
+   int32_t colMaxI = 0;
+   ulong bestRowUL = 0;
+   ulong rowUL = 0;
+   ulong maskUL = 0;
+
+   /*Maps reference bases to their query profile*/
+   ulong profIndexAryUL[256];
+   ulong numProfUL = 0;
+
+   struct alnMatrix *retMatrixST = 0;
+
+   /*****************************************************\
+   * Fun-04 Sec-01 Sub-02:
+   *  - Variables holding the striped columns
+   \*****************************************************/
+
+   struct vectMemBlock memST;
+
+   int32_t *profAryI = 0;   /*Query profile*/
+   int32_t *validAryI = 0;  /*-1 for bases, 0 padding*/
+   int32_t *lane0AryI = 0;  /*-1 for lane 0, else 0*/
+   int32_t *rowAryI = 0;    /*Row for 1st segment*/
+   int32_t *maxAryI = 0;    /*For column max score*/
+
+   /*Current column*/
+   int32_t *scoreAryI = 0;
+   int32_t *snpAryI = 0;
+   int32_t *startRowAryI = 0;
+   int32_t *startColAryI = 0;
+
+   /*Last column*/
+   int32_t *oldScoreAryI = 0;
+   int32_t *oldSnpAryI = 0;
+   int32_t *oldStartRowAryI = 0;
+   int32_t *oldStartColAryI = 0;
+
+   int32_t *swapPtrI = 0;
+   int32_t *profOnI = 0;   /*Profile for reference base*/
+
+   /*****************************************************\
+   * Fun-04 Sec-01 Sub-03:
+   *  - Vectors
+   \*****************************************************/
+
+   vectI32 zeroVI = zero_retVectI32();
+   vectI32 oneVI = set1_I32_retVectI32(1);
+
+   vectI32 extendVI;
+   vectI32 gapDiffVI;
+   vectI32 lane0VI;
+   vectI32 rowBaseVI;
+
+   vectI32 diagVI;
+   vectI32 diagRowVI;
+   vectI32 diagColVI;
+
+   vectI32 firstDiagVI;      /*Diagnol for segment 0*/
+   vectI32 firstDiagRowVI;
+   vectI32 firstDiagColVI;
+
+   vectI32 leftVI;
+   vectI32 leftSnpVI;
+   vectI32 leftRowVI;
+   vectI32 leftColVI;
+
+   vectI32 insVI;
+   vectI32 insRowVI;
+   vectI32 insColVI;
+
+   vectI32 scoreVI;
+   vectI32 snpVI;
+   vectI32 startRowVI;
+   vectI32 startColVI;
+
+   vectI32 rowVI;
+   vectI32 colVI;
+   vectI32 maxVI;
+   vectI32 sameVI;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-04 Sec-02:
+   ^  - Allocate memory for alignment
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(
+         ! vectWaterDirBl(settings->bestDirC)
+      || settings->vectSetC == defVectScalar
+   ){ /*If: the vectors can not do this preference*/
+      if(settings->noGapBl)
+         return memWaterNoGap(qryST, refST, settings);
+
+      return memWater(qryST, refST, settings);
+   } /*If: the vectors can not do this preference*/
+
+   refSeqStr = refST->seqCStr + refST->offsetUL;
+   qrySeqStr = qryST->seqCStr + qryST->offsetUL;
+
+   /*Find the number of profiles I need*/
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+      profIndexAryUL[ulBase] = 0;
+
+   for(ulRef = 0; ulRef < lenRefUL; ++ulRef)
+   { /*Loop: find the bases in the reference*/
+      if(profIndexAryUL[(uchar) refSeqStr[ulRef]] == 0)
+      { /*If: this is a new base*/
+         ++numProfUL;
+         profIndexAryUL[(uchar) refSeqStr[ulRef]] =
+            numProfUL;
+      } /*If: this is a new base*/
+   } /*Loop: find the bases in the reference*/
+
+   retMatrixST = malloc(sizeof(struct alnMatrix));
+   if(retMatrixST == 0) return 0;
+   initAlnMatrix(retMatrixST);
+   retMatrixST->scoreBitsC = 32;
+
+   retMatrixST->lenRefUL = lenRefUL;
+   retMatrixST->refOffsetUL = refST->offsetUL;
+
+   retMatrixST->lenQryUL = lenQryUL;
+   retMatrixST->qryOffsetUL = qryST->offsetUL;
+
+   /*Profiles + valid + 8 columns + 3 small arrays*/
+   initVectMemBlock(&memST);
+
+   mallocVectMemBlock(
+      &memST,
+        ((numProfUL + 9) * lenColUL + 3 * defNum32BitElms)
+      * sizeof(int32_t)
+   );
+
+   if(memST.freePtr == 0)
+   { /*If: Memory error*/
+      freeAlnMatrix(retMatrixST);
+      return 0;
+   } /*If: Memory error*/
+
+   profAryI = (int32_t *) memST.alnPtr;
+   validAryI = profAryI + numProfUL * lenColUL;
+
+   scoreAryI = validAryI + lenColUL;
+   snpAryI = scoreAryI + lenColUL;
+   startRowAryI = snpAryI + lenColUL;
+   startColAryI = startRowAryI + lenColUL;
+
+   oldScoreAryI = startColAryI + lenColUL;
+   oldSnpAryI = oldScoreAryI + lenColUL;
+   oldStartRowAryI = oldSnpAryI + lenColUL;
+   oldStartColAryI = oldStartRowAryI + lenColUL;
+
+   lane0AryI = oldStartColAryI + lenColUL;
+   rowAryI = lane0AryI + defNum32BitElms;
+   maxAryI = rowAryI + defNum32BitElms;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-04 Sec-03:
+   ^  - Build the query profile and the gap column
+   ^  o fun-04 sec-03 sub-01:
+   ^    - Build the query profile
+   ^  o fun-04 sec-03 sub-02:
+   ^    - Set up the gap column and constant vectors
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*****************************************************\
+   * Fun-04 Sec-03 Sub-01:
+   *  - Build the query profile
+   \*****************************************************/
+
+   /* Element ulElm in segment ulSeg is query base
+   `  ulElm * lenSegUL + ulSeg (striped)
+   */
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+   { /*Loop: build the profile for each reference base*/
+      if(profIndexAryUL[ulBase] == 0) continue;
+
+      profOnI =
+         profAryI + (profIndexAryUL[ulBase] - 1) * lenColUL;
+
+      for(ulSeg = 0; ulSeg < lenSegUL; ++ulSeg)
+      { /*Loop: Fill in each segment*/
+         for(ulElm = 0; ulElm < defNum32BitElms; ++ulElm)
+         { /*Loop: Fill in each element*/
+            rowUL = ulElm * lenSegUL + ulSeg;
+
+            if(rowUL >= lenQryUL) *profOnI = 0;
+            else
+               *profOnI =
+                  getBaseScore(
+                     qrySeqStr[rowUL],
+                     (char) ulBase,
+                     settings
+                  );
+
+            ++profOnI;
+         } /*Loop: Fill in each element*/
+      } /*Loop: Fill in each segment*/
+   } /*Loop: build the profile for each reference base*/
+
+   /*****************************************************\
+   * Fun-04 Sec-03 Sub-02:
+   *  - Set up the gap column and constant vectors
+   \*****************************************************/
+
+   for(ulSeg = 0; ulSeg < lenSegUL; ++ulSeg)
+   { /*Loop: set up each segment*/
+      for(ulElm = 0; ulElm < defNum32BitElms; ++ulElm)
+      { /*Loop: set up each element*/
+         rowUL = ulElm * lenSegUL + ulSeg;
+         offsetUL = ulSeg * defNum32BitElms + ulElm;
+
+         validAryI[offsetUL] = -(rowUL < lenQryUL);
+
+         /*The gap column is a stop, so it is its start*/
+         oldScoreAryI[offsetUL] = 0;
+         oldSnpAryI[offsetUL] = 0;
+         oldStartRowAryI[offsetUL] = rowUL + 1;
+         oldStartColAryI[offsetUL] = 0;
+      } /*Loop: set up each element*/
+   } /*Loop: set up each segment*/
+
+   for(ulElm = 0; ulElm < defNum32BitElms; ++ulElm)
+   { /*Loop: set up the lane 0 mask and first rows*/
+      lane0AryI[ulElm] = -(ulElm == 0);
+      rowAryI[ulElm] = ulElm * lenSegUL + 1;
+   } /*Loop: set up the lane 0 mask and first rows*/
+
+   lane0VI = load_I32Ary_retVectI32(lane0AryI);
+   rowBaseVI = load_I32Ary_retVectI32(rowAryI);
+
+   if(settings->noGapBl)
+   { /*If: not using gap extension penalties*/
+      extendVI = set1_I32_retVectI32(settings->gapOpenC);
+      gapDiffVI = zeroVI;
+   } /*If: not using gap extension penalties*/
+
+   else
+   { /*Else: using gap extension penalties*/
+      extendVI = set1_I32_retVectI32(settings->gapExtendC);
+
+      gapDiffVI =
+         set1_I32_retVectI32(
+            settings->gapOpenC - settings->gapExtendC
+         );
+   } /*Else: using gap extension penalties*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-04 Sec-04:
+   ^  - Fill the matrix with scores
+   ^  o fun-04 sec-04 sub-01:
+   ^    - Set up for the next reference base
+   ^  o fun-04 sec-04 sub-02:
+   ^    - Score each segment (insertions stay in lane)
+   ^  o fun-04 sec-04 sub-03:
+   ^    - Lazy-F loop; move insertions across lanes
+   ^  o fun-04 sec-04 sub-04:
+   ^    - Check if have a new best score
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(ulRef = 1; ulRef <= lenRefUL; ++ulRef)
+   { /*Loop: score each reference base*/
+
+      /**************************************************\
+      * Fun-04 Sec-04 Sub-01:
+      *  - Set up for the next reference base
+      \**************************************************/
+
+      profOnI =
+           profAryI
+         +   (profIndexAryUL[(uchar) refSeqStr[ulRef - 1]] -1)
+           * lenColUL;
+
+      colVI = set1_I32_retVectI32(ulRef);
+      rowVI = rowBaseVI;
+      maxVI = zeroVI;
+
+      /*Segment 0 is the row below the last segment, but
+      ` shifted one element. Lane 0 is under the gap row
+      */
+      offsetUL = (lenSegUL - 1) * defNum32BitElms;
+
+      firstDiagVI =
+         slvect_vectI32_retVectI32(
+            load_I32Ary_retVectI32(oldScoreAryI + offsetUL),
+            1
+         );
+
+      firstDiagRowVI =
+         slvect_vectI32_retVectI32(
+            load_I32Ary_retVectI32(
+               oldStartRowAryI + offsetUL
+            ),
+            1
+         );
+
+      firstDiagColVI =
+         or_vectI32_retVectI32(
+            slvect_vectI32_retVectI32(
+               load_I32Ary_retVectI32(
+                  oldStartColAryI + offsetUL
+               ),
+               1
+            ),
+            and_vectI32_retVectI32(
+               lane0VI,
+               set1_I32_retVectI32(ulRef - 1)
+            )
+         );
+
+      diagVI = firstDiagVI;
+      diagRowVI = firstDiagRowVI;
+      diagColVI = firstDiagColVI;
+
+      /*The first pass does not carry insertions between
+      ` lanes. The lazy-F loop fixes this.
+      */
+      insVI = zeroVI;
+      insRowVI = zeroVI;
+      insColVI = zeroVI;
+
+      /**************************************************\
+      * Fun-04 Sec-04 Sub-02:
+      *  - Score each segment (insertions stay in lane)
+      \**************************************************/
+
+      for(ulSeg = 0; ulSeg < lenSegUL; ++ulSeg)
+      { /*Loop: score each segment*/
+         offsetUL = ulSeg * defNum32BitElms;
+
+         leftVI = load_I32Ary_retVectI32(oldScoreAryI+offsetUL);
+         leftSnpVI = load_I32Ary_retVectI32(oldSnpAryI+offsetUL);
+
+         leftRowVI =
+            load_I32Ary_retVectI32(oldStartRowAryI+offsetUL);
+         leftColVI =
+            load_I32Ary_retVectI32(oldStartColAryI+offsetUL);
+
+         vectWaterScoreSeg(
+            diagVI,
+            diagRowVI,
+            diagColVI,
+            load_I32Ary_retVectI32(profOnI + offsetUL),
+            leftVI,
+            leftSnpVI,
+            leftRowVI,
+            leftColVI,
+            insVI,
+            insRowVI,
+            insColVI,
+            load_I32Ary_retVectI32(validAryI + offsetUL),
+            rowVI,
+            colVI,
+            extendVI,
+            gapDiffVI,
+            zeroVI,
+            scoreVI,
+            snpVI,
+            startRowVI,
+            startColVI
+         );
+
+         store_vectI32_retAryI32(scoreAryI+offsetUL,scoreVI);
+         store_vectI32_retAryI32(snpAryI + offsetUL, snpVI);
+
+         store_vectI32_retAryI32(
+            startRowAryI + offsetUL,
+            startRowVI
+         );
+
+         store_vectI32_retAryI32(
+            startColAryI + offsetUL,
+            startColVI
+         );
+
+         maxVI = max_vectI32_retVectI32(maxVI, scoreVI);
+
+         /*Insertion score for the next segment*/
+         insVI =
+            add_vectI32_retVectI32(
+               add_vectI32_retVectI32(scoreVI, extendVI),
+               and_vectI32_retVectI32(snpVI, gapDiffVI)
+            );
+
+         insRowVI = startRowVI;
+         insColVI = startColVI;
+
+         diagVI = leftVI;
+         diagRowVI = leftRowVI;
+         diagColVI = leftColVI;
+
+         rowVI = add_vectI32_retVectI32(rowVI, oneVI);
+      } /*Loop: score each segment*/
+
+      /**************************************************\
+      * Fun-04 Sec-04 Sub-03:
+      *  - Lazy-F loop; move insertions across lanes
+      \**************************************************/
+
+      /* Insertions only increase scores, so each cell is
+      `  rescored with the insertion from the lane below
+      `  until no cell in a segment changes. A segment with
+      `  no changes means every later segment is correct.
+      */
+      insVI = slvect_vectI32_retVectI32(insVI, 1);
+      insRowVI = slvect_vectI32_retVectI32(insRowVI, 1);
+      insColVI = slvect_vectI32_retVectI32(insColVI, 1);
+
+      diagVI = firstDiagVI;
+      diagRowVI = firstDiagRowVI;
+      diagColVI = firstDiagColVI;
+
+      rowVI = rowBaseVI;
+      ulSeg = 0;
+
+      while(1)
+      { /*Loop: Lazy-F loop*/
+         offsetUL = ulSeg * defNum32BitElms;
+
+         leftVI = load_I32Ary_retVectI32(oldScoreAryI+offsetUL);
+         leftSnpVI = load_I32Ary_retVectI32(oldSnpAryI+offsetUL);
+
+         leftRowVI =
+            load_I32Ary_retVectI32(oldStartRowAryI+offsetUL);
+         leftColVI =
+            load_I32Ary_retVectI32(oldStartColAryI+offsetUL);
+
+         vectWaterScoreSeg(
+            diagVI,
+            diagRowVI,
+            diagColVI,
+            load_I32Ary_retVectI32(profOnI + offsetUL),
+            leftVI,
+            leftSnpVI,
+            leftRowVI,
+            leftColVI,
+            insVI,
+            insRowVI,
+            insColVI,
+            load_I32Ary_retVectI32(validAryI + offsetUL),
+            rowVI,
+            colVI,
+            extendVI,
+            gapDiffVI,
+            zeroVI,
+            scoreVI,
+            snpVI,
+            startRowVI,
+            startColVI
+         );
+
+         /*Check if any cell in this segment changed*/
+         sameVI =
+            and_vectI32_retVectI32(
+               mask32_retVectI32(
+                  cmpeq_vectI32_retMask32(
+                     scoreVI,
+                     load_I32Ary_retVectI32(scoreAryI+offsetUL)
+                  )
+               ),
+               mask32_retVectI32(
+                  cmpeq_vectI32_retMask32(
+                     snpVI,
+                     load_I32Ary_retVectI32(snpAryI+offsetUL)
+                  )
+               )
+            );
+
+         sameVI =
+            and_vectI32_retVectI32(
+               sameVI,
+               mask32_retVectI32(
+                  cmpeq_vectI32_retMask32(
+                     startRowVI,
+                     load_I32Ary_retVectI32(
+                        startRowAryI + offsetUL
+                     )
+                  )
+               )
+            );
+
+         sameVI =
+            and_vectI32_retVectI32(
+               sameVI,
+               mask32_retVectI32(
+                  cmpeq_vectI32_retMask32(
+                     startColVI,
+                     load_I32Ary_retVectI32(
+                        startColAryI + offsetUL
+                     )
+                  )
+               )
+            );
+
+         store_mask32_retUL(
+            maskUL,
+            cmpgt_vectI32_retMask32(zeroVI, sameVI)
+         ); /*sameVI is -1 (< 0) for unchanged cells*/
+
+         if(maskUL == defMvMask32) break;
+
+         store_vectI32_retAryI32(scoreAryI+offsetUL,scoreVI);
+         store_vectI32_retAryI32(snpAryI + offsetUL, snpVI);
+
+         store_vectI32_retAryI32(
+            startRowAryI + offsetUL,
+            startRowVI
+         );
+
+         store_vectI32_retAryI32(
+            startColAryI + offsetUL,
+            startColVI
+         );
+
+         maxVI = max_vectI32_retVectI32(maxVI, scoreVI);
+
+         insVI =
+            add_vectI32_retVectI32(
+               add_vectI32_retVectI32(scoreVI, extendVI),
+               and_vectI32_retVectI32(snpVI, gapDiffVI)
+            );
+
+         insRowVI = startRowVI;
+         insColVI = startColVI;
+
+         diagVI = leftVI;
+         diagRowVI = leftRowVI;
+         diagColVI = leftColVI;
+
+         rowVI = add_vectI32_retVectI32(rowVI, oneVI);
+         ++ulSeg;
+
+         if(ulSeg == lenSegUL)
+         { /*If: I need to move to the next lane*/
+            insVI = slvect_vectI32_retVectI32(insVI, 1);
+            insRowVI = slvect_vectI32_retVectI32(insRowVI, 1);
+            insColVI = slvect_vectI32_retVectI32(insColVI, 1);
+
+            diagVI = firstDiagVI;
+            diagRowVI = firstDiagRowVI;
+            diagColVI = firstDiagColVI;
+
+            rowVI = rowBaseVI;
+            ulSeg = 0;
+         } /*If: I need to move to the next lane*/
+      } /*Loop: Lazy-F loop*/
+
+      /**************************************************\
+      * Fun-04 Sec-04 Sub-04:
+      *  - Check if have a new best score
+      \**************************************************/
+
+      /*memWater keeps the first best score it finds, going
+      ` row by row (query). So a tie is only kept if it is
+      ` on an earlier query row.
+      */
+      store_vectI32_retAryI32(maxAryI, maxVI);
+      colMaxI = 0;
+
+      for(ulElm = 0; ulElm < defNum32BitElms; ++ulElm)
+         if(maxAryI[ulElm] > colMaxI) colMaxI=maxAryI[ulElm];
+
+      if(colMaxI == 0) goto swapColumns;
+      if(colMaxI < retMatrixST->bestScoreL) goto swapColumns;
+
+      maxVI = set1_I32_retVectI32(colMaxI);
+      rowUL = lenColUL + 1;
+
+      for(ulSeg = 0; ulSeg < lenSegUL; ++ulSeg)
+      { /*Loop: find the first row with the max score*/
+         offsetUL = ulSeg * defNum32BitElms;
+
+         store_mask32_retUL(
+            maskUL,
+            cmpeq_vectI32_retMask32(
+               maxVI,
+               load_I32Ary_retVectI32(scoreAryI + offsetUL)
+            )
+         );
+
+         if(maskUL == 0) continue;
+
+         for(ulElm = 0; ulElm < defNum32BitElms; ++ulElm)
+         { /*Loop: find the lanes with the max score*/
+            if(scoreAryI[offsetUL + ulElm] != colMaxI)
+               continue;
+
+            if(ulElm * lenSegUL + ulSeg + 1 < rowUL)
+            { /*If: this is an earlier row*/
+               rowUL = ulElm * lenSegUL + ulSeg + 1;
+               ulBase = offsetUL + ulElm;
+            } /*If: this is an earlier row*/
+
+            break; /*Later lanes are later rows*/
+         } /*Loop: find the lanes with the max score*/
+      } /*Loop: find the first row with the max score*/
+
+      if(
+            colMaxI > retMatrixST->bestScoreL
+         || rowUL < bestRowUL
+      ){ /*If: this is the best score*/
+         retMatrixST->bestScoreL = colMaxI;
+         bestRowUL = rowUL;
+
+         retMatrixST->bestStartIndexUL =
+              (ulong) startRowAryI[ulBase] * (lenRefUL + 1)
+            + (ulong) startColAryI[ulBase];
+
+         retMatrixST->bestEndIndexUL =
+            rowUL * (lenRefUL + 1) + ulRef;
+      } /*If: this is the best score*/
+
+      swapColumns:
+
+      swapPtrI = scoreAryI;
+      scoreAryI = oldScoreAryI;
+      oldScoreAryI = swapPtrI;
+
+      swapPtrI = snpAryI;
+      snpAryI = oldSnpAryI;
+      oldSnpAryI = swapPtrI;
+
+      swapPtrI = startRowAryI;
+      startRowAryI = oldStartRowAryI;
+      oldStartRowAryI = swapPtrI;
+
+      swapPtrI = startColAryI;
+      startColAryI = oldStartColAryI;
+      oldStartColAryI = swapPtrI;
+   } /*Loop: score each reference base*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-04 Sec-05:
+   ^  - Clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   freeVectMemBlockBuff(&memST);
+   return retMatrixST;
+} /*memWaterVect*/
+
+#endif /*DEFNOVECT*/
+#endif
@@ -153,6 +153,7 @@ int main(
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
    freeAlnST(alnST);
+   freeAlnSetStack(&settings); /*Score profile rows*/
    freeSeqSTStack(&refST);
    freeSeqSTStack(&qryST);
    free(outRefSeqStr);
@@ -30,10 +30,9 @@
 | Fun-01: needleMaxScore
 |   - Maximizes the score for a single Needleman alignment
 | Input;
-|   - refBase;
-|     o Reference base to find score for
-|   - qryBase;
-|     o Query base to find score for
+|   - baseScore;
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - gapDiff:
 |     o Gap Exentsion score - gap open score.
 |     o This is used to find the indel scores
@@ -57,8 +56,7 @@
 |     o delScore to hold the score for the next deletion
 \-------------------------------------------------------*/
 #define needleMaxScore(\
-   refBase,     /*Reference Base*/\
-   qryBase,     /*Query Base*/\
+   baseScore,   /*Score for ref/query bases*/\
    gapDiff,     /*GapExtend - gapOpen*/\
    scoreOn,     /*Score to update*/\
    dirOn,       /*Direction to update*/\
@@ -69,7 +67,7 @@
 ){ /*needleMaxScore*/\
    long macroSnpScoreL =\
         (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
     \
     long macroInsScoreL =\
          (scoreOn)\
@@ -89,7 +87,7 @@
     \
     (delScore) =\
          (long) (scoreOn)\
-       + ((gapDiff) & (-(dirOn) != defMvSnp))\
+       + ((gapDiff) & (-((dirOn) != defMvSnp)))\
        + (alnSetPtr)->gapOpenC;\
 } /*needleMaxScore*/
 
@@ -99,10 +97,9 @@
 |   - This for the end of a row, were you do not want the
 |     next snp or deletion score
 | Input;
-|   - refBase;
-|     o Reference base to find score for
-|   - qryBase;
-|     o Query base to find score for
+|   - baseScore;
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - gapDiff:j
 |     o Gap Exentsion score - gap open score.
 |     o This is used to find the indel scores
@@ -121,8 +118,7 @@
 |     o dirOn to hold the direction of the max score
 \-------------------------------------------------------*/
 #define needleMaxEndRowScore(\
-   refBase,     /*Reference Base*/\
-   qryBase,     /*Query Base*/\
+   baseScore,   /*Score for ref/query bases*/\
    gapDiff,    /*GapExtend - gapOpen*/\
    scoreOn,     /*Score to update*/\
    dirOn,       /*Direction to update*/\
@@ -133,7 +129,7 @@
 ){ /*needleMaxEndRowScore*/\
    long macroSnpScoreL =\
       (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
     \
     long macroInsScoreL =\
          (scoreOn)\
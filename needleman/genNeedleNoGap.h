@@ -32,10 +32,9 @@
 |   - Maximizes the score for a single Needleman alignment
 |     with no gap extension penalty
 | Input;
-|   - refBase;
-|     o Reference base to find score for
-|   - qryBase;
-|     o Query base to find score for
+|   - baseScore;
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - gapDiff:
 |     o Gap Exentsion score - gap open score.
 |     o This is used to find the indel scores
@@ -59,8 +58,7 @@
 |     o delScore to hold the score for the next deletion
 \-------------------------------------------------------*/
 #define needleMaxScoreNoGap(\
-   refBase,     /*Reference Base*/\
-   qryBase,     /*Query Base*/\
+   baseScore,   /*Score for ref/query bases*/\
    scoreOn,     /*Score to update*/\
    dirOn,       /*Direction to update*/\
    insDir,      /*Insertion direction*/\
@@ -70,7 +68,7 @@
 ){ /*needleMaxScore*/\
    long macroSnpScoreL =\
         (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
     \
     long macroInsScoreL =\
          (scoreOn) + (alnSetPtr)->gapOpenC;\
@@ -97,10 +95,9 @@
 |   - This for the end of a row, were you do not want the
 |     next snp or deletion score
 | Input;
-|   - refBase;
-|     o Reference base to find score for
-|   - qryBase;
-|     o Query base to find score for
+|   - baseScore;
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - gapDiff:j
 |     o Gap Exentsion score - gap open score.
 |     o This is used to find the indel scores
@@ -119,8 +116,7 @@
 |     o dirOn to hold the direction of the max score
 \-------------------------------------------------------*/
 #define needleMaxEndRowScoreNoGap(\
-   refBase,     /*Reference Base*/\
-   qryBase,     /*Query Base*/\
+   baseScore,   /*Score for ref/query bases*/\
    scoreOn,     /*Score to update*/\
    dirOn,       /*Direction to update*/\
    insDir,      /*Insertion direction*/\
@@ -130,7 +126,7 @@
 ){ /*needleMaxEndRowScoreNoGap*/\
    long macroSnpScoreL =\
       (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
     \
     long macroInsScoreL =\
          (scoreOn) + (alnSetPtr)->gapOpenC;\
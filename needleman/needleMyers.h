@@ -0,0 +1,806 @@
+/*########################################################
+# Name needleMyers
+# Use:
+#  o Holds functions for doing a Needleman alignment with
+#    the Myers (Hyyro) bit-vector edit distance algorithm
+#  o This is only used when the scoring matrix and gap
+#    penalties are unit costs (see needleMyersBl). Then
+#    the best Needleman score is found from the edit
+#    distance and both give the same alignment.
+#  o Each bit in a ulong is a query base, so one word
+#    scores 64 cells at once. Longer queries are split
+#    into blocks of words.
+#  o Only the vertical differences (+1, 0, or -1) of each
+#    column are kept (two bits per cell). The alignment is
+#    found by rebuilding the edit distances from them.
+# Libraries:
+#   - "../general/alnStruct.h"         (No .c file)
+#   o "../general/alnMatrixStruct.h"   (No .c file)
+#   o "../general/twoBitArrays.h"      (No .c file)
+#   o "../general/dataTypeShortHand.h" (No .c file)
+#   o "../general/alnSetStruct.h"      (No .c file)
+#   o "../general/base10StrToNum.h"    (No .c file)
+#   o "../general/alnSeqDefaults.h"    (No .c file)
+#   o "../general/seqStruct.h"         (No .c file)
+# C Standard libraries:
+#   o <stdlib.h>
+#   o <stdio.h>
+#   o <string.h>
+#   o <time.h>
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOH: Start Of Header
+'  - macro-01 needleMyersDirBl:
+'    o Checks if the direction preference can be done
+'      with needleMyers
+'  - macro-02 needleMyersPopCnt:
+'    o Counts the number of bits set in a ulong
+'  - fun-03 needleMyersBl:
+'    o Checks if the alignment settings are unit costs
+'  - fun-04 needleMyersBlock:
+'    o Scores one block (word) of a column
+'  - fun-05 needleMyersCol:
+'    o Finds the edit distance of a cell from the vertical
+'      differences of its column
+'  - fun-06 needleMyers:
+'    o Does a Needleman alignment with bit-vectors
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#ifndef NEEDLEMAN_MYERS_H
+#define NEEDLEMAN_MYERS_H
+
+#include "../general/alnStruct.h"
+
+/*Number of query bases in a block (bits in a ulong)*/
+#define defMyersBlockBits (sizeof(ulong) << 3)
+#define defMyersHighBit \
+   (((ulong) 1) << (defMyersBlockBits - 1))
+
+/*-------------------------------------------------------\
+| Macro-01: needleMyersDirBl
+|   - Checks if the direction preference can be done with
+|     needleMyers. Only delInsSnp is supported.
+| Input:
+|   - pref:
+|     o The direction preference (settings->bestDirC)
+| Output:
+|   - Returns:
+|     o 1 if needleMyers can be used
+|     o 0 if NeedlemanAln has to be used
+\-------------------------------------------------------*/
+#if defined DELINSSNP
+   #define needleMyersDirBl(pref) 1
+
+#elif defined SNPINSDEL || defined SNPDELINS
+   #define needleMyersDirBl(pref) 0
+
+#elif defined INSSNPDEL || defined INSDELSNP
+   #define needleMyersDirBl(pref) 0
+
+#elif defined DELSNPINS
+   #define needleMyersDirBl(pref) 0
+
+#else
+   #define needleMyersDirBl(pref) ((pref) == defDelInsSnp)
+#endif
+
+/*-------------------------------------------------------\
+| Macro-02: needleMyersPopCnt
+|   - Counts the number of bits set in a ulong
+| Input:
+|   - valUL:
+|     o ulong to count the bits in (is modified)
+|   - cntL:
+|     o long to add the number of set bits to
+| Output:
+|   - Modifies:
+|     o valUL to be 0
+|     o cntL to have the number of set bits added
+\-------------------------------------------------------*/
+#define needleMyersPopCnt(valUL, cntL){\
+   while((valUL) != 0)\
+   { /*Loop: clear the lowest set bit*/\
+      (valUL) &= (valUL) - 1;\
+      ++(cntL);\
+   } /*Loop: clear the lowest set bit*/\
+} /*needleMyersPopCnt*/
+
+/*-------------------------------------------------------\
+| Fun-03: needleMyersBl
+|  - Checks if the alignment settings are unit costs, so
+|    a Needleman alignment is the same as an edit
+|    distance alignment
+| Input:
+|  - qryST:
+|    o Pionter to seqStruct structure with query sequence
+|      and region to align (offsetUL and endAlnUL)
+|  - refST:
+|    o Pionter to seqStruct with reference sequence and
+|      region to align (offsetUL and endAlnUL)
+|  - settings:
+|    o Point to alnSet structure with alignment settings
+|  - matchL:
+|    o Pointer to long to hold the match score (M)
+|  - snpL:
+|    o Pointer to long to hold the mismatch score (X)
+| Output:
+|  - Modifies:
+|    o matchL and snpL to have the match and mismatch
+|      scores (only if 1 is returned)
+|  - Returns:
+|    o 1 if needleMyers can be used
+|    o 0 if NeedlemanAln has to be used
+| Note:
+|  - Unit costs are:
+|    o The gap extension penalty (G) is the gap opening
+|      penalty (or -no-gapextend is used)
+|    o Every score between a query and reference base is
+|      either the match score (M) or the mismatch score
+|      (X), with M > X
+|    o M - X = M / 2 - G (2M - 2X = M - 2G), so a
+|      mismatch and a gap both cost one edit
+|  - Then the score of a cell is M * (query + ref) / 2 -
+|    (M - X) * edit distance, so the best score is the
+|    smallest edit distance. The ties in each cell are
+|    the same, so the alignment is also the same.
+\-------------------------------------------------------*/
+static char needleMyersBl(
+    struct seqStruct *qryST, /*query sequence and data*/
+    struct seqStruct *refST, /*ref sequence and data*/
+    struct alnSet *settings, /*Settings for alignment*/
+    long *matchL,            /*Gets the match score*/
+    long *snpL               /*Gets the mismatch score*/
+){
+   char qryBlAry[256];
+   char refBlAry[256];
+   ulong ulBase = 0;
+   ulong ulRef = 0;
+   long maxL = 0;
+   long minL = 0;
+   long scoreL = 0;
+   long gapL = settings->gapOpenC;
+   char firstBl = 1;
+
+   if(! needleMyersDirBl(settings->bestDirC)) return 0;
+
+   if(
+         ! settings->noGapBl
+      && settings->gapExtendC != settings->gapOpenC
+   ) return 0; /*Gap extension penalties are not unit*/
+
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+   { /*Loop: Clear the base lists*/
+      qryBlAry[ulBase] = 0;
+      refBlAry[ulBase] = 0;
+   } /*Loop: Clear the base lists*/
+
+   for(
+      ulBase = qryST->offsetUL;
+      ulBase <= qryST->endAlnUL;
+      ++ulBase
+   ) qryBlAry[(uchar) qryST->seqCStr[ulBase]] = 1;
+
+   for(
+      ulBase = refST->offsetUL;
+      ulBase <= refST->endAlnUL;
+      ++ulBase
+   ) refBlAry[(uchar) refST->seqCStr[ulBase]] = 1;
+
+   /*Find the match (largest) and mismatch (smallest)
+   ` scores for the bases in the sequences
+   */
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+   { /*Loop: Check each query base*/
+      if(! qryBlAry[ulBase]) continue;
+
+      for(ulRef = 0; ulRef < 256; ++ulRef)
+      { /*Loop: Check each reference base*/
+         if(! refBlAry[ulRef]) continue;
+
+         scoreL =
+            getBaseScore(
+               (char) ulBase,
+               (char) ulRef,
+               settings
+            );
+
+         if(firstBl)
+         { /*If: this is the first score*/
+            maxL = scoreL;
+            minL = scoreL;
+            firstBl = 0;
+         } /*If: this is the first score*/
+
+         else if(scoreL > maxL) maxL = scoreL;
+         else if(scoreL < minL) minL = scoreL;
+      } /*Loop: Check each reference base*/
+   } /*Loop: Check each query base*/
+
+   if(maxL <= minL) return 0; /*Can not find mismatches*/
+
+   /*Make sure every score is a match or mismatch*/
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+   { /*Loop: Check each query base*/
+      if(! qryBlAry[ulBase]) continue;
+
+      for(ulRef = 0; ulRef < 256; ++ulRef)
+      { /*Loop: Check each reference base*/
+         if(! refBlAry[ulRef]) continue;
+
+         scoreL =
+            getBaseScore(
+               (char) ulBase,
+               (char) ulRef,
+               settings
+            );
+
+         if(scoreL != maxL && scoreL != minL) return 0;
+      } /*Loop: Check each reference base*/
+   } /*Loop: Check each query base*/
+
+   if(2 * (maxL - minL) != maxL - 2 * gapL) return 0;
+
+   *matchL = maxL;
+   *snpL = minL;
+   return 1;
+} /*needleMyersBl*/
+
+/*-------------------------------------------------------\
+| Fun-04: needleMyersBlock
+|  - Scores one block (word) of a column with the Myers
+|    bit-vector algorithm (Hyyro's version)
+| Input:
+|  - posVUL:
+|    o Pointer to ulong with the +1 vertical differences
+|      (bit i is row i) of the last column. This is set
+|      to the differences for this column.
+|  - negVUL:
+|    o Pointer to ulong with the -1 vertical differences
+|      of the last column. This is set to the differences
+|      for this column.
+|  - eqUL:
+|    o Bit i is set if query base i matches the
+|      reference base of this column
+|  - hInC:
+|    o Horizontal difference (-1, 0, or 1) above the
+|      first row of this block
+| Output:
+|  - Modifies:
+|    o posVUL and negVUL to have the differences of this
+|      column
+|  - Returns:
+|    o Horizontal difference (-1, 0, 1) of the last row
+|      in this block
+\-------------------------------------------------------*/
+static char needleMyersBlock(
+   ulong *posVUL,  /*+1 vertical differences*/
+   ulong *negVUL,  /*-1 vertical differences*/
+   ulong eqUL,     /*Query bases matching the ref base*/
+   char hInC       /*Horizontal difference above block*/
+){
+   ulong xVUL = eqUL | *negVUL;
+   ulong xHUL = 0;
+   ulong posHUL = 0;
+   ulong negHUL = 0;
+   char hOutC = 0;
+
+   if(hInC < 0) eqUL |= 1;
+
+   xHUL = (((eqUL & *posVUL) + *posVUL) ^ *posVUL) | eqUL;
+
+   posHUL = *negVUL | ~(xHUL | *posVUL);
+   negHUL = *posVUL & xHUL;
+
+   if(posHUL & defMyersHighBit) hOutC = 1;
+   if(negHUL & defMyersHighBit) hOutC = -1;
+
+   posHUL <<= 1;
+   negHUL <<= 1;
+
+   if(hInC < 0) negHUL |= 1;
+   else if(hInC > 0) posHUL |= 1;
+
+   *posVUL = negHUL | ~(xVUL | posHUL);
+   *negVUL = posHUL & xVUL;
+
+   return hOutC;
+} /*needleMyersBlock*/
+
+/*-------------------------------------------------------\
+| Fun-05: needleMyersCol
+|  - Finds the edit distance of a cell from the vertical
+|    differences of its column
+| Input:
+|  - posVAryUL:
+|    o +1 vertical differences for the column (0 for the
+|      gap column)
+|  - negVAryUL:
+|    o -1 vertical differences for the column
+|  - colUL:
+|    o Column (reference base, index 1) of the cell
+|  - rowUL:
+|    o Row (query base, index 1) of the cell
+| Output:
+|  - Returns:
+|    o Edit distance of the cell
+\-------------------------------------------------------*/
+static long needleMyersCol(
+   ulong *posVAryUL,  /*+1 vertical differences*/
+   ulong *negVAryUL,  /*-1 vertical differences*/
+   ulong colUL,       /*Column of cell*/
+   ulong rowUL        /*Row of cell*/
+){
+   long posCntL = (long) colUL; /*Gap row distance*/
+   long negCntL = 0;
+   ulong blockUL = 0;
+   ulong posUL = 0;
+   ulong negUL = 0;
+   ulong lastBitsUL = rowUL % defMyersBlockBits;
+
+   if(posVAryUL == 0) return (long) rowUL; /*Gap column*/
+
+   for(
+      blockUL = 0;
+      blockUL < rowUL / defMyersBlockBits;
+      ++blockUL
+   ){ /*Loop: Add up each full block*/
+      posUL = posVAryUL[blockUL];
+      negUL = negVAryUL[blockUL];
+      needleMyersPopCnt(posUL, posCntL);
+      needleMyersPopCnt(negUL, negCntL);
+   } /*Loop: Add up each full block*/
+
+   if(lastBitsUL != 0)
+   { /*If: I have a partial block*/
+      posUL =
+           posVAryUL[blockUL]
+         & ((((ulong) 1) << lastBitsUL) - 1);
+
+      negUL =
+           negVAryUL[blockUL]
+         & ((((ulong) 1) << lastBitsUL) - 1);
+
+      needleMyersPopCnt(posUL, posCntL);
+      needleMyersPopCnt(negUL, negCntL);
+   } /*If: I have a partial block*/
+
+   return posCntL - negCntL;
+} /*needleMyersCol*/
+
+/*-------------------------------------------------------\
+| Fun-06: needleMyers
+|  - Does a Needleman alignment with the Myers bit-vector
+|    edit distance algorithm
+| Input:
+|  - qryST:
+|    o Pionter to seqStruct structure with query sequence
+|    o offsetUL; were to start query alignment, is index 0
+|    o endAlnUL; were to stop query alignment, is index 0
+|  - refST:
+|    o Pionter to seqStruct with reference sequence
+|    o offsetUL; were to start alignment on ref, index 0
+|    o endAlnUL; were to stop alignment on ref, is index 0
+|  - settings:
+|    o Point to alnSet structure with alignment settings
+|  - matchL:
+|    o Match score from needleMyersBl
+|  - snpL:
+|    o Mismatch score from needleMyersBl
+|  - scoreL:
+|    o Pointer to long to hold the Needleman score
+| Output:
+|  - Modifies:
+|    o scoreL to have the score of the alignment
+|  - Returns:
+|    o alnStruct with the alignment (same as
+|      dirMatrixToAln with NeedlemanAln)
+|    o 0 for memory allocation errors
+\-------------------------------------------------------*/
+static struct alnStruct * needleMyers(
+    struct seqStruct *qryST, /*query sequence and data*/
+    struct seqStruct *refST, /*ref sequence and data*/
+    struct alnSet *settings, /*Settings for alignment*/
+    long matchL,             /*Match score*/
+    long snpL,               /*Mismatch score*/
+    long *scoreL             /*Gets alignment score*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-06 TOC: needleMyers
+   '  - Does a Needleman alignment with the Myers
+   '    bit-vector edit distance algorithm
+   '  o fun-06 sec-01:
+   '    - Variable declerations
+   '  o fun-06 sec-02:
+   '    - Allocate memory and build the match profiles
+   '  o fun-06 sec-03:
+   '    - Find the vertical differences for each column
+   '  o fun-06 sec-04:
+   '    - Find the score and set up the alignment
+   '  o fun-06 sec-05:
+   '    - Trace back the alignment
+   '  o fun-06 sec-06:
+   '    - Add soft masking and clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-06 Sec-01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   char *qrySeqStr = qryST->seqCStr + qryST->offsetUL;
+   char *refSeqStr = refST->seqCStr + refST->offsetUL;
+   ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
+   ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
+
+   ulong numBlocksUL =
+      (lenQryUL + defMyersBlockBits - 1)
+      / defMyersBlockBits;
+
+   ulong profIndexAryUL[256]; /*Maps ref bases to eqAry*/
+   ulong numProfUL = 0;
+
+   ulong *eqAryUL = 0;   /*Query bases matching ref base*/
+   ulong *posVAryUL = 0; /*+1 vertical differences*/
+   ulong *negVAryUL = 0; /*-1 vertical differences*/
+   ulong *eqUL = 0;      /*Profile for current column*/
+   ulong *posColUL = 0;  /*+1 differences of a column*/
+   ulong *negColUL = 0;  /*-1 differences of a column*/
+
+   ulong ulBase = 0;
+   ulong ulRef = 0;
+   ulong blockUL = 0;
+   char hC = 0;          /*Horizontal difference*/
+
+   ulong qryPosUL = 0;   /*Row (index 1) on*/
+   ulong refPosUL = 0;   /*Column (index 1) on*/
+   ulong lastRefMatchSnpUL = 0;
+   ulong lastQryMatchSnpUL = 0;
+   ulong bitUL = 0;
+
+   long distL = 0;       /*Edit distance of current cell*/
+   long insDistL = 0;    /*Edit distance of cell above*/
+   long delDistL = 0;    /*Edit distance of cell to left*/
+   long snpDistL = 0;    /*Edit distance of diagonal*/
+   long indelDistL = 0;
+   char dirC = 0;
+
+   struct alnStruct *alnST = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-06 Sec-02:
+   ^  - Allocate memory and build the match profiles
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+      profIndexAryUL[ulBase] = 0;
+
+   for(ulRef = 0; ulRef < lenRefUL; ++ulRef)
+   { /*Loop: find the bases in the reference*/
+      if(profIndexAryUL[(uchar) refSeqStr[ulRef]] == 0)
+      { /*If: this is a new base*/
+         ++numProfUL;
+         profIndexAryUL[(uchar) refSeqStr[ulRef]] =
+            numProfUL;
+      } /*If: this is a new base*/
+   } /*Loop: find the bases in the reference*/
+
+   eqAryUL = calloc(numProfUL * numBlocksUL, sizeof(ulong));
+   if(eqAryUL == 0) return 0;
+
+   posVAryUL =
+      malloc(lenRefUL * numBlocksUL * sizeof(ulong));
+   if(posVAryUL == 0) goto memErr;
+
+   negVAryUL =
+      malloc(lenRefUL * numBlocksUL * sizeof(ulong));
+   if(negVAryUL == 0) goto memErr;
+
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+   { /*Loop: build the profile for each reference base*/
+      if(profIndexAryUL[ulBase] == 0) continue;
+
+      eqUL =
+           eqAryUL
+         + (profIndexAryUL[ulBase] - 1) * numBlocksUL;
+
+      for(ulRef = 0; ulRef < lenQryUL; ++ulRef)
+      { /*Loop: mark the matching query bases*/
+         if(
+               getBaseScore(
+                  qrySeqStr[ulRef],
+                  (char) ulBase,
+                  settings
+               )
+            == matchL
+         ) eqUL[ulRef / defMyersBlockBits] |=
+              ((ulong) 1) << (ulRef % defMyersBlockBits);
+      } /*Loop: mark the matching query bases*/
+   } /*Loop: build the profile for each reference base*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-06 Sec-03:
+   ^  - Find the vertical differences for each column
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*The gap column is D(i, 0) = i, so every vertical
+   ` difference is +1
+   */
+   for(blockUL = 0; blockUL < numBlocksUL; ++blockUL)
+   { /*Loop: set up the first column*/
+      posVAryUL[blockUL] = ~((ulong) 0);
+      negVAryUL[blockUL] = 0;
+   } /*Loop: set up the first column*/
+
+   for(ulRef = 0; ulRef < lenRefUL; ++ulRef)
+   { /*Loop: score each column*/
+      eqUL =
+           eqAryUL
+         +   (profIndexAryUL[(uchar) refSeqStr[ulRef]] - 1)
+           * numBlocksUL;
+
+      posColUL = posVAryUL + ulRef * numBlocksUL;
+      negColUL = negVAryUL + ulRef * numBlocksUL;
+
+      if(ulRef > 0)
+      { /*If: start from the last column*/
+         for(blockUL = 0; blockUL < numBlocksUL; ++blockUL)
+         { /*Loop: copy the last column*/
+            posColUL[blockUL] =
+               posColUL[blockUL - numBlocksUL];
+            negColUL[blockUL] =
+               negColUL[blockUL - numBlocksUL];
+         } /*Loop: copy the last column*/
+      } /*If: start from the last column*/
+
+      hC = 1; /*The gap row goes up by one each column*/
+
+      for(blockUL = 0; blockUL < numBlocksUL; ++blockUL)
+         hC =
+            needleMyersBlock(
+               &posColUL[blockUL],
+               &negColUL[blockUL],
+               eqUL[blockUL],
+               hC
+            );
+   } /*Loop: score each column*/
+
+   free(eqAryUL);
+   eqAryUL = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-06 Sec-04:
+   ^  - Find the score and set up the alignment
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   distL =
+      needleMyersCol(
+         posVAryUL + (lenRefUL - 1) * numBlocksUL,
+         negVAryUL + (lenRefUL - 1) * numBlocksUL,
+         lenRefUL,
+         lenQryUL
+      );
+
+   *scoreL =
+      (
+           matchL * (long) (lenQryUL + lenRefUL)
+         - 2 * (matchL - snpL) * distL
+      ) / 2;
+
+   alnST = calloc(1, sizeof(struct alnStruct));
+   if(alnST == 0) goto memErr;
+
+   alnST->refAlnStr =
+      calloc(refST->lenSeqUL + 1, sizeof(char));
+
+   if(alnST->refAlnStr == 0) goto memErr;
+
+   alnST->qryAlnStr =
+      calloc(qryST->lenSeqUL + 1, sizeof(char));
+
+   if(alnST->qryAlnStr == 0) goto memErr;
+
+   alnST->refLenUL = refST->lenSeqUL;
+   alnST->qryLenUL = qryST->lenSeqUL;
+
+   alnST->refEndAlnUL = refST->endAlnUL;
+   alnST->qryEndAlnUL = qryST->endAlnUL;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-06 Sec-05:
+   ^  - Trace back the alignment
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   qryPosUL = lenQryUL;
+   refPosUL = lenRefUL;
+
+   while(qryPosUL > 0 || refPosUL > 0)
+   { /*Loop: trace back the alignment*/
+      if(qryPosUL == 0) dirC = defMvDel;
+      else if(refPosUL == 0) dirC = defMvIns;
+
+      else
+      { /*Else: find the direction NeedlemanAln had*/
+         posColUL = posVAryUL + (refPosUL-1) * numBlocksUL;
+         negColUL = negVAryUL + (refPosUL-1) * numBlocksUL;
+
+         blockUL = (qryPosUL - 1) / defMyersBlockBits;
+         bitUL =
+              ((ulong) 1)
+           << ((qryPosUL - 1) % defMyersBlockBits);
+
+         insDistL = distL;
+         if(posColUL[blockUL] & bitUL) --insDistL;
+         else if(negColUL[blockUL] & bitUL) ++insDistL;
+
+         if(refPosUL > 1)
+         { /*If: the cell to the left is not a gap*/
+            posColUL -= numBlocksUL;
+            negColUL -= numBlocksUL;
+         } /*If: the cell to the left is not a gap*/
+
+         else
+         { /*Else: the cell to the left is the gap column*/
+            posColUL = 0;
+            negColUL = 0;
+         } /*Else: the cell to the left is the gap column*/
+
+         snpDistL =
+            needleMyersCol(
+               posColUL,
+               negColUL,
+               refPosUL - 1,
+               qryPosUL - 1
+            );
+
+         delDistL = snpDistL;
+
+         if(posColUL == 0) ++delDistL; /*Gap column*/
+         else if(posColUL[blockUL] & bitUL) ++delDistL;
+         else if(negColUL[blockUL] & bitUL) --delDistL;
+
+         /*Deletions win ties with insertions and snps
+         ` have to be better than both (delInsSnp)
+         */
+         if(insDistL < delDistL)
+         { /*If: an insertion is better*/
+            dirC = defMvIns;
+            indelDistL = insDistL;
+         } /*If: an insertion is better*/
+
+         else
+         { /*Else: a deletion is better*/
+            dirC = defMvDel;
+            indelDistL = delDistL;
+         } /*Else: a deletion is better*/
+
+         if(
+              snpDistL
+            + (
+                 getBaseScore(
+                    qrySeqStr[qryPosUL - 1],
+                    refSeqStr[refPosUL - 1],
+                    settings
+                 ) != matchL
+              )
+            < indelDistL + 1
+         ) dirC = defMvSnp; /*Gaps cost one more*/
+      } /*Else: find the direction NeedlemanAln had*/
+
+      switch(dirC)
+      { /*Switch: check if bases is gap, match, or snp*/
+         case defMvIns:
+         /*Case: insertion (defMvIns)*/
+            alnST->qryAlnStr[
+               qryST->offsetUL + qryPosUL - 1
+            ] = defGapFlag;
+
+            ++(alnST->numInssUL);
+            distL = insDistL;
+            --qryPosUL;
+            break;
+         /*Case: insertion (defMvIns)*/
+
+         case defMvSnp:
+         /*Case: match/snp (defMvSnp)*/
+            lastRefMatchSnpUL = refPosUL - 1;
+            lastQryMatchSnpUL = qryPosUL - 1;
+
+            if(
+               matchOrSnp(
+                  qrySeqStr[qryPosUL - 1],
+                  refSeqStr[refPosUL - 1],
+                  settings
+               )
+            ){ /*If the bases were a match*/
+               alnST->qryAlnStr[
+                  qryST->offsetUL + qryPosUL - 1
+               ] = defMatchFlag;
+
+               alnST->refAlnStr[
+                  refST->offsetUL + refPosUL - 1
+               ] = defMatchFlag;
+
+               ++(alnST->numMatchesUL);
+            } /*If the bases were a match*/
+
+            else
+            { /*Else was a SNP*/
+               alnST->qryAlnStr[
+                  qryST->offsetUL + qryPosUL - 1
+               ] = defSnpFlag;
+
+               alnST->refAlnStr[
+                  refST->offsetUL + refPosUL - 1
+               ] = defSnpFlag;
+
+               ++(alnST->numSnpsUL);
+            } /*Else was a SNP*/
+
+            distL = snpDistL;
+            --qryPosUL;
+            --refPosUL;
+            break;
+         /*Case: match/snp (defMvSnp)*/
+
+         case defMvDel:
+         /*Case: deletion (defMvDel)*/
+            alnST->refAlnStr[
+               refST->offsetUL + refPosUL - 1
+            ] = defGapFlag;
+
+            ++(alnST->numDelsUL);
+            distL = delDistL;
+            --refPosUL;
+            break;
+         /*Case: deletion (defMvDel)*/
+      } /*Switch: check if bases is gap, match, or snp*/
+
+      ++(alnST->lenAlnUL);
+   } /*Loop: trace back the alignment*/
+
+   free(posVAryUL);
+   posVAryUL = 0;
+
+   free(negVAryUL);
+   negVAryUL = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-06 Sec-06:
+   ^  - Add soft masking and clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   alnST->refStartAlnUL =
+      lastRefMatchSnpUL + refST->offsetUL;
+   alnST->qryStartAlnUL =
+      lastQryMatchSnpUL + qryST->offsetUL;
+
+   /*Everything before and after the aligned region is
+   ` soft masked (calloc set them to 0)
+   */
+   for(ulBase = 0; ulBase < alnST->refLenUL; ++ulBase)
+   { /*Loop: soft mask the unaligned reference bases*/
+      if(alnST->refAlnStr[ulBase] == 0)
+         alnST->refAlnStr[ulBase] = defSoftMaskFlag;
+   } /*Loop: soft mask the unaligned reference bases*/
+
+   for(ulBase = 0; ulBase < alnST->qryLenUL; ++ulBase)
+   { /*Loop: soft mask the unaligned query bases*/
+      if(alnST->qryAlnStr[ulBase] == 0)
+         alnST->qryAlnStr[ulBase] = defSoftMaskFlag;
+   } /*Loop: soft mask the unaligned query bases*/
+
+   alnST->refAlnStr[alnST->refLenUL] = defEndAlnFlag;
+   alnST->qryAlnStr[alnST->qryLenUL] = defEndAlnFlag;
+
+   return alnST;
+
+   memErr:
+
+   free(eqAryUL);
+   free(posVAryUL);
+   free(negVAryUL);
+   freeAlnST(alnST);
+   return 0;
+} /*needleMyers*/
+
+#endif
@@ -81,6 +81,7 @@ static struct alnMatrix * NeedleAlnNoGap(
    /*Get start & end of query & reference sequences*/
    char *refSeqStr = refST->seqCStr + refST->offsetUL;
    char *qrySeqStr = qryST->seqCStr + qryST->offsetUL;
+   char *profRowC = 0; /*Scores for a query base*/
 
    /*Find the length of the reference and query. The +1
    ` is to account for offsetUL being index 0
@@ -109,6 +110,17 @@ static struct alnMatrix * NeedleAlnNoGap(
    ^  - Allocate memory for alignment
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         qryST->endAlnUL - qryST->offsetUL + 1,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
    retMatrixST = malloc(sizeof(struct alnMatrix));
    if(retMatrixST == 0) return 0;
    initAlnMatrix(retMatrixST);
@@ -184,7 +196,7 @@ static struct alnMatrix * NeedleAlnNoGap(
    /*Fill in the current indel column for this row*/
    scoreAryL[0] = settings->gapOpenC;
    dirMatrix[0] = defMvIns;
-   delScoreL = settings->gapOpenC;
+   delScoreL = scoreAryL[0] + settings->gapOpenC;
 
    /*****************************************************\
    * Fun-01 Sec-04 Sub-02:
@@ -197,6 +209,12 @@ static struct alnMatrix * NeedleAlnNoGap(
       ulQry < qryST->endAlnUL - qryST->offsetUL + 1;
       ++ulQry
    ){ /*loop; fill the direction matrix with socres*/
+      profRowC =
+         getScoreProfRow(
+            qrySeqStr[ulQry],
+            refSeqStr,
+            settings
+         ); /*Scores for this query base*/
 
        for(
           ulRef = 1;
@@ -204,8 +222,7 @@ static struct alnMatrix * NeedleAlnNoGap(
           ++ulRef
        ){ /*Loop: compare 1 query to all reference bases*/
           needleMaxScoreNoGap(
-             refSeqStr[ulRef],
-             qrySeqStr[ulQry],
+             profRowC[ulRef],
              scoreAryL[ulRef],
              dirMatrix[ulRef],
              insDir[ulRef],
@@ -221,8 +238,7 @@ static struct alnMatrix * NeedleAlnNoGap(
        **************************************************/
 
        needleMaxEndRowScoreNoGap(
-          refSeqStr[ulRef],
-          qrySeqStr[ulQry],
+          profRowC[ulRef],
           scoreAryL[ulRef],
           dirMatrix[ulRef],
           insDir[ulRef],
@@ -241,8 +257,8 @@ static struct alnMatrix * NeedleAlnNoGap(
        dirMatrix[0] = defMvIns;
 
        nextSnpScoreL = scoreAryL[0];
-       scoreAryL[0] += settings->gapExtendC;
-       delScoreL = scoreAryL[0] + settings->gapExtendC;
+       scoreAryL[0] += settings->gapOpenC;
+       delScoreL = scoreAryL[0] + settings->gapOpenC;
    } /*loop; fill the direction matrix with socres*/
 
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
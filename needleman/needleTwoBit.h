@@ -14,6 +14,7 @@
 #   o "../general/base10StrToNum.h"    (No .c file)
 #   o "../general/alnSeqDefaults.h"    (No .c file)
 #   - "../general/seqStruct.h"         (No .c file)
+#   - "../general/alnScratch.h"        (No .c file)
 # C Standard libraries:
 #   o <stdlib.h>
 #   o <stdint.h>
@@ -22,7 +23,11 @@
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
 ' SOH: Start Of Header
-'  - fun-01 NeedleManWunschAln:
+'  - fun-01 NeedleTwoBitScratch:
+'    o Perform a Needleman-Wunsch alignment on the two
+'      input sequences with two bit arrays and the score
+'      row from an arena
+'  - fun-02 NeedleTwoBit:
 '    o Perform a Needleman-Wunsch alignment on the two
 '      input sequences with two bit arrays
 \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
@@ -34,11 +39,12 @@
 #include "../general/alnMatrixStruct.h"
 #include "../general/seqStruct.h"
 #include "../general/alnSetStruct.h"
+#include "../general/alnScratch.h"
 
 /*-------------------------------------------------------\
-| Fun-01: NeedleTwoBit
+| Fun-01: NeedleTwoBitScratch
 |  - Perform a Needleman-Wunsch alignment on the two input
-|    sequences
+|    sequences. The score row is taken from an arena.
 | Input:
 |  - qryST:
 |    o Pionter to seqStruct structure with query sequence 
@@ -50,17 +56,25 @@
 |    o endAlnUL; were to stop alignment on ref, is index 0
 |  - alnSet:
 |    o Point to alnSet structure with alignment settings
+|  - scratchST:
+|    o alnScratch structure (arena) to get the score row
+|      from. This is reset first, so memory from earlier
+|      calls is no longer valid.
 | Output:
+|  - Modifies:
+|    o scratchST to hold the score row
 |  - Returns:
 |    o alnMatrixStruct with the direction matrix & scores
+|      (the direction matrix is not in scratchST)
 |    o 0 for memory allocation errors
 \-------------------------------------------------------*/
-static struct alnMatrixTwoBit * NeedleTwoBit(
+static struct alnMatrixTwoBit * NeedleTwoBitScratch(
     struct seqStruct *qryST, /*query sequence and data*/
     struct seqStruct *refST, /*ref sequence and data*/
-    struct alnSet *settings  /*Settings for alignment*/
+    struct alnSet *settings, /*Settings for alignment*/
+    struct alnScratch *scratchST /*Arena for score row*/
 ){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
-   ' Fun-01 TOC: NeedleTwoBit
+   ' Fun-01 TOC: NeedleTwoBitScratch
    '  - Perform a Needleman-Wunsch alignment on the two
    '    input sequences using two bit arrays
    '  o fun-01 sec-01:
@@ -81,6 +95,7 @@ static struct alnMatrixTwoBit * NeedleTwoBit(
    /*Get start & end of query & reference sequences*/
    char *refSeqStr = refST->seqCStr + refST->offsetUL;
    char *qrySeqStr = qryST->seqCStr + qryST->offsetUL;
+   char *profRowC = 0; /*Scores for a query base*/
 
    /*Find the length of the reference and query. The +1
    ` is to account for offsetUL being index 0
@@ -115,6 +130,17 @@ static struct alnMatrixTwoBit * NeedleTwoBit(
    ^  - Allocate memory for alignment
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         qryST->endAlnUL - qryST->offsetUL + 1,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
    retMatrixST = malloc(sizeof(struct alnMatrixTwoBit));
    if(retMatrixST == 0) return 0;
    initAlnMatrixTwoBit(retMatrixST);
@@ -129,12 +155,16 @@ static struct alnMatrixTwoBit * NeedleTwoBit(
 
    retMatrixST->dirMatrix = dirMatrix;
 
-   scoreAryL = malloc((lenRefUL + 1) * sizeof(long));
+   /*Rows from the last alignment are no longer needed*/
+   resetAlnScratch(scratchST);
+
+   scoreAryL =
+      getAlnScratch(scratchST,(lenRefUL + 1)*sizeof(long));
       /*+ 1 is for the indel column*/
 
    if(scoreAryL == 0)
    { /*If: I had a memory error*/
-     freeAlnMatrix(retMatrixST);
+     freeAlnMatrixTwoBit(retMatrixST);
      return 0;
    } /*If: I had a memory error*/
 
@@ -210,6 +240,12 @@ static struct alnMatrixTwoBit * NeedleTwoBit(
       ulQry < qryST->endAlnUL - qryST->offsetUL + 1;
       ++ulQry
    ){ /*loop; fill the direction matrix with socres*/
+      profRowC =
+         getScoreProfRow(
+            qrySeqStr[ulQry],
+            refSeqStr,
+            settings
+         ); /*Scores for this query base*/
 
        for(
           ulRef = 1;
@@ -217,8 +253,7 @@ static struct alnMatrixTwoBit * NeedleTwoBit(
           ++ulRef
        ){ /*Loop: compare 1 query to all reference bases*/
           needleMaxScore(
-             refSeqStr[ulRef],
-             qrySeqStr[ulQry],
+             profRowC[ulRef],
              gapDiffS,
              scoreAryL[ulRef],
              dirUC,
@@ -239,8 +274,7 @@ static struct alnMatrixTwoBit * NeedleTwoBit(
        **************************************************/
 
        needleMaxEndRowScore(
-          refSeqStr[ulRef],
-          qrySeqStr[ulQry],
+          profRowC[ulRef],
           gapDiffS,
           scoreAryL[ulRef],
           dirUC,
@@ -284,10 +318,46 @@ static struct alnMatrixTwoBit * NeedleTwoBit(
       twoBitGetIndex(dirMatrix);
 
    /*Clean UP*/
-   free(scoreAryL);
-   scoreAryL = 0;
+   scoreAryL = 0; /*Kept in scratchST for the next call*/
+
+   return retMatrixST;
+} /*NeedleTwoBitScratch*/
+
+/*-------------------------------------------------------\
+| Fun-02: NeedleTwoBit
+|  - Perform a Needleman-Wunsch alignment on the two input
+|    sequences (uses a temporary arena)
+| Input:
+|  - qryST:
+|    o Pionter to seqStruct structure with query sequence 
+|    o offsetUL; were to start query alignment, is index 0
+|    o endAlnUL; were to stop query alignment, is index 0
+|  - refST:
+|    o Pionter to seqStruct with reference sequence 
+|    o offsetUL; were to start alignment on ref, index 0
+|    o endAlnUL; were to stop alignment on ref, is index 0
+|  - alnSet:
+|    o Point to alnSet structure with alignment settings
+| Output:
+|  - Returns:
+|    o alnMatrixStruct with the direction matrix & scores
+|    o 0 for memory allocation errors
+\-------------------------------------------------------*/
+static struct alnMatrixTwoBit * NeedleTwoBit(
+    struct seqStruct *qryST, /*query sequence and data*/
+    struct seqStruct *refST, /*ref sequence and data*/
+    struct alnSet *settings  /*Settings for alignment*/
+){
+   struct alnScratch scratchST;
+   struct alnMatrixTwoBit *retMatrixST = 0;
+
+   initAlnScratch(&scratchST);
+
+   retMatrixST =
+      NeedleTwoBitScratch(qryST,refST,settings,&scratchST);
 
+   freeAlnScratchStack(&scratchST);
    return retMatrixST;
-} /*NeeldeTwoBit*/
+} /*NeedleTwoBit*/
 
 #endif
@@ -85,6 +85,7 @@ static struct alnMatrixTwoBit * NeedleTwoBitNoGap(
    /*Get start & end of query & reference sequences*/
    char *refSeqStr = refST->seqCStr + refST->offsetUL;
    char *qrySeqStr = qryST->seqCStr + qryST->offsetUL;
+   char *profRowC = 0; /*Scores for a query base*/
 
    /*Find the length of the reference and query. The +1
    ` is to account for offsetUL being index 0
@@ -115,6 +116,17 @@ static struct alnMatrixTwoBit * NeedleTwoBitNoGap(
    ^  - Allocate memory for alignment
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         qryST->endAlnUL - qryST->offsetUL + 1,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
    retMatrixST = malloc(sizeof(struct alnMatrixTwoBit));
    if(retMatrixST == 0) return 0;
    initAlnMatrixTwoBit(retMatrixST);
@@ -210,6 +222,12 @@ static struct alnMatrixTwoBit * NeedleTwoBitNoGap(
       ulQry < qryST->endAlnUL - qryST->offsetUL + 1;
       ++ulQry
    ){ /*loop; fill the direction matrix with socres*/
+      profRowC =
+         getScoreProfRow(
+            qrySeqStr[ulQry],
+            refSeqStr,
+            settings
+         ); /*Scores for this query base*/
 
        for(
           ulRef = 1;
@@ -217,8 +235,7 @@ static struct alnMatrixTwoBit * NeedleTwoBitNoGap(
           ++ulRef
        ){ /*Loop: compare 1 query to all reference bases*/
           needleMaxScoreNoGap(
-             refSeqStr[ulRef],
-             qrySeqStr[ulQry],
+             profRowC[ulRef],
              scoreAryL[ulRef],
              dirUC,
              getTwoBitElm(&insDir),
@@ -238,8 +255,7 @@ static struct alnMatrixTwoBit * NeedleTwoBitNoGap(
        **************************************************/
 
        needleMaxEndRowScoreNoGap(
-          refSeqStr[ulRef],
-          qrySeqStr[ulQry],
+          profRowC[ulRef],
           scoreAryL[ulRef],
           dirUC,
           getTwoBitElm(&insDir),
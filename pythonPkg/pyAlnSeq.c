@@ -30,6 +30,7 @@
 
 #include "../memWater/memWater.h"
 #include "../memWater/memWaterNoGap.h"
+#include "../vectDispatch/vectDispatch.h"
 
 #include "../needleman/needleman.h"
 #include "../needleman/needleNoGap.h"
@@ -286,6 +287,7 @@ static PyObject * alnSeqHirsch(
 
    lookupIndexToSeq(qryST.seqCStr);
    lookupIndexToSeq(refST.seqCStr);
+   freeAlnSetStack(&settings); /*Score profile rows*/
 
    if(alnST == 0)
    { /*If: Had a memory error*/
@@ -558,13 +560,14 @@ static PyObject * alnSeqMemWater(
    seqToLookupIndex(refST.seqCStr);
    seqToLookupIndex(qryST.seqCStr);
 
-   if(settings.noGapBl)
-      matrixST = memWaterNoGap(&qryST, &refST, &settings);
-   else
-      matrixST = memWater(&qryST, &refST, &settings);
+   /*Uses vectors when the cpu has them (setup.py builds
+   ` the SSE2, SSE4, and AVX2 kernels on x86)
+   */
+   matrixST = memWaterDispatch(&qryST, &refST, &settings);
 
    lookupIndexToSeq(refST.seqCStr);
    lookupIndexToSeq(qryST.seqCStr);
+   freeAlnSetStack(&settings); /*Score profile rows*/
 
    if(matrixST == 0)
    { /*If: Had a memory error*/
@@ -845,6 +848,7 @@ static PyObject * alnSeqNeedle(
 
    lookupIndexToSeq(refST.seqCStr);
    lookupIndexToSeq(qryST.seqCStr);
+   freeAlnSetStack(&settings); /*Score profile rows*/
 
    if(alnMtrxST == 0 && alnMtrxTBST == 0)
    { /*If: Had a memory error*/
@@ -1180,6 +1184,7 @@ static PyObject * alnSeqWater(
 
    lookupIndexToSeq(refST.seqCStr);
    lookupIndexToSeq(qryST.seqCStr);
+   freeAlnSetStack(&settings); /*Score profile rows*/
 
    if(alnMtrxST == 0 && alnMtrxTBST == 0)
    { /*If: Had a memory error*/
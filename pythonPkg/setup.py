@@ -4,8 +4,12 @@
 #  CC=cc python3 setup.py build
 #  pip install -e .
 
+import os
+import platform
+
 from setuptools import setup
 from setuptools import Extension
+from setuptools.command.build_ext import build_ext
 
 descriptionStr="\
    Neeldeman Wunsch, Waterman Smith, and Hirschberg\
@@ -23,6 +27,42 @@ compileFlags = [
    "-static",
    "-Wno-unused-function"
 ]
+
+# Vector kernels for run time dispatch (x86 only). Each
+# set is compiled on its own, so it needs its own flags.
+vectKernelStr = os.path.abspath(
+   "../vectDispatch/vectDispatchKernels.c"
+); # Absolute, so the object files stay in build/
+
+vectSetsAry = [
+   ("SSE2", []),
+   ("SSE4", ["-msse4.1"]),
+   ("AVX2", ["-mavx2"])
+]; # (-D flag, extra compiler flags)
+
+class buildDispatch(build_ext):
+   """Compiles the vector kernels for each set before
+      building pyAlnSeq.c with -DVECTDISPATCH
+   """
+   def build_extensions(self):
+      if(platform.machine().lower() in ("x86_64", "amd64")):
+         for ext in self.extensions:
+            for setStr, flagsAry in vectSetsAry:
+               ext.extra_objects += self.compiler.compile(
+                  [vectKernelStr],
+                  output_dir =
+                     os.path.join(self.build_temp, setStr),
+                  macros = [(setStr, None)],
+                  extra_postargs = compileFlags + flagsAry
+               ); # Compile this sets kernels
+            # Loop: compile the kernels for each set
+
+            ext.define_macros.append(("VECTDISPATCH", None));
+         # Loop: add the kernels to each extension
+      # If: this is a x86 cpu
+
+      build_ext.build_extensions(self);
+
 setup(
    name = "alnSeq",
    version = "20231222",
@@ -33,5 +73,6 @@ setup(
          "alnSeq",
          srcFilesStr,
          extra_compile_args = compileFlags
-   )]
+   )],
+   cmdclass = {"build_ext": buildDispatch}
 );
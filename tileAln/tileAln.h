@@ -0,0 +1,937 @@
+/*########################################################
+# Name: tileAln
+# Use:
+#  - Holds functions for doing a Needleman or Waterman
+#    alignment (full direction matrix) with more than one
+#    thread (-threads)
+#  - The matrix is split into tiles of about
+#    defTileAlnLen by defTileAlnLen cells. Tiles on the
+#    same anti-diagonal do not depend on each other, so
+#    each anti-diagonal (wave) of tiles is scored at the
+#    same time. A wave is started after the last wave
+#    finished.
+#  - Tiles only get scores and directions from the last
+#    row of the tile above and the last column of the
+#    tile to the left (boundary arrays). The direction
+#    matrix is only written to, so the byte and two bit
+#    direction matrixes can both be used.
+# Libraries:
+#  - "../needleman/genNeedle.h"       (No .c file)
+#  - "../needleman/genNeedleNoGap.h"  (No .c file)
+#  - "../waterman/genWater.h"         (No .c file)
+#  - "../waterman/genWaterNoGap.h"    (No .c file)
+#  - "../general/threadPool.h"        (No .c file)
+#  - "../general/alnMatrixStruct.h"   (No .c file)
+#  - "../general/seqStruct.h"         (No .c file)
+#  - "../general/alnSetStruct.h"      (No .c file)
+#  o "../general/genAln.h"            (No .c file)
+#  o "../general/genMath.h"           (No .c file)
+#  o "../general/twoBitArrays.h"      (No .c file)
+#  o "../general/dataTypeShortHand.h" (No .c file)
+#  o "../general/base10StrToNum.h"    (No .c file)
+#  o "../general/alnSeqDefaults.h"    (No .c file)
+# C Standard libraries:
+#  o <stdlib.h>
+#  o <stdio.h>
+#  o <pthread.h> (POSIX, not C standard)
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Includes, definitions, and structures
+'  o fun-01 tileAlnFill:
+'    - Scores one tile and writes its directions (pool
+'      task)
+'  o fun-02 tileAlnRun:
+'    - Sets up the edges and boundary arrays, then scores
+'      every tile one wave at a time
+'  o fun-03 tileAln:
+'    - Does a threaded Needleman or Waterman alignment
+'      into a byte direction matrix
+'  o fun-04 tileAlnTwoBit:
+'    - Does a threaded Needleman or Waterman alignment
+'      into a two bit direction matrix
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes, definitions, and structures
+\-------------------------------------------------------*/
+
+#ifndef TILE_ALN_H
+#define TILE_ALN_H
+
+#include <stdlib.h>
+#include "../needleman/genNeedle.h"
+#include "../needleman/genNeedleNoGap.h"
+#include "../waterman/genWater.h"
+#include "../waterman/genWaterNoGap.h"
+#include "../general/threadPool.h"
+#include "../general/alnMatrixStruct.h"
+#include "../general/seqStruct.h"
+#include "../general/alnSetStruct.h"
+
+#define defTileAlnLen 512
+   /*Number of reference and query bases in one tile.
+   ` Smaller tiles give more tiles per wave, but spend
+   ` more time waiting on the other tiles in the wave.
+   */
+
+/*-------------------------------------------------------\
+| Struct-01: tileAlnPiece
+|  - Input and output for scoring one tile
+\-------------------------------------------------------*/
+struct tileAlnPiece{
+   char *refSeqStr;  /*Base before 1st aligned ref base*/
+   char *qrySeqStr;  /*1st aligned query base*/
+   ulong lenRefUL;   /*Reference bases (row is + 1)*/
+
+   ulong refStartUL; /*1st column in tile (index 1)*/
+   ulong refEndUL;   /*Last column in tile (index 1)*/
+   ulong qryStartUL; /*1st row in tile (index 1)*/
+   ulong qryEndUL;   /*Last row in tile (index 1)*/
+
+   long *rowScoreL;  /*Scores in last row scored*/
+   char *rowDirC;    /*Directions in last row scored*/
+   long *colScoreL;  /*Scores in last column scored*/
+   char *colDirC;    /*Directions in last column scored*/
+   long *cornerL;    /*Score up and left of the tile*/
+
+   char *dirMatrix;            /*Byte direction matrix*/
+   struct twoBitAry *twoBitST; /*Or two bit matrix*/
+
+   char needleBl;    /*1: Needleman; 0: Waterman*/
+   long bestScoreL;  /*Best Waterman score in tile*/
+   ulong bestIndexUL;/*Index of bestScoreL*/
+
+   struct alnSet *settings; /*Settings for alignment*/
+};
+
+/*-------------------------------------------------------\
+| Fun-01: tileAlnFill
+|  - Scores one tile and writes its directions to the
+|    direction matrix. This is run as a pool task.
+| Input:
+|  - pieceST:
+|    o Pointer to a tileAlnPiece with the tile to score.
+|      The tiles above and to the left must be done.
+| Output:
+|  - Modifies:
+|    o rowScoreL and rowDirC in pieceST to have the
+|      last row of the tile (for the tile below)
+|    o colScoreL and colDirC in pieceST to have the
+|      last column of the tile (for the tile to the
+|      right)
+|    o cornerL in pieceST to have the score up and left
+|      of the tile to the right
+|    o dirMatrix or twoBitST in pieceST to have the
+|      directions for the tile
+|    o bestScoreL and bestIndexUL in pieceST to have
+|      the first best score (Waterman only)
+\-------------------------------------------------------*/
+static void tileAlnFill(
+   void *pieceST /*tileAlnPiece to score*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-01 TOC: tileAlnFill
+   '  - Scores one tile and writes its directions
+   '  o fun-01 sec-01:
+   '    - Variable declerations
+   '  o fun-01 sec-02:
+   '    - Score the tile one row at a time
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-01 Sec-01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   struct tileAlnPiece *pST =
+      (struct tileAlnPiece *) pieceST;
+   struct alnSet *settings = pST->settings;
+
+   char *profRowC = 0;  /*Scores for a query base*/
+   long *scoreAryL = pST->rowScoreL;
+   char *dirRowC = pST->rowDirC;
+
+   /*Kept out of pST, so the compiler does not reload
+   ` them after each direction is stored
+   */
+   ulong refStartUL = pST->refStartUL;
+   ulong refEndUL = pST->refEndUL;
+   char *dirMatrix = pST->dirMatrix;
+
+   ulong ulRef = 0;
+   ulong ulQry = 0;
+   ulong rowIndexUL = 0; /*Index of column 0 in the row*/
+
+   long nextSnpScoreL = 0;
+   long delScoreL = 0;
+   long leftScoreL = 0;  /*Score left of this row*/
+
+   long bestScoreL = 0;  /*Best Waterman score in tile*/
+   ulong bestIndexUL = 0;
+
+   long scoreL = 0;      /*Score of the cell on*/
+   char dirC = 0;        /*Direction of the cell on*/
+   char noGapBl = settings->noGapBl;
+
+   short gapDiffS =
+      settings->gapExtendC - settings->gapOpenC;
+
+   struct twoBitAry twoBitST; /*Position in two bit*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-01 Sec-02:
+   ^  - Score the tile one row at a time
+   ^  o fun-01 sec-02 sub-01:
+   ^    - Get the scores to the left of the row
+   ^  o fun-01 sec-02 sub-02:
+   ^    - Score the row
+   ^  o fun-01 sec-02 sub-03:
+   ^    - Save the last column and the directions
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*The score above the last column is the snp score for
+   ` the first row in the tile to the right
+   */
+   nextSnpScoreL = *pST->cornerL;
+   *pST->cornerL = scoreAryL[refEndUL];
+
+   for(
+      ulQry = pST->qryStartUL;
+      ulQry <= pST->qryEndUL;
+      ++ulQry
+   ){ /*Loop: score each row in the tile*/
+
+      /**************************************************\
+      * Fun-01 Sec-02 Sub-01:
+      *  - Get the scores to the left of the row
+      \**************************************************/
+
+      profRowC =
+         getScoreProfRow(
+            pST->qrySeqStr[ulQry - 1],
+            pST->refSeqStr,
+            settings
+         ); /*Scores for this query base*/
+
+      rowIndexUL = ulQry * (pST->lenRefUL + 1);
+      leftScoreL = pST->colScoreL[ulQry];
+      delScoreL = leftScoreL + settings->gapOpenC;
+
+      if(
+            ! noGapBl
+         && pST->colDirC[ulQry] != defMvSnp
+      ) delScoreL += gapDiffS;
+
+      /**************************************************\
+      * Fun-01 Sec-02 Sub-02:
+      *  - Score the row
+      \**************************************************/
+
+      /*The above direction (dirRowC) is the insertion
+      ` direction, so it is both input and output. The
+      ` cell is scored in scoreL and dirC, so the compiler
+      ` can keep it in registers.
+      */
+      if(pST->needleBl && noGapBl)
+      { /*If: Needleman without gap extension*/
+         for(
+            ulRef = refStartUL;
+            ulRef <= refEndUL;
+            ++ulRef
+         ){ /*Loop: score each base in the row*/
+            scoreL = scoreAryL[ulRef];
+            dirC = dirRowC[ulRef];
+
+            needleMaxScoreNoGap(
+               profRowC[ulRef],
+               scoreL,
+               dirC,
+               dirC,
+               nextSnpScoreL,
+               delScoreL,
+               settings
+            );
+
+            scoreAryL[ulRef] = scoreL;
+            dirRowC[ulRef] = dirC;
+         } /*Loop: score each base in the row*/
+      } /*If: Needleman without gap extension*/
+
+      else if(pST->needleBl)
+      { /*Else If: Needleman alignment*/
+         for(
+            ulRef = refStartUL;
+            ulRef <= refEndUL;
+            ++ulRef
+         ){ /*Loop: score each base in the row*/
+            scoreL = scoreAryL[ulRef];
+            dirC = dirRowC[ulRef];
+
+            needleMaxScore(
+               profRowC[ulRef],
+               gapDiffS,
+               scoreL,
+               dirC,
+               dirC,
+               nextSnpScoreL,
+               delScoreL,
+               settings
+            );
+
+            scoreAryL[ulRef] = scoreL;
+            dirRowC[ulRef] = dirC;
+         } /*Loop: score each base in the row*/
+      } /*Else If: Needleman alignment*/
+
+      else if(noGapBl)
+      { /*Else If: Waterman without gap extension*/
+         for(
+            ulRef = refStartUL;
+            ulRef <= refEndUL;
+            ++ulRef
+         ){ /*Loop: score each base in the row*/
+            scoreL = scoreAryL[ulRef];
+            dirC = dirRowC[ulRef];
+
+            waterMaxScoreNoGap(
+               profRowC[ulRef],
+               scoreL,
+               dirC,
+               dirC,
+               nextSnpScoreL,
+               delScoreL,
+               settings
+            );
+
+            scoreAryL[ulRef] = scoreL;
+            dirRowC[ulRef] = dirC;
+
+            /*Same check as WatermanAln, so the first best
+            ` score (by index) in the tile is kept
+            */
+            if(bestScoreL < scoreL)
+            { /*If: have a new best score*/
+               bestScoreL = scoreL;
+               bestIndexUL = rowIndexUL + ulRef;
+            } /*If: have a new best score*/
+         } /*Loop: score each base in the row*/
+      } /*Else If: Waterman without gap extension*/
+
+      else
+      { /*Else: Waterman alignment*/
+         for(
+            ulRef = refStartUL;
+            ulRef <= refEndUL;
+            ++ulRef
+         ){ /*Loop: score each base in the row*/
+            scoreL = scoreAryL[ulRef];
+            dirC = dirRowC[ulRef];
+
+            waterMaxScore(
+               profRowC[ulRef],
+               gapDiffS,
+               scoreL,
+               dirC,
+               dirC,
+               nextSnpScoreL,
+               delScoreL,
+               settings
+            );
+
+            scoreAryL[ulRef] = scoreL;
+            dirRowC[ulRef] = dirC;
+
+            /*Same check as WatermanAln, so the first best
+            ` score (by index) in the tile is kept
+            */
+            if(bestScoreL < scoreL)
+            { /*If: have a new best score*/
+               bestScoreL = scoreL;
+               bestIndexUL = rowIndexUL + ulRef;
+            } /*If: have a new best score*/
+         } /*Loop: score each base in the row*/
+      } /*Else: Waterman alignment*/
+
+      /**************************************************\
+      * Fun-01 Sec-02 Sub-03:
+      *  - Save the last column and the directions
+      \**************************************************/
+
+      nextSnpScoreL = leftScoreL;
+      pST->colScoreL[ulQry] = scoreAryL[refEndUL];
+      pST->colDirC[ulQry] = dirRowC[refEndUL];
+
+      if(dirMatrix != 0)
+      { /*If: using a byte direction matrix*/
+         for(
+            ulRef = refStartUL;
+            ulRef <= refEndUL;
+            ++ulRef
+         ) dirMatrix[rowIndexUL + ulRef] = dirRowC[ulRef];
+      } /*If: using a byte direction matrix*/
+
+      else
+      { /*Else: using a two bit direction matrix*/
+         cpTwoBitPos(pST->twoBitST, &twoBitST);
+         twoBitMvXElmFromStart(
+            &twoBitST,
+            rowIndexUL + refStartUL
+         );
+
+         for(
+            ulRef = refStartUL;
+            ulRef <= refEndUL;
+            ++ulRef
+         ){ /*Loop: copy the directions*/
+            changeTwoBitElm(&twoBitST, dirRowC[ulRef]);
+            twoBitMvToNextElm(&twoBitST);
+         } /*Loop: copy the directions*/
+      } /*Else: using a two bit direction matrix*/
+   } /*Loop: score each row in the tile*/
+
+   pST->bestScoreL = bestScoreL;
+   pST->bestIndexUL = bestIndexUL;
+} /*tileAlnFill*/
+
+/*-------------------------------------------------------\
+| Fun-02: tileAlnRun
+|  - Fills in the gap row and column, then scores every
+|    tile in the matrix one wave (anti-diagonal) at a
+|    time
+| Input:
+|  - qryST:
+|    o Pionter to seqStruct structure with query sequence
+|    o offsetUL; were to start query alignment, is index 0
+|    o endAlnUL; were to stop query alignment, is index 0
+|  - refST:
+|    o Pionter to seqStruct with reference sequence
+|    o offsetUL; were to start alignment on ref, index 0
+|    o endAlnUL; were to stop alignment on ref, is index 0
+|  - needleBl:
+|    o 1: Do a Needleman alignment
+|    o 0: Do a Waterman alignment
+|  - dirMatrix:
+|    o Byte direction matrix to fill ((lenRef + 1) *
+|      (lenQry + 1) + 1 cells) or 0 to use twoBitST
+|  - twoBitST:
+|    o Two bit direction matrix to fill (used when
+|      dirMatrix is 0)
+|  - bestScoreL:
+|    o Pointer to long to hold the best score
+|  - bestIndexUL:
+|    o Pointer to ulong to hold the index of bestScoreL
+|  - settings:
+|    o Point to alnSet structure with alignment settings
+| Output:
+|  - Modifies:
+|    o dirMatrix or twoBitST to have the directions
+|    o bestScoreL to have the best score (Waterman) or
+|      the score of the last cell (Needleman)
+|    o bestIndexUL to have the index of bestScoreL
+|  - Returns:
+|    o 0 for success
+|    o 64 for memory errors
+\-------------------------------------------------------*/
+static char tileAlnRun(
+   struct seqStruct *qryST,    /*Query sequence and data*/
+   struct seqStruct *refST,    /*Ref sequence and data*/
+   char needleBl,              /*1: Needleman; 0: Water*/
+   char *dirMatrix,            /*Byte matrix or 0*/
+   struct twoBitAry *twoBitST, /*Two bit matrix*/
+   long *bestScoreL,           /*Gets best score*/
+   ulong *bestIndexUL,         /*Gets best score index*/
+   struct alnSet *settings     /*Settings for alignment*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-02 TOC: tileAlnRun
+   '  - Scores every tile in the matrix
+   '  o fun-02 sec-01:
+   '    - Variable declerations
+   '  o fun-02 sec-02:
+   '    - Allocate memory and find the tile sizes
+   '  o fun-02 sec-03:
+   '    - Fill in the gap row and gap column
+   '  o fun-02 sec-04:
+   '    - Score the tiles one wave at a time
+   '  o fun-02 sec-05:
+   '    - Clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
+   ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
+   ulong lenMatrixUL = (lenRefUL + 1) * (lenQryUL + 1);
+
+   /*Boundary arrays*/
+   long *rowScoreL = 0;
+   char *rowDirC = 0;
+   long *colScoreL = 0;
+   char *colDirC = 0;
+   long *cornerL = 0;   /*One per row of tiles*/
+
+   /*Tile sizes*/
+   ulong numTileRowsUL = 0;
+   ulong numTileColsUL = 0;
+   ulong tileRowLenUL = 0; /*Query bases per tile*/
+   ulong tileColLenUL = 0; /*Reference bases per tile*/
+   ulong maxWaveUL = 0;    /*Most tiles in a wave*/
+
+   ulong waveUL = 0;
+   ulong tileRowUL = 0;
+   ulong numInWaveUL = 0;
+   ulong ulTile = 0;
+   ulong ulRef = 0;
+   ulong ulQry = 0;
+
+   struct tileAlnPiece *pieceAryST = 0;
+   struct poolTask *taskAryST = 0;
+   struct threadPool poolST;
+
+   char gapDirC = 0;      /*Direction for the gap row/col*/
+   struct twoBitAry twoBitPosST;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-02:
+   ^  - Allocate memory and find the tile sizes
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         lenQryUL,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 64; /*Memory error*/
+
+   numTileRowsUL =
+      (lenQryUL + defTileAlnLen - 1) / defTileAlnLen;
+   numTileColsUL =
+      (lenRefUL + defTileAlnLen - 1) / defTileAlnLen;
+
+   /*With two bit arrays the end of one row and the start
+   ` of the next row can be in the same byte. With two
+   ` columns of tiles, the last tile in a row of tiles and
+   ` the first tile in the next row are in the same wave
+   ` and would both change that byte.
+   */
+   if(numTileColsUL == 2) numTileColsUL = 3;
+
+   tileRowLenUL =
+      (lenQryUL + numTileRowsUL - 1) / numTileRowsUL;
+   tileColLenUL =
+      (lenRefUL + numTileColsUL - 1) / numTileColsUL;
+
+   /*Round up may leave the last tile empty*/
+   numTileRowsUL =
+      (lenQryUL + tileRowLenUL - 1) / tileRowLenUL;
+   numTileColsUL =
+      (lenRefUL + tileColLenUL - 1) / tileColLenUL;
+
+   maxWaveUL = numTileRowsUL;
+   if(maxWaveUL > numTileColsUL) maxWaveUL = numTileColsUL;
+
+   rowScoreL = malloc((lenRefUL + 1) * sizeof(long));
+   rowDirC = malloc((lenRefUL + 1) * sizeof(char));
+   colScoreL = malloc((lenQryUL + 1) * sizeof(long));
+   colDirC = malloc((lenQryUL + 1) * sizeof(char));
+   cornerL = malloc(numTileRowsUL * sizeof(long));
+
+   pieceAryST =
+      malloc(maxWaveUL * sizeof(struct tileAlnPiece));
+   taskAryST = malloc(maxWaveUL * sizeof(struct poolTask));
+
+   if(
+         rowScoreL == 0
+      || rowDirC == 0
+      || colScoreL == 0
+      || colDirC == 0
+      || cornerL == 0
+      || pieceAryST == 0
+      || taskAryST == 0
+   ) goto memErr;
+
+   if(initThreadPool(&poolST, settings->threadsUS))
+      goto memErr;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-03:
+   ^  - Fill in the gap row and gap column
+   ^  o fun-02 sec-03 sub-01:
+   ^    - Find the gap row and column scores
+   ^  o fun-02 sec-03 sub-02:
+   ^    - Write the gap row and column directions
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*****************************************************\
+   * Fun-02 Sec-03 Sub-01:
+   *  - Find the gap row and column scores
+   \*****************************************************/
+
+   /*These are the same as NeedlemanAln and WatermanAln*/
+   rowScoreL[0] = 0;
+   colScoreL[0] = 0;
+   rowDirC[0] = defMvStop;
+   colDirC[0] = defMvStop;
+
+   for(ulRef = 1; ulRef <= lenRefUL; ++ulRef)
+   { /*Loop: find the gap row*/
+      if(! needleBl) rowScoreL[ulRef] = 0;
+      else if(ulRef == 1 || settings->noGapBl)
+         rowScoreL[ulRef] =
+            rowScoreL[ulRef - 1] + settings->gapOpenC;
+      else
+         rowScoreL[ulRef] =
+            rowScoreL[ulRef - 1] + settings->gapExtendC;
+
+      rowDirC[ulRef] = needleBl ? defMvDel : defMvStop;
+   } /*Loop: find the gap row*/
+
+   for(ulQry = 1; ulQry <= lenQryUL; ++ulQry)
+   { /*Loop: find the gap column*/
+      if(! needleBl) colScoreL[ulQry] = 0;
+      else if(ulQry == 1 || settings->noGapBl)
+         colScoreL[ulQry] =
+            colScoreL[ulQry - 1] + settings->gapOpenC;
+      else
+         colScoreL[ulQry] =
+            colScoreL[ulQry - 1] + settings->gapExtendC;
+
+      colDirC[ulQry] = needleBl ? defMvIns : defMvStop;
+   } /*Loop: find the gap column*/
+
+   /*The first row in each row of tiles gets its first
+   ` snp score from the gap column
+   */
+   for(
+      tileRowUL = 0;
+      tileRowUL < numTileRowsUL;
+      ++tileRowUL
+   ) cornerL[tileRowUL] =
+        colScoreL[tileRowUL * tileRowLenUL];
+
+   /*****************************************************\
+   * Fun-02 Sec-03 Sub-02:
+   *  - Write the gap row and column directions
+   \*****************************************************/
+
+   for(ulRef = 0; ulRef <= lenRefUL; ++ulRef)
+   { /*Loop: write the gap row*/
+      if(dirMatrix != 0) dirMatrix[ulRef] = rowDirC[ulRef];
+      else
+      { /*Else: two bit direction matrix*/
+         cpTwoBitPos(twoBitST, &twoBitPosST);
+         twoBitMvXElmFromStart(&twoBitPosST, ulRef);
+         changeTwoBitElm(&twoBitPosST, rowDirC[ulRef]);
+      } /*Else: two bit direction matrix*/
+   } /*Loop: write the gap row*/
+
+   gapDirC = needleBl ? defMvIns : defMvStop;
+
+   for(ulQry = 1; ulQry <= lenQryUL; ++ulQry)
+   { /*Loop: write the gap column*/
+      if(dirMatrix != 0)
+         dirMatrix[ulQry * (lenRefUL + 1)] = gapDirC;
+      else
+      { /*Else: two bit direction matrix*/
+         cpTwoBitPos(twoBitST, &twoBitPosST);
+         twoBitMvXElmFromStart(
+            &twoBitPosST,
+            ulQry * (lenRefUL + 1)
+         );
+         changeTwoBitElm(&twoBitPosST, gapDirC);
+      } /*Else: two bit direction matrix*/
+   } /*Loop: write the gap column*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-04:
+   ^  - Score the tiles one wave at a time
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   *bestScoreL = 0;
+   *bestIndexUL = 0;
+
+   for(
+      waveUL = 0;
+      waveUL < numTileRowsUL + numTileColsUL - 1;
+      ++waveUL
+   ){ /*Loop: score each wave of tiles*/
+      tileRowUL = 0;
+
+      if(waveUL >= numTileColsUL)
+         tileRowUL = waveUL - numTileColsUL + 1;
+
+      numInWaveUL = 0;
+
+      for(
+         ;
+         tileRowUL < numTileRowsUL && tileRowUL <= waveUL;
+         ++tileRowUL
+      ){ /*Loop: add each tile in the wave*/
+         pieceAryST[numInWaveUL].refSeqStr =
+            refST->seqCStr + refST->offsetUL - 1;
+         pieceAryST[numInWaveUL].qrySeqStr =
+            qryST->seqCStr + qryST->offsetUL;
+         pieceAryST[numInWaveUL].lenRefUL = lenRefUL;
+
+         pieceAryST[numInWaveUL].qryStartUL =
+            tileRowUL * tileRowLenUL + 1;
+         pieceAryST[numInWaveUL].qryEndUL =
+            (tileRowUL + 1) * tileRowLenUL;
+
+         if(pieceAryST[numInWaveUL].qryEndUL > lenQryUL)
+            pieceAryST[numInWaveUL].qryEndUL = lenQryUL;
+
+         pieceAryST[numInWaveUL].refStartUL =
+            (waveUL - tileRowUL) * tileColLenUL + 1;
+         pieceAryST[numInWaveUL].refEndUL =
+            (waveUL - tileRowUL + 1) * tileColLenUL;
+
+         if(pieceAryST[numInWaveUL].refEndUL > lenRefUL)
+            pieceAryST[numInWaveUL].refEndUL = lenRefUL;
+
+         pieceAryST[numInWaveUL].rowScoreL = rowScoreL;
+         pieceAryST[numInWaveUL].rowDirC = rowDirC;
+         pieceAryST[numInWaveUL].colScoreL = colScoreL;
+         pieceAryST[numInWaveUL].colDirC = colDirC;
+         pieceAryST[numInWaveUL].cornerL =
+            cornerL + tileRowUL;
+
+         pieceAryST[numInWaveUL].dirMatrix = dirMatrix;
+         pieceAryST[numInWaveUL].twoBitST = twoBitST;
+         pieceAryST[numInWaveUL].needleBl = needleBl;
+         pieceAryST[numInWaveUL].settings = settings;
+
+         addPoolTask(
+            &poolST,
+            &taskAryST[numInWaveUL],
+            tileAlnFill,
+            &pieceAryST[numInWaveUL]
+         );
+
+         ++numInWaveUL;
+      } /*Loop: add each tile in the wave*/
+
+      for(ulTile = 0; ulTile < numInWaveUL; ++ulTile)
+      { /*Loop: wait for the wave to finish*/
+         waitPoolTask(&poolST, &taskAryST[ulTile]);
+
+         /*Keep the first best score (lowest index)*/
+         if(
+               pieceAryST[ulTile].bestScoreL > *bestScoreL
+            || (
+                  pieceAryST[ulTile].bestScoreL > 0
+               && pieceAryST[ulTile].bestScoreL
+                  == *bestScoreL
+               && pieceAryST[ulTile].bestIndexUL
+                  < *bestIndexUL
+            )
+         ){ /*If: this tile has the best score*/
+            *bestScoreL = pieceAryST[ulTile].bestScoreL;
+            *bestIndexUL = pieceAryST[ulTile].bestIndexUL;
+         } /*If: this tile has the best score*/
+      } /*Loop: wait for the wave to finish*/
+   } /*Loop: score each wave of tiles*/
+
+   freeThreadPool(&poolST);
+
+   if(needleBl)
+   { /*If: Needleman ends at the last cell*/
+      *bestScoreL = rowScoreL[lenRefUL];
+      *bestIndexUL = lenMatrixUL - 1;
+   } /*If: Needleman ends at the last cell*/
+
+   /*Mark the end of the matrix (same as NeedlemanAln)*/
+   if(dirMatrix != 0) dirMatrix[lenMatrixUL] = defMvStop;
+   else
+   { /*Else: two bit direction matrix*/
+      cpTwoBitPos(twoBitST, &twoBitPosST);
+      twoBitMvXElmFromStart(&twoBitPosST, lenMatrixUL);
+      changeTwoBitElm(&twoBitPosST, defMvStop);
+   } /*Else: two bit direction matrix*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-02 Sec-05:
+   ^  - Clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   free(rowScoreL);
+   free(rowDirC);
+   free(colScoreL);
+   free(colDirC);
+   free(cornerL);
+   free(pieceAryST);
+   free(taskAryST);
+
+   return 0;
+
+   memErr:
+
+   if(rowScoreL != 0) free(rowScoreL);
+   if(rowDirC != 0) free(rowDirC);
+   if(colScoreL != 0) free(colScoreL);
+   if(colDirC != 0) free(colDirC);
+   if(cornerL != 0) free(cornerL);
+   if(pieceAryST != 0) free(pieceAryST);
+   if(taskAryST != 0) free(taskAryST);
+
+   return 64;
+} /*tileAlnRun*/
+
+/*-------------------------------------------------------\
+| Fun-03: tileAln
+|  - Does a Needleman or Waterman alignment with more
+|    than one thread (settings->threadsUS) into a byte
+|    direction matrix
+| Input:
+|  - qryST:
+|    o Pionter to seqStruct structure with query sequence
+|    o offsetUL; were to start query alignment, is index 0
+|    o endAlnUL; were to stop query alignment, is index 0
+|  - refST:
+|    o Pionter to seqStruct with reference sequence
+|    o offsetUL; were to start alignment on ref, index 0
+|    o endAlnUL; were to stop alignment on ref, is index 0
+|  - needleBl:
+|    o 1: Do a Needleman alignment
+|    o 0: Do a Waterman alignment
+|  - settings:
+|    o Point to alnSet structure with alignment settings
+| Output:
+|  - Returns:
+|    o alnMatrixStruct with the direction matrix & scores
+|      (same as NeedlemanAln or WatermanAln)
+|    o 0 for memory allocation errors
+\-------------------------------------------------------*/
+static struct alnMatrix * tileAln(
+   struct seqStruct *qryST, /*query sequence and data*/
+   struct seqStruct *refST, /*ref sequence and data*/
+   char needleBl,           /*1: Needleman; 0: Waterman*/
+   struct alnSet *settings  /*Settings for alignment*/
+){
+   ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
+   ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
+   ulong lenMatrixUL = (lenRefUL + 1) * (lenQryUL + 1);
+   struct alnMatrix *retMatrixST = 0;
+
+   retMatrixST = malloc(sizeof(struct alnMatrix));
+   if(retMatrixST == 0) return 0;
+   initAlnMatrix(retMatrixST);
+
+   retMatrixST->dirMatrix =
+      malloc((lenMatrixUL + 1) * sizeof(char));
+
+   if(retMatrixST->dirMatrix == 0)
+   { /*If: Memory error*/
+      freeAlnMatrix(retMatrixST);
+      return 0;
+   } /*If: Memory error*/
+
+   retMatrixST->lenRefUL = lenRefUL;
+   retMatrixST->refOffsetUL = refST->offsetUL;
+
+   retMatrixST->lenQryUL = lenQryUL;
+   retMatrixST->qryOffsetUL = qryST->offsetUL;
+
+   if(
+      tileAlnRun(
+         qryST,
+         refST,
+         needleBl,
+         retMatrixST->dirMatrix,
+         0,
+         &retMatrixST->bestScoreL,
+         &retMatrixST->bestEndIndexUL,
+         settings
+      )
+   ){ /*If: Memory error*/
+      freeAlnMatrix(retMatrixST);
+      return 0;
+   } /*If: Memory error*/
+
+   return retMatrixST;
+} /*tileAln*/
+
+/*-------------------------------------------------------\
+| Fun-04: tileAlnTwoBit
+|  - Does a Needleman or Waterman alignment with more
+|    than one thread (settings->threadsUS) into a two bit
+|    direction matrix
+| Input:
+|  - qryST:
+|    o Pionter to seqStruct structure with query sequence
+|    o offsetUL; were to start query alignment, is index 0
+|    o endAlnUL; were to stop query alignment, is index 0
+|  - refST:
+|    o Pionter to seqStruct with reference sequence
+|    o offsetUL; were to start alignment on ref, index 0
+|    o endAlnUL; were to stop alignment on ref, is index 0
+|  - needleBl:
+|    o 1: Do a Needleman alignment
+|    o 0: Do a Waterman alignment
+|  - settings:
+|    o Point to alnSet structure with alignment settings
+| Output:
+|  - Returns:
+|    o alnMatrixTwoBit with the direction matrix & scores
+|      (same as NeedleTwoBit or WaterTwoBit)
+|    o 0 for memory allocation errors
+\-------------------------------------------------------*/
+static struct alnMatrixTwoBit * tileAlnTwoBit(
+   struct seqStruct *qryST, /*query sequence and data*/
+   struct seqStruct *refST, /*ref sequence and data*/
+   char needleBl,           /*1: Needleman; 0: Waterman*/
+   struct alnSet *settings  /*Settings for alignment*/
+){
+   ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
+   ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
+   ulong lenMatrixUL = (lenRefUL + 1) * (lenQryUL + 1);
+   struct alnMatrixTwoBit *retMatrixST = 0;
+
+   retMatrixST = malloc(sizeof(struct alnMatrixTwoBit));
+   if(retMatrixST == 0) return 0;
+   initAlnMatrixTwoBit(retMatrixST);
+
+   retMatrixST->dirMatrix =
+      makeTwoBit((lenMatrixUL + 1), 0);
+
+   if(retMatrixST->dirMatrix == 0)
+   { /*If: Memory error*/
+      freeAlnMatrixTwoBit(retMatrixST);
+      return 0;
+   } /*If: Memory error*/
+
+   retMatrixST->lenRefUL = lenRefUL;
+   retMatrixST->refOffsetUL = refST->offsetUL;
+
+   retMatrixST->lenQryUL = lenQryUL;
+   retMatrixST->qryOffsetUL = qryST->offsetUL;
+
+   if(
+      tileAlnRun(
+         qryST,
+         refST,
+         needleBl,
+         0,
+         retMatrixST->dirMatrix,
+         &retMatrixST->bestScoreL,
+         &retMatrixST->bestEndIndexUL,
+         settings
+      )
+   ){ /*If: Memory error*/
+      freeAlnMatrixTwoBit(retMatrixST);
+      return 0;
+   } /*If: Memory error*/
+
+   return retMatrixST;
+} /*tileAlnTwoBit*/
+
+#endif
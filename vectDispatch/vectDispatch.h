@@ -0,0 +1,562 @@
+/*########################################################
+# Name vectDispatch
+# Use:
+#  o Picks the vector (SIMD) instruction set to use at run
+#    time and calls the memWaterVect, batchAln, hirschVect,
+#    and alnDirVect kernels for that set.
+#  o With -DVECTDISPATCH the SSE2, SSE4, and AVX2 kernels
+#    are compiled into their own object files (see
+#    vectDispatchKernels.c and make dispatch), so one
+#    binary can use the widest set the cpu has. The file
+#    that includes this header is compiled without vector
+#    flags.
+#  o Without -DVECTDISPATCH only the set picked when
+#    compiling (-DSSE2, -DSSE4, or -DAVX2) or the scalar
+#    aligners can be used.
+#  o The set can be forced with -vect-set or the
+#    ALNSEQ_VECT environment variable (for benchmarking).
+# Libraries:
+#   - "../memWater/memWaterVect.h"     (No .c file)
+#   - "../batchAln/batchAln.h"         (No .c file)
+#   - "../hirschberg/hirschVect.h"     (No .c file)
+#   - "../alnDirVect/alnDirVect.h"     (No .c file)
+#   o "../general/alnMatrixStruct.h"   (No .c file)
+#   o "../general/dataTypeShortHand.h" (No .c file)
+#   o "../general/alnSetStruct.h"      (No .c file)
+#   o "../general/alnSeqDefaults.h"    (No .c file)
+#   o "../general/seqStruct.h"         (No .c file)
+#   o "../vectWrap/vectWrap.h"         (No .c file)
+# C Standard libraries:
+#   - <stdlib.h>
+#   - <string.h>
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+' o fun-01 vectDispatchStrToSet:
+'   - Converts a set name (sse2, avx2, ...) to its number
+' o fun-02 vectDispatchSetToStr:
+'   - Converts a set number to its name
+' o fun-03 vectDispatchCpuSet:
+'   - Finds the widest set the cpu has that was compiled
+' o fun-04 vectDispatchPick:
+'   - Picks the set to use (user choice, ALNSEQ_VECT, or
+'     the cpu)
+' o fun-05 memWaterDispatch:
+'   - Runs memWaterVect with the picked set
+' o fun-06 batchAlnDispatch:
+'   - Runs batchAln with the picked set
+' o fun-07 hirschVectDispatch:
+'   - Runs hirschVect with the picked set
+' o fun-08 alnDirVectDispatch:
+'   - Runs alnDirVect with the picked set
+' o fun-09 alnDirVectTwoBitDispatch:
+'   - Runs alnDirVectTwoBit with the picked set
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#ifndef VECT_DISPATCH_H
+#define VECT_DISPATCH_H
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../memWater/memWaterVect.h"
+#include "../batchAln/batchAln.h"
+#include "../hirschberg/hirschVect.h"
+#include "../alnDirVect/alnDirVect.h"
+
+/*Environment variable to force a set with*/
+#define defVectEnvStr "ALNSEQ_VECT"
+
+#ifdef VECTDISPATCH
+   /*These are in vectDispatchKernels.c (one object file
+   ` per set)
+   */
+   struct alnMatrix * memWaterVectSSE2(
+      struct seqStruct *, struct seqStruct *,
+      struct alnSet *
+   );
+   struct alnMatrix * memWaterVectSSE4(
+      struct seqStruct *, struct seqStruct *,
+      struct alnSet *
+   );
+   struct alnMatrix * memWaterVectAVX2(
+      struct seqStruct *, struct seqStruct *,
+      struct alnSet *
+   );
+
+   struct alnMatrix * batchAlnSSE2(
+      struct seqStruct **, struct seqStruct **, ulong,
+      char, char, struct alnSet *
+   );
+   struct alnMatrix * batchAlnSSE4(
+      struct seqStruct **, struct seqStruct **, ulong,
+      char, char, struct alnSet *
+   );
+   struct alnMatrix * batchAlnAVX2(
+      struct seqStruct **, struct seqStruct **, ulong,
+      char, char, struct alnSet *
+   );
+
+   struct alnStruct * hirschVectSSE2(
+      struct seqStruct *, struct seqStruct *,
+      struct alnSet *
+   );
+   struct alnStruct * hirschVectSSE4(
+      struct seqStruct *, struct seqStruct *,
+      struct alnSet *
+   );
+   struct alnStruct * hirschVectAVX2(
+      struct seqStruct *, struct seqStruct *,
+      struct alnSet *
+   );
+
+   struct alnMatrix * alnDirVectSSE2(
+      struct seqStruct *, struct seqStruct *, char,
+      struct alnSet *
+   );
+   struct alnMatrix * alnDirVectSSE4(
+      struct seqStruct *, struct seqStruct *, char,
+      struct alnSet *
+   );
+   struct alnMatrix * alnDirVectAVX2(
+      struct seqStruct *, struct seqStruct *, char,
+      struct alnSet *
+   );
+
+   struct alnMatrixTwoBit * alnDirVectTwoBitSSE2(
+      struct seqStruct *, struct seqStruct *, char,
+      struct alnSet *
+   );
+   struct alnMatrixTwoBit * alnDirVectTwoBitSSE4(
+      struct seqStruct *, struct seqStruct *, char,
+      struct alnSet *
+   );
+   struct alnMatrixTwoBit * alnDirVectTwoBitAVX2(
+      struct seqStruct *, struct seqStruct *, char,
+      struct alnSet *
+   );
+#endif
+
+/*-------------------------------------------------------\
+| Fun-01: vectDispatchStrToSet
+|   - Converts a set name to its number
+| Input:
+|   - setStr:
+|     o C-string with the name of the set (auto, scalar,
+|       sse2, sse4, or avx2)
+| Output:
+|   - Returns:
+|     o The set number (defVectAuto, defVectScalar,
+|       defVectSSE2, defVectSSE4, or defVectAVX2)
+|     o 0 if setStr is not a set
+\-------------------------------------------------------*/
+static char vectDispatchStrToSet(
+   char *setStr
+){
+   if(setStr == 0) return 0;
+   if(strcmp(setStr, "auto") == 0) return defVectAuto;
+   if(strcmp(setStr, "scalar") == 0) return defVectScalar;
+   if(strcmp(setStr, "sse2") == 0) return defVectSSE2;
+   if(strcmp(setStr, "sse4") == 0) return defVectSSE4;
+   if(strcmp(setStr, "avx2") == 0) return defVectAVX2;
+   return 0;
+} /*vectDispatchStrToSet*/
+
+/*-------------------------------------------------------\
+| Fun-02: vectDispatchSetToStr
+|   - Converts a set number to its name
+| Input:
+|   - setC:
+|     o Set number to convert (defVectSSE2, ...)
+| Output:
+|   - Returns:
+|     o C-string with the name of the set
+\-------------------------------------------------------*/
+static char * vectDispatchSetToStr(
+   char setC
+){
+   switch(setC)
+   { /*Switch: find the sets name*/
+      case defVectScalar: return "scalar";
+      case defVectSSE2: return "sse2";
+      case defVectSSE4: return "sse4";
+      case defVectAVX2: return "avx2";
+      case defVectNative: return "native";
+      case defVectAuto: return "auto";
+   } /*Switch: find the sets name*/
+
+   return "unknown";
+} /*vectDispatchSetToStr*/
+
+/*-------------------------------------------------------\
+| Fun-03: vectDispatchCpuSet
+|   - Finds the widest set the cpu has that was compiled
+|     into this binary
+| Input:
+| Output:
+|   - Returns:
+|     o With -DVECTDISPATCH, the widest of defVectSSE2,
+|       defVectSSE4, or defVectAVX2 that the cpu has
+|       (defVectScalar if none)
+|     o Without -DVECTDISPATCH, the set picked when
+|       compiling (defVectScalar for no vectors)
+\-------------------------------------------------------*/
+static char vectDispatchCpuSet(
+){
+   #ifdef VECTDISPATCH
+      #if    defined __GNUC__ \
+         && (defined __x86_64__ || defined __i386__)
+         __builtin_cpu_init();
+
+         if(__builtin_cpu_supports("avx2"))
+            return defVectAVX2;
+
+         if(__builtin_cpu_supports("sse4.1"))
+            return defVectSSE4;
+
+         if(__builtin_cpu_supports("sse2"))
+            return defVectSSE2;
+
+         return defVectScalar;
+      #elif defined __x86_64__
+         return defVectSSE2; /*All 64 bit x86 cpus*/
+      #else
+         return defVectScalar;
+      #endif
+
+   #elif defined AVX2
+      return defVectAVX2;
+   #elif defined SSE4
+      return defVectSSE4;
+   #elif defined DEFNOVECT
+      return defVectScalar;
+   #elif defined SSE2 && ! defined AVX512
+      return defVectSSE2;
+   #else
+      return defVectNative; /*AVX512 or NEON*/
+   #endif
+} /*vectDispatchCpuSet*/
+
+/*-------------------------------------------------------\
+| Fun-04: vectDispatchPick
+|   - Picks the set to use
+| Input:
+|   - setC:
+|     o Set the user asked for (-vect-set). For
+|       defVectAuto the ALNSEQ_VECT environment variable
+|       is checked and then the cpu is used.
+| Output:
+|   - Returns:
+|     o The set to use. This is never wider than the
+|       widest set the cpu has (vectDispatchCpuSet).
+\-------------------------------------------------------*/
+static char vectDispatchPick(
+   char setC
+){
+   char cpuSetC = vectDispatchCpuSet();
+
+   if(setC == defVectAuto)
+      setC = vectDispatchStrToSet(getenv(defVectEnvStr));
+
+   if(setC == 0 || setC == defVectAuto) return cpuSetC;
+
+   /*The user can only pick the scalar aligners or a set
+   ` that the cpu has
+   */
+   if(setC == defVectScalar) return setC;
+
+   #ifdef VECTDISPATCH
+      if(setC > cpuSetC) return cpuSetC;
+      return setC;
+   #else
+      return cpuSetC; /*Only one set was compiled*/
+   #endif
+} /*vectDispatchPick*/
+
+/*-------------------------------------------------------\
+| Fun-05: memWaterDispatch
+|   - Runs memWaterVect with the set in settings
+| Input:
+|   - qryST:
+|     o seqStruct with the query sequence
+|   - refST:
+|     o seqStruct with the reference sequence
+|   - settings:
+|     o alnSet structure with the alignment settings.
+|       settings->vectSetC is set to the picked set if it
+|       is defVectAuto.
+| Output:
+|   - Returns:
+|     o Same as memWaterVect (alnMatrix structure with
+|       the best score, start, and end)
+|     o 0 for memory errors
+\-------------------------------------------------------*/
+static struct alnMatrix * memWaterDispatch(
+   struct seqStruct *qryST,
+   struct seqStruct *refST,
+   struct alnSet *settings
+){
+   if(settings->vectSetC == defVectAuto)
+      settings->vectSetC = vectDispatchPick(defVectAuto);
+
+   #ifdef VECTDISPATCH
+      switch(settings->vectSetC)
+      { /*Switch: use the picked set*/
+         case defVectAVX2:
+            return memWaterVectAVX2(qryST, refST, settings);
+         case defVectSSE4:
+            return memWaterVectSSE4(qryST, refST, settings);
+         case defVectSSE2:
+            return memWaterVectSSE2(qryST, refST, settings);
+      } /*Switch: use the picked set*/
+   #endif
+
+   /*Scalar or the set picked when compiling*/
+   return memWaterVect(qryST, refST, settings);
+} /*memWaterDispatch*/
+
+/*-------------------------------------------------------\
+| Fun-06: batchAlnDispatch
+|   - Runs batchAln with the set in settings
+| Input:
+|   - qryAryST:
+|     o Array of pointers to seqStructs with the query
+|       sequences (see batchAln)
+|   - refAryST:
+|     o Array of pointers to seqStructs with the reference
+|       sequences (see batchAln)
+|   - numPairsUL:
+|     o Number of pairs in qryAryST and refAryST
+|   - needleBl:
+|     o 1: Do Needleman alignments
+|     o 0: Do Waterman alignments
+|   - dirBl:
+|     o 1: Fill in the direction matrix for each pair
+|     o 0: Only find the scores and start/end indexes
+|   - settings:
+|     o alnSet structure with the alignment settings.
+|       settings->vectSetC is set to the picked set if it
+|       is defVectAuto.
+| Output:
+|   - Returns:
+|     o Same as batchAln (array of alnMatrix structures)
+|     o 0 for memory errors
+\-------------------------------------------------------*/
+static struct alnMatrix * batchAlnDispatch(
+   struct seqStruct **qryAryST,
+   struct seqStruct **refAryST,
+   ulong numPairsUL,
+   char needleBl,
+   char dirBl,
+   struct alnSet *settings
+){
+   if(settings->vectSetC == defVectAuto)
+      settings->vectSetC = vectDispatchPick(defVectAuto);
+
+   #ifdef VECTDISPATCH
+      switch(settings->vectSetC)
+      { /*Switch: use the picked set*/
+         case defVectAVX2:
+            return
+               batchAlnAVX2(
+                  qryAryST,
+                  refAryST,
+                  numPairsUL,
+                  needleBl,
+                  dirBl,
+                  settings
+               );
+
+         case defVectSSE4:
+            return
+               batchAlnSSE4(
+                  qryAryST,
+                  refAryST,
+                  numPairsUL,
+                  needleBl,
+                  dirBl,
+                  settings
+               );
+
+         case defVectSSE2:
+            return
+               batchAlnSSE2(
+                  qryAryST,
+                  refAryST,
+                  numPairsUL,
+                  needleBl,
+                  dirBl,
+                  settings
+               );
+      } /*Switch: use the picked set*/
+   #endif
+
+   /*Scalar or the set picked when compiling*/
+   return
+      batchAln(
+         qryAryST,
+         refAryST,
+         numPairsUL,
+         needleBl,
+         dirBl,
+         settings
+      );
+} /*batchAlnDispatch*/
+
+/*-------------------------------------------------------\
+| Fun-07: hirschVectDispatch
+|   - Runs hirschVect with the set in settings
+| Input:
+|   - refST:
+|     o seqStruct with the reference sequence
+|   - qryST:
+|     o seqStruct with the query sequence
+|   - settings:
+|     o alnSet structure with the alignment settings.
+|       settings->vectSetC is set to the picked set if it
+|       is defVectAuto.
+| Output:
+|   - Returns:
+|     o Same as hirschVect (alnStruct with the alignment)
+|     o 0 for memory errors
+\-------------------------------------------------------*/
+static struct alnStruct * hirschVectDispatch(
+   struct seqStruct *refST,
+   struct seqStruct *qryST,
+   struct alnSet *settings
+){
+   if(settings->vectSetC == defVectAuto)
+      settings->vectSetC = vectDispatchPick(defVectAuto);
+
+   #ifdef VECTDISPATCH
+      switch(settings->vectSetC)
+      { /*Switch: use the picked set*/
+         case defVectAVX2:
+            return hirschVectAVX2(refST, qryST, settings);
+         case defVectSSE4:
+            return hirschVectSSE4(refST, qryST, settings);
+         case defVectSSE2:
+            return hirschVectSSE2(refST, qryST, settings);
+      } /*Switch: use the picked set*/
+   #endif
+
+   /*Scalar or the set picked when compiling*/
+   return hirschVect(refST, qryST, settings);
+} /*hirschVectDispatch*/
+
+/*-------------------------------------------------------\
+| Fun-08: alnDirVectDispatch
+|   - Runs alnDirVect with the set in settings
+| Input:
+|   - qryST:
+|     o seqStruct with the query sequence
+|   - refST:
+|     o seqStruct with the reference sequence
+|   - needleBl:
+|     o 1: Do a Needleman alignment
+|     o 0: Do a Waterman alignment
+|   - settings:
+|     o alnSet structure with the alignment settings.
+|       settings->vectSetC is set to the picked set if it
+|       is defVectAuto.
+| Output:
+|   - Returns:
+|     o Same as alnDirVect (alnMatrix structure with
+|       the direction matrix)
+|     o 0 for memory errors
+\-------------------------------------------------------*/
+static struct alnMatrix * alnDirVectDispatch(
+   struct seqStruct *qryST,
+   struct seqStruct *refST,
+   char needleBl,
+   struct alnSet *settings
+){
+   if(settings->vectSetC == defVectAuto)
+      settings->vectSetC = vectDispatchPick(defVectAuto);
+
+   #ifdef VECTDISPATCH
+      switch(settings->vectSetC)
+      { /*Switch: use the picked set*/
+         case defVectAVX2:
+            return
+               alnDirVectAVX2(qryST,refST,needleBl,settings);
+         case defVectSSE4:
+            return
+               alnDirVectSSE4(qryST,refST,needleBl,settings);
+         case defVectSSE2:
+            return
+               alnDirVectSSE2(qryST,refST,needleBl,settings);
+      } /*Switch: use the picked set*/
+   #endif
+
+   /*Scalar or the set picked when compiling*/
+   return alnDirVect(qryST, refST, needleBl, settings);
+} /*alnDirVectDispatch*/
+
+/*-------------------------------------------------------\
+| Fun-09: alnDirVectTwoBitDispatch
+|   - Runs alnDirVectTwoBit with the set in settings
+| Input:
+|   - qryST:
+|     o seqStruct with the query sequence
+|   - refST:
+|     o seqStruct with the reference sequence
+|   - needleBl:
+|     o 1: Do a Needleman alignment
+|     o 0: Do a Waterman alignment
+|   - settings:
+|     o alnSet structure with the alignment settings.
+|       settings->vectSetC is set to the picked set if it
+|       is defVectAuto.
+| Output:
+|   - Returns:
+|     o Same as alnDirVectTwoBit (alnMatrixTwoBit
+|       structure with the two bit direction matrix)
+|     o 0 for memory errors
+\-------------------------------------------------------*/
+static struct alnMatrixTwoBit * alnDirVectTwoBitDispatch(
+   struct seqStruct *qryST,
+   struct seqStruct *refST,
+   char needleBl,
+   struct alnSet *settings
+){
+   if(settings->vectSetC == defVectAuto)
+      settings->vectSetC = vectDispatchPick(defVectAuto);
+
+   #ifdef VECTDISPATCH
+      switch(settings->vectSetC)
+      { /*Switch: use the picked set*/
+         case defVectAVX2:
+            return
+               alnDirVectTwoBitAVX2(
+                  qryST,
+                  refST,
+                  needleBl,
+                  settings
+               );
+         case defVectSSE4:
+            return
+               alnDirVectTwoBitSSE4(
+                  qryST,
+                  refST,
+                  needleBl,
+                  settings
+               );
+         case defVectSSE2:
+            return
+               alnDirVectTwoBitSSE2(
+                  qryST,
+                  refST,
+                  needleBl,
+                  settings
+               );
+      } /*Switch: use the picked set*/
+   #endif
+
+   /*Scalar or the set picked when compiling*/
+   return
+      alnDirVectTwoBit(qryST, refST, needleBl, settings);
+} /*alnDirVectTwoBitDispatch*/
+
+#endif
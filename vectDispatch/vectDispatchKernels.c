@@ -0,0 +1,211 @@
+/*########################################################
+# Name vectDispatchKernels
+# Use:
+#  o Compiles the memWaterVect, batchAln, hirschVect, and
+#    alnDirVect kernels for one vector instruction set.
+#    Each set is compiled into its own object file, with
+#    the set added to the function names, so they can be
+#    linked into one binary (see vectDispatch.h and make
+#    dispatch).
+#  o Compile with one of:
+#    - -DSSE2 -c (memWaterVectSSE2, batchAlnSSE2,
+#      hirschVectSSE2, alnDirVectSSE2, ...)
+#    - -DSSE4 -msse4.1 -c (memWaterVectSSE4,
+#      batchAlnSSE4, hirschVectSSE4, alnDirVectSSE4, ...)
+#    - -DAVX2 -mavx2 -c (memWaterVectAVX2,
+#      batchAlnAVX2, hirschVectAVX2, alnDirVectAVX2, ...)
+# Libraries:
+#   - "../memWater/memWaterVect.h"     (No .c file)
+#   - "../batchAln/batchAln.h"         (No .c file)
+#   - "../hirschberg/hirschVect.h"     (No .c file)
+#   - "../alnDirVect/alnDirVect.h"     (No .c file)
+#   o "../general/alnMatrixStruct.h"   (No .c file)
+#   o "../general/dataTypeShortHand.h" (No .c file)
+#   o "../general/alnSetStruct.h"      (No .c file)
+#   o "../general/alnSeqDefaults.h"    (No .c file)
+#   o "../general/seqStruct.h"         (No .c file)
+#   o "../vectWrap/vectWrap.h"         (No .c file)
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+' o macro-01 vectDispatchName:
+'   - Adds the instruction set to a function name
+' o fun-02 memWaterVect(SSE2|SSE4|AVX2):
+'   - Runs memWaterVect with this files instruction set
+' o fun-03 batchAln(SSE2|SSE4|AVX2):
+'   - Runs batchAln with this files instruction set
+' o fun-04 hirschVect(SSE2|SSE4|AVX2):
+'   - Runs hirschVect with this files instruction set
+' o fun-05 alnDirVect(SSE2|SSE4|AVX2):
+'   - Runs alnDirVect with this files instruction set
+' o fun-06 alnDirVectTwoBit(SSE2|SSE4|AVX2):
+'   - Runs alnDirVectTwoBit with this files instruction
+'     set
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#include "../memWater/memWaterVect.h"
+#include "../batchAln/batchAln.h"
+#include "../hirschberg/hirschVect.h"
+#include "../alnDirVect/alnDirVect.h"
+
+/*-------------------------------------------------------\
+| Macro-01: vectDispatchName
+|   - Adds the instruction set to a function name
+| Input:
+|   - funName:
+|     o Name of the function
+| Output:
+|   - funName with SSE2, SSE4, or AVX2 on the end
+\-------------------------------------------------------*/
+#if defined AVX2
+   #define vectDispatchName(funName) funName##AVX2
+#elif defined SSE4
+   #define vectDispatchName(funName) funName##SSE4
+#elif defined SSE2
+   #define vectDispatchName(funName) funName##SSE2
+#else
+   #error "Use -DSSE2, -DSSE4 -msse4.1, or -DAVX2 -mavx2"
+#endif
+
+/*-------------------------------------------------------\
+| Fun-02: memWaterVect(SSE2|SSE4|AVX2)
+|   - Runs memWaterVect with this files instruction set
+| Input:
+|   - qryST:
+|     o seqStruct with the query sequence
+|   - refST:
+|     o seqStruct with the reference sequence
+|   - settings:
+|     o alnSet structure with the alignment settings
+| Output:
+|   - Returns:
+|     o Same as memWaterVect
+\-------------------------------------------------------*/
+struct alnMatrix * vectDispatchName(memWaterVect)(
+   struct seqStruct *qryST,
+   struct seqStruct *refST,
+   struct alnSet *settings
+){
+   return memWaterVect(qryST, refST, settings);
+} /*memWaterVect(SSE2|SSE4|AVX2)*/
+
+/*-------------------------------------------------------\
+| Fun-03: batchAln(SSE2|SSE4|AVX2)
+|   - Runs batchAln with this files instruction set
+| Input:
+|   - qryAryST:
+|     o Array of pointers to seqStructs with the query
+|       sequences (see batchAln)
+|   - refAryST:
+|     o Array of pointers to seqStructs with the reference
+|       sequences (see batchAln)
+|   - numPairsUL:
+|     o Number of pairs in qryAryST and refAryST
+|   - needleBl:
+|     o 1: Do Needleman alignments
+|     o 0: Do Waterman alignments
+|   - dirBl:
+|     o 1: Fill in the direction matrix for each pair
+|     o 0: Only find the scores and start/end indexes
+|   - settings:
+|     o alnSet structure with the alignment settings
+| Output:
+|   - Returns:
+|     o Same as batchAln
+\-------------------------------------------------------*/
+struct alnMatrix * vectDispatchName(batchAln)(
+   struct seqStruct **qryAryST,
+   struct seqStruct **refAryST,
+   ulong numPairsUL,
+   char needleBl,
+   char dirBl,
+   struct alnSet *settings
+){
+   return
+      batchAln(
+         qryAryST,
+         refAryST,
+         numPairsUL,
+         needleBl,
+         dirBl,
+         settings
+      );
+} /*batchAln(SSE2|SSE4|AVX2)*/
+
+/*-------------------------------------------------------\
+| Fun-04: hirschVect(SSE2|SSE4|AVX2)
+|   - Runs hirschVect with this files instruction set
+| Input:
+|   - refST:
+|     o seqStruct with the reference sequence
+|   - qryST:
+|     o seqStruct with the query sequence
+|   - settings:
+|     o alnSet structure with the alignment settings
+| Output:
+|   - Returns:
+|     o Same as hirschVect
+\-------------------------------------------------------*/
+struct alnStruct * vectDispatchName(hirschVect)(
+   struct seqStruct *refST,
+   struct seqStruct *qryST,
+   struct alnSet *settings
+){
+   return hirschVect(refST, qryST, settings);
+} /*hirschVect(SSE2|SSE4|AVX2)*/
+
+/*-------------------------------------------------------\
+| Fun-05: alnDirVect(SSE2|SSE4|AVX2)
+|   - Runs alnDirVect with this files instruction set
+| Input:
+|   - qryST:
+|     o seqStruct with the query sequence
+|   - refST:
+|     o seqStruct with the reference sequence
+|   - needleBl:
+|     o 1: Do a Needleman alignment
+|     o 0: Do a Waterman alignment
+|   - settings:
+|     o alnSet structure with the alignment settings
+| Output:
+|   - Returns:
+|     o Same as alnDirVect
+\-------------------------------------------------------*/
+struct alnMatrix * vectDispatchName(alnDirVect)(
+   struct seqStruct *qryST,
+   struct seqStruct *refST,
+   char needleBl,
+   struct alnSet *settings
+){
+   return alnDirVect(qryST, refST, needleBl, settings);
+} /*alnDirVect(SSE2|SSE4|AVX2)*/
+
+/*-------------------------------------------------------\
+| Fun-06: alnDirVectTwoBit(SSE2|SSE4|AVX2)
+|   - Runs alnDirVectTwoBit with this files instruction
+|     set
+| Input:
+|   - qryST:
+|     o seqStruct with the query sequence
+|   - refST:
+|     o seqStruct with the reference sequence
+|   - needleBl:
+|     o 1: Do a Needleman alignment
+|     o 0: Do a Waterman alignment
+|   - settings:
+|     o alnSet structure with the alignment settings
+| Output:
+|   - Returns:
+|     o Same as alnDirVectTwoBit
+\-------------------------------------------------------*/
+struct alnMatrixTwoBit *
+vectDispatchName(alnDirVectTwoBit)(
+   struct seqStruct *qryST,
+   struct seqStruct *refST,
+   char needleBl,
+   struct alnSet *settings
+){
+   return
+      alnDirVectTwoBit(qryST, refST, needleBl, settings);
+} /*alnDirVectTwoBit(SSE2|SSE4|AVX2)*/
@@ -773,6 +773,18 @@
 #        o Converts mask16 to a vectU16
 #      - mask32_retVectU32(inMask32)
 #        o Converts mask32 to a vectU32
+#  - Byte shuffles (sec-02 sub-08)
+#    o Only in SSE4 (SSSE3) and AVX2 builds. Check for
+#      defVectShuffle before using these.
+#    o loadTbl_U8Ary_retVectU8(arrayU8)
+#      - Loads a 16 byte table for shuffles (copied into
+#        each 128 bit lane for AVX2)
+#    o shuffle_vectU8_retVectU8(tblVectU8, indexVectU8)
+#      - Looks up each byte (0 to 15) of indexVectU8 in
+#        tblVectU8
+#    o rev_vectU8_retVectU8(inVectU8)
+#      - Reverses the bytes in inVectU8 (+1 lane swap for
+#        AVX2)
 # Libraries:
 #  o Compiler flag determined
 #    i) or "vectWrapAVX512.h" 
@@ -956,7 +968,9 @@ typedef struct vectMemBlock
       malloc(sizeof(int8_t) * ((size) + defVectBytes));\
    \
    if((memBlockST)->freePtr != 0)\
-      (memBlockST)->alnPtr=alnPointer(memBlockST->freePtr)\
+      (memBlockST)->alnPtr =\
+         alnPointer((memBlockST)->freePtr + defVectBytes);\
+      /*alnPointer rounds down, so move up one vector*/\
 } /*mallocVectMemBlock*/
 
 /*--------------------------------------------------------\
@@ -976,7 +990,9 @@ typedef struct vectMemBlock
       calloc(((size) + defVectBytes), sizeof(int8_t));\
    \
    if((memBlockST)->freePtr != 0)\
-      (memBlockST)->alnPtr=alnPointer(memBlockST->freePtr)\
+      (memBlockST)->alnPtr =\
+         alnPointer((memBlockST)->freePtr + defVectBytes);\
+      /*alnPointer rounds down, so move up one vector*/\
 } /*callocVectMemBlock*/
 
 /*--------------------------------------------------------\
@@ -67,6 +67,8 @@ typedef __m256i mask32; /*mask of 32 bit values*/
 ^    - Math functions
 ^  o sec-02 sub-07:
 ^    - Casts [for NEON & masks] and Conversions
+^  o sec-02 sub-08:
+^    - Byte shuffles (table lookups) and reverse
 \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
 /*********************************************************\
@@ -254,13 +256,13 @@ typedef __m256i mask32; /*mask of 32 bit values*/
 /*storing in retUL because this is how AVX512 does it*/
 
 #define store_mask8_retUL(retUL, mask8) \
-   ((retUL) = _mm256_movemask_epi8((mask8)))
+   ((retUL) = (unsigned int) _mm256_movemask_epi8((mask8)))
 
 #define store_mask16_retUL(retUL, mask16) \
-   ((retUL) = _mm256_movemask_epi8((mask16)))
+   ((retUL) = (unsigned int) _mm256_movemask_epi8((mask16)))
 
 #define store_mask32_retUL(retUL, mask32) \
-   ((retUL) = _mm256_movemask_epi8((mask32)))
+   ((retUL) = (unsigned int) _mm256_movemask_epi8((mask32)))
 
 /*++++++++++++++++++++++++++++++++++++++++++++++++++++++++\
 + Sec-02 Sub-02 Cat-04:
@@ -650,23 +652,32 @@ typedef __m256i mask32; /*mask of 32 bit values*/
 +  - Shift a vector right by x bytes
 \*+++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 
+/*_mm256_srli_si256 only shifts within each 128 bit lane,
+` so the upper lane is moved down with a permute and then
+` shifted into the lower lane with alignr. This only
+` works for shifts of less than 16 bytes.
+*/
 #define srvect_vectI8_retVectI8(inVectI8, numBytesI)\
-    (_mm256_srli_si256((inVectI8), (numBytesI)))
+    (_mm256_alignr_epi8(\
+       _mm256_permute2x128_si256((inVectI8),(inVectI8),0x81),\
+       (inVectI8),\
+       (numBytesI)\
+    ))
 
 #define srvect_vectU8_retVectU8(inVectU8, numBytesI)\
-    (_mm256_srli_si256((inVectU8), (numBytesI)))
+    (srvect_vectI8_retVectI8((inVectU8), (numBytesI)))
 
 #define srvect_vectI16_retVectI16(inVectI16, numShortsI)\
-    (_mm256_srli_si256((inVectI16), (numShortsI) << 1))
+    (srvect_vectI8_retVectI8((inVectI16),(numShortsI) << 1))
 
 #define srvect_vectU16_retVectU16(inVectU16, numShortsI)\
-    (_mm256_srli_si256((inVectU16), (numShortsI) << 1))
+    (srvect_vectI8_retVectI8((inVectU16),(numShortsI) << 1))
 
 #define srvect_vectI32_retVectI32(inVectI32, numIntsI)\
-    (_mm256_srli_si256((inVectI32), (numIntsI) << 2))
+    (srvect_vectI8_retVectI8((inVectI32), (numIntsI) << 2))
 
 #define srvect_vectU32_retVectU32(inVectU32, numIntsI)\
-    (_mm256_srli_si256((inVectU32), (numIntsI) << 2))
+    (srvect_vectI8_retVectI8((inVectU32), (numIntsI) << 2))
 
 /*++++++++++++++++++++++++++++++++++++++++++++++++++++++++\
 + Sec-02 Sub-05 Cat-03:
@@ -696,23 +707,31 @@ typedef __m256i mask32; /*mask of 32 bit values*/
 +  - Shift a vector left by x bytes
 \*+++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 
+/*Same problem as the right shifts; the lower lane is
+` moved up with a permute and then shifted in with alignr.
+` This only works for shifts of less than 16 bytes.
+*/
 #define slvect_vectI8_retVectI8(inVectI8, numBytesI)\
-    (_mm256_slli_si256((inVectI8), (numBytesI)))
+    (_mm256_alignr_epi8(\
+       (inVectI8),\
+       _mm256_permute2x128_si256((inVectI8),(inVectI8),0x08),\
+       16 - (numBytesI)\
+    ))
 
 #define slvect_vectU8_retVectU8(inVectU8, numBytesI)\
-    (_mm256_slli_si256((inVectU8), (numBytesI)))
+    (slvect_vectI8_retVectI8((inVectU8), (numBytesI)))
 
 #define slvect_vectI16_retVectI16(inVectI16, numShortsI)\
-    (_mm256_slli_si256((inVectI16), (numShortsI) << 1))
+    (slvect_vectI8_retVectI8((inVectI16),(numShortsI) << 1))
 
 #define slvect_vectU16_retVectU16(inVectU16, numShortsI)\
-    (_mm256_slli_si256((inVectU16), (numShortsI) << 1))
+    (slvect_vectI8_retVectI8((inVectU16),(numShortsI) << 1))
 
 #define slvect_vectI32_retVectI32(inVectI32, numIntsI)\
-    (_mm256_slli_si256((inVectI32), (numIntsI) << 2))
+    (slvect_vectI8_retVectI8((inVectI32), (numIntsI) << 2))
 
 #define slvect_vectU32_retVectU32(inVectU32, numIntsI)\
-    (_mm256_slli_si256((inVectU32), (numIntsI) << 2))
+    (slvect_vectI8_retVectI8((inVectU32), (numIntsI) << 2))
 
 /*********************************************************\
 * Sec-02 Sub-06:
@@ -1460,4 +1479,57 @@ typedef __m256i mask32; /*mask of 32 bit values*/
 #define mask16_retVectU16(inMask16) ((vectU16) (inMask16))
 #define mask32_retVectU32(inMask32) ((vectU32) (inMask32))
 
+/*********************************************************\
+* Sec-02 Sub-08:
+*  - Byte shuffles (table lookups) and reverse.
+*    defVectShuffle is defined when these can be used.
+*  o sec-02 sub-08 cat-01:
+*    - Load a 16 byte table for shuffle_vectU8_retVectU8
+*  o sec-02 sub-08 cat-02:
+*    - Look up each byte (0 to 15) in a 16 byte table
+*  o sec-02 sub-08 cat-03:
+*    - Reverse the bytes in a vector
+\*********************************************************/
+
+#define defVectShuffle /*Have byte shuffles*/
+
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++\
++ Sec-02 Sub-08 Cat-01:
++  - Load a 16 byte table for shuffle_vectU8_retVectU8
++  - AVX2 shuffles each 128 bit lane on its own, so the
++    table is copied into both lanes
+\+++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+#define loadTbl_U8Ary_retVectU8(arrayU8) \
+  (_mm256_broadcastsi128_si256(\
+     _mm_loadu_si128((__m128i *) (arrayU8))\
+  ))
+
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++\
++ Sec-02 Sub-08 Cat-02:
++  - Look up each byte (0 to 15) in a 16 byte table
+\+++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+#define shuffle_vectU8_retVectU8(tblVectU8, indexVectU8) \
+  (_mm256_shuffle_epi8((tblVectU8), (indexVectU8)))
+
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++\
++ Sec-02 Sub-08 Cat-03:
++  - Reverse the bytes in a vector
++  - Each lane is reversed and then the lanes are swapped
+\+++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+#define rev_vectU8_retVectU8(inVectU8) \
+  (_mm256_permute4x64_epi64(\
+     _mm256_shuffle_epi8(\
+        (inVectU8),\
+        _mm256_broadcastsi128_si256(\
+          _mm_set_epi8(\
+             0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15\
+          )\
+        )\
+     ),\
+     0x4E\
+  ))
+
 #endif
@@ -67,6 +67,8 @@ typedef __m128i mask32; /*mask of 32 bit values*/
 ^    - Math functions
 ^  o sec-02 sub-07:
 ^    - Casts [for NEON & masks] and Conversions
+^  o sec-02 sub-08:
+^    - Byte shuffles (table lookups) and reverse
 \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
 /*********************************************************\
@@ -221,7 +223,7 @@ typedef __m128i mask32; /*mask of 32 bit values*/
 +  - Store vector ouput into an array (aligned)
 \*+++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 
-#define store_vectI8_retAryI8(retAry, inVectI8) { \
+#define store_vectI8_retAryI8(retAry, inVectI8) \
   (_mm_store_si128((__m128i *) (retAry), (inVectI8)))
 
 #define store_vectI16_retAryI16(retAry, inVectI16) \
@@ -245,7 +247,7 @@ typedef __m128i mask32; /*mask of 32 bit values*/
 +  - Store vector ouput into an array (unaligned)
 \*+++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 
-#define storeu_vectI8_retAryI8(retAry, inVectI8) { \
+#define storeu_vectI8_retAryI8(retAry, inVectI8) \
   (_mm_storeu_si128((__m128i *) (retAry), (inVectI8)))
 
 #define storeu_vectI16_retAryI16(retAry, inVectI16) \
@@ -869,7 +871,7 @@ typedef __m128i mask32; /*mask of 32 bit values*/
          _mm_cmplt_epi8((xVectI8), (yVectI8)); \
       vectI8 xorVectI8 =\
           _mm_xor_si128((xVectI8), (yVectI8));\
-      cmpVectI8 = _mm_xor_si128(cmpVectI8, xorVectI8); \
+      cmpVectI8 = _mm_and_si128(cmpVectI8, xorVectI8); \
       /*At this point the xor value is only kept if
       ` the frist vector is less than the second vector
       */\
@@ -931,7 +933,7 @@ typedef __m128i mask32; /*mask of 32 bit values*/
        _mm_cmplt_epi32((xVectI32), (yVectI32));\
     vectI32 xorVectI32 = \
        _mm_xor_si128((xVectI32), (yVectI32));\
-    cmpVectI32 = _mm_xor_si128(cmpVectI32, xorVectI32); \
+    cmpVectI32 = _mm_and_si128(cmpVectI32, xorVectI32); \
       /*At this point the xor value is only kept if
       ` the frist vector is less than the second vector
       */\
@@ -987,7 +989,7 @@ typedef __m128i mask32; /*mask of 32 bit values*/
 
 #ifdef SSE4
    #define min_vectI8_retVectI8(xVectI8,yVectI8) \
-      (_mm_min_epi8((xVectI8), (yVectI8));)
+      (_mm_min_epi8((xVectI8), (yVectI8)))
 #else
    /*SSE2 does not support I8 min, So I need to do a
    ` branchless min
@@ -997,7 +999,7 @@ typedef __m128i mask32; /*mask of 32 bit values*/
          _mm_cmplt_epi8((xVectI8), (yVectI8)); \
       vectI8 xorVectI8 = \
          _mm_xor_si128((xVectI8), (yVectI8)); \
-      cmpVectI8 = _mm_xor_si128(cmpVectI8, xorVectI8); \
+      cmpVectI8 = _mm_and_si128(cmpVectI8, xorVectI8); \
       /*At this point the xor value is only kept if
       ` the frist vector is less than the second vector
       */\
@@ -1044,7 +1046,7 @@ typedef __m128i mask32; /*mask of 32 bit values*/
        _mm_cmplt_epi32((xVectI32), (yVectI32));\
     vectI32 xorVectI32 = \
        _mm_xor_si128((xVectI32), (yVectI32));\
-    cmpVectI32 = _mm_xor_si128(cmpVectI32, xorVectI32); \
+    cmpVectI32 = _mm_and_si128(cmpVectI32, xorVectI32); \
       /*At this point the xor value is only kept if
       ` the frist vector is less than the second vector
       */\
@@ -1663,4 +1665,50 @@ typedef __m128i mask32; /*mask of 32 bit values*/
 #define mask16_retVectU16(inMask16) ((vectU16) (inMask16))
 #define mask32_retVectU32(inMask32) ((vectU32) (inMask32))
 
+/*********************************************************\
+* Sec-02 Sub-08:
+*  - Byte shuffles (table lookups) and reverse. These
+*    need SSSE3, so they are only in SSE4 builds.
+*    defVectShuffle is defined when these can be used.
+*  o sec-02 sub-08 cat-01:
+*    - Load a 16 byte table for shuffle_vectU8_retVectU8
+*  o sec-02 sub-08 cat-02:
+*    - Look up each byte (0 to 15) in a 16 byte table
+*  o sec-02 sub-08 cat-03:
+*    - Reverse the bytes in a vector
+\*********************************************************/
+
+#ifdef SSE4
+
+#define defVectShuffle /*Have byte shuffles*/
+
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++\
++ Sec-02 Sub-08 Cat-01:
++  - Load a 16 byte table for shuffle_vectU8_retVectU8
+\+++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+#define loadTbl_U8Ary_retVectU8(arrayU8) \
+  (_mm_loadu_si128((__m128i *) (arrayU8)))
+
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++\
++ Sec-02 Sub-08 Cat-02:
++  - Look up each byte (0 to 15) in a 16 byte table
+\+++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+#define shuffle_vectU8_retVectU8(tblVectU8, indexVectU8) \
+  (_mm_shuffle_epi8((tblVectU8), (indexVectU8)))
+
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++\
++ Sec-02 Sub-08 Cat-03:
++  - Reverse the bytes in a vector
+\+++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+#define rev_vectU8_retVectU8(inVectU8) \
+  (_mm_shuffle_epi8(\
+     (inVectU8),\
+     _mm_set_epi8(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15)\
+  ))
+
+#endif /*SSE4 (SSSE3) only*/
+
 #endif
@@ -27,10 +27,9 @@
 | Fun-01: waterMaxScore
 |   - Maximizes the score for a single waterman alignment
 | Input;
-|   - refBase;
-|     o Reference base to find score for
-|   - qryBase;
-|     o Query base to find score for
+|   - baseScore;
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - gapDiff:
 |     o Gap Exentsion score - gap open score.
 |     o This is used to find the indel scores
@@ -54,8 +53,7 @@
 |     o delScore to hold the score for the next deletion
 \-------------------------------------------------------*/
 #define waterMaxScore(\
-   refBase,     /*Reference Base*/\
-   qryBase,     /*Query Base*/\
+   baseScore,   /*Score for ref/query bases*/\
    gapDiff,     /*GapExtend - gapOpen*/\
    scoreOn,     /*Score to update*/\
    dirOn,       /*Direction to update*/\
@@ -66,7 +64,7 @@
 ){ /*waterMaxScore*/\
    long macroSnpScoreL =\
         (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
     \
     long macroInsScoreL =\
          (scoreOn)\
@@ -93,7 +91,7 @@
     \
     (delScore) =\
          (scoreOn)\
-       + ((gapDiff) & (-(dirOn) != defMvSnp))\
+       + ((gapDiff) & (-((dirOn) != defMvSnp)))\
        + (alnSetPtr)->gapOpenC;\
 } /*waterMaxScore*/
 
@@ -103,10 +101,9 @@
 |   - This for the end of a row, were you do not want the
 |     next snp or deletion score
 | Input;
-|   - refBase;
-|     o Reference base to find score for
-|   - qryBase;
-|     o Query base to find score for
+|   - baseScore;
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - gapDiff:
 |     o Gap Exentsion score - gap open score.
 |     o This is used to find the indel scores
@@ -125,8 +122,7 @@
 |     o dirOn to hold the direction of the max score
 \-------------------------------------------------------*/
 #define waterMaxEndRowScore(\
-   refBase,     /*Reference Base*/\
-   qryBase,     /*Query Base*/\
+   baseScore,   /*Score for ref/query bases*/\
    gapDiff,    /*GapExtend - gapOpen*/\
    scoreOn,     /*Score to update*/\
    dirOn,       /*Direction to update*/\
@@ -137,7 +133,7 @@
 ){ /*waterMaxEndRowScore*/\
    long macroSnpScoreL =\
       (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
     \
     long macroInsScoreL =\
          (scoreOn)\
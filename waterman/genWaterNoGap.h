@@ -30,10 +30,9 @@
 |   - Maximizes the score for a single waterman alignment
 |     without using the gap extension penalty
 | Input;
-|   - refBase;
-|     o Reference base to find score for
-|   - qryBase;
-|     o Query base to find score for
+|   - baseScore;
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - scoreOn:
 |     o Score to update/score for an insertion
 |   - dirOn;
@@ -54,8 +53,7 @@
 |     o delScore to hold the score for the next deletion
 \-------------------------------------------------------*/
 #define waterMaxScoreNoGap(\
-   refBase,     /*Reference Base*/\
-   qryBase,     /*Query Base*/\
+   baseScore,   /*Score for ref/query bases*/\
    scoreOn,     /*Score to update*/\
    dirOn,       /*Direction to update*/\
    insDir,      /*Insertion direction*/\
@@ -65,7 +63,7 @@
 ){ /*waterMaxScoreNoGap*/\
    long macroSnpScoreL =\
         (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
     \
     long macroInsScoreL =\
          (scoreOn) + (alnSetPtr)->gapOpenC;\
@@ -99,10 +97,9 @@
 |   - This for the end of a row, were you do not want the
 |     next snp or deletion score
 | Input;
-|   - refBase;
-|     o Reference base to find score for
-|   - qryBase;
-|     o Query base to find score for
+|   - baseScore;
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - scoreOn:
 |     o Score to update/score for an insertion
 |   - dirOn;
@@ -118,8 +115,7 @@
 |     o dirOn to hold the direction of the max score
 \-------------------------------------------------------*/
 #define waterMaxEndRowScoreNoGap(\
-   refBase,     /*Reference Base*/\
-   qryBase,     /*Query Base*/\
+   baseScore,   /*Score for ref/query bases*/\
    scoreOn,     /*Score to update*/\
    dirOn,       /*Direction to update*/\
    insDir,      /*Insertion direction*/\
@@ -129,7 +125,7 @@
 ){ /*waterMaxEndRowScoreNoGap*/\
    long macroSnpScoreL =\
       (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
     \
     long macroInsScoreL =\
          (scoreOn) + (alnSetPtr)->gapOpenC;\
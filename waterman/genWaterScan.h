@@ -43,10 +43,9 @@
 |   - Maximizes the score for a single base pair in an
 |     waterman query reference scan
 | Input;
-|   - refBase;
-|     o Reference base to find score for
-|   - qryBase;
-|     o Query base to find score for
+|   - baseScore;
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - gapDiff:
 |     o Gap Exentsion score - gap open score.
 |     o This is used to find the indel scores
@@ -70,8 +69,7 @@
 |     o delScore to hold the score for the next deletion
 \-------------------------------------------------------*/
 #define waterMatrixScanMaxScore(\
-   refBase,     /*Reference Base*/\
-   qryBase,     /*Query Base*/\
+   baseScore,   /*Score for ref/query bases*/\
    gapDiff,    /*GapExtend - gapOpen*/\
    scoreOn,     /*Score to update*/\
    dirOn,       /*Direction to update*/\
@@ -87,7 +85,7 @@
 ){ /*waterScanMaxScore*/\
    long macroSnpScoreL =\
         (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
     \
     long macroInsScoreL =\
          (scoreOn)\
@@ -121,7 +119,7 @@
     \
     (delScore) =\
          (scoreOn)\
-       + ((gapDiff) & (-(dirOn) != defMvSnp))\
+       + ((gapDiff) & (-((dirOn) != defMvSnp)))\
        + (alnSetPtr)->gapOpenC;\
 } /*waterScanMaxScore*/
 
@@ -131,10 +129,9 @@
 |   - This for the end of a row, were you do not want the
 |     next snp or deletion score
 | Input;
-|   - refBase;
-|     o Reference base to find score for
-|   - qryBase;
-|     o Query base to find score for
+|   - baseScore;
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - gapDiff:
 |     o Gap Exentsion score - gap open score.
 |     o This is used to find the indel scores
@@ -153,8 +150,7 @@
 |     o dirOn to hold the direction of the max score
 \-------------------------------------------------------*/
 #define waterMatrixScanMaxEndRow(\
-   refBase,     /*Reference Base*/\
-   qryBase,     /*Query Base*/\
+   baseScore,   /*Score for ref/query bases*/\
    gapDiff,    /*GapExtend - gapOpen*/\
    scoreOn,     /*Score to update*/\
    dirOn,       /*Direction to update*/\
@@ -170,7 +166,7 @@
 ){ /*waterMaxEndRowScore*/\
    long macroSnpScoreL =\
       (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
     \
     long macroInsScoreL =\
          (scoreOn)\
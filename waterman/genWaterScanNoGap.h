@@ -47,10 +47,9 @@
 |     waterman query reference scan. This does not use
 |     gap extension penalties
 | Input;
-|   - refBase;
-|     o Reference base to find score for
-|   - qryBase;
-|     o Query base to find score for
+|   - baseScore;
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - scoreOn:
 |     o Score to update/score for an insertion
 |   - dirOn;
@@ -71,8 +70,7 @@
 |     o delScore to hold the score for the next deletion
 \-------------------------------------------------------*/
 #define waterMatrixScanMaxScoreNoGap(\
-   refBase,     /*Reference Base*/\
-   qryBase,     /*Query Base*/\
+   baseScore,   /*Score for ref/query bases*/\
    scoreOn,     /*Score to update*/\
    dirOn,       /*Direction to update*/\
    insDir,      /*Previous ins direction*/\
@@ -87,7 +85,7 @@
 ){ /*waterScanMaxScoreNoGap*/\
    long macroSnpScoreL =\
         (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
     \
     long macroInsScoreL =\
          (scoreOn) + (alnSetPtr)->gapOpenC;\
@@ -128,10 +126,9 @@
 |   - This for the end of a row, were you do not want the
 |     next snp or deletion score
 | Input;
-|   - refBase;
-|     o Reference base to find score for
-|   - qryBase;
-|     o Query base to find score for
+|   - baseScore;
+|     o Score for the reference and query bases (from
+|       the score profile row, see getScoreProfRow)
 |   - scoreOn:
 |     o Score to update/score for an insertion
 |   - dirOn;
@@ -147,8 +144,7 @@
 |     o dirOn to hold the direction of the max score
 \-------------------------------------------------------*/
 #define waterMatrixScanMaxEndRowNoGap(\
-   refBase,     /*Reference Base*/\
-   qryBase,     /*Query Base*/\
+   baseScore,   /*Score for ref/query bases*/\
    scoreOn,     /*Score to update*/\
    dirOn,       /*Direction to update*/\
    insDir,      /*Direction of last insertion*/\
@@ -163,7 +159,7 @@
 ){ /*waterMaxEndRowScoreNoGap*/\
    long macroSnpScoreL =\
       (nextSnpScore)\
-      + getBaseScore((qryBase), (refBase), (alnSetPtr));\
+      + (baseScore);\
     \
     long macroInsScoreL =\
          (scoreOn) + (alnSetPtr)->gapOpenC;\
@@ -0,0 +1,560 @@
+/*########################################################
+# Name: waterDrop
+# Use:
+#  - Does a Waterman alignment (WatermanAln, WaterScan,
+#    memWater, or memWaterScan) that stops scoring cells
+#    once they fall to far below the best score
+#    (-x-drop and -z-drop).
+#  - X-drop (xDropL): cells more than xDropL below the
+#    best score are set to a stop. Once the best score is
+#    more than xDropL above the best match score, no new
+#    alignment can start, so each row only scores the
+#    cells next to the live (score > 0) cells in the last
+#    row. The alignment ends when a row has no live cells.
+#  - Z-drop (zDropL): the alignment ends when the best
+#    score in a row is more than zDropL + gap extension *
+#    (distance between the best cell and the rows best
+#    cell diagonals) below the best score. This is done
+#    by row (not anti-diagonal) to match the other
+#    Waterman aligners.
+#  - Cells that are never scored are stops (0), so the
+#    direction matrix and start indexes are the same as
+#    the full aligners when neither drop is hit.
+#  - -no-gap-extend is done by setting the gap extension
+#    penalty to the gap opening penalty
+# Libraries:
+#  - "../general/genScan.h"           (No .c File)
+#  o "../general/alnMatrixStruct.h"   (No .c File)
+#  o "../general/twoBitArrays.h"      (No .c File)
+#  o "../general/dataTypeShortHand.h" (No .c File)
+#  o "../general/genMath.h"           (No .c File)
+#  - "../general/alnSetStruct.h"      (No .c File)
+#  o "../general/alnSeqDefaults.h"    (No .c File)
+#  - "../general/seqStruct.h"         (No .c File)
+# C Standard Libraries:
+#  o <stdlib.h>
+#  - <stdio.h>
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Includes
+'  o macro-01 waterDropMaxMatch:
+'    - Finds the highest score in the scoring matrix
+'  o macro-02 waterDropPStats:
+'    - Prints the number of cells scored to a file
+'  o fun-03 waterDrop:
+'    - Does a Waterman alignment with X-drop and Z-drop
+'      early stops
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes
+\-------------------------------------------------------*/
+
+#ifndef WATER_DROP_H
+#define WATER_DROP_H
+
+#include <stdio.h>
+
+#include "../general/genScan.h"
+#include "../general/alnSetStruct.h"
+#include "../general/seqStruct.h"
+
+/*-------------------------------------------------------\
+| Macro-01: waterDropMaxMatch
+|   - Finds the highest score in the scoring matrix
+| Input:
+|   - settings:
+|     o Pointer to an alnSet with the scoring matrix
+|   - retL:
+|     o long to hold the highest score
+| Output:
+|   - Modifies:
+|     o retL to have the highest score
+\-------------------------------------------------------*/
+#define waterDropMaxMatch(settings, retL){\
+   uint macroColUI = 0;\
+   uint macroRowUI = 0;\
+   char *macroRowC = 0;\
+   \
+   (retL) = (settings)->scoreMatrixC[0][0];\
+   \
+   for(\
+      macroColUI = 0;\
+      macroColUI < defMatrixCol;\
+      ++macroColUI\
+   ){ /*Loop: Check each column*/\
+      macroRowC = (settings)->scoreMatrixC[macroColUI];\
+      \
+      for(\
+         macroRowUI = 0;\
+         macroRowUI < defMatrixCol;\
+         ++macroRowUI\
+      ){ /*Loop: Check each row*/\
+         if((retL) < macroRowC[macroRowUI])\
+            (retL) = macroRowC[macroRowUI];\
+      } /*Loop: Check each row*/\
+   } /*Loop: Check each column*/\
+} /*waterDropMaxMatch*/
+
+/*-------------------------------------------------------\
+| Macro-02: waterDropPStats
+|   - Prints the number of cells scored by waterDrop to a
+|     file (-stats)
+| Input:
+|   - matrixST:
+|     o Pointer to the alnMatrix returned by waterDrop
+|   - outFILE:
+|     o File to print the number of cells to
+| Output:
+|   - Prints:
+|     o Cells scored and cells in the full matrix. Nothing
+|       is printed if the cells were not counted (not
+|       from waterDrop).
+\-------------------------------------------------------*/
+#define waterDropPStats(matrixST, outFILE){\
+   if((matrixST)->cellsScoredUL != 0)\
+      fprintf(\
+         (outFILE),\
+         "Cells scored: %lu of %lu\n",\
+         (matrixST)->cellsScoredUL,\
+         (matrixST)->lenRefUL * (matrixST)->lenQryUL\
+      );\
+} /*waterDropPStats*/
+
+/*-------------------------------------------------------\
+| Fun-03: waterDrop
+|   - Does a Waterman alignment with X-drop and Z-drop
+|     early stops (-x-drop/-z-drop)
+| Input:
+|   - qryST:
+|     o seqStruct with the query sequence and index 0
+|       coordinates to start (offsetUL)/end (endAlnUL)
+|       the alignment
+|   - refST:
+|     o seqStruct with the reference sequence and index 0
+|       coordinates to start (offsetUL)/end (endAlnUL)
+|       the alignment
+|   - dirBl:
+|     o 1: Fill in a direction matrix (WatermanAln)
+|     o 0: Only find the start and end (memWater)
+|   - scanBl:
+|     o 1: Keep the best score for each reference and
+|          query base (WaterScan/memWaterScan)
+|     o 0: Only keep the best score
+|   - settings:
+|     o alnSet with the scoring matrix, gap penalties,
+|       and the X-drop (xDropL) and Z-drop (zDropL)
+| Output:
+|   - Returns:
+|     o alnMatrix with the best score, the start and end
+|       indexes, the direction matrix (dirBl), the
+|       alternative scores (scanBl), and the number of
+|       cells scored (cellsScoredUL)
+|     o 0 for memory errors
+\-------------------------------------------------------*/
+static struct alnMatrix * waterDrop(
+   struct seqStruct *qryST,
+   struct seqStruct *refST,
+   char dirBl,
+   char scanBl,
+   struct alnSet *settings
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-03 TOC: waterDrop
+   '  - Does a Waterman alignment with X-drop and Z-drop
+   '    early stops
+   '  o fun-03 sec-01:
+   '    - Variable declerations
+   '  o fun-03 sec-02:
+   '    - Allocate memory
+   '  o fun-03 sec-03:
+   '    - Fill in the matrix
+   '  o fun-03 sec-04:
+   '    - Clean up and find the best score
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-03 Sec-01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   char *refSeqStr = 0;
+   char *qrySeqStr = 0;
+   char *profRowC = 0; /*Scores for a query base*/
+
+   ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
+   ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
+   ulong lenMatrixUL = (lenRefUL + 1) * (lenQryUL + 1);
+
+   ulong ulRef = 0;
+   ulong ulQry = 0;
+
+   /*Scoring variables*/
+   long delScoreL = 0;    /*Score for doing an deletion*/
+   long nextSnpScoreL = 0;/*Score for the next match/snp*/
+   long *scoreAryL = 0;   /*Last row/current row scores*/
+   short gapDiffS =
+      settings->gapExtendC - settings->gapOpenC;
+   long gapExtendL = settings->gapExtendC;
+
+   /*Directions and start indexes*/
+   struct alnMatrix *retMatrixST = 0;
+   char *dirMatrix = 0;
+   char *dirRow = 0;
+   ulong indexUL = 0;
+   ulong *indexAryUL = 0;
+   ulong *oldIndexAryUL = 0;
+   ulong *swapPtrUL = 0;
+
+   /*Alternative alignments (scanBl)*/
+   long *refScoreAryL = 0;
+   ulong *refIndexAryUL = 0;
+   ulong *refEndIndexAryUL = 0;
+   long *qryScoreAryL = 0;
+   ulong *qryIndexAryUL = 0;
+   ulong *qryEndIndexAryUL = 0;
+
+   /*X-drop and Z-drop variables*/
+   long maxMatchL = 0;  /*Highest score for a match*/
+   long dropScoreL = 0; /*Cells below this are stops*/
+   long rowMaxL = 0;    /*Best score in the current row*/
+   ulong rowMaxRefUL = 0;
+   ulong bestRefUL = 0; /*Reference base of best score*/
+   ulong bestQryUL = 0; /*Query base of best score*/
+   long diagDiffL = 0;  /*Diagonals from the best score*/
+
+   ulong firstRefUL = 1; /*First cell to score in a row*/
+   ulong lastRefUL = 0;  /*Last cell to score in a row*/
+   ulong firstLiveUL = 0;/*First cell with a score > 0*/
+   ulong lastLiveUL = 0; /*Last cell with a score > 0*/
+
+   if(settings->noGapBl)
+   { /*If: not using gap extension penalties*/
+      gapDiffS = 0;
+      gapExtendL = settings->gapOpenC;
+   } /*If: not using gap extension penalties*/
+
+   if(gapExtendL < 0) gapExtendL = -gapExtendL;
+   waterDropMaxMatch(settings, maxMatchL);
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-03 Sec-02:
+   ^  - Allocate memory
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         lenQryUL,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
+   retMatrixST = malloc(sizeof(struct alnMatrix));
+   if(retMatrixST == 0) return 0;
+   initAlnMatrix(retMatrixST);
+
+   retMatrixST->lenRefUL = lenRefUL;
+   retMatrixST->refOffsetUL = refST->offsetUL;
+   retMatrixST->lenQryUL = lenQryUL;
+   retMatrixST->qryOffsetUL = qryST->offsetUL;
+
+   if(dirBl)
+   { /*If: keeping the direction matrix*/
+      /*calloc, so cells that are not scored are stops*/
+      dirMatrix = calloc(lenMatrixUL + 1, sizeof(char));
+      retMatrixST->dirMatrix = dirMatrix;
+      if(dirMatrix == 0) goto memErr;
+   } /*If: keeping the direction matrix*/
+
+   if(scanBl)
+   { /*If: keeping the best score for each base*/
+      retMatrixST->lenArraysUL = lenRefUL + lenQryUL + 1;
+
+      refScoreAryL =
+         calloc(retMatrixST->lenArraysUL, sizeof(long));
+      retMatrixST->scoreAryL = refScoreAryL;
+      if(refScoreAryL == 0) goto memErr;
+
+      refIndexAryUL =
+         calloc(retMatrixST->lenArraysUL, sizeof(ulong));
+      retMatrixST->startIndexAryUL = refIndexAryUL;
+      if(refIndexAryUL == 0) goto memErr;
+
+      refEndIndexAryUL =
+         calloc(retMatrixST->lenArraysUL, sizeof(ulong));
+      retMatrixST->endIndexAryUL = refEndIndexAryUL;
+      if(refEndIndexAryUL == 0) goto memErr;
+
+      /*WaterScan starts the query scores on the last
+      ` reference score; memWaterScan starts them after it
+      */
+      ulRef = lenRefUL + !dirBl;
+      qryScoreAryL = refScoreAryL + ulRef;
+      qryIndexAryUL = refIndexAryUL + ulRef;
+      qryEndIndexAryUL = refEndIndexAryUL + ulRef;
+   } /*If: keeping the best score for each base*/
+
+   scoreAryL = calloc(lenRefUL + 1, sizeof(long));
+   dirRow = malloc((lenRefUL + 1) * sizeof(char));
+   indexAryUL = malloc((lenRefUL + 1) * sizeof(ulong));
+   oldIndexAryUL = malloc((lenRefUL + 1) * sizeof(ulong));
+
+   if(
+         scoreAryL == 0
+      || dirRow == 0
+      || indexAryUL == 0
+      || oldIndexAryUL == 0
+   ) goto memErr;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-03 Sec-03:
+   ^  - Fill in the matrix
+   ^  o fun-03 sec-03 sub-01:
+   ^    - Set up the gap row
+   ^  o fun-03 sec-03 sub-02:
+   ^    - Score the cells in a row
+   ^  o fun-03 sec-03 sub-03:
+   ^    - Check if the cell dropped and keep best scores
+   ^  o fun-03 sec-03 sub-04:
+   ^    - Check for a Z-drop and find the next rows cells
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*****************************************************\
+   * Fun-03 Sec-03 Sub-01:
+   *  - Set up the gap row
+   \*****************************************************/
+
+   for(indexUL = 0; indexUL <= lenRefUL; ++indexUL)
+   { /*Loop: Set up the gap row*/
+      dirRow[indexUL] = defMvStop;
+      oldIndexAryUL[indexUL] = indexUL;
+   } /*Loop: Set up the gap row*/
+
+   lastRefUL = lenRefUL;
+   refSeqStr = refST->seqCStr + refST->offsetUL - 1;
+   qrySeqStr = qryST->seqCStr + qryST->offsetUL;
+
+   /*****************************************************\
+   * Fun-03 Sec-03 Sub-02:
+   *  - Score the cells in a row
+   \*****************************************************/
+
+   for(ulQry = 0; ulQry < lenQryUL; ++ulQry)
+   { /*Loop: Score each row (query base)*/
+      profRowC =
+         getScoreProfRow(
+            qrySeqStr[ulQry],
+            refSeqStr,
+            settings
+         ); /*Scores for this query base*/
+
+      /*The cell before the first cell is a stop (gap
+      ` column or a dropped cell), so it is its own start
+      */
+      indexUL = (ulQry + 1) * (lenRefUL + 1) + firstRefUL;
+      indexAryUL[firstRefUL - 1] = indexUL - 1;
+      nextSnpScoreL = scoreAryL[firstRefUL - 1];
+      delScoreL = 0;
+
+      firstLiveUL = 0;
+      lastLiveUL = 0;
+      rowMaxL = 0;
+
+      ulRef = firstRefUL;
+
+      /*Cells past lastRefUL can only be kept by a
+      ` deletion from a live cell
+      */
+      while(
+            ulRef <= lenRefUL
+         && (ulRef <= lastRefUL || scoreAryL[ulRef - 1] > 0)
+      ){ /*Loop: Score the live cells in this row*/
+         waterScanMaxScore(
+            profRowC[ulRef],
+            gapDiffS,
+            scoreAryL[ulRef],
+            dirRow[ulRef],
+            indexAryUL[ulRef],
+            nextSnpScoreL,
+            delScoreL,
+            oldIndexAryUL[ulRef - 1],
+            oldIndexAryUL[ulRef],
+            indexAryUL[ulRef - 1],
+            indexUL,
+            settings
+         );
+
+         /***********************************************\
+         * Fun-03 Sec-03 Sub-03:
+         *  - Check if the cell dropped and keep scores
+         \***********************************************/
+
+         if(scoreAryL[ulRef] < dropScoreL)
+         { /*If: the cell is to far below the best*/
+            scoreAryL[ulRef] = 0;
+            dirRow[ulRef] = defMvStop;
+            indexAryUL[ulRef] = indexUL;
+            delScoreL = settings->gapOpenC + gapDiffS;
+         } /*If: the cell is to far below the best*/
+
+         if(scoreAryL[ulRef] > 0)
+         { /*If: this cell is still alive*/
+            if(firstLiveUL == 0) firstLiveUL = ulRef;
+            lastLiveUL = ulRef;
+
+            if(rowMaxL < scoreAryL[ulRef])
+            { /*If: this is the best score in the row*/
+               rowMaxL = scoreAryL[ulRef];
+               rowMaxRefUL = ulRef;
+            } /*If: this is the best score in the row*/
+
+            if(retMatrixST->bestScoreL < scoreAryL[ulRef])
+            { /*If: this is the best score*/
+               retMatrixST->bestScoreL = scoreAryL[ulRef];
+
+               retMatrixST->bestStartIndexUL =
+                  indexAryUL[ulRef];
+
+               retMatrixST->bestEndIndexUL = indexUL;
+               bestRefUL = ulRef;
+               bestQryUL = ulQry;
+
+               if(settings->xDropL)
+                  dropScoreL =
+                     retMatrixST->bestScoreL
+                   - settings->xDropL;
+            } /*If: this is the best score*/
+         } /*If: this cell is still alive*/
+
+         if(scanBl)
+         { /*If: keeping the best score for each base*/
+            if(ulRef < lenRefUL / 2)
+            { /*If: in the first half of the reference*/
+               scanIfKeepScoreRef(
+                  scoreAryL[ulRef],
+                  dirRow[ulRef],
+                  indexAryUL[ulRef],
+                  indexUL,
+                  refScoreAryL[ulRef],
+                  refIndexAryUL[ulRef],
+                  refEndIndexAryUL[ulRef],
+                  qryScoreAryL[ulQry],
+                  qryIndexAryUL[ulQry],
+                  qryEndIndexAryUL[ulQry]
+               );
+            } /*If: in the first half of the reference*/
+
+            else
+            { /*Else: in the second half of the reference*/
+               scanIfKeepScoreQry(
+                  scoreAryL[ulRef],
+                  dirRow[ulRef],
+                  indexAryUL[ulRef],
+                  indexUL,
+                  refScoreAryL[ulRef],
+                  refIndexAryUL[ulRef],
+                  refEndIndexAryUL[ulRef],
+                  qryScoreAryL[ulQry],
+                  qryIndexAryUL[ulQry],
+                  qryEndIndexAryUL[ulQry]
+               );
+            } /*Else: in the second half of the reference*/
+         } /*If: keeping the best score for each base*/
+
+         if(dirBl) dirMatrix[indexUL] = dirRow[ulRef];
+
+         ++retMatrixST->cellsScoredUL;
+         ++indexUL;
+         ++ulRef;
+      } /*Loop: Score the live cells in this row*/
+
+      /*Swap index arrays so the current is last*/
+      swapPtrUL = indexAryUL;
+      indexAryUL = oldIndexAryUL;
+      oldIndexAryUL = swapPtrUL;
+
+      /**************************************************\
+      * Fun-03 Sec-03 Sub-04:
+      *  - Check for a Z-drop and find the next rows cells
+      \**************************************************/
+
+      if(settings->zDropL && retMatrixST->bestScoreL > 0)
+      { /*If: checking for a Z-drop*/
+         diagDiffL =
+              ((long) ulQry - (long) bestQryUL)
+            - ((long) rowMaxRefUL - (long) bestRefUL);
+
+         if(diagDiffL < 0) diagDiffL = -diagDiffL;
+         if(rowMaxL == 0) diagDiffL = 0; /*No live cells*/
+
+         if(
+              retMatrixST->bestScoreL - rowMaxL
+            > settings->zDropL + gapExtendL * diagDiffL
+         ) break; /*The alignment dropped to far*/
+      } /*If: checking for a Z-drop*/
+
+      /*Once the best score is more than X above a match,
+      ` only cells next to live cells can be kept
+      */
+      if(
+            settings->xDropL
+         && retMatrixST->bestScoreL - settings->xDropL
+            > maxMatchL
+      ){ /*If: new alignments can not start*/
+         if(firstLiveUL == 0) break; /*Nothing left*/
+
+         firstRefUL = firstLiveUL;
+         lastRefUL = lastLiveUL + 1;
+      } /*If: new alignments can not start*/
+   } /*Loop: Score each row (query base)*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-03 Sec-04:
+   ^  - Clean up and find the best score
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   free(scoreAryL);
+   free(dirRow);
+   free(indexAryUL);
+   free(oldIndexAryUL);
+
+   if(scanBl)
+   { /*If: the best score is from the kept scores*/
+      retMatrixST->bestScoreL = 0;
+
+      for(
+         ulRef = 0;
+         ulRef < retMatrixST->lenArraysUL;
+         ++ulRef
+      ){ /*Loop: Find the highest score*/
+         if(refScoreAryL[ulRef] > retMatrixST->bestScoreL)
+         { /*If: I have a new best score*/
+            retMatrixST->bestScoreL = refScoreAryL[ulRef];
+
+            retMatrixST->bestStartIndexUL =
+               refIndexAryUL[ulRef];
+
+            retMatrixST->bestEndIndexUL =
+               refEndIndexAryUL[ulRef];
+         } /*If: I have a new best score*/
+      } /*Loop: Find the highest score*/
+   } /*If: the best score is from the kept scores*/
+
+   return retMatrixST;
+
+   memErr:
+      free(scoreAryL);
+      free(dirRow);
+      free(indexAryUL);
+      free(oldIndexAryUL);
+      freeAlnMatrix(retMatrixST);
+      return 0;
+} /*waterDrop*/
+
+#endif
@@ -87,6 +87,7 @@ static struct alnMatrix * WaterScan(
    /*Get start & end of query and reference sequences*/
    char *refSeqStr = 0;
    char *qrySeqStr = 0;
+   char *profRowC = 0; /*Scores for a query base*/
 
    /*Find the length of the reference and query*/
    ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
@@ -158,6 +159,17 @@ static struct alnMatrix * WaterScan(
    *  - Allocate memory for the alignment
    \*****************************************************/
 
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         qryST->endAlnUL - qryST->offsetUL + 1,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
    retMatrixST = malloc(sizeof(struct alnMatrix));
    if(retMatrixST == 0) return 0;
    initAlnMatrix(retMatrixST);
@@ -330,6 +342,12 @@ static struct alnMatrix * WaterScan(
       ulQry < lenQryUL;
       ++ulQry
    ){ /*Loop: compare query base against all ref bases*/
+      profRowC =
+         getScoreProfRow(
+            qrySeqStr[ulQry],
+            refSeqStr,
+            settings
+         ); /*Scores for this query base*/
 
       for(
          ulRef = 1;
@@ -338,8 +356,7 @@ static struct alnMatrix * WaterScan(
       ){ /* Loop: Check the 1st half of reference bases*/
 
          waterMatrixScanMaxScore(
-            refSeqStr[ulRef],
-            qrySeqStr[ulQry],
+            profRowC[ulRef],
             gapDiffS,
             scoreAryL[ulRef],
             dirMatrix[ulRef],
@@ -381,8 +398,7 @@ static struct alnMatrix * WaterScan(
          ++ulRef
       ){ /* Loop: Check last half of reference bases*/
          waterMatrixScanMaxScore(
-            refSeqStr[ulRef],
-            qrySeqStr[ulQry],
+            profRowC[ulRef],
             gapDiffS,
             scoreAryL[ulRef],
             dirMatrix[ulRef],
@@ -419,8 +435,7 @@ static struct alnMatrix * WaterScan(
       \***************************************************/
 
       waterMatrixScanMaxEndRow(
-         refSeqStr[ulRef],
-         qrySeqStr[ulQry],
+         profRowC[ulRef],
          gapDiffS,
          scoreAryL[ulRef],
          dirMatrix[ulRef],
@@ -473,6 +488,9 @@ static struct alnMatrix * WaterScan(
       indexAryUL = oldIndexAryUL;
       oldIndexAryUL = swapPtrUL;
 
+      /*The gap column is a stop, so it is its own start*/
+      indexAryUL[0] = indexUL;
+
       ++indexUL; /*Set index for the next base pair*/
      /*At this piont insDir is on the second base*/
    } /*loop; compare query base against all ref bases*/
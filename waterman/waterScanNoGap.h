@@ -89,6 +89,7 @@ static struct alnMatrix * WaterScanNoGap(
    /*Get start & end of query and reference sequences*/
    char *refSeqStr = 0;
    char *qrySeqStr = 0;
+   char *profRowC = 0; /*Scores for a query base*/
 
    /*Find the length of the reference and query*/
    ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
@@ -156,6 +157,17 @@ static struct alnMatrix * WaterScanNoGap(
    *  - Allocate memory for the alignment
    \*****************************************************/
 
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         qryST->endAlnUL - qryST->offsetUL + 1,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
    retMatrixST = malloc(sizeof(struct alnMatrix));
    if(retMatrixST == 0) return 0;
    initAlnMatrix(retMatrixST);
@@ -328,6 +340,12 @@ static struct alnMatrix * WaterScanNoGap(
       ulQry < lenQryUL;
       ++ulQry
    ){ /*Loop: compare query base against all ref bases*/
+      profRowC =
+         getScoreProfRow(
+            qrySeqStr[ulQry],
+            refSeqStr,
+            settings
+         ); /*Scores for this query base*/
 
       for(
          ulRef = 1;
@@ -336,8 +354,7 @@ static struct alnMatrix * WaterScanNoGap(
       ){ /* Loop: Check the 1st half of reference bases*/
 
          waterMatrixScanMaxScoreNoGap(
-            refSeqStr[ulRef],
-            qrySeqStr[ulQry],
+            profRowC[ulRef],
             scoreAryL[ulRef],
             dirMatrix[ulRef],
             insDir[ulRef],
@@ -378,8 +395,7 @@ static struct alnMatrix * WaterScanNoGap(
          ++ulRef
       ){ /* Loop: Check last half of reference bases*/
          waterMatrixScanMaxScoreNoGap(
-            refSeqStr[ulRef],
-            qrySeqStr[ulQry],
+            profRowC[ulRef],
             scoreAryL[ulRef],
             dirMatrix[ulRef],
             insDir[ulRef],
@@ -415,8 +431,7 @@ static struct alnMatrix * WaterScanNoGap(
       \***************************************************/
 
       waterMatrixScanMaxEndRowNoGap(
-         refSeqStr[ulRef],
-         qrySeqStr[ulQry],
+         profRowC[ulRef],
          scoreAryL[ulRef],
          dirMatrix[ulRef],
          insDir[ulRef],
@@ -468,6 +483,9 @@ static struct alnMatrix * WaterScanNoGap(
       indexAryUL = oldIndexAryUL;
       oldIndexAryUL = swapPtrUL;
 
+      /*The gap column is a stop, so it is its own start*/
+      indexAryUL[0] = indexUL;
+
       ++indexUL; /*Set index for the next base pair*/
      /*At this piont insDir is on the second base*/
    } /*loop; compare query base against all ref bases*/
@@ -90,6 +90,7 @@ static struct alnMatrixTwoBit * WaterScanTwoBit(
    /*Get start & end of query and reference sequences*/
    char *refSeqStr = 0;
    char *qrySeqStr = 0;
+   char *profRowC = 0; /*Scores for a query base*/
 
    /*Find the length of the reference and query*/
    ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
@@ -162,6 +163,17 @@ static struct alnMatrixTwoBit * WaterScanTwoBit(
    *  - Allocate memory for the alignment
    \*****************************************************/
 
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         qryST->endAlnUL - qryST->offsetUL + 1,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
    retMatrixST = malloc(sizeof(struct alnMatrix));
    if(retMatrixST == 0) return 0;
    initAlnMatrix(retMatrixST);
@@ -335,6 +347,12 @@ static struct alnMatrixTwoBit * WaterScanTwoBit(
       ulQry < lenQryUL;
       ++ulQry
    ){ /*Loop: compare query base against all ref bases*/
+      profRowC =
+         getScoreProfRow(
+            qrySeqStr[ulQry],
+            refSeqStr,
+            settings
+         ); /*Scores for this query base*/
 
       for(
          ulRef = 1;
@@ -343,8 +361,7 @@ static struct alnMatrixTwoBit * WaterScanTwoBit(
       ){ /* Loop: Check the 1st half of reference bases*/
 
          waterMatrixScanMaxScore(
-            refSeqStr[ulRef],
-            qrySeqStr[ulQry],
+            profRowC[ulRef],
             gapDiffS,
             scoreAryL[ulRef],
             dirUC,
@@ -390,8 +407,7 @@ static struct alnMatrixTwoBit * WaterScanTwoBit(
          ++ulRef
       ){ /* Loop: Check last half of reference bases*/
          waterMatrixScanMaxScore(
-            refSeqStr[ulRef],
-            qrySeqStr[ulQry],
+            profRowC[ulRef],
             gapDiffS,
             scoreAryL[ulRef],
             dirUC,
@@ -432,8 +448,7 @@ static struct alnMatrixTwoBit * WaterScanTwoBit(
       \***************************************************/
 
       waterMatrixScanMaxEndRow(
-         refSeqStr[ulRef],
-         qrySeqStr[ulQry],
+         profRowC[ulRef],
          gapDiffS,
          scoreAryL[ulRef],
          dirUC,
@@ -490,6 +505,9 @@ static struct alnMatrixTwoBit * WaterScanTwoBit(
       indexAryUL = oldIndexAryUL;
       oldIndexAryUL = swapPtrUL;
 
+      /*The gap column is a stop, so it is its own start*/
+      indexAryUL[0] = indexUL;
+
       ++indexUL; /*Set index for the next base pair*/
      /*At this piont insDir is on the second base*/
    } /*loop; compare query base against all ref bases*/
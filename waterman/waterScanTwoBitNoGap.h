@@ -93,6 +93,7 @@ static struct alnMatrixTwoBit * WaterScanTwoBitNoGap(
    /*Get start & end of query and reference sequences*/
    char *refSeqStr = 0;
    char *qrySeqStr = 0;
+   char *profRowC = 0; /*Scores for a query base*/
 
    /*Find the length of the reference and query*/
    ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
@@ -161,6 +162,17 @@ static struct alnMatrixTwoBit * WaterScanTwoBitNoGap(
    *  - Allocate memory for the alignment
    \*****************************************************/
 
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         qryST->endAlnUL - qryST->offsetUL + 1,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
    retMatrixST = malloc(sizeof(struct alnMatrix));
    if(retMatrixST == 0) return 0;
    initAlnMatrix(retMatrixST);
@@ -334,6 +346,12 @@ static struct alnMatrixTwoBit * WaterScanTwoBitNoGap(
       ulQry < lenQryUL;
       ++ulQry
    ){ /*Loop: compare query base against all ref bases*/
+      profRowC =
+         getScoreProfRow(
+            qrySeqStr[ulQry],
+            refSeqStr,
+            settings
+         ); /*Scores for this query base*/
 
       for(
          ulRef = 1;
@@ -342,8 +360,7 @@ static struct alnMatrixTwoBit * WaterScanTwoBitNoGap(
       ){ /* Loop: Check the 1st half of reference bases*/
 
          waterMatrixScanMaxScoreNoGap(
-            refSeqStr[ulRef],
-            qrySeqStr[ulQry],
+            profRowC[ulRef],
             scoreAryL[ulRef],
             dirUC,
             getTwoBitElm(&insDir),
@@ -388,8 +405,7 @@ static struct alnMatrixTwoBit * WaterScanTwoBitNoGap(
          ++ulRef
       ){ /* Loop: Check last half of reference bases*/
          waterMatrixScanMaxScoreNoGap(
-            refSeqStr[ulRef],
-            qrySeqStr[ulQry],
+            profRowC[ulRef],
             scoreAryL[ulRef],
             dirUC,
             getTwoBitElm(&insDir),
@@ -429,8 +445,7 @@ static struct alnMatrixTwoBit * WaterScanTwoBitNoGap(
       \***************************************************/
 
       waterMatrixScanMaxEndRowNoGap(
-         refSeqStr[ulRef],
-         qrySeqStr[ulQry],
+         profRowC[ulRef],
          scoreAryL[ulRef],
          dirUC,
          getTwoBitElm(&insDir),
@@ -486,6 +501,9 @@ static struct alnMatrixTwoBit * WaterScanTwoBitNoGap(
       indexAryUL = oldIndexAryUL;
       oldIndexAryUL = swapPtrUL;
 
+      /*The gap column is a stop, so it is its own start*/
+      indexAryUL[0] = indexUL;
+
       ++indexUL; /*Set index for the next base pair*/
      /*At this piont insDir is on the second base*/
    } /*loop; compare query base against all ref bases*/
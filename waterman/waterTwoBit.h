@@ -103,6 +103,7 @@ static struct alnMatrixTwoBit * WaterTwoBit(
    /*Get start & end of query and reference sequences*/
    char *refSeqStr = refST->seqCStr + refST->offsetUL;
    char *qrySeqStr = qryST->seqCStr + qryST->offsetUL;
+   char *profRowC = 0; /*Scores for a query base*/
 
    /*Find the length of the reference and query*/
    ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
@@ -151,6 +152,17 @@ static struct alnMatrixTwoBit * WaterTwoBit(
    ^  - Allocate memory for alignment
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         qryST->endAlnUL - qryST->offsetUL + 1,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
    retMatrixST = malloc(sizeof(struct alnMatrixTwoBit));
    if(retMatrixST == 0) return 0;
    initAlnMatrixTwoBit(retMatrixST);
@@ -240,6 +252,12 @@ static struct alnMatrixTwoBit * WaterTwoBit(
       ulQry <= qryST->endAlnUL - qryST->offsetUL;
       ++ulQry
    ){ /*loop; compare query base against all ref bases*/
+      profRowC =
+         getScoreProfRow(
+            qrySeqStr[ulQry],
+            refSeqStr,
+            settings
+         ); /*Scores for this query base*/
 
      for(
         ulRef = 1;
@@ -253,8 +271,7 @@ static struct alnMatrixTwoBit * WaterTwoBit(
        \*************************************************/
 
        waterMaxScore(
-          refSeqStr[ulRef],
-          qrySeqStr[ulQry],
+          profRowC[ulRef],
           gapDiffS,
           scoreAryL[ulRef],
           dirUC,
@@ -296,8 +313,7 @@ static struct alnMatrixTwoBit * WaterTwoBit(
       ` I need to move off it to avoid overwirting it
       */
       waterMaxEndRowScore(
-         refSeqStr[ulRef],
-         qrySeqStr[ulQry],
+         profRowC[ulRef],
          gapDiffS,
          scoreAryL[ulRef],
          dirUC,
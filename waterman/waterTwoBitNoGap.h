@@ -104,6 +104,7 @@ static struct alnMatrixTwoBit * WaterTwoBitNoGap(
    /*Get start & end of query and reference sequences*/
    char *refSeqStr = refST->seqCStr + refST->offsetUL;
    char *qrySeqStr = qryST->seqCStr + qryST->offsetUL;
+   char *profRowC = 0; /*Scores for a query base*/
 
    /*Find the length of the reference and query*/
    ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
@@ -148,6 +149,17 @@ static struct alnMatrixTwoBit * WaterTwoBitNoGap(
    ^  - Allocate memory for alignment
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         qryST->endAlnUL - qryST->offsetUL + 1,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
    retMatrixST = malloc(sizeof(struct alnMatrixTwoBit));
    if(retMatrixST == 0) return 0;
    initAlnMatrixTwoBit(retMatrixST);
@@ -237,6 +249,12 @@ static struct alnMatrixTwoBit * WaterTwoBitNoGap(
       ulQry <= qryST->endAlnUL - qryST->offsetUL;
       ++ulQry
    ){ /*loop; compare query base against all ref bases*/
+      profRowC =
+         getScoreProfRow(
+            qrySeqStr[ulQry],
+            refSeqStr,
+            settings
+         ); /*Scores for this query base*/
 
      for(
         ulRef = 1;
@@ -250,8 +268,7 @@ static struct alnMatrixTwoBit * WaterTwoBitNoGap(
        \*************************************************/
 
        waterMaxScoreNoGap(
-          refSeqStr[ulRef],
-          qrySeqStr[ulQry],
+          profRowC[ulRef],
           scoreAryL[ulRef],
           dirUC,
           getTwoBitElm(&insDir),
@@ -292,8 +309,7 @@ static struct alnMatrixTwoBit * WaterTwoBitNoGap(
       ` I need to move off it to avoid overwirting it
       */
       waterMaxEndRowScoreNoGap(
-         refSeqStr[ulRef],
-         qrySeqStr[ulQry],
+         profRowC[ulRef],
          scoreAryL[ulRef],
          dirUC,
          getTwoBitElm(&insDir),
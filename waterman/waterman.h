@@ -14,6 +14,7 @@
 #   o "../general/base10StrToNum.h"    (No .c file)
 #   o "../general/alnSeqDefaults.h"    (No .c file)
 #   - "../general/seqStruct.h"         (No .c file)
+#   - "../general/alnScratch.h"        (No .c file)
 # C Standard libraries:
 #   o <stdlib.h>
 #   o <stdint.h>
@@ -24,22 +25,12 @@
 ' SOF: Start Of File
 '  o header:
 '    - Has includes and definede variables
-'  o fun-01 WatermanSmithAln:
+'  o fun-01 WatermanAlnScratch:
+'    - Perform a Waterman Smith alignment on input
+'      sequences with the score row from an arena
+'  o fun-02 WatermanAln:
 '    - Perform a Waterman Smith alignment on input
 '      sequences
-'  o fun-02 printAltWaterAlns:
-'    - Prints out the best aligment and the saved
-'       alterantive alignments  (best alignment for each
-'       base) to a file
-'  o fun-03 updateDirScoreWaterSingle:
-'    - Picks the best score and direction for the current
-'      base pairs being compared in a Waterman-Smith
-'      alignment
-'  o fun-04 keepAltScore:
-'    - Detemines if keeping a score for a row or column
-'      in a query ref scan
-'  o fun-05 addBestBaseScore:
-'    - Adds a score and index to the kept scores list
 \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 /*-------------------------------------------------------\
@@ -54,10 +45,12 @@
 #include "../general/alnMatrixStruct.h"
 #include "../general/alnSetStruct.h"
 #include "../general/seqStruct.h"
+#include "../general/alnScratch.h"
 
 /*-------------------------------------------------------\
-| Fun-01 TOC: WatermanAln
-|  - Run a Waterman Smith alignment on input sequences
+| Fun-01 TOC: WatermanAlnScratch
+|  - Run a Waterman Smith alignment on input sequences.
+|    The score row is taken from an arena.
 | Input:
 |  - qryST:
 |    o Pionter to seqStruct structure with query sequence 
@@ -69,17 +62,25 @@
 |    o endAlnUL; were to stop alignment on ref, is index 0
 |  - alnSet:
 |    o Point to alnSet structure with alignment settings
+|  - scratchST:
+|    o alnScratch structure (arena) to get the score row
+|      from. This is reset first, so memory from earlier
+|      calls is no longer valid.
 | Output:
+|  - Modifies:
+|    o scratchST to hold the score row
 |  - Returns:
 |    o alnMatrixStruct with the direction matrix & scores
+|      (the direction matrix is not in scratchST)
 |    o 0 for memory allocation errors
 \-------------------------------------------------------*/
-static struct alnMatrix * WatermanAln(
+static struct alnMatrix * WatermanAlnScratch(
     struct seqStruct *qryST, /*query sequence and data*/
     struct seqStruct *refST, /*ref sequence and data*/
-    struct alnSet *settings  /*Settings for alignment*/
+    struct alnSet *settings, /*Settings for alignment*/
+    struct alnScratch *scratchST /*Arena for score row*/
 ){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
-   ' Fun-01 TOC: WatermanAln
+   ' Fun-01 TOC: WatermanAlnScratch
    '  - Run a Waterman Smith alignment on input sequences
    '  o fun-01 sec-01:
    '    - Variable declerations
@@ -115,6 +116,7 @@ static struct alnMatrix * WatermanAln(
    /*Get start & end of query and reference sequences*/
    char *refSeqStr = refST->seqCStr + refST->offsetUL;
    char *qrySeqStr = qryST->seqCStr + qryST->offsetUL;
+   char *profRowC = 0; /*Scores for a query base*/
 
    /*Find the length of the reference and query*/
    ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
@@ -161,6 +163,17 @@ static struct alnMatrix * WatermanAln(
    ^  - Allocate memory for alignment
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         qryST->endAlnUL - qryST->offsetUL + 1,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
    retMatrixST = malloc(sizeof(struct alnMatrix));
    if(retMatrixST == 0) return 0;
    initAlnMatrix(retMatrixST);
@@ -174,7 +187,12 @@ static struct alnMatrix * WatermanAln(
    } /*If: Memory error*/
 
    retMatrixST->dirMatrix = dirMatrix;
-   scoreAryL = calloc((lenRefUL + 1), sizeof(long));
+
+   /*Rows from the last alignment are no longer needed*/
+   resetAlnScratch(scratchST);
+
+   scoreAryL =
+      callocAlnScratch(scratchST, lenRefUL+1, sizeof(long));
       /*+ 1 is for the indel column*/
 
    if(scoreAryL == 0)
@@ -260,6 +278,12 @@ static struct alnMatrix * WatermanAln(
       ulQry <= qryST->endAlnUL - qryST->offsetUL;
       ++ulQry
    ){ /*loop; compare query base against all ref bases*/
+      profRowC =
+         getScoreProfRow(
+            qrySeqStr[ulQry],
+            refSeqStr,
+            settings
+         ); /*Scores for this query base*/
 
      for(
         ulRef = 1;
@@ -273,8 +297,7 @@ static struct alnMatrix * WatermanAln(
        \*************************************************/
 
        waterMaxScore(
-          refSeqStr[ulRef],
-          qrySeqStr[ulQry],
+          profRowC[ulRef],
           gapDiffS,
           scoreAryL[ulRef],
           dirMatrix[ulRef],
@@ -312,8 +335,7 @@ static struct alnMatrix * WatermanAln(
       ` I need to move off it to avoid overwirting it
       */
       waterMaxEndRowScore(
-         refSeqStr[ulRef],
-         qrySeqStr[ulQry],
+         profRowC[ulRef],
          gapDiffS,
          scoreAryL[ulRef],
          dirMatrix[ulRef],
@@ -369,9 +391,45 @@ static struct alnMatrix * WatermanAln(
    */
 
    insDir[ulRef + 1] = defMvStop;
-   free(scoreAryL);
-   scoreAryL = 0;
+   scoreAryL = 0; /*Kept in scratchST for the next call*/
+
+   return retMatrixST;
+} /*WatermanAlnScratch*/
+
+/*-------------------------------------------------------\
+| Fun-02: WatermanAln
+|  - Run a Waterman Smith alignment on input sequences
+|    (uses a temporary arena)
+| Input:
+|  - qryST:
+|    o Pionter to seqStruct structure with query sequence 
+|    o offsetUL; were to start query alignment, is index 0
+|    o endAlnUL; were to stop query alignment, is index 0
+|  - refST:
+|    o Pionter to seqStruct with reference sequence 
+|    o offsetUL; were to start alignment on ref, index 0
+|    o endAlnUL; were to stop alignment on ref, is index 0
+|  - alnSet:
+|    o Point to alnSet structure with alignment settings
+| Output:
+|  - Returns:
+|    o alnMatrixStruct with the direction matrix & scores
+|    o 0 for memory allocation errors
+\-------------------------------------------------------*/
+static struct alnMatrix * WatermanAln(
+    struct seqStruct *qryST, /*query sequence and data*/
+    struct seqStruct *refST, /*ref sequence and data*/
+    struct alnSet *settings  /*Settings for alignment*/
+){
+   struct alnScratch scratchST;
+   struct alnMatrix *retMatrixST = 0;
+
+   initAlnScratch(&scratchST);
+
+   retMatrixST =
+      WatermanAlnScratch(qryST,refST,settings,&scratchST);
 
+   freeAlnScratchStack(&scratchST);
    return retMatrixST;
 } /*WatermanAln*/
 
@@ -116,6 +116,7 @@ static struct alnMatrix * WatermanAlnNoGap(
    /*Get start & end of query and reference sequences*/
    char *refSeqStr = refST->seqCStr + refST->offsetUL;
    char *qrySeqStr = qryST->seqCStr + qryST->offsetUL;
+   char *profRowC = 0; /*Scores for a query base*/
 
    /*Find the length of the reference and query*/
    ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
@@ -158,6 +159,17 @@ static struct alnMatrix * WatermanAlnNoGap(
    ^  - Allocate memory for alignment
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
+   /*Score profile for the query (kept in settings)*/
+   if(
+      setScoreProf(
+         qryST->seqCStr + qryST->offsetUL,
+         qryST->endAlnUL - qryST->offsetUL + 1,
+         refST->seqCStr,
+         refST->endAlnUL + 1,
+         settings
+      )
+   ) return 0; /*Memory error*/
+
    retMatrixST = malloc(sizeof(struct alnMatrix));
    if(retMatrixST == 0) return 0;
    initAlnMatrix(retMatrixST);
@@ -257,6 +269,12 @@ static struct alnMatrix * WatermanAlnNoGap(
       ulQry <= qryST->endAlnUL - qryST->offsetUL;
       ++ulQry
    ){ /*loop; compare query base against all ref bases*/
+      profRowC =
+         getScoreProfRow(
+            qrySeqStr[ulQry],
+            refSeqStr,
+            settings
+         ); /*Scores for this query base*/
 
      for(
         ulRef = 1;
@@ -270,8 +288,7 @@ static struct alnMatrix * WatermanAlnNoGap(
        \*************************************************/
 
        waterMaxScoreNoGap(
-          refSeqStr[ulRef],
-          qrySeqStr[ulQry],
+          profRowC[ulRef],
           scoreAryL[ulRef],
           dirMatrix[ulRef],
           insDir[ulRef],
@@ -308,8 +325,7 @@ static struct alnMatrix * WatermanAlnNoGap(
       ` I need to move off it to avoid overwirting it
       */
       waterMaxEndRowScoreNoGap(
-         refSeqStr[ulRef],
-         qrySeqStr[ulQry],
+         profRowC[ulRef],
          scoreAryL[ulRef],
          dirMatrix[ulRef],
          insDir[ulRef],
@@ -0,0 +1,1734 @@
+/*########################################################
+# Name: wfa
+# Use:
+#  - Does a global (Needleman) alignment with the
+#    wavefront algorithm (WFA, -use-wfa). The time and
+#    memory used depend on the alignment score instead of
+#    the sequence lengths, so this is fast for pairs that
+#    are nearly the same.
+#  - Scores are changed to penalties (Eizenga's
+#    transform, doubled to keep everything whole):
+#    o M is the best score for a pair of bases in the
+#      sequences
+#    o A pair of bases costs 2 * (M - score); so pairs
+#      scoring M are free (extended over)
+#    o The first base in a gap costs M - 2 * gap open
+#    o Every other gap base costs M - 2 * gap extend
+#    o The score is (M * (ref length + query length) -
+#      penalty) / 2
+#  - A gap after an insertion or deletion is an extension
+#    (the same as NeedlemanAln), so the insertion and
+#    deletion wavefronts extend each other
+#  - -wfa-low-mem (wfaLowMemBl) does a bidirectional
+#    (BiWFA) alignment. The forward and reverse wavefronts
+#    are run till they meet. The alignment is split at
+#    the meeting point and both halves are aligned the
+#    same way. Only the last few wavefronts are kept.
+# Libraries:
+#  - "../general/alnStruct.h"         (No .c File)
+#  o "../general/seqStruct.h"         (No .c File)
+#  o "../general/alnSetStruct.h"      (No .c File)
+#  o "../general/alnSeqDefaults.h"    (No .c File)
+#  o "../general/dataTypeShortHand.h" (No .c File)
+# C Standard Libraries:
+#  o <stdlib.h>
+#  o <stdio.h>
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Includes, definitions, and structures
+'  o macro-01 wfaPen:
+'    - Gets the penalty for a pair of bases
+'  o macro-02 wfaGetFront:
+'    - Gets the wavefront for a score
+'  o macro-03 wfaOff:
+'    - Gets the offset of a diagonal in a wavefront
+'  o fun-04 wfaSetup:
+'    - Checks if the settings can be used with -use-wfa
+'      and finds the penalties
+'  o fun-05 wfaSnpOff:
+'    - Finds the furthest offset a mismatch reaches on a
+'      diagonal
+'  o fun-06 wfaNextFront:
+'    - Finds the wavefront for the next score
+'  o fun-07 wfaMark:
+'    - Adds a match, snp, insertion, or deletion to an
+'      alignment
+'  o fun-08 wfaFull:
+'    - Aligns a piece of the sequences while keeping
+'      every wavefront
+'  o fun-09 wfaBiCheck:
+'    - Checks if a forward and reverse wavefront meet
+'  o fun-10 wfaBiSplit:
+'    - Finds where to split an alignment for -wfa-low-mem
+'  o fun-11 wfaBiAln:
+'    - Does the recursive part of a -wfa-low-mem alignment
+'  o fun-12 wfaAln:
+'    - Does a wavefront alignment (-use-wfa)
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Includes, definitions, and structures
+\-------------------------------------------------------*/
+
+#ifndef WFA_H
+#define WFA_H
+
+#include "../general/alnStruct.h"
+
+#define defWfaNull -1073741824L /*Diagonal not reached*/
+#define defWfaMaxPens 64 /*Max unique mismatch penalties*/
+#define defWfaBiMinLen 1024
+   /*-wfa-low-mem pieces with fewer bases (ref + query)
+   ` than this are aligned with wfaFull
+   */
+
+/*How the first bases are aligned (wfaRun->startC)*/
+#define defWfaStartSnp 0  /*First gap is opened*/
+#define defWfaStartGap 1  /*Extends a gap before this*/
+#define defWfaStartOpen 2 /*Has to open a gap first*/
+
+/*Penalties for a wavefront alignment*/
+struct wfaSet{
+   long matchL;   /*Best score for a pair of bases (M)*/
+   long openL;    /*Penalty for first gap base*/
+   long extL;     /*Penalty for each extra gap base*/
+   long penAryL[defWfaMaxPens]; /*Mismatch penalties*/
+   long numPensL; /*Number of mismatch penalties*/
+   long maxPenL;  /*Largest penalty*/
+   struct alnSet *settings; /*Has the scoring matrix*/
+};
+
+/*Furthest offsets (reference bases) reached on each
+` diagonal (reference - query) for one score
+*/
+struct wfaFront{
+   long loL;     /*Lowest diagonal (hiL < loL is empty)*/
+   long hiL;     /*Highest diagonal*/
+   long *mAryL;  /*Ends with any move*/
+   long *iAryL;  /*Ends with an insertion*/
+   long *dAryL;  /*Ends with a deletion*/
+   long sizeL;   /*Number of diagonals allocated*/
+};
+
+/*One direction of an alignment*/
+struct wfaRun{
+   char *refStr;       /*Reference bases to align*/
+   long lenRefL;
+   char *qryStr;       /*Query bases to align*/
+   long lenQryL;
+   char startC;        /*defWfaStartSnp/Gap/Open*/
+   char endGapBl;      /*1: has to end in a gap*/
+   struct wfaFront *frontAryST;
+   long numFrontsL;    /*Number of wavefronts allocated*/
+   long ringL;         /*0 keep all; else keep ringL*/
+};
+
+/*-------------------------------------------------------\
+| Macro-01: wfaPen
+|  - Gets the penalty for a pair of bases
+| Input:
+|  - qryBase:
+|    o Query base
+|  - refBase:
+|    o Reference base
+|  - setST:
+|    o Pointer to wfaSet structure with the penalties
+| Output:
+|  - Returns:
+|    o The penalty (0 for a match)
+\-------------------------------------------------------*/
+#define wfaPen(qryBase, refBase, setST)(\
+   (\
+        (setST)->matchL\
+      - getBaseScore(qryBase, refBase, (setST)->settings)\
+   ) << 1\
+) /*wfaPen*/
+
+/*-------------------------------------------------------\
+| Macro-02: wfaGetFront
+|  - Gets the wavefront for a score
+| Input:
+|  - runST:
+|    o Pointer to wfaRun structure with the wavefronts
+|  - scoreL:
+|    o Score (penalty) of the wavefront to get
+| Output:
+|  - Returns:
+|    o Pointer to the wfaFront for the score
+\-------------------------------------------------------*/
+#define wfaGetFront(runST, scoreL)(\
+   (runST)->ringL\
+      ? (runST)->frontAryST + ((scoreL) % (runST)->ringL)\
+      : (runST)->frontAryST + (scoreL)\
+) /*wfaGetFront*/
+
+/*-------------------------------------------------------\
+| Macro-03: wfaOff
+|  - Gets the offset of a diagonal in a wavefront
+| Input:
+|  - frontST:
+|    o Pointer to the wfaFront to get the offset from
+|  - aryL:
+|    o Array to get the offset from (mAryL, iAryL, or
+|      dAryL)
+|  - diagL:
+|    o Diagonal to get the offset for
+| Output:
+|  - Returns:
+|    o The offset or defWfaNull if the diagonal is not in
+|      the wavefront
+\-------------------------------------------------------*/
+#define wfaOff(frontST, aryL, diagL)(\
+   ((diagL) < (frontST)->loL || (diagL) > (frontST)->hiL)\
+      ? defWfaNull\
+      : (frontST)->aryL[(diagL) - (frontST)->loL]\
+) /*wfaOff*/
+
+/*-------------------------------------------------------\
+| Fun-04: wfaSetup
+|  - Checks if the settings can be used with -use-wfa
+|    and finds the penalties
+| Input:
+|  - qryST:
+|    o Pointer to seqStruct with the query sequence and
+|      region to align (offsetUL and endAlnUL)
+|  - refST:
+|    o Pointer to seqStruct with the reference sequence
+|      and region to align (offsetUL and endAlnUL)
+|  - settings:
+|    o Pointer to alnSet structure with the settings
+|  - setST:
+|    o Pointer to wfaSet structure to set up
+| Output:
+|  - Modifies:
+|    o setST to have the penalties
+|  - Returns:
+|    o 1 if a wavefront alignment can be done
+|    o 0 if the gap penalties are positive (or more than
+|      half the best score), the gap extension penalty is
+|      worse than the gap opening penalty, or there are
+|      to many different scores
+\-------------------------------------------------------*/
+static char wfaSetup(
+   struct seqStruct *qryST, /*Query sequence and data*/
+   struct seqStruct *refST, /*Reference sequence & data*/
+   struct alnSet *settings, /*Settings for alignment*/
+   struct wfaSet *setST     /*Gets the penalties*/
+){
+   char qryBlAry[256];
+   char refBlAry[256];
+   ulong ulBase = 0;
+   ulong ulRef = 0;
+   long scoreL = 0;
+   long penL = 0;
+   long iPen = 0;
+   long extL = settings->gapExtendC;
+   char firstBl = 1;
+
+   if(settings->noGapBl) extL = settings->gapOpenC;
+
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+   { /*Loop: Clear the base lists*/
+      qryBlAry[ulBase] = 0;
+      refBlAry[ulBase] = 0;
+   } /*Loop: Clear the base lists*/
+
+   for(
+      ulBase = qryST->offsetUL;
+      ulBase <= qryST->endAlnUL;
+      ++ulBase
+   ) qryBlAry[(uchar) qryST->seqCStr[ulBase]] = 1;
+
+   for(
+      ulBase = refST->offsetUL;
+      ulBase <= refST->endAlnUL;
+      ++ulBase
+   ) refBlAry[(uchar) refST->seqCStr[ulBase]] = 1;
+
+   /*Find the best score (M) for the bases in the
+   ` sequences
+   */
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+   { /*Loop: Check each query base*/
+      if(! qryBlAry[ulBase]) continue;
+
+      for(ulRef = 0; ulRef < 256; ++ulRef)
+      { /*Loop: Check each reference base*/
+         if(! refBlAry[ulRef]) continue;
+
+         scoreL =
+            getBaseScore(
+               (char) ulBase,
+               (char) ulRef,
+               settings
+            );
+
+         if(firstBl || scoreL > setST->matchL)
+            setST->matchL = scoreL;
+
+         firstBl = 0;
+      } /*Loop: Check each reference base*/
+   } /*Loop: Check each query base*/
+
+   setST->openL = setST->matchL - 2 * settings->gapOpenC;
+   setST->extL = setST->matchL - 2 * extL;
+   setST->settings = settings;
+
+   if(setST->extL <= 0) return 0;
+   if(setST->openL < setST->extL) return 0;
+
+   setST->numPensL = 0;
+   setST->maxPenL = setST->openL;
+
+   /*Find the mismatch penalties*/
+   for(ulBase = 0; ulBase < 256; ++ulBase)
+   { /*Loop: Check each query base*/
+      if(! qryBlAry[ulBase]) continue;
+
+      for(ulRef = 0; ulRef < 256; ++ulRef)
+      { /*Loop: Check each reference base*/
+         if(! refBlAry[ulRef]) continue;
+
+         penL = wfaPen((char) ulBase, (char) ulRef, setST);
+         if(penL == 0) continue; /*Match*/
+
+         for(iPen = 0; iPen < setST->numPensL; ++iPen)
+            if(setST->penAryL[iPen] == penL) break;
+
+         if(iPen < setST->numPensL) continue; /*Have*/
+         if(iPen >= defWfaMaxPens) return 0;
+
+         setST->penAryL[iPen] = penL;
+         ++(setST->numPensL);
+
+         if(penL > setST->maxPenL) setST->maxPenL = penL;
+      } /*Loop: Check each reference base*/
+   } /*Loop: Check each query base*/
+
+   return 1;
+} /*wfaSetup*/
+
+/*-------------------------------------------------------\
+| Fun-05: wfaSnpOff
+|  - Finds the furthest offset a mismatch reaches on a
+|    diagonal
+| Input:
+|  - runST:
+|    o Pointer to wfaRun structure with the wavefronts
+|  - setST:
+|    o Pointer to wfaSet structure with the penalties
+|  - scoreL:
+|    o Score (penalty) of the wavefront being found
+|  - diagL:
+|    o Diagonal to check
+|  - penL:
+|    o Pointer to long to hold the penalty of the
+|      mismatch used
+| Output:
+|  - Modifies:
+|    o penL to have the penalty of the mismatch
+|  - Returns:
+|    o The offset after the mismatch
+|    o defWfaNull if no mismatch reaches the diagonal
+\-------------------------------------------------------*/
+static long wfaSnpOff(
+   struct wfaRun *runST, /*Has wavefronts*/
+   struct wfaSet *setST, /*Has penalties*/
+   long scoreL,          /*Score of wavefront*/
+   long diagL,           /*Diagonal on*/
+   long *penL            /*Gets penalty of mismatch*/
+){
+   struct wfaFront *srcST = 0;
+   long offL = defWfaNull;
+   long tmpL = 0;
+   long iPen = 0;
+
+   for(iPen = 0; iPen < setST->numPensL; ++iPen)
+   { /*Loop: Check each mismatch penalty*/
+      if(setST->penAryL[iPen] > scoreL) continue;
+
+      srcST =
+         wfaGetFront(runST, scoreL - setST->penAryL[iPen]);
+      tmpL = wfaOff(srcST, mAryL, diagL);
+
+      if(tmpL < 0) continue;
+      if(tmpL >= runST->lenRefL) continue;
+      if(tmpL - diagL >= runST->lenQryL) continue;
+
+      if(
+            wfaPen(
+               runST->qryStr[tmpL - diagL],
+               runST->refStr[tmpL],
+               setST
+            )
+         != setST->penAryL[iPen]
+      ) continue; /*This mismatch has another penalty*/
+
+      if(tmpL + 1 > offL)
+      { /*If: this mismatch goes further*/
+         offL = tmpL + 1;
+         *penL = setST->penAryL[iPen];
+      } /*If: this mismatch goes further*/
+   } /*Loop: Check each mismatch penalty*/
+
+   return offL;
+} /*wfaSnpOff*/
+
+/*-------------------------------------------------------\
+| Fun-06: wfaNextFront
+|  - Finds the wavefront for the next score
+| Input:
+|  - runST:
+|    o Pointer to wfaRun structure with the wavefronts.
+|      The wavefronts for all lower scores (the last
+|      maxPenL when ringL is used) must be found.
+|  - setST:
+|    o Pointer to wfaSet structure with the penalties
+|  - scoreL:
+|    o Score (penalty) of the wavefront to find
+| Output:
+|  - Modifies:
+|    o The wavefront for scoreL in runST
+|  - Returns:
+|    o 0 for no errors
+|    o 64 for memory errors
+\-------------------------------------------------------*/
+static char wfaNextFront(
+   struct wfaRun *runST, /*Has wavefronts*/
+   struct wfaSet *setST, /*Has penalties*/
+   long scoreL           /*Score of wavefront to find*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-06 TOC: wfaNextFront
+   '  - Finds the wavefront for the next score
+   '  o fun-06 sec-01:
+   '    - Variable declerations
+   '  o fun-06 sec-02:
+   '    - Find the diagonals in the wavefront
+   '  o fun-06 sec-03:
+   '    - Find the offsets for each diagonal
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-06 Sec-01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   struct wfaFront *frontST = 0;
+   struct wfaFront *openST = 0; /*Wavefront gaps open from*/
+   struct wfaFront *extST = 0;  /*Wavefront gaps extend*/
+   struct wfaFront *srcST = 0;
+   long loL = runST->lenRefL + 1;
+   long hiL = -(runST->lenQryL) - 1;
+   long diagL = 0;
+   long offL = 0;
+   long insL = 0;
+   long delL = 0;
+   long tmpL = 0;
+   long iPen = 0;
+   long *tmpAryL = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-06 Sec-02:
+   ^  - Find the diagonals in the wavefront
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(scoreL == 0)
+   { /*If: this is the first wavefront*/
+      if(runST->startC != defWfaStartOpen)
+      { /*If: the start can be a match*/
+         loL = 0;
+         hiL = 0;
+      } /*If: the start can be a match*/
+   } /*If: this is the first wavefront*/
+
+   else
+   { /*Else: find the diagonals from the last scores*/
+      for(iPen = 0; iPen < setST->numPensL; ++iPen)
+      { /*Loop: Check each mismatch wavefront*/
+         if(setST->penAryL[iPen] > scoreL) continue;
+
+         srcST =
+            wfaGetFront(
+               runST,
+               scoreL - setST->penAryL[iPen]
+            );
+
+         if(srcST->loL > srcST->hiL) continue;
+         if(srcST->loL < loL) loL = srcST->loL;
+         if(srcST->hiL > hiL) hiL = srcST->hiL;
+      } /*Loop: Check each mismatch wavefront*/
+
+      if(setST->openL <= scoreL)
+      { /*If: gaps can be opened*/
+         openST = wfaGetFront(runST, scoreL - setST->openL);
+
+         if(openST->loL <= openST->hiL)
+         { /*If: the gap can open from a wavefront*/
+            if(openST->loL - 1 < loL) loL = openST->loL - 1;
+            if(openST->hiL + 1 > hiL) hiL = openST->hiL + 1;
+         } /*If: the gap can open from a wavefront*/
+
+         else openST = 0;
+      } /*If: gaps can be opened*/
+
+      if(setST->extL <= scoreL)
+      { /*If: gaps can be extended*/
+         extST = wfaGetFront(runST, scoreL - setST->extL);
+
+         if(extST->loL <= extST->hiL)
+         { /*If: the gap can extend from a wavefront*/
+            if(extST->loL - 1 < loL) loL = extST->loL - 1;
+            if(extST->hiL + 1 > hiL) hiL = extST->hiL + 1;
+         } /*If: the gap can extend from a wavefront*/
+
+         else extST = 0;
+      } /*If: gaps can be extended*/
+
+      if(
+            runST->startC == defWfaStartOpen
+         && scoreL == setST->openL
+      ){ /*If: a gap opens from the start*/
+         if(loL > -1) loL = -1;
+         if(hiL < 1) hiL = 1;
+      } /*If: a gap opens from the start*/
+   } /*Else: find the diagonals from the last scores*/
+
+   if(loL < -(runST->lenQryL)) loL = -(runST->lenQryL);
+   if(hiL > runST->lenRefL) hiL = runST->lenRefL;
+
+   frontST = wfaGetFront(runST, scoreL);
+   frontST->loL = loL;
+   frontST->hiL = hiL;
+
+   if(loL > hiL) return 0; /*No diagonals reached*/
+
+   if(hiL - loL + 1 > frontST->sizeL)
+   { /*If: I need more memory*/
+      tmpAryL =
+         realloc(
+            frontST->mAryL,
+            3 * (hiL - loL + 1) * sizeof(long)
+         );
+
+      if(tmpAryL == 0) return 64;
+
+      frontST->mAryL = tmpAryL;
+      frontST->sizeL = hiL - loL + 1;
+   } /*If: I need more memory*/
+
+   frontST->iAryL = frontST->mAryL + frontST->sizeL;
+   frontST->dAryL = frontST->iAryL + frontST->sizeL;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-06 Sec-03:
+   ^  - Find the offsets for each diagonal
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(diagL = loL; diagL <= hiL; ++diagL)
+   { /*Loop: Find the offset of each diagonal*/
+      insL = defWfaNull;
+      delL = defWfaNull;
+
+      if(openST != 0)
+      { /*If: gaps can open here*/
+         insL = wfaOff(openST, mAryL, diagL + 1);
+         delL = wfaOff(openST, mAryL, diagL - 1);
+      } /*If: gaps can open here*/
+
+      if(extST != 0)
+      { /*If: gaps can extend here*/
+         tmpL = wfaOff(extST, iAryL, diagL + 1);
+         if(tmpL > insL) insL = tmpL;
+         tmpL = wfaOff(extST, dAryL, diagL + 1);
+         if(tmpL > insL) insL = tmpL;
+
+         tmpL = wfaOff(extST, iAryL, diagL - 1);
+         if(tmpL > delL) delL = tmpL;
+         tmpL = wfaOff(extST, dAryL, diagL - 1);
+         if(tmpL > delL) delL = tmpL;
+      } /*If: gaps can extend here*/
+
+      if(
+            runST->startC == defWfaStartOpen
+         && scoreL == setST->openL
+      ){ /*If: a gap can open from the start*/
+         if(diagL == -1 && insL < 0) insL = 0;
+         if(diagL == 1 && delL < 0) delL = 0;
+      } /*If: a gap can open from the start*/
+
+      /*Insertions keep the reference base and deletions
+      ` move to the next reference base
+      */
+      if(delL >= 0) ++delL;
+      if(delL > runST->lenRefL) delL = defWfaNull;
+      if(insL - diagL > runST->lenQryL) insL = defWfaNull;
+
+      if(scoreL == 0 && diagL == 0)
+      { /*If: at the start*/
+         offL = 0;
+
+         if(runST->startC == defWfaStartGap)
+         { /*If: the start is in a gap*/
+            insL = 0;
+            delL = 0;
+         } /*If: the start is in a gap*/
+      } /*If: at the start*/
+
+      else
+      { /*Else: find the best move*/
+         offL =
+            wfaSnpOff(runST, setST, scoreL, diagL, &tmpL);
+         if(insL > offL) offL = insL;
+         if(delL > offL) offL = delL;
+      } /*Else: find the best move*/
+
+      if(offL >= 0)
+      { /*If: this diagonal was reached*/
+         while(
+               offL < runST->lenRefL
+            && offL - diagL < runST->lenQryL
+            &&   getBaseScore(
+                    runST->qryStr[offL - diagL],
+                    runST->refStr[offL],
+                    setST->settings
+                 )
+              == setST->matchL
+         ) ++offL; /*Extend the matches*/
+      } /*If: this diagonal was reached*/
+
+      else offL = defWfaNull;
+      if(insL < 0) insL = defWfaNull;
+      if(delL < 0) delL = defWfaNull;
+
+      frontST->mAryL[diagL - loL] = offL;
+      frontST->iAryL[diagL - loL] = insL;
+      frontST->dAryL[diagL - loL] = delL;
+   } /*Loop: Find the offset of each diagonal*/
+
+   return 0;
+} /*wfaNextFront*/
+
+/*-------------------------------------------------------\
+| Fun-07: wfaMark
+|  - Adds a match, snp, insertion, or deletion to an
+|    alignment
+| Input:
+|  - alnST:
+|    o Pointer to alnStruct to add the move to
+|  - moveC:
+|    o defMvSnp, defMvIns, or defMvDel
+|  - refPosUL:
+|    o Position (index 0) of the reference base
+|  - qryPosUL:
+|    o Position (index 0) of the query base
+|  - refSeqStr:
+|    o Full reference sequence
+|  - qrySeqStr:
+|    o Full query sequence
+|  - settings:
+|    o Pointer to alnSet structure with the settings
+| Output:
+|  - Modifies:
+|    o refAlnStr and qryAlnStr in alnST to have the move
+|    o The counts in alnST
+\-------------------------------------------------------*/
+static void wfaMark(
+   struct alnStruct *alnST, /*Alignment to add to*/
+   char moveC,              /*Move to add*/
+   ulong refPosUL,          /*Reference base*/
+   ulong qryPosUL,          /*Query base*/
+   char *refSeqStr,         /*Reference sequence*/
+   char *qrySeqStr,         /*Query sequence*/
+   struct alnSet *settings  /*Has the match matrix*/
+){
+   switch(moveC)
+   { /*Switch: check if bases is gap, match, or snp*/
+      case defMvIns:
+      /*Case: insertion (defMvIns)*/
+         alnST->qryAlnStr[qryPosUL] = defGapFlag;
+         ++(alnST->numInssUL);
+         break;
+      /*Case: insertion (defMvIns)*/
+
+      case defMvDel:
+      /*Case: deletion (defMvDel)*/
+         alnST->refAlnStr[refPosUL] = defGapFlag;
+         ++(alnST->numDelsUL);
+         break;
+      /*Case: deletion (defMvDel)*/
+
+      case defMvSnp:
+      /*Case: match/snp (defMvSnp)*/
+         if(
+            matchOrSnp(
+               qrySeqStr[qryPosUL],
+               refSeqStr[refPosUL],
+               settings
+            )
+         ){ /*If the bases were a match*/
+            alnST->qryAlnStr[qryPosUL] = defMatchFlag;
+            alnST->refAlnStr[refPosUL] = defMatchFlag;
+            ++(alnST->numMatchesUL);
+         } /*If the bases were a match*/
+
+         else
+         { /*Else was a SNP*/
+            alnST->qryAlnStr[qryPosUL] = defSnpFlag;
+            alnST->refAlnStr[refPosUL] = defSnpFlag;
+            ++(alnST->numSnpsUL);
+         } /*Else was a SNP*/
+
+         break;
+      /*Case: match/snp (defMvSnp)*/
+   } /*Switch: check if bases is gap, match, or snp*/
+
+   ++(alnST->lenAlnUL);
+} /*wfaMark*/
+
+/*-------------------------------------------------------\
+| Fun-08: wfaFull
+|  - Aligns a piece of the sequences while keeping every
+|    wavefront
+| Input:
+|  - runST:
+|    o Pointer to wfaRun with the piece to align, the
+|      start (defWfaStartSnp or defWfaStartGap), and if
+|      the alignment has to end in a gap (endGapBl)
+|    o frontAryST is allocated and freed here
+|  - setST:
+|    o Pointer to wfaSet structure with the penalties
+|  - refPosUL:
+|    o Position (index 0) of the first reference base in
+|      runST in the full sequence
+|  - qryPosUL:
+|    o Position (index 0) of the first query base in
+|      runST in the full sequence
+|  - refSeqStr:
+|    o Full reference sequence
+|  - qrySeqStr:
+|    o Full query sequence
+|  - alnST:
+|    o Pointer to alnStruct to add the alignment to
+| Output:
+|  - Modifies:
+|    o alnST to have the alignment of the piece
+|  - Returns:
+|    o 0 for no errors
+|    o 64 for memory errors
+\-------------------------------------------------------*/
+static char wfaFull(
+   struct wfaRun *runST,    /*Piece to align*/
+   struct wfaSet *setST,    /*Has penalties*/
+   ulong refPosUL,          /*First reference base*/
+   ulong qryPosUL,          /*First query base*/
+   char *refSeqStr,         /*Reference sequence*/
+   char *qrySeqStr,         /*Query sequence*/
+   struct alnStruct *alnST  /*Gets alignment*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-08 TOC: wfaFull
+   '  - Aligns a piece of the sequences while keeping
+   '    every wavefront
+   '  o fun-08 sec-01:
+   '    - Variable declerations
+   '  o fun-08 sec-02:
+   '    - Align pieces with only insertions or deletions
+   '  o fun-08 sec-03:
+   '    - Find the wavefronts till the end is reached
+   '  o fun-08 sec-04:
+   '    - Trace back the alignment
+   '  o fun-08 sec-05:
+   '    - Clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-08 Sec-01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   struct wfaFront *frontST = 0;
+   struct wfaFront *tmpST = 0;
+   long endDiagL = runST->lenRefL - runST->lenQryL;
+   long maxScoreL = 0;
+   long scoreL = 0;
+   long diagL = 0;
+   long offL = 0;
+   long preL = 0;
+   long penL = 0;
+   long lenL = 0;
+   char stateC = defMvSnp;
+   char errC = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-08 Sec-02:
+   ^  - Align pieces with only insertions or deletions
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(runST->lenRefL == 0 || runST->lenQryL == 0)
+   { /*If: this piece is only gaps*/
+      for(lenL = 0; lenL < runST->lenQryL; ++lenL)
+         wfaMark(
+            alnST,
+            defMvIns,
+            0,
+            qryPosUL + lenL,
+            refSeqStr,
+            qrySeqStr,
+            setST->settings
+         );
+
+      for(lenL = 0; lenL < runST->lenRefL; ++lenL)
+         wfaMark(
+            alnST,
+            defMvDel,
+            refPosUL + lenL,
+            0,
+            refSeqStr,
+            qrySeqStr,
+            setST->settings
+         );
+
+      return 0;
+   } /*If: this piece is only gaps*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-08 Sec-03:
+   ^  - Find the wavefronts till the end is reached
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*Penalty for all gaps is the most it could take*/
+   maxScoreL =
+        (setST->openL << 1)
+      + setST->extL * (runST->lenRefL + runST->lenQryL);
+
+   runST->ringL = 0;
+   runST->numFrontsL = 0;
+   runST->frontAryST = 0;
+
+   for(scoreL = 0; scoreL <= maxScoreL; ++scoreL)
+   { /*Loop: Find wavefronts till I reach the end*/
+      if(scoreL >= runST->numFrontsL)
+      { /*If: I need more wavefronts*/
+         lenL = (runST->numFrontsL << 1) + 64;
+
+         tmpST =
+            realloc(
+               runST->frontAryST,
+               lenL * sizeof(struct wfaFront)
+            );
+
+         if(tmpST == 0) goto memErr;
+         runST->frontAryST = tmpST;
+
+         while(runST->numFrontsL < lenL)
+         { /*Loop: Blank the new wavefronts*/
+            tmpST = runST->frontAryST + runST->numFrontsL;
+            tmpST->loL = 0;
+            tmpST->hiL = -1;
+            tmpST->mAryL = 0;
+            tmpST->sizeL = 0;
+            ++(runST->numFrontsL);
+         } /*Loop: Blank the new wavefronts*/
+      } /*If: I need more wavefronts*/
+
+      if(wfaNextFront(runST, setST, scoreL)) goto memErr;
+      frontST = wfaGetFront(runST, scoreL);
+
+      if(runST->endGapBl)
+      { /*If: the alignment has to end in a gap*/
+         if(
+               wfaOff(frontST, iAryL, endDiagL)
+            == runST->lenRefL
+         ){ /*If: an insertion reached the end*/
+            stateC = defMvIns;
+            break;
+         } /*If: an insertion reached the end*/
+
+         if(
+               wfaOff(frontST, dAryL, endDiagL)
+            == runST->lenRefL
+         ){ /*If: a deletion reached the end*/
+            stateC = defMvDel;
+            break;
+         } /*If: a deletion reached the end*/
+      } /*If: the alignment has to end in a gap*/
+
+      else if(
+            wfaOff(frontST, mAryL, endDiagL)
+         == runST->lenRefL
+      ) break; /*Reached the end*/
+   } /*Loop: Find wavefronts till I reach the end*/
+
+   if(scoreL > maxScoreL) goto memErr; /*Should not be*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-08 Sec-04:
+   ^  - Trace back the alignment
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   diagL = endDiagL;
+   offL = runST->lenRefL;
+
+   while(1)
+   { /*Loop: Trace back the alignment*/
+      frontST = wfaGetFront(runST, scoreL);
+
+      if(stateC == defMvSnp)
+      { /*If: on any move (match, snp, or gap end)*/
+         if(scoreL == 0) preL = 0; /*At the start*/
+
+         else
+         { /*Else: find the offset before the matches*/
+            preL =
+               wfaSnpOff(
+                  runST,
+                  setST,
+                  scoreL,
+                  diagL,
+                  &penL
+               );
+
+            if(wfaOff(frontST, iAryL, diagL) > preL)
+               preL = wfaOff(frontST, iAryL, diagL);
+
+            if(wfaOff(frontST, dAryL, diagL) > preL)
+               preL = wfaOff(frontST, dAryL, diagL);
+         } /*Else: find the offset before the matches*/
+
+         while(offL > preL)
+         { /*Loop: Add the extended matches*/
+            --offL;
+
+            wfaMark(
+               alnST,
+               defMvSnp,
+               refPosUL + offL,
+               qryPosUL + offL - diagL,
+               refSeqStr,
+               qrySeqStr,
+               setST->settings
+            );
+         } /*Loop: Add the extended matches*/
+
+         if(scoreL == 0) break; /*At the start*/
+
+         if(wfaOff(frontST, dAryL, diagL) == offL)
+            stateC = defMvDel;
+         else if(wfaOff(frontST, iAryL, diagL) == offL)
+            stateC = defMvIns;
+
+         else
+         { /*Else: this was a mismatch*/
+            --offL;
+
+            wfaMark(
+               alnST,
+               defMvSnp,
+               refPosUL + offL,
+               qryPosUL + offL - diagL,
+               refSeqStr,
+               qrySeqStr,
+               setST->settings
+            );
+
+            scoreL -= penL;
+         } /*Else: this was a mismatch*/
+
+         continue;
+      } /*If: on any move (match, snp, or gap end)*/
+
+      if(scoreL == 0) break; /*Started in a gap*/
+
+      if(stateC == defMvIns)
+      { /*If: on an insertion*/
+         wfaMark(
+            alnST,
+            defMvIns,
+            0,
+            qryPosUL + offL - diagL - 1,
+            refSeqStr,
+            qrySeqStr,
+            setST->settings
+         );
+
+         ++diagL;
+         preL = offL;
+      } /*If: on an insertion*/
+
+      else
+      { /*Else: on a deletion*/
+         --offL;
+
+         wfaMark(
+            alnST,
+            defMvDel,
+            refPosUL + offL,
+            0,
+            refSeqStr,
+            qrySeqStr,
+            setST->settings
+         );
+
+         --diagL;
+         preL = offL;
+      } /*Else: on a deletion*/
+
+      /*Find the wavefront the gap came from*/
+      if(setST->extL <= scoreL)
+      { /*If: the gap could be an extension*/
+         tmpST = wfaGetFront(runST, scoreL - setST->extL);
+
+         if(wfaOff(tmpST, iAryL, diagL) == preL)
+         { /*If: extended an insertion*/
+            scoreL -= setST->extL;
+            stateC = defMvIns;
+            continue;
+         } /*If: extended an insertion*/
+
+         if(wfaOff(tmpST, dAryL, diagL) == preL)
+         { /*If: extended a deletion*/
+            scoreL -= setST->extL;
+            stateC = defMvDel;
+            continue;
+         } /*If: extended a deletion*/
+      } /*If: the gap could be an extension*/
+
+      scoreL -= setST->openL;
+      stateC = defMvSnp;
+   } /*Loop: Trace back the alignment*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-08 Sec-05:
+   ^  - Clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   goto cleanUp;
+
+   memErr:
+   errC = 64;
+
+   cleanUp:
+
+   for(lenL = 0; lenL < runST->numFrontsL; ++lenL)
+      free(runST->frontAryST[lenL].mAryL);
+
+   free(runST->frontAryST);
+   runST->frontAryST = 0;
+   runST->numFrontsL = 0;
+
+   return errC;
+} /*wfaFull*/
+
+
+/*-------------------------------------------------------\
+| Fun-09: wfaBiCheck
+|  - Checks if a forward and reverse wavefront meet
+| Input:
+|  - fwdST:
+|    o Pointer to the forward wfaFront to check
+|  - revST:
+|    o Pointer to the reverse wfaFront to check
+|  - fwdScoreL:
+|    o Score (penalty) of the forward wavefront
+|  - revScoreL:
+|    o Score (penalty) of the reverse wavefront
+|  - lenRefL:
+|    o Number of reference bases being aligned
+|  - lenQryL:
+|    o Number of query bases being aligned
+|  - setST:
+|    o Pointer to wfaSet structure with the penalties
+|  - scoreL:
+|    o Pointer to long with the best score found (-1 if
+|      nothing was found yet)
+|  - refPosL:
+|    o Pointer to long with the reference base to split
+|      at for the best score
+|  - qryPosL:
+|    o Pointer to long with the query base to split at
+|      for the best score
+|  - gapBl:
+|    o Pointer to char that is set to 1 if the best
+|      score splits a gap
+| Output:
+|  - Modifies:
+|    o scoreL, refPosL, qryPosL, and gapBl if the
+|      wavefronts meet with a better score
+| Note:
+|  - The wavefronts meet if the forward and reverse
+|    offsets reach or pass each other on a diagonal. The
+|    split is at the reverse offset.
+|  - Gaps (insertions or deletions) that meet are joined
+|    into one gap, which is only opened once. So, the
+|    score is the open penalty - the extension penalty
+|    lower.
+\-------------------------------------------------------*/
+static void wfaBiCheck(
+   struct wfaFront *fwdST, /*Forward wavefront*/
+   struct wfaFront *revST, /*Reverse wavefront*/
+   long fwdScoreL,         /*Score of forward wavefront*/
+   long revScoreL,         /*Score of reverse wavefront*/
+   long lenRefL,           /*Reference bases aligning*/
+   long lenQryL,           /*Query bases aligning*/
+   struct wfaSet *setST,   /*Has penalties*/
+   long *scoreL,           /*Best score found*/
+   long *refPosL,          /*Reference base to split at*/
+   long *qryPosL,          /*Query base to split at*/
+   char *gapBl             /*1: split is in a gap*/
+){
+   long endDiagL = lenRefL - lenQryL;
+   long diagL = 0;
+   long lastDiagL = 0;
+   long fwdIndexL = 0;
+   long revIndexL = 0;
+   long fwdOffL = 0;
+   long revOffL = 0;
+   long gapScoreL =
+      fwdScoreL + revScoreL - setST->openL + setST->extL;
+
+   if(fwdST->loL > fwdST->hiL) return;
+   if(revST->loL > revST->hiL) return;
+
+   /*Reverse diagonals are endDiagL - forward diagonal*/
+   diagL = fwdST->loL;
+   if(endDiagL - revST->hiL > diagL)
+      diagL = endDiagL - revST->hiL;
+
+   lastDiagL = fwdST->hiL;
+   if(endDiagL - revST->loL < lastDiagL)
+      lastDiagL = endDiagL - revST->loL;
+
+   for(; diagL <= lastDiagL; ++diagL)
+   { /*Loop: Check each diagonal in both wavefronts*/
+      fwdIndexL = diagL - fwdST->loL;
+      revIndexL = endDiagL - diagL - revST->loL;
+
+      fwdOffL = fwdST->mAryL[fwdIndexL];
+      revOffL = revST->mAryL[revIndexL];
+
+      if(
+            fwdOffL >= 0
+         && revOffL >= 0
+         && fwdOffL + revOffL >= lenRefL
+         && (*scoreL < 0 || fwdScoreL + revScoreL < *scoreL)
+      ){ /*If: the wavefronts meet with a better score*/
+         *scoreL = fwdScoreL + revScoreL;
+         *refPosL = lenRefL - revOffL;
+         *qryPosL = *refPosL - diagL;
+         *gapBl = 0;
+      } /*If: the wavefronts meet with a better score*/
+
+      if(*scoreL >= 0 && gapScoreL >= *scoreL) continue;
+
+      fwdOffL = fwdST->iAryL[fwdIndexL];
+      if(fwdST->dAryL[fwdIndexL] > fwdOffL)
+         fwdOffL = fwdST->dAryL[fwdIndexL];
+
+      revOffL = revST->iAryL[revIndexL];
+      if(revST->dAryL[revIndexL] > revOffL)
+         revOffL = revST->dAryL[revIndexL];
+
+      if(fwdOffL < 0 || revOffL < 0) continue;
+      if(fwdOffL + revOffL < lenRefL) continue;
+
+      *scoreL = gapScoreL;
+      *refPosL = lenRefL - revOffL;
+      *qryPosL = *refPosL - diagL;
+      *gapBl = 1;
+   } /*Loop: Check each diagonal in both wavefronts*/
+} /*wfaBiCheck*/
+
+/*-------------------------------------------------------\
+| Fun-10: wfaBiSplit
+|  - Finds where to split an alignment for -wfa-low-mem
+| Input:
+|  - fwdST:
+|    o Pointer to wfaRun with the forward piece to align
+|    o This needs a ring (ringL > maxPenL) of wavefronts
+|  - revST:
+|    o Pointer to wfaRun with the reversed piece to align
+|    o This needs a ring the same size as fwdST
+|  - setST:
+|    o Pointer to wfaSet structure with the penalties
+|  - refPosL:
+|    o Pointer to long to hold the reference base to
+|      split at (index 0; bases before are in the first
+|      half)
+|  - qryPosL:
+|    o Pointer to long to hold the query base to split at
+|  - gapBl:
+|    o Pointer to char to hold if the split is in a gap
+| Output:
+|  - Modifies:
+|    o refPosL, qryPosL, and gapBl to have the split
+|    o The wavefronts in fwdST and revST
+|  - Returns:
+|    o 0 for no errors
+|    o 64 for memory errors
+| Note:
+|  - The forward and reverse wavefronts are found one
+|    score at a time (the lowest score first). Each new
+|    wavefront is checked against the other directions
+|    wavefronts in its ring.
+|  - Checking stops after the sum of the forward and
+|    reverse scores passes the best score by the gap
+|    opening penalty + the largest penalty. By then the
+|    middle of every better alignment would have been
+|    checked.
+\-------------------------------------------------------*/
+static char wfaBiSplit(
+   struct wfaRun *fwdST,  /*Forward piece and ring*/
+   struct wfaRun *revST,  /*Reverse piece and ring*/
+   struct wfaSet *setST,  /*Has penalties*/
+   long *refPosL,         /*Reference base to split at*/
+   long *qryPosL,         /*Query base to split at*/
+   char *gapBl            /*1: split is in a gap*/
+){
+   long fwdScoreL = 0;
+   long revScoreL = 0;
+   long scoreOnL = 0;
+   long bestScoreL = -1;
+   long marginL = setST->openL + setST->maxPenL + 2;
+
+   if(wfaNextFront(fwdST, setST, 0)) return 64;
+   if(wfaNextFront(revST, setST, 0)) return 64;
+
+   wfaBiCheck(
+      wfaGetFront(fwdST, 0),
+      wfaGetFront(revST, 0),
+      0,
+      0,
+      fwdST->lenRefL,
+      fwdST->lenQryL,
+      setST,
+      &bestScoreL,
+      refPosL,
+      qryPosL,
+      gapBl
+   );
+
+   while(
+         bestScoreL < 0
+      || fwdScoreL + revScoreL < bestScoreL + marginL
+   ){ /*Loop: Find wavefronts till the best is found*/
+      if(fwdScoreL <= revScoreL)
+      { /*If: finding the next forward wavefront*/
+         ++fwdScoreL;
+         if(wfaNextFront(fwdST, setST, fwdScoreL))
+            return 64;
+
+         scoreOnL = revScoreL - revST->ringL + 1;
+         if(scoreOnL < 0) scoreOnL = 0;
+
+         for(; scoreOnL <= revScoreL; ++scoreOnL)
+            wfaBiCheck(
+               wfaGetFront(fwdST, fwdScoreL),
+               wfaGetFront(revST, scoreOnL),
+               fwdScoreL,
+               scoreOnL,
+               fwdST->lenRefL,
+               fwdST->lenQryL,
+               setST,
+               &bestScoreL,
+               refPosL,
+               qryPosL,
+               gapBl
+            );
+      } /*If: finding the next forward wavefront*/
+
+      else
+      { /*Else: finding the next reverse wavefront*/
+         ++revScoreL;
+         if(wfaNextFront(revST, setST, revScoreL))
+            return 64;
+
+         scoreOnL = fwdScoreL - fwdST->ringL + 1;
+         if(scoreOnL < 0) scoreOnL = 0;
+
+         for(; scoreOnL <= fwdScoreL; ++scoreOnL)
+            wfaBiCheck(
+               wfaGetFront(fwdST, scoreOnL),
+               wfaGetFront(revST, revScoreL),
+               scoreOnL,
+               revScoreL,
+               fwdST->lenRefL,
+               fwdST->lenQryL,
+               setST,
+               &bestScoreL,
+               refPosL,
+               qryPosL,
+               gapBl
+            );
+      } /*Else: finding the next reverse wavefront*/
+   } /*Loop: Find wavefronts till the best is found*/
+
+   return 0;
+} /*wfaBiSplit*/
+
+/*-------------------------------------------------------\
+| Fun-11: wfaBiAln
+|  - Does the recursive part of a -wfa-low-mem alignment
+| Input:
+|  - fwdST:
+|    o Pointer to wfaRun with a ring of wavefronts to use
+|      for the forward direction
+|  - revST:
+|    o Pointer to wfaRun with a ring of wavefronts to use
+|      for the reverse direction
+|  - setST:
+|    o Pointer to wfaSet structure with the penalties
+|  - refSeqStr:
+|    o Full reference sequence
+|  - qrySeqStr:
+|    o Full query sequence
+|  - revRefEndStr:
+|    o Pointer to the end of the reversed reference
+|      sequence (reversed sequence + sequence length)
+|  - revQryEndStr:
+|    o Pointer to the end of the reversed query sequence
+|  - refPosUL:
+|    o First reference base (index 0) in the piece
+|  - lenRefL:
+|    o Number of reference bases in the piece
+|  - qryPosUL:
+|    o First query base (index 0) in the piece
+|  - lenQryL:
+|    o Number of query bases in the piece
+|  - startC:
+|    o defWfaStartSnp or defWfaStartGap (the piece before
+|      ended in a gap)
+|  - endGapBl:
+|    o 1: piece has to end in a gap (the piece after
+|      starts by extending it)
+|  - alnST:
+|    o Pointer to alnStruct to add the alignment to
+| Output:
+|  - Modifies:
+|    o alnST to have the alignment of the piece
+|  - Returns:
+|    o 0 for no errors
+|    o 64 for memory errors
+\-------------------------------------------------------*/
+static char wfaBiAln(
+   struct wfaRun *fwdST,  /*Forward ring*/
+   struct wfaRun *revST,  /*Reverse ring*/
+   struct wfaSet *setST,  /*Has penalties*/
+   char *refSeqStr,       /*Reference sequence*/
+   char *qrySeqStr,       /*Query sequence*/
+   char *revRefEndStr,    /*End of reversed reference*/
+   char *revQryEndStr,    /*End of reversed query*/
+   ulong refPosUL,        /*First reference base*/
+   long lenRefL,          /*Reference bases in piece*/
+   ulong qryPosUL,        /*First query base*/
+   long lenQryL,          /*Query bases in piece*/
+   char startC,           /*How the piece starts*/
+   char endGapBl,         /*1: piece ends in a gap*/
+   struct alnStruct *alnST /*Gets the alignment*/
+){
+   struct wfaRun fullST;
+   long refSplitL = 0;
+   long qrySplitL = 0;
+   char gapBl = 0;
+   char errC = 0;
+
+   if(
+         lenRefL == 0
+      || lenQryL == 0
+      || lenRefL + lenQryL < defWfaBiMinLen
+   ) goto fullAln;
+
+   fwdST->refStr = refSeqStr + refPosUL;
+   fwdST->lenRefL = lenRefL;
+   fwdST->qryStr = qrySeqStr + qryPosUL;
+   fwdST->lenQryL = lenQryL;
+   fwdST->startC = startC;
+
+   revST->refStr = revRefEndStr - refPosUL - lenRefL;
+   revST->lenRefL = lenRefL;
+   revST->qryStr = revQryEndStr - qryPosUL - lenQryL;
+   revST->lenQryL = lenQryL;
+
+   if(endGapBl) revST->startC = defWfaStartOpen;
+   else revST->startC = defWfaStartSnp;
+
+   errC =
+      wfaBiSplit(
+         fwdST,
+         revST,
+         setST,
+         &refSplitL,
+         &qrySplitL,
+         &gapBl
+      );
+
+   if(errC) return errC;
+
+   /*Splits at the ends would not make the pieces smaller;
+   ` this only happens for low scores
+   */
+   if(refSplitL == 0 && qrySplitL == 0) goto fullAln;
+
+   if(refSplitL == lenRefL && qrySplitL == lenQryL)
+      goto fullAln;
+
+   errC =
+      wfaBiAln(
+         fwdST,
+         revST,
+         setST,
+         refSeqStr,
+         qrySeqStr,
+         revRefEndStr,
+         revQryEndStr,
+         refPosUL,
+         refSplitL,
+         qryPosUL,
+         qrySplitL,
+         startC,
+         gapBl,
+         alnST
+      );
+
+   if(errC) return errC;
+
+   return
+      wfaBiAln(
+         fwdST,
+         revST,
+         setST,
+         refSeqStr,
+         qrySeqStr,
+         revRefEndStr,
+         revQryEndStr,
+         refPosUL + refSplitL,
+         lenRefL - refSplitL,
+         qryPosUL + qrySplitL,
+         lenQryL - qrySplitL,
+         gapBl ? defWfaStartGap : defWfaStartSnp,
+         endGapBl,
+         alnST
+      );
+
+   fullAln:
+
+   fullST.refStr = refSeqStr + refPosUL;
+   fullST.lenRefL = lenRefL;
+   fullST.qryStr = qrySeqStr + qryPosUL;
+   fullST.lenQryL = lenQryL;
+   fullST.startC = startC;
+   fullST.endGapBl = endGapBl;
+
+   return
+      wfaFull(
+         &fullST,
+         setST,
+         refPosUL,
+         qryPosUL,
+         refSeqStr,
+         qrySeqStr,
+         alnST
+      );
+} /*wfaBiAln*/
+
+/*-------------------------------------------------------\
+| Fun-12: wfaAln
+|  - Does a wavefront alignment (-use-wfa)
+| Input:
+|  - qryST:
+|    o Pionter to seqStruct structure with query sequence
+|    o offsetUL; were to start query alignment, is index 0
+|    o endAlnUL; were to stop query alignment, is index 0
+|  - refST:
+|    o Pionter to seqStruct with reference sequence
+|    o offsetUL; were to start alignment on ref, index 0
+|    o endAlnUL; were to stop alignment on ref, is index 0
+|  - setST:
+|    o Pointer to wfaSet structure from wfaSetup
+|  - scoreL:
+|    o Pointer to long to hold the alignment score
+| Output:
+|  - Modifies:
+|    o scoreL to have the score of the alignment
+|  - Returns:
+|    o alnStruct with the alignment
+|    o 0 for memory allocation errors
+| Note:
+|  - settings->wfaLowMemBl (-wfa-low-mem) uses wfaBiAln
+\-------------------------------------------------------*/
+static struct alnStruct * wfaAln(
+    struct seqStruct *qryST, /*query sequence and data*/
+    struct seqStruct *refST, /*ref sequence and data*/
+    struct wfaSet *setST,    /*Penalties from wfaSetup*/
+    long *scoreL             /*Gets alignment score*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun-12 TOC: wfaAln
+   '  - Does a wavefront alignment (-use-wfa)
+   '  o fun-12 sec-01:
+   '    - Variable declerations
+   '  o fun-12 sec-02:
+   '    - Set up the alignment structure
+   '  o fun-12 sec-03:
+   '    - Do the alignment
+   '  o fun-12 sec-04:
+   '    - Add soft masking and find the score
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-12 Sec-01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   struct alnSet *settings = setST->settings;
+   long lenQryL =
+      (long) (qryST->endAlnUL - qryST->offsetUL + 1);
+   long lenRefL =
+      (long) (refST->endAlnUL - refST->offsetUL + 1);
+
+   struct wfaRun fwdST;
+   struct wfaRun revST;
+   char *revRefStr = 0;
+   char *revQryStr = 0;
+
+   ulong refUL = 0;
+   ulong qryUL = 0;
+   long ringL = 0;
+   char gapBl = 0;
+   char firstBl = 1;
+   char errC = 0;
+
+   struct alnStruct *alnST = 0;
+
+   fwdST.frontAryST = 0;
+   revST.frontAryST = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-12 Sec-02:
+   ^  - Set up the alignment structure
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   alnST = calloc(1, sizeof(struct alnStruct));
+   if(alnST == 0) return 0;
+
+   alnST->refAlnStr =
+      calloc(refST->lenSeqUL + 1, sizeof(char));
+
+   if(alnST->refAlnStr == 0) goto memErr;
+
+   alnST->qryAlnStr =
+      calloc(qryST->lenSeqUL + 1, sizeof(char));
+
+   if(alnST->qryAlnStr == 0) goto memErr;
+
+   alnST->refLenUL = refST->lenSeqUL;
+   alnST->qryLenUL = qryST->lenSeqUL;
+
+   alnST->refEndAlnUL = refST->endAlnUL;
+   alnST->qryEndAlnUL = qryST->endAlnUL;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-12 Sec-03:
+   ^  - Do the alignment
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(
+         ! settings->wfaLowMemBl
+      || lenRefL + lenQryL < defWfaBiMinLen
+   ){ /*If: keeping every wavefront*/
+      fwdST.refStr = refST->seqCStr + refST->offsetUL;
+      fwdST.lenRefL = lenRefL;
+      fwdST.qryStr = qryST->seqCStr + qryST->offsetUL;
+      fwdST.lenQryL = lenQryL;
+      fwdST.startC = defWfaStartSnp;
+      fwdST.endGapBl = 0;
+
+      errC =
+         wfaFull(
+            &fwdST,
+            setST,
+            refST->offsetUL,
+            qryST->offsetUL,
+            refST->seqCStr,
+            qryST->seqCStr,
+            alnST
+         );
+   } /*If: keeping every wavefront*/
+
+   else
+   { /*Else: doing a bidirectional alignment*/
+      revRefStr = malloc(refST->lenSeqUL * sizeof(char));
+      if(revRefStr == 0) goto memErr;
+
+      revQryStr = malloc(qryST->lenSeqUL * sizeof(char));
+      if(revQryStr == 0) goto memErr;
+
+      for(refUL = 0; refUL < refST->lenSeqUL; ++refUL)
+         revRefStr[refUL] =
+            refST->seqCStr[refST->lenSeqUL - refUL - 1];
+
+      for(qryUL = 0; qryUL < qryST->lenSeqUL; ++qryUL)
+         revQryStr[qryUL] =
+            qryST->seqCStr[qryST->lenSeqUL - qryUL - 1];
+
+      /*The ring has to hold every wavefront a new
+      ` wavefront is found from
+      */
+      ringL = setST->maxPenL + 2;
+
+      fwdST.ringL = ringL;
+      fwdST.numFrontsL = ringL;
+      revST.ringL = ringL;
+      revST.numFrontsL = ringL;
+
+      fwdST.frontAryST =
+         calloc(ringL, sizeof(struct wfaFront));
+      if(fwdST.frontAryST == 0) goto memErr;
+
+      revST.frontAryST =
+         calloc(ringL, sizeof(struct wfaFront));
+      if(revST.frontAryST == 0) goto memErr;
+
+      errC =
+         wfaBiAln(
+            &fwdST,
+            &revST,
+            setST,
+            refST->seqCStr,
+            qryST->seqCStr,
+            revRefStr + refST->lenSeqUL,
+            revQryStr + qryST->lenSeqUL,
+            refST->offsetUL,
+            lenRefL,
+            qryST->offsetUL,
+            lenQryL,
+            defWfaStartSnp,
+            0,
+            alnST
+         );
+
+      for(ringL = 0; ringL < fwdST.numFrontsL; ++ringL)
+      { /*Loop: free the rings*/
+         free(fwdST.frontAryST[ringL].mAryL);
+         free(revST.frontAryST[ringL].mAryL);
+      } /*Loop: free the rings*/
+
+      free(fwdST.frontAryST);
+      fwdST.frontAryST = 0;
+      free(revST.frontAryST);
+      revST.frontAryST = 0;
+
+      free(revRefStr);
+      revRefStr = 0;
+      free(revQryStr);
+      revQryStr = 0;
+   } /*Else: doing a bidirectional alignment*/
+
+   if(errC) goto memErr;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun-12 Sec-04:
+   ^  - Add soft masking and find the score
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*The score is found from the alignment, since the
+   ` -wfa-low-mem pieces do not keep their scores
+   */
+   *scoreL = 0;
+   refUL = refST->offsetUL;
+   qryUL = qryST->offsetUL;
+   gapBl = 0;
+
+   alnST->refStartAlnUL = refST->offsetUL;
+   alnST->qryStartAlnUL = qryST->offsetUL;
+
+   while(
+         refUL <= refST->endAlnUL
+      || qryUL <= qryST->endAlnUL
+   ){ /*Loop: Score the alignment*/
+      if(
+            refUL <= refST->endAlnUL
+         && alnST->refAlnStr[refUL] == defGapFlag
+      ){ /*If: this is a deletion*/
+         ++refUL;
+      } /*If: this is a deletion*/
+
+      else if(
+            qryUL <= qryST->endAlnUL
+         && alnST->qryAlnStr[qryUL] == defGapFlag
+      ){ /*Else If: this is an insertion*/
+         ++qryUL;
+      } /*Else If: this is an insertion*/
+
+      else
+      { /*Else: this is a match or snp*/
+         if(firstBl)
+         { /*If: this is the first match or snp*/
+            alnST->refStartAlnUL = refUL;
+            alnST->qryStartAlnUL = qryUL;
+            firstBl = 0;
+         } /*If: this is the first match or snp*/
+
+         *scoreL +=
+            getBaseScore(
+               qryST->seqCStr[qryUL],
+               refST->seqCStr[refUL],
+               settings
+            );
+
+         ++refUL;
+         ++qryUL;
+         gapBl = 0;
+         continue;
+      } /*Else: this is a match or snp*/
+
+      if(gapBl && ! settings->noGapBl)
+         *scoreL += settings->gapExtendC;
+      else *scoreL += settings->gapOpenC;
+
+      gapBl = 1;
+   } /*Loop: Score the alignment*/
+
+   alnST->refAlnStr[alnST->refLenUL] = defEndAlnFlag;
+   alnST->qryAlnStr[alnST->qryLenUL] = defEndAlnFlag;
+
+   for(refUL = 0; refUL < alnST->refLenUL; ++refUL)
+   { /*Loop: soft mask the unaligned reference bases*/
+      if(alnST->refAlnStr[refUL] == 0)
+         alnST->refAlnStr[refUL] = defSoftMaskFlag;
+   } /*Loop: soft mask the unaligned reference bases*/
+
+   for(qryUL = 0; qryUL < alnST->qryLenUL; ++qryUL)
+   { /*Loop: soft mask the unaligned query bases*/
+      if(alnST->qryAlnStr[qryUL] == 0)
+         alnST->qryAlnStr[qryUL] = defSoftMaskFlag;
+   } /*Loop: soft mask the unaligned query bases*/
+
+   return alnST;
+
+   memErr:
+
+   if(fwdST.frontAryST != 0)
+   { /*If: I need to free the forward ring*/
+      for(ringL = 0; ringL < fwdST.numFrontsL; ++ringL)
+         free(fwdST.frontAryST[ringL].mAryL);
+
+      free(fwdST.frontAryST);
+   } /*If: I need to free the forward ring*/
+
+   if(revST.frontAryST != 0)
+   { /*If: I need to free the reverse ring*/
+      for(ringL = 0; ringL < revST.numFrontsL; ++ringL)
+         free(revST.frontAryST[ringL].mAryL);
+
+      free(revST.frontAryST);
+   } /*If: I need to free the reverse ring*/
+
+   free(revRefStr);
+   free(revQryStr);
+   freeAlnST(alnST);
+   return 0;
+} /*wfaAln*/
+
+#endif